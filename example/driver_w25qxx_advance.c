@@ -60,6 +60,9 @@ uint8_t w25qxx_advance_init(w25qxx_type_t type, w25qxx_interface_t interface, w2
     DRIVER_W25QXX_LINK_DELAY_MS(&gs_handle, w25qxx_interface_delay_ms);
     DRIVER_W25QXX_LINK_DELAY_US(&gs_handle, w25qxx_interface_delay_us);
     DRIVER_W25QXX_LINK_DEBUG_PRINT(&gs_handle, w25qxx_interface_debug_print);
+#if (W25QXX_INTERFACE_SPI_BATCH == 1)
+    DRIVER_W25QXX_LINK_SPI_BATCH(&gs_handle, w25qxx_interface_spi_batch);
+#endif
     
     /* set chip type */
     res = w25qxx_set_type(&gs_handle, type);
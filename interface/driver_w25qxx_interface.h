@@ -50,6 +50,13 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief interface spi batch definition
+ */
+#ifndef W25QXX_INTERFACE_SPI_BATCH
+    #define W25QXX_INTERFACE_SPI_BATCH        0        /**< set to 1 by a port implementing w25qxx_interface_spi_batch */
+#endif
+
 /**
  * @brief  interface spi qspi bus init
  * @return status code
@@ -95,6 +102,18 @@ uint8_t w25qxx_interface_spi_qspi_write_read(uint8_t instruction, uint8_t instru
                                              uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
                                              uint8_t *out_buf, uint32_t out_len, uint8_t data_line);
 
+/**
+ * @brief      interface spi bus batch write read
+ * @param[in]  *transfer pointer to a w25qxx spi transfer array
+ * @param[in]  num transfer number
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       every transfer is one chip select frame, optional, a port implementing it
+ *             sets W25QXX_INTERFACE_SPI_BATCH to 1 so the examples link it
+ */
+uint8_t w25qxx_interface_spi_batch(w25qxx_spi_transfer_t *transfer, uint8_t num);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
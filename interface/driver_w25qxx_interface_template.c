@@ -90,6 +90,21 @@ uint8_t w25qxx_interface_spi_qspi_write_read(uint8_t instruction, uint8_t instru
     return 0;
 }
 
+/**
+ * @brief      interface spi bus batch write read
+ * @param[in]  *transfer pointer to a w25qxx spi transfer array
+ * @param[in]  num transfer number
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       every transfer is one chip select frame, optional, a port implementing it
+ *             sets W25QXX_INTERFACE_SPI_BATCH to 1 so the examples link it
+ */
+uint8_t w25qxx_interface_spi_batch(w25qxx_spi_transfer_t *transfer, uint8_t num)
+{
+    return 1;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -0,0 +1,1632 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bench.c
+ * @brief     w25qxx bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx.h"
+#include "driver_w25qxx_queue.h"
+#include "queue_worker.h"
+#include "driver_w25qxx_stripe.h"
+#include "driver_w25qxx_mirror.h"
+#include "driver_w25qxx_async.h"
+#include "driver_w25qxx_log.h"
+#include "emulator.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+/**
+ * @brief bench max scenario definition
+ */
+#define BENCH_MAX_SCENARIO        32
+
+/**
+ * @brief bench max chip definition
+ */
+#define BENCH_MAX_CHIP            4
+
+/**
+ * @brief bench result structure definition
+ */
+typedef struct bench_result_s
+{
+    char name[32];                /**< scenario name */
+    uint32_t transaction;         /**< bus transactions */
+    uint64_t bus_bytes;           /**< bytes clocked on the bus */
+    uint64_t time_us;             /**< virtual time */
+    uint64_t payload;             /**< user bytes */
+} bench_result_t;
+
+/**
+ * @brief bench scenario structure definition
+ */
+typedef struct bench_scenario_s
+{
+    const char *name;                                             /**< scenario name */
+    uint16_t type;                                                /**< chip type */
+    uint32_t size;                                                /**< chip size */
+    w25qxx_bool_t dual_quad_spi_enable;                           /**< dual quad spi enable */
+    w25qxx_address_mode_t address_mode;                           /**< address mode */
+    uint8_t chip;                                                 /**< emulated chips */
+    uint8_t (*run)(w25qxx_handle_t *handle, uint64_t *payload);   /**< scenario body */
+} bench_scenario_t;
+
+static w25qxx_handle_t gs_handle;                    /**< w25qxx handle */
+static w25qxx_handle_t gs_extra[BENCH_MAX_CHIP - 1]; /**< handles of the other chips */
+static uint8_t gs_buffer[65536];                     /**< data buffer */
+static uint8_t gs_check[65536];                      /**< check buffer */
+static bench_result_t gs_result[BENCH_MAX_SCENARIO];  /**< results */
+static bench_result_t gs_baseline[BENCH_MAX_SCENARIO];/**< baseline */
+
+/**
+ * @brief     fill a pattern
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] seed pattern seed
+ * @note      none
+ */
+static void a_bench_pattern(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    uint32_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        buf[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+/**
+ * @brief      check the emulated memory
+ * @param[in]  addr flash address
+ * @param[in]  *buf pointer to an expected buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 mismatch
+ * @note       none
+ */
+static uint8_t a_bench_verify(uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    uint32_t size;
+    uint8_t *mem;
+    
+    mem = emulator_get_memory(0, &size);
+    if ((mem == NULL) || ((addr + len) > size) || (memcmp(&mem[addr], buf, len) != 0))
+    {
+        emulator_debug_print("bench: data mismatch at 0x%08X.\n", addr);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      init scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the initialization itself is measured by the caller
+ */
+static uint8_t a_bench_init(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    (void)handle;
+    *payload = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      sequential 4k read scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_bench_read_4k(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t addr;
+    
+    for (addr = 0; addr < 65536; addr += 4096)
+    {
+        if (w25qxx_read(handle, handle->type >= W25Q256 ? 0x1000000 + addr : addr, gs_buffer, 4096) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = 65536;
+    
+    return 0;
+}
+
+/**
+ * @brief      small random read scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_bench_read_small(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t i;
+    
+    for (i = 0; i < 256; i++)
+    {
+        if (w25qxx_read(handle, (i * 4111U) % 0x100000, gs_buffer, 16) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = 256 * 16;
+    
+    return 0;
+}
+
+/**
+ * @brief      page program scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_bench_page_program(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t addr;
+    
+    a_bench_pattern(gs_check, 65536, 1);
+    for (addr = 0; addr < 65536; addr += 256)
+    {
+        if (w25qxx_page_program(handle, 0x10000 + addr, &gs_check[addr], 256) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = 65536;
+    
+    return a_bench_verify(0x10000, gs_check, 65536);
+}
+
+/**
+ * @brief      blank write scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_bench_write_blank(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t addr;
+    
+    a_bench_pattern(gs_check, 65536, 2);
+    for (addr = 0; addr < 65536; addr += 256)
+    {
+        if (w25qxx_write(handle, 0x20000 + addr, &gs_check[addr], 256) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = 65536;
+    
+    return a_bench_verify(0x20000, gs_check, 65536);
+}
+
+/**
+ * @brief      read modify write scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       every 256 bytes write lands on programmed data
+ */
+static uint8_t a_bench_write_rmw(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t size;
+    uint32_t addr;
+    uint8_t *mem;
+    
+    /* prefill without bus traffic */
+    mem = emulator_get_memory(0, &size);
+    memset(&mem[0x30000], 0x00, 16384);
+    a_bench_pattern(gs_check, 16384, 3);
+    for (addr = 0; addr < 16384; addr += 256)
+    {
+        if (w25qxx_write(handle, 0x30000 + addr, &gs_check[addr], 256) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = 16384;
+    
+    return a_bench_verify(0x30000, gs_check, 16384);
+}
+
+/**
+ * @brief      sector erase scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_bench_erase_4k(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t addr;
+    
+    for (addr = 0; addr < 65536; addr += 4096)
+    {
+        if (w25qxx_sector_erase_4k(handle, 0x40000 + addr) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = 65536;
+    
+    return 0;
+}
+
+/**
+ * @brief      block erase scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_bench_erase_64k(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t addr;
+    
+    for (addr = 0; addr < 4 * 65536; addr += 65536)
+    {
+        if (w25qxx_block_erase_64k(handle, 0x50000 + addr) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = 4 * 65536;
+    
+    return 0;
+}
+
+/**
+ * @brief bench mixed workload definition
+ */
+#define BENCH_MIXED_READ             32                                /**< reads arriving during the erases */
+#define BENCH_MIXED_ERASE            16                                /**< sector erases */
+#define BENCH_MIXED_PERIOD_NS        (10ULL * 1000ULL * 1000ULL)       /**< one read every 10 ms */
+
+static w25qxx_queue_t gs_queue;                                       /**< w25qxx queue */
+static w25qxx_queue_req_t gs_req[BENCH_MIXED_READ + BENCH_MIXED_ERASE];/**< queue requests */
+static uint64_t gs_arrive_ns[BENCH_MIXED_READ];                       /**< read arrival time */
+static uint64_t gs_done_ns[BENCH_MIXED_READ];                         /**< read completion time */
+static uint32_t gs_arrived;                                           /**< arrived reads */
+static uint8_t gs_mixed_failed;                                       /**< failed flag */
+
+/**
+ * @brief mixed workload reset
+ * @note  reads arrive every period from now on
+ */
+static void a_bench_mixed_reset(void)
+{
+    uint64_t start;
+    uint32_t i;
+    
+    start = emulator_get_time_ns();
+    for (i = 0; i < BENCH_MIXED_READ; i++)
+    {
+        gs_arrive_ns[i] = start + (uint64_t)(i + 1) * BENCH_MIXED_PERIOD_NS;
+        gs_done_ns[i] = 0;
+    }
+    gs_arrived = 0;
+    gs_mixed_failed = 0;
+}
+
+/**
+ * @brief      mixed workload report
+ * @param[in]  *name pointer to a scenario name
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 a read didn't complete
+ * @note       the read latency is the time from the arrival to the completion
+ */
+static uint8_t a_bench_mixed_report(const char *name, uint64_t *payload)
+{
+    uint64_t sum;
+    uint64_t max;
+    uint64_t latency;
+    uint32_t i;
+    
+    sum = 0;
+    max = 0;
+    for (i = 0; i < BENCH_MIXED_READ; i++)
+    {
+        if ((gs_done_ns[i] == 0) || (gs_done_ns[i] < gs_arrive_ns[i]))
+        {
+            return 1;
+        }
+        latency = gs_done_ns[i] - gs_arrive_ns[i];
+        sum += latency;
+        max = (latency > max) ? latency : max;
+    }
+    (void)printf("bench: %s read latency avg %llu us, max %llu us.\n", name,
+                 (unsigned long long)(sum / BENCH_MIXED_READ / 1000), (unsigned long long)(max / 1000));
+    *payload = BENCH_MIXED_READ * 256;
+    
+    return gs_mixed_failed;
+}
+
+/**
+ * @brief      blocking erases with reads arriving scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       reads that arrive during an erase wait for it
+ */
+static uint8_t a_bench_erase_read_direct(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t sector;
+    uint32_t served;
+    
+    a_bench_mixed_reset();
+    sector = 0;
+    served = 0;
+    while ((served < BENCH_MIXED_READ) || (sector < BENCH_MIXED_ERASE))
+    {
+        /* serve the arrived reads */
+        while ((served < BENCH_MIXED_READ) && (gs_arrive_ns[served] <= emulator_get_time_ns()))
+        {
+            if (w25qxx_read(handle, 0x100000 + served * 256, &gs_buffer[served * 256], 256) != 0)
+            {
+                return 1;
+            }
+            gs_done_ns[served] = emulator_get_time_ns();
+            served++;
+        }
+        if (sector < BENCH_MIXED_ERASE)
+        {
+            if (w25qxx_sector_erase_4k(handle, 0x200000 + sector * 8192) != 0)
+            {
+                return 1;
+            }
+            sector++;
+        }
+        else if (served < BENCH_MIXED_READ)
+        {
+            handle->delay_ms(1);
+        }
+        else
+        {
+            /* all done */
+        }
+    }
+    
+    return a_bench_mixed_report("erase_read_direct", payload);
+}
+
+/**
+ * @brief     queue completion callback
+ * @param[in] *req pointer to a w25qxx queue request structure
+ * @param[in] res request result
+ * @note      none
+ */
+static void a_bench_queue_done(w25qxx_queue_req_t *req, uint8_t res)
+{
+    if (res != 0)
+    {
+        gs_mixed_failed = 1;
+    }
+    else if (req->op == W25QXX_QUEUE_OP_READ)
+    {
+        gs_done_ns[(uintptr_t)req->arg] = emulator_get_time_ns();
+    }
+    else
+    {
+        /* erase done */
+    }
+}
+
+/**
+ * @brief     queue scenario delay and read arrival
+ * @param[in] ms time
+ * @note      the reads are submitted by the virtual clock
+ */
+static void a_bench_queue_delay_ms(uint32_t ms)
+{
+    w25qxx_queue_req_t *req;
+    
+    emulator_delay_ms(ms);
+    while ((gs_arrived < BENCH_MIXED_READ) && (gs_arrive_ns[gs_arrived] <= emulator_get_time_ns()))
+    {
+        req = &gs_req[gs_arrived];
+        memset(req, 0, sizeof(w25qxx_queue_req_t));
+        req->op = W25QXX_QUEUE_OP_READ;
+        req->addr = 0x100000 + gs_arrived * 256;
+        req->buf = &gs_buffer[gs_arrived * 256];
+        req->len = 256;
+        req->arg = (void *)(uintptr_t)gs_arrived;
+        if (w25qxx_queue_submit(&gs_queue, req, a_bench_queue_done) != 0)
+        {
+            gs_mixed_failed = 1;
+        }
+        gs_arrived++;
+    }
+}
+
+/**
+ * @brief      queued erases with reads arriving scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       same workload as erase_read_direct, the queue suspends the erases for the reads
+ */
+static uint8_t a_bench_erase_read_queue(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    w25qxx_queue_req_t *req;
+    uint32_t count;
+    uint32_t i;
+    uint8_t res;
+    
+    if (w25qxx_queue_init(&gs_queue, handle) != 0)
+    {
+        return 1;
+    }
+    a_bench_mixed_reset();
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, a_bench_queue_delay_ms);
+    for (i = 0; i < BENCH_MIXED_ERASE; i++)
+    {
+        req = &gs_req[BENCH_MIXED_READ + i];
+        memset(req, 0, sizeof(w25qxx_queue_req_t));
+        req->op = W25QXX_QUEUE_OP_ERASE_4K;
+        req->addr = 0x200000 + i * 8192;
+        (void)w25qxx_queue_submit(&gs_queue, req, a_bench_queue_done);
+    }
+    
+    /* run the queue, idle until the next read arrives */
+    res = 0;
+    while (1)
+    {
+        if (w25qxx_queue_run(&gs_queue, &count) != 0)
+        {
+            res = 1;
+            
+            break;
+        }
+        if (count == 0)
+        {
+            if (gs_arrived == BENCH_MIXED_READ)
+            {
+                break;
+            }
+            handle->delay_ms(1);
+        }
+    }
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, emulator_delay_ms);
+    (void)w25qxx_queue_deinit(&gs_queue);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return a_bench_mixed_report("erase_read_queue", payload);
+}
+
+static uint32_t gs_worker_done;                                       /**< requests completed by the worker */
+
+/**
+ * @brief     worker completion callback
+ * @param[in] *req pointer to a w25qxx queue request structure
+ * @param[in] res request result
+ * @note      runs in the worker thread, read after the worker is joined
+ */
+static void a_bench_worker_done(w25qxx_queue_req_t *req, uint8_t res)
+{
+    (void)req;
+    if (res != 0)
+    {
+        gs_mixed_failed = 1;
+    }
+    gs_worker_done++;
+}
+
+/**
+ * @brief      queue worker thread scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the erases queued before the start are drained by the worker, the reads are
+ *             submitted to the running worker and completed by the stop, the reads don't
+ *             touch each other and the erases are done first, so the transactions don't
+ *             depend on the thread timing
+ */
+static uint8_t a_bench_queue_worker(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    w25qxx_queue_stats_t stats;
+    w25qxx_queue_req_t *req;
+    uint32_t size;
+    uint32_t i;
+    uint8_t *mem;
+    
+    /* prefill without bus traffic */
+    mem = emulator_get_memory(0, &size);
+    memset(&mem[0x300000], 0x00, 65536);
+    a_bench_pattern(gs_check, 65536, 7);
+    memcpy(&mem[0x310000], gs_check, 65536);
+    if (w25qxx_queue_init(&gs_queue, handle) != 0)
+    {
+        return 1;
+    }
+    gs_worker_done = 0;
+    gs_mixed_failed = 0;
+    
+    /* a whole block of erases queued before the start */
+    for (i = 0; i < 16; i++)
+    {
+        req = &gs_req[i];
+        memset(req, 0, sizeof(w25qxx_queue_req_t));
+        req->op = W25QXX_QUEUE_OP_ERASE_4K;
+        req->addr = 0x300000 + i * 4096;
+        if (w25qxx_queue_submit(&gs_queue, req, a_bench_worker_done) != 0)
+        {
+            return 1;
+        }
+    }
+    if ((queue_worker_start(&gs_queue) != 0) || (queue_worker_stop() != 0))
+    {
+        return 1;
+    }
+    
+    /* reads submitted to the running worker */
+    if (queue_worker_start(&gs_queue) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < 16; i++)
+    {
+        req = &gs_req[16 + i];
+        memset(req, 0, sizeof(w25qxx_queue_req_t));
+        req->op = W25QXX_QUEUE_OP_READ;
+        req->addr = 0x310000 + i * 4096;
+        req->buf = &gs_buffer[i * 4096];
+        req->len = 1024;
+        if (w25qxx_queue_submit(&gs_queue, req, a_bench_worker_done) != 0)
+        {
+            (void)queue_worker_stop();
+            
+            return 1;
+        }
+    }
+    if (queue_worker_stop() != 0)
+    {
+        return 1;
+    }
+    if ((w25qxx_queue_get_stats(&gs_queue, &stats) != 0) || (stats.complete != 32) ||
+        (gs_worker_done != 32) || (gs_mixed_failed != 0))
+    {
+        return 1;
+    }
+    (void)w25qxx_queue_deinit(&gs_queue);
+    for (i = 0; i < 16; i++)
+    {
+        if (memcmp(&gs_buffer[i * 4096], &gs_check[i * 4096], 1024) != 0)
+        {
+            return 1;
+        }
+    }
+    memset(gs_check, 0xFF, 65536);
+    *payload = 16 * 1024;
+    
+    return a_bench_verify(0x300000, gs_check, 65536);
+}
+
+/**
+ * @brief bench stripe unit definition
+ */
+#define BENCH_STRIPE_UNIT        8192        /**< 8k */
+
+static uint8_t gs_chip;                                  /**< emulated chips of the running scenario */
+static w25qxx_stripe_t gs_stripe;                        /**< w25qxx stripe */
+static uint8_t gs_stripe_buf[BENCH_MAX_CHIP * 4096];     /**< stripe work buffer */
+
+/**
+ * @brief      emulator chip 1 spi qspi bus write read
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       none
+ */
+static uint8_t a_bench_spi_qspi_write_read_1(uint8_t instruction, uint8_t instruction_line,
+                                             uint32_t address, uint8_t address_line, uint8_t address_len,
+                                             uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                             uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                             uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    return emulator_write_read(1, instruction, instruction_line, address, address_line, address_len,
+                               alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                               out_buf, out_len, data_line);
+}
+
+/**
+ * @brief      emulator chip 2 spi qspi bus write read
+ * @note       same parameters as a_bench_spi_qspi_write_read_1
+ */
+static uint8_t a_bench_spi_qspi_write_read_2(uint8_t instruction, uint8_t instruction_line,
+                                             uint32_t address, uint8_t address_line, uint8_t address_len,
+                                             uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                             uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                             uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    return emulator_write_read(2, instruction, instruction_line, address, address_line, address_len,
+                               alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                               out_buf, out_len, data_line);
+}
+
+/**
+ * @brief      emulator chip 3 spi qspi bus write read
+ * @note       same parameters as a_bench_spi_qspi_write_read_1
+ */
+static uint8_t a_bench_spi_qspi_write_read_3(uint8_t instruction, uint8_t instruction_line,
+                                             uint32_t address, uint8_t address_line, uint8_t address_len,
+                                             uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                             uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                             uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    return emulator_write_read(3, instruction, instruction_line, address, address_line, address_len,
+                               alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                               out_buf, out_len, data_line);
+}
+
+static w25qxx_mirror_t gs_mirror;        /**< w25qxx mirror */
+
+/**
+ * @brief     mirror scenario delay and read arrival
+ * @param[in] ms time
+ * @note      the reads are served by the virtual clock
+ */
+static void a_bench_mirror_delay_ms(uint32_t ms)
+{
+    emulator_delay_ms(ms);
+    while ((gs_arrived < BENCH_MIXED_READ) && (gs_arrive_ns[gs_arrived] <= emulator_get_time_ns()))
+    {
+        if (w25qxx_mirror_read(&gs_mirror, 0x100000 + gs_arrived * 256, &gs_buffer[gs_arrived * 256], 256) != 0)
+        {
+            gs_mixed_failed = 1;
+        }
+        gs_done_ns[gs_arrived] = emulator_get_time_ns();
+        gs_arrived++;
+    }
+}
+
+/**
+ * @brief      mirrored erases with reads arriving scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       same workload as erase_read_direct on two chips, the reads go to
+ *             the chip that isn't erasing
+ */
+static uint8_t a_bench_erase_read_mirror(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t i;
+    uint8_t res;
+    
+    if (w25qxx_mirror_init(&gs_mirror, handle, &gs_extra[0], 0x1000000) != 0)
+    {
+        return 1;
+    }
+    a_bench_mixed_reset();
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, a_bench_mirror_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_MS(&gs_extra[0], a_bench_mirror_delay_ms);
+    res = 0;
+    for (i = 0; i < BENCH_MIXED_ERASE; i++)
+    {
+        if (w25qxx_mirror_erase(&gs_mirror, 0x200000 + i * 8192, 4096) != 0)
+        {
+            res = 1;
+            
+            break;
+        }
+    }
+    while ((res == 0) && (gs_arrived < BENCH_MIXED_READ))
+    {
+        handle->delay_ms(1);
+    }
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, emulator_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_MS(&gs_extra[0], emulator_delay_ms);
+    (void)w25qxx_mirror_deinit(&gs_mirror);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return a_bench_mixed_report("erase_read_mirror", payload);
+}
+
+/**
+ * @brief      striped write scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       64k over programmed data, the erases and programs of the chips overlap
+ */
+static uint8_t a_bench_stripe_write(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    w25qxx_handle_t *chip[BENCH_MAX_CHIP];
+    uint32_t size;
+    uint8_t *mem;
+    uint8_t i;
+    
+    chip[0] = handle;
+    for (i = 1; i < gs_chip; i++)
+    {
+        chip[i] = &gs_extra[i - 1];
+    }
+    
+    /* prefill without bus traffic */
+    for (i = 0; i < gs_chip; i++)
+    {
+        mem = emulator_get_memory(i, &size);
+        memset(mem, 0x00, 65536);
+    }
+    if (w25qxx_stripe_init(&gs_stripe, chip, gs_chip, BENCH_STRIPE_UNIT, 0x100000, gs_stripe_buf) != 0)
+    {
+        return 1;
+    }
+    a_bench_pattern(gs_check, 65536, 4);
+    if (w25qxx_stripe_write(&gs_stripe, 0, gs_check, 65536) != 0)
+    {
+        return 1;
+    }
+    *payload = 65536;
+    if (w25qxx_stripe_read(&gs_stripe, 0, gs_buffer, 65536) != 0)
+    {
+        return 1;
+    }
+    (void)w25qxx_stripe_deinit(&gs_stripe);
+    
+    return (memcmp(gs_buffer, gs_check, 65536) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      serial multi chip erase scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       every chip erases 4 blocks with the blocking erase, one chip after another
+ */
+static uint8_t a_bench_erase_serial(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    w25qxx_handle_t *chip;
+    uint32_t block;
+    uint8_t i;
+    
+    for (i = 0; i < gs_chip; i++)
+    {
+        chip = (i == 0) ? handle : &gs_extra[i - 1];
+        for (block = 0; block < 4; block++)
+        {
+            if (w25qxx_block_erase_64k(chip, 0x40000 + block * 65536) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    *payload = (uint64_t)gs_chip * 4 * 65536;
+    
+    return 0;
+}
+
+/**
+ * @brief      parallel multi chip erase scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       same work as erase_serial_4, the chips erase at the same time
+ */
+static uint8_t a_bench_erase_parallel(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    w25qxx_handle_t *chip[BENCH_MAX_CHIP];
+    uint32_t addr[BENCH_MAX_CHIP];
+    uint8_t result[BENCH_MAX_CHIP];
+    uint32_t block;
+    uint8_t i;
+    
+    chip[0] = handle;
+    for (i = 1; i < gs_chip; i++)
+    {
+        chip[i] = &gs_extra[i - 1];
+    }
+    for (block = 0; block < 4; block++)
+    {
+        for (i = 0; i < gs_chip; i++)
+        {
+            addr[i] = 0x40000 + block * 65536;
+        }
+        if (w25qxx_erase_parallel(chip, gs_chip, W25QXX_ERASE_TYPE_BLOCK_64K, addr, result) != 0)
+        {
+            return 1;
+        }
+    }
+    *payload = (uint64_t)gs_chip * 4 * 65536;
+    
+    return 0;
+}
+
+/**
+ * @brief      emulator chip 0 spi batch write read
+ * @param[in]  *transfer pointer to a w25qxx spi transfer array
+ * @param[in]  num transfer number
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       the frames pay the transaction overhead once
+ */
+static uint8_t a_bench_spi_batch(w25qxx_spi_transfer_t *transfer, uint8_t num)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    res = 0;
+    emulator_batch_begin();
+    for (i = 0; (i < num) && (res == 0); i++)
+    {
+        res = emulator_write_read(0, 0x00, 0x00, 0x00000000, 0x00, 0x00,
+                                  0x00000000, 0x00, 0x00, 0x00, transfer[i].in_buf, transfer[i].in_len,
+                                  transfer[i].out_buf, transfer[i].out_len, 1);
+    }
+    emulator_batch_end();
+    
+    return res;
+}
+
+/**
+ * @brief      batched page program scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       same work as page_program with the spi batch hook linked
+ */
+static uint8_t a_bench_page_program_batch(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    DRIVER_W25QXX_LINK_SPI_BATCH(handle, a_bench_spi_batch);
+    
+    return a_bench_page_program(handle, payload);
+}
+
+/**
+ * @brief      batched blank write scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       same work as write_blank with the spi batch hook linked
+ */
+static uint8_t a_bench_write_blank_batch(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    DRIVER_W25QXX_LINK_SPI_BATCH(handle, a_bench_spi_batch);
+    
+    return a_bench_write_blank(handle, payload);
+}
+
+static w25qxx_async_t gs_async;             /**< w25qxx async context */
+static w25qxx_async_req_t gs_async_req[64]; /**< async requests */
+static uint8_t gs_async_failed;             /**< async failed flag */
+
+/**
+ * @brief     async completion callback
+ * @param[in] *req pointer to a w25qxx async request structure
+ * @param[in] res request result
+ * @note      none
+ */
+static void a_bench_async_done(w25qxx_async_req_t *req, uint8_t res)
+{
+    (void)req;
+    if (res != 0)
+    {
+        gs_async_failed = 1;
+    }
+}
+
+/**
+ * @brief     async scenario delay ms
+ * @param[in] ms time
+ * @note      the pump must never get here
+ */
+static void a_bench_async_delay_ms(uint32_t ms)
+{
+    gs_async_failed = 1;
+    emulator_delay_ms(ms);
+}
+
+/**
+ * @brief     async scenario delay us
+ * @param[in] us time
+ * @note      the pump must never get here
+ */
+static void a_bench_async_delay_us(uint32_t us)
+{
+    gs_async_failed = 1;
+    emulator_delay_us(us);
+}
+
+/**
+ * @brief      async read modify write scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       same work as write_rmw through the async pump, the loop waits the
+ *             returned time and the delay hooks fail the run if called
+ */
+static uint8_t a_bench_write_rmw_async(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    uint32_t size;
+    uint32_t addr;
+    uint32_t pending;
+    uint32_t wait_us;
+    uint8_t *mem;
+    
+    /* prefill without bus traffic */
+    mem = emulator_get_memory(0, &size);
+    memset(&mem[0x30000], 0x00, 16384);
+    a_bench_pattern(gs_check, 16384, 3);
+    if (w25qxx_async_init(&gs_async, handle) != 0)
+    {
+        return 1;
+    }
+    gs_async_failed = 0;
+    for (addr = 0; addr < 16384; addr += 256)
+    {
+        if (w25qxx_write_async(&gs_async, &gs_async_req[addr / 256], 0x30000 + addr, &gs_check[addr], 256,
+                               a_bench_async_done, NULL) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* run the pump like an event loop */
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, a_bench_async_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(handle, a_bench_async_delay_us);
+    do
+    {
+        if (w25qxx_process(&gs_async, &pending, &wait_us) != 0)
+        {
+            gs_async_failed = 1;
+            
+            break;
+        }
+        if (wait_us != 0)
+        {
+            emulator_delay_us(wait_us);
+        }
+    } while (pending != 0);
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, emulator_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(handle, emulator_delay_us);
+    (void)w25qxx_async_deinit(&gs_async);
+    if (gs_async_failed != 0)
+    {
+        return 1;
+    }
+    *payload = 16384;
+    
+    return a_bench_verify(0x30000, gs_check, 16384);
+}
+
+/**
+ * @brief bench log region definition
+ */
+#define BENCH_LOG_ADDR               0x40000                           /**< log region address */
+#define BENCH_LOG_SECTOR             8                                 /**< log region sectors */
+#define BENCH_LOG_RECORD             1000                              /**< log record length */
+
+static w25qxx_log_t gs_log;                                           /**< w25qxx log */
+
+/**
+ * @brief      torn log open at the lap boundary scenario
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the log is filled until the head is the last sector of its second lap,
+ *             then the next open is cut after its erase ahead, the mount must find
+ *             the head again with every record and keep appending
+ */
+static uint8_t a_bench_log_torn_mount(w25qxx_handle_t *handle, uint64_t *payload)
+{
+    w25qxx_log_info_t info;
+    w25qxx_log_cursor_t cursor;
+    uint32_t erase_ahead;
+    uint32_t count;
+    uint32_t first;
+    uint32_t last;
+    uint32_t len;
+    uint32_t size;
+    uint32_t n;
+    uint8_t *mem;
+    
+    *payload = 0;
+    for (erase_ahead = 1; erase_ahead <= 3; erase_ahead++)
+    {
+        if ((w25qxx_log_init(&gs_log, handle, BENCH_LOG_ADDR, BENCH_LOG_SECTOR * 4096, erase_ahead) != 0) ||
+            (w25qxx_log_format(&gs_log) != 0))
+        {
+            return 1;
+        }
+        
+        /* fill until the head is the last sector */
+        count = 0;
+        while (1)
+        {
+            if (w25qxx_log_get_info(&gs_log, &info) != 0)
+            {
+                return 1;
+            }
+            if (info.head_seq == BENCH_LOG_SECTOR * 2 - 1)
+            {
+                break;
+            }
+            memset(gs_buffer, (uint8_t)count, BENCH_LOG_RECORD);
+            memcpy(gs_buffer, &count, sizeof(count));
+            if (w25qxx_log_append(&gs_log, gs_buffer, BENCH_LOG_RECORD) != 0)
+            {
+                return 1;
+            }
+            *payload += BENCH_LOG_RECORD;
+            count++;
+        }
+        
+        /* power lost after the erase ahead, before the header of sector 0 */
+        mem = emulator_get_memory(0, &size);
+        memset(&mem[BENCH_LOG_ADDR + erase_ahead * 4096], 0xFF, 4096);
+        if (w25qxx_log_mount(&gs_log) != 0)
+        {
+            emulator_debug_print("bench: torn log with erase ahead %d is lost.\n", erase_ahead);
+            
+            return 1;
+        }
+        if ((w25qxx_log_get_info(&gs_log, &info) != 0) || (info.head_seq != BENCH_LOG_SECTOR * 2 - 1))
+        {
+            return 1;
+        }
+        
+        /* the records left are the newest ones in order */
+        if (w25qxx_log_rewind(&gs_log, &cursor) != 0)
+        {
+            return 1;
+        }
+        n = 0;
+        last = 0;
+        while (w25qxx_log_next(&gs_log, &cursor, gs_check, BENCH_LOG_RECORD, &len) == 0)
+        {
+            memcpy(&first, gs_check, sizeof(first));
+            if ((len != BENCH_LOG_RECORD) || ((n != 0) && (first != last + 1)))
+            {
+                return 1;
+            }
+            last = first;
+            n++;
+        }
+        if ((n == 0) || (last != count - 1))
+        {
+            return 1;
+        }
+        if (w25qxx_log_append(&gs_log, gs_buffer, BENCH_LOG_RECORD) != 0)
+        {
+            return 1;
+        }
+        *payload += BENCH_LOG_RECORD;
+        (void)w25qxx_log_deinit(&gs_log);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief bench scenario table
+ */
+static const bench_scenario_t gsc_scenario[] =
+{
+    {"init",             W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_init},
+    {"read_4k",          W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_read_4k},
+    {"read_4k_dual_quad",W25Q128, 0x1000000, W25QXX_BOOL_TRUE,  W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_read_4k},
+    {"read_4k_ext_addr", W25Q256, 0x2000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_read_4k},
+    {"read_4k_4_byte",   W25Q256, 0x2000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_4_BYTE, 1, a_bench_read_4k},
+    {"read_small",       W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_read_small},
+    {"page_program",     W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_page_program},
+    {"write_blank",      W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_write_blank},
+    {"write_rmw",        W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_write_rmw},
+    {"erase_4k",         W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_erase_4k},
+    {"erase_64k",        W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_erase_64k},
+    {"erase_read_direct",W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_erase_read_direct},
+    {"erase_read_queue", W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_erase_read_queue},
+    {"stripe_write_1",   W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_stripe_write},
+    {"stripe_write_2",   W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 2, a_bench_stripe_write},
+    {"stripe_write_4",   W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 4, a_bench_stripe_write},
+    {"erase_read_mirror",W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 2, a_bench_erase_read_mirror},
+    {"erase_serial_4",   W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 4, a_bench_erase_serial},
+    {"erase_parallel_4", W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 4, a_bench_erase_parallel},
+    {"program_batch",    W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_page_program_batch},
+    {"write_blank_batch",W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_write_blank_batch},
+    {"write_rmw_async",  W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_write_rmw_async},
+    {"log_torn_mount",   W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_log_torn_mount},
+    {"queue_worker",     W25Q128, 0x1000000, W25QXX_BOOL_FALSE, W25QXX_ADDRESS_MODE_3_BYTE, 1, a_bench_queue_worker},
+};
+    
+/**
+ * @brief     open one of the other chips
+ * @param[in] index chip index
+ * @param[in] *scenario pointer to a bench scenario structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      index is 1 to BENCH_MAX_CHIP - 1
+ */
+static uint8_t a_bench_open(uint8_t index, const bench_scenario_t *scenario)
+{
+    w25qxx_handle_t *handle;
+    
+    if ((index == 0) || (index >= BENCH_MAX_CHIP))
+    {
+        return 1;
+    }
+    if (emulator_init(index, scenario->type, scenario->size) != 0)
+    {
+        return 1;
+    }
+    handle = &gs_extra[index - 1];
+    DRIVER_W25QXX_LINK_INIT(handle, w25qxx_handle_t);
+    DRIVER_W25QXX_LINK_SPI_QSPI_INIT(handle, emulator_spi_qspi_init);
+    DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(handle, emulator_spi_qspi_deinit);
+    if (index == 1)
+    {
+        DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(handle, a_bench_spi_qspi_write_read_1);
+    }
+    else if (index == 2)
+    {
+        DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(handle, a_bench_spi_qspi_write_read_2);
+    }
+    else
+    {
+        DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(handle, a_bench_spi_qspi_write_read_3);
+    }
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, emulator_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(handle, emulator_delay_us);
+    DRIVER_W25QXX_LINK_DEBUG_PRINT(handle, emulator_debug_print);
+    (void)w25qxx_set_type(handle, (w25qxx_type_t)scenario->type);
+    (void)w25qxx_set_interface(handle, W25QXX_INTERFACE_SPI);
+    (void)w25qxx_set_dual_quad_spi(handle, scenario->dual_quad_spi_enable);
+    if (w25qxx_init(handle) != 0)
+    {
+        emulator_deinit(index);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     close the chips of a scenario
+ * @param[in] chip opened chips, chip 0 included
+ * @note      none
+ */
+static void a_bench_close(uint8_t chip)
+{
+    uint8_t i;
+    
+    for (i = 1; i < chip; i++)
+    {
+        (void)w25qxx_deinit(&gs_extra[i - 1]);
+        emulator_deinit(i);
+    }
+    (void)w25qxx_deinit(&gs_handle);
+    emulator_deinit(0);
+}
+
+/**
+ * @brief      run one scenario
+ * @param[in]  *scenario pointer to a bench scenario structure
+ * @param[out] *result pointer to a bench result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the initialization is only measured by the init scenario
+ */
+static uint8_t a_bench_run(const bench_scenario_t *scenario, bench_result_t *result)
+{
+    emulator_stats_t stats;
+    uint64_t start;
+    uint64_t payload;
+    uint8_t res;
+    uint8_t i;
+    
+    if (emulator_init(0, scenario->type, scenario->size) != 0)
+    {
+        return 1;
+    }
+    emulator_clear_stats();
+    start = emulator_get_time_ns();
+    
+    /* link the emulated transport */
+    DRIVER_W25QXX_LINK_INIT(&gs_handle, w25qxx_handle_t);
+    DRIVER_W25QXX_LINK_SPI_QSPI_INIT(&gs_handle, emulator_spi_qspi_init);
+    DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(&gs_handle, emulator_spi_qspi_deinit);
+    DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(&gs_handle, emulator_spi_qspi_write_read);
+    DRIVER_W25QXX_LINK_DELAY_MS(&gs_handle, emulator_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(&gs_handle, emulator_delay_us);
+    DRIVER_W25QXX_LINK_DEBUG_PRINT(&gs_handle, emulator_debug_print);
+    (void)w25qxx_set_type(&gs_handle, (w25qxx_type_t)scenario->type);
+    (void)w25qxx_set_interface(&gs_handle, W25QXX_INTERFACE_SPI);
+    (void)w25qxx_set_dual_quad_spi(&gs_handle, scenario->dual_quad_spi_enable);
+    if (w25qxx_init(&gs_handle) != 0)
+    {
+        emulator_deinit(0);
+        
+        return 1;
+    }
+    if (scenario->address_mode == W25QXX_ADDRESS_MODE_4_BYTE)
+    {
+        if (w25qxx_set_address_mode(&gs_handle, W25QXX_ADDRESS_MODE_4_BYTE) != 0)
+        {
+            (void)w25qxx_deinit(&gs_handle);
+            emulator_deinit(0);
+            
+            return 1;
+        }
+    }
+    
+    /* open the other chips */
+    gs_chip = scenario->chip;
+    for (i = 1; i < scenario->chip; i++)
+    {
+        if (a_bench_open(i, scenario) != 0)
+        {
+            a_bench_close(i);
+            
+            return 1;
+        }
+    }
+    
+    /* only the init scenario measures the initialization */
+    if (scenario->run != a_bench_init)
+    {
+        emulator_clear_stats();
+        start = emulator_get_time_ns();
+    }
+    res = scenario->run(&gs_handle, &payload);
+    emulator_get_stats(&stats);
+    memset(result, 0, sizeof(bench_result_t));
+    strncpy(result->name, scenario->name, sizeof(result->name) - 1);
+    result->transaction = stats.transaction;
+    result->bus_bytes = stats.bus_bytes;
+    result->time_us = (emulator_get_time_ns() - start) / 1000;
+    result->payload = payload;
+    if (stats.busy_violation != 0)
+    {
+        emulator_debug_print("bench: %s sent %d commands to a busy chip.\n", scenario->name, stats.busy_violation);
+        res = 1;
+    }
+    a_bench_close(scenario->chip);
+    
+    return res;
+}
+
+/**
+ * @brief      load the baseline file
+ * @param[in]  *path pointer to a file path
+ * @param[out] *num pointer to a number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       lines are "name transaction bus_bytes time_us payload", # starts a comment
+ */
+static uint8_t a_bench_load(const char *path, uint32_t *num)
+{
+    FILE *fp;
+    char line[256];
+    bench_result_t *r;
+    unsigned long long bus_bytes;
+    unsigned long long time_us;
+    unsigned long long payload;
+    unsigned int transaction;
+    
+    *num = 0;
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    while ((fgets(line, sizeof(line), fp) != NULL) && (*num < BENCH_MAX_SCENARIO))
+    {
+        r = &gs_baseline[*num];
+        if ((line[0] == '#') || (line[0] == '\n'))
+        {
+            continue;
+        }
+        if (sscanf(line, "%31s %u %llu %llu %llu", r->name, &transaction, &bus_bytes, &time_us, &payload) == 5)
+        {
+            r->transaction = transaction;
+            r->bus_bytes = bus_bytes;
+            r->time_us = time_us;
+            r->payload = payload;
+            (*num)++;
+        }
+    }
+    (void)fclose(fp);
+    
+    return 0;
+}
+
+/**
+ * @brief     save the baseline file
+ * @param[in] *path pointer to a file path
+ * @param[in] num result number
+ * @return    status code
+ *            - 0 success
+ *            - 1 save failed
+ * @note      none
+ */
+static uint8_t a_bench_save(const char *path, uint32_t num)
+{
+    FILE *fp;
+    uint32_t i;
+    
+    fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    (void)fprintf(fp, "# w25qxx emulated transport baseline, regenerate with w25qxx_bench -u\n");
+    (void)fprintf(fp, "# name transaction bus_bytes time_us payload\n");
+    for (i = 0; i < num; i++)
+    {
+        (void)fprintf(fp, "%s %u %llu %llu %llu\n", gs_result[i].name, gs_result[i].transaction,
+                      (unsigned long long)gs_result[i].bus_bytes, (unsigned long long)gs_result[i].time_us,
+                      (unsigned long long)gs_result[i].payload);
+    }
+    (void)fclose(fp);
+    
+    return 0;
+}
+
+/**
+ * @brief     bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed or regression found
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    const char short_options[] = "hb:t:uc:";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"baseline", required_argument, NULL, 'b'},
+        {"threshold", required_argument, NULL, 't'},
+        {"update", no_argument, NULL, 'u'},
+        {"clock", required_argument, NULL, 'c'},
+        {NULL, 0, NULL, 0},
+    };
+    const char *baseline = NULL;
+    double threshold = 5.0;
+    uint32_t clock_hz = 1000 * 1000;
+    unsigned long clock;
+    char *end;
+    uint8_t update = 0;
+    uint8_t failed = 0;
+    uint32_t base_num = 0;
+    uint32_t num;
+    uint32_t i;
+    uint32_t j;
+    int c;
+    
+    /* parse the options */
+    optind = 0;
+    while ((c = getopt_long(argc, argv, short_options, long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'b' :
+            {
+                baseline = optarg;
+                
+                break;
+            }
+            case 't' :
+            {
+                threshold = atof(optarg);
+                
+                break;
+            }
+            case 'u' :
+            {
+                update = 1;
+                
+                break;
+            }
+            case 'c' :
+            {
+                clock = strtoul(optarg, &end, 0);
+                if ((optarg[0] < '0') || (optarg[0] > '9') || (*end != '\0') || (clock == 0))
+                {
+                    (void)printf("bench: clock is invalid.\n");
+                    
+                    return 1;
+                }
+                clock_hz = (clock > EMULATOR_MAX_CLOCK_HZ) ? EMULATOR_MAX_CLOCK_HZ : (uint32_t)clock;
+                
+                break;
+            }
+            default :
+            {
+                (void)printf("Usage:\n");
+                (void)printf("  w25qxx_bench [-b <file> | --baseline=<file>] [-t <percent> | --threshold=<percent>]\n");
+                (void)printf("               [-c <hz> | --clock=<hz>] [-u | --update]\n");
+                (void)printf("Run the driver against an emulated transport and compare the bus transactions\n");
+                (void)printf("exactly and the modeled time within the threshold with a committed baseline.\n");
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    emulator_set_clock(clock_hz, 10 * 1000);
+    if ((baseline != NULL) && (update == 0))
+    {
+        if (a_bench_load(baseline, &base_num) != 0)
+        {
+            (void)printf("bench: can't load %s.\n", baseline);
+            
+            return 1;
+        }
+    }
+    
+    /* run all scenarios */
+    num = sizeof(gsc_scenario) / sizeof(gsc_scenario[0]);
+    (void)printf("%-20s %8s %10s %12s %10s %s\n", "scenario", "xfers", "bus bytes", "time us", "KiB/s", "result");
+    for (i = 0; i < num; i++)
+    {
+        const char *verdict = "new";
+        double kib_s = 0.0;
+        
+        if (a_bench_run(&gsc_scenario[i], &gs_result[i]) != 0)
+        {
+            (void)printf("%-20s run failed.\n", gsc_scenario[i].name);
+            failed = 1;
+            
+            continue;
+        }
+        if (gs_result[i].time_us != 0)
+        {
+            kib_s = (double)gs_result[i].payload / 1024.0 / ((double)gs_result[i].time_us / 1000000.0);
+        }
+        for (j = 0; j < base_num; j++)
+        {
+            if (strcmp(gs_baseline[j].name, gs_result[i].name) == 0)
+            {
+                break;
+            }
+        }
+        if (j < base_num)
+        {
+            /* the transactions are deterministic, any extra one is a regression, the time gets the threshold */
+            if ((gs_result[i].transaction > gs_baseline[j].transaction) ||
+                ((double)gs_result[i].time_us > (double)gs_baseline[j].time_us * (1.0 + threshold / 100.0)))
+            {
+                verdict = "REGRESSION";
+                failed = 1;
+            }
+            else if ((gs_result[i].transaction < gs_baseline[j].transaction) ||
+                     (gs_result[i].time_us < gs_baseline[j].time_us))
+            {
+                verdict = "improved";
+            }
+            else
+            {
+                verdict = "ok";
+            }
+            (void)printf("%-20s %8u %10llu %12llu %10.1f %s (baseline %u xfers, %llu us)\n", gs_result[i].name,
+                         gs_result[i].transaction, (unsigned long long)gs_result[i].bus_bytes,
+                         (unsigned long long)gs_result[i].time_us, kib_s, verdict,
+                         gs_baseline[j].transaction, (unsigned long long)gs_baseline[j].time_us);
+        }
+        else
+        {
+            (void)printf("%-20s %8u %10llu %12llu %10.1f %s\n", gs_result[i].name,
+                         gs_result[i].transaction, (unsigned long long)gs_result[i].bus_bytes,
+                         (unsigned long long)gs_result[i].time_us, kib_s, verdict);
+        }
+    }
+    
+    /* rewrite the baseline */
+    if ((update != 0) && (baseline != NULL) && (failed == 0))
+    {
+        if (a_bench_save(baseline, num) != 0)
+        {
+            (void)printf("bench: can't save %s.\n", baseline);
+            
+            return 1;
+        }
+        (void)printf("bench: baseline saved to %s.\n", baseline);
+    }
+    
+    return failed;
+}
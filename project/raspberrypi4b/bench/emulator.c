@@ -0,0 +1,922 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      emulator.c
+ * @brief     w25qxx emulator source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "emulator.h"
+#include <stdarg.h>
+#include <stdlib.h>
+
+/**
+ * @brief emulator busy kind enumeration definition
+ */
+typedef enum
+{
+    EMULATOR_BUSY_NONE    = 0x00,        /**< idle */
+    EMULATOR_BUSY_PROGRAM = 0x01,        /**< program */
+    EMULATOR_BUSY_ERASE   = 0x02,        /**< erase */
+    EMULATOR_BUSY_STATUS  = 0x03,        /**< write status */
+} emulator_busy_t;
+
+/**
+ * @brief emulator chip structure definition
+ */
+typedef struct emulator_chip_s
+{
+    uint8_t *mem;                        /**< flash memory */
+    uint32_t size;                       /**< flash size */
+    uint16_t id;                         /**< chip id */
+    uint8_t status1;                     /**< status register 1 */
+    uint8_t status2;                     /**< status register 2 */
+    uint8_t status3;                     /**< status register 3 */
+    uint8_t ext_addr;                    /**< extended address register */
+    uint8_t four_byte;                   /**< 4 byte address mode */
+    uint8_t volatile_sr;                 /**< volatile status register write enable */
+    uint8_t suspended;                   /**< suspended flag */
+    emulator_busy_t busy;                /**< busy kind */
+    uint64_t busy_until;                 /**< busy end time */
+    uint64_t suspend_left;               /**< busy time left when suspended */
+    uint8_t security[3][256];            /**< security registers */
+} emulator_chip_t;
+
+static emulator_chip_t gs_chip[EMULATOR_MAX_CHIP];        /**< chips */
+static emulator_stats_t gs_stats;                         /**< statistics */
+static uint64_t gs_time_ns = 0;                           /**< virtual time */
+static uint32_t gs_clock_hz = 1000 * 1000;                /**< bus clock */
+static uint32_t gs_overhead_ns = 10 * 1000;               /**< transaction overhead */
+static uint8_t gs_batch = 0;                              /**< batch state, 2 once the overhead is paid */
+
+/**
+ * @brief     check if a chip is busy
+ * @param[in] *chip pointer to an emulator chip structure
+ * @return    1 if busy
+ * @note      none
+ */
+static uint8_t a_emulator_busy(emulator_chip_t *chip)
+{
+    if ((chip->busy != EMULATOR_BUSY_NONE) && (gs_time_ns >= chip->busy_until) && (chip->suspended == 0))
+    {
+        /* operation done */
+        chip->busy = EMULATOR_BUSY_NONE;
+        chip->status1 &= (uint8_t)(~0x02);
+    }
+    
+    return (chip->busy != EMULATOR_BUSY_NONE) && (chip->suspended == 0);
+}
+
+/**
+ * @brief     start a busy period
+ * @param[in] *chip pointer to an emulator chip structure
+ * @param[in] busy busy kind
+ * @param[in] ns busy time
+ * @note      none
+ */
+static void a_emulator_start(emulator_chip_t *chip, emulator_busy_t busy, uint64_t ns)
+{
+    chip->busy = busy;
+    chip->busy_until = gs_time_ns + ns;
+}
+
+/**
+ * @brief     get the address width of a raw spi command
+ * @param[in] *chip pointer to an emulator chip structure
+ * @param[in] cmd command
+ * @return    address bytes
+ * @note      none
+ */
+static uint8_t a_emulator_address_width(emulator_chip_t *chip, uint8_t cmd)
+{
+    switch (cmd)
+    {
+        case 0x90 :
+        case 0x92 :
+        case 0x94 :
+        case 0x5A :
+        {
+            return 3;
+        }
+        case 0x0C :
+        case 0x12 :
+        case 0x13 :
+        case 0x21 :
+        case 0xDC :
+        {
+            return 4;
+        }
+        case 0x02 :
+        case 0x32 :
+        case 0x03 :
+        case 0x0B :
+        case 0x20 :
+        case 0x52 :
+        case 0xD8 :
+        case 0x42 :
+        case 0x44 :
+        case 0x48 :
+        case 0x36 :
+        case 0x39 :
+        case 0x3D :
+        {
+            return (chip->four_byte != 0) ? 4 : 3;
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief     get the dummy bytes of a raw spi command
+ * @param[in] cmd command
+ * @return    dummy bytes
+ * @note      none
+ */
+static uint8_t a_emulator_dummy_bytes(uint8_t cmd)
+{
+    switch (cmd)
+    {
+        case 0x0B :
+        case 0x0C :
+        case 0x48 :
+        case 0x5A :
+        {
+            return 1;
+        }
+        case 0xAB :
+        {
+            return 3;
+        }
+        case 0x4B :
+        {
+            return 4;
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief      execute one command
+ * @param[in]  *chip pointer to an emulator chip structure
+ * @param[in]  index chip index
+ * @param[in]  cmd command
+ * @param[in]  addr full address
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  out_len output length
+ * @note       none
+ */
+static void a_emulator_execute(emulator_chip_t *chip, uint8_t index, uint8_t cmd, uint32_t addr,
+                               uint8_t *data, uint32_t len, uint8_t *out, uint32_t out_len)
+{
+    uint8_t busy;
+    uint32_t i;
+    uint32_t base;
+    uint8_t reg;
+    
+    busy = a_emulator_busy(chip);
+    switch (cmd)
+    {
+        case 0x05 :
+        {
+            gs_stats.status_poll++;
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = chip->status1 | busy;
+            }
+            
+            return;
+        }
+        case 0x35 :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = chip->status2 | (uint8_t)(chip->suspended << 7);
+            }
+            
+            return;
+        }
+        case 0x15 :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = (uint8_t)((chip->status3 & 0xFE) | chip->four_byte);
+            }
+            
+            return;
+        }
+        case 0x75 :
+        {
+            if ((busy != 0) && (chip->busy != EMULATOR_BUSY_STATUS))
+            {
+                chip->suspend_left = chip->busy_until - gs_time_ns;
+                chip->suspended = 1;
+            }
+            
+            return;
+        }
+        case 0x7A :
+        {
+            if (chip->suspended != 0)
+            {
+                chip->suspended = 0;
+                chip->busy_until = gs_time_ns + chip->suspend_left;
+            }
+            
+            return;
+        }
+        case 0x66 :
+        {
+            return;
+        }
+        case 0x99 :
+        {
+            chip->busy = EMULATOR_BUSY_NONE;
+            chip->suspended = 0;
+            chip->status1 &= (uint8_t)(~0x02);
+            chip->ext_addr = 0;
+            chip->four_byte = 0;
+            
+            return;
+        }
+        default :
+        {
+            break;
+        }
+    }
+    
+    /* the chip ignores all other commands while busy */
+    if (busy != 0)
+    {
+        gs_stats.busy_violation++;
+        
+        return;
+    }
+    switch (cmd)
+    {
+        case 0x06 :
+        {
+            chip->status1 |= 0x02;
+            
+            break;
+        }
+        case 0x04 :
+        {
+            chip->status1 &= (uint8_t)(~0x02);
+            
+            break;
+        }
+        case 0x50 :
+        {
+            chip->volatile_sr = 1;
+            
+            break;
+        }
+        case 0x01 :
+        case 0x31 :
+        case 0x11 :
+        {
+            if ((len == 0) || (((chip->status1 & 0x02) == 0) && (chip->volatile_sr == 0)))
+            {
+                break;
+            }
+            if (cmd == 0x01)
+            {
+                chip->status1 = (uint8_t)((chip->status1 & 0x03) | (data[0] & 0xFC));
+                if (len > 1)
+                {
+                    chip->status2 = data[1] & 0x7F;
+                }
+            }
+            else if (cmd == 0x31)
+            {
+                chip->status2 = data[0] & 0x7F;
+            }
+            else
+            {
+                chip->status3 = data[0];
+            }
+            if ((chip->status1 & 0x02) != 0)
+            {
+                a_emulator_start(chip, EMULATOR_BUSY_STATUS, EMULATOR_WRITE_STATUS_NS);
+            }
+            chip->volatile_sr = 0;
+            
+            break;
+        }
+        case 0x02 :
+        case 0x32 :
+        case 0x12 :
+        {
+            if ((chip->status1 & 0x02) == 0)
+            {
+                break;
+            }
+            if (chip->suspended != 0)
+            {
+                gs_stats.busy_violation++;
+                
+                break;
+            }
+            base = (addr % chip->size) & (~0xFFU);
+            for (i = 0; i < len; i++)
+            {
+                chip->mem[base + ((addr + i) & 0xFF)] &= data[i];
+            }
+            gs_stats.page_program++;
+            a_emulator_start(chip, EMULATOR_BUSY_PROGRAM, EMULATOR_PAGE_PROGRAM_NS);
+            
+            break;
+        }
+        case 0x20 :
+        case 0x21 :
+        case 0x52 :
+        case 0xD8 :
+        case 0xDC :
+        {
+            if ((chip->status1 & 0x02) == 0)
+            {
+                break;
+            }
+            if (chip->suspended != 0)
+            {
+                gs_stats.busy_violation++;
+                
+                break;
+            }
+            if ((cmd == 0x20) || (cmd == 0x21))
+            {
+                base = (addr % chip->size) & (~0xFFFU);
+                memset(&chip->mem[base], 0xFF, 4096);
+                a_emulator_start(chip, EMULATOR_BUSY_ERASE, EMULATOR_SECTOR_ERASE_NS);
+            }
+            else if (cmd == 0x52)
+            {
+                base = (addr % chip->size) & (~0x7FFFU);
+                memset(&chip->mem[base], 0xFF, 32768);
+                a_emulator_start(chip, EMULATOR_BUSY_ERASE, EMULATOR_BLOCK_ERASE_32K_NS);
+            }
+            else
+            {
+                base = (addr % chip->size) & (~0xFFFFU);
+                memset(&chip->mem[base], 0xFF, 65536);
+                a_emulator_start(chip, EMULATOR_BUSY_ERASE, EMULATOR_BLOCK_ERASE_64K_NS);
+            }
+            gs_stats.erase++;
+            
+            break;
+        }
+        case 0xC7 :
+        case 0x60 :
+        {
+            if (((chip->status1 & 0x02) == 0) || (chip->suspended != 0))
+            {
+                break;
+            }
+            memset(chip->mem, 0xFF, chip->size);
+            gs_stats.erase++;
+            a_emulator_start(chip, EMULATOR_BUSY_ERASE, EMULATOR_CHIP_ERASE_NS);
+            
+            break;
+        }
+        case 0x03 :
+        case 0x0B :
+        case 0x0C :
+        case 0x13 :
+        case 0x3B :
+        case 0x6B :
+        case 0xBB :
+        case 0xEB :
+        case 0xE7 :
+        case 0xE3 :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = chip->mem[(addr + i) % chip->size];
+            }
+            
+            break;
+        }
+        case 0x90 :
+        case 0x92 :
+        case 0x94 :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = (((i + addr) % 2) == 0) ? 0xEF : (uint8_t)(chip->id & 0xFF);
+            }
+            
+            break;
+        }
+        case 0x9F :
+        {
+            for (i = 0; (i < out_len) && (i < 3); i++)
+            {
+                if (i == 0)
+                {
+                    out[i] = 0xEF;
+                }
+                else if (i == 1)
+                {
+                    out[i] = 0x40;
+                }
+                else
+                {
+                    for (base = 0; (1UL << base) < chip->size; base++)
+                    {
+                    }
+                    out[i] = (uint8_t)base;
+                }
+            }
+            
+            break;
+        }
+        case 0xAB :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = (uint8_t)(chip->id & 0xFF);
+            }
+            
+            break;
+        }
+        case 0x4B :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = (uint8_t)(0x10 * index + i);
+            }
+            
+            break;
+        }
+        case 0xB7 :
+        {
+            chip->four_byte = 1;
+            
+            break;
+        }
+        case 0xE9 :
+        {
+            chip->four_byte = 0;
+            
+            break;
+        }
+        case 0xC5 :
+        {
+            if ((len > 0) && ((chip->status1 & 0x02) != 0))
+            {
+                chip->ext_addr = data[0];
+                chip->status1 &= (uint8_t)(~0x02);
+            }
+            
+            break;
+        }
+        case 0xC8 :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = chip->ext_addr;
+            }
+            
+            break;
+        }
+        case 0x44 :
+        case 0x42 :
+        case 0x48 :
+        {
+            reg = (uint8_t)((addr >> 12) & 0x0F);
+            if ((reg < 1) || (reg > 3))
+            {
+                break;
+            }
+            if (cmd == 0x48)
+            {
+                for (i = 0; i < out_len; i++)
+                {
+                    out[i] = chip->security[reg - 1][(addr + i) & 0xFF];
+                }
+            }
+            else if ((chip->status1 & 0x02) != 0)
+            {
+                if (cmd == 0x44)
+                {
+                    memset(chip->security[reg - 1], 0xFF, 256);
+                    a_emulator_start(chip, EMULATOR_BUSY_ERASE, EMULATOR_SECTOR_ERASE_NS);
+                }
+                else
+                {
+                    for (i = 0; i < len; i++)
+                    {
+                        chip->security[reg - 1][(addr + i) & 0xFF] &= data[i];
+                    }
+                    a_emulator_start(chip, EMULATOR_BUSY_PROGRAM, EMULATOR_SECURITY_PROGRAM_NS);
+                }
+            }
+            
+            break;
+        }
+        case 0x5A :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = ((addr + i) < 4) ? (uint8_t)("SFDP"[addr + i]) : 0xFF;
+            }
+            
+            break;
+        }
+        case 0x3D :
+        {
+            for (i = 0; i < out_len; i++)
+            {
+                out[i] = 0x00;
+            }
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     emulator init
+ * @param[in] index chip index
+ * @param[in] id chip id, same as the w25qxx type
+ * @param[in] size flash size in bytes
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the flash starts fully erased
+ */
+uint8_t emulator_init(uint8_t index, uint16_t id, uint32_t size)
+{
+    emulator_chip_t *chip;
+    
+    if ((index >= EMULATOR_MAX_CHIP) || (size < 65536) || ((size % 65536) != 0))
+    {
+        return 1;
+    }
+    chip = &gs_chip[index];
+    free(chip->mem);
+    memset(chip, 0, sizeof(emulator_chip_t));
+    chip->mem = (uint8_t *)malloc(size);
+    if (chip->mem == NULL)
+    {
+        return 1;
+    }
+    
+    /* the flash starts erased */
+    memset(chip->mem, 0xFF, size);
+    memset(chip->security, 0xFF, sizeof(chip->security));
+    chip->size = size;
+    chip->id = id;
+    
+    return 0;
+}
+
+/**
+ * @brief     emulator deinit
+ * @param[in] index chip index
+ * @note      none
+ */
+void emulator_deinit(uint8_t index)
+{
+    if (index < EMULATOR_MAX_CHIP)
+    {
+        free(gs_chip[index].mem);
+        memset(&gs_chip[index], 0, sizeof(emulator_chip_t));
+    }
+}
+
+/**
+ * @brief     set the emulated bus clock
+ * @param[in] clock_hz bus clock in hz
+ * @param[in] overhead_ns fixed cost of one transaction in ns
+ * @note      default is 1 MHz and 10 us, a clock above EMULATOR_MAX_CLOCK_HZ is clamped to it
+ */
+void emulator_set_clock(uint32_t clock_hz, uint32_t overhead_ns)
+{
+    gs_clock_hz = (clock_hz != 0) ? clock_hz : 1;
+    gs_clock_hz = (gs_clock_hz > EMULATOR_MAX_CLOCK_HZ) ? EMULATOR_MAX_CLOCK_HZ : gs_clock_hz;
+    gs_overhead_ns = overhead_ns;
+}
+
+/**
+ * @brief  begin a batch of transactions
+ * @note   the transactions until emulator_batch_end pay the fixed overhead once,
+ *         like frames sent with one system call
+ */
+void emulator_batch_begin(void)
+{
+    gs_batch = 1;
+}
+
+/**
+ * @brief  end a batch of transactions
+ * @note   none
+ */
+void emulator_batch_end(void)
+{
+    gs_batch = 0;
+}
+
+/**
+ * @brief      get the memory of one chip
+ * @param[in]  index chip index
+ * @param[out] *size pointer to a size buffer
+ * @return     pointer to the memory
+ * @note       none
+ */
+uint8_t *emulator_get_memory(uint8_t index, uint32_t *size)
+{
+    if (index >= EMULATOR_MAX_CHIP)
+    {
+        *size = 0;
+        
+        return NULL;
+    }
+    *size = gs_chip[index].size;
+    
+    return gs_chip[index].mem;
+}
+
+/**
+ * @brief      get the statistics
+ * @param[out] *stats pointer to an emulator stats structure
+ * @note       none
+ */
+void emulator_get_stats(emulator_stats_t *stats)
+{
+    memcpy(stats, &gs_stats, sizeof(emulator_stats_t));
+}
+
+/**
+ * @brief emulator clear statistics
+ * @note  none
+ */
+void emulator_clear_stats(void)
+{
+    memset(&gs_stats, 0, sizeof(emulator_stats_t));
+}
+
+/**
+ * @brief  get the virtual time
+ * @return virtual time in ns
+ * @note   the time only moves with bus transfers and delays
+ */
+uint64_t emulator_get_time_ns(void)
+{
+    return gs_time_ns;
+}
+
+/**
+ * @brief      emulated bus write read
+ * @param[in]  index chip index
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       none
+ */
+uint8_t emulator_write_read(uint8_t index, uint8_t instruction, uint8_t instruction_line,
+                            uint32_t address, uint8_t address_line, uint8_t address_len,
+                            uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                            uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                            uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    emulator_chip_t *chip;
+    uint64_t cycles;
+    uint8_t cmd;
+    uint8_t width;
+    uint32_t addr;
+    uint32_t pos;
+    uint32_t i;
+    
+    (void)alternate;
+    if ((index >= EMULATOR_MAX_CHIP) || (gs_chip[index].mem == NULL))
+    {
+        return 1;
+    }
+    chip = &gs_chip[index];
+    
+    /* account the bus time of every phase */
+    cycles = 0;
+    if (instruction_line != 0)
+    {
+        cycles += 8 / instruction_line;
+    }
+    if (address_line != 0)
+    {
+        cycles += (uint64_t)address_len * 8 / address_line;
+    }
+    if (alternate_line != 0)
+    {
+        cycles += (uint64_t)alternate_len * 8 / alternate_line;
+    }
+    cycles += dummy;
+    if (data_line != 0)
+    {
+        cycles += ((uint64_t)in_len + out_len) * 8 / data_line;
+    }
+    gs_time_ns += cycles * 1000000000ULL / gs_clock_hz;
+    if (gs_batch != 2)
+    {
+        gs_time_ns += gs_overhead_ns;
+    }
+    if (gs_batch == 1)
+    {
+        gs_batch = 2;
+    }
+    gs_stats.transaction++;
+    gs_stats.bus_bytes += (cycles + 7) / 8;
+    gs_stats.bus_ns += cycles * 1000000000ULL / gs_clock_hz;
+    
+    /* the bus floats high when nothing drives it */
+    if ((out_buf != NULL) && (out_len != 0))
+    {
+        memset(out_buf, 0xFF, out_len);
+    }
+    else
+    {
+        out_len = 0;
+    }
+    
+    if (instruction_line != 0)
+    {
+        /* structured qspi frame */
+        cmd = instruction;
+        addr = address;
+        if ((address_len == 3) && (chip->four_byte == 0))
+        {
+            addr |= (uint32_t)chip->ext_addr << 24;
+        }
+        a_emulator_execute(chip, index, cmd, addr, in_buf, (in_buf != NULL) ? in_len : 0, out_buf, out_len);
+    }
+    else
+    {
+        /* raw spi frame */
+        if ((in_buf == NULL) || (in_len == 0))
+        {
+            return 1;
+        }
+        cmd = in_buf[0];
+        pos = 1;
+        addr = 0;
+        width = a_emulator_address_width(chip, cmd);
+        for (i = 0; (i < width) && (pos < in_len); i++)
+        {
+            addr = (addr << 8) | in_buf[pos++];
+        }
+        if ((width == 3) && (cmd != 0x90) && (cmd != 0x5A))
+        {
+            addr |= (uint32_t)chip->ext_addr << 24;
+        }
+        pos += a_emulator_dummy_bytes(cmd);
+        a_emulator_execute(chip, index, cmd, addr, (pos < in_len) ? &in_buf[pos] : NULL,
+                           (pos < in_len) ? (in_len - pos) : 0, out_buf, out_len);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  emulator spi qspi bus init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t emulator_spi_qspi_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  emulator spi qspi bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t emulator_spi_qspi_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      emulator chip 0 spi qspi bus write read
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       none
+ */
+uint8_t emulator_spi_qspi_write_read(uint8_t instruction, uint8_t instruction_line,
+                                     uint32_t address, uint8_t address_line, uint8_t address_len,
+                                     uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                     uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                     uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    return emulator_write_read(0, instruction, instruction_line, address, address_line, address_len,
+                               alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                               out_buf, out_len, data_line);
+}
+
+/**
+ * @brief     emulator delay ms
+ * @param[in] ms time
+ * @note      advances the virtual time only
+ */
+void emulator_delay_ms(uint32_t ms)
+{
+    gs_time_ns += (uint64_t)ms * 1000000ULL;
+}
+
+/**
+ * @brief     emulator delay us
+ * @param[in] us time
+ * @note      advances the virtual time only
+ */
+void emulator_delay_us(uint32_t us)
+{
+    gs_time_ns += (uint64_t)us * 1000ULL;
+}
+
+/**
+ * @brief     emulator print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void emulator_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256);
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)printf("%s", str);
+}
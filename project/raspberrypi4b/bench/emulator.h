@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      emulator.h
+ * @brief     w25qxx emulator header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef EMULATOR_H
+#define EMULATOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup emulator emulator function
+ * @brief    ram backed w25qxx emulator modules
+ * @{
+ */
+
+/**
+ * @brief emulator max chip definition
+ */
+#define EMULATOR_MAX_CHIP                   4
+
+/**
+ * @brief emulator max clock definition
+ */
+#define EMULATOR_MAX_CLOCK_HZ               (104UL * 1000UL * 1000UL)            /**< 104 MHz, fast read limit of the parts */
+
+/**
+ * @brief emulator typical timing definition
+ */
+#define EMULATOR_PAGE_PROGRAM_NS            (400ULL * 1000ULL)                  /**< 0.4 ms */
+#define EMULATOR_SECTOR_ERASE_NS            (45ULL * 1000ULL * 1000ULL)         /**< 45 ms */
+#define EMULATOR_BLOCK_ERASE_32K_NS         (120ULL * 1000ULL * 1000ULL)        /**< 120 ms */
+#define EMULATOR_BLOCK_ERASE_64K_NS         (150ULL * 1000ULL * 1000ULL)        /**< 150 ms */
+#define EMULATOR_CHIP_ERASE_NS              (10000ULL * 1000ULL * 1000ULL)      /**< 10 s */
+#define EMULATOR_WRITE_STATUS_NS            (10ULL * 1000ULL * 1000ULL)         /**< 10 ms */
+#define EMULATOR_SECURITY_PROGRAM_NS        (400ULL * 1000ULL)                  /**< 0.4 ms */
+
+/**
+ * @brief emulator statistics structure definition
+ */
+typedef struct emulator_stats_s
+{
+    uint32_t transaction;           /**< bus transactions */
+    uint64_t bus_bytes;             /**< bytes clocked on the bus */
+    uint64_t bus_ns;                /**< time spent on the bus */
+    uint32_t status_poll;           /**< status register reads */
+    uint32_t page_program;          /**< page program commands */
+    uint32_t erase;                 /**< erase commands */
+    uint32_t busy_violation;        /**< commands ignored because the chip was busy */
+} emulator_stats_t;
+
+/**
+ * @brief     emulator init
+ * @param[in] index chip index
+ * @param[in] id chip id, same as the w25qxx type
+ * @param[in] size flash size in bytes
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the flash starts fully erased
+ */
+uint8_t emulator_init(uint8_t index, uint16_t id, uint32_t size);
+
+/**
+ * @brief     emulator deinit
+ * @param[in] index chip index
+ * @note      none
+ */
+void emulator_deinit(uint8_t index);
+
+/**
+ * @brief     set the emulated bus clock
+ * @param[in] clock_hz bus clock in hz
+ * @param[in] overhead_ns fixed cost of one transaction in ns
+ * @note      default is 1 MHz and 10 us, a clock above EMULATOR_MAX_CLOCK_HZ is clamped to it
+ */
+void emulator_set_clock(uint32_t clock_hz, uint32_t overhead_ns);
+
+/**
+ * @brief  begin a batch of transactions
+ * @note   the transactions until emulator_batch_end pay the fixed overhead once,
+ *         like frames sent with one system call
+ */
+void emulator_batch_begin(void);
+
+/**
+ * @brief  end a batch of transactions
+ * @note   none
+ */
+void emulator_batch_end(void);
+
+/**
+ * @brief      get the memory of one chip
+ * @param[in]  index chip index
+ * @param[out] *size pointer to a size buffer
+ * @return     pointer to the memory
+ * @note       none
+ */
+uint8_t *emulator_get_memory(uint8_t index, uint32_t *size);
+
+/**
+ * @brief      get the statistics
+ * @param[out] *stats pointer to an emulator stats structure
+ * @note       none
+ */
+void emulator_get_stats(emulator_stats_t *stats);
+
+/**
+ * @brief emulator clear statistics
+ * @note  none
+ */
+void emulator_clear_stats(void);
+
+/**
+ * @brief  get the virtual time
+ * @return virtual time in ns
+ * @note   the time only moves with bus transfers and delays
+ */
+uint64_t emulator_get_time_ns(void);
+
+/**
+ * @brief      emulated bus write read
+ * @param[in]  index chip index
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       none
+ */
+uint8_t emulator_write_read(uint8_t index, uint8_t instruction, uint8_t instruction_line,
+                            uint32_t address, uint8_t address_line, uint8_t address_len,
+                            uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                            uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                            uint8_t *out_buf, uint32_t out_len, uint8_t data_line);
+
+/**
+ * @brief  emulator spi qspi bus init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t emulator_spi_qspi_init(void);
+
+/**
+ * @brief  emulator spi qspi bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t emulator_spi_qspi_deinit(void);
+
+/**
+ * @brief      emulator chip 0 spi qspi bus write read
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       none
+ */
+uint8_t emulator_spi_qspi_write_read(uint8_t instruction, uint8_t instruction_line,
+                                     uint32_t address, uint8_t address_line, uint8_t address_len,
+                                     uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                     uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                     uint8_t *out_buf, uint32_t out_len, uint8_t data_line);
+
+/**
+ * @brief     emulator delay ms
+ * @param[in] ms time
+ * @note      advances the virtual time only
+ */
+void emulator_delay_ms(uint32_t ms);
+
+/**
+ * @brief     emulator delay us
+ * @param[in] us time
+ * @note      advances the virtual time only
+ */
+void emulator_delay_us(uint32_t us);
+
+/**
+ * @brief     emulator print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void emulator_debug_print(const char *const fmt, ...);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      raspberrypi4b_driver_w25qxx_interface.h
+ * @brief     raspberrypi4b driver w25qxx interface header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RASPBERRYPI4B_DRIVER_W25QXX_INTERFACE_H
+#define RASPBERRYPI4B_DRIVER_W25QXX_INTERFACE_H
+
+#include "driver_w25qxx_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup raspberrypi4b_w25qxx_interface raspberrypi4b w25qxx interface function
+ * @brief    raspberrypi4b w25qxx interface modules
+ * @ingroup  w25qxx_interface_driver
+ * @{
+ */
+
+/**
+ * @brief spi clock definition
+ */
+#define W25QXX_INTERFACE_SPI_CLOCK_DEFAULT        (1000 * 1000)              /**< 1 MHz */
+#define W25QXX_INTERFACE_SPI_CLOCK_MAX            (104 * 1000 * 1000)        /**< 104 MHz, fast read limit of the parts */
+#define W25QXX_INTERFACE_SPI_CLOCK_ENV            "W25QXX_SPI_CLOCK"         /**< environment variable of the clock in Hz */
+
+/**
+ * @brief      interface parse a spi clock
+ * @param[in]  *str pointer to a clock string in Hz
+ * @param[out] *hz pointer to a clock buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 clock is invalid
+ * @note       decimal, 0x hex or 0 octal, a string not starting with a digit, trailing
+ *             characters and 0 are rejected, a clock above W25QXX_INTERFACE_SPI_CLOCK_MAX
+ *             is clamped to it
+ */
+uint8_t w25qxx_interface_spi_parse_clock(const char *str, uint32_t *hz);
+
+/**
+ * @brief     interface set the spi clock
+ * @param[in] hz spi clock in Hz, 0 goes back to the environment or the default
+ * @note      takes effect at the next spi qspi init, a clock set here wins over
+ *            W25QXX_SPI_CLOCK and that wins over the 1 MHz default, a clock above
+ *            W25QXX_INTERFACE_SPI_CLOCK_MAX is clamped to it
+ */
+void w25qxx_interface_spi_set_clock(uint32_t hz);
+
+/**
+ * @brief  interface get the spi clock
+ * @return spi clock in Hz used by the next spi qspi init
+ * @note   none
+ */
+uint32_t w25qxx_interface_spi_get_clock(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -34,7 +34,7 @@
  * </table>
  */
 
-#include "driver_w25qxx_interface.h"
+#include "raspberrypi4b_driver_w25qxx_interface.h"
 #include "spi.h"
 #include <stdarg.h>
 
@@ -48,6 +48,148 @@
  */
 static int gs_fd;                           /**< spi handle */
 
+/**
+ * @brief spi clock definition
+ */
+static uint32_t gs_clock = 0;               /**< spi clock set by the api, 0 if none */
+
+/**
+ * @brief      interface parse a spi clock
+ * @param[in]  *str pointer to a clock string in Hz
+ * @param[out] *hz pointer to a clock buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 clock is invalid
+ * @note       decimal, 0x hex or 0 octal, a string not starting with a digit, trailing
+ *             characters and 0 are rejected, a clock above W25QXX_INTERFACE_SPI_CLOCK_MAX
+ *             is clamped to it
+ */
+uint8_t w25qxx_interface_spi_parse_clock(const char *str, uint32_t *hz)
+{
+    char *end;
+    unsigned long value;
+    
+    if ((str == NULL) || (str[0] < '0') || (str[0] > '9'))
+    {
+        return 1;
+    }
+    value = strtoul(str, &end, 0);
+    if ((*end != '\0') || (value == 0))
+    {
+        return 1;
+    }
+    *hz = (value > W25QXX_INTERFACE_SPI_CLOCK_MAX) ? W25QXX_INTERFACE_SPI_CLOCK_MAX : (uint32_t)value;
+    
+    return 0;
+}
+
+/**
+ * @brief     interface set the spi clock
+ * @param[in] hz spi clock in Hz, 0 goes back to the environment or the default
+ * @note      takes effect at the next spi qspi init, a clock set here wins over
+ *            W25QXX_SPI_CLOCK and that wins over the 1 MHz default, a clock above
+ *            W25QXX_INTERFACE_SPI_CLOCK_MAX is clamped to it
+ */
+void w25qxx_interface_spi_set_clock(uint32_t hz)
+{
+    gs_clock = (hz > W25QXX_INTERFACE_SPI_CLOCK_MAX) ? W25QXX_INTERFACE_SPI_CLOCK_MAX : hz;
+}
+
+/**
+ * @brief  interface get the spi clock
+ * @return spi clock in Hz used by the next spi qspi init
+ * @note   none
+ */
+uint32_t w25qxx_interface_spi_get_clock(void)
+{
+    uint32_t hz;
+    
+    if (gs_clock != 0)
+    {
+        return gs_clock;
+    }
+    if (w25qxx_interface_spi_parse_clock(getenv(W25QXX_INTERFACE_SPI_CLOCK_ENV), &hz) == 0)
+    {
+        return hz;
+    }
+    
+    return W25QXX_INTERFACE_SPI_CLOCK_DEFAULT;
+}
+
+/**
+ * @brief      interface spi read in several frames
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a read longer than the spidev bufsiz is sent as several complete read
+ *             commands, each one at the address the previous one stopped
+ */
+static uint8_t a_w25qxx_interface_spi_read_split(uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len)
+{
+    uint8_t cmd[6];
+    uint32_t addr_len;
+    uint32_t addr;
+    uint32_t room;
+    uint32_t len;
+    uint32_t i;
+    
+    /* read data has no dummy byte, fast read, security register and sfdp reads have one */
+    if ((in_buf[0] == 0x03) && (in_len >= 4) && (in_len <= 5))
+    {
+        addr_len = in_len - 1;
+    }
+    else if (((in_buf[0] == 0x0B) || (in_buf[0] == 0x48) || (in_buf[0] == 0x5A)) &&
+             (in_len >= 5) && (in_len <= 6))
+    {
+        addr_len = in_len - 2;
+    }
+    else
+    {
+        w25qxx_interface_debug_print("w25qxx: command 0x%02X is over the spi bufsiz.\n", in_buf[0]);
+        
+        return 1;
+    }
+    if (spi_get_bufsiz() <= in_len)
+    {
+        return 1;
+    }
+    room = spi_get_bufsiz() - in_len;
+    memcpy(cmd, in_buf, in_len);
+    addr = 0;
+    for (i = 0; i < addr_len; i++)
+    {
+        addr = (addr << 8) | in_buf[1 + i];
+    }
+    while (out_len > 0)
+    {
+        /* a 3 bytes address can't go past its 16MB bank */
+        if ((addr_len == 3) && (addr > 0xFFFFFF))
+        {
+            w25qxx_interface_debug_print("w25qxx: read crosses the 3 bytes address bank.\n");
+            
+            return 1;
+        }
+        for (i = 0; i < addr_len; i++)
+        {
+            cmd[addr_len - i] = (uint8_t)(addr >> (8 * i));
+        }
+        len = (out_len > room) ? room : out_len;
+        if (spi_write_read(gs_fd, cmd, in_len, out_buf, len) != 0)
+        {
+            return 1;
+        }
+        addr += len;
+        out_buf += len;
+        out_len -= len;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  interface spi qspi bus init
  * @return status code
@@ -57,7 +199,7 @@ static int gs_fd;                           /**< spi handle */
  */
 uint8_t w25qxx_interface_spi_qspi_init(void)
 {
-    return spi_init(SPI_DEVICE_NAME, &gs_fd, SPI_MODE_TYPE_3, 1000 * 1000);
+    return spi_init(SPI_DEVICE_NAME, &gs_fd, SPI_MODE_TYPE_3, w25qxx_interface_spi_get_clock());
 }
 
 /**
@@ -103,10 +245,47 @@ uint8_t w25qxx_interface_spi_qspi_write_read(uint8_t instruction, uint8_t instru
     {
         return 1;
     }
+    if ((in_len > 0) && ((in_len + out_len) > spi_get_bufsiz()))
+    {
+        return a_w25qxx_interface_spi_read_split(in_buf, in_len, out_buf, out_len);
+    }
     
     return spi_write_read(gs_fd, in_buf, in_len, out_buf, out_len);
 }
 
+/**
+ * @brief      interface spi bus batch write read
+ * @param[in]  *transfer pointer to a w25qxx spi transfer array
+ * @param[in]  num transfer number
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       every transfer is one chip select frame, optional, a port implementing it
+ *             sets W25QXX_INTERFACE_SPI_BATCH to 1 so the examples link it
+ */
+uint8_t w25qxx_interface_spi_batch(w25qxx_spi_transfer_t *transfer, uint8_t num)
+{
+    uint8_t *in_buf[SPI_MAX_BATCH];
+    uint32_t in_len[SPI_MAX_BATCH];
+    uint8_t *out_buf[SPI_MAX_BATCH];
+    uint32_t out_len[SPI_MAX_BATCH];
+    uint8_t i;
+    
+    if (num > SPI_MAX_BATCH)
+    {
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        in_buf[i] = transfer[i].in_buf;
+        in_len[i] = transfer[i].in_len;
+        out_buf[i] = transfer[i].out_buf;
+        out_len[i] = transfer[i].out_len;
+    }
+    
+    return spi_write_read_batch(gs_fd, in_buf, in_len, out_buf, out_len, num);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
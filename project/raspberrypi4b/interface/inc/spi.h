@@ -54,6 +54,17 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief spi max batch definition
+ */
+#define SPI_MAX_BATCH        8        /**< 8 frames */
+
+/**
+ * @brief spi buffer size definition
+ */
+#define SPI_DEFAULT_BUFSIZ        4096                                        /**< spidev default bufsiz */
+#define SPI_BUFSIZ_PATH           "/sys/module/spidev/parameters/bufsiz"      /**< spidev bufsiz parameter */
+
 /**
  * @brief spi mode type enumeration definition
  */
@@ -88,6 +99,13 @@ uint8_t spi_init(char *name, int *fd, spi_mode_type_t mode, uint32_t freq);
  */
 uint8_t spi_deinit(int fd);
 
+/**
+ * @brief  get the spidev buffer size
+ * @return bytes of one ioctl
+ * @note   read at spi init
+ */
+uint32_t spi_get_bufsiz(void);
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -174,10 +192,28 @@ uint8_t spi_write_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len);
  * @return     status code
  *             - 0 success
  *             - 1 write read failed
- * @note       none
+ * @note       in_len + out_len is at most the spidev bufsiz, a longer frame can't
+ *             keep its chip select across ioctls and fails
  */
 uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len);
 
+/**
+ * @brief      spi bus write read of several chip select frames
+ * @param[in]  fd spi handle
+ * @param[in]  **in_buf pointer to the input buffers of every frame
+ * @param[in]  *in_len pointer to the input lengths of every frame
+ * @param[out] **out_buf pointer to the output buffers of every frame
+ * @param[in]  *out_len pointer to the output lengths of every frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       all frames go out with one ioctl, the chip select is released between
+ *             frames, num is at most SPI_MAX_BATCH and an out_len may be 0
+ */
+uint8_t spi_write_read_batch(int fd, uint8_t **in_buf, uint32_t *in_len,
+                             uint8_t **out_buf, uint32_t *out_len, uint8_t num);
+
 /**
  * @brief      spi transmit
  * @param[in]  fd spi handle
@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      queue_worker.c
+ * @brief     queue worker source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "queue_worker.h"
+#include <pthread.h>
+
+/**
+ * @brief worker global variables definition
+ */
+static pthread_t gs_thread;                                        /**< worker thread */
+static pthread_mutex_t gs_list_mutex = PTHREAD_MUTEX_INITIALIZER;  /**< pending list mutex */
+static pthread_mutex_t gs_wait_mutex = PTHREAD_MUTEX_INITIALIZER;  /**< wake up mutex */
+static pthread_cond_t gs_wait_cond = PTHREAD_COND_INITIALIZER;     /**< wake up condition */
+static w25qxx_queue_t *gs_queue = NULL;                            /**< running queue */
+static uint8_t gs_pending = 0;                                     /**< submit flag */
+static uint8_t gs_stop = 0;                                        /**< stop flag */
+
+/**
+ * @brief queue lock hook
+ * @note  none
+ */
+static void a_queue_worker_lock(void)
+{
+    (void)pthread_mutex_lock(&gs_list_mutex);
+}
+
+/**
+ * @brief queue unlock hook
+ * @note  none
+ */
+static void a_queue_worker_unlock(void)
+{
+    (void)pthread_mutex_unlock(&gs_list_mutex);
+}
+
+/**
+ * @brief queue notify hook
+ * @note  none
+ */
+static void a_queue_worker_notify(void)
+{
+    (void)pthread_mutex_lock(&gs_wait_mutex);
+    gs_pending = 1;
+    (void)pthread_cond_signal(&gs_wait_cond);
+    (void)pthread_mutex_unlock(&gs_wait_mutex);
+}
+
+/**
+ * @brief     worker thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      the submit flag is cleared before the queue is drained, so a
+ *            request submitted while draining always wakes the next round
+ */
+static void *a_queue_worker_thread(void *arg)
+{
+    uint32_t count;
+    
+    (void)arg;
+    while (1)
+    {
+        (void)pthread_mutex_lock(&gs_wait_mutex);
+        while ((gs_pending == 0) && (gs_stop == 0))
+        {
+            (void)pthread_cond_wait(&gs_wait_cond, &gs_wait_mutex);
+        }
+        if (gs_pending == 0)
+        {
+            (void)pthread_mutex_unlock(&gs_wait_mutex);
+            
+            break;
+        }
+        gs_pending = 0;
+        (void)pthread_mutex_unlock(&gs_wait_mutex);
+        
+        /* run until the queue is empty */
+        do
+        {
+            if (w25qxx_queue_run(gs_queue, &count) != 0)
+            {
+                count = 0;
+            }
+        } while (count != 0);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     start the worker thread
+ * @param[in] *queue pointer to an initialized w25qxx queue structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the worker links the queue hooks and runs the queue whenever
+ *            a request is submitted, only one worker can run at a time
+ */
+uint8_t queue_worker_start(w25qxx_queue_t *queue)
+{
+    if ((queue == NULL) || (gs_queue != NULL))
+    {
+        return 1;
+    }
+    
+    /* link the hooks */
+    if (w25qxx_queue_set_hooks(queue, a_queue_worker_lock, a_queue_worker_unlock, a_queue_worker_notify) != 0)
+    {
+        return 1;
+    }
+    gs_queue = queue;
+    gs_pending = 1;
+    gs_stop = 0;
+    
+    /* create the thread */
+    if (pthread_create(&gs_thread, NULL, a_queue_worker_thread, NULL) != 0)
+    {
+        (void)w25qxx_queue_set_hooks(queue, NULL, NULL, NULL);
+        gs_queue = NULL;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  stop the worker thread
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   the requests submitted before the stop are completed first
+ */
+uint8_t queue_worker_stop(void)
+{
+    if (gs_queue == NULL)
+    {
+        return 1;
+    }
+    
+    /* wake and join the thread */
+    (void)pthread_mutex_lock(&gs_wait_mutex);
+    gs_stop = 1;
+    (void)pthread_cond_signal(&gs_wait_cond);
+    (void)pthread_mutex_unlock(&gs_wait_mutex);
+    if (pthread_join(gs_thread, NULL) != 0)
+    {
+        return 1;
+    }
+    (void)w25qxx_queue_set_hooks(gs_queue, NULL, NULL, NULL);
+    gs_queue = NULL;
+    
+    return 0;
+}
@@ -39,6 +39,32 @@
 #include <sys/ioctl.h>
 #include <fcntl.h>
 
+/**
+ * @brief spi buffer size definition
+ */
+static uint32_t gs_bufsiz = SPI_DEFAULT_BUFSIZ;        /**< bytes of one ioctl */
+
+/**
+ * @brief read the spidev buffer size
+ * @note  keeps the 4096 default when the module parameter can't be read
+ */
+static void a_spi_load_bufsiz(void)
+{
+    FILE *fp;
+    unsigned long bufsiz;
+    
+    fp = fopen(SPI_BUFSIZ_PATH, "r");
+    if (fp == NULL)
+    {
+        return;
+    }
+    if ((fscanf(fp, "%lu", &bufsiz) == 1) && (bufsiz != 0))
+    {
+        gs_bufsiz = (uint32_t)bufsiz;
+    }
+    (void)fclose(fp);
+}
+
 /**
  * @brief      spi bus init
  * @param[in]  *name pointer to a spi device name buffer
@@ -132,6 +158,9 @@ uint8_t spi_init(char *name, int *fd, spi_mode_type_t mode, uint32_t freq)
             return 1;
         }
         
+        /* get the max bytes of one ioctl */
+        a_spi_load_bufsiz();
+        
         return 0;
     }
 }
@@ -159,6 +188,16 @@ uint8_t spi_deinit(int fd)
     }
 }
 
+/**
+ * @brief  get the spidev buffer size
+ * @return bytes of one ioctl
+ * @note   read at spi init
+ */
+uint32_t spi_get_bufsiz(void)
+{
+    return gs_bufsiz;
+}
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -415,11 +454,18 @@ uint8_t spi_write_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len)
  * @return     status code
  *             - 0 success
  *             - 1 write read failed
- * @note       none
+ * @note       in_len + out_len is at most the spidev bufsiz, a longer frame can't
+ *             keep its chip select across ioctls and fails
  */
 uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len)
 {
-    if ((in_len > 0) && (out_len > 0))
+    if ((in_len + out_len) > gs_bufsiz)
+    {
+        perror("spi: length is over the bufsiz.\n");
+        
+        return 1;
+    }
+    else if ((in_len > 0) && (out_len > 0))
     {
         struct spi_ioc_transfer k[2];
         int l;
@@ -476,6 +522,91 @@ uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_bu
     }
 }
 
+/**
+ * @brief      spi bus write read of several chip select frames
+ * @param[in]  fd spi handle
+ * @param[in]  **in_buf pointer to the input buffers of every frame
+ * @param[in]  *in_len pointer to the input lengths of every frame
+ * @param[out] **out_buf pointer to the output buffers of every frame
+ * @param[in]  *out_len pointer to the output lengths of every frame
+ * @param[in]  num frame number
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       all frames go out with one ioctl, the chip select is released between
+ *             frames, num is at most SPI_MAX_BATCH and an out_len may be 0
+ */
+uint8_t spi_write_read_batch(int fd, uint8_t **in_buf, uint32_t *in_len,
+                             uint8_t **out_buf, uint32_t *out_len, uint8_t num)
+{
+    struct spi_ioc_transfer k[SPI_MAX_BATCH * 2];
+    uint32_t total;
+    uint8_t n;
+    uint8_t i;
+    int l;
+    
+    if ((num == 0) || (num > SPI_MAX_BATCH))
+    {
+        return 1;
+    }
+    
+    /* clear ioc transfer */
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * SPI_MAX_BATCH * 2);
+    
+    /* every frame is a write and an optional read */
+    n = 0;
+    total = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (in_len[i] == 0)
+        {
+            return 1;
+        }
+        k[n].tx_buf = (unsigned long)in_buf[i];
+        k[n].len = in_len[i];
+        total += in_len[i];
+        n++;
+        if ((out_buf[i] != NULL) && (out_len[i] > 0))
+        {
+            k[n].rx_buf = (unsigned long)out_buf[i];
+            k[n].len = out_len[i];
+            total += out_len[i];
+            n++;
+        }
+        
+        /* release the chip select after every frame but the last */
+        if (i != (num - 1))
+        {
+            k[n - 1].cs_change = 1;
+        }
+    }
+    
+    /* one ioctl can't hold the frames */
+    if (total > gs_bufsiz)
+    {
+        for (i = 0; i < num; i++)
+        {
+            if (spi_write_read(fd, in_buf[i], in_len[i], out_buf[i], out_len[i]) != 0)
+            {
+                return 1;
+            }
+        }
+        
+        return 0;
+    }
+    
+    /* transmit */
+    l = ioctl(fd, SPI_IOC_MESSAGE(n), &k);
+    if ((l < 0) || ((uint32_t)l != total))
+    {
+        perror("spi: length check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief      spi transmit
  * @param[in]  fd spi handle
@@ -0,0 +1,1148 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      nbd.c
+ * @brief     w25qxx network block device server source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx.h"
+#include "raspberrypi4b_driver_w25qxx_interface.h"
+#include "emulator.h"
+#include <getopt.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief nbd magic definition
+ */
+#define NBD_MAGIC                  0x4E42444D41474943ULL        /**< "NBDMAGIC" */
+#define NBD_OPTS_MAGIC             0x49484156454F5054ULL        /**< "IHAVEOPT" */
+#define NBD_REP_MAGIC              0x0003E889045565A9ULL        /**< option reply magic */
+#define NBD_REQUEST_MAGIC          0x25609513U                  /**< request magic */
+#define NBD_SIMPLE_REPLY_MAGIC     0x67446698U                  /**< simple reply magic */
+
+/**
+ * @brief nbd handshake flag definition
+ */
+#define NBD_FLAG_FIXED_NEWSTYLE    (1 << 0)        /**< fixed newstyle */
+#define NBD_FLAG_NO_ZEROES         (1 << 1)        /**< no zeroes */
+
+/**
+ * @brief nbd transmission flag definition
+ */
+#define NBD_FLAG_HAS_FLAGS         (1 << 0)        /**< has flags */
+#define NBD_FLAG_SEND_FLUSH        (1 << 2)        /**< send flush */
+#define NBD_FLAG_SEND_TRIM         (1 << 5)        /**< send trim */
+
+/**
+ * @brief nbd option definition
+ */
+#define NBD_OPT_EXPORT_NAME        1        /**< export name */
+#define NBD_OPT_ABORT              2        /**< abort */
+#define NBD_OPT_LIST               3        /**< list */
+#define NBD_OPT_INFO               6        /**< info */
+#define NBD_OPT_GO                 7        /**< go */
+
+/**
+ * @brief nbd option reply definition
+ */
+#define NBD_REP_ACK                1                        /**< ack */
+#define NBD_REP_SERVER             2                        /**< server */
+#define NBD_REP_INFO               3                        /**< info */
+#define NBD_REP_ERR_UNSUP          ((1U << 31) + 1)         /**< unsupported option */
+#define NBD_INFO_EXPORT            0                        /**< export info */
+#define NBD_INFO_BLOCK_SIZE        3                        /**< block size info */
+
+/**
+ * @brief nbd command definition
+ */
+#define NBD_CMD_READ               0        /**< read */
+#define NBD_CMD_WRITE              1        /**< write */
+#define NBD_CMD_DISC               2        /**< disconnect */
+#define NBD_CMD_FLUSH              3        /**< flush */
+#define NBD_CMD_TRIM               4        /**< trim */
+
+/**
+ * @brief nbd merge definition
+ */
+#define NBD_MAX_MERGE              32                   /**< requests in one merged operation */
+#define NBD_BUFFER_SIZE            (1024 * 1024)        /**< bytes in one merged operation */
+
+/**
+ * @brief nbd request structure definition
+ */
+typedef struct nbd_request_s
+{
+    uint16_t type;          /**< command type */
+    uint64_t cookie;        /**< request handle */
+    uint64_t offset;        /**< device offset */
+    uint32_t length;        /**< data length */
+} nbd_request_t;
+
+/**
+ * @brief nbd stats structure definition
+ */
+typedef struct nbd_stats_s
+{
+    uint32_t request;        /**< received requests */
+    uint32_t operation;      /**< driver operations */
+    uint32_t merged;         /**< requests folded into another one */
+    uint32_t erase;          /**< erased sectors and blocks */
+} nbd_stats_t;
+
+static w25qxx_handle_t gs_handle;                   /**< w25qxx handle */
+static uint64_t gs_size;                            /**< export size */
+static nbd_stats_t gs_stats;                        /**< statistics */
+static uint8_t gs_buf[NBD_BUFFER_SIZE];             /**< merge buffer */
+static volatile sig_atomic_t gs_stop = 0;           /**< stop flag */
+
+/**
+ * @brief     stop signal handler
+ * @param[in] sig signal number
+ * @note      none
+ */
+static void a_nbd_signal(int sig)
+{
+    (void)sig;
+    gs_stop = 1;
+}
+
+/**
+ * @brief     put a big endian 16 bits value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_nbd_put_u16(uint8_t *buf, uint16_t v)
+{
+    buf[0] = (v >> 8) & 0xFF;
+    buf[1] = (v >> 0) & 0xFF;
+}
+
+/**
+ * @brief     put a big endian 32 bits value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_nbd_put_u32(uint8_t *buf, uint32_t v)
+{
+    a_nbd_put_u16(buf, (uint16_t)(v >> 16));
+    a_nbd_put_u16(buf + 2, (uint16_t)(v & 0xFFFF));
+}
+
+/**
+ * @brief     put a big endian 64 bits value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_nbd_put_u64(uint8_t *buf, uint64_t v)
+{
+    a_nbd_put_u32(buf, (uint32_t)(v >> 32));
+    a_nbd_put_u32(buf + 4, (uint32_t)(v & 0xFFFFFFFFU));
+}
+
+/**
+ * @brief     get a big endian 16 bits value
+ * @param[in] *buf pointer to a buffer
+ * @return    value
+ * @note      none
+ */
+static uint16_t a_nbd_get_u16(const uint8_t *buf)
+{
+    return (uint16_t)(((uint16_t)buf[0] << 8) | buf[1]);
+}
+
+/**
+ * @brief     get a big endian 32 bits value
+ * @param[in] *buf pointer to a buffer
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_nbd_get_u32(const uint8_t *buf)
+{
+    return ((uint32_t)a_nbd_get_u16(buf) << 16) | a_nbd_get_u16(buf + 2);
+}
+
+/**
+ * @brief     get a big endian 64 bits value
+ * @param[in] *buf pointer to a buffer
+ * @return    value
+ * @note      none
+ */
+static uint64_t a_nbd_get_u64(const uint8_t *buf)
+{
+    return ((uint64_t)a_nbd_get_u32(buf) << 32) | a_nbd_get_u32(buf + 4);
+}
+
+/**
+ * @brief     receive bytes
+ * @param[in] fd socket
+ * @param[in] *buf pointer to a buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 receive failed
+ * @note      none
+ */
+static uint8_t a_nbd_recv(int fd, void *buf, size_t len)
+{
+    uint8_t *p = (uint8_t *)buf;
+    ssize_t l;
+    
+    while (len != 0)
+    {
+        l = read(fd, p, len);
+        if (l < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        if (l == 0)
+        {
+            return 1;
+        }
+        p += l;
+        len -= (size_t)l;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     send bytes
+ * @param[in] fd socket
+ * @param[in] *buf pointer to a buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_nbd_send(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+    ssize_t l;
+    
+    while (len != 0)
+    {
+        l = write(fd, p, len);
+        if (l < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        p += l;
+        len -= (size_t)l;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     drop bytes
+ * @param[in] fd socket
+ * @param[in] len dropped length
+ * @return    status code
+ *            - 0 success
+ *            - 1 receive failed
+ * @note      none
+ */
+static uint8_t a_nbd_drop(int fd, uint64_t len)
+{
+    uint8_t buf[256];
+    size_t l;
+    
+    while (len != 0)
+    {
+        l = (len > sizeof(buf)) ? sizeof(buf) : (size_t)len;
+        if (a_nbd_recv(fd, buf, l) != 0)
+        {
+            return 1;
+        }
+        len -= l;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     send an option reply
+ * @param[in] fd socket
+ * @param[in] option client option
+ * @param[in] type reply type
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_nbd_option_reply(int fd, uint32_t option, uint32_t type, const uint8_t *data, uint32_t len)
+{
+    uint8_t buf[20];
+    
+    a_nbd_put_u64(&buf[0], NBD_REP_MAGIC);
+    a_nbd_put_u32(&buf[8], option);
+    a_nbd_put_u32(&buf[12], type);
+    a_nbd_put_u32(&buf[16], len);
+    if (a_nbd_send(fd, buf, 20) != 0)
+    {
+        return 1;
+    }
+    if ((len != 0) && (a_nbd_send(fd, data, len) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  get the transmission flags
+ * @return transmission flags
+ * @note   none
+ */
+static uint16_t a_nbd_flags(void)
+{
+    return NBD_FLAG_HAS_FLAGS | NBD_FLAG_SEND_FLUSH | NBD_FLAG_SEND_TRIM;
+}
+
+/**
+ * @brief     send the export and block size info of a go or info option
+ * @param[in] fd socket
+ * @param[in] option client option
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      the preferred block size is one sector, so the client rarely
+ *            makes the driver read modify write
+ */
+static uint8_t a_nbd_option_info(int fd, uint32_t option)
+{
+    uint8_t buf[14];
+    
+    a_nbd_put_u16(&buf[0], NBD_INFO_EXPORT);
+    a_nbd_put_u64(&buf[2], gs_size);
+    a_nbd_put_u16(&buf[10], a_nbd_flags());
+    if (a_nbd_option_reply(fd, option, NBD_REP_INFO, buf, 12) != 0)
+    {
+        return 1;
+    }
+    a_nbd_put_u16(&buf[0], NBD_INFO_BLOCK_SIZE);
+    a_nbd_put_u32(&buf[2], 1);
+    a_nbd_put_u32(&buf[6], 4096);
+    a_nbd_put_u32(&buf[10], NBD_BUFFER_SIZE);
+    if (a_nbd_option_reply(fd, option, NBD_REP_INFO, buf, 14) != 0)
+    {
+        return 1;
+    }
+    
+    return a_nbd_option_reply(fd, option, NBD_REP_ACK, NULL, 0);
+}
+
+/**
+ * @brief     run the fixed newstyle handshake
+ * @param[in] fd socket
+ * @return    status code
+ *            - 0 success
+ *            - 1 handshake failed or aborted
+ * @note      any export name is accepted
+ */
+static uint8_t a_nbd_handshake(int fd)
+{
+    uint8_t buf[18];
+    uint8_t zero[124];
+    uint32_t client;
+    uint32_t option;
+    uint32_t len;
+    
+    a_nbd_put_u64(&buf[0], NBD_MAGIC);
+    a_nbd_put_u64(&buf[8], NBD_OPTS_MAGIC);
+    a_nbd_put_u16(&buf[16], NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES);
+    if (a_nbd_send(fd, buf, 18) != 0)
+    {
+        return 1;
+    }
+    if (a_nbd_recv(fd, buf, 4) != 0)
+    {
+        return 1;
+    }
+    client = a_nbd_get_u32(buf);
+    if ((client & NBD_FLAG_FIXED_NEWSTYLE) == 0)
+    {
+        return 1;
+    }
+    
+    /* option haggling */
+    while (1)
+    {
+        if (a_nbd_recv(fd, buf, 16) != 0)
+        {
+            return 1;
+        }
+        if (a_nbd_get_u64(&buf[0]) != NBD_OPTS_MAGIC)
+        {
+            return 1;
+        }
+        option = a_nbd_get_u32(&buf[8]);
+        len = a_nbd_get_u32(&buf[12]);
+        if (a_nbd_drop(fd, len) != 0)
+        {
+            return 1;
+        }
+        if (option == NBD_OPT_EXPORT_NAME)
+        {
+            a_nbd_put_u64(&buf[0], gs_size);
+            a_nbd_put_u16(&buf[8], a_nbd_flags());
+            if (a_nbd_send(fd, buf, 10) != 0)
+            {
+                return 1;
+            }
+            if ((client & NBD_FLAG_NO_ZEROES) == 0)
+            {
+                memset(zero, 0, sizeof(zero));
+                if (a_nbd_send(fd, zero, sizeof(zero)) != 0)
+                {
+                    return 1;
+                }
+            }
+            
+            return 0;
+        }
+        else if ((option == NBD_OPT_GO) || (option == NBD_OPT_INFO))
+        {
+            if (a_nbd_option_info(fd, option) != 0)
+            {
+                return 1;
+            }
+            if (option == NBD_OPT_GO)
+            {
+                return 0;
+            }
+        }
+        else if (option == NBD_OPT_LIST)
+        {
+            a_nbd_put_u32(&buf[0], 6);
+            memcpy(&buf[4], "w25qxx", 6);
+            if (a_nbd_option_reply(fd, option, NBD_REP_SERVER, buf, 10) != 0)
+            {
+                return 1;
+            }
+            if (a_nbd_option_reply(fd, option, NBD_REP_ACK, NULL, 0) != 0)
+            {
+                return 1;
+            }
+        }
+        else if (option == NBD_OPT_ABORT)
+        {
+            (void)a_nbd_option_reply(fd, option, NBD_REP_ACK, NULL, 0);
+            
+            return 1;
+        }
+        else
+        {
+            if (a_nbd_option_reply(fd, option, NBD_REP_ERR_UNSUP, NULL, 0) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief      receive a request header
+ * @param[in]  fd socket
+ * @param[out] *req pointer to a nbd request structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive failed
+ * @note       none
+ */
+static uint8_t a_nbd_recv_request(int fd, nbd_request_t *req)
+{
+    uint8_t buf[28];
+    
+    if (a_nbd_recv(fd, buf, 28) != 0)
+    {
+        return 1;
+    }
+    if (a_nbd_get_u32(&buf[0]) != NBD_REQUEST_MAGIC)
+    {
+        return 1;
+    }
+    req->type = a_nbd_get_u16(&buf[6]);
+    req->cookie = a_nbd_get_u64(&buf[8]);
+    req->offset = a_nbd_get_u64(&buf[16]);
+    req->length = a_nbd_get_u32(&buf[24]);
+    gs_stats.request++;
+    
+    return 0;
+}
+
+/**
+ * @brief     send a simple reply
+ * @param[in] fd socket
+ * @param[in] *req pointer to a nbd request structure
+ * @param[in] error errno value, 0 on success
+ * @param[in] *data pointer to the read data, NULL if none
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_nbd_reply(int fd, const nbd_request_t *req, uint32_t error, const uint8_t *data)
+{
+    uint8_t buf[16];
+    
+    a_nbd_put_u32(&buf[0], NBD_SIMPLE_REPLY_MAGIC);
+    a_nbd_put_u32(&buf[4], error);
+    a_nbd_put_u64(&buf[8], req->cookie);
+    if (a_nbd_send(fd, buf, 16) != 0)
+    {
+        return 1;
+    }
+    if ((data != NULL) && (error == 0) && (a_nbd_send(fd, data, req->length) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check if a request is inside the export
+ * @param[in] offset device offset
+ * @param[in] len length
+ * @return    1 if valid, else 0
+ * @note      none
+ */
+static uint8_t a_nbd_in_range(uint64_t offset, uint64_t len)
+{
+    return ((offset <= gs_size) && (len <= (gs_size - offset))) ? 1 : 0;
+}
+
+/**
+ * @brief     erase the whole sectors of a range
+ * @param[in] offset device offset
+ * @param[in] len length
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ * @note      partial sectors at both ends are left alone, trim is only a hint,
+ *            aligned 64k blocks take one block erase instead of 16 sector erases
+ */
+static uint8_t a_nbd_trim(uint64_t offset, uint64_t len)
+{
+    uint64_t addr;
+    uint64_t end;
+    
+    addr = (offset + 4095) / 4096 * 4096;
+    end = (offset + len) / 4096 * 4096;
+    while (addr < end)
+    {
+        if (((addr % 65536) == 0) && ((addr + 65536) <= end))
+        {
+            if (w25qxx_block_erase_64k(&gs_handle, (uint32_t)addr) != 0)
+            {
+                return 1;
+            }
+            addr += 65536;
+        }
+        else
+        {
+            if (w25qxx_sector_erase_4k(&gs_handle, (uint32_t)addr) != 0)
+            {
+                return 1;
+            }
+            addr += 4096;
+        }
+        gs_stats.erase++;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run a read, write or trim on the chip
+ * @param[in] type command type
+ * @param[in] offset device offset
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the range is already checked
+ */
+static uint8_t a_nbd_run(uint16_t type, uint64_t offset, uint8_t *buf, uint64_t len)
+{
+    gs_stats.operation++;
+    if (type == NBD_CMD_READ)
+    {
+        return (w25qxx_read(&gs_handle, (uint32_t)offset, buf, (uint32_t)len) != 0) ? 1 : 0;
+    }
+    else if (type == NBD_CMD_WRITE)
+    {
+        return (w25qxx_write(&gs_handle, (uint32_t)offset, buf, (uint32_t)len) != 0) ? 1 : 0;
+    }
+    else
+    {
+        return a_nbd_trim(offset, len);
+    }
+}
+
+/**
+ * @brief     serve a request too large for the merge buffer
+ * @param[in] fd socket
+ * @param[in] *req pointer to a nbd request structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 connection failed
+ * @note      the data goes through the buffer piece by piece, a failed read
+ *            after the reply header can't be reported and drops the client
+ */
+static uint8_t a_nbd_serve_large(int fd, const nbd_request_t *req)
+{
+    uint8_t buf[16];
+    uint32_t error;
+    uint32_t done;
+    uint32_t l;
+    
+    error = (a_nbd_in_range(req->offset, req->length) != 0) ? 0 : EINVAL;
+    if (req->type == NBD_CMD_WRITE)
+    {
+        for (done = 0; done < req->length; done += l)
+        {
+            l = ((req->length - done) > NBD_BUFFER_SIZE) ? NBD_BUFFER_SIZE : (req->length - done);
+            if (a_nbd_recv(fd, gs_buf, l) != 0)
+            {
+                return 1;
+            }
+            if ((error == 0) && (w25qxx_write(&gs_handle, (uint32_t)(req->offset + done), gs_buf, l) != 0))
+            {
+                error = EIO;
+            }
+            gs_stats.operation++;
+        }
+        
+        return a_nbd_reply(fd, req, error, NULL);
+    }
+    if (error != 0)
+    {
+        return a_nbd_reply(fd, req, error, NULL);
+    }
+    a_nbd_put_u32(&buf[0], NBD_SIMPLE_REPLY_MAGIC);
+    a_nbd_put_u32(&buf[4], 0);
+    a_nbd_put_u64(&buf[8], req->cookie);
+    if (a_nbd_send(fd, buf, 16) != 0)
+    {
+        return 1;
+    }
+    for (done = 0; done < req->length; done += l)
+    {
+        l = ((req->length - done) > NBD_BUFFER_SIZE) ? NBD_BUFFER_SIZE : (req->length - done);
+        if (w25qxx_read(&gs_handle, (uint32_t)(req->offset + done), gs_buf, l) != 0)
+        {
+            return 1;
+        }
+        gs_stats.operation++;
+        if (a_nbd_send(fd, gs_buf, l) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check if data is waiting on the socket
+ * @param[in] fd socket
+ * @return    1 if readable, else 0
+ * @note      never waits
+ */
+static uint8_t a_nbd_ready(int fd)
+{
+    struct pollfd p;
+    
+    p.fd = fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    
+    return ((poll(&p, 1, 0) == 1) && ((p.revents & POLLIN) != 0)) ? 1 : 0;
+}
+
+/**
+ * @brief     serve one client
+ * @param[in] fd socket
+ * @note      reads, writes and trims that continue the previous request and
+ *            are already queued on the socket are merged into one driver call,
+ *            when it fails the requests are run one by one so each one gets its
+ *            own error, the replies go out in the request order
+ */
+static void a_nbd_serve(int fd)
+{
+    nbd_request_t req[NBD_MAX_MERGE];
+    nbd_request_t next;
+    uint32_t error[NBD_MAX_MERGE];
+    uint8_t have_next;
+    uint64_t total;
+    uint32_t used;
+    uint32_t n;
+    uint32_t i;
+    
+    have_next = 0;
+    while (gs_stop == 0)
+    {
+        /* take the next request */
+        if (have_next != 0)
+        {
+            req[0] = next;
+            have_next = 0;
+        }
+        else if (a_nbd_recv_request(fd, &req[0]) != 0)
+        {
+            return;
+        }
+        if (req[0].type == NBD_CMD_DISC)
+        {
+            return;
+        }
+        if (((req[0].type == NBD_CMD_READ) || (req[0].type == NBD_CMD_WRITE)) && (req[0].length > NBD_BUFFER_SIZE))
+        {
+            if (a_nbd_serve_large(fd, &req[0]) != 0)
+            {
+                return;
+            }
+            
+            continue;
+        }
+        if ((req[0].type == NBD_CMD_WRITE) && (a_nbd_recv(fd, gs_buf, req[0].length) != 0))
+        {
+            return;
+        }
+        
+        /* merge the following requests, a request outside the export ends the run */
+        n = 1;
+        used = req[0].length;
+        total = req[0].length;
+        if (((req[0].type == NBD_CMD_READ) || (req[0].type == NBD_CMD_WRITE) || (req[0].type == NBD_CMD_TRIM)) &&
+            (a_nbd_in_range(req[0].offset, req[0].length) != 0))
+        {
+            while ((n < NBD_MAX_MERGE) && (a_nbd_ready(fd) != 0))
+            {
+                if (a_nbd_recv_request(fd, &next) != 0)
+                {
+                    return;
+                }
+                if ((next.type != req[0].type) || (next.offset != (req[n - 1].offset + req[n - 1].length)) ||
+                    ((next.type != NBD_CMD_TRIM) && ((used + (uint64_t)next.length) > NBD_BUFFER_SIZE)) ||
+                    (a_nbd_in_range(next.offset, next.length) == 0))
+                {
+                    have_next = 1;
+                    
+                    break;
+                }
+                if ((next.type == NBD_CMD_WRITE) && (a_nbd_recv(fd, &gs_buf[used], next.length) != 0))
+                {
+                    return;
+                }
+                if (next.type != NBD_CMD_TRIM)
+                {
+                    used += next.length;
+                }
+                total += next.length;
+                req[n++] = next;
+                gs_stats.merged++;
+            }
+        }
+        
+        /* run the merged operation */
+        for (i = 0; i < n; i++)
+        {
+            error[i] = 0;
+        }
+        if ((req[0].type == NBD_CMD_READ) || (req[0].type == NBD_CMD_WRITE) || (req[0].type == NBD_CMD_TRIM))
+        {
+            if (a_nbd_in_range(req[0].offset, req[0].length) == 0)
+            {
+                error[0] = EINVAL;
+            }
+            else if (a_nbd_run(req[0].type, req[0].offset, gs_buf, total) != 0)
+            {
+                /* retry the requests one by one, so a failed one doesn't fail the others */
+                used = 0;
+                for (i = 0; i < n; i++)
+                {
+                    if ((n == 1) || (a_nbd_run(req[i].type, req[i].offset, &gs_buf[used], req[i].length) != 0))
+                    {
+                        error[i] = EIO;
+                    }
+                    if (req[i].type != NBD_CMD_TRIM)
+                    {
+                        used += req[i].length;
+                    }
+                }
+            }
+            else
+            {
+                /* done */
+            }
+        }
+        else if (req[0].type != NBD_CMD_FLUSH)
+        {
+            /* writes are on the chip when they are replied, a flush has nothing to do */
+            error[0] = EINVAL;
+        }
+        else
+        {
+            /* flush */
+        }
+        
+        /* reply in order */
+        used = 0;
+        for (i = 0; i < n; i++)
+        {
+            if (a_nbd_reply(fd, &req[i], error[i], (req[i].type == NBD_CMD_READ) ? &gs_buf[used] : NULL) != 0)
+            {
+                return;
+            }
+            if (req[i].type == NBD_CMD_READ)
+            {
+                used += req[i].length;
+            }
+        }
+    }
+}
+
+/**
+ * @brief     open the w25qxx handle
+ * @param[in] type chip type
+ * @param[in] emulated bool value, if the chip is emulated
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
+ */
+static uint8_t a_nbd_open(w25qxx_type_t type, w25qxx_bool_t emulated)
+{
+    uint32_t size;
+    
+    size = 1UL << ((type & 0xFF) + 1);
+    DRIVER_W25QXX_LINK_INIT(&gs_handle, w25qxx_handle_t);
+    if (emulated == W25QXX_BOOL_TRUE)
+    {
+        if (emulator_init(0, type, size) != 0)
+        {
+            return 1;
+        }
+        DRIVER_W25QXX_LINK_SPI_QSPI_INIT(&gs_handle, emulator_spi_qspi_init);
+        DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(&gs_handle, emulator_spi_qspi_deinit);
+        DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(&gs_handle, emulator_spi_qspi_write_read);
+        DRIVER_W25QXX_LINK_DELAY_MS(&gs_handle, emulator_delay_ms);
+        DRIVER_W25QXX_LINK_DELAY_US(&gs_handle, emulator_delay_us);
+        DRIVER_W25QXX_LINK_DEBUG_PRINT(&gs_handle, emulator_debug_print);
+    }
+    else
+    {
+        DRIVER_W25QXX_LINK_SPI_QSPI_INIT(&gs_handle, w25qxx_interface_spi_qspi_init);
+        DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(&gs_handle, w25qxx_interface_spi_qspi_deinit);
+        DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(&gs_handle, w25qxx_interface_spi_qspi_write_read);
+        DRIVER_W25QXX_LINK_DELAY_MS(&gs_handle, w25qxx_interface_delay_ms);
+        DRIVER_W25QXX_LINK_DELAY_US(&gs_handle, w25qxx_interface_delay_us);
+        DRIVER_W25QXX_LINK_DEBUG_PRINT(&gs_handle, w25qxx_interface_debug_print);
+        DRIVER_W25QXX_LINK_SPI_BATCH(&gs_handle, w25qxx_interface_spi_batch);
+    }
+    (void)w25qxx_set_type(&gs_handle, type);
+    (void)w25qxx_set_interface(&gs_handle, W25QXX_INTERFACE_SPI);
+    (void)w25qxx_set_dual_quad_spi(&gs_handle, W25QXX_BOOL_FALSE);
+    if (w25qxx_init(&gs_handle) != 0)
+    {
+        if (emulated == W25QXX_BOOL_TRUE)
+        {
+            emulator_deinit(0);
+        }
+        
+        return 1;
+    }
+    if ((gs_size == 0) || (gs_size > size))
+    {
+        gs_size = size;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      parse a chip type
+ * @param[in]  *name pointer to a type name
+ * @param[out] *type pointer to a chip type buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 unknown type
+ * @note       none
+ */
+static uint8_t a_nbd_parse_type(const char *name, w25qxx_type_t *type)
+{
+    if (strcmp(name, "W25Q80") == 0)
+    {
+        *type = W25Q80;
+    }
+    else if (strcmp(name, "W25Q16") == 0)
+    {
+        *type = W25Q16;
+    }
+    else if (strcmp(name, "W25Q32") == 0)
+    {
+        *type = W25Q32;
+    }
+    else if (strcmp(name, "W25Q64") == 0)
+    {
+        *type = W25Q64;
+    }
+    else if (strcmp(name, "W25Q128") == 0)
+    {
+        *type = W25Q128;
+    }
+    else if (strcmp(name, "W25Q256") == 0)
+    {
+        *type = W25Q256;
+    }
+    else
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief print the usage
+ * @note  none
+ */
+static void a_nbd_usage(void)
+{
+    (void)printf("Usage:\n");
+    (void)printf("  w25qxx_nbd (-s <path> | --socket=<path>) [-e | --emulator] [--clock=<hz>]\n");
+    (void)printf("             [--type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>] [--size=<bytes>]\n");
+    (void)printf("Export the flash as a network block device on a unix socket, for example\n");
+    (void)printf("  nbd-client -unix <path> /dev/nbd0 -b 4096\n");
+    (void)printf("Reads and writes go to w25qxx_read and w25qxx_write, trims erase the whole\n");
+    (void)printf("sectors they cover and queued requests that continue each other are merged.\n");
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    const char short_options[] = "hs:e";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"socket", required_argument, NULL, 's'},
+        {"emulator", no_argument, NULL, 'e'},
+        {"type", required_argument, NULL, 1},
+        {"size", required_argument, NULL, 2},
+        {"clock", required_argument, NULL, 3},
+        {NULL, 0, NULL, 0},
+    };
+    const char *path = NULL;
+    w25qxx_type_t type = W25Q128;
+    w25qxx_bool_t emulated = W25QXX_BOOL_FALSE;
+    struct sockaddr_un addr;
+    struct sigaction sa;
+    emulator_stats_t stats;
+    uint64_t start;
+    uint32_t clock_hz;
+    int server;
+    int client;
+    int c;
+    
+    /* parse the options */
+    optind = 0;
+    while ((c = getopt_long(argc, argv, short_options, long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 's' :
+            {
+                path = optarg;
+                
+                break;
+            }
+            case 'e' :
+            {
+                emulated = W25QXX_BOOL_TRUE;
+                
+                break;
+            }
+            case 1 :
+            {
+                if (a_nbd_parse_type(optarg, &type) != 0)
+                {
+                    (void)printf("nbd: unknown type %s.\n", optarg);
+                    
+                    return 1;
+                }
+                
+                break;
+            }
+            case 2 :
+            {
+                gs_size = strtoull(optarg, NULL, 0) / 4096 * 4096;
+                
+                break;
+            }
+            case 3 :
+            {
+                if (w25qxx_interface_spi_parse_clock(optarg, &clock_hz) != 0)
+                {
+                    (void)printf("nbd: clock is invalid.\n");
+                    
+                    return 1;
+                }
+                w25qxx_interface_spi_set_clock(clock_hz);
+                
+                break;
+            }
+            default :
+            {
+                a_nbd_usage();
+                
+                return 1;
+            }
+        }
+    }
+    if ((path == NULL) || (strlen(path) >= sizeof(addr.sun_path)))
+    {
+        a_nbd_usage();
+        
+        return 1;
+    }
+    
+    /* open the chip */
+    if (a_nbd_open(type, emulated) != 0)
+    {
+        (void)printf("nbd: open the chip failed.\n");
+        
+        return 1;
+    }
+    
+    /* listen on the socket */
+    server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0)
+    {
+        perror("nbd: socket failed");
+        (void)w25qxx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    (void)unlink(path);
+    if ((bind(server, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(server, 1) != 0))
+    {
+        perror("nbd: bind failed");
+        (void)close(server);
+        (void)w25qxx_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = a_nbd_signal;
+    (void)sigaction(SIGINT, &sa, NULL);
+    (void)sigaction(SIGTERM, &sa, NULL);
+    sa.sa_handler = SIG_IGN;
+    (void)sigaction(SIGPIPE, &sa, NULL);
+    (void)printf("nbd: export %llu bytes on %s.\n", (unsigned long long)gs_size, path);
+    
+    /* one client at a time */
+    while (gs_stop == 0)
+    {
+        client = accept(server, NULL, NULL);
+        if (client < 0)
+        {
+            continue;
+        }
+        memset(&gs_stats, 0, sizeof(gs_stats));
+        emulator_clear_stats();
+        start = emulator_get_time_ns();
+        if (a_nbd_handshake(client) == 0)
+        {
+            a_nbd_serve(client);
+        }
+        (void)close(client);
+        (void)printf("nbd: client done, %u requests, %u merged, %u operations, %u erases.\n",
+                     gs_stats.request, gs_stats.merged, gs_stats.operation, gs_stats.erase);
+        if (emulated == W25QXX_BOOL_TRUE)
+        {
+            emulator_get_stats(&stats);
+            (void)printf("nbd: emulated bus %u transactions, %llu bytes, %.3f s.\n",
+                         stats.transaction, (unsigned long long)stats.bus_bytes,
+                         (double)(emulator_get_time_ns() - start) / 1e9);
+        }
+        (void)fflush(stdout);
+    }
+    
+    /* close */
+    (void)close(server);
+    (void)unlink(path);
+    (void)w25qxx_deinit(&gs_handle);
+    if (emulated == W25QXX_BOOL_TRUE)
+    {
+        emulator_deinit(0);
+    }
+    
+    return 0;
+}
@@ -38,9 +38,26 @@
 #include "driver_w25qxx_advance.h"
 #include "driver_w25qxx_read_test.h"
 #include "driver_w25qxx_register_test.h"
+#include "driver_w25qxx_soak_test.h"
+#include "raspberrypi4b_driver_w25qxx_interface.h"
 #include <getopt.h>
 #include <math.h>
 #include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief  get the monotonic timestamp
+ * @return timestamp in us
+ * @note   none
+ */
+static uint64_t a_timestamp_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
 
 /**
  * @brief     w25qxx full function
@@ -73,17 +90,32 @@ uint8_t w25qxx(uint8_t argc, char **argv)
         {"status", required_argument, NULL, 7},
         {"type", required_argument, NULL, 8},
         {"wrap", required_argument, NULL, 9},
+        {"size", required_argument, NULL, 10},
+        {"seconds", required_argument, NULL, 11},
+        {"operations", required_argument, NULL, 12},
+        {"ratio", required_argument, NULL, 13},
+        {"pattern", required_argument, NULL, 14},
+        {"distribution", required_argument, NULL, 15},
+        {"min", required_argument, NULL, 16},
+        {"max", required_argument, NULL, 17},
+        {"seed", required_argument, NULL, 18},
+        {"interval", required_argument, NULL, 19},
+        {"clock", required_argument, NULL, 20},
         {NULL, 0, NULL, 0},
     };
     char type[49] = "unknown";
     uint32_t addr = 0;
     uint32_t data = 0;
+    uint32_t clock_hz = 0;
     w25qxx_qspi_read_dummy_t dummy = W25QXX_QSPI_READ_DUMMY_8_80MHZ;
     w25qxx_qspi_read_wrap_length_t length = W25QXX_QSPI_READ_WRAP_LENGTH_8_BYTE;
     w25qxx_interface_t interface = W25QXX_INTERFACE_SPI;
     w25qxx_security_register_t num = W25QXX_SECURITY_REGISTER_1;
     w25qxx_type_t chip_type = W25Q128;
     w25qxx_burst_wrap_t wrap = W25QXX_BURST_WRAP_NONE;
+    w25qxx_soak_param_t soak = {0x00000000, 0x00100000, 3600, 0, 10, 1, 70, 25, 5,
+                                W25QXX_SOAK_PATTERN_RANDOM, W25QXX_SOAK_DISTRIBUTION_LOG,
+                                1, W25QXX_SOAK_MAX_LENGTH, a_timestamp_us};
     uint8_t status;
     
     /* if no params */
@@ -539,6 +571,149 @@ uint8_t w25qxx(uint8_t argc, char **argv)
                 break;
             }
 
+            /* size */
+            case 10 :
+            {
+                /* set the region size */
+                soak.size = strtoul(optarg, NULL, 0);
+
+                break;
+            }
+
+            /* seconds */
+            case 11 :
+            {
+                /* set the run time */
+                soak.seconds = strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* operations */
+            case 12 :
+            {
+                /* set the operation count */
+                soak.operations = strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* ratio */
+            case 13 :
+            {
+                unsigned int r, w, e;
+
+                /* set the read write erase ratio */
+                if (sscanf(optarg, "%u:%u:%u", &r, &w, &e) != 3)
+                {
+                    return 5;
+                }
+                if ((r > 255) || (w > 255) || (e > 255))
+                {
+                    return 5;
+                }
+                soak.read_ratio = (uint8_t)r;
+                soak.write_ratio = (uint8_t)w;
+                soak.erase_ratio = (uint8_t)e;
+
+                break;
+            }
+
+            /* pattern */
+            case 14 :
+            {
+                /* set the pattern */
+                if (strcmp("random", optarg) == 0)
+                {
+                    soak.pattern = W25QXX_SOAK_PATTERN_RANDOM;
+                }
+                else if (strcmp("sequential", optarg) == 0)
+                {
+                    soak.pattern = W25QXX_SOAK_PATTERN_SEQUENTIAL;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* distribution */
+            case 15 :
+            {
+                /* set the distribution */
+                if (strcmp("fixed", optarg) == 0)
+                {
+                    soak.distribution = W25QXX_SOAK_DISTRIBUTION_FIXED;
+                }
+                else if (strcmp("uniform", optarg) == 0)
+                {
+                    soak.distribution = W25QXX_SOAK_DISTRIBUTION_UNIFORM;
+                }
+                else if (strcmp("log", optarg) == 0)
+                {
+                    soak.distribution = W25QXX_SOAK_DISTRIBUTION_LOG;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* min */
+            case 16 :
+            {
+                /* set the min length */
+                soak.min_length = strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* max */
+            case 17 :
+            {
+                /* set the max length */
+                soak.max_length = strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* seed */
+            case 18 :
+            {
+                /* set the seed */
+                soak.seed = strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* interval */
+            case 19 :
+            {
+                /* set the report interval */
+                soak.interval = strtoul(optarg, NULL, 10);
+
+                break;
+            }
+
+            /* clock */
+            case 20 :
+            {
+                /* set the spi clock */
+                if (w25qxx_interface_spi_parse_clock(optarg, &clock_hz) != 0)
+                {
+                    w25qxx_interface_debug_print("w25qxx: clock is invalid.\n");
+
+                    return 5;
+                }
+                w25qxx_interface_spi_set_clock(clock_hz);
+
+                break;
+            }
+
             /* the end */
             case -1 :
             {
@@ -596,6 +771,28 @@ uint8_t w25qxx(uint8_t argc, char **argv)
             return 0;
         }
     }
+    else if (strcmp("t_soak", type) == 0)
+    {
+        uint8_t res;
+
+        /* check the interface */
+        if (interface != W25QXX_INTERFACE_SPI)
+        {
+            return 5;
+        }
+
+        /* run soak test */
+        soak.addr = addr;
+        res = w25qxx_soak_test(chip_type, interface, W25QXX_BOOL_FALSE, &soak);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("e_power-down", type) == 0)
     {
         uint8_t res;
@@ -1931,6 +2128,10 @@ uint8_t w25qxx(uint8_t argc, char **argv)
         w25qxx_interface_debug_print("  w25qxx (-p | --port)\n");
         w25qxx_interface_debug_print("  w25qxx (-t reg | --test=reg) [--type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>] [--interface=<spi | qspi>]\n");
         w25qxx_interface_debug_print("  w25qxx (-t read | --test=read) [--type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>] [--interface=<spi | qspi>]\n");
+        w25qxx_interface_debug_print("  w25qxx (-t soak | --test=soak) [--type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>] [--interface=<spi>]\n");
+        w25qxx_interface_debug_print("         [--addr=<address>] [--size=<size>] [--seconds=<s>] [--operations=<n>] [--ratio=<r:w:e>]\n");
+        w25qxx_interface_debug_print("         [--pattern=<random | sequential>] [--distribution=<fixed | uniform | log>] [--min=<bytes>] [--max=<bytes>]\n");
+        w25qxx_interface_debug_print("         [--seed=<n>] [--interval=<s>]\n");
         w25qxx_interface_debug_print("  w25qxx (-e power-down | --example=power-down) [--type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>] [--interface=<spi | qspi>]\n");
         w25qxx_interface_debug_print("  w25qxx (-e wake-up | --example=wake-up) [--type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>] [--interface=<spi | qspi>]\n");
         w25qxx_interface_debug_print("  w25qxx (-e chip-erase | --example=chip-erase) [--type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>] [--interface=<spi | qspi>]\n");
@@ -2005,9 +2206,12 @@ uint8_t w25qxx(uint8_t argc, char **argv)
         w25qxx_interface_debug_print("\n");
         w25qxx_interface_debug_print("Options:\n");
         w25qxx_interface_debug_print("      --addr=<address>               Set the operator address and it is hexadecimal.([default: 0x00000000])\n");
+        w25qxx_interface_debug_print("      --clock=<hz>                   Set the spi clock up to 104000000, the W25QXX_SPI_CLOCK environment variable also sets it.([default: 1000000])\n");
         w25qxx_interface_debug_print("      --data=<hex>                   Set the input data and it is hexadecimal.([default: 0x00000000])\n");
         w25qxx_interface_debug_print("      --dummy=<DUMMY_2_33MHZ | DUMMY_4_55MHZ | DUMMY_6_80MHZ | DUMMY_8_80MHZ>\n");
         w25qxx_interface_debug_print("                                     Set the dummy.([default: DUMMY_8_80MHZ])\n");
+        w25qxx_interface_debug_print("      --distribution=<fixed | uniform | log>\n");
+        w25qxx_interface_debug_print("                                     Set the soak size distribution.([default: log])\n");
         w25qxx_interface_debug_print("  -e <power-down | wake-up | chip-erase | get-id | read | write | advance-power-down | advance-wake-up | advance-chip-erase\n");
         w25qxx_interface_debug_print("     | advance-get-id | advance-read | advance-write | advance-page-program | advance-erase-4k | advance-erase-32k | advance-erase-64k\n");
         w25qxx_interface_debug_print("     | advance-fast-read | advance-get-status1 | advance-get-status2 | advance-get-status3 | advance-set-status1 | advance-set-status2\n");
@@ -2029,10 +2233,20 @@ uint8_t w25qxx(uint8_t argc, char **argv)
         w25qxx_interface_debug_print("      --length=<8 | 16 | 32 | 64>    Set the dummy length.([default: 8])\n");
         w25qxx_interface_debug_print("  -i, --information                  Show the chip information.\n");
         w25qxx_interface_debug_print("      --interface=<spi | qspi>       Set the chip interface.([default: spi])\n");
+        w25qxx_interface_debug_print("      --interval=<s>                 Set the soak report interval in seconds.([default: 10])\n");
+        w25qxx_interface_debug_print("      --max=<bytes>                  Set the soak max operation length.([default: 4096])\n");
+        w25qxx_interface_debug_print("      --min=<bytes>                  Set the soak min operation length.([default: 1])\n");
         w25qxx_interface_debug_print("      --num=<1 | 2 | 3>              Set the security number.([default: 1])\n");
+        w25qxx_interface_debug_print("      --operations=<n>               Set the soak operation count, 0 means no limit.([default: 0])\n");
+        w25qxx_interface_debug_print("      --pattern=<random | sequential>\n");
+        w25qxx_interface_debug_print("                                     Set the soak address pattern.([default: random])\n");
         w25qxx_interface_debug_print("  -p, --port                         Display the pin connections of the current board.\n");
+        w25qxx_interface_debug_print("      --ratio=<r:w:e>                Set the soak read write erase ratio.([default: 70:25:5])\n");
+        w25qxx_interface_debug_print("      --seconds=<s>                  Set the soak run time, 0 means no limit.([default: 3600])\n");
+        w25qxx_interface_debug_print("      --seed=<n>                     Set the soak random seed.([default: 1])\n");
+        w25qxx_interface_debug_print("      --size=<size>                  Set the soak region size.([default: 0x100000])\n");
         w25qxx_interface_debug_print("      --status=<hex>                 Set the status and it is hexadecimal.([default: 0x00])\n");
-        w25qxx_interface_debug_print("  -t <reg | read>, --test=<reg | read>\n");
+        w25qxx_interface_debug_print("  -t <reg | read | soak>, --test=<reg | read | soak>\n");
         w25qxx_interface_debug_print("                                     Run the driver test.\n");
         w25qxx_interface_debug_print("      --type=<W25Q80 | W25Q16 | W25Q32 | W25Q64 | W25Q128 | W25Q256>\n");
         w25qxx_interface_debug_print("                                     Set the chip type.([default: W25Q128])\n");
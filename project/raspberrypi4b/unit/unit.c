@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit.c
+ * @brief     w25qxx unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+/**
+ * @brief unit case structure definition
+ */
+typedef struct unit_case_s
+{
+    const char *name;              /**< case name */
+    uint8_t (*run)(void);          /**< case body */
+} unit_case_t;
+
+static w25qxx_handle_t gs_handle[UNIT_MAX_CHIP];        /**< w25qxx handles */
+static uint8_t gs_opened[UNIT_MAX_CHIP];                /**< opened flags */
+static uint8_t gs_fail_command[UNIT_MAX_CHIP];          /**< armed failing command */
+static uint32_t gs_fail_skip[UNIT_MAX_CHIP];            /**< frames of the command to pass first */
+
+/**
+ * @brief     check the armed failure of a chip
+ * @param[in] index chip index
+ * @param[in] instruction sent instruction
+ * @param[in] instruction_line instruction phy lines
+ * @param[in] *in_buf pointer to a input buffer
+ * @param[in] in_len input length
+ * @return    status code
+ *            - 0 pass the frame
+ *            - 1 fail the frame
+ * @note      a raw spi frame carries its command in the first byte
+ */
+static uint8_t a_unit_fail(uint8_t index, uint8_t instruction, uint8_t instruction_line,
+                           uint8_t *in_buf, uint32_t in_len)
+{
+    uint8_t command;
+    
+    if (gs_fail_command[index] == 0)
+    {
+        return 0;
+    }
+    if (instruction_line != 0)
+    {
+        command = instruction;
+    }
+    else if ((in_buf != NULL) && (in_len != 0))
+    {
+        command = in_buf[0];
+    }
+    else
+    {
+        return 0;
+    }
+    if (command != gs_fail_command[index])
+    {
+        return 0;
+    }
+    if (gs_fail_skip[index] != 0)
+    {
+        gs_fail_skip[index]--;
+        
+        return 0;
+    }
+    gs_fail_command[index] = 0;
+    
+    return 1;
+}
+
+/**
+ * @brief      emulator chip 0 spi qspi bus write read
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       none
+ */
+static uint8_t a_unit_spi_qspi_write_read_0(uint8_t instruction, uint8_t instruction_line,
+                                            uint32_t address, uint8_t address_line, uint8_t address_len,
+                                            uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                            uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                            uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    if (a_unit_fail(0, instruction, instruction_line, in_buf, in_len) != 0)
+    {
+        return 1;
+    }
+    
+    return emulator_write_read(0, instruction, instruction_line, address, address_line, address_len,
+                               alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                               out_buf, out_len, data_line);
+}
+
+/**
+ * @brief      emulator chip 1 spi qspi bus write read
+ * @note       same parameters as a_unit_spi_qspi_write_read_0
+ */
+static uint8_t a_unit_spi_qspi_write_read_1(uint8_t instruction, uint8_t instruction_line,
+                                            uint32_t address, uint8_t address_line, uint8_t address_len,
+                                            uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                            uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                            uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    if (a_unit_fail(1, instruction, instruction_line, in_buf, in_len) != 0)
+    {
+        return 1;
+    }
+    
+    return emulator_write_read(1, instruction, instruction_line, address, address_line, address_len,
+                               alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                               out_buf, out_len, data_line);
+}
+
+/**
+ * @brief     open an emulated chip
+ * @param[in] index chip index
+ * @param[in] interface chip interface
+ * @param[in] dual_quad_spi_enable dual quad spi enable
+ * @return    pointer to the initialized handle or NULL on failure
+ * @note      none
+ */
+w25qxx_handle_t *unit_open(uint8_t index, w25qxx_interface_t interface, w25qxx_bool_t dual_quad_spi_enable)
+{
+    w25qxx_handle_t *handle;
+    
+    if ((index >= UNIT_MAX_CHIP) || (gs_opened[index] != 0))
+    {
+        return NULL;
+    }
+    if (emulator_init(index, UNIT_TYPE, UNIT_SIZE) != 0)
+    {
+        return NULL;
+    }
+    handle = &gs_handle[index];
+    DRIVER_W25QXX_LINK_INIT(handle, w25qxx_handle_t);
+    DRIVER_W25QXX_LINK_SPI_QSPI_INIT(handle, emulator_spi_qspi_init);
+    DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(handle, emulator_spi_qspi_deinit);
+    if (index == 0)
+    {
+        DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(handle, a_unit_spi_qspi_write_read_0);
+    }
+    else
+    {
+        DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(handle, a_unit_spi_qspi_write_read_1);
+    }
+    DRIVER_W25QXX_LINK_DELAY_MS(handle, emulator_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(handle, emulator_delay_us);
+    DRIVER_W25QXX_LINK_DEBUG_PRINT(handle, emulator_debug_print);
+    (void)w25qxx_set_type(handle, (w25qxx_type_t)UNIT_TYPE);
+    (void)w25qxx_set_interface(handle, interface);
+    (void)w25qxx_set_dual_quad_spi(handle, dual_quad_spi_enable);
+    if (w25qxx_init(handle) != 0)
+    {
+        emulator_deinit(index);
+    
+        return NULL;
+    }
+    gs_opened[index] = 1;
+    
+    return handle;
+}
+
+/**
+ * @brief     close an emulated chip
+ * @param[in] index chip index
+ * @note      none
+ */
+void unit_close(uint8_t index)
+{
+    if ((index < UNIT_MAX_CHIP) && (gs_opened[index] != 0))
+    {
+        (void)w25qxx_deinit(&gs_handle[index]);
+        emulator_deinit(index);
+        gs_opened[index] = 0;
+    }
+    if (index < UNIT_MAX_CHIP)
+    {
+        gs_fail_command[index] = 0;
+    }
+}
+
+/**
+ * @brief     fail one frame of a chip
+ * @param[in] index chip index
+ * @param[in] command failing command
+ * @param[in] skip frames of the command to pass first
+ * @note      none
+ */
+void unit_fail(uint8_t index, uint8_t command, uint32_t skip)
+{
+    if (index < UNIT_MAX_CHIP)
+    {
+        gs_fail_command[index] = command;
+        gs_fail_skip[index] = skip;
+    }
+}
+
+/**
+ * @brief     fill a pattern
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] seed pattern seed
+ * @note      none
+ */
+void unit_pattern(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    uint32_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        buf[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+/**
+ * @brief unit case table
+ */
+static const unit_case_t gsc_case[] =
+{
+    {"wa",      unit_wa},
+    {"wear",    unit_wear},
+    {"cost",    unit_cost},
+    {"kv",      unit_kv},
+    {"ftl",     unit_ftl},
+    {"bd",      unit_bd},
+    {"ts",      unit_ts},
+    {"wb",      unit_wb},
+    {"ota",     unit_ota},
+    {"delta",   unit_delta},
+    {"blob",    unit_blob},
+    {"ckpt",    unit_ckpt},
+    {"bus",     unit_bus},
+    {"stripe",  unit_stripe},
+    {"mirror",  unit_mirror},
+    {"parallel", unit_parallel},
+    {"async",   unit_async},
+};
+
+/**
+ * @brief     unit main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 a case failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    const char short_options[] = "hn:";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"name", required_argument, NULL, 'n'},
+        {NULL, 0, NULL, 0},
+    };
+    emulator_stats_t stats;
+    const char *name = NULL;
+    uint8_t failed = 0;
+    uint8_t res;
+    uint32_t run = 0;
+    uint32_t num;
+    uint32_t i;
+    uint32_t j;
+    int c;
+    
+    /* parse the options */
+    optind = 0;
+    while ((c = getopt_long(argc, argv, short_options, long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'n' :
+            {
+                name = optarg;
+    
+                break;
+            }
+            default :
+            {
+                (void)printf("Usage:\n");
+                (void)printf("  w25qxx_unit [-n <case> | --name=<case>]\n");
+                (void)printf("Run the unit cases of the driver modules against an emulated chip.\n");
+    
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    
+    /* run the cases */
+    num = sizeof(gsc_case) / sizeof(gsc_case[0]);
+    for (i = 0; i < num; i++)
+    {
+        if ((name != NULL) && (strcmp(name, gsc_case[i].name) != 0))
+        {
+            continue;
+        }
+        emulator_clear_stats();
+        res = gsc_case[i].run();
+        emulator_get_stats(&stats);
+        if ((res == 0) && (stats.busy_violation != 0))
+        {
+            (void)printf("unit: %s sent %d commands to a busy chip.\n", gsc_case[i].name, stats.busy_violation);
+            res = 1;
+        }
+        for (j = 0; j < UNIT_MAX_CHIP; j++)
+        {
+            unit_close((uint8_t)j);
+        }
+        (void)printf("%-12s %s\n", gsc_case[i].name, (res == 0) ? "ok" : "FAILED");
+        failed |= res;
+        run++;
+    }
+    if (run == 0)
+    {
+        (void)printf("unit: no case named %s.\n", name);
+    
+        return 1;
+    }
+    
+    return failed;
+}
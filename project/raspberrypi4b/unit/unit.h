@@ -0,0 +1,278 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit.h
+ * @brief     w25qxx unit test header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef UNIT_H
+#define UNIT_H
+
+#include "driver_w25qxx.h"
+#include "emulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup unit unit function
+ * @brief    emulator backed unit test modules
+ * @{
+ */
+
+/**
+ * @brief unit max chip definition
+ */
+#define UNIT_MAX_CHIP            2
+
+/**
+ * @brief unit chip definition
+ */
+#define UNIT_TYPE                W25Q128         /**< chip type */
+#define UNIT_SIZE                0x1000000       /**< chip size */
+
+/**
+ * @brief     check a condition of a unit case
+ * @param[in] c checked condition
+ * @note      prints the failed condition and returns 1 from the case
+ */
+#define UNIT_CHECK(c)                                                                          \
+    do                                                                                         \
+    {                                                                                          \
+        if (!(c))                                                                              \
+        {                                                                                      \
+            emulator_debug_print("unit: %s:%d: %s failed.\n", __FILE__, __LINE__, #c);         \
+                                                                                               \
+            return 1;                                                                          \
+        }                                                                                      \
+    } while (0)
+
+/**
+ * @brief     open an emulated chip
+ * @param[in] index chip index
+ * @param[in] interface chip interface
+ * @param[in] dual_quad_spi_enable dual quad spi enable
+ * @return    pointer to the initialized handle or NULL on failure
+ * @note      the chip is a fully erased UNIT_TYPE of UNIT_SIZE bytes,
+ *            the runner closes every opened chip after each case
+ */
+w25qxx_handle_t *unit_open(uint8_t index, w25qxx_interface_t interface, w25qxx_bool_t dual_quad_spi_enable);
+
+/**
+ * @brief     close an emulated chip
+ * @param[in] index chip index
+ * @note      none
+ */
+void unit_close(uint8_t index);
+
+/**
+ * @brief     fail one frame of a chip
+ * @param[in] index chip index
+ * @param[in] command failing command, 0 disarms
+ * @param[in] skip frames of the command to pass first
+ * @note      the failing frame never reaches the emulator and its write read returns 1,
+ *            the failure fires once and closing the chip disarms it
+ */
+void unit_fail(uint8_t index, uint8_t command, uint32_t skip);
+
+/**
+ * @brief     fill a pattern
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] seed pattern seed
+ * @note      none
+ */
+void unit_pattern(uint8_t *buf, uint32_t len, uint32_t seed);
+
+/**
+ * @brief  write amplification case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_wa(void);
+
+/**
+ * @brief  wear case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_wear(void);
+
+/**
+ * @brief  cost case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_cost(void);
+
+/**
+ * @brief  kv case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_kv(void);
+
+/**
+ * @brief  ftl case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_ftl(void);
+
+/**
+ * @brief  bd case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_bd(void);
+
+/**
+ * @brief  ts case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_ts(void);
+
+/**
+ * @brief  wb case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_wb(void);
+
+/**
+ * @brief  ota case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_ota(void);
+
+/**
+ * @brief  delta case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_delta(void);
+
+/**
+ * @brief  blob case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_blob(void);
+
+/**
+ * @brief  ckpt case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_ckpt(void);
+
+/**
+ * @brief  bus case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_bus(void);
+
+/**
+ * @brief  stripe case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_stripe(void);
+
+/**
+ * @brief  mirror case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_mirror(void);
+
+/**
+ * @brief  erase parallel case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_parallel(void);
+
+/**
+ * @brief  async case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   none
+ */
+uint8_t unit_async(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
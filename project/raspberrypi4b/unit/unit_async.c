@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_async.c
+ * @brief     w25qxx async unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_async.h"
+
+static w25qxx_async_t gs_async;               /**< async context */
+static w25qxx_async_req_t gs_req[4];          /**< async requests */
+static uint8_t gs_res[4];                     /**< request results */
+static uint8_t gs_order[4];                   /**< completion order */
+static uint8_t gs_done;                       /**< completed requests */
+static int32_t gs_held;                       /**< exclusive handle locks held */
+static uint8_t gs_buf[4096];                  /**< data buffer */
+static uint8_t gs_data[2][300];               /**< write data */
+static uint8_t gs_check[4096];                /**< check buffer */
+
+/**
+ * @brief     handle lock
+ * @param[in] type lock type
+ * @note      none
+ */
+static void a_unit_async_lock(w25qxx_lock_t type)
+{
+    if (type == W25QXX_LOCK_EXCLUSIVE)
+    {
+        gs_held++;
+    }
+}
+
+/**
+ * @brief     handle unlock
+ * @param[in] type lock type
+ * @note      none
+ */
+static void a_unit_async_unlock(w25qxx_lock_t type)
+{
+    if (type == W25QXX_LOCK_EXCLUSIVE)
+    {
+        gs_held--;
+    }
+}
+
+/**
+ * @brief     completion callback
+ * @param[in] *req pointer to a w25qxx async request structure
+ * @param[in] res request result
+ * @note      none
+ */
+static void a_unit_async_done(w25qxx_async_req_t *req, uint8_t res)
+{
+    uint8_t index;
+    
+    index = (uint8_t)(req - gs_req);
+    gs_res[index] = res;
+    gs_order[gs_done++] = index;
+}
+
+/**
+ * @brief  run the pump until nothing is pending
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   the handle is held exactly while the chip is busy
+ */
+static uint8_t a_unit_async_run(void)
+{
+    uint32_t pending;
+    uint32_t wait_us;
+    
+    do
+    {
+        UNIT_CHECK(w25qxx_process(&gs_async, &pending, &wait_us) == 0);
+        UNIT_CHECK(gs_held == ((wait_us != 0) ? 1 : 0));
+        if (wait_us != 0)
+        {
+            emulator_delay_us(wait_us);
+        }
+    } while (pending != 0);
+    
+    return 0;
+}
+
+/**
+ * @brief  async case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   the callbacks report every result in order, a write over programmed data
+ *         erases the sector and keeps its other bytes, and a failed program leaves
+ *         the handle released
+ */
+uint8_t unit_async(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_async_stats_t stats;
+    uint32_t pending;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    DRIVER_W25QXX_LINK_LOCK(handle, a_unit_async_lock);
+    DRIVER_W25QXX_LINK_UNLOCK(handle, a_unit_async_unlock);
+    UNIT_CHECK(w25qxx_async_init(&gs_async, handle) == 0);
+    UNIT_CHECK(w25qxx_process(&gs_async, NULL, NULL) == 4);
+    
+    /* a blank write, an overwrite needing an erase and a read back */
+    unit_pattern(gs_data[0], 300, 1);
+    unit_pattern(gs_data[1], 100, 2);
+    UNIT_CHECK(w25qxx_write_async(&gs_async, &gs_req[0], 0x001080, gs_data[0], 300, a_unit_async_done, NULL) == 0);
+    UNIT_CHECK(w25qxx_write_async(&gs_async, &gs_req[1], 0x001100, gs_data[1], 100, a_unit_async_done, NULL) == 0);
+    UNIT_CHECK(w25qxx_read_async(&gs_async, &gs_req[2], 0x001000, gs_buf, 4096, a_unit_async_done, NULL) == 0);
+    UNIT_CHECK(a_unit_async_run() == 0);
+    UNIT_CHECK(gs_done == 3);
+    UNIT_CHECK((gs_order[0] == 0) && (gs_order[1] == 1) && (gs_order[2] == 2));
+    UNIT_CHECK((gs_res[0] == 0) && (gs_res[1] == 0) && (gs_res[2] == 0));
+    memset(gs_check, 0xFF, 4096);
+    memcpy(&gs_check[0x080], gs_data[0], 300);
+    memcpy(&gs_check[0x100], gs_data[1], 100);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    UNIT_CHECK(w25qxx_async_get_stats(&gs_async, &stats) == 0);
+    UNIT_CHECK(stats.erase == 1);
+    
+    /* an erase request blanks the sector */
+    UNIT_CHECK(w25qxx_erase_async(&gs_async, &gs_req[3], 0x001000, 4096, a_unit_async_done, NULL) == 0);
+    UNIT_CHECK(a_unit_async_run() == 0);
+    UNIT_CHECK((gs_done == 4) && (gs_order[3] == 3) && (gs_res[3] == 0));
+    UNIT_CHECK(w25qxx_read(handle, 0x001000, gs_buf, 4096) == 0);
+    memset(gs_check, 0xFF, 4096);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    
+    /* a failed program start reports the error and releases the handle */
+    gs_done = 0;
+    unit_fail(0, 0x02, 0);
+    UNIT_CHECK(w25qxx_write_async(&gs_async, &gs_req[0], 0x002000, gs_data[0], 300, a_unit_async_done, NULL) == 0);
+    UNIT_CHECK(a_unit_async_run() == 0);
+    UNIT_CHECK((gs_done == 1) && (gs_res[0] == 1));
+    UNIT_CHECK(gs_held == 0);
+    UNIT_CHECK(w25qxx_process(&gs_async, &pending, NULL) == 0);
+    UNIT_CHECK(pending == 0);
+    UNIT_CHECK(w25qxx_async_deinit(&gs_async) == 0);
+    
+    return 0;
+}
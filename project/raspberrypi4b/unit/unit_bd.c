@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_bd.c
+ * @brief     w25qxx bd unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_bd.h"
+
+/**
+ * @brief unit bd definition
+ */
+#define UNIT_BD_ADDR           0x010000        /**< region address */
+#define UNIT_BD_COUNT          8               /**< block count */
+
+static w25qxx_bd_t gs_bd;                                       /**< block device */
+static uint8_t gs_erased[W25QXX_BD_BITMAP_SIZE(UNIT_BD_COUNT)]; /**< known erased bitmap */
+static uint8_t gs_cache[256];                                   /**< read cache */
+static uint8_t gs_buf[4096];                                    /**< data buffer */
+static uint8_t gs_check[4096];                                  /**< check buffer */
+
+/**
+ * @brief  bd case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   programs and reads that start inside a page and cross page and cache
+ *         boundaries round-trip, offsets off the read or program size are rejected
+ */
+uint8_t unit_bd(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_bd_config_t config;
+    w25qxx_bd_stats_t stats;
+    uint32_t i;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    memset(&config, 0, sizeof(config));
+    config.addr = UNIT_BD_ADDR;
+    config.block_size = 4096;
+    config.block_count = UNIT_BD_COUNT;
+    config.read_size = 16;
+    config.prog_size = 16;
+    config.cache_size = sizeof(gs_cache);
+    config.read_mode = W25QXX_BD_READ_MODE_AUTO;
+    config.blank_check = 1;
+    UNIT_CHECK(w25qxx_bd_init(&gs_bd, handle, &config, gs_erased, gs_cache) == 0);
+    
+    /* the first erase checks the block blank and skips it, the second knows it */
+    UNIT_CHECK(w25qxx_bd_erase(&gs_bd, 2) == 0);
+    UNIT_CHECK(w25qxx_bd_erase(&gs_bd, 2) == 0);
+    UNIT_CHECK(w25qxx_bd_get_stats(&gs_bd, &stats) == 0);
+    UNIT_CHECK(stats.erase_count == 0);
+    UNIT_CHECK(stats.erase_skip == 2);
+    
+    /* a program starting at 0xF0 crosses two page boundaries */
+    unit_pattern(gs_buf, 0x220, 1);
+    UNIT_CHECK(w25qxx_bd_prog(&gs_bd, 2, 0x0F0, gs_buf, 0x220) == 0);
+    UNIT_CHECK(w25qxx_read(handle, UNIT_BD_ADDR + 2 * 4096 + 0x0F0, gs_check, 0x220) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 0x220) == 0);
+    
+    /* small reads through the cache at every read size step */
+    memset(gs_check, 0, sizeof(gs_check));
+    for (i = 0; i < 0x220; i += 16)
+    {
+        UNIT_CHECK(w25qxx_bd_read(&gs_bd, 2, 0x0F0 + i, &gs_check[i], 16) == 0);
+    }
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 0x220) == 0);
+    UNIT_CHECK(w25qxx_bd_get_stats(&gs_bd, &stats) == 0);
+    UNIT_CHECK(stats.cache_hit_bytes + stats.read_bytes >= 0x220);
+    UNIT_CHECK(stats.cache_hit_bytes != 0);
+    
+    /* one read spanning the written range and the blank bytes around it */
+    UNIT_CHECK(w25qxx_bd_read(&gs_bd, 2, 0x0E0, gs_check, 0x240) == 0);
+    for (i = 0; i < 0x10; i++)
+    {
+        UNIT_CHECK(gs_check[i] == 0xFF);
+        UNIT_CHECK(gs_check[0x230 + i] == 0xFF);
+    }
+    UNIT_CHECK(memcmp(gs_buf, &gs_check[0x10], 0x220) == 0);
+    
+    /* a second program into the blank tail of the block is seen by a cached read */
+    unit_pattern(gs_buf, 0x30, 2);
+    UNIT_CHECK(w25qxx_bd_prog(&gs_bd, 2, 0x310, gs_buf, 0x30) == 0);
+    UNIT_CHECK(w25qxx_bd_read(&gs_bd, 2, 0x310, gs_check, 0x30) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 0x30) == 0);
+    
+    /* an erase after the program really erases and the block reads blank */
+    UNIT_CHECK(w25qxx_bd_erase(&gs_bd, 2) == 0);
+    UNIT_CHECK(w25qxx_bd_read(&gs_bd, 2, 0x000, gs_check, 4096) == 0);
+    for (i = 0; i < 4096; i++)
+    {
+        UNIT_CHECK(gs_check[i] == 0xFF);
+    }
+    UNIT_CHECK(w25qxx_bd_get_stats(&gs_bd, &stats) == 0);
+    UNIT_CHECK(stats.erase_count == 1);
+    
+    /* offsets and sizes off the read or program size are rejected */
+    UNIT_CHECK(w25qxx_bd_read(&gs_bd, 2, 0x001, gs_check, 16) == 4);
+    UNIT_CHECK(w25qxx_bd_read(&gs_bd, 2, 0x000, gs_check, 17) == 4);
+    UNIT_CHECK(w25qxx_bd_prog(&gs_bd, 2, 0x008, gs_buf, 16) == 4);
+    UNIT_CHECK(w25qxx_bd_prog(&gs_bd, 2, 0xFF0, gs_buf, 32) == 4);
+    UNIT_CHECK(w25qxx_bd_erase(&gs_bd, UNIT_BD_COUNT) == 4);
+    
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_blob.c
+ * @brief     w25qxx blob unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_blob.h"
+
+/**
+ * @brief unit blob definition
+ */
+#define UNIT_BLOB_ADDR         0x010000        /**< region address */
+#define UNIT_BLOB_LEN          0x040000        /**< region length */
+#define UNIT_BLOB_TEXT         20000           /**< compressible bytes */
+#define UNIT_BLOB_RAW          2048            /**< incompressible bytes at the end */
+#define UNIT_BLOB_SIZE         (UNIT_BLOB_TEXT + UNIT_BLOB_RAW)        /**< blob size */
+
+static w25qxx_blob_t gs_blob;                   /**< blob */
+static uint8_t gs_data[UNIT_BLOB_SIZE];         /**< blob data */
+static uint8_t gs_check[UNIT_BLOB_SIZE];        /**< check buffer */
+
+/**
+ * @brief  blob case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a finished blob reads back after a reopen, a flipped bit in a stored
+ *         frame fails the crc check of the first read
+ */
+uint8_t unit_blob(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_blob_info_t info;
+    uint8_t *mem;
+    uint32_t size;
+    uint32_t i;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    for (i = 0; i < UNIT_BLOB_TEXT; i++)
+    {
+        gs_data[i] = (uint8_t)("state=OK temp=21 "[i % 17]);
+    }
+    unit_pattern(&gs_data[UNIT_BLOB_TEXT], UNIT_BLOB_RAW, 1);
+    UNIT_CHECK(w25qxx_blob_init(&gs_blob, handle, UNIT_BLOB_ADDR, UNIT_BLOB_LEN, UNIT_BLOB_SIZE) == 0);
+    UNIT_CHECK(w25qxx_blob_open(&gs_blob) == 4);
+    
+    /* write in odd chunks, the text compresses and the tail is stored as is */
+    UNIT_CHECK(w25qxx_blob_create(&gs_blob) == 0);
+    for (i = 0; i < UNIT_BLOB_SIZE; i += 777)
+    {
+        UNIT_CHECK(w25qxx_blob_write(&gs_blob, &gs_data[i], (UNIT_BLOB_SIZE - i > 777) ? 777 : UNIT_BLOB_SIZE - i) == 0);
+    }
+    UNIT_CHECK(w25qxx_blob_finish(&gs_blob) == 0);
+    UNIT_CHECK(w25qxx_blob_get_info(&gs_blob, &info) == 0);
+    UNIT_CHECK(info.size == UNIT_BLOB_SIZE);
+    UNIT_CHECK(info.stored < UNIT_BLOB_TEXT / 4 + UNIT_BLOB_RAW);
+    UNIT_CHECK(w25qxx_blob_read(&gs_blob, 0, gs_check, UNIT_BLOB_SIZE) == 0);
+    UNIT_CHECK(memcmp(gs_data, gs_check, UNIT_BLOB_SIZE) == 0);
+    
+    /* a reopened blob reads back any range */
+    UNIT_CHECK(w25qxx_blob_init(&gs_blob, handle, UNIT_BLOB_ADDR, UNIT_BLOB_LEN, UNIT_BLOB_SIZE) == 0);
+    UNIT_CHECK(w25qxx_blob_open(&gs_blob) == 0);
+    UNIT_CHECK(w25qxx_blob_read(&gs_blob, 1000, gs_check, 3000) == 0);
+    UNIT_CHECK(memcmp(&gs_data[1000], gs_check, 3000) == 0);
+    UNIT_CHECK(w25qxx_blob_read(&gs_blob, UNIT_BLOB_SIZE - 100, gs_check, 100) == 0);
+    UNIT_CHECK(memcmp(&gs_data[UNIT_BLOB_SIZE - 100], gs_check, 100) == 0);
+    
+    /* a flipped bit in the raw tail frame decodes fine but fails the crc */
+    mem = emulator_get_memory(0, &size);
+    UNIT_CHECK(mem != NULL);
+    mem[gs_blob.data_addr + gs_blob.stored - 1] ^= 0x10;
+    UNIT_CHECK(w25qxx_blob_open(&gs_blob) == 0);
+    UNIT_CHECK(w25qxx_blob_read(&gs_blob, 0, gs_check, 16) == 7);
+    UNIT_CHECK(w25qxx_blob_read(&gs_blob, UNIT_BLOB_SIZE - 1, gs_check, 1) == 7);
+    mem[gs_blob.data_addr + gs_blob.stored - 1] ^= 0x10;
+    UNIT_CHECK(w25qxx_blob_open(&gs_blob) == 0);
+    UNIT_CHECK(w25qxx_blob_read(&gs_blob, 0, gs_check, UNIT_BLOB_SIZE) == 0);
+    UNIT_CHECK(memcmp(gs_data, gs_check, UNIT_BLOB_SIZE) == 0);
+    
+    return 0;
+}
@@ -0,0 +1,313 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_bus.c
+ * @brief     w25qxx bus unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_bus.h"
+#include <pthread.h>
+
+static w25qxx_bus_t gs_bus;                                          /**< shared bus */
+static w25qxx_bus_chip_t gs_chip[2];                                 /**< bus chips */
+static w25qxx_handle_t *gs_handle[2];                                /**< chip handles */
+static pthread_mutex_t gs_emulator = PTHREAD_MUTEX_INITIALIZER;      /**< emulator lock */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;         /**< bus mutex */
+static uint8_t gs_taken;                                             /**< another chip holds the bus */
+static uint8_t gs_locked;                                            /**< bus lock state */
+static uint32_t gs_unlocked;                                         /**< transfers sent without the bus lock */
+static uint32_t gs_bad;                                              /**< wrong bytes read by the reader thread */
+
+/**
+ * @brief     bus transfer
+ * @param[in] cs chip select
+ * @note      the other parameters are the ones of the spi_qspi_write_read hook
+ */
+static uint8_t a_unit_bus_write_read(uint8_t cs, uint8_t instruction, uint8_t instruction_line,
+                                     uint32_t address, uint8_t address_line, uint8_t address_len,
+                                     uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                     uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                     uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    uint8_t res;
+    
+    if (gs_locked == 0)
+    {
+        gs_unlocked++;
+    }
+    (void)pthread_mutex_lock(&gs_emulator);
+    res = emulator_write_read(cs, instruction, instruction_line, address, address_line, address_len,
+                              alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                              out_buf, out_len, data_line);
+    (void)pthread_mutex_unlock(&gs_emulator);
+    
+    return res;
+}
+
+/**
+ * @brief chip 0 spi qspi write read through the bus
+ * @note  same parameters as the spi_qspi_write_read hook
+ */
+static uint8_t a_unit_bus_chip_0(uint8_t instruction, uint8_t instruction_line,
+                                 uint32_t address, uint8_t address_line, uint8_t address_len,
+                                 uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                 uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                 uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    return w25qxx_bus_write_read(&gs_chip[0], instruction, instruction_line, address, address_line, address_len,
+                                 alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                                 out_buf, out_len, data_line);
+}
+
+/**
+ * @brief chip 1 spi qspi write read through the bus
+ * @note  same parameters as the spi_qspi_write_read hook
+ */
+static uint8_t a_unit_bus_chip_1(uint8_t instruction, uint8_t instruction_line,
+                                 uint32_t address, uint8_t address_line, uint8_t address_len,
+                                 uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                 uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                 uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    return w25qxx_bus_write_read(&gs_chip[1], instruction, instruction_line, address, address_line, address_len,
+                                 alternate, alternate_line, alternate_len, dummy, in_buf, in_len,
+                                 out_buf, out_len, data_line);
+}
+
+/**
+ * @brief bus lock
+ * @note  none
+ */
+static void a_unit_bus_lock(void)
+{
+    (void)pthread_mutex_lock(&gs_mutex);
+    gs_locked = 1;
+}
+
+/**
+ * @brief  bus try lock
+ * @return status code
+ *         - 0 locked
+ *         - 1 the bus is taken
+ * @note   gs_taken models another chip holding the bus
+ */
+static uint8_t a_unit_bus_try_lock(void)
+{
+    if ((gs_taken != 0) || (pthread_mutex_trylock(&gs_mutex) != 0))
+    {
+        return 1;
+    }
+    gs_locked = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief bus unlock
+ * @note  none
+ */
+static void a_unit_bus_unlock(void)
+{
+    gs_locked = 0;
+    (void)pthread_mutex_unlock(&gs_mutex);
+}
+
+/**
+ * @brief     delay ms under the emulator lock
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_unit_bus_delay_ms(uint32_t ms)
+{
+    (void)pthread_mutex_lock(&gs_emulator);
+    emulator_delay_ms(ms);
+    (void)pthread_mutex_unlock(&gs_emulator);
+}
+
+/**
+ * @brief     delay us under the emulator lock
+ * @param[in] us time
+ * @note      none
+ */
+static void a_unit_bus_delay_us(uint32_t us)
+{
+    (void)pthread_mutex_lock(&gs_emulator);
+    emulator_delay_us(us);
+    (void)pthread_mutex_unlock(&gs_emulator);
+}
+
+/**
+ * @brief     eraser thread
+ * @param[in] *arg pointer to a result buffer
+ * @return    NULL
+ * @note      none
+ */
+static void *a_unit_bus_eraser(void *arg)
+{
+    uint8_t *res = (uint8_t *)arg;
+    uint32_t i;
+    
+    for (i = 0; i < 8; i++)
+    {
+        *res |= w25qxx_sector_erase_4k(gs_handle[0], 0x020000 + i * 4096);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     reader thread
+ * @param[in] *arg pointer to a result buffer
+ * @return    NULL
+ * @note      none
+ */
+static void *a_unit_bus_reader(void *arg)
+{
+    uint8_t *res = (uint8_t *)arg;
+    uint8_t buf[256];
+    uint8_t check[256];
+    uint32_t i;
+    
+    for (i = 0; i < 64; i++)
+    {
+        *res |= w25qxx_read(gs_handle[1], i * 256, buf, 256);
+        unit_pattern(check, 256, i);
+        if (memcmp(buf, check, 256) != 0)
+        {
+            gs_bad++;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief  bus case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   every transfer holds the bus lock, a busy chip answers its polls without the
+ *         bus at most W25QXX_BUS_MAX_DEFER times in a row, and an erase on one chip
+ *         runs next to reads of the other chip from another thread
+ */
+uint8_t unit_bus(void)
+{
+    w25qxx_bus_stats_t stats;
+    emulator_stats_t es;
+    pthread_t eraser;
+    pthread_t reader;
+    uint8_t buf[256];
+    uint8_t check[256];
+    uint8_t erase_res;
+    uint8_t read_res;
+    uint8_t *mem;
+    uint32_t size;
+    uint32_t i;
+    
+    gs_handle[0] = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    gs_handle[1] = unit_open(1, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK((gs_handle[0] != NULL) && (gs_handle[1] != NULL));
+    UNIT_CHECK(w25qxx_bus_init(&gs_bus, a_unit_bus_write_read) == 0);
+    UNIT_CHECK(w25qxx_bus_set_hooks(&gs_bus, a_unit_bus_lock, a_unit_bus_try_lock, a_unit_bus_unlock) == 0);
+    UNIT_CHECK(w25qxx_bus_chip_init(&gs_bus, &gs_chip[0], 0) == 0);
+    UNIT_CHECK(w25qxx_bus_chip_init(&gs_bus, &gs_chip[1], 1) == 0);
+    DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(gs_handle[0], a_unit_bus_chip_0);
+    DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(gs_handle[1], a_unit_bus_chip_1);
+    DRIVER_W25QXX_LINK_DELAY_MS(gs_handle[0], a_unit_bus_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_MS(gs_handle[1], a_unit_bus_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(gs_handle[0], a_unit_bus_delay_us);
+    DRIVER_W25QXX_LINK_DELAY_US(gs_handle[1], a_unit_bus_delay_us);
+    gs_taken = 0;
+    gs_locked = 0;
+    gs_unlocked = 0;
+    gs_bad = 0;
+    
+    /* every transfer of both chips goes out under the bus lock */
+    emulator_clear_stats();
+    unit_pattern(buf, 256, 1);
+    UNIT_CHECK(w25qxx_write(gs_handle[0], 0x001000, buf, 256) == 0);
+    UNIT_CHECK(w25qxx_read(gs_handle[1], 0x001000, buf, 256) == 0);
+    UNIT_CHECK(buf[0] == 0xFF);
+    UNIT_CHECK(w25qxx_read(gs_handle[0], 0x001000, buf, 256) == 0);
+    unit_pattern(check, 256, 1);
+    UNIT_CHECK(memcmp(buf, check, 256) == 0);
+    UNIT_CHECK(w25qxx_bus_get_stats(&gs_bus, &stats) == 0);
+    emulator_get_stats(&es);
+    UNIT_CHECK(stats.transaction == es.transaction);
+    UNIT_CHECK(gs_unlocked == 0);
+    
+    /* with the bus taken by another chip, the polls of a busy chip are deferred in short rows */
+    gs_taken = 1;
+    UNIT_CHECK(w25qxx_bus_get_stats(&gs_bus, &stats) == 0);
+    UNIT_CHECK(w25qxx_sector_erase_4k(gs_handle[0], 0x001000) == 0);
+    size = stats.poll;
+    UNIT_CHECK(w25qxx_bus_get_stats(&gs_bus, &stats) == 0);
+    UNIT_CHECK(gs_chip[0].defer != 0);
+    UNIT_CHECK(gs_chip[0].defer <= W25QXX_BUS_MAX_DEFER * (stats.poll - size));
+    UNIT_CHECK(gs_chip[1].defer == 0);
+    UNIT_CHECK(w25qxx_read(gs_handle[0], 0x001000, buf, 256) == 0);
+    for (i = 0; i < 256; i++)
+    {
+        UNIT_CHECK(buf[i] == 0xFF);
+    }
+    gs_taken = 0;
+    UNIT_CHECK(gs_unlocked == 0);
+    
+    /* an erase of chip 0 and reads of chip 1 from two threads */
+    mem = emulator_get_memory(1, &size);
+    UNIT_CHECK(mem != NULL);
+    for (i = 0; i < 64; i++)
+    {
+        unit_pattern(&mem[i * 256], 256, i);
+    }
+    mem = emulator_get_memory(0, &size);
+    UNIT_CHECK(mem != NULL);
+    memset(&mem[0x020000], 0x00, 0x8000);
+    erase_res = 0;
+    read_res = 0;
+    UNIT_CHECK(pthread_create(&eraser, NULL, a_unit_bus_eraser, &erase_res) == 0);
+    UNIT_CHECK(pthread_create(&reader, NULL, a_unit_bus_reader, &read_res) == 0);
+    (void)pthread_join(eraser, NULL);
+    (void)pthread_join(reader, NULL);
+    UNIT_CHECK((erase_res == 0) && (read_res == 0));
+    UNIT_CHECK(gs_bad == 0);
+    UNIT_CHECK(gs_unlocked == 0);
+    mem = emulator_get_memory(0, &size);
+    UNIT_CHECK(mem != NULL);
+    for (i = 0x020000; i < 0x028000; i++)
+    {
+        UNIT_CHECK(mem[i] == 0xFF);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_ckpt.c
+ * @brief     w25qxx ckpt unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_ckpt.h"
+#include "driver_w25qxx_util.h"
+
+static w25qxx_ckpt_t gs_ckpt;        /**< checkpoint */
+
+/**
+ * @brief     reload the checkpoint
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] generation expected generation
+ * @param[in] seed expected data seed
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      models a reboot
+ */
+static uint8_t a_unit_ckpt_expect(w25qxx_handle_t *handle, uint32_t generation, uint32_t seed)
+{
+    uint8_t data[W25QXX_CKPT_DATA_SIZE];
+    uint8_t check[W25QXX_CKPT_DATA_SIZE];
+    uint32_t g;
+    
+    UNIT_CHECK(w25qxx_ckpt_init(&gs_ckpt, handle, W25QXX_CKPT_REGISTER_2 | W25QXX_CKPT_REGISTER_3) == 0);
+    UNIT_CHECK(w25qxx_ckpt_load(&gs_ckpt, data, &g) == 0);
+    UNIT_CHECK(g == generation);
+    unit_pattern(check, W25QXX_CKPT_DATA_SIZE, seed);
+    UNIT_CHECK(memcmp(data, check, W25QXX_CKPT_DATA_SIZE) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief  ckpt case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a commit that fails or is torn by a power loss leaves the last good
+ *         checkpoint in place, the next commit skips the torn record
+ */
+uint8_t unit_ckpt(void)
+{
+    w25qxx_handle_t *handle;
+    uint8_t data[W25QXX_CKPT_DATA_SIZE];
+    uint8_t buf[256];
+    uint8_t *rec;
+    uint32_t g;
+    uint32_t i;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(w25qxx_ckpt_init(&gs_ckpt, handle, W25QXX_CKPT_REGISTER_1) == 4);
+    UNIT_CHECK(w25qxx_ckpt_init(&gs_ckpt, handle, W25QXX_CKPT_REGISTER_2 | W25QXX_CKPT_REGISTER_3) == 0);
+    UNIT_CHECK(w25qxx_ckpt_format(&gs_ckpt) == 0);
+    UNIT_CHECK(w25qxx_ckpt_load(&gs_ckpt, data, &g) == 5);
+    
+    /* five commits, the newest one survives a reboot */
+    for (i = 1; i <= 5; i++)
+    {
+        unit_pattern(data, W25QXX_CKPT_DATA_SIZE, i);
+        UNIT_CHECK(w25qxx_ckpt_save(&gs_ckpt, data) == 0);
+    }
+    UNIT_CHECK(a_unit_ckpt_expect(handle, 5, 5) == 0);
+    
+    /* a commit whose program fails returns the error and keeps generation 5 */
+    unit_fail(0, 0x42, 0);
+    unit_pattern(data, W25QXX_CKPT_DATA_SIZE, 6);
+    UNIT_CHECK(w25qxx_ckpt_save(&gs_ckpt, data) == 1);
+    UNIT_CHECK(a_unit_ckpt_expect(handle, 5, 5) == 0);
+    
+    /* a commit torn after the first 20 bytes of record 6, the second record of register 3 */
+    memset(buf, 0xFF, sizeof(buf));
+    rec = &buf[1 * W25QXX_CKPT_RECORD_SIZE];
+    w25qxx_util_put32(&rec[0], 0x30504B43U);
+    w25qxx_util_put32(&rec[4], 6);
+    memcpy(&rec[8], data, 12);
+    UNIT_CHECK(w25qxx_program_security_register(handle, W25QXX_SECURITY_REGISTER_3, buf) == 0);
+    UNIT_CHECK(a_unit_ckpt_expect(handle, 5, 5) == 0);
+    
+    /* the next commit skips the torn record and wins after a reboot */
+    unit_pattern(data, W25QXX_CKPT_DATA_SIZE, 7);
+    UNIT_CHECK(w25qxx_ckpt_save(&gs_ckpt, data) == 0);
+    UNIT_CHECK(a_unit_ckpt_expect(handle, 7, 7) == 0);
+    
+    return 0;
+}
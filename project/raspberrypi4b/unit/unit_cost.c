@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_cost.c
+ * @brief     w25qxx cost unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+
+static uint8_t gs_buf[4096];        /**< data buffer */
+
+/**
+ * @brief     check one estimate against a hand computed count and the emulated bus
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] operation planned operation
+ * @param[in] addr operation address
+ * @param[in] len operation length
+ * @param[in] transaction hand computed transactions
+ * @param[in] cycle hand computed bus cycles
+ * @param[in] poll_cycle bus cycles of one status poll
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      the emulated bus runs at 1 MHz, so one cycle takes 1 us
+ */
+static uint8_t a_unit_cost_check(w25qxx_handle_t *handle, w25qxx_operation_t operation, uint32_t addr,
+                                 uint32_t len, uint32_t transaction, uint64_t cycle, uint32_t poll_cycle)
+{
+    w25qxx_cost_t cost;
+    emulator_stats_t stats;
+    uint8_t res;
+    
+    /* the estimate matches the hand computed frames */
+    UNIT_CHECK(w25qxx_estimate_cost(handle, operation, addr, len, 1000000, &cost) == 0);
+    UNIT_CHECK(cost.transaction == transaction);
+    UNIT_CHECK(cost.cycle == cycle);
+    UNIT_CHECK(cost.bus_time_us == (float)cycle);
+    
+    /* the driver clocks the same frames, the status polls aside */
+    emulator_clear_stats();
+    switch (operation)
+    {
+        case W25QXX_OPERATION_READ :
+        {
+            res = w25qxx_read(handle, addr, gs_buf, len);
+            
+            break;
+        }
+        case W25QXX_OPERATION_FAST_READ_DUAL_OUTPUT :
+        {
+            res = w25qxx_fast_read_dual_output(handle, addr, gs_buf, len);
+            
+            break;
+        }
+        case W25QXX_OPERATION_FAST_READ_QUAD_OUTPUT :
+        {
+            res = w25qxx_fast_read_quad_output(handle, addr, gs_buf, len);
+            
+            break;
+        }
+        case W25QXX_OPERATION_FAST_READ_DUAL_IO :
+        {
+            res = w25qxx_fast_read_dual_io(handle, addr, gs_buf, len);
+            
+            break;
+        }
+        case W25QXX_OPERATION_FAST_READ_QUAD_IO :
+        {
+            res = w25qxx_fast_read_quad_io(handle, addr, gs_buf, len);
+            
+            break;
+        }
+        case W25QXX_OPERATION_PAGE_PROGRAM :
+        {
+            res = w25qxx_page_program(handle, addr, gs_buf, (uint16_t)len);
+            
+            break;
+        }
+        case W25QXX_OPERATION_WRITE_BLANK :
+        {
+            res = w25qxx_write(handle, addr, gs_buf, len);
+            
+            break;
+        }
+        case W25QXX_OPERATION_SECTOR_ERASE_4K :
+        {
+            res = w25qxx_sector_erase_4k(handle, addr);
+            
+            break;
+        }
+        default :
+        {
+            res = 1;
+            
+            break;
+        }
+    }
+    emulator_get_stats(&stats);
+    UNIT_CHECK(res == 0);
+    UNIT_CHECK(stats.transaction - stats.status_poll == transaction);
+    UNIT_CHECK(stats.bus_ns / 1000 - (uint64_t)stats.status_poll * poll_cycle == cycle);
+    
+    return 0;
+}
+
+/**
+ * @brief  cost case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   the cycles are counted by hand from the frames of each driver function,
+ *         instruction + address + alternate + dummy + data, each phase divided by its lines
+ */
+uint8_t unit_cost(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_cost_t cost;
+    
+    /* single spi, every phase on one line, fast read has 8 dummy cycles */
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(w25qxx_estimate_cost(handle, W25QXX_OPERATION_READ, 0, 1, 1000000, NULL) == 7);
+    UNIT_CHECK(w25qxx_estimate_cost(handle, W25QXX_OPERATION_READ, 0, 1, 0, &cost) == 4);
+    UNIT_CHECK(w25qxx_estimate_cost(handle, W25QXX_OPERATION_FAST_READ_DUAL_OUTPUT, 0, 1, 1000000, &cost) == 5);
+    UNIT_CHECK(w25qxx_estimate_cost(handle, W25QXX_OPERATION_FAST_READ_QUAD_IO, 0, 1, 1000000, &cost) == 5);
+    UNIT_CHECK(w25qxx_estimate_cost(handle, W25QXX_OPERATION_PAGE_PROGRAM, 0xF0, 32, 1000000, &cost) == 6);
+    
+    /* 8 + 24 + 8 + 100 * 8 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_READ, 0x000010, 100, 1, 840, 16) == 0);
+    
+    /* write enable 8, then 8 + 24 + 200 * 8 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_PAGE_PROGRAM, 0x001000, 200, 2, 1640, 16) == 0);
+    
+    /* write enable 8, then 8 + 24 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_SECTOR_ERASE_4K, 0x001000, 0, 2, 40, 16) == 0);
+    
+    /* read 4k 8 + 24 + 8 + 32768, then 256 bytes 8 + 8 + 24 + 2048 and 44 bytes 8 + 8 + 24 + 352 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_WRITE_BLANK, 0x003000, 300, 5, 35288, 16) == 0);
+    unit_close(0);
+    
+    /* dual quad spi, w25qxx_read keeps the one line fast read */
+    handle = unit_open(1, W25QXX_INTERFACE_SPI, W25QXX_BOOL_TRUE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_READ, 0x000010, 100, 1, 840, 16) == 0);
+    
+    /* 1-1-2, 8 + 24 + 8 + 100 * 8 / 2 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_FAST_READ_DUAL_OUTPUT, 0x000010, 100, 1, 440, 16) == 0);
+    
+    /* 1-1-4, 8 + 24 + 8 + 100 * 8 / 4 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_FAST_READ_QUAD_OUTPUT, 0x000010, 100, 1, 240, 16) == 0);
+    
+    /* 1-2-2, 8 + 24 / 2 + mode 8 / 2 + 100 * 8 / 2 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_FAST_READ_DUAL_IO, 0x000010, 100, 1, 424, 16) == 0);
+    
+    /* 1-4-4, 8 + 24 / 4 + mode 8 / 4 + 4 dummy + 100 * 8 / 4 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_FAST_READ_QUAD_IO, 0x000010, 100, 1, 220, 16) == 0);
+    
+    /* the same page program as single spi */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_PAGE_PROGRAM, 0x001000, 200, 2, 1640, 16) == 0);
+    
+    /* qspi, every phase on four lines with the configured 8 dummy cycles */
+    handle = unit_open(0, W25QXX_INTERFACE_QSPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(w25qxx_estimate_cost(handle, W25QXX_OPERATION_FAST_READ_DUAL_IO, 0, 1, 1000000, &cost) == 5);
+    
+    /* 2 + 6 + 8 + 100 * 2 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_READ, 0x000010, 100, 1, 216, 4) == 0);
+    
+    /* 2 + 6 + mode 2 + 8 + 100 * 2 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_FAST_READ_QUAD_IO, 0x000010, 100, 1, 218, 4) == 0);
+    
+    /* write enable 2, then 2 + 6 + 200 * 2 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_PAGE_PROGRAM, 0x001000, 200, 2, 410, 4) == 0);
+    
+    /* write enable 2, then 2 + 6 */
+    UNIT_CHECK(a_unit_cost_check(handle, W25QXX_OPERATION_SECTOR_ERASE_4K, 0x001000, 0, 2, 10, 4) == 0);
+    
+    return 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_delta.c
+ * @brief     w25qxx delta unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_ota.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief unit delta definition
+ */
+#define UNIT_DELTA_SLOT_A        0x100000        /**< slot a address */
+#define UNIT_DELTA_SLOT_B        0x200000        /**< slot b address */
+#define UNIT_DELTA_SLOT_SIZE     0x040000        /**< slot size */
+#define UNIT_DELTA_SELECTOR      0x080000        /**< selector region address */
+#define UNIT_DELTA_OLD           100000          /**< old image size */
+#define UNIT_DELTA_INSERT        1000            /**< inserted bytes */
+#define UNIT_DELTA_NEW           (UNIT_DELTA_OLD - 10000 + UNIT_DELTA_INSERT)        /**< new image size */
+
+static w25qxx_ota_t gs_ota;                                        /**< slot manager */
+static w25qxx_ota_patch_t gs_patch;                                /**< patch state */
+static uint8_t gs_old[UNIT_DELTA_OLD];                             /**< old image */
+static uint8_t gs_new[UNIT_DELTA_NEW];                             /**< new image */
+static uint8_t gs_check[UNIT_DELTA_OLD];                           /**< check buffer */
+static uint8_t gs_stream[64 + UNIT_DELTA_INSERT];                  /**< patch stream */
+static uint32_t gs_stream_len;                                     /**< patch stream length */
+
+/**
+ * @brief     append a copy op to the patch stream
+ * @param[in] offset old image offset
+ * @param[in] len copy length
+ * @note      none
+ */
+static void a_unit_delta_copy(uint32_t offset, uint32_t len)
+{
+    gs_stream[gs_stream_len] = 0x01;
+    w25qxx_util_put32(&gs_stream[gs_stream_len + 1], offset);
+    w25qxx_util_put32(&gs_stream[gs_stream_len + 5], len);
+    gs_stream_len += 9;
+}
+
+/**
+ * @brief     mount the slots again
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      models a reboot, a patch in progress is lost
+ */
+static uint8_t a_unit_delta_remount(w25qxx_handle_t *handle)
+{
+    UNIT_CHECK(w25qxx_ota_init(&gs_ota, handle, UNIT_DELTA_SLOT_A, UNIT_DELTA_SLOT_B,
+                               UNIT_DELTA_SLOT_SIZE, UNIT_DELTA_SELECTOR) == 0);
+    UNIT_CHECK(w25qxx_ota_mount(&gs_ota) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     check the active slot
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] slot expected slot
+ * @param[in] *image pointer to the expected image
+ * @param[in] len expected image size
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_unit_delta_expect(w25qxx_handle_t *handle, w25qxx_ota_slot_t slot, const uint8_t *image, uint32_t len)
+{
+    w25qxx_ota_slot_t active;
+    w25qxx_ota_image_t info;
+    uint32_t addr;
+    
+    UNIT_CHECK(w25qxx_ota_get_active(&gs_ota, &active, &addr, &info) == 0);
+    UNIT_CHECK(active == slot);
+    UNIT_CHECK(info.size == len);
+    UNIT_CHECK(w25qxx_read(handle, addr, gs_check, len) == 0);
+    UNIT_CHECK(memcmp(gs_check, image, len) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief  delta case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a patch interrupted by a reboot leaves the old image active, applying it
+ *         again skips the pages the first run already programmed
+ */
+uint8_t unit_delta(void)
+{
+    w25qxx_handle_t *handle;
+    uint32_t programmed;
+    uint32_t half;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    
+    /* the new image keeps the head, inserts a block and drops 11000 bytes before the tail */
+    unit_pattern(gs_old, UNIT_DELTA_OLD, 1);
+    memcpy(&gs_new[0], &gs_old[0], 50000);
+    unit_pattern(&gs_new[50000], UNIT_DELTA_INSERT, 2);
+    memcpy(&gs_new[50000 + UNIT_DELTA_INSERT], &gs_old[60000], UNIT_DELTA_OLD - 60000);
+    w25qxx_util_put32(&gs_stream[0], 0x30504457U);
+    w25qxx_util_put32(&gs_stream[4], UNIT_DELTA_NEW);
+    w25qxx_util_put32(&gs_stream[8], ~w25qxx_util_crc32(0xFFFFFFFFU, gs_new, UNIT_DELTA_NEW));
+    w25qxx_util_put32(&gs_stream[12], ~w25qxx_util_crc32(0xFFFFFFFFU, gs_old, UNIT_DELTA_OLD));
+    gs_stream_len = 16;
+    a_unit_delta_copy(0, 50000);
+    gs_stream[gs_stream_len] = 0x02;
+    w25qxx_util_put32(&gs_stream[gs_stream_len + 1], UNIT_DELTA_INSERT);
+    memcpy(&gs_stream[gs_stream_len + 5], &gs_new[50000], UNIT_DELTA_INSERT);
+    gs_stream_len += 5 + UNIT_DELTA_INSERT;
+    a_unit_delta_copy(60000, UNIT_DELTA_OLD - 60000);
+    
+    /* install the old image into slot a */
+    UNIT_CHECK(a_unit_delta_remount(handle) == 0);
+    UNIT_CHECK(w25qxx_ota_patch_begin(&gs_ota, &gs_patch) == 5);
+    UNIT_CHECK(w25qxx_ota_begin(&gs_ota, UNIT_DELTA_OLD) == 0);
+    UNIT_CHECK(w25qxx_ota_write(&gs_ota, gs_old, UNIT_DELTA_OLD) == 0);
+    UNIT_CHECK(w25qxx_ota_finish(&gs_ota, ~w25qxx_util_crc32(0xFFFFFFFFU, gs_old, UNIT_DELTA_OLD)) == 0);
+    
+    /* the stream stops after the first copy, the reboot keeps slot a */
+    half = 16 + 9;
+    UNIT_CHECK(w25qxx_ota_patch_begin(&gs_ota, &gs_patch) == 0);
+    UNIT_CHECK(w25qxx_ota_patch_write(&gs_ota, &gs_patch, gs_stream, half) == 0);
+    programmed = gs_patch.page_program;
+    UNIT_CHECK(programmed != 0);
+    UNIT_CHECK(a_unit_delta_remount(handle) == 0);
+    UNIT_CHECK(a_unit_delta_expect(handle, W25QXX_OTA_SLOT_A, gs_old, UNIT_DELTA_OLD) == 0);
+    
+    /* the second run finds the programmed pages in place and flips to slot b */
+    UNIT_CHECK(w25qxx_ota_patch_begin(&gs_ota, &gs_patch) == 0);
+    UNIT_CHECK(w25qxx_ota_patch_write(&gs_ota, &gs_patch, gs_stream, half) == 0);
+    UNIT_CHECK(w25qxx_ota_patch_write(&gs_ota, &gs_patch, &gs_stream[half], gs_stream_len - half) == 0);
+    UNIT_CHECK(w25qxx_ota_patch_finish(&gs_ota, &gs_patch) == 0);
+    UNIT_CHECK(gs_patch.page_skip >= programmed);
+    UNIT_CHECK(gs_patch.page_program + programmed <= (UNIT_DELTA_NEW + 255) / 256);
+    UNIT_CHECK(a_unit_delta_expect(handle, W25QXX_OTA_SLOT_B, gs_new, UNIT_DELTA_NEW) == 0);
+    UNIT_CHECK(a_unit_delta_remount(handle) == 0);
+    UNIT_CHECK(a_unit_delta_expect(handle, W25QXX_OTA_SLOT_B, gs_new, UNIT_DELTA_NEW) == 0);
+    
+    /* a patch made against another image is rejected and keeps slot b */
+    UNIT_CHECK(w25qxx_ota_patch_begin(&gs_ota, &gs_patch) == 0);
+    UNIT_CHECK(w25qxx_ota_patch_write(&gs_ota, &gs_patch, gs_stream, gs_stream_len) == 6);
+    UNIT_CHECK(a_unit_delta_expect(handle, W25QXX_OTA_SLOT_B, gs_new, UNIT_DELTA_NEW) == 0);
+    
+    return 0;
+}
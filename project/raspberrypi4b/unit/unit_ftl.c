@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_ftl.c
+ * @brief     w25qxx ftl unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_ftl.h"
+
+/**
+ * @brief unit ftl definition
+ */
+#define UNIT_FTL_ADDR          0x100000        /**< region address */
+#define UNIT_FTL_LEN           (32 * 4096)     /**< region length */
+
+static w25qxx_ftl_t gs_ftl;                                                /**< ftl */
+static uint16_t gs_map[W25QXX_FTL_LOGICAL_COUNT(UNIT_FTL_LEN)];            /**< logical to physical map */
+static uint32_t gs_info[W25QXX_FTL_PHYSICAL_COUNT(UNIT_FTL_LEN)];          /**< physical sector info */
+static uint32_t gs_before[W25QXX_FTL_PHYSICAL_COUNT(UNIT_FTL_LEN)];        /**< physical sector info before a write */
+static uint8_t gs_buf[4096];                                               /**< data buffer */
+static uint8_t gs_check[4096];                                             /**< check buffer */
+
+/**
+ * @brief     check one logical sector
+ * @param[in] logical logical sector
+ * @param[in] seed pattern seed
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_unit_ftl_expect(uint32_t logical, uint32_t seed)
+{
+    unit_pattern(gs_check, 4096, seed);
+    UNIT_CHECK(w25qxx_ftl_read(&gs_ftl, logical, gs_buf) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief  ftl case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a write whose data program fails keeps the old mapping, the retry is
+ *         remapped to another sector and the new data survives a remount
+ */
+uint8_t unit_ftl(void)
+{
+    w25qxx_handle_t *handle;
+    uint16_t old;
+    uint32_t bad;
+    uint32_t i;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(w25qxx_ftl_init(&gs_ftl, handle, UNIT_FTL_ADDR, UNIT_FTL_LEN,
+                               gs_map, W25QXX_FTL_LOGICAL_COUNT(UNIT_FTL_LEN),
+                               gs_info, W25QXX_FTL_PHYSICAL_COUNT(UNIT_FTL_LEN)) == 0);
+    UNIT_CHECK(w25qxx_ftl_mount(&gs_ftl) == 4);
+    UNIT_CHECK(w25qxx_ftl_format(&gs_ftl) == 0);
+    
+    /* an unmapped sector reads blank, a written one survives a remount */
+    UNIT_CHECK(w25qxx_ftl_read(&gs_ftl, 3, gs_buf) == 0);
+    for (i = 0; i < 4096; i++)
+    {
+        UNIT_CHECK(gs_buf[i] == 0xFF);
+    }
+    unit_pattern(gs_buf, 4096, 1);
+    UNIT_CHECK(w25qxx_ftl_write(&gs_ftl, 3, gs_buf) == 0);
+    UNIT_CHECK(w25qxx_ftl_mount(&gs_ftl) == 0);
+    UNIT_CHECK(a_unit_ftl_expect(3, 1) == 0);
+    old = gs_map[3];
+    
+    /* the fourth page program of the next write fails, the old data stays mapped */
+    memcpy(gs_before, gs_info, sizeof(gs_info));
+    unit_fail(0, 0x02, 3);
+    unit_pattern(gs_buf, 4096, 2);
+    UNIT_CHECK(w25qxx_ftl_write(&gs_ftl, 3, gs_buf) == 1);
+    UNIT_CHECK(gs_map[3] == old);
+    UNIT_CHECK(a_unit_ftl_expect(3, 1) == 0);
+    bad = W25QXX_FTL_PHYSICAL_COUNT(UNIT_FTL_LEN);
+    for (i = 0; i < W25QXX_FTL_PHYSICAL_COUNT(UNIT_FTL_LEN); i++)
+    {
+        if (gs_info[i] != gs_before[i])
+        {
+            bad = i;
+        }
+    }
+    UNIT_CHECK(bad != W25QXX_FTL_PHYSICAL_COUNT(UNIT_FTL_LEN));
+    UNIT_CHECK(bad != old);
+    
+    /* the retry goes to neither the old nor the torn sector */
+    unit_pattern(gs_buf, 4096, 2);
+    UNIT_CHECK(w25qxx_ftl_write(&gs_ftl, 3, gs_buf) == 0);
+    UNIT_CHECK(gs_map[3] != old);
+    UNIT_CHECK(gs_map[3] != bad);
+    UNIT_CHECK(a_unit_ftl_expect(3, 2) == 0);
+    UNIT_CHECK(w25qxx_ftl_mount(&gs_ftl) == 0);
+    UNIT_CHECK(a_unit_ftl_expect(3, 2) == 0);
+    
+    /* the torn sector is erased before it is used again */
+    for (i = 0; i < 64; i++)
+    {
+        unit_pattern(gs_buf, 4096, 100 + i);
+        UNIT_CHECK(w25qxx_ftl_write(&gs_ftl, i % 8, gs_buf) == 0);
+    }
+    UNIT_CHECK(w25qxx_ftl_mount(&gs_ftl) == 0);
+    for (i = 0; i < 8; i++)
+    {
+        UNIT_CHECK(a_unit_ftl_expect(i, 100 + 56 + i) == 0);
+    }
+    
+    return 0;
+}
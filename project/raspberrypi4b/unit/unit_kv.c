@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_kv.c
+ * @brief     w25qxx kv unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_kv.h"
+
+/**
+ * @brief unit kv definition
+ */
+#define UNIT_KV_ADDR          0x010000        /**< region address */
+#define UNIT_KV_LEN           (6 * 4096)      /**< region length */
+#define UNIT_KV_INDEX         64              /**< index entries */
+#define UNIT_KV_KEY           8               /**< keys of the update loop */
+
+static w25qxx_kv_t gs_kv;                               /**< kv store */
+static w25qxx_kv_t gs_kv2;                              /**< kv store mounted after a reboot */
+static w25qxx_kv_entry_t gs_index[UNIT_KV_INDEX];       /**< kv index */
+static w25qxx_kv_entry_t gs_index2[UNIT_KV_INDEX];      /**< second kv index */
+
+/**
+ * @brief     mount the region again into the second store
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      models a reboot, nothing of the first store is reused
+ */
+static uint8_t a_unit_kv_remount(w25qxx_handle_t *handle)
+{
+    memset(&gs_kv2, 0, sizeof(gs_kv2));
+    UNIT_CHECK(w25qxx_kv_init(&gs_kv2, handle, UNIT_KV_ADDR, UNIT_KV_LEN, gs_index2, UNIT_KV_INDEX) == 0);
+    UNIT_CHECK(w25qxx_kv_mount(&gs_kv2) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     check one key
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *key pointer to a key string
+ * @param[in] *value pointer to an expected value string
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_unit_kv_expect(w25qxx_kv_t *kv, const char *key, const char *value)
+{
+    uint8_t buf[32];
+    uint16_t len;
+    
+    UNIT_CHECK(w25qxx_kv_get(kv, (const uint8_t *)key, (uint8_t)strlen(key), buf, sizeof(buf), &len) == 0);
+    UNIT_CHECK(len == strlen(value));
+    UNIT_CHECK(memcmp(buf, value, len) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief  kv case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a value set before a reboot is found after it, through updates, deletes,
+ *         several laps of compaction and a torn record at the append point
+ */
+uint8_t unit_kv(void)
+{
+    w25qxx_handle_t *handle;
+    uint8_t header[W25QXX_KV_RECORD_HEADER];
+    char key[16];
+    char value[16];
+    uint32_t count;
+    uint32_t free_sector;
+    uint32_t addr;
+    uint32_t i;
+    uint32_t j;
+    uint16_t len;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(w25qxx_kv_init(&gs_kv, handle, UNIT_KV_ADDR, UNIT_KV_LEN, gs_index, UNIT_KV_INDEX) == 0);
+    UNIT_CHECK(w25qxx_kv_mount(&gs_kv) == 4);
+    UNIT_CHECK(w25qxx_kv_format(&gs_kv) == 0);
+    
+    /* set, update, then find both after a reboot */
+    UNIT_CHECK(w25qxx_kv_set(&gs_kv, (const uint8_t *)"alpha", 5, (const uint8_t *)"one", 3) == 0);
+    UNIT_CHECK(w25qxx_kv_set(&gs_kv, (const uint8_t *)"beta", 4, (const uint8_t *)"two", 3) == 0);
+    UNIT_CHECK(w25qxx_kv_set(&gs_kv, (const uint8_t *)"alpha", 5, (const uint8_t *)"uno", 3) == 0);
+    UNIT_CHECK(a_unit_kv_remount(handle) == 0);
+    UNIT_CHECK(a_unit_kv_expect(&gs_kv2, "alpha", "uno") == 0);
+    UNIT_CHECK(a_unit_kv_expect(&gs_kv2, "beta", "two") == 0);
+    UNIT_CHECK(w25qxx_kv_get_usage(&gs_kv2, &count, &free_sector) == 0);
+    UNIT_CHECK(count == 2);
+    
+    /* a deleted key stays deleted after a reboot */
+    UNIT_CHECK(w25qxx_kv_delete(&gs_kv2, (const uint8_t *)"beta", 4) == 0);
+    UNIT_CHECK(w25qxx_kv_delete(&gs_kv2, (const uint8_t *)"beta", 4) == 6);
+    UNIT_CHECK(a_unit_kv_remount(handle) == 0);
+    UNIT_CHECK(w25qxx_kv_get(&gs_kv2, (const uint8_t *)"beta", 4, (uint8_t *)value, sizeof(value), &len) == 6);
+    UNIT_CHECK(a_unit_kv_expect(&gs_kv2, "alpha", "uno") == 0);
+    
+    /* enough updates to lap the region several times, the compaction keeps the newest values */
+    for (i = 0; i < 2000; i++)
+    {
+        (void)snprintf(key, sizeof(key), "key%u", (unsigned int)(i % UNIT_KV_KEY));
+        (void)snprintf(value, sizeof(value), "value%u", (unsigned int)i);
+        UNIT_CHECK(w25qxx_kv_set(&gs_kv2, (const uint8_t *)key, (uint8_t)strlen(key),
+                                 (const uint8_t *)value, (uint16_t)strlen(value)) == 0);
+        if ((i % 300) == 0)
+        {
+            UNIT_CHECK(w25qxx_kv_gc(&gs_kv2) == 0);
+        }
+    }
+    UNIT_CHECK(a_unit_kv_remount(handle) == 0);
+    for (j = 0; j < UNIT_KV_KEY; j++)
+    {
+        (void)snprintf(key, sizeof(key), "key%u", (unsigned int)j);
+        (void)snprintf(value, sizeof(value), "value%u", (unsigned int)(2000 - UNIT_KV_KEY + j));
+        UNIT_CHECK(a_unit_kv_expect(&gs_kv2, key, value) == 0);
+    }
+    UNIT_CHECK(a_unit_kv_expect(&gs_kv2, "alpha", "uno") == 0);
+    UNIT_CHECK(w25qxx_kv_get_usage(&gs_kv2, &count, &free_sector) == 0);
+    UNIT_CHECK(count == UNIT_KV_KEY + 1);
+    
+    /* a record header torn by a power loss at the append point is skipped */
+    addr = gs_kv2.addr + gs_kv2.head * 4096 + gs_kv2.offset;
+    memset(header, 0x00, sizeof(header));
+    header[0] = 5;
+    header[2] = 3;
+    UNIT_CHECK(w25qxx_page_program(handle, addr, header, sizeof(header)) == 0);
+    UNIT_CHECK(a_unit_kv_remount(handle) == 0);
+    UNIT_CHECK(a_unit_kv_expect(&gs_kv2, "alpha", "uno") == 0);
+    UNIT_CHECK(w25qxx_kv_set(&gs_kv2, (const uint8_t *)"gamma", 5, (const uint8_t *)"three", 5) == 0);
+    UNIT_CHECK(a_unit_kv_remount(handle) == 0);
+    UNIT_CHECK(a_unit_kv_expect(&gs_kv2, "gamma", "three") == 0);
+    UNIT_CHECK(a_unit_kv_expect(&gs_kv2, "alpha", "uno") == 0);
+    
+    return 0;
+}
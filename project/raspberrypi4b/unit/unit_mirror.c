@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_mirror.c
+ * @brief     w25qxx mirror unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_mirror.h"
+
+static w25qxx_mirror_t gs_mirror;          /**< mirrored volume */
+static uint8_t gs_locked;                  /**< state lock depth */
+static uint8_t gs_race;                    /**< start a write on the next mismatch */
+static uint8_t gs_buf[4096];               /**< data buffer */
+static uint8_t gs_check[4096];             /**< check buffer */
+
+/**
+ * @brief lock the mirror state
+ * @note  none
+ */
+static void a_unit_mirror_lock(void)
+{
+    gs_locked++;
+}
+
+/**
+ * @brief unlock the mirror state
+ * @note  a mismatch counted under the lock starts a write when armed
+ */
+static void a_unit_mirror_unlock(void)
+{
+    if ((gs_race != 0) && (gs_mirror.stats.mismatch != 0))
+    {
+        gs_mirror.generation++;
+        gs_race = 0;
+    }
+    gs_locked--;
+}
+
+/**
+ * @brief  mirror case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a verified read repairs chip 1 from chip 0 and counts it, the repair
+ *         is skipped when a write started after chip 0 was read
+ */
+uint8_t unit_mirror(void)
+{
+    w25qxx_handle_t *handle[2];
+    w25qxx_mirror_stats_t stats;
+    uint8_t *memory;
+    uint32_t size;
+    
+    handle[0] = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    handle[1] = unit_open(1, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK((handle[0] != NULL) && (handle[1] != NULL));
+    UNIT_CHECK(w25qxx_mirror_init(&gs_mirror, handle[0], handle[1], 0x10000) == 0);
+    UNIT_CHECK(w25qxx_mirror_set_hooks(&gs_mirror, a_unit_mirror_lock, a_unit_mirror_unlock) == 0);
+    UNIT_CHECK(w25qxx_mirror_set_verify(&gs_mirror, W25QXX_BOOL_TRUE) == 0);
+    unit_pattern(gs_buf, 4096, 1);
+    UNIT_CHECK(w25qxx_mirror_write(&gs_mirror, 0x000000, gs_buf, 4096) == 0);
+    memory = emulator_get_memory(1, &size);
+    UNIT_CHECK(memory != NULL);
+    
+    /* a corrupted chip 1 is repaired from chip 0 */
+    memory[0x100] ^= 0x01;
+    UNIT_CHECK(w25qxx_mirror_read(&gs_mirror, 0x000000, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_buf, memory, 4096) == 0);
+    UNIT_CHECK(w25qxx_mirror_get_stats(&gs_mirror, &stats) == 0);
+    UNIT_CHECK(stats.mismatch == 1);
+    UNIT_CHECK(stats.repair == 1);
+    UNIT_CHECK(gs_locked == 0);
+    
+    /* a write started after chip 0 was read skips the repair */
+    memory[0x100] ^= 0x01;
+    gs_race = 1;
+    UNIT_CHECK(w25qxx_mirror_read(&gs_mirror, 0x000000, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    UNIT_CHECK(memory[0x100] == (gs_buf[0x100] ^ 0x01));
+    UNIT_CHECK(w25qxx_mirror_get_stats(&gs_mirror, &stats) == 0);
+    UNIT_CHECK(stats.mismatch == 2);
+    UNIT_CHECK(stats.repair == 1);
+    
+    /* the next verified read repairs it */
+    UNIT_CHECK(w25qxx_mirror_read(&gs_mirror, 0x000000, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_buf, memory, 4096) == 0);
+    UNIT_CHECK(w25qxx_mirror_get_stats(&gs_mirror, &stats) == 0);
+    UNIT_CHECK(stats.mismatch == 3);
+    UNIT_CHECK(stats.repair == 2);
+    UNIT_CHECK(gs_locked == 0);
+    
+    return 0;
+}
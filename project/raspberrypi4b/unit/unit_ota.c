@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_ota.c
+ * @brief     w25qxx ota unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_ota.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief unit ota definition
+ */
+#define UNIT_OTA_SLOT_A        0x100000        /**< slot a address */
+#define UNIT_OTA_SLOT_B        0x200000        /**< slot b address */
+#define UNIT_OTA_SLOT_SIZE     0x040000        /**< slot size */
+#define UNIT_OTA_SELECTOR      0x080000        /**< selector region address */
+#define UNIT_OTA_SIZE          100000          /**< image size */
+
+static w25qxx_ota_t gs_ota;                       /**< slot manager */
+static uint8_t gs_image[2][UNIT_OTA_SIZE];        /**< images */
+static uint8_t gs_check[UNIT_OTA_SIZE];           /**< check buffer */
+
+/**
+ * @brief     mount the slots again
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      models a reboot, an install in progress is lost
+ */
+static uint8_t a_unit_ota_remount(w25qxx_handle_t *handle)
+{
+    UNIT_CHECK(w25qxx_ota_init(&gs_ota, handle, UNIT_OTA_SLOT_A, UNIT_OTA_SLOT_B,
+                               UNIT_OTA_SLOT_SIZE, UNIT_OTA_SELECTOR) == 0);
+    UNIT_CHECK(w25qxx_ota_mount(&gs_ota) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     check the active slot
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] slot expected slot
+ * @param[in] *image pointer to the expected image
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_unit_ota_expect(w25qxx_handle_t *handle, w25qxx_ota_slot_t slot, const uint8_t *image)
+{
+    w25qxx_ota_slot_t active;
+    w25qxx_ota_image_t info;
+    uint32_t addr;
+    
+    UNIT_CHECK(w25qxx_ota_get_active(&gs_ota, &active, &addr, &info) == 0);
+    UNIT_CHECK(active == slot);
+    UNIT_CHECK(info.size == UNIT_OTA_SIZE);
+    UNIT_CHECK(info.crc == ~w25qxx_util_crc32(0xFFFFFFFFU, image, UNIT_OTA_SIZE));
+    UNIT_CHECK(w25qxx_read(handle, addr, gs_check, UNIT_OTA_SIZE) == 0);
+    UNIT_CHECK(memcmp(gs_check, image, UNIT_OTA_SIZE) == 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     install an image
+ * @param[in] *image pointer to an image
+ * @param[in] len bytes streamed before stopping
+ * @param[in] crc announced crc
+ * @return    finish status code, 0xFF when the install stopped early
+ * @note      none
+ */
+static uint8_t a_unit_ota_install(const uint8_t *image, uint32_t len, uint32_t crc)
+{
+    uint32_t pos;
+    uint32_t n;
+    
+    if (w25qxx_ota_begin(&gs_ota, UNIT_OTA_SIZE) != 0)
+    {
+        return 0xFE;
+    }
+    for (pos = 0; pos < len; pos += n)
+    {
+        n = (len - pos > 3000) ? 3000 : len - pos;
+        if (w25qxx_ota_write(&gs_ota, &image[pos], n) != 0)
+        {
+            return 0xFE;
+        }
+    }
+    if (len != UNIT_OTA_SIZE)
+    {
+        return 0xFF;
+    }
+    
+    return w25qxx_ota_finish(&gs_ota, crc);
+}
+
+/**
+ * @brief  ota case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   an install interrupted by a reboot leaves the active image in place and is
+ *         resumed by installing again, a wrong crc never flips the selector and an
+ *         installed slot can be selected back
+ */
+uint8_t unit_ota(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_ota_slot_t active;
+    w25qxx_ota_image_t info;
+    uint32_t crc_a;
+    uint32_t crc_b;
+    uint32_t addr;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    unit_pattern(gs_image[0], UNIT_OTA_SIZE, 1);
+    unit_pattern(gs_image[1], UNIT_OTA_SIZE, 2);
+    crc_a = ~w25qxx_util_crc32(0xFFFFFFFFU, gs_image[0], UNIT_OTA_SIZE);
+    crc_b = ~w25qxx_util_crc32(0xFFFFFFFFU, gs_image[1], UNIT_OTA_SIZE);
+    UNIT_CHECK(a_unit_ota_remount(handle) == 0);
+    UNIT_CHECK(w25qxx_ota_get_active(&gs_ota, &active, &addr, &info) == 5);
+    
+    /* the first image goes to slot a */
+    UNIT_CHECK(a_unit_ota_install(gs_image[0], UNIT_OTA_SIZE, crc_a) == 0);
+    UNIT_CHECK(a_unit_ota_expect(handle, W25QXX_OTA_SLOT_A, gs_image[0]) == 0);
+    
+    /* a reboot half way through the second image keeps slot a active */
+    UNIT_CHECK(a_unit_ota_install(gs_image[1], UNIT_OTA_SIZE / 2, crc_b) == 0xFF);
+    UNIT_CHECK(a_unit_ota_remount(handle) == 0);
+    UNIT_CHECK(a_unit_ota_expect(handle, W25QXX_OTA_SLOT_A, gs_image[0]) == 0);
+    
+    /* installing again after the reboot completes into slot b */
+    UNIT_CHECK(a_unit_ota_install(gs_image[1], UNIT_OTA_SIZE, crc_b) == 0);
+    UNIT_CHECK(a_unit_ota_expect(handle, W25QXX_OTA_SLOT_B, gs_image[1]) == 0);
+    UNIT_CHECK(a_unit_ota_remount(handle) == 0);
+    UNIT_CHECK(a_unit_ota_expect(handle, W25QXX_OTA_SLOT_B, gs_image[1]) == 0);
+    
+    /* a wrong crc keeps slot b, the overwritten slot a has no image until it is installed again */
+    UNIT_CHECK(a_unit_ota_install(gs_image[0], UNIT_OTA_SIZE, crc_a ^ 1) == 7);
+    UNIT_CHECK(a_unit_ota_expect(handle, W25QXX_OTA_SLOT_B, gs_image[1]) == 0);
+    UNIT_CHECK(w25qxx_ota_select(&gs_ota, W25QXX_OTA_SLOT_A) == 5);
+    UNIT_CHECK(a_unit_ota_install(gs_image[0], UNIT_OTA_SIZE, crc_a) == 0);
+    UNIT_CHECK(w25qxx_ota_select(&gs_ota, W25QXX_OTA_SLOT_B) == 0);
+    UNIT_CHECK(a_unit_ota_remount(handle) == 0);
+    UNIT_CHECK(a_unit_ota_expect(handle, W25QXX_OTA_SLOT_B, gs_image[1]) == 0);
+    
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_parallel.c
+ * @brief     w25qxx erase parallel unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+
+static uint32_t gs_lock[2];          /**< exclusive locks taken by every chip */
+static int32_t gs_held[2];           /**< exclusive locks held by every chip */
+static uint32_t gs_delay[2];         /**< delays of every chip */
+
+/**
+ * @brief     chip 0 lock
+ * @param[in] type lock type
+ * @note      none
+ */
+static void a_unit_parallel_lock_0(w25qxx_lock_t type)
+{
+    if (type == W25QXX_LOCK_EXCLUSIVE)
+    {
+        gs_lock[0]++;
+        gs_held[0]++;
+    }
+}
+
+/**
+ * @brief     chip 0 unlock
+ * @param[in] type lock type
+ * @note      none
+ */
+static void a_unit_parallel_unlock_0(w25qxx_lock_t type)
+{
+    if (type == W25QXX_LOCK_EXCLUSIVE)
+    {
+        gs_held[0]--;
+    }
+}
+
+/**
+ * @brief     chip 1 lock
+ * @param[in] type lock type
+ * @note      none
+ */
+static void a_unit_parallel_lock_1(w25qxx_lock_t type)
+{
+    if (type == W25QXX_LOCK_EXCLUSIVE)
+    {
+        gs_lock[1]++;
+        gs_held[1]++;
+    }
+}
+
+/**
+ * @brief     chip 1 unlock
+ * @param[in] type lock type
+ * @note      none
+ */
+static void a_unit_parallel_unlock_1(w25qxx_lock_t type)
+{
+    if (type == W25QXX_LOCK_EXCLUSIVE)
+    {
+        gs_held[1]--;
+    }
+}
+
+/**
+ * @brief     chip 0 delay
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_unit_parallel_delay_ms_0(uint32_t ms)
+{
+    gs_delay[0]++;
+    emulator_delay_ms(ms);
+}
+
+/**
+ * @brief     chip 1 delay
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_unit_parallel_delay_ms_1(uint32_t ms)
+{
+    gs_delay[1]++;
+    emulator_delay_ms(ms);
+}
+
+/**
+ * @brief  erase parallel case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   every chip is locked once from its erase start until it is done, and
+ *         a chip failing to start leaves the wait to the delay of a running chip
+ */
+uint8_t unit_parallel(void)
+{
+    w25qxx_handle_t *handle[2];
+    w25qxx_bool_t busy;
+    uint32_t addr[2] = {0x001000, 0x002000};
+    uint8_t result[2];
+    uint8_t buf[16];
+    uint8_t i;
+    
+    handle[0] = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    handle[1] = unit_open(1, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK((handle[0] != NULL) && (handle[1] != NULL));
+    DRIVER_W25QXX_LINK_LOCK(handle[0], a_unit_parallel_lock_0);
+    DRIVER_W25QXX_LINK_UNLOCK(handle[0], a_unit_parallel_unlock_0);
+    DRIVER_W25QXX_LINK_LOCK(handle[1], a_unit_parallel_lock_1);
+    DRIVER_W25QXX_LINK_UNLOCK(handle[1], a_unit_parallel_unlock_1);
+    DRIVER_W25QXX_LINK_DELAY_MS(handle[0], a_unit_parallel_delay_ms_0);
+    DRIVER_W25QXX_LINK_DELAY_MS(handle[1], a_unit_parallel_delay_ms_1);
+    
+    /* both chips erase under one lock each */
+    unit_pattern(buf, 16, 1);
+    for (i = 0; i < 2; i++)
+    {
+        UNIT_CHECK(w25qxx_write(handle[i], addr[i], buf, 16) == 0);
+    }
+    gs_lock[0] = 0;
+    gs_lock[1] = 0;
+    UNIT_CHECK(w25qxx_erase_parallel(handle, 2, W25QXX_ERASE_TYPE_SECTOR_4K, addr, result) == 0);
+    for (i = 0; i < 2; i++)
+    {
+        UNIT_CHECK(result[i] == 0);
+        UNIT_CHECK(gs_lock[i] == 1);
+        UNIT_CHECK(gs_held[i] == 0);
+        UNIT_CHECK(w25qxx_read(handle[i], addr[i], buf, 16) == 0);
+        UNIT_CHECK((buf[0] == 0xFF) && (buf[15] == 0xFF));
+    }
+    
+    /* chip 0 fails to start, chip 1 is waited with its own delay */
+    gs_delay[0] = 0;
+    gs_delay[1] = 0;
+    unit_fail(0, 0x20, 0);
+    UNIT_CHECK(w25qxx_erase_parallel(handle, 2, W25QXX_ERASE_TYPE_SECTOR_4K, addr, result) == 1);
+    UNIT_CHECK(result[0] == 1);
+    UNIT_CHECK(result[1] == 0);
+    UNIT_CHECK(gs_delay[0] == 0);
+    UNIT_CHECK(gs_delay[1] != 0);
+    UNIT_CHECK((gs_held[0] == 0) && (gs_held[1] == 0));
+    UNIT_CHECK(w25qxx_get_busy(handle[1], &busy, NULL) == 0);
+    UNIT_CHECK(busy == W25QXX_BOOL_FALSE);
+    
+    return 0;
+}
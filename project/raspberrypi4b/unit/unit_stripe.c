@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_stripe.c
+ * @brief     w25qxx stripe unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_stripe.h"
+
+static w25qxx_stripe_t gs_stripe;          /**< striped volume */
+static uint8_t gs_work[2 * 4096];          /**< stripe work buffer */
+static uint8_t gs_buf[0x4000];             /**< data buffer */
+static uint8_t gs_check[0x4000];           /**< check buffer */
+
+/**
+ * @brief     check that no chip is busy
+ * @param[in] **handle pointer to the chip handles
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_unit_stripe_idle(w25qxx_handle_t **handle)
+{
+    w25qxx_bool_t busy;
+    uint8_t i;
+    
+    for (i = 0; i < 2; i++)
+    {
+        UNIT_CHECK(w25qxx_get_busy(handle[i], &busy, NULL) == 0);
+        UNIT_CHECK(busy == W25QXX_BOOL_FALSE);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  stripe case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   data round-trips across two chips, and when one chip fails to start an
+ *         erase or a program the other chip is idle again before the error returns
+ */
+uint8_t unit_stripe(void)
+{
+    w25qxx_handle_t *handle[2];
+    
+    handle[0] = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    handle[1] = unit_open(1, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK((handle[0] != NULL) && (handle[1] != NULL));
+    UNIT_CHECK(w25qxx_stripe_init(&gs_stripe, handle, 2, 4096, 0x100000, gs_work) == 0);
+    
+    /* four units alternate between the chips */
+    unit_pattern(gs_buf, 0x4000, 1);
+    UNIT_CHECK(w25qxx_stripe_write(&gs_stripe, 0x000000, gs_buf, 0x4000) == 0);
+    UNIT_CHECK(w25qxx_stripe_read(&gs_stripe, 0x000000, gs_check, 0x4000) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 0x4000) == 0);
+    UNIT_CHECK(w25qxx_read(handle[1], 0x000000, gs_check, 0x1000) == 0);
+    UNIT_CHECK(memcmp(&gs_buf[0x1000], gs_check, 0x1000) == 0);
+    
+    /* chip 1 fails to start its sector erase while chip 0 erases */
+    unit_fail(1, 0x20, 0);
+    UNIT_CHECK(w25qxx_stripe_erase(&gs_stripe, 0x000000, 0x2000) == 1);
+    UNIT_CHECK(a_unit_stripe_idle(handle) == 0);
+    
+    /* chip 1 fails to start its first page program while chip 0 programs */
+    UNIT_CHECK(w25qxx_stripe_erase(&gs_stripe, 0x000000, 0x4000) == 0);
+    unit_fail(1, 0x02, 0);
+    UNIT_CHECK(w25qxx_stripe_program(&gs_stripe, 0x000000, gs_buf, 0x2000) == 1);
+    UNIT_CHECK(a_unit_stripe_idle(handle) == 0);
+    
+    /* an overwrite fails on chip 1 after chip 0 started its erase */
+    UNIT_CHECK(w25qxx_stripe_write(&gs_stripe, 0x000000, gs_buf, 0x4000) == 0);
+    unit_pattern(gs_buf, 0x4000, 2);
+    unit_fail(1, 0x20, 0);
+    UNIT_CHECK(w25qxx_stripe_write(&gs_stripe, 0x000000, gs_buf, 0x2000) == 1);
+    UNIT_CHECK(a_unit_stripe_idle(handle) == 0);
+    
+    /* the volume still works afterwards */
+    UNIT_CHECK(w25qxx_stripe_write(&gs_stripe, 0x000000, gs_buf, 0x4000) == 0);
+    UNIT_CHECK(w25qxx_stripe_read(&gs_stripe, 0x000000, gs_check, 0x4000) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 0x4000) == 0);
+    
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_ts.c
+ * @brief     w25qxx ts unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_ts.h"
+
+/**
+ * @brief unit ts definition
+ */
+#define UNIT_TS_INDEX_ADDR        0x100000                  /**< index region address */
+#define UNIT_TS_DATA_ADDR         0x200000                  /**< data region address */
+#define UNIT_TS_DATA_LEN          (16 * 4096)               /**< data region length */
+#define UNIT_TS_SAMPLE            12                        /**< sample size */
+
+static w25qxx_ts_t gs_ts;                  /**< time series */
+static uint32_t gs_count;                  /**< samples seen by the callback */
+static uint32_t gs_bad;                    /**< samples with wrong data seen by the callback */
+
+/**
+ * @brief     fill a sample
+ * @param[in] timestamp sample timestamp
+ * @param[in] *data pointer to a sample buffer
+ * @note      none
+ */
+static void a_unit_ts_sample(uint32_t timestamp, uint8_t *data)
+{
+    unit_pattern(data, UNIT_TS_SAMPLE, timestamp);
+}
+
+/**
+ * @brief     query callback
+ * @param[in] timestamp sample timestamp
+ * @param[in] *data pointer to a sample buffer
+ * @param[in] len sample length
+ * @param[in] *arg pointer to a callback argument
+ * @note      none
+ */
+static void a_unit_ts_callback(uint32_t timestamp, uint8_t *data, uint16_t len, void *arg)
+{
+    uint8_t check[UNIT_TS_SAMPLE];
+    
+    (void)arg;
+    a_unit_ts_sample(timestamp, check);
+    if ((len != UNIT_TS_SAMPLE) || (memcmp(data, check, UNIT_TS_SAMPLE) != 0))
+    {
+        gs_bad++;
+    }
+    gs_count++;
+}
+
+/**
+ * @brief  ts case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a sample whose page program fails closes the head sector, the next
+ *         append rolls over to a new sector and the flushed samples stay readable
+ */
+uint8_t unit_ts(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_ts_info_t info;
+    uint8_t data[UNIT_TS_SAMPLE];
+    uint32_t count;
+    uint32_t seq;
+    uint32_t t;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(w25qxx_ts_init(&gs_ts, handle, UNIT_TS_INDEX_ADDR, W25QXX_TS_INDEX_LEN(UNIT_TS_DATA_LEN),
+                              UNIT_TS_DATA_ADDR, UNIT_TS_DATA_LEN, UNIT_TS_SAMPLE) == 0);
+    UNIT_CHECK(w25qxx_ts_format(&gs_ts) == 0);
+    
+    /* fill the first page up to the last sample and flush it */
+    for (t = 1; t <= 11; t++)
+    {
+        a_unit_ts_sample(t, data);
+        UNIT_CHECK(w25qxx_ts_append(&gs_ts, t, data) == 0);
+    }
+    UNIT_CHECK(w25qxx_ts_flush(&gs_ts) == 0);
+    UNIT_CHECK(w25qxx_ts_get_info(&gs_ts, &info) == 0);
+    seq = info.head_seq;
+    
+    /* the sample completing the page fails to program */
+    unit_fail(0, 0x02, 0);
+    a_unit_ts_sample(12, data);
+    UNIT_CHECK(w25qxx_ts_append(&gs_ts, 12, data) == 1);
+    
+    /* the next appends roll over to a new sector */
+    for (t = 13; t <= 40; t++)
+    {
+        a_unit_ts_sample(t, data);
+        UNIT_CHECK(w25qxx_ts_append(&gs_ts, t, data) == 0);
+    }
+    UNIT_CHECK(w25qxx_ts_flush(&gs_ts) == 0);
+    UNIT_CHECK(w25qxx_ts_get_info(&gs_ts, &info) == 0);
+    UNIT_CHECK(info.head_seq == seq + 1);
+    UNIT_CHECK(info.first_timestamp == 13);
+    
+    /* every sample but the failed one is found, before and after a remount */
+    gs_count = 0;
+    gs_bad = 0;
+    UNIT_CHECK(w25qxx_ts_query(&gs_ts, 0, 100, a_unit_ts_callback, NULL, &count) == 0);
+    UNIT_CHECK((count == 39) && (gs_count == 39) && (gs_bad == 0));
+    UNIT_CHECK(w25qxx_ts_init(&gs_ts, handle, UNIT_TS_INDEX_ADDR, W25QXX_TS_INDEX_LEN(UNIT_TS_DATA_LEN),
+                              UNIT_TS_DATA_ADDR, UNIT_TS_DATA_LEN, UNIT_TS_SAMPLE) == 0);
+    UNIT_CHECK(w25qxx_ts_mount(&gs_ts) == 0);
+    UNIT_CHECK(w25qxx_ts_get_info(&gs_ts, &info) == 0);
+    UNIT_CHECK(info.head_seq == seq + 1);
+    gs_count = 0;
+    gs_bad = 0;
+    UNIT_CHECK(w25qxx_ts_query(&gs_ts, 0, 100, a_unit_ts_callback, NULL, &count) == 0);
+    UNIT_CHECK((count == 39) && (gs_count == 39) && (gs_bad == 0));
+    a_unit_ts_sample(41, data);
+    UNIT_CHECK(w25qxx_ts_append(&gs_ts, 41, data) == 0);
+    
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_wa.c
+ * @brief     w25qxx write amplification unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+
+static uint8_t gs_buf[8192];          /**< data buffer */
+static uint8_t gs_check[8192];        /**< check buffer */
+
+/**
+ * @brief  write amplification case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   a blank write programs only the user bytes, an overwrite erases and
+ *         programs the whole sector and a write across two blank sectors takes
+ *         the blank path twice
+ */
+uint8_t unit_wa(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_write_amplification_t wa;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    
+    /* blank write of 100 bytes */
+    unit_pattern(gs_buf, 100, 1);
+    UNIT_CHECK(w25qxx_write(handle, 0x000000, gs_buf, 100) == 0);
+    UNIT_CHECK(w25qxx_get_write_amplification(handle, &wa) == 0);
+    UNIT_CHECK(wa.user_bytes == 100);
+    UNIT_CHECK(wa.read_bytes == 4096);
+    UNIT_CHECK(wa.erase_bytes == 0);
+    UNIT_CHECK(wa.program_bytes == 100);
+    UNIT_CHECK(wa.blank_program_count == 1);
+    UNIT_CHECK(wa.rmw_erase_count == 0);
+    UNIT_CHECK(wa.page_program_count == 1);
+    UNIT_CHECK(wa.program_ratio == 1.0f);
+    UNIT_CHECK(wa.read_ratio == 40.96f);
+    
+    /* overwrite 100 bytes at 50, the whole sector is erased and programmed */
+    unit_pattern(gs_buf, 100, 2);
+    UNIT_CHECK(w25qxx_write(handle, 0x000032, gs_buf, 100) == 0);
+    UNIT_CHECK(w25qxx_get_write_amplification(handle, &wa) == 0);
+    UNIT_CHECK(wa.user_bytes == 200);
+    UNIT_CHECK(wa.read_bytes == 8192);
+    UNIT_CHECK(wa.erase_bytes == 4096);
+    UNIT_CHECK(wa.program_bytes == 100 + 4096);
+    UNIT_CHECK(wa.blank_program_count == 1);
+    UNIT_CHECK(wa.rmw_erase_count == 1);
+    UNIT_CHECK(wa.page_program_count == 1 + 16);
+    UNIT_CHECK(wa.erase_ratio == 4096.0f / 200.0f);
+    
+    /* the overwrite kept the first 50 bytes of the blank write */
+    unit_pattern(gs_check, 100, 1);
+    unit_pattern(&gs_check[50], 100, 2);
+    UNIT_CHECK(w25qxx_read(handle, 0x000000, gs_buf, 150) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 150) == 0);
+    
+    /* a cleared meter restarts, then 4096 bytes across two blank sectors take 16 page programs */
+    UNIT_CHECK(w25qxx_clear_write_amplification(handle) == 0);
+    unit_pattern(gs_buf, 4096, 3);
+    UNIT_CHECK(w25qxx_write(handle, 0x001800, gs_buf, 4096) == 0);
+    UNIT_CHECK(w25qxx_get_write_amplification(handle, &wa) == 0);
+    UNIT_CHECK(wa.user_bytes == 4096);
+    UNIT_CHECK(wa.read_bytes == 8192);
+    UNIT_CHECK(wa.erase_bytes == 0);
+    UNIT_CHECK(wa.program_bytes == 4096);
+    UNIT_CHECK(wa.blank_program_count == 2);
+    UNIT_CHECK(wa.rmw_erase_count == 0);
+    UNIT_CHECK(wa.page_program_count == 16);
+    UNIT_CHECK(w25qxx_read(handle, 0x001800, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_wb.c
+ * @brief     w25qxx wb unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_wb.h"
+
+/**
+ * @brief unit wb definition
+ */
+#define UNIT_WB_ADDR          0x010000        /**< first sector address */
+#define UNIT_WB_LINE          2               /**< line count */
+#define UNIT_WB_TIMEOUT       100             /**< flush timeout in ms */
+
+static w25qxx_wb_t gs_wb;                            /**< write back buffer */
+static w25qxx_wb_line_t gs_line[UNIT_WB_LINE];       /**< buffer lines */
+static uint8_t gs_buf[4096];                         /**< data buffer */
+static uint8_t gs_check[4096];                       /**< check buffer */
+static uint8_t gs_old[4096];                         /**< old sector data */
+
+/**
+ * @brief  wb case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   small writes into one sector cost one erase and one program per page at
+ *         the flush, reads see the buffered data, eviction and timeout flush the lines
+ */
+uint8_t unit_wb(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_wb_stats_t stats;
+    emulator_stats_t es;
+    uint32_t i;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    unit_pattern(gs_old, 4096, 1);
+    UNIT_CHECK(w25qxx_write(handle, UNIT_WB_ADDR, gs_old, 4096) == 0);
+    UNIT_CHECK(w25qxx_wb_init(&gs_wb, handle, gs_line, UNIT_WB_LINE, UNIT_WB_TIMEOUT) == 0);
+    
+    /* 128 writes of 32 bytes stay in ram until the flush */
+    unit_pattern(gs_buf, 4096, 2);
+    emulator_clear_stats();
+    for (i = 0; i < 4096; i += 32)
+    {
+        UNIT_CHECK(w25qxx_wb_write(&gs_wb, UNIT_WB_ADDR + i, &gs_buf[i], 32) == 0);
+    }
+    emulator_get_stats(&es);
+    UNIT_CHECK((es.erase == 0) && (es.page_program == 0));
+    UNIT_CHECK(w25qxx_wb_read(&gs_wb, UNIT_WB_ADDR, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    UNIT_CHECK(w25qxx_read(handle, UNIT_WB_ADDR, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_old, gs_check, 4096) == 0);
+    
+    /* the flush erases once and programs every page once */
+    UNIT_CHECK(w25qxx_wb_flush(&gs_wb) == 0);
+    emulator_get_stats(&es);
+    UNIT_CHECK((es.erase == 1) && (es.page_program == 16));
+    UNIT_CHECK(w25qxx_read(handle, UNIT_WB_ADDR, gs_check, 4096) == 0);
+    UNIT_CHECK(memcmp(gs_buf, gs_check, 4096) == 0);
+    UNIT_CHECK(w25qxx_wb_get_stats(&gs_wb, &stats) == 0);
+    UNIT_CHECK(stats.write_bytes == 4096);
+    UNIT_CHECK(stats.write_hit == 127);
+    UNIT_CHECK((stats.erase == 1) && (stats.page_program == 16));
+    
+    /* a third sector evicts the least recently used one to the flash */
+    unit_pattern(gs_buf, 96, 3);
+    UNIT_CHECK(w25qxx_wb_poll(&gs_wb, 0) == 0);
+    UNIT_CHECK(w25qxx_wb_write(&gs_wb, UNIT_WB_ADDR + 0x1000, &gs_buf[0], 32) == 0);
+    UNIT_CHECK(w25qxx_wb_write(&gs_wb, UNIT_WB_ADDR + 0x2000, &gs_buf[32], 32) == 0);
+    UNIT_CHECK(w25qxx_wb_write(&gs_wb, UNIT_WB_ADDR + 0x3000, &gs_buf[64], 32) == 0);
+    UNIT_CHECK(w25qxx_wb_get_stats(&gs_wb, &stats) == 0);
+    UNIT_CHECK(stats.evict == 1);
+    UNIT_CHECK(w25qxx_read(handle, UNIT_WB_ADDR + 0x1000, gs_check, 32) == 0);
+    UNIT_CHECK(memcmp(&gs_buf[0], gs_check, 32) == 0);
+    UNIT_CHECK(w25qxx_read(handle, UNIT_WB_ADDR + 0x3000, gs_check, 32) == 0);
+    UNIT_CHECK(gs_check[0] == 0xFF);
+    
+    /* the dirty lines are flushed once the timeout has passed */
+    UNIT_CHECK(w25qxx_wb_poll(&gs_wb, UNIT_WB_TIMEOUT / 2) == 0);
+    UNIT_CHECK(w25qxx_wb_get_stats(&gs_wb, &stats) == 0);
+    UNIT_CHECK(stats.timeout == 0);
+    UNIT_CHECK(w25qxx_wb_poll(&gs_wb, UNIT_WB_TIMEOUT * 2) == 0);
+    UNIT_CHECK(w25qxx_wb_get_stats(&gs_wb, &stats) == 0);
+    UNIT_CHECK(stats.timeout == 2);
+    UNIT_CHECK(w25qxx_read(handle, UNIT_WB_ADDR + 0x2000, gs_check, 32) == 0);
+    UNIT_CHECK(memcmp(&gs_buf[32], gs_check, 32) == 0);
+    UNIT_CHECK(w25qxx_read(handle, UNIT_WB_ADDR + 0x3000, gs_check, 32) == 0);
+    UNIT_CHECK(memcmp(&gs_buf[64], gs_check, 32) == 0);
+    UNIT_CHECK(w25qxx_wb_deinit(&gs_wb) == 0);
+    
+    return 0;
+}
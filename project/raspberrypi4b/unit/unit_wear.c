@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      unit_wear.c
+ * @brief     w25qxx wear unit test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "unit.h"
+#include "driver_w25qxx_wear.h"
+
+/**
+ * @brief unit wear definition
+ */
+#define UNIT_WEAR_SIZE           0x100000        /**< tracked size */
+#define UNIT_WEAR_REGION         0x0F0000        /**< reserved region address, inside the tracked size */
+#define UNIT_WEAR_REGION_LEN     0x2000          /**< reserved region length */
+
+static uint8_t gs_table[W25QXX_WEAR_TABLE_SIZE(UNIT_WEAR_SIZE)];        /**< wear table */
+static uint8_t gs_table2[W25QXX_WEAR_TABLE_SIZE(UNIT_WEAR_SIZE)];       /**< reloaded wear table */
+static uint8_t gs_buf[16];                                              /**< data buffer */
+
+/**
+ * @brief  wear case
+ * @return status code
+ *         - 0 success
+ *         - 1 failed
+ * @note   every erase type is counted on the sectors it covers, the rmw path of
+ *         w25qxx_write counts too and a persisted table loads back unchanged
+ */
+uint8_t unit_wear(void)
+{
+    w25qxx_handle_t *handle;
+    w25qxx_wear_t wear;
+    w25qxx_wear_t wear2;
+    w25qxx_wear_count_t count;
+    uint32_t addr;
+    uint32_t total;
+    
+    handle = unit_open(0, W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE);
+    UNIT_CHECK(handle != NULL);
+    UNIT_CHECK(w25qxx_wear_init(&wear, handle, UNIT_WEAR_SIZE, gs_table, sizeof(gs_table)) == 0);
+    
+    /* three sector erases, one 32k and one 64k block erase over sector 0x1000 */
+    UNIT_CHECK(w25qxx_sector_erase_4k(handle, 0x001000) == 0);
+    UNIT_CHECK(w25qxx_sector_erase_4k(handle, 0x001000) == 0);
+    UNIT_CHECK(w25qxx_sector_erase_4k(handle, 0x001000) == 0);
+    UNIT_CHECK(w25qxx_block_erase_32k(handle, 0x000000) == 0);
+    UNIT_CHECK(w25qxx_block_erase_64k(handle, 0x000000) == 0);
+    UNIT_CHECK(w25qxx_wear_get_count(&wear, 0x001000, &count) == 0);
+    UNIT_CHECK(count.sector_4k == 3);
+    UNIT_CHECK(count.block_32k == 1);
+    UNIT_CHECK(count.block_64k == 1);
+    UNIT_CHECK(count.chip == 0);
+    UNIT_CHECK(count.total == 5);
+    
+    /* sector 0x9000 is in the second 32k block, only the 64k erase covered it */
+    UNIT_CHECK(w25qxx_wear_get_count(&wear, 0x009000, &count) == 0);
+    UNIT_CHECK(count.sector_4k == 0);
+    UNIT_CHECK(count.block_32k == 0);
+    UNIT_CHECK(count.block_64k == 1);
+    UNIT_CHECK(count.total == 1);
+    
+    /* an overwrite through w25qxx_write erases its sector once */
+    memset(gs_buf, 0x00, sizeof(gs_buf));
+    UNIT_CHECK(w25qxx_write(handle, 0x020000, gs_buf, sizeof(gs_buf)) == 0);
+    UNIT_CHECK(w25qxx_wear_get_count(&wear, 0x020000, &count) == 0);
+    UNIT_CHECK(count.sector_4k == 0);
+    UNIT_CHECK(w25qxx_write(handle, 0x020000, gs_buf, sizeof(gs_buf)) == 0);
+    UNIT_CHECK(w25qxx_wear_get_count(&wear, 0x020000, &count) == 0);
+    UNIT_CHECK(count.sector_4k == 1);
+    
+    /* the hot sector is the one erased the most */
+    UNIT_CHECK(w25qxx_wear_get_hot_sector(&wear, &addr, &total) == 0);
+    UNIT_CHECK(addr == 0x001000);
+    UNIT_CHECK(total == 5);
+    
+    /* erases outside the tracked size are not counted */
+    UNIT_CHECK(w25qxx_wear_get_count(&wear, UNIT_WEAR_SIZE, &count) == 4);
+    
+    /* persist the table and load it into a second table */
+    UNIT_CHECK(w25qxx_wear_set_region(&wear, UNIT_WEAR_REGION, UNIT_WEAR_REGION_LEN, 1) == 0);
+    UNIT_CHECK(w25qxx_wear_sync(&wear, W25QXX_BOOL_TRUE) == 0);
+    UNIT_CHECK(w25qxx_wear_deinit(&wear) == 0);
+    UNIT_CHECK(w25qxx_wear_init(&wear2, handle, UNIT_WEAR_SIZE, gs_table2, sizeof(gs_table2)) == 0);
+    UNIT_CHECK(w25qxx_wear_set_region(&wear2, UNIT_WEAR_REGION, UNIT_WEAR_REGION_LEN, 1) == 0);
+    UNIT_CHECK(w25qxx_wear_load(&wear2) == 0);
+    UNIT_CHECK(memcmp(gs_table, gs_table2, sizeof(gs_table)) == 0);
+    UNIT_CHECK(w25qxx_wear_get_count(&wear2, 0x001000, &count) == 0);
+    UNIT_CHECK(count.total == 5);
+    UNIT_CHECK(w25qxx_wear_deinit(&wear2) == 0);
+    
+    return 0;
+}
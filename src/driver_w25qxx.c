@@ -163,6 +163,75 @@ static uint8_t a_w25qxx_qspi_write_read(w25qxx_handle_t *handle, uint8_t instruc
     }
 }
 
+/**
+ * @brief     take the handle lock
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] type lock type
+ * @note      nothing is done when no lock is linked
+ */
+static void a_w25qxx_lock(w25qxx_handle_t *handle, w25qxx_lock_t type)
+{
+    if (handle->lock != NULL)        /* check lock */
+    {
+        handle->lock(type);          /* lock */
+    }
+}
+
+/**
+ * @brief     release the handle lock
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] type lock type
+ * @note      nothing is done when no lock is linked
+ */
+static void a_w25qxx_unlock(w25qxx_handle_t *handle, w25qxx_lock_t type)
+{
+    if (handle->unlock != NULL)      /* check unlock */
+    {
+        handle->unlock(type);        /* unlock */
+    }
+}
+
+/**
+ * @brief     get the lock type of an addressed read
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    lock type
+ * @note      chips above 128Mb in the 3 bytes address mode set the extended address
+ *            register before every read, so those reads can't share the chip
+ */
+static w25qxx_lock_t a_w25qxx_read_lock_type(w25qxx_handle_t *handle)
+{
+    if ((handle->address_mode == W25QXX_ADDRESS_MODE_3_BYTE) && (handle->type >= W25Q256))        /* extended address */
+    {
+        return W25QXX_LOCK_EXCLUSIVE;                                                              /* exclusive */
+    }
+    
+    return W25QXX_LOCK_SHARED;                                                                     /* shared */
+}
+
+/**
+ * @brief     take the handle lock of an addressed read
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    lock type taken
+ * @note      the address mode is checked again under the shared lock, a mode changed
+ *            before the lock was taken upgrades it to the exclusive lock
+ */
+static w25qxx_lock_t a_w25qxx_read_lock(w25qxx_handle_t *handle)
+{
+    w25qxx_lock_t type;
+    
+    type = a_w25qxx_read_lock_type(handle);                                    /* get the lock type */
+    a_w25qxx_lock(handle, type);                                               /* lock */
+    if ((type == W25QXX_LOCK_SHARED) &&
+        (a_w25qxx_read_lock_type(handle) == W25QXX_LOCK_EXCLUSIVE))            /* changed before the lock */
+    {
+        a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);                           /* unlock */
+        type = W25QXX_LOCK_EXCLUSIVE;                                          /* exclusive */
+        a_w25qxx_lock(handle, type);                                           /* lock */
+    }
+    
+    return type;                                                               /* return the lock type */
+}
+
 /**
  * @brief     enable or disable the dual quad spi
  * @param[in] *handle pointer to a w25qxx handle structure
@@ -178,7 +247,7 @@ uint8_t w25qxx_set_dual_quad_spi(w25qxx_handle_t *handle, w25qxx_bool_t enable)
     {
         return 2;                                          /* return error */
     }
-
+    
     handle->dual_quad_spi_enable = (uint8_t)enable;        /* set enable */
     
     return 0;                                              /* success return 0 */
@@ -199,7 +268,7 @@ uint8_t w25qxx_get_dual_quad_spi(w25qxx_handle_t *handle, w25qxx_bool_t *enable)
     {
         return 2;                                                   /* return error */
     }
-
+    
     *enable = (w25qxx_bool_t)(handle->dual_quad_spi_enable);        /* get enable */
     
     return 0;                                                       /* success return 0 */
@@ -220,7 +289,7 @@ uint8_t w25qxx_set_type(w25qxx_handle_t *handle, w25qxx_type_t type)
     {
         return 2;                        /* return error */
     }
-
+    
     handle->type = (uint16_t)type;       /* set type */
     
     return 0;                            /* success return 0 */
@@ -241,7 +310,7 @@ uint8_t w25qxx_get_type(w25qxx_handle_t *handle, w25qxx_type_t *type)
     {
         return 2;                                 /* return error */
     }
-
+    
     *type = (w25qxx_type_t)(handle->type);        /* get type */
     
     return 0;                                     /* success return 0 */
@@ -262,7 +331,7 @@ uint8_t w25qxx_set_interface(w25qxx_handle_t *handle, w25qxx_interface_t interfa
     {
         return 2;                                 /* return error */
     }
-
+    
     handle->spi_qspi = (uint8_t)interface;        /* set interface */
     
     return 0;                                     /* success return 0 */
@@ -283,25 +352,17 @@ uint8_t w25qxx_get_interface(w25qxx_handle_t *handle, w25qxx_interface_t *interf
     {
         return 2;                                               /* return error */
     }
-
+    
     *interface = (w25qxx_interface_t)(handle->spi_qspi);        /* get interface */
     
     return 0;                                                   /* success return 0 */
 }
 
 /**
- * @brief     set the chip address mode
- * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] mode address mode
- * @return    status code
- *             - 0 success
- *             - 1 set address mode failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 current type can't use this function
- * @note      none
+ * @brief set the chip address mode
+ * @note  the caller holds the handle lock
  */
-uint8_t w25qxx_set_address_mode(w25qxx_handle_t *handle, w25qxx_address_mode_t mode)
+static uint8_t a_w25qxx_set_address_mode_unlocked(w25qxx_handle_t *handle, w25qxx_address_mode_t mode)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -392,6 +453,34 @@ uint8_t w25qxx_set_address_mode(w25qxx_handle_t *handle, w25qxx_address_mode_t m
     return 0;                                                                         /* success return 0 */
 }
 
+/**
+ * @brief     set the chip address mode
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] mode address mode
+ * @return    status code
+ *             - 0 success
+ *             - 1 set address mode failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 current type can't use this function
+ * @note      none
+ */
+uint8_t w25qxx_set_address_mode(w25qxx_handle_t *handle, w25qxx_address_mode_t mode)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);           /* lock */
+    res = a_w25qxx_set_address_mode_unlocked(handle, mode); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);         /* unlock */
+    
+    return res;                                             /* return the result */
+}
+
 /**
  * @brief      get the chip address mode
  * @param[in]  *handle pointer to a w25qxx handle structure
@@ -412,23 +501,17 @@ uint8_t w25qxx_get_address_mode(w25qxx_handle_t *handle, w25qxx_address_mode_t *
     {
         return 3;                                                /* return error */
     }
-
+    
     *mode = (w25qxx_address_mode_t)(handle->address_mode);       /* get address mode */
     
     return 0;                                                    /* success return 0 */
 }
 
 /**
- * @brief     enable writing
- * @param[in] *handle pointer to a w25qxx handle structure
- * @return    status code
- *            - 0 success
- *            - 1 enable write failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief enable writing
+ * @note  the caller holds the handle lock
  */
-uint8_t w25qxx_enable_write(w25qxx_handle_t *handle)
+static uint8_t a_w25qxx_enable_write_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -489,16 +572,36 @@ uint8_t w25qxx_enable_write(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     enable volatile sr writing
+ * @brief     enable writing
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 enable volatile sr write failed
+ *            - 1 enable write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t w25qxx_enable_volatile_sr_write(w25qxx_handle_t *handle)
+uint8_t w25qxx_enable_write(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);   /* lock */
+    res = a_w25qxx_enable_write_unlocked(handle);   /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief enable volatile sr writing
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_enable_volatile_sr_write_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -511,7 +614,7 @@ uint8_t w25qxx_enable_volatile_sr_write(w25qxx_handle_t *handle)
     {
         return 3;                                                                            /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                            /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                               /* enable dual quad spi */
@@ -560,16 +663,36 @@ uint8_t w25qxx_enable_volatile_sr_write(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     disable writing
+ * @brief     enable volatile sr writing
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 disable write failed
+ *            - 1 enable volatile sr write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t w25qxx_disable_write(w25qxx_handle_t *handle)
+uint8_t w25qxx_enable_volatile_sr_write(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                       /* check handle */
+    {
+        return 2;                                             /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);             /* lock */
+    res = a_w25qxx_enable_volatile_sr_write_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);           /* unlock */
+    
+    return res;                                               /* return the result */
+}
+
+/**
+ * @brief disable writing
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_disable_write_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -582,7 +705,7 @@ uint8_t w25qxx_disable_write(w25qxx_handle_t *handle)
     {
         return 3;                                                                     /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                     /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                        /* enable dual quad spi */
@@ -630,17 +753,36 @@ uint8_t w25qxx_disable_write(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief      get the status 1
- * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get status 1 failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     disable writing
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 disable write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t w25qxx_get_status1(w25qxx_handle_t *handle, uint8_t *status)
+uint8_t w25qxx_disable_write(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);   /* lock */
+    res = a_w25qxx_disable_write_unlocked(handle);  /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief get the status 1
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_status1_unlocked(w25qxx_handle_t *handle, uint8_t *status)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -653,7 +795,7 @@ uint8_t w25qxx_get_status1(w25qxx_handle_t *handle, uint8_t *status)
     {
         return 3;                                                                  /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                  /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                     /* enable dual quad spi */
@@ -703,17 +845,37 @@ uint8_t w25qxx_get_status1(w25qxx_handle_t *handle, uint8_t *status)
 }
 
 /**
- * @brief      get the status 2
+ * @brief      get the status 1
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get status 2 failed
+ *             - 1 get status 1 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t w25qxx_get_status2(w25qxx_handle_t *handle, uint8_t *status)
+uint8_t w25qxx_get_status1(w25qxx_handle_t *handle, uint8_t *status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);           /* lock */
+    res = a_w25qxx_get_status1_unlocked(handle, status); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);         /* unlock */
+    
+    return res;                                          /* return the result */
+}
+
+/**
+ * @brief get the status 2
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_status2_unlocked(w25qxx_handle_t *handle, uint8_t *status)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -726,7 +888,7 @@ uint8_t w25qxx_get_status2(w25qxx_handle_t *handle, uint8_t *status)
     {
         return 3;                                                                  /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                  /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                     /* enable dual quad spi */
@@ -776,17 +938,37 @@ uint8_t w25qxx_get_status2(w25qxx_handle_t *handle, uint8_t *status)
 }
 
 /**
- * @brief      get the status 3
+ * @brief      get the status 2
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get status 3 failed
+ *             - 1 get status 2 failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t w25qxx_get_status3(w25qxx_handle_t *handle, uint8_t *status)
+uint8_t w25qxx_get_status2(w25qxx_handle_t *handle, uint8_t *status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);           /* lock */
+    res = a_w25qxx_get_status2_unlocked(handle, status); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);         /* unlock */
+    
+    return res;                                          /* return the result */
+}
+
+/**
+ * @brief get the status 3
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_status3_unlocked(w25qxx_handle_t *handle, uint8_t *status)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -799,7 +981,7 @@ uint8_t w25qxx_get_status3(w25qxx_handle_t *handle, uint8_t *status)
     {
         return 3;                                                                  /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                  /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                     /* enable dual quad spi */
@@ -849,18 +1031,37 @@ uint8_t w25qxx_get_status3(w25qxx_handle_t *handle, uint8_t *status)
 }
 
 /**
- * @brief     set the status 1
- * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] status set status
- * @return    status code
- *            - 0 success
- *            - 1 set status 1 failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 write status 1 timeout
- * @note      none
+ * @brief      get the status 3
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status 3 failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t w25qxx_set_status1(w25qxx_handle_t *handle, uint8_t status)
+uint8_t w25qxx_get_status3(w25qxx_handle_t *handle, uint8_t *status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);           /* lock */
+    res = a_w25qxx_get_status3_unlocked(handle, status); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);         /* unlock */
+    
+    return res;                                          /* return the result */
+}
+
+/**
+ * @brief set the status 1
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_set_status1_unlocked(w25qxx_handle_t *handle, uint8_t status)
 {
     uint8_t res;
     uint8_t buf[2];
@@ -875,7 +1076,7 @@ uint8_t w25qxx_set_status1(w25qxx_handle_t *handle, uint8_t status)
     {
         return 3;                                                                                        /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                        /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                                           /* enable dual quad spi */
@@ -1048,18 +1249,38 @@ uint8_t w25qxx_set_status1(w25qxx_handle_t *handle, uint8_t status)
 }
 
 /**
- * @brief     set the status 2
+ * @brief     set the status 1
  * @param[in] *handle pointer to a w25qxx handle structure
  * @param[in] status set status
  * @return    status code
  *            - 0 success
- *            - 1 set status 2 failed
+ *            - 1 set status 1 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 write status 2 timeout
+ *            - 4 write status 1 timeout
  * @note      none
  */
-uint8_t w25qxx_set_status2(w25qxx_handle_t *handle, uint8_t status)
+uint8_t w25qxx_set_status1(w25qxx_handle_t *handle, uint8_t status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);        /* lock */
+    res = a_w25qxx_set_status1_unlocked(handle, status); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);      /* unlock */
+    
+    return res;                                          /* return the result */
+}
+
+/**
+ * @brief set the status 2
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_set_status2_unlocked(w25qxx_handle_t *handle, uint8_t status)
 {
     uint8_t res;
     uint8_t buf[2];
@@ -1074,7 +1295,7 @@ uint8_t w25qxx_set_status2(w25qxx_handle_t *handle, uint8_t status)
     {
         return 3;                                                                                        /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                        /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                                           /* enable dual quad spi */
@@ -1247,18 +1468,38 @@ uint8_t w25qxx_set_status2(w25qxx_handle_t *handle, uint8_t status)
 }
 
 /**
- * @brief     set the status 3
+ * @brief     set the status 2
  * @param[in] *handle pointer to a w25qxx handle structure
  * @param[in] status set status
  * @return    status code
  *            - 0 success
- *            - 1 set status 3 failed
+ *            - 1 set status 2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 write status 3 timeout
+ *            - 4 write status 2 timeout
  * @note      none
  */
-uint8_t w25qxx_set_status3(w25qxx_handle_t *handle, uint8_t status)
+uint8_t w25qxx_set_status2(w25qxx_handle_t *handle, uint8_t status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);        /* lock */
+    res = a_w25qxx_set_status2_unlocked(handle, status); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);      /* unlock */
+    
+    return res;                                          /* return the result */
+}
+
+/**
+ * @brief set the status 3
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_set_status3_unlocked(w25qxx_handle_t *handle, uint8_t status)
 {
     uint8_t res;
     uint8_t buf[2];
@@ -1273,7 +1514,7 @@ uint8_t w25qxx_set_status3(w25qxx_handle_t *handle, uint8_t status)
     {
         return 3;                                                                                        /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                        /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                                           /* enable dual quad spi */
@@ -1446,17 +1687,38 @@ uint8_t w25qxx_set_status3(w25qxx_handle_t *handle, uint8_t status)
 }
 
 /**
- * @brief     erase the chip
+ * @brief     set the status 3
  * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] status set status
  * @return    status code
  *            - 0 success
- *            - 1 chip erase failed
+ *            - 1 set status 3 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 erase timeout
+ *            - 4 write status 3 timeout
  * @note      none
  */
-uint8_t w25qxx_chip_erase(w25qxx_handle_t *handle)
+uint8_t w25qxx_set_status3(w25qxx_handle_t *handle, uint8_t status)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);        /* lock */
+    res = a_w25qxx_set_status3_unlocked(handle, status); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);      /* unlock */
+    
+    return res;                                          /* return the result */
+}
+
+/**
+ * @brief erase the chip
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_chip_erase_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t status;
@@ -1471,7 +1733,7 @@ uint8_t w25qxx_chip_erase(w25qxx_handle_t *handle)
     {
         return 3;                                                                                  /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                  /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                                     /* enable dual quad spi */
@@ -1498,6 +1760,10 @@ uint8_t w25qxx_chip_erase(w25qxx_handle_t *handle)
                
                 return 1;                                                                          /* return error */
             }
+            if (handle->erase_callback != NULL)                                                    /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_CHIP, 0x00000000);   /* run erase callback */
+            }
             timeout = W25QXX_ERASE_CHIP_TIMEOUT_MS;                                                /* set default timeout */
             while (timeout != 0)                                                                   /* check timeout */
             {
@@ -1548,6 +1814,10 @@ uint8_t w25qxx_chip_erase(w25qxx_handle_t *handle)
                
                 return 1;                                                                          /* return error */
             }
+            if (handle->erase_callback != NULL)                                                    /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_CHIP, 0x00000000);   /* run erase callback */
+            }
             timeout = W25QXX_ERASE_CHIP_TIMEOUT_MS;                                                /* set default timeout */
             while (timeout != 0)                                                                   /* check timeout */
             {
@@ -1603,6 +1873,10 @@ uint8_t w25qxx_chip_erase(w25qxx_handle_t *handle)
            
             return 1;                                                                              /* return error */
         }
+        if (handle->erase_callback != NULL)                                                        /* check erase callback */
+        {
+            handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_CHIP, 0x00000000);       /* run erase callback */
+        }
         timeout = W25QXX_ERASE_CHIP_TIMEOUT_MS;                                                    /* set default timeout */
         while (timeout != 0)                                                                       /* check timeout */
         {
@@ -1638,16 +1912,37 @@ uint8_t w25qxx_chip_erase(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     suspend erase or program 
+ * @brief     erase the chip
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 erase program suspend failed
+ *            - 1 chip erase failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 erase timeout
  * @note      none
  */
-uint8_t w25qxx_erase_program_suspend(w25qxx_handle_t *handle)
+uint8_t w25qxx_chip_erase(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);   /* lock */
+    res = a_w25qxx_chip_erase_unlocked(handle);     /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief suspend erase or program 
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_erase_program_suspend_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -1710,16 +2005,36 @@ uint8_t w25qxx_erase_program_suspend(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     resume erase or program 
+ * @brief     suspend erase or program 
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 erase program resume failed
+ *            - 1 erase program suspend failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t w25qxx_erase_program_resume(w25qxx_handle_t *handle)
+uint8_t w25qxx_erase_program_suspend(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);          /* lock */
+    res = a_w25qxx_erase_program_suspend_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);        /* unlock */
+    
+    return res;                                            /* return the result */
+}
+
+/**
+ * @brief resume erase or program 
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_erase_program_resume_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -1780,176 +2095,992 @@ uint8_t w25qxx_erase_program_resume(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     power down
+ * @brief     resume erase or program 
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 power down failed
+ *            - 1 erase program resume failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t w25qxx_power_down(w25qxx_handle_t *handle)
+uint8_t w25qxx_erase_program_resume(w25qxx_handle_t *handle)
 {
     uint8_t res;
-    uint8_t buf[1];
     
-    if (handle == NULL)                                                            /* check handle */
-    {
-        return 2;                                                                  /* return error */
-    }   
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle == NULL)                                   /* check handle */
     {
-        return 3;                                                                  /* return error */
+        return 2;                                         /* return error */
     }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);         /* lock */
+    res = a_w25qxx_erase_program_resume_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);       /* unlock */
+    
+    return res;                                           /* return the result */
+}
 
-    if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                  /* spi interface */
+/**
+ * @brief      send a write enabled command with one spi batch
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[in]  command sent command
+ * @param[in]  addr command address
+ * @param[in]  has_addr bool value, if the command takes an address
+ * @param[in]  *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *status pointer to a status1 buffer, NULL to skip the first poll
+ * @return     status code
+ *             - 0 success
+ *             - 1 batch failed
+ *             - 5 address mode is invalid
+ * @note       single spi with a linked spi_batch hook only, write enable, the extended
+ *             address register write, the command and the first status1 read go out
+ *             in one hook call
+ */
+static uint8_t a_w25qxx_spi_batch_write(w25qxx_handle_t *handle, uint8_t command, uint32_t addr,
+                                        w25qxx_bool_t has_addr, uint8_t *data, uint16_t len, uint8_t *status)
+{
+    w25qxx_spi_transfer_t transfer[5];
+    uint8_t wren[1];
+    uint8_t ext[2];
+    uint8_t rdsr[1];
+    uint8_t addr_len;
+    uint8_t num;
+    uint16_t i;
+    
+    if (has_addr == W25QXX_BOOL_FALSE)                                                          /* no address */
     {
-        if (handle->dual_quad_spi_enable != 0)                                     /* enable dual quad spi */
-        {
-            res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_POWER_DOWN, 1,
-                                           0x00000000, 0x00, 0x00,
-                                           0x00000000, 0x00, 0x00,
-                                           0x00, NULL, 0x00,
-                                           NULL, 0x00, 0x00);                      /* qspi write read */
-            if (res != 0)                                                          /* check result */
-            {
-                handle->debug_print("w25qxx: power down failed.\n");               /* power down failed */
-               
-                return 1;                                                          /* return error */
-            }
-        }
-        else                                                                       /* single spi */
-        {
-            buf[0] = W25QXX_COMMAND_POWER_DOWN;                                    /* power down command */
-            res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf,
-                                          1, NULL, 0);                             /* spi write read */
-            if (res != 0)                                                          /* check result */
-            {
-                handle->debug_print("w25qxx: power down failed.\n");               /* power down failed */
-               
-                return 1;                                                          /* return error */
-            }
-        }
+        addr_len = 0;                                                                           /* no address */
     }
-    else                                                                           /* qspi interface */
+    else if (handle->address_mode == W25QXX_ADDRESS_MODE_3_BYTE)                                /* 3 address mode */
     {
-        res = a_w25qxx_qspi_write_read(handle, 0xFF, 4,
-                                       0x00000000, 0x00, 0x00,
-                                       0x00000000, 0x00, 0x00,
-                                       0, NULL, 0x00,
-                                       NULL, 0x00, 0);                             /* spi write read */
-        if (res != 0)                                                              /* check result */
-        {
-            handle->debug_print("w25qxx: exit qspi mode failed.\n");               /* exit qspi mode failed */
-           
-            return 1;                                                              /* return error */
-        }
-        handle->delay_ms(10);                                                      /* delay 10 ms */
-        res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_POWER_DOWN, 4,
-                                       0x00000000, 0x00, 0x00,
-                                       0x00000000, 0x00, 0x00,
-                                       0x00, NULL, 0x00,
-                                       NULL, 0x00, 0x00);                          /* qspi write read */
-        if (res != 0)                                                              /* check result */
-        {
-            handle->debug_print("w25qxx: power down failed.\n");                   /* power down failed */
-           
-            return 1;                                                              /* return error */
-        }
+        addr_len = 3;                                                                           /* 3 bytes */
+    }
+    else if ((handle->address_mode == W25QXX_ADDRESS_MODE_4_BYTE) && (handle->type >= W25Q256)) /* 4 address mode */
+    {
+        addr_len = 4;                                                                           /* 4 bytes */
+    }
+    else
+    {
+        handle->debug_print("w25qxx: address mode is invalid.\n");                              /* address mode is invalid */
+        
+        return 5;                                                                               /* return error */
     }
     
-    return 0;                                                                      /* success return 0 */
+    memset(transfer, 0, sizeof(transfer));                                                      /* clear transfers */
+    num = 0;                                                                                    /* init 0 */
+    wren[0] = W25QXX_COMMAND_WRITE_ENABLE;                                                      /* write enable command */
+    transfer[num].in_buf = wren;                                                                /* set write enable */
+    transfer[num++].in_len = 1;                                                                 /* 1 byte */
+    if ((addr_len == 3) && (handle->type >= W25Q256))                                           /* >128Mb */
+    {
+        ext[0] = 0xC5;                                                                          /* write extended addr register command */
+        ext[1] = (addr >> 24) & 0xFF;                                                           /* 31 - 24 bits */
+        transfer[num].in_buf = ext;                                                             /* set extended addr */
+        transfer[num++].in_len = 2;                                                             /* 2 bytes */
+        transfer[num].in_buf = wren;                                                            /* set write enable */
+        transfer[num++].in_len = 1;                                                             /* 1 byte */
+    }
+    i = 0;                                                                                      /* init 0 */
+    handle->buf[i++] = command;                                                                 /* set command */
+    if (addr_len == 4)                                                                          /* 4 address mode */
+    {
+        handle->buf[i++] = (addr >> 24) & 0xFF;                                                 /* 31 - 24 bits */
+    }
+    if (addr_len != 0)                                                                          /* check address */
+    {
+        handle->buf[i++] = (addr >> 16) & 0xFF;                                                 /* 23 - 16 bits */
+        handle->buf[i++] = (addr >> 8) & 0xFF;                                                  /* 15 - 8  bits */
+        handle->buf[i++] = (addr >> 0) & 0xFF;                                                  /* 7 - 0 bits */
+    }
+    if (len != 0)                                                                               /* check length */
+    {
+        memcpy(&handle->buf[i], data, len);                                                     /* copy data */
+    }
+    transfer[num].in_buf = (uint8_t *)handle->buf;                                              /* set command */
+    transfer[num++].in_len = i + len;                                                           /* command length */
+    if (status != NULL)                                                                         /* first poll */
+    {
+        rdsr[0] = W25QXX_COMMAND_READ_STATUS_REG1;                                              /* read status1 command */
+        transfer[num].in_buf = rdsr;                                                            /* set read status1 */
+        transfer[num].in_len = 1;                                                               /* 1 byte */
+        transfer[num].out_buf = status;                                                         /* set status */
+        transfer[num++].out_len = 1;                                                            /* 1 byte */
+    }
+    if (handle->spi_batch(transfer, num) != 0)                                                  /* send the batch */
+    {
+        handle->debug_print("w25qxx: spi batch failed.\n");                                     /* spi batch failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     release power down
+ * @brief     issue a write enabled command without waiting for it
  * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] command sent command
+ * @param[in] addr command address
+ * @param[in] has_addr bool value, if the command takes an address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
  * @return    status code
  *            - 0 success
- *            - 1 release power down failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 issue failed
+ *            - 5 address mode is invalid
+ * @note      the caller holds the handle lock and checks the arguments
  */
-uint8_t w25qxx_release_power_down(w25qxx_handle_t *handle)
+static uint8_t a_w25qxx_issue_write_command(w25qxx_handle_t *handle, uint8_t command, uint32_t addr,
+                                            w25qxx_bool_t has_addr, uint8_t *data, uint16_t len)
 {
     uint8_t res;
-    uint8_t id;
-    uint8_t buf[4];
+    uint8_t line;
+    uint8_t addr_len;
+    uint8_t buf[2];
+    uint16_t i;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (has_addr == W25QXX_BOOL_FALSE)                                                          /* no address */
     {
-        return 2;                                                                          /* return error */
-    }   
-    if (handle->inited != 1)                                                               /* check handle initialization */
+        addr_len = 0;                                                                           /* no address */
+    }
+    else if (handle->address_mode == W25QXX_ADDRESS_MODE_3_BYTE)                                /* 3 address mode */
     {
-        return 3;                                                                          /* return error */
+        addr_len = 3;                                                                           /* 3 bytes */
+    }
+    else if ((handle->address_mode == W25QXX_ADDRESS_MODE_4_BYTE) && (handle->type >= W25Q256)) /* 4 address mode */
+    {
+        addr_len = 4;                                                                           /* 4 bytes */
+    }
+    else
+    {
+        handle->debug_print("w25qxx: address mode is invalid.\n");                              /* address mode is invalid */
+        
+        return 5;                                                                               /* return error */
     }
     
-    if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                          /* spi interface */
+    if ((handle->spi_qspi == W25QXX_INTERFACE_SPI) && (handle->dual_quad_spi_enable == 0) &&
+        (handle->spi_batch != NULL))                                                            /* single spi batch */
     {
-        if (handle->dual_quad_spi_enable != 0)                                             /* enable dual quad spi */
+        return a_w25qxx_spi_batch_write(handle, command, addr, has_addr, data, len, NULL);      /* send the batch */
+    }
+    else if ((handle->spi_qspi == W25QXX_INTERFACE_SPI) && (handle->dual_quad_spi_enable == 0)) /* single spi */
+    {
+        buf[0] = W25QXX_COMMAND_WRITE_ENABLE;                                                   /* write enable command */
+        res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf, 1, NULL, 0);                      /* spi write read */
+        if (res != 0)                                                                           /* check result */
         {
-            res = a_w25qxx_qspi_write_read(handle,
-                                           W25QXX_COMMAND_RELEASE_POWER_DOWN, 1,
-                                           0x00000000, 0x00, 0x00,
-                                           0x00000000, 0x00, 0x00,
-                                           3 * 8, NULL, 0x00,
-                                          (uint8_t *)&id, 1, 1);                           /* qspi write read */
-            if (res != 0)                                                                  /* check result */
-            {
-                handle->debug_print("w25qxx: release power down failed.\n");               /* release power down failed */
-               
-                return 1;                                                                  /* return error */
-            }
+            handle->debug_print("w25qxx: write enable failed.\n");                              /* write enable failed */
+            
+            return 1;                                                                           /* return error */
         }
-        else                                                                               /* single spi */
+        if ((addr_len == 3) && (handle->type >= W25Q256))                                       /* >128Mb */
         {
-            buf[0] = W25QXX_COMMAND_RELEASE_POWER_DOWN;                                    /* release power down command */
-            buf[1] = 0xFF;                                                                 /* dummy */
-            buf[2] = 0xFF;                                                                 /* dummy */
-            buf[3] = 0xFF;                                                                 /* dummy */
-            res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf, 4, (uint8_t *)&id, 1);   /* spi write read */
-            if (res != 0)                                                                  /* check result */
+            buf[0] = 0xC5;                                                                      /* write extended addr register command */
+            buf[1] = (addr >> 24) & 0xFF;                                                       /* 31 - 24 bits */
+            res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf, 2, NULL, 0);                  /* spi write read */
+            if (res != 0)                                                                       /* check result */
             {
-                handle->debug_print("w25qxx: release power down failed.\n");               /* release power down failed */
-               
-                return 1;                                                                  /* return error */
+                handle->debug_print("w25qxx: write extended addr register failed.\n");          /* write extended addr register failed */
+                
+                return 1;                                                                       /* return error */
             }
+            buf[0] = W25QXX_COMMAND_WRITE_ENABLE;                                               /* write enable command */
+            res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf, 1, NULL, 0);                  /* spi write read */
+            if (res != 0)                                                                       /* check result */
+            {
+                handle->debug_print("w25qxx: write enable failed.\n");                          /* write enable failed */
+                
+                return 1;                                                                       /* return error */
+            }
+        }
+        i = 0;                                                                                  /* init 0 */
+        handle->buf[i++] = command;                                                             /* set command */
+        if (addr_len == 4)                                                                      /* 4 address mode */
+        {
+            handle->buf[i++] = (addr >> 24) & 0xFF;                                             /* 31 - 24 bits */
+        }
+        if (addr_len != 0)                                                                      /* check address */
+        {
+            handle->buf[i++] = (addr >> 16) & 0xFF;                                             /* 23 - 16 bits */
+            handle->buf[i++] = (addr >> 8) & 0xFF;                                              /* 15 - 8  bits */
+            handle->buf[i++] = (addr >> 0) & 0xFF;                                              /* 7 - 0 bits */
+        }
+        if (len != 0)                                                                           /* check length */
+        {
+            memcpy(&handle->buf[i], data, len);                                                 /* copy data */
+        }
+        res = a_w25qxx_spi_write_read(handle, (uint8_t *)handle->buf, i + len, NULL, 0);        /* spi write read */
+        if (res != 0)                                                                           /* check result */
+        {
+            handle->debug_print("w25qxx: issue command failed.\n");                             /* issue command failed */
+            
+            return 1;                                                                           /* return error */
         }
     }
-    else                                                                                   /* qspi interface */
+    else                                                                                        /* dual quad spi or qspi */
     {
-        res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_RELEASE_POWER_DOWN, 4,
+        line = (handle->spi_qspi == W25QXX_INTERFACE_SPI) ? 1 : 4;                              /* set the phy lines */
+        res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_WRITE_ENABLE, line,
                                        0x00000000, 0x00, 0x00,
                                        0x00000000, 0x00, 0x00,
-                                       6, NULL, 0x00,
-                                      (uint8_t *)&id, 1, 4);                               /* qspi write read */
-        if (res != 0)                                                                      /* check result */
+                                       0x00, NULL, 0x00,
+                                       NULL, 0x00, 0x00);                                       /* qspi write read */
+        if (res != 0)                                                                           /* check result */
         {
-            handle->debug_print("w25qxx: release power down failed.\n");                   /* release power down failed */
-           
-            return 1;                                                                      /* return error */
+            handle->debug_print("w25qxx: write enable failed.\n");                              /* write enable failed */
+            
+            return 1;                                                                           /* return error */
         }
-    }
-    
+        if ((addr_len == 3) && (handle->type >= W25Q256))                                       /* >128Mb */
+        {
+            buf[0] = (addr >> 24) & 0xFF;                                                       /* 31 - 24 bits */
+            res = a_w25qxx_qspi_write_read(handle, 0xC5, line,
+                                           0x00000000, 0x00, 0x00,
+                                           0x00000000, 0x00, 0x00,
+                                           0, (uint8_t *)buf, 0x01,
+                                           NULL, 0x00, line);                                   /* qspi write read */
+            if (res != 0)                                                                       /* check result */
+            {
+                handle->debug_print("w25qxx: write extended addr register failed.\n");          /* write extended addr register failed */
+                
+                return 1;                                                                       /* return error */
+            }
+            res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_WRITE_ENABLE, line,
+                                           0x00000000, 0x00, 0x00,
+                                           0x00000000, 0x00, 0x00,
+                                           0x00, NULL, 0x00,
+                                           NULL, 0x00, 0x00);                                   /* qspi write read */
+            if (res != 0)                                                                       /* check result */
+            {
+                handle->debug_print("w25qxx: write enable failed.\n");                          /* write enable failed */
+                
+                return 1;                                                                       /* return error */
+            }
+        }
+        res = a_w25qxx_qspi_write_read(handle, command, line,
+                                       addr, (addr_len != 0) ? line : 0x00, addr_len,
+                                       0x00000000, 0x00, 0x00,
+                                       0, data, len,
+                                       NULL, 0x00, (len != 0) ? line : 0x00);                   /* qspi write read */
+        if (res != 0)                                                                           /* check result */
+        {
+            handle->debug_print("w25qxx: issue command failed.\n");                             /* issue command failed */
+            
+            return 1;                                                                           /* return error */
+        }
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief start an erase without waiting for it
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_erase_start_unlocked(w25qxx_handle_t *handle, w25qxx_erase_type_t type, uint32_t addr)
+{
+    uint8_t res;
+    uint8_t command;
+    uint32_t align;
+    
+    if (handle == NULL)                                          /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (handle->inited != 1)                                     /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    if (type == W25QXX_ERASE_TYPE_SECTOR_4K)                     /* 4k sector */
+    {
+        command = W25QXX_COMMAND_SECTOR_ERASE_4K;                /* sector erase 4k command */
+        align = 4096;                                            /* 4k */
+    }
+    else if (type == W25QXX_ERASE_TYPE_BLOCK_32K)                /* 32k block */
+    {
+        command = W25QXX_COMMAND_BLOCK_ERASE_32K;                /* block erase 32k command */
+        align = 32 * 1024;                                       /* 32k */
+    }
+    else if (type == W25QXX_ERASE_TYPE_BLOCK_64K)                /* 64k block */
+    {
+        command = W25QXX_COMMAND_BLOCK_ERASE_64K;                /* block erase 64k command */
+        align = 64 * 1024;                                       /* 64k */
+    }
+    else if (type == W25QXX_ERASE_TYPE_CHIP)                     /* chip */
+    {
+        command = W25QXX_COMMAND_CHIP_ERASE;                     /* chip erase command */
+        align = 1;                                               /* any */
+        addr = 0;                                                /* no address */
+    }
+    else
+    {
+        handle->debug_print("w25qxx: type is invalid.\n");       /* type is invalid */
+        
+        return 6;                                                /* return error */
+    }
+    if ((addr % align) != 0)                                     /* check address */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");       /* addr is invalid */
+        
+        return 4;                                                /* return error */
+    }
+    
+    res = a_w25qxx_issue_write_command(handle, command, addr,
+                                       (type == W25QXX_ERASE_TYPE_CHIP) ? W25QXX_BOOL_FALSE : W25QXX_BOOL_TRUE,
+                                       NULL, 0);                 /* issue the erase */
+    if (res != 0)                                                /* check result */
+    {
+        handle->debug_print("w25qxx: erase start failed.\n");    /* erase start failed */
+        
+        return res;                                              /* return error */
+    }
+    if (handle->erase_callback != NULL)                          /* check erase callback */
+    {
+        handle->erase_callback(handle->erase_param, type, addr); /* run erase callback */
+    }
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief     start an erase without waiting for it
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] type erase type
+ * @param[in] addr erase address
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 6 type is invalid
+ * @note      none
+ */
+uint8_t w25qxx_erase_start(w25qxx_handle_t *handle, w25qxx_erase_type_t type, uint32_t addr)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);            /* lock */
+    res = a_w25qxx_erase_start_unlocked(handle, type, addr); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);          /* unlock */
+    
+    return res;                                              /* return the result */
+}
+
+/**
+ * @brief start a page program without waiting for it
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_page_program_start_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    if (len > 256)                                                   /* check length */
+    {
+        handle->debug_print("w25qxx: length is over 256.\n");        /* length is over 256 */
+        
+        return 7;                                                    /* return error */
+    }
+    if (((addr % 256) + len) > 256)                                  /* check address */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");           /* addr is invalid */
+        
+        return 4;                                                    /* return error */
+    }
+    
+    res = a_w25qxx_issue_write_command(handle, W25QXX_COMMAND_PAGE_PROGRAM, addr,
+                                       W25QXX_BOOL_TRUE, data, len); /* issue the page program */
+    if (res != 0)                                                    /* check result */
+    {
+        handle->debug_print("w25qxx: page program start failed.\n"); /* page program start failed */
+        
+        return res;                                                  /* return error */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     start a page program without waiting for it
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] addr program address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 page program start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 7 length is over 256
+ * @note      none
+ */
+uint8_t w25qxx_page_program_start(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                        /* lock */
+    res = a_w25qxx_page_program_start_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                      /* unlock */
+    
+    return res;                                                          /* return the result */
+}
+
+/**
+ * @brief get the busy and suspend status
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_busy_unlocked(w25qxx_handle_t *handle, w25qxx_bool_t *busy, w25qxx_bool_t *suspended)
+{
+    uint8_t res;
+    uint8_t status;
+    
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    
+    res = a_w25qxx_get_status1_unlocked(handle, &status);      /* get status1 */
+    if (res != 0)                                              /* check result */
+    {
+        handle->debug_print("w25qxx: get busy failed.\n");     /* get busy failed */
+        
+        return 1;                                              /* return error */
+    }
+    *busy = W25QXX_BOOL_FALSE;                                 /* not busy */
+    if ((status & 0x01) != 0)                                  /* check busy */
+    {
+        *busy = W25QXX_BOOL_TRUE;                              /* busy */
+    }
+    if (suspended != NULL)                                     /* check suspended */
+    {
+        res = a_w25qxx_get_status2_unlocked(handle, &status);  /* get status2 */
+        if (res != 0)                                          /* check result */
+        {
+            handle->debug_print("w25qxx: get busy failed.\n"); /* get busy failed */
+            
+            return 1;                                          /* return error */
+        }
+        *suspended = W25QXX_BOOL_FALSE;                        /* not suspended */
+        if ((status & 0x80) != 0)                              /* check suspended */
+        {
+            *suspended = W25QXX_BOOL_TRUE;                     /* suspended */
+        }
+    }
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the busy and suspend status
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *busy pointer to a bool buffer
+ * @param[out] *suspended pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get busy failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       suspended may be NULL
+ */
+uint8_t w25qxx_get_busy(w25qxx_handle_t *handle, w25qxx_bool_t *busy, w25qxx_bool_t *suspended)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);                 /* lock */
+    res = a_w25qxx_get_busy_unlocked(handle, busy, suspended); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);               /* unlock */
+    
+    return res;                                                /* return the result */
+}
+
+/**
+ * @brief     start an erase and hold the handle until it is done
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] type erase type
+ * @param[in] addr erase address
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 6 type is invalid
+ * @note      on success the exclusive lock stays taken, poll w25qxx_get_busy_hold from
+ *            the same thread until it releases the lock, other users of the handle wait
+ *            instead of meeting a busy chip
+ */
+uint8_t w25qxx_erase_start_hold(w25qxx_handle_t *handle, w25qxx_erase_type_t type, uint32_t addr)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);            /* lock */
+    res = a_w25qxx_erase_start_unlocked(handle, type, addr); /* run */
+    if (res != 0)                                            /* check result */
+    {
+        a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);      /* unlock */
+    }
+    
+    return res;                                              /* return the result */
+}
+
+/**
+ * @brief     start a page program and hold the handle until it is done
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] addr program address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 page program start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 7 length is over 256
+ * @note      on success the exclusive lock stays taken, poll w25qxx_get_busy_hold from
+ *            the same thread until it releases the lock
+ */
+uint8_t w25qxx_page_program_start_hold(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                        /* lock */
+    res = a_w25qxx_page_program_start_unlocked(handle, addr, data, len); /* run */
+    if (res != 0)                                                        /* check result */
+    {
+        a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                  /* unlock */
+    }
+    
+    return res;                                                          /* return the result */
+}
+
+/**
+ * @brief      get the busy status of a held handle
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *busy pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get busy failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       only after a successful w25qxx_erase_start_hold or w25qxx_page_program_start_hold,
+ *             the lock is released once the chip is idle or the status read fails
+ */
+uint8_t w25qxx_get_busy_hold(w25qxx_handle_t *handle, w25qxx_bool_t *busy)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    
+    res = a_w25qxx_get_busy_unlocked(handle, busy, NULL); /* run */
+    if ((res != 0) || (*busy == W25QXX_BOOL_FALSE))       /* check done */
+    {
+        a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);   /* unlock */
+    }
+    
+    return res;                                           /* return the result */
+}
+
+/**
+ * @brief     release a held handle
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      gives the handle up while the chip is still busy, e.g. after a timeout
+ */
+uint8_t w25qxx_release_hold(w25qxx_handle_t *handle)
+{
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief      erase on several chips at the same time
+ * @param[in]  **handle pointer to an array of w25qxx handles
+ * @param[in]  count chip count
+ * @param[in]  type erase type
+ * @param[in]  *addr pointer to an erase address array, one per chip, may be NULL for the chip erase
+ * @param[out] *result pointer to a status array, one erase start status per chip or 1 on timeout
+ * @return     status code
+ *             - 0 success
+ *             - 1 an erase failed
+ *             - 2 handle is NULL
+ * @note       the erases are started back to back and the chips are polled together every
+ *             1 ms with the delay of a running chip, so the whole call takes about one erase
+ *             time instead of count times, a failed chip doesn't stop the others, every chip
+ *             holds its exclusive lock from the erase start until it is done, so the handles
+ *             must be different
+ */
+uint8_t w25qxx_erase_parallel(w25qxx_handle_t **handle, uint8_t count, w25qxx_erase_type_t type,
+                              const uint32_t *addr, uint8_t *result)
+{
+    uint8_t i;
+    uint8_t pending;
+    uint8_t running;
+    uint8_t res;
+    uint32_t timeout;
+    w25qxx_bool_t busy;
+    
+    if ((handle == NULL) || (result == NULL) || (count == 0))                                /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if ((addr == NULL) && (type != W25QXX_ERASE_TYPE_CHIP))                                  /* check address */
+    {
+        return 2;                                                                            /* return error */
+    }
+    for (i = 0; i < count; i++)                                                              /* loop all chips */
+    {
+        if (handle[i] == NULL)                                                               /* check handle */
+        {
+            return 2;                                                                        /* return error */
+        }
+    }
+    
+    /* start all erases back to back */
+    pending = 0;                                                                             /* init 0 */
+    for (i = 0; i < count; i++)                                                              /* loop all chips */
+    {
+        a_w25qxx_lock(handle[i], W25QXX_LOCK_EXCLUSIVE);                                     /* lock */
+        result[i] = a_w25qxx_erase_start_unlocked(handle[i], type,
+                                                  (addr != NULL) ? addr[i] : 0);             /* start the erase */
+        if (result[i] == 0)                                                                  /* check result */
+        {
+            result[i] = 0xFF;                                                                /* running */
+            pending++;                                                                       /* pending++ */
+        }
+        else
+        {
+            a_w25qxx_unlock(handle[i], W25QXX_LOCK_EXCLUSIVE);                               /* unlock */
+        }
+    }
+    if (type == W25QXX_ERASE_TYPE_SECTOR_4K)                                                 /* 4k sector */
+    {
+        timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                                /* set default timeout */
+    }
+    else if (type == W25QXX_ERASE_TYPE_BLOCK_32K)                                            /* 32k block */
+    {
+        timeout = W25QXX_ERASE_32K_TIMEOUT_MS;                                               /* set default timeout */
+    }
+    else if (type == W25QXX_ERASE_TYPE_BLOCK_64K)                                            /* 64k block */
+    {
+        timeout = W25QXX_ERASE_64K_TIMEOUT_MS;                                               /* set default timeout */
+    }
+    else
+    {
+        timeout = W25QXX_ERASE_CHIP_TIMEOUT_MS;                                              /* set default timeout */
+    }
+    
+    /* poll the running chips together */
+    while (pending != 0)                                                                     /* check pending */
+    {
+        running = 0xFF;                                                                      /* none */
+        for (i = 0; i < count; i++)                                                          /* loop all chips */
+        {
+            if (result[i] != 0xFF)                                                           /* not running */
+            {
+                continue;                                                                    /* skip */
+            }
+            if (a_w25qxx_get_busy_unlocked(handle[i], &busy, NULL) != 0)                     /* get busy */
+            {
+                result[i] = 1;                                                               /* failed */
+                pending--;                                                                   /* pending-- */
+            }
+            else if (busy == W25QXX_BOOL_FALSE)                                              /* idle */
+            {
+                result[i] = 0;                                                               /* done */
+                pending--;                                                                   /* pending-- */
+            }
+            else if (timeout == 0)                                                           /* check timeout */
+            {
+                handle[i]->debug_print("w25qxx: erase parallel timeout.\n");                /* erase parallel timeout */
+                result[i] = 1;                                                               /* failed */
+                pending--;                                                                   /* pending-- */
+            }
+            else
+            {
+                running = i;                                                                 /* still erasing */
+            }
+            if (result[i] != 0xFF)                                                           /* done */
+            {
+                a_w25qxx_unlock(handle[i], W25QXX_LOCK_EXCLUSIVE);                           /* unlock */
+            }
+        }
+        if ((running != 0xFF) && (timeout != 0))                                             /* check running */
+        {
+            timeout--;                                                                       /* timeout-- */
+            handle[running]->delay_ms(1);                                                    /* delay 1 ms */
+        }
+    }
+    
+    /* collect the results */
+    res = 0;                                                                                 /* init 0 */
+    for (i = 0; i < count; i++)                                                              /* loop all chips */
+    {
+        if (result[i] != 0)                                                                  /* check result */
+        {
+            res = 1;                                                                         /* failed */
+        }
+    }
+    
+    return res;                                                                              /* return the result */
+}
+
+/**
+ * @brief power down
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_power_down_unlocked(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t buf[1];
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }   
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    
+    if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                  /* spi interface */
+    {
+        if (handle->dual_quad_spi_enable != 0)                                     /* enable dual quad spi */
+        {
+            res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_POWER_DOWN, 1,
+                                           0x00000000, 0x00, 0x00,
+                                           0x00000000, 0x00, 0x00,
+                                           0x00, NULL, 0x00,
+                                           NULL, 0x00, 0x00);                      /* qspi write read */
+            if (res != 0)                                                          /* check result */
+            {
+                handle->debug_print("w25qxx: power down failed.\n");               /* power down failed */
+               
+                return 1;                                                          /* return error */
+            }
+        }
+        else                                                                       /* single spi */
+        {
+            buf[0] = W25QXX_COMMAND_POWER_DOWN;                                    /* power down command */
+            res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf,
+                                          1, NULL, 0);                             /* spi write read */
+            if (res != 0)                                                          /* check result */
+            {
+                handle->debug_print("w25qxx: power down failed.\n");               /* power down failed */
+               
+                return 1;                                                          /* return error */
+            }
+        }
+    }
+    else                                                                           /* qspi interface */
+    {
+        res = a_w25qxx_qspi_write_read(handle, 0xFF, 4,
+                                       0x00000000, 0x00, 0x00,
+                                       0x00000000, 0x00, 0x00,
+                                       0, NULL, 0x00,
+                                       NULL, 0x00, 0);                             /* spi write read */
+        if (res != 0)                                                              /* check result */
+        {
+            handle->debug_print("w25qxx: exit qspi mode failed.\n");               /* exit qspi mode failed */
+           
+            return 1;                                                              /* return error */
+        }
+        handle->delay_ms(10);                                                      /* delay 10 ms */
+        res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_POWER_DOWN, 4,
+                                       0x00000000, 0x00, 0x00,
+                                       0x00000000, 0x00, 0x00,
+                                       0x00, NULL, 0x00,
+                                       NULL, 0x00, 0x00);                          /* qspi write read */
+        if (res != 0)                                                              /* check result */
+        {
+            handle->debug_print("w25qxx: power down failed.\n");                   /* power down failed */
+           
+            return 1;                                                              /* return error */
+        }
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     power down
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 power down failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_power_down(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);   /* lock */
+    res = a_w25qxx_power_down_unlocked(handle);     /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief release power down
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_release_power_down_unlocked(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t id;
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }   
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                          /* spi interface */
+    {
+        if (handle->dual_quad_spi_enable != 0)                                             /* enable dual quad spi */
+        {
+            res = a_w25qxx_qspi_write_read(handle,
+                                           W25QXX_COMMAND_RELEASE_POWER_DOWN, 1,
+                                           0x00000000, 0x00, 0x00,
+                                           0x00000000, 0x00, 0x00,
+                                           3 * 8, NULL, 0x00,
+                                          (uint8_t *)&id, 1, 1);                           /* qspi write read */
+            if (res != 0)                                                                  /* check result */
+            {
+                handle->debug_print("w25qxx: release power down failed.\n");               /* release power down failed */
+               
+                return 1;                                                                  /* return error */
+            }
+        }
+        else                                                                               /* single spi */
+        {
+            buf[0] = W25QXX_COMMAND_RELEASE_POWER_DOWN;                                    /* release power down command */
+            buf[1] = 0xFF;                                                                 /* dummy */
+            buf[2] = 0xFF;                                                                 /* dummy */
+            buf[3] = 0xFF;                                                                 /* dummy */
+            res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf, 4, (uint8_t *)&id, 1);   /* spi write read */
+            if (res != 0)                                                                  /* check result */
+            {
+                handle->debug_print("w25qxx: release power down failed.\n");               /* release power down failed */
+               
+                return 1;                                                                  /* return error */
+            }
+        }
+    }
+    else                                                                                   /* qspi interface */
+    {
+        res = a_w25qxx_qspi_write_read(handle, W25QXX_COMMAND_RELEASE_POWER_DOWN, 4,
+                                       0x00000000, 0x00, 0x00,
+                                       0x00000000, 0x00, 0x00,
+                                       6, NULL, 0x00,
+                                      (uint8_t *)&id, 1, 4);                               /* qspi write read */
+        if (res != 0)                                                                      /* check result */
+        {
+            handle->debug_print("w25qxx: release power down failed.\n");                   /* release power down failed */
+           
+            return 1;                                                                      /* return error */
+        }
+    }
+    
     return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the manufacturer && device id information
- * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[out] *manufacturer pointer to a manufacturer buffer
- * @param[out] *device_id pointer to a device id buffer
- * @return     status code
- *             - 0 success
- *             - 1 get manufacturer device id failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     release power down
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 release power down failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t w25qxx_get_manufacturer_device_id(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
+uint8_t w25qxx_release_power_down(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);       /* lock */
+    res = a_w25qxx_release_power_down_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);     /* unlock */
+    
+    return res;                                         /* return the result */
+}
+
+/**
+ * @brief get the manufacturer && device id information
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_manufacturer_device_id_unlocked(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
 {
     uint8_t res;
     uint8_t buf[4];
@@ -2021,21 +3152,38 @@ uint8_t w25qxx_get_manufacturer_device_id(w25qxx_handle_t *handle, uint8_t *manu
 }
 
 /**
- * @brief      get the manufacturer && device id information with dual io
+ * @brief      get the manufacturer && device id information
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[out] *manufacturer pointer to a manufacturer buffer
  * @param[out] *device_id pointer to a device id buffer
  * @return     status code
  *             - 0 success
- *             - 1 get manufacturer device id dual io failed
+ *             - 1 get manufacturer device id failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 address mode is invalid
- *             - 5 qspi can't use this function
- *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_get_manufacturer_device_id_dual_io(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
+uint8_t w25qxx_get_manufacturer_device_id(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);                                           /* lock */
+    res = a_w25qxx_get_manufacturer_device_id_unlocked(handle, manufacturer, device_id); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);                                         /* unlock */
+    
+    return res;                                                                          /* return the result */
+}
+
+/**
+ * @brief get the manufacturer && device id information with dual io
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_manufacturer_device_id_dual_io_unlocked(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
 {
     uint8_t res;
     uint8_t out[2];
@@ -2105,13 +3253,13 @@ uint8_t w25qxx_get_manufacturer_device_id_dual_io(w25qxx_handle_t *handle, uint8
 }
 
 /**
- * @brief      get the manufacturer && device id information with quad io
+ * @brief      get the manufacturer && device id information with dual io
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[out] *manufacturer pointer to a manufacturer buffer
  * @param[out] *device_id pointer to a device id buffer
  * @return     status code
  *             - 0 success
- *             - 1 get manufacturer device id quad io failed
+ *             - 1 get manufacturer device id dual io failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
@@ -2119,7 +3267,27 @@ uint8_t w25qxx_get_manufacturer_device_id_dual_io(w25qxx_handle_t *handle, uint8
  *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_get_manufacturer_device_id_quad_io(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
+uint8_t w25qxx_get_manufacturer_device_id_dual_io(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);                                                   /* lock */
+    res = a_w25qxx_get_manufacturer_device_id_dual_io_unlocked(handle, manufacturer, device_id); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);                                                 /* unlock */
+    
+    return res;                                                                                  /* return the result */
+}
+
+/**
+ * @brief get the manufacturer && device id information with quad io
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_manufacturer_device_id_quad_io_unlocked(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
 {
     uint8_t res;
     uint8_t out[2];
@@ -2189,18 +3357,41 @@ uint8_t w25qxx_get_manufacturer_device_id_quad_io(w25qxx_handle_t *handle, uint8
 }
 
 /**
- * @brief      get the jedec id information
+ * @brief      get the manufacturer && device id information with quad io
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[out] *manufacturer pointer to a manufacturer buffer
  * @param[out] *device_id pointer to a device id buffer
  * @return     status code
  *             - 0 success
- *             - 1 get jedec id failed
+ *             - 1 get manufacturer device id quad io failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 address mode is invalid
+ *             - 5 qspi can't use this function
+ *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_get_jedec_id(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t device_id[2])
+uint8_t w25qxx_get_manufacturer_device_id_quad_io(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t *device_id)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);                                                   /* lock */
+    res = a_w25qxx_get_manufacturer_device_id_quad_io_unlocked(handle, manufacturer, device_id); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);                                                 /* unlock */
+    
+    return res;                                                                                  /* return the result */
+}
+
+/**
+ * @brief get the jedec id information
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_jedec_id_unlocked(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t device_id[2])
 {
     uint8_t res;
     uint8_t buf[1];
@@ -2272,16 +3463,38 @@ uint8_t w25qxx_get_jedec_id(w25qxx_handle_t *handle, uint8_t *manufacturer, uint
 }
 
 /**
- * @brief     lock the whole block
- * @param[in] *handle pointer to a w25qxx handle structure
- * @return    status code
- *            - 0 success
- *            - 1 global block lock failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the jedec id information
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *manufacturer pointer to a manufacturer buffer
+ * @param[out] *device_id pointer to a device id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get jedec id failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t w25qxx_global_block_lock(w25qxx_handle_t *handle)
+uint8_t w25qxx_get_jedec_id(w25qxx_handle_t *handle, uint8_t *manufacturer, uint8_t device_id[2])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);                             /* lock */
+    res = a_w25qxx_get_jedec_id_unlocked(handle, manufacturer, device_id); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);                           /* unlock */
+    
+    return res;                                                            /* return the result */
+}
+
+/**
+ * @brief lock the whole block
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_global_block_lock_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -2342,16 +3555,36 @@ uint8_t w25qxx_global_block_lock(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     unlock the whole block
+ * @brief     lock the whole block
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 global block unlock failed
+ *            - 1 global block lock failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t w25qxx_global_block_unlock(w25qxx_handle_t *handle)
+uint8_t w25qxx_global_block_lock(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                /* check handle */
+    {
+        return 2;                                      /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);      /* lock */
+    res = a_w25qxx_global_block_lock_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);    /* unlock */
+    
+    return res;                                        /* return the result */
+}
+
+/**
+ * @brief unlock the whole block
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_global_block_unlock_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -2412,19 +3645,36 @@ uint8_t w25qxx_global_block_unlock(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     set the read parameters
+ * @brief     unlock the whole block
  * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] dummy qspi read dummy
- * @param[in] length qspi read wrap length
  * @return    status code
  *            - 0 success
- *            - 1 set read parameters failed
+ *            - 1 global block unlock failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 spi interface can't use this function
  * @note      none
  */
-uint8_t w25qxx_set_read_parameters(w25qxx_handle_t *handle, w25qxx_qspi_read_dummy_t dummy, w25qxx_qspi_read_wrap_length_t length)
+uint8_t w25qxx_global_block_unlock(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);        /* lock */
+    res = a_w25qxx_global_block_unlock_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);      /* unlock */
+    
+    return res;                                          /* return the result */
+}
+
+/**
+ * @brief set the read parameters
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_set_read_parameters_unlocked(w25qxx_handle_t *handle, w25qxx_qspi_read_dummy_t dummy, w25qxx_qspi_read_wrap_length_t length)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -2477,21 +3727,43 @@ uint8_t w25qxx_set_read_parameters(w25qxx_handle_t *handle, w25qxx_qspi_read_dum
         }
     }
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the read parameters
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] dummy qspi read dummy
+ * @param[in] length qspi read wrap length
+ * @return    status code
+ *            - 0 success
+ *            - 1 set read parameters failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 spi interface can't use this function
+ * @note      none
+ */
+uint8_t w25qxx_set_read_parameters(w25qxx_handle_t *handle, w25qxx_qspi_read_dummy_t dummy, w25qxx_qspi_read_wrap_length_t length)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                       /* lock */
+    res = a_w25qxx_set_read_parameters_unlocked(handle, dummy, length); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                     /* unlock */
+    
+    return res;                                                         /* return the result */
 }
 
 /**
- * @brief     enter the qspi mode
- * @param[in] *handle pointer to a w25qxx handle structure
- * @return    status code
- *            - 0 success
- *            - 1 enter qspi mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 qspi interface can't use this function
- * @note      none
+ * @brief enter the qspi mode
+ * @note  the caller holds the handle lock
  */
-uint8_t w25qxx_enter_qspi_mode(w25qxx_handle_t *handle)
+static uint8_t a_w25qxx_enter_qspi_mode_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -2559,17 +3831,37 @@ uint8_t w25qxx_enter_qspi_mode(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     exit the qspi mode
+ * @brief     enter the qspi mode
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 exit qspi mode failed
+ *            - 1 enter qspi mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 spi interface can't use this function
+ *            - 4 qspi interface can't use this function
  * @note      none
  */
-uint8_t w25qxx_exit_qspi_mode(w25qxx_handle_t *handle)
+uint8_t w25qxx_enter_qspi_mode(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                              /* check handle */
+    {
+        return 2;                                    /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);    /* lock */
+    res = a_w25qxx_enter_qspi_mode_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);  /* unlock */
+    
+    return res;                                      /* return the result */
+}
+
+/**
+ * @brief exit the qspi mode
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_exit_qspi_mode_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     
@@ -2607,16 +3899,37 @@ uint8_t w25qxx_exit_qspi_mode(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     enable the reset
+ * @brief     exit the qspi mode
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 enable reset failed
+ *            - 1 exit qspi mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 spi interface can't use this function
  * @note      none
  */
-uint8_t w25qxx_enable_reset(w25qxx_handle_t *handle)
+uint8_t w25qxx_exit_qspi_mode(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);   /* lock */
+    res = a_w25qxx_exit_qspi_mode_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief enable the reset
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_enable_reset_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -2678,16 +3991,36 @@ uint8_t w25qxx_enable_reset(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief     reset the device
+ * @brief     enable the reset
  * @param[in] *handle pointer to a w25qxx handle structure
  * @return    status code
  *            - 0 success
- *            - 1 reset device failed
+ *            - 1 enable reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t w25qxx_reset_device(w25qxx_handle_t *handle)
+uint8_t w25qxx_enable_reset(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);   /* lock */
+    res = a_w25qxx_enable_reset_unlocked(handle);   /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief reset the device
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_reset_device_unlocked(w25qxx_handle_t *handle)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -2749,19 +4082,36 @@ uint8_t w25qxx_reset_device(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief      get the unique id
- * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[out] *id pointer to an id buffer
- * @return     status code
- *             - 0 success
- *             - 1 get the unique id failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 address mode is invalid
- *             - 5 qspi can't use this function
- * @note       none
+ * @brief     reset the device
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 reset device failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t w25qxx_get_unique_id(w25qxx_handle_t *handle, uint8_t id[8])
+uint8_t w25qxx_reset_device(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);   /* lock */
+    res = a_w25qxx_reset_device_unlocked(handle);   /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE); /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief get the unique id
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_unique_id_unlocked(w25qxx_handle_t *handle, uint8_t id[8])
 {
     uint8_t res;
     uint8_t buf[6];
@@ -2866,18 +4216,39 @@ uint8_t w25qxx_get_unique_id(w25qxx_handle_t *handle, uint8_t id[8])
 }
 
 /**
- * @brief      get the sfdp
+ * @brief      get the unique id
  * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[out] *sfdp pointer to an sfdp buffer
+ * @param[out] *id pointer to an id buffer
  * @return     status code
  *             - 0 success
- *             - 1 get the sfdp failed
+ *             - 1 get the unique id failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 qspi can't use this function
+ *             - 4 address mode is invalid
+ *             - 5 qspi can't use this function
  * @note       none
  */
-uint8_t w25qxx_get_sfdp(w25qxx_handle_t *handle, uint8_t sfdp[256])
+uint8_t w25qxx_get_unique_id(w25qxx_handle_t *handle, uint8_t id[8])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                /* check handle */
+    {
+        return 2;                                      /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);         /* lock */
+    res = a_w25qxx_get_unique_id_unlocked(handle, id); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);       /* unlock */
+    
+    return res;                                        /* return the result */
+}
+
+/**
+ * @brief get the sfdp
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_sfdp_unlocked(w25qxx_handle_t *handle, uint8_t sfdp[256])
 {
     uint8_t res;
     uint8_t buf[5];
@@ -2936,20 +4307,38 @@ uint8_t w25qxx_get_sfdp(w25qxx_handle_t *handle, uint8_t sfdp[256])
 }
 
 /**
- * @brief     erase the security register
- * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] num security register number
- * @return    status code
- *            - 0 success
- *            - 1 erase security register failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 address mode is invalid
- *            - 5 qspi can't use this function
- *            - 6 erase security register timeout
- * @note      none
+ * @brief      get the sfdp
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *sfdp pointer to an sfdp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get the sfdp failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 qspi can't use this function
+ * @note       none
  */
-uint8_t w25qxx_erase_security_register(w25qxx_handle_t *handle, w25qxx_security_register_t num)
+uint8_t w25qxx_get_sfdp(w25qxx_handle_t *handle, uint8_t sfdp[256])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                             /* check handle */
+    {
+        return 2;                                   /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);      /* lock */
+    res = a_w25qxx_get_sfdp_unlocked(handle, sfdp); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);    /* unlock */
+    
+    return res;                                     /* return the result */
+}
+
+/**
+ * @brief erase the security register
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_erase_security_register_unlocked(w25qxx_handle_t *handle, w25qxx_security_register_t num)
 {
     uint8_t res;
     uint8_t status;
@@ -3130,21 +4519,40 @@ uint8_t w25qxx_erase_security_register(w25qxx_handle_t *handle, w25qxx_security_
 }
 
 /**
- * @brief     program the security register
+ * @brief     erase the security register
  * @param[in] *handle pointer to a w25qxx handle structure
  * @param[in] num security register number
- * @param[in] *data pointer to a data buffer
  * @return    status code
  *            - 0 success
- *            - 1 program security register failed
+ *            - 1 erase security register failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 address mode is invalid
  *            - 5 qspi can't use this function
- *            - 6 program security register timeout
+ *            - 6 erase security register timeout
  * @note      none
  */
-uint8_t w25qxx_program_security_register(w25qxx_handle_t *handle, w25qxx_security_register_t num, uint8_t data[256])
+uint8_t w25qxx_erase_security_register(w25qxx_handle_t *handle, w25qxx_security_register_t num)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                           /* check handle */
+    {
+        return 2;                                                 /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                 /* lock */
+    res = a_w25qxx_erase_security_register_unlocked(handle, num); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);               /* unlock */
+    
+    return res;                                                   /* return the result */
+}
+
+/**
+ * @brief program the security register
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_program_security_register_unlocked(w25qxx_handle_t *handle, w25qxx_security_register_t num, uint8_t data[256])
 {
     uint8_t res;
     uint8_t status;
@@ -3327,21 +4735,41 @@ uint8_t w25qxx_program_security_register(w25qxx_handle_t *handle, w25qxx_securit
 }
 
 /**
- * @brief      read the security register
- * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[in]  num security register number
- * @param[out] *data pointer to a data buffer
- * @return     status code
- *             - 0 success
- *             - 1 read security register failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 address mode is invalid
- *             - 5 qspi can't use this function
- *             - 6 program security register timeout
- * @note       none
+ * @brief     program the security register
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] num security register number
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 program security register failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address mode is invalid
+ *            - 5 qspi can't use this function
+ *            - 6 program security register timeout
+ * @note      none
  */
-uint8_t w25qxx_read_security_register(w25qxx_handle_t *handle, w25qxx_security_register_t num, uint8_t data[256])
+uint8_t w25qxx_program_security_register(w25qxx_handle_t *handle, w25qxx_security_register_t num, uint8_t data[256])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                         /* lock */
+    res = a_w25qxx_program_security_register_unlocked(handle, num, data); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                       /* unlock */
+    
+    return res;                                                           /* return the result */
+}
+
+/**
+ * @brief read the security register
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_read_security_register_unlocked(w25qxx_handle_t *handle, w25qxx_security_register_t num, uint8_t data[256])
 {
     uint8_t res;
     uint8_t buf[6];
@@ -3448,21 +4876,41 @@ uint8_t w25qxx_read_security_register(w25qxx_handle_t *handle, w25qxx_security_r
 }
 
 /**
- * @brief      read only in the spi interface
+ * @brief      read the security register
  * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[in]  addr read address
+ * @param[in]  num security register number
  * @param[out] *data pointer to a data buffer
- * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 only spi read failed
+ *             - 1 read security register failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
- *             - 5 only spi interface can use this function
+ *             - 5 qspi can't use this function
+ *             - 6 program security register timeout
  * @note       none
  */
-uint8_t w25qxx_only_spi_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_read_security_register(w25qxx_handle_t *handle, w25qxx_security_register_t num, uint8_t data[256])
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);                         /* lock */
+    res = a_w25qxx_read_security_register_unlocked(handle, num, data); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);                       /* unlock */
+    
+    return res;                                                        /* return the result */
+}
+
+/**
+ * @brief read only in the spi interface
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_only_spi_read_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[5];
@@ -3618,20 +5066,42 @@ uint8_t w25qxx_only_spi_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *da
 }
 
 /**
- * @brief      read in the fast mode
+ * @brief      read only in the spi interface
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[in]  addr read address
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 fast read failed
+ *             - 1 only spi read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
+ *             - 5 only spi interface can use this function
  * @note       none
  */
-uint8_t w25qxx_fast_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_only_spi_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                              /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_only_spi_read_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                                  /* unlock */
+    
+    return res;                                                     /* return the result */
+}
+
+/**
+ * @brief read in the fast mode
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_fast_read_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[6];
@@ -3840,22 +5310,41 @@ uint8_t w25qxx_fast_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data,
 }
 
 /**
- * @brief      read with dual output in the fast mode
+ * @brief      read in the fast mode
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[in]  addr read address
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 fast read dual output failed
+ *             - 1 fast read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
- *             - 5 qspi can't use this function
- *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_fast_read_dual_output(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_fast_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                         /* check handle */
+    {
+        return 2;                                               /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                          /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_fast_read_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                              /* unlock */
+    
+    return res;                                                 /* return the result */
+}
+
+/**
+ * @brief read with dual output in the fast mode
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_fast_read_dual_output_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -3949,14 +5438,14 @@ uint8_t w25qxx_fast_read_dual_output(w25qxx_handle_t *handle, uint32_t addr, uin
 }
 
 /**
- * @brief      read with quad output in the fast mode
+ * @brief      read with dual output in the fast mode
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[in]  addr read address
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 fast read quad output failed
+ *             - 1 fast read dual output failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
@@ -3964,7 +5453,28 @@ uint8_t w25qxx_fast_read_dual_output(w25qxx_handle_t *handle, uint32_t addr, uin
  *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_fast_read_quad_output(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_fast_read_dual_output(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                                      /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_fast_read_dual_output_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                                          /* unlock */
+    
+    return res;                                                             /* return the result */
+}
+
+/**
+ * @brief read with quad output in the fast mode
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_fast_read_quad_output_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -4058,14 +5568,14 @@ uint8_t w25qxx_fast_read_quad_output(w25qxx_handle_t *handle, uint32_t addr, uin
 }
 
 /**
- * @brief      read with dual io in the fast mode
+ * @brief      read with quad output in the fast mode
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[in]  addr read address
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 fast read dual io failed
+ *             - 1 fast read quad output failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
@@ -4073,7 +5583,28 @@ uint8_t w25qxx_fast_read_quad_output(w25qxx_handle_t *handle, uint32_t addr, uin
  *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_fast_read_dual_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_fast_read_quad_output(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                                      /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_fast_read_quad_output_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                                          /* unlock */
+    
+    return res;                                                             /* return the result */
+}
+
+/**
+ * @brief read with dual io in the fast mode
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_fast_read_dual_io_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -4167,21 +5698,43 @@ uint8_t w25qxx_fast_read_dual_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t
 }
 
 /**
- * @brief      read with quad io in the fast mode
+ * @brief      read with dual io in the fast mode
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[in]  addr read address
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 fast read quad io failed
+ *             - 1 fast read dual io failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
+ *             - 5 qspi can't use this function
  *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_fast_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_fast_read_dual_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                                  /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_fast_read_dual_io_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                                      /* unlock */
+    
+    return res;                                                         /* return the result */
+}
+
+/**
+ * @brief read with quad io in the fast mode
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_fast_read_quad_io_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -4332,22 +5885,42 @@ uint8_t w25qxx_fast_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t
 }
 
 /**
- * @brief      word read with quad io
+ * @brief      read with quad io in the fast mode
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[in]  addr read address
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 word read quad io failed
+ *             - 1 fast read quad io failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
- *             - 5 qspi can't use this function
  *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_word_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_fast_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                                  /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_fast_read_quad_io_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                                      /* unlock */
+    
+    return res;                                                         /* return the result */
+}
+
+/**
+ * @brief word read with quad io
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_word_read_quad_io_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -4441,14 +6014,14 @@ uint8_t w25qxx_word_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t
 }
 
 /**
- * @brief      octal word read with quad io
+ * @brief      word read with quad io
  * @param[in]  *handle pointer to a w25qxx handle structure
  * @param[in]  addr read address
  * @param[out] *data pointer to a data buffer
  * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 octal word read quad io failed
+ *             - 1 word read quad io failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 address mode is invalid
@@ -4456,7 +6029,28 @@ uint8_t w25qxx_word_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t
  *             - 6 standard spi can't use this function failed
  * @note       none
  */
-uint8_t w25qxx_octal_word_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+uint8_t w25qxx_word_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                                  /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_word_read_quad_io_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                                      /* unlock */
+    
+    return res;                                                         /* return the result */
+}
+
+/**
+ * @brief octal word read with quad io
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_octal_word_read_quad_io_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[1];
@@ -4550,23 +6144,43 @@ uint8_t w25qxx_octal_word_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, u
 }
 
 /**
- * @brief     page program
- * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] addr programming address
- * @param[in] *data pointer to a data buffer
- * @param[in] len data length
- * @return    status code
- *            - 0 success
- *            - 1 page program failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 addr is invalid
- *            - 5 address mode is invalid
- *            - 6 page program timeout
- *            - 7 length is over 256
- * @note      len <= 256
+ * @brief      octal word read with quad io
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[in]  addr read address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 octal word read quad io failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address mode is invalid
+ *             - 5 qspi can't use this function
+ *             - 6 standard spi can't use this function failed
+ * @note       none
  */
-uint8_t w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
+uint8_t w25qxx_octal_word_read_quad_io(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                                       /* check handle */
+    {
+        return 2;                                                             /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                                        /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_octal_word_read_quad_io_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                                            /* unlock */
+    
+    return res;                                                               /* return the result */
+}
+
+/**
+ * @brief page program
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_page_program_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
 {
     uint8_t res;
     uint8_t status;
@@ -4581,18 +6195,18 @@ uint8_t w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uint8_t *dat
     {
         return 3;                                                                                           /* return error */
     }
-    if ((addr % 256) != 0)                                                                                  /* check address */
-    {
-        handle->debug_print("w25qxx: addr is invalid.\n");                                                  /* addr is invalid */
-       
-        return 4;                                                                                           /* return error */
-    }
     if (len > 256)                                                                                          /* check address */
     {
         handle->debug_print("w25qxx: length is over 256.\n");                                               /* length is over 256 */
        
         return 7;                                                                                           /* return error */
     }
+    if (((addr % 256) + len) > 256)                                                                         /* check address */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");                                                  /* addr is invalid */
+       
+        return 4;                                                                                           /* return error */
+    }
     
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                           /* spi interface */
     {
@@ -4698,6 +6312,36 @@ uint8_t w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uint8_t *dat
                 return 6;                                                                                   /* return error */
             }
         }
+        else if (handle->spi_batch != NULL)                                                                 /* single spi batch */
+        {
+            res = a_w25qxx_spi_batch_write(handle, W25QXX_COMMAND_PAGE_PROGRAM, addr, W25QXX_BOOL_TRUE,
+                                           data, len, (uint8_t *)&status);                                  /* send the batch */
+            if (res != 0)                                                                                   /* check result */
+            {
+                return res;                                                                                 /* return error */
+            }
+            
+            timeout = W25QXX_PAGE_PROGRAM_TIMEOUT_MS * 100;                                                 /* set default timeout */
+            while ((status & 0x01) != 0x00)                                                                 /* check status */
+            {
+                if (timeout == 0)                                                                           /* check timeout */
+                {
+                    handle->debug_print("w25qxx: page program timeout.\n");                                 /* page program timeout */
+                   
+                    return 6;                                                                               /* return error */
+                }
+                timeout--;                                                                                  /* timeout-- */
+                handle->delay_us(10);                                                                       /* delay 10 us */
+                buf[0] = W25QXX_COMMAND_READ_STATUS_REG1;                                                   /* read status1 command */
+                res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf, 1, (uint8_t *)&status, 1);            /* spi write read */
+                if (res != 0)                                                                               /* check result */
+                {
+                    handle->debug_print("w25qxx: get status1 failed.\n");                                   /* get status1 failed */
+                   
+                    return 1;                                                                               /* return error */
+                }
+            }
+        }
         else                                                                                                /* single spi */
         {
             buf[0] = W25QXX_COMMAND_WRITE_ENABLE;                                                           /* write enable command */
@@ -4900,24 +6544,43 @@ uint8_t w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uint8_t *dat
 }
 
 /**
- * @brief     quad page program with quad input
+ * @brief     page program
  * @param[in] *handle pointer to a w25qxx handle structure
  * @param[in] addr programming address
  * @param[in] *data pointer to a data buffer
  * @param[in] len data length
  * @return    status code
  *            - 0 success
- *            - 1 quad page program failed
+ *            - 1 page program failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 addr is invalid
- *            - 5 qspi can't use this function
+ *            - 5 address mode is invalid
  *            - 6 page program timeout
  *            - 7 length is over 256
- *            - 8 standard spi can't use this function failed
- * @note      len <= 256
+ * @note      len <= 256, the data can start anywhere inside a page but must not cross the page end
  */
-uint8_t w25qxx_page_program_quad_input(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
+uint8_t w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                  /* lock */
+    res = a_w25qxx_page_program_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                /* unlock */
+    
+    return res;                                                    /* return the result */
+}
+
+/**
+ * @brief quad page program with quad input
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_page_program_quad_input_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
 {
     uint8_t res;
     uint8_t status;
@@ -5064,20 +6727,44 @@ uint8_t w25qxx_page_program_quad_input(w25qxx_handle_t *handle, uint32_t addr, u
 }
 
 /**
- * @brief     erase the 4k sector
+ * @brief     quad page program with quad input
  * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] addr erase address
+ * @param[in] addr programming address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
  * @return    status code
  *            - 0 success
- *            - 1 sector erase 4k failed
+ *            - 1 quad page program failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 addr is invalid
- *            - 5 address mode is invalid
- *            - 6 sector erase 4k timeout
- * @note      none
+ *            - 5 qspi can't use this function
+ *            - 6 page program timeout
+ *            - 7 length is over 256
+ *            - 8 standard spi can't use this function failed
+ * @note      len <= 256
  */
-uint8_t w25qxx_sector_erase_4k(w25qxx_handle_t *handle, uint32_t addr)
+uint8_t w25qxx_page_program_quad_input(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                       /* check handle */
+    {
+        return 2;                                                             /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                             /* lock */
+    res = a_w25qxx_page_program_quad_input_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                           /* unlock */
+    
+    return res;                                                               /* return the result */
+}
+
+/**
+ * @brief erase the 4k sector
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_sector_erase_4k_unlocked(w25qxx_handle_t *handle, uint32_t addr)
 {
     uint8_t res;
     uint8_t status;
@@ -5175,6 +6862,10 @@ uint8_t w25qxx_sector_erase_4k(w25qxx_handle_t *handle, uint32_t addr)
                 return 5;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_SECTOR_4K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                                           /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -5270,6 +6961,10 @@ uint8_t w25qxx_sector_erase_4k(w25qxx_handle_t *handle, uint32_t addr)
                 return 5;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_SECTOR_4K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                                           /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -5370,6 +7065,10 @@ uint8_t w25qxx_sector_erase_4k(w25qxx_handle_t *handle, uint32_t addr)
             return 5;                                                                                       /* return error */
         }
         
+        if (handle->erase_callback != NULL)                                                                 /* check erase callback */
+        {
+            handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_SECTOR_4K, addr);                 /* run erase callback */
+        }
         timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                                               /* set default timeout */
         while (timeout != 0)                                                                                /* check timeout */
         {
@@ -5403,20 +7102,40 @@ uint8_t w25qxx_sector_erase_4k(w25qxx_handle_t *handle, uint32_t addr)
 }
 
 /**
- * @brief     erase the 32k block
+ * @brief     erase the 4k sector
  * @param[in] *handle pointer to a w25qxx handle structure
  * @param[in] addr erase address
  * @return    status code
  *            - 0 success
- *            - 1 block erase 32k failed
+ *            - 1 sector erase 4k failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 addr is invalid
  *            - 5 address mode is invalid
- *            - 6 block erase 32k timeout
+ *            - 6 sector erase 4k timeout
  * @note      none
  */
-uint8_t w25qxx_block_erase_32k(w25qxx_handle_t *handle, uint32_t addr)
+uint8_t w25qxx_sector_erase_4k(w25qxx_handle_t *handle, uint32_t addr)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);          /* lock */
+    res = a_w25qxx_sector_erase_4k_unlocked(handle, addr); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);        /* unlock */
+    
+    return res;                                            /* return the result */
+}
+
+/**
+ * @brief erase the 32k block
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_block_erase_32k_unlocked(w25qxx_handle_t *handle, uint32_t addr)
 {
     uint8_t res;
     uint8_t status;
@@ -5514,6 +7233,10 @@ uint8_t w25qxx_block_erase_32k(w25qxx_handle_t *handle, uint32_t addr)
                 return 5;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_BLOCK_32K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_32K_TIMEOUT_MS;                                                          /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -5609,6 +7332,10 @@ uint8_t w25qxx_block_erase_32k(w25qxx_handle_t *handle, uint32_t addr)
                 return 5;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_BLOCK_32K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_32K_TIMEOUT_MS;                                                          /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -5709,6 +7436,10 @@ uint8_t w25qxx_block_erase_32k(w25qxx_handle_t *handle, uint32_t addr)
             return 5;                                                                                       /* return error */
         }
         
+        if (handle->erase_callback != NULL)                                                                 /* check erase callback */
+        {
+            handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_BLOCK_32K, addr);                 /* run erase callback */
+        }
         timeout = W25QXX_ERASE_32K_TIMEOUT_MS;                                                              /* set default timeout */
         while (timeout != 0)                                                                                /* check timeout */
         {
@@ -5742,20 +7473,40 @@ uint8_t w25qxx_block_erase_32k(w25qxx_handle_t *handle, uint32_t addr)
 }
 
 /**
- * @brief     erase the 64k block
+ * @brief     erase the 32k block
  * @param[in] *handle pointer to a w25qxx handle structure
  * @param[in] addr erase address
  * @return    status code
  *            - 0 success
- *            - 1 block erase 64k failed
+ *            - 1 block erase 32k failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 addr is invalid
  *            - 5 address mode is invalid
- *            - 6 block erase 64k timeout
+ *            - 6 block erase 32k timeout
  * @note      none
  */
-uint8_t w25qxx_block_erase_64k(w25qxx_handle_t *handle, uint32_t addr)
+uint8_t w25qxx_block_erase_32k(w25qxx_handle_t *handle, uint32_t addr)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);          /* lock */
+    res = a_w25qxx_block_erase_32k_unlocked(handle, addr); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);        /* unlock */
+    
+    return res;                                            /* return the result */
+}
+
+/**
+ * @brief erase the 64k block
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_block_erase_64k_unlocked(w25qxx_handle_t *handle, uint32_t addr)
 {
     uint8_t res;
     uint8_t status;
@@ -5853,6 +7604,10 @@ uint8_t w25qxx_block_erase_64k(w25qxx_handle_t *handle, uint32_t addr)
                 return 5;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_BLOCK_64K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_64K_TIMEOUT_MS;                                                          /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -5947,6 +7702,10 @@ uint8_t w25qxx_block_erase_64k(w25qxx_handle_t *handle, uint32_t addr)
                 return 5;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_BLOCK_64K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_64K_TIMEOUT_MS;                                                          /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -6047,6 +7806,10 @@ uint8_t w25qxx_block_erase_64k(w25qxx_handle_t *handle, uint32_t addr)
             return 5;                                                                                       /* return error */
         }
         
+        if (handle->erase_callback != NULL)                                                                 /* check erase callback */
+        {
+            handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_BLOCK_64K, addr);                 /* run erase callback */
+        }
         timeout = W25QXX_ERASE_64K_TIMEOUT_MS;                                                              /* set default timeout */
         while (timeout != 0)                                                                                /* check timeout */
         {
@@ -6080,18 +7843,40 @@ uint8_t w25qxx_block_erase_64k(w25qxx_handle_t *handle, uint32_t addr)
 }
 
 /**
- * @brief     lock the individual block
+ * @brief     erase the 64k block
  * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] addr block address
+ * @param[in] addr erase address
  * @return    status code
  *            - 0 success
- *            - 1 individual block lock failed
+ *            - 1 block erase 64k failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 address mode is invalid
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 6 block erase 64k timeout
  * @note      none
  */
-uint8_t w25qxx_individual_block_lock(w25qxx_handle_t *handle, uint32_t addr)
+uint8_t w25qxx_block_erase_64k(w25qxx_handle_t *handle, uint32_t addr)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);          /* lock */
+    res = a_w25qxx_block_erase_64k_unlocked(handle, addr); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);        /* unlock */
+    
+    return res;                                            /* return the result */
+}
+
+/**
+ * @brief lock the individual block
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_individual_block_lock_unlocked(w25qxx_handle_t *handle, uint32_t addr)
 {
     uint8_t res;
     uint8_t buf[5];
@@ -6297,18 +8082,38 @@ uint8_t w25qxx_individual_block_lock(w25qxx_handle_t *handle, uint32_t addr)
 }
 
 /**
- * @brief     unlock the individual block
+ * @brief     lock the individual block
  * @param[in] *handle pointer to a w25qxx handle structure
  * @param[in] addr block address
  * @return    status code
  *            - 0 success
- *            - 1 individual block unlock failed
+ *            - 1 individual block lock failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 address mode is invalid
  * @note      none
  */
-uint8_t w25qxx_individual_block_unlock(w25qxx_handle_t *handle, uint32_t addr)
+uint8_t w25qxx_individual_block_lock(w25qxx_handle_t *handle, uint32_t addr)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                          /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                /* lock */
+    res = a_w25qxx_individual_block_lock_unlocked(handle, addr); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);              /* unlock */
+    
+    return res;                                                  /* return the result */
+}
+
+/**
+ * @brief unlock the individual block
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_individual_block_unlock_unlocked(w25qxx_handle_t *handle, uint32_t addr)
 {
     uint8_t res;
     uint8_t buf[5];
@@ -6514,19 +8319,38 @@ uint8_t w25qxx_individual_block_unlock(w25qxx_handle_t *handle, uint32_t addr)
 }
 
 /**
- * @brief      read the block lock
- * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[in]  addr block address
- * @param[out] *value pointer to a value buffer
- * @return     status code
- *             - 0 success
- *             - 1 read block lock failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 address mode is invalid
- * @note       none
+ * @brief     unlock the individual block
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] addr block address
+ * @return    status code
+ *            - 0 success
+ *            - 1 individual block unlock failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 address mode is invalid
+ * @note      none
  */
-uint8_t w25qxx_read_block_lock(w25qxx_handle_t *handle, uint32_t addr, uint8_t *value)
+uint8_t w25qxx_individual_block_unlock(w25qxx_handle_t *handle, uint32_t addr)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                  /* lock */
+    res = a_w25qxx_individual_block_unlock_unlocked(handle, addr); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                /* unlock */
+    
+    return res;                                                    /* return the result */
+}
+
+/**
+ * @brief read the block lock
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_read_block_lock_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *value)
 {
     uint8_t res;
     uint8_t buf[5];
@@ -6732,18 +8556,40 @@ uint8_t w25qxx_read_block_lock(w25qxx_handle_t *handle, uint32_t addr, uint8_t *
 }
 
 /**
- * @brief     set the burst with wrap
- * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] wrap burst wrap
- * @return    status code
- *            - 0 success
- *            - 1 set burst with wrap failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 qspi can't use this function
- * @note      none
+ * @brief      read the block lock
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[in]  addr block address
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read block lock failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address mode is invalid
+ * @note       none
  */
-uint8_t w25qxx_set_burst_with_wrap(w25qxx_handle_t *handle, w25qxx_burst_wrap_t wrap)
+uint8_t w25qxx_read_block_lock(w25qxx_handle_t *handle, uint32_t addr, uint8_t *value)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                           /* check handle */
+    {
+        return 2;                                                 /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                            /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_read_block_lock_unlocked(handle, addr, value); /* run */
+    a_w25qxx_unlock(handle, type);                                /* unlock */
+    
+    return res;                                                   /* return the result */
+}
+
+/**
+ * @brief set the burst with wrap
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_set_burst_with_wrap_unlocked(w25qxx_handle_t *handle, w25qxx_burst_wrap_t wrap)
 {
     uint8_t res;
     uint8_t buf[5];
@@ -6801,6 +8647,34 @@ uint8_t w25qxx_set_burst_with_wrap(w25qxx_handle_t *handle, w25qxx_burst_wrap_t
     return 0;                                                                        /* success return 0 */
 }
 
+/**
+ * @brief     set the burst with wrap
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] wrap burst wrap
+ * @return    status code
+ *            - 0 success
+ *            - 1 set burst with wrap failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 qspi can't use this function
+ * @note      none
+ */
+uint8_t w25qxx_set_burst_with_wrap(w25qxx_handle_t *handle, w25qxx_burst_wrap_t wrap)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);              /* lock */
+    res = a_w25qxx_set_burst_with_wrap_unlocked(handle, wrap); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);            /* unlock */
+    
+    return res;                                                /* return the result */
+}
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to a w25qxx handle structure
@@ -7176,6 +9050,7 @@ uint8_t w25qxx_init(w25qxx_handle_t *handle)
         }
     }
     handle->address_mode = W25QXX_ADDRESS_MODE_3_BYTE;                                     /* set address mode */
+    memset(&handle->wa, 0, sizeof(w25qxx_write_amplification_t));                         /* clear write amplification */
     handle->inited = 1;                                                                    /* initialize inited */
     
     return 0;                                                                              /* success return 0 */
@@ -7205,7 +9080,7 @@ uint8_t w25qxx_deinit(w25qxx_handle_t *handle)
     {
         return 3;                                                                  /* return error */
     }
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                  /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                     /* enable dual quad spi */
@@ -7273,20 +9148,10 @@ uint8_t w25qxx_deinit(w25qxx_handle_t *handle)
 }
 
 /**
- * @brief      read data
- * @param[in]  *handle pointer to a w25qxx handle structure
- * @param[in]  addr read address
- * @param[out] *data pointer to a data buffer
- * @param[in]  len data length
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 address mode is invalid
- * @note       none
+ * @brief read data
+ * @note  the caller holds the handle lock
  */
-uint8_t w25qxx_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+static uint8_t a_w25qxx_read_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
 {
     uint8_t res;
     uint8_t buf[6];
@@ -7494,6 +9359,37 @@ uint8_t w25qxx_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint3
     return 0;                                                                                             /* success return 0 */
 }
 
+/**
+ * @brief      read data
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[in]  addr read address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 address mode is invalid
+ * @note       none
+ */
+uint8_t w25qxx_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    w25qxx_lock_t type;
+    
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    type = a_w25qxx_read_lock(handle);                     /* lock, exclusive when the extended address is used */
+    res = a_w25qxx_read_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, type);                         /* unlock */
+    
+    return res;                                            /* return the result */
+}
+
 /**
  * @brief      read data
  * @param[in]  *handle pointer to a w25qxx handle structure
@@ -7509,7 +9405,7 @@ static uint8_t a_w25qxx_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *da
 {
     uint8_t res;
     uint8_t buf[6];
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                         /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                                            /* enable dual quad spi */
@@ -7718,7 +9614,7 @@ static uint8_t a_w25qxx_erase_sector(w25qxx_handle_t *handle, uint32_t addr)
     uint8_t status;
     uint32_t timeout;
     uint8_t buf[5];
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                           /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                                              /* enable dual quad spi */
@@ -7795,6 +9691,10 @@ static uint8_t a_w25qxx_erase_sector(w25qxx_handle_t *handle, uint32_t addr)
                 return 1;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_SECTOR_4K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                                           /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -7889,6 +9789,10 @@ static uint8_t a_w25qxx_erase_sector(w25qxx_handle_t *handle, uint32_t addr)
                 return 1;                                                                                   /* return error */
             }
             
+            if (handle->erase_callback != NULL)                                                             /* check erase callback */
+            {
+                handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_SECTOR_4K, addr);             /* run erase callback */
+            }
             timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                                           /* set default timeout */
             while (timeout != 0)                                                                            /* check timeout */
             {
@@ -7989,6 +9893,10 @@ static uint8_t a_w25qxx_erase_sector(w25qxx_handle_t *handle, uint32_t addr)
             return 1;                                                                                       /* return error */
         }
         
+        if (handle->erase_callback != NULL)                                                                 /* check erase callback */
+        {
+            handle->erase_callback(handle->erase_param, W25QXX_ERASE_TYPE_SECTOR_4K, addr);                 /* run erase callback */
+        }
         timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                                               /* set default timeout */
         while (timeout != 0)                                                                                /* check timeout */
         {
@@ -8038,7 +9946,7 @@ static uint8_t a_w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uin
     uint8_t status;
     uint32_t timeout;
     uint8_t buf[2];
-
+    
     if (handle->spi_qspi == W25QXX_INTERFACE_SPI)                                                           /* spi interface */
     {
         if (handle->dual_quad_spi_enable != 0)                                                              /* enable dual quad spi */
@@ -8133,14 +10041,44 @@ static uint8_t a_w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uin
                 {
                     break;                                                                                  /* break */
                 }
-                timeout--;                                                                                  /* timeout-- */
-                handle->delay_us(10);                                                                       /* delay 10 us */
-            }
-            if (timeout == 0)
-            {
-                handle->debug_print("w25qxx: page program timeout.\n");                                     /* page program timeout */
-               
-                return 1;                                                                                   /* return error */
+                timeout--;                                                                                  /* timeout-- */
+                handle->delay_us(10);                                                                       /* delay 10 us */
+            }
+            if (timeout == 0)
+            {
+                handle->debug_print("w25qxx: page program timeout.\n");                                     /* page program timeout */
+               
+                return 1;                                                                                   /* return error */
+            }
+        }
+        else if (handle->spi_batch != NULL)                                                                 /* single spi batch */
+        {
+            res = a_w25qxx_spi_batch_write(handle, W25QXX_COMMAND_PAGE_PROGRAM, addr, W25QXX_BOOL_TRUE,
+                                           data, len, (uint8_t *)&status);                                  /* send the batch */
+            if (res != 0)                                                                                   /* check result */
+            {
+                return 1;                                                                                   /* return error */
+            }
+            
+            timeout = W25QXX_PAGE_PROGRAM_TIMEOUT_MS * 100;                                                 /* set default timeout */
+            while ((status & 0x01) != 0x00)                                                                 /* check status */
+            {
+                if (timeout == 0)                                                                           /* check timeout */
+                {
+                    handle->debug_print("w25qxx: page program timeout.\n");                                 /* page program timeout */
+                   
+                    return 1;                                                                               /* return error */
+                }
+                timeout--;                                                                                  /* timeout-- */
+                handle->delay_us(10);                                                                       /* delay 10 us */
+                buf[0] = W25QXX_COMMAND_READ_STATUS_REG1;                                                   /* read status1 command */
+                res = a_w25qxx_spi_write_read(handle, (uint8_t *)buf, 1, (uint8_t *)&status, 1);            /* spi write read */
+                if (res != 0)                                                                               /* check result */
+                {
+                    handle->debug_print("w25qxx: get status1 failed.\n");                                   /* get status1 failed */
+                   
+                    return 1;                                                                               /* return error */
+                }
             }
         }
         else                                                                                                /* single spi */
@@ -8340,172 +10278,738 @@ static uint8_t a_w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uin
             return 1;                                                                                       /* return error */
         }
     }
-    
-    return 0;                                                                                               /* success return 0 */
+    
+    return 0;                                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     write with no check
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] addr written address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_w25qxx_write_no_check(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint16_t page_remain;
+    
+    page_remain = 256 - addr % 256;                                         /* get remain */
+    if (len <= page_remain)                                                 /* check length */
+    {
+        page_remain = (uint16_t)len;                                        /* page remain */
+    }
+    while( 1)                                                               /* loop */
+    { 
+        res = a_w25qxx_page_program(handle, addr, data, page_remain);       /* page program */
+        if (res != 0)
+        {
+            handle->debug_print("w25qxx: page program failed.\n");          /* page program failed */
+           
+            return 1;                                                       /* return error */
+        }
+        handle->wa.page_program_count++;                                    /* page program count++ */
+        handle->wa.program_bytes += page_remain;                            /* add program bytes */
+        if (len == page_remain)                                             /* check length */
+        {
+            break;                                                          /* break loop */
+        }
+        else
+        {
+            data += page_remain;                                            /* data + page_remain */
+            addr += page_remain;                                            /* address + page_remain */
+            len -= page_remain;                                             /* length - page_remain */
+            if (len > 256)                                                  /* check length */
+            {
+                page_remain = 256;                                          /* set page remain */
+            }
+            else
+            {
+                page_remain = (uint16_t)len;                                /* set length */
+            }
+        }
+    }
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief write data
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_write_unlocked(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint32_t sec_pos;
+    uint32_t sec_off;
+    uint32_t sec_remain;
+    uint32_t i;
+    
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }   
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    
+    handle->wa.user_bytes += len;                                                              /* add user bytes */
+    sec_pos = addr / 4096;                                                                     /* get sector position */
+    sec_off = addr % 4096;                                                                     /* get sector offset */
+    sec_remain = 4096 - sec_off;                                                               /* get sector remain */
+    if (len <= sec_remain)                                                                     /* check length */
+    {
+        sec_remain = len;                                                                      /* set remain */
+    }
+    while(1)                                                                                   /* loop */
+    {    
+        res = a_w25qxx_read(handle, sec_pos * 4096, handle->buf_4k, 4096);                     /* read 4k data */
+        if (res != 0)
+        {
+            handle->debug_print("w25qxx: read failed.\n");                                     /* read failed */
+           
+            return 4;                                                                          /* return error */
+        }
+        handle->wa.read_bytes += 4096;                                                         /* add read bytes */
+        for (i = 0; i< sec_remain; i++)                                                        /* sec_remain length */
+        {
+            if (handle->buf_4k[sec_off + i] != 0xFF)                                           /* check 0xFF */
+            {
+                break;                                                                         /* break loop */
+            }
+        }
+        if (i < sec_remain)                                                                    /* not all is 0xFF */
+        {
+            res = a_w25qxx_erase_sector(handle, sec_pos * 4096);                               /* erase sector */
+            if (res != 0)
+            {
+                handle->debug_print("w25qxx: erase sector failed.\n");                         /* erase sector failed */
+               
+                return 5;                                                                      /* return error */
+            }
+            handle->wa.erase_bytes += 4096;                                                    /* add erase bytes */
+            handle->wa.rmw_erase_count++;                                                      /* rmw erase count++ */
+            for (i = 0; i<sec_remain; i++)                                                     /* sec_remain length */
+            {
+                handle->buf_4k[i + sec_off] = data[i];                                         /* copy data */
+            }
+            res = a_w25qxx_write_no_check(handle, sec_pos * 4096, handle->buf_4k, 4096);       /* write data no check */
+            if (res != 0)                                                                      /* check result */
+            {
+                handle->debug_print("w25qxx: write failed.\n");                                /* write failed */
+               
+                return 1;                                                                      /* return error */
+            }
+        }
+        else
+        {
+            res = a_w25qxx_write_no_check(handle, addr, data, sec_remain);                     /* write data */
+            if (res != 0)                                                                      /* check result */
+            {
+                handle->debug_print("w25qxx: write failed.\n");                                /* write failed */
+               
+                return 1;                                                                      /* return error */
+            }
+            handle->wa.blank_program_count++;                                                  /* blank program count++ */
+        }    
+        if (len == sec_remain)                                                                 /* check length length*/
+        {
+            break;                                                                             /* break loop */
+        }
+        else
+        {
+            sec_pos++;                                                                         /* sector++ */
+            sec_off = 0;                                                                       /* set offset */
+            data += sec_remain;                                                                /* data + remain */
+            addr += sec_remain;                                                                /* addr + remain */
+            len -= sec_remain;                                                                 /* len - remain */
+            if (len > 4096)                                                                    /* check length */
+            {
+                sec_remain = 4096;                                                             /* set 4096 */
+            }
+            else
+            {
+                sec_remain = len;                                                              /* set length */
+            }
+        }
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     write data
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] addr written address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 read failed
+ *            - 5 erase sector failed
+ * @note      none
+ */
+uint8_t w25qxx_write(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);           /* lock */
+    res = a_w25qxx_write_unlocked(handle, addr, data, len); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);         /* unlock */
+    
+    return res;                                             /* return the result */
+}
+
+/**
+ * @brief get the write amplification of w25qxx_write
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_get_write_amplification_unlocked(w25qxx_handle_t *handle, w25qxx_write_amplification_t *wa)
+{
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    memcpy(wa, &handle->wa, sizeof(w25qxx_write_amplification_t));                        /* copy counter */
+    if (wa->user_bytes != 0)                                                              /* check user bytes */
+    {
+        wa->read_ratio = (float)((double)wa->read_bytes / (double)wa->user_bytes);        /* get read ratio */
+        wa->erase_ratio = (float)((double)wa->erase_bytes / (double)wa->user_bytes);      /* get erase ratio */
+        wa->program_ratio = (float)((double)wa->program_bytes / (double)wa->user_bytes);  /* get program ratio */
+    }
+    else
+    {
+        wa->read_ratio = 0.0f;                                                            /* set 0.0 */
+        wa->erase_ratio = 0.0f;                                                           /* set 0.0 */
+        wa->program_ratio = 0.0f;                                                         /* set 0.0 */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the write amplification of w25qxx_write
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *wa pointer to a w25qxx write amplification structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       ratios are 0.0 before any byte is written
+ */
+uint8_t w25qxx_get_write_amplification(w25qxx_handle_t *handle, w25qxx_write_amplification_t *wa)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                          /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_SHARED);                   /* lock */
+    res = a_w25qxx_get_write_amplification_unlocked(handle, wa); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_SHARED);                 /* unlock */
+    
+    return res;                                                  /* return the result */
+}
+
+/**
+ * @brief clear the write amplification counter
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_clear_write_amplification_unlocked(w25qxx_handle_t *handle)
+{
+    if (handle == NULL)                                                          /* check handle */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    
+    memset(&handle->wa, 0, sizeof(w25qxx_write_amplification_t));               /* clear counter */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     clear the write amplification counter
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_clear_write_amplification(w25qxx_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);              /* lock */
+    res = a_w25qxx_clear_write_amplification_unlocked(handle); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);            /* unlock */
+    
+    return res;                                                /* return the result */
+}
+
+/**
+ * @brief     add one transaction to a cost
+ * @param[in] *cost pointer to a w25qxx cost structure
+ * @param[in] instruction_line instruction phy lines
+ * @param[in] address_line address phy lines
+ * @param[in] address_len address length
+ * @param[in] alternate_line alternate phy lines
+ * @param[in] alternate_len alternate length
+ * @param[in] dummy dummy cycles
+ * @param[in] data_line data phy lines
+ * @param[in] data_len data length
+ * @note      a phase with 0 lines is not sent
+ */
+static void a_w25qxx_cost_add(w25qxx_cost_t *cost, uint8_t instruction_line,
+                              uint8_t address_line, uint8_t address_len,
+                              uint8_t alternate_line, uint8_t alternate_len,
+                              uint8_t dummy, uint8_t data_line, uint32_t data_len)
+{
+    cost->transaction++;                                                                 /* transaction++ */
+    if (instruction_line != 0)                                                           /* check instruction */
+    {
+        cost->cycle += 8 / instruction_line;                                             /* add instruction cycles */
+    }
+    if (address_line != 0)                                                               /* check address */
+    {
+        cost->cycle += address_len * 8 / address_line;                                   /* add address cycles */
+    }
+    if (alternate_line != 0)                                                             /* check alternate */
+    {
+        cost->cycle += alternate_len * 8 / alternate_line;                               /* add alternate cycles */
+    }
+    cost->cycle += dummy;                                                                /* add dummy cycles */
+    if (data_line != 0)                                                                  /* check data */
+    {
+        cost->cycle += (uint64_t)data_len * 8 / data_line;                               /* add data cycles */
+    }
 }
 
 /**
- * @brief     write with no check
+ * @brief     add one addressed command to a cost
  * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] addr written address
- * @param[in] *data pointer to a data buffer
- * @param[in] len data length
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- * @note      none
+ * @param[in] *cost pointer to a w25qxx cost structure
+ * @param[in] write_enable bool value
+ * @param[in] address_line address phy lines
+ * @param[in] alternate_line alternate phy lines
+ * @param[in] dummy dummy cycles
+ * @param[in] data_line data phy lines
+ * @param[in] data_len data length
+ * @note      the instruction, the write enable and the extended address register
+ *            frames use 4 lines in qspi and 1 line in spi, as the driver sends them
  */
-static uint8_t a_w25qxx_write_no_check(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+static void a_w25qxx_cost_command(w25qxx_handle_t *handle, w25qxx_cost_t *cost, w25qxx_bool_t write_enable,
+                                  uint8_t address_line, uint8_t alternate_line, uint8_t dummy,
+                                  uint8_t data_line, uint32_t data_len)
 {
-    uint8_t res;
-    uint16_t page_remain;
+    uint8_t line;
+    uint8_t address_len;
     
-    page_remain = 256 - addr % 256;                                         /* get remain */
-    if (len <= page_remain)                                                 /* check length */
+    if (handle->spi_qspi == W25QXX_INTERFACE_QSPI)                                       /* qspi interface */
     {
-        page_remain = (uint16_t)len;                                        /* page remain */
+        line = 4;                                                                        /* 4 lines */
     }
-    while( 1)                                                               /* loop */
-    { 
-        res = a_w25qxx_page_program(handle, addr, data, page_remain);       /* page program */
-        if (res != 0)
-        {
-            handle->debug_print("w25qxx: page program failed.\n");          /* page program failed */
-           
-            return 1;                                                       /* return error */
-        }
-        if (len == page_remain)                                             /* check length */
+    else
+    {
+        line = 1;                                                                        /* 1 line */
+    }
+    address_len = 3;                                                                     /* 3 byte address */
+    if (handle->type >= W25Q256)                                                         /* >128Mb */
+    {
+        if (handle->address_mode == W25QXX_ADDRESS_MODE_3_BYTE)                          /* 3 address mode */
         {
-            break;                                                          /* break loop */
+            a_w25qxx_cost_add(cost, line, 0, 0, 0, 0, 0, 0, 0);                          /* write enable */
+            a_w25qxx_cost_add(cost, line, 0, 0, 0, 0, 0, line, 1);                       /* extended address register */
         }
         else
         {
-            data += page_remain;                                            /* data + page_remain */
-            addr += page_remain;                                            /* address + page_remain */
-            len -= page_remain;                                             /* length - page_remain */
-            if (len > 256)                                                  /* check length */
-            {
-                page_remain = 256;                                          /* set page remain */
-            }
-            else
-            {
-                page_remain = (uint16_t)len;                                /* set length */
-            }
+            address_len = 4;                                                             /* 4 byte address */
         }
     }
-    
-    return 0;                                                               /* success return 0 */
+    if (write_enable == W25QXX_BOOL_TRUE)                                                /* check write enable */
+    {
+        a_w25qxx_cost_add(cost, line, 0, 0, 0, 0, 0, 0, 0);                              /* write enable */
+    }
+    a_w25qxx_cost_add(cost, line, address_line, address_len,
+                      alternate_line, (alternate_line != 0) ? 1 : 0,
+                      dummy, data_line, data_len);                                       /* command */
 }
 
 /**
- * @brief     write data
+ * @brief     add one w25qxx_read to a cost
  * @param[in] *handle pointer to a w25qxx handle structure
- * @param[in] addr written address
- * @param[in] *data pointer to a data buffer
+ * @param[in] *cost pointer to a w25qxx cost structure
  * @param[in] len data length
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 read failed
- *            - 5 erase sector failed
+ * @note      w25qxx_read always sends fast read, with one line and one dummy byte in spi
+ *            whether dual_quad_spi_enable is set or not, and with four lines and the
+ *            configured dummy cycles in qspi
+ */
+static void a_w25qxx_cost_read(w25qxx_handle_t *handle, w25qxx_cost_t *cost, uint32_t len)
+{
+    if (handle->spi_qspi == W25QXX_INTERFACE_QSPI)                                       /* qspi interface */
+    {
+        a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_FALSE, 4, 0,
+                              handle->dummy, 4, len);                                    /* fast read */
+    }
+    else
+    {
+        a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_FALSE, 1, 0, 8, 1, len);         /* fast read */
+    }
+}
+
+/**
+ * @brief     add one program or erase command to a cost
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] *cost pointer to a w25qxx cost structure
+ * @param[in] data_len data length
  * @note      none
  */
-uint8_t w25qxx_write(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len)
+static void a_w25qxx_cost_write(w25qxx_handle_t *handle, w25qxx_cost_t *cost, uint32_t data_len)
 {
-    uint8_t res;
-    uint32_t sec_pos;
+    uint8_t line;
+    
+    if (handle->spi_qspi == W25QXX_INTERFACE_QSPI)                                       /* qspi interface */
+    {
+        line = 4;                                                                        /* 4 lines */
+    }
+    else
+    {
+        line = 1;                                                                        /* 1 line */
+    }
+    a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_TRUE, line, 0, 0,
+                          (data_len != 0) ? line : 0, data_len);                         /* command */
+}
+
+/**
+ * @brief      estimate the cost of an operation without touching the chip
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[in]  operation planned operation
+ * @param[in]  addr operation address
+ * @param[in]  len operation length
+ * @param[in]  clock_hz bus clock in hz
+ * @param[out] *cost pointer to a w25qxx cost structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 clock is invalid
+ *             - 5 operation is invalid
+ *             - 6 length is invalid
+ *             - 7 cost is NULL
+ * @note       the model sends the same frames, line widths and dummy cycles as the driver function of
+ *             the operation with the handle configuration, the status polls are counted apart in poll
+ *             and the per transaction gap of the host is not included
+ */
+uint8_t w25qxx_estimate_cost(w25qxx_handle_t *handle, w25qxx_operation_t operation,
+                             uint32_t addr, uint32_t len, uint32_t clock_hz, w25qxx_cost_t *cost)
+{
+    uint8_t line;
     uint32_t sec_off;
     uint32_t sec_remain;
+    uint32_t page_remain;
+    uint32_t size_mb;
     uint32_t i;
+    double busy_typ_us;
+    double busy_max_us;
     
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                              /* return error */
-    }   
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                                                                /* return error */
     }
-
-    sec_pos = addr / 4096;                                                                     /* get sector position */
-    sec_off = addr % 4096;                                                                     /* get sector offset */
-    sec_remain = 4096 - sec_off;                                                               /* get sector remain */
-    if (len <= sec_remain)                                                                     /* check length */
+    if (cost == NULL)                                                                            /* check cost */
     {
-        sec_remain = len;                                                                      /* set remain */
+        handle->debug_print("w25qxx: cost is null.\n");                                          /* cost is null */
+        
+        return 7;                                                                                /* return error */
     }
-    while(1)                                                                                   /* loop */
-    {    
-        res = a_w25qxx_read(handle, sec_pos * 4096, handle->buf_4k, 4096);                     /* read 4k data */
-        if (res != 0)
+    if (clock_hz == 0)                                                                           /* check clock */
+    {
+        handle->debug_print("w25qxx: clock is invalid.\n");                                      /* clock is invalid */
+        
+        return 4;                                                                                /* return error */
+    }
+    if ((operation == W25QXX_OPERATION_PAGE_PROGRAM) &&
+        ((len > 256) || (len == 0) || (((addr % 256) + len) > 256)))                             /* check length */
+    {
+        handle->debug_print("w25qxx: length is invalid.\n");                                     /* length is invalid */
+        
+        return 6;                                                                                /* return error */
+    }
+    
+    memset(cost, 0, sizeof(w25qxx_cost_t));                                                      /* clear cost */
+    busy_typ_us = 0.0;                                                                           /* init 0 */
+    busy_max_us = 0.0;                                                                           /* init 0 */
+    if (handle->spi_qspi == W25QXX_INTERFACE_QSPI)                                               /* qspi interface */
+    {
+        line = 4;                                                                                /* 4 lines */
+    }
+    else
+    {
+        line = 1;                                                                                /* 1 line */
+    }
+    switch (operation)
+    {
+        case W25QXX_OPERATION_READ :
         {
-            handle->debug_print("w25qxx: read failed.\n");                                     /* read failed */
-           
-            return 4;                                                                          /* return error */
+            a_w25qxx_cost_read(handle, cost, len);                                               /* fast read */
+            
+            break;
         }
-        for (i = 0; i< sec_remain; i++)                                                        /* sec_remain length */
+        case W25QXX_OPERATION_FAST_READ_DUAL_OUTPUT :
+        case W25QXX_OPERATION_FAST_READ_QUAD_OUTPUT :
+        case W25QXX_OPERATION_FAST_READ_DUAL_IO :
         {
-            if (handle->buf_4k[sec_off + i] != 0xFF)                                           /* check 0xFF */
+            if ((handle->spi_qspi != W25QXX_INTERFACE_SPI) ||
+                (handle->dual_quad_spi_enable == 0))                                             /* check interface */
             {
-                break;                                                                         /* break loop */
+                handle->debug_print("w25qxx: operation is invalid.\n");                          /* operation is invalid */
+                
+                return 5;                                                                        /* return error */
+            }
+            if (operation == W25QXX_OPERATION_FAST_READ_DUAL_OUTPUT)                             /* 1-1-2 */
+            {
+                a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_FALSE, 1, 0, 8, 2, len);         /* fast read dual output */
+            }
+            else if (operation == W25QXX_OPERATION_FAST_READ_QUAD_OUTPUT)                        /* 1-1-4 */
+            {
+                a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_FALSE, 1, 0, 8, 4, len);         /* fast read quad output */
+            }
+            else                                                                                 /* 1-2-2 */
+            {
+                a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_FALSE, 2, 2, 0, 2, len);         /* fast read dual io */
             }
+            
+            break;
         }
-        if (i < sec_remain)                                                                    /* not all is 0xFF */
+        case W25QXX_OPERATION_FAST_READ_QUAD_IO :
         {
-            res = a_w25qxx_erase_sector(handle, sec_pos * 4096);                               /* erase sector */
-            if (res != 0)
+            if ((handle->spi_qspi == W25QXX_INTERFACE_SPI) &&
+                (handle->dual_quad_spi_enable != 0))                                             /* 1-4-4 */
             {
-                handle->debug_print("w25qxx: erase sector failed.\n");                         /* erase sector failed */
-               
-                return 5;                                                                      /* return error */
+                a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_FALSE, 4, 4, 4, 4, len);         /* fast read quad io */
             }
-            for (i = 0; i<sec_remain; i++)                                                     /* sec_remain length */
+            else if (handle->spi_qspi == W25QXX_INTERFACE_QSPI)                                  /* 4-4-4 */
             {
-                handle->buf_4k[i + sec_off] = data[i];                                         /* copy data */
+                a_w25qxx_cost_command(handle, cost, W25QXX_BOOL_FALSE, 4, 4,
+                                      handle->dummy, 4, len);                                    /* fast read quad io */
             }
-            res = a_w25qxx_write_no_check(handle, sec_pos * 4096, handle->buf_4k, 4096);       /* write data no check */
-            if (res != 0)                                                                      /* check result */
+            else
             {
-                handle->debug_print("w25qxx: write failed.\n");                                /* write failed */
-               
-                return 1;                                                                      /* return error */
+                handle->debug_print("w25qxx: operation is invalid.\n");                          /* operation is invalid */
+                
+                return 5;                                                                        /* return error */
             }
+            
+            break;
         }
-        else
+        case W25QXX_OPERATION_PAGE_PROGRAM :
         {
-            res = a_w25qxx_write_no_check(handle, addr, data, sec_remain);                     /* write data */
-            if (res != 0)                                                                      /* check result */
+            a_w25qxx_cost_write(handle, cost, len);                                              /* page program */
+            busy_typ_us = W25QXX_PAGE_PROGRAM_TYPICAL_US;                                        /* typical time */
+            busy_max_us = W25QXX_PAGE_PROGRAM_TIMEOUT_MS * 1000.0;                               /* max time */
+            cost->poll = W25QXX_PAGE_PROGRAM_TYPICAL_US / 10 + 1;                                /* poll every 10us */
+            
+            break;
+        }
+        case W25QXX_OPERATION_WRITE :
+        case W25QXX_OPERATION_WRITE_BLANK :
+        {
+            sec_off = addr % 4096;                                                               /* get sector offset */
+            while (len != 0)                                                                     /* loop all sectors */
             {
-                handle->debug_print("w25qxx: write failed.\n");                                /* write failed */
-               
-                return 1;                                                                      /* return error */
+                sec_remain = 4096 - sec_off;                                                     /* get sector remain */
+                if (len < sec_remain)                                                            /* check length */
+                {
+                    sec_remain = len;                                                            /* set remain */
+                }
+                a_w25qxx_cost_read(handle, cost, 4096);                                          /* read 4k */
+                if (operation == W25QXX_OPERATION_WRITE)                                         /* read modify erase write */
+                {
+                    a_w25qxx_cost_write(handle, cost, 0);                                        /* sector erase */
+                    busy_typ_us += W25QXX_ERASE_4K_TYPICAL_MS * 1000.0;                          /* typical time */
+                    busy_max_us += W25QXX_ERASE_4K_TIMEOUT_MS * 1000.0;                          /* max time */
+                    cost->poll += W25QXX_ERASE_4K_TYPICAL_MS + 1;                                /* poll every 1ms */
+                    for (i = 0; i < 16; i++)                                                     /* 16 pages */
+                    {
+                        a_w25qxx_cost_write(handle, cost, 256);                                  /* page program */
+                        busy_typ_us += W25QXX_PAGE_PROGRAM_TYPICAL_US;                           /* typical time */
+                        busy_max_us += W25QXX_PAGE_PROGRAM_TIMEOUT_MS * 1000.0;                  /* max time */
+                        cost->poll += W25QXX_PAGE_PROGRAM_TYPICAL_US / 10 + 1;                   /* poll every 10us */
+                    }
+                }
+                else
+                {
+                    i = sec_remain;                                                              /* remain bytes */
+                    while (i != 0)                                                               /* loop all pages */
+                    {
+                        page_remain = 256 - (addr % 256);                                        /* get page remain */
+                        if (i < page_remain)                                                     /* check length */
+                        {
+                            page_remain = i;                                                     /* set remain */
+                        }
+                        a_w25qxx_cost_write(handle, cost, page_remain);                          /* page program */
+                        busy_typ_us += W25QXX_PAGE_PROGRAM_TYPICAL_US;                           /* typical time */
+                        busy_max_us += W25QXX_PAGE_PROGRAM_TIMEOUT_MS * 1000.0;                  /* max time */
+                        cost->poll += W25QXX_PAGE_PROGRAM_TYPICAL_US / 10 + 1;                   /* poll every 10us */
+                        addr += page_remain;                                                     /* next page */
+                        i -= page_remain;                                                        /* remain - page */
+                    }
+                }
+                len -= sec_remain;                                                               /* len - remain */
+                sec_off = 0;                                                                     /* next sector */
             }
-        }    
-        if (len == sec_remain)                                                                 /* check length length*/
+            
+            break;
+        }
+        case W25QXX_OPERATION_SECTOR_ERASE_4K :
         {
-            break;                                                                             /* break loop */
+            a_w25qxx_cost_write(handle, cost, 0);                                                /* sector erase */
+            busy_typ_us = W25QXX_ERASE_4K_TYPICAL_MS * 1000.0;                                   /* typical time */
+            busy_max_us = W25QXX_ERASE_4K_TIMEOUT_MS * 1000.0;                                   /* max time */
+            cost->poll = W25QXX_ERASE_4K_TYPICAL_MS + 1;                                         /* poll every 1ms */
+            
+            break;
         }
-        else
+        case W25QXX_OPERATION_BLOCK_ERASE_32K :
         {
-            sec_pos++;                                                                         /* sector++ */
-            sec_off = 0;                                                                       /* set offset */
-            data += sec_remain;                                                                /* data + remain */
-            addr += sec_remain;                                                                /* addr + remain */
-            len -= sec_remain;                                                                 /* len - remain */
-            if (len > 4096)                                                                    /* check length */
+            a_w25qxx_cost_write(handle, cost, 0);                                                /* block erase */
+            busy_typ_us = W25QXX_ERASE_32K_TYPICAL_MS * 1000.0;                                  /* typical time */
+            busy_max_us = W25QXX_ERASE_32K_TIMEOUT_MS * 1000.0;                                  /* max time */
+            cost->poll = W25QXX_ERASE_32K_TYPICAL_MS + 1;                                        /* poll every 1ms */
+            
+            break;
+        }
+        case W25QXX_OPERATION_BLOCK_ERASE_64K :
+        {
+            a_w25qxx_cost_write(handle, cost, 0);                                                /* block erase */
+            busy_typ_us = W25QXX_ERASE_64K_TYPICAL_MS * 1000.0;                                  /* typical time */
+            busy_max_us = W25QXX_ERASE_64K_TIMEOUT_MS * 1000.0;                                  /* max time */
+            cost->poll = W25QXX_ERASE_64K_TYPICAL_MS + 1;                                        /* poll every 1ms */
+            
+            break;
+        }
+        case W25QXX_OPERATION_CHIP_ERASE :
+        {
+            if (handle->type >= W25Q01)                                                          /* 1Gb and 2Gb */
             {
-                sec_remain = 4096;                                                             /* set 4096 */
+                size_mb = 128U << (handle->type - W25Q01);                                       /* get size */
+            }
+            else if (handle->type >= W25Q80)                                                     /* >= 8Mb */
+            {
+                size_mb = 1U << (handle->type - W25Q80);                                         /* get size */
             }
             else
             {
-                sec_remain = len;                                                              /* set length */
+                size_mb = 1;                                                                     /* round up to 1MB */
             }
+            a_w25qxx_cost_add(cost, line, 0, 0, 0, 0, 0, 0, 0);                                  /* write enable */
+            a_w25qxx_cost_add(cost, line, 0, 0, 0, 0, 0, 0, 0);                                  /* chip erase */
+            busy_typ_us = (double)size_mb * W25QXX_ERASE_CHIP_TYPICAL_MS_PER_MB * 1000.0;        /* typical time */
+            busy_max_us = (double)W25QXX_ERASE_CHIP_TIMEOUT_MS * 1000.0;                         /* max time */
+            cost->poll = size_mb * W25QXX_ERASE_CHIP_TYPICAL_MS_PER_MB + 1;                      /* poll every 1ms */
+            
+            break;
+        }
+        default :
+        {
+            handle->debug_print("w25qxx: operation is invalid.\n");                              /* operation is invalid */
+            
+            return 5;                                                                            /* return error */
         }
     }
+    cost->bus_time_us = (float)((double)cost->cycle * 1000000.0 / (double)clock_hz);             /* get bus time */
+    cost->busy_time_typical_us = (float)busy_typ_us;                                             /* set typical busy time */
+    cost->busy_time_max_us = (float)busy_max_us;                                                 /* set max busy time */
+    cost->total_time_typical_us = cost->bus_time_us + cost->busy_time_typical_us;                /* get typical total */
+    cost->total_time_max_us = cost->bus_time_us + cost->busy_time_max_us;                        /* get max total */
     
-    return 0;                                                                                  /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     set the erase callback
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] *callback pointer to an erase callback function, NULL to disable
+ * @param[in] *param pointer to a callback param
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the callback runs after every accepted sector, block or chip erase command
+ *            and while the chip is still busy, so it must not access the chip
+ */
+uint8_t w25qxx_set_erase_callback(w25qxx_handle_t *handle,
+                                  void (*callback)(void *param, w25qxx_erase_type_t type, uint32_t addr),
+                                  void *param)
+{
+    if (handle == NULL)                      /* check handle */
+    {
+        return 2;                            /* return error */
+    }
+    
+    handle->erase_callback = callback;       /* set erase callback */
+    handle->erase_param = param;             /* set erase param */
+    
+    return 0;                                /* success return 0 */
+}
+
+/**
+ * @brief write and read register
+ * @note  the caller holds the handle lock
+ */
+static uint8_t a_w25qxx_write_read_reg_unlocked(w25qxx_handle_t *handle, uint8_t instruction, uint8_t instruction_line,
+                                                uint32_t address, uint8_t address_line, uint8_t address_len,
+                                                uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                                uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                                uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    
+    if (handle == NULL)                                                          /* check handle */
+    {
+        return 2;                                                                /* return error */
+    }   
+    if (handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    
+    return a_w25qxx_qspi_write_read(handle, instruction, instruction_line,
+                                    address, address_line, address_len,
+                                    alternate, alternate_line, alternate_len,
+                                    dummy, in_buf, in_len,
+                                    out_buf, out_len, data_line);                /* write and read */
 }
 
 /**
@@ -8538,21 +11042,18 @@ uint8_t w25qxx_write_read_reg(w25qxx_handle_t *handle, uint8_t instruction, uint
                               uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
                               uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
 {
+    uint8_t res;
     
-    if (handle == NULL)                                                          /* check handle */
-    {
-        return 2;                                                                /* return error */
-    }   
-    if (handle->inited != 1)                                                     /* check handle initialization */
+    if (handle == NULL)                                                                                                                                                                                              /* check handle */
     {
-        return 3;                                                                /* return error */
+        return 2;                                                                                                                                                                                                    /* return error */
     }
     
-    return a_w25qxx_qspi_write_read(handle, instruction, instruction_line,
-                                    address, address_line, address_len,
-                                    alternate, alternate_line, alternate_len,
-                                    dummy, in_buf, in_len,
-                                    out_buf, out_len, data_line);                /* write and read */
+    a_w25qxx_lock(handle, W25QXX_LOCK_EXCLUSIVE);                                                                                                                                                                    /* lock */
+    res = a_w25qxx_write_read_reg_unlocked(handle, instruction, instruction_line, address, address_line, address_len, alternate, alternate_line, alternate_len, dummy, in_buf, in_len, out_buf, out_len, data_line); /* run */
+    a_w25qxx_unlock(handle, W25QXX_LOCK_EXCLUSIVE);                                                                                                                                                                  /* unlock */
+    
+    return res;                                                                                                                                                                                                      /* return the result */
 }
 
 /**
@@ -112,6 +112,41 @@ extern "C"{
     #define W25QXX_ERASE_64K_TIMEOUT_MS        (2000U)      /**< max 2000ms */
 #endif
 
+/**
+ * @brief w25qxx page program typical time definition
+ */
+#ifndef W25QXX_PAGE_PROGRAM_TYPICAL_US
+    #define W25QXX_PAGE_PROGRAM_TYPICAL_US        (400U)      /**< typical 0.4ms */
+#endif
+
+/**
+ * @brief w25qxx erase 4k typical time definition
+ */
+#ifndef W25QXX_ERASE_4K_TYPICAL_MS
+    #define W25QXX_ERASE_4K_TYPICAL_MS        (45U)      /**< typical 45ms */
+#endif
+
+/**
+ * @brief w25qxx erase 32k typical time definition
+ */
+#ifndef W25QXX_ERASE_32K_TYPICAL_MS
+    #define W25QXX_ERASE_32K_TYPICAL_MS        (120U)      /**< typical 120ms */
+#endif
+
+/**
+ * @brief w25qxx erase 64k typical time definition
+ */
+#ifndef W25QXX_ERASE_64K_TYPICAL_MS
+    #define W25QXX_ERASE_64K_TYPICAL_MS        (150U)      /**< typical 150ms */
+#endif
+
+/**
+ * @brief w25qxx erase chip typical time per MB definition
+ */
+#ifndef W25QXX_ERASE_CHIP_TYPICAL_MS_PER_MB
+    #define W25QXX_ERASE_CHIP_TYPICAL_MS_PER_MB        (2500U)      /**< typical 2.5s per MB */
+#endif
+
 /**
  * @brief w25qxx type enumeration definition
  */
@@ -265,6 +300,88 @@ typedef enum
  * @{
  */
 
+/**
+ * @brief w25qxx erase type enumeration definition
+ */
+typedef enum
+{
+    W25QXX_ERASE_TYPE_SECTOR_4K = 0x00,        /**< 4k sector erase */
+    W25QXX_ERASE_TYPE_BLOCK_32K = 0x01,        /**< 32k block erase */
+    W25QXX_ERASE_TYPE_BLOCK_64K = 0x02,        /**< 64k block erase */
+    W25QXX_ERASE_TYPE_CHIP      = 0x03,        /**< chip erase */
+} w25qxx_erase_type_t;
+
+/**
+ * @brief w25qxx write amplification structure definition
+ */
+typedef struct w25qxx_write_amplification_s
+{
+    uint64_t user_bytes;                 /**< user requested bytes */
+    uint64_t read_bytes;                 /**< bytes read back from the flash */
+    uint64_t erase_bytes;                /**< bytes erased */
+    uint64_t program_bytes;              /**< bytes programmed */
+    uint32_t blank_program_count;        /**< sectors written with the blank program path */
+    uint32_t rmw_erase_count;            /**< sectors written with the read modify erase write path */
+    uint32_t page_program_count;         /**< page program command count */
+    float read_ratio;                    /**< read bytes / user bytes */
+    float erase_ratio;                   /**< erase bytes / user bytes */
+    float program_ratio;                 /**< program bytes / user bytes */
+} w25qxx_write_amplification_t;
+
+/**
+ * @brief w25qxx operation enumeration definition
+ */
+typedef enum
+{
+    W25QXX_OPERATION_READ                  = 0x00,        /**< w25qxx_read */
+    W25QXX_OPERATION_PAGE_PROGRAM          = 0x01,        /**< w25qxx_page_program */
+    W25QXX_OPERATION_WRITE                 = 0x02,        /**< w25qxx_write on programmed data, read modify erase write */
+    W25QXX_OPERATION_WRITE_BLANK           = 0x03,        /**< w25qxx_write on erased data, blank program */
+    W25QXX_OPERATION_SECTOR_ERASE_4K       = 0x04,        /**< w25qxx_sector_erase_4k */
+    W25QXX_OPERATION_BLOCK_ERASE_32K       = 0x05,        /**< w25qxx_block_erase_32k */
+    W25QXX_OPERATION_BLOCK_ERASE_64K       = 0x06,        /**< w25qxx_block_erase_64k */
+    W25QXX_OPERATION_CHIP_ERASE            = 0x07,        /**< w25qxx_chip_erase */
+    W25QXX_OPERATION_FAST_READ_DUAL_OUTPUT = 0x08,        /**< w25qxx_fast_read_dual_output */
+    W25QXX_OPERATION_FAST_READ_QUAD_OUTPUT = 0x09,        /**< w25qxx_fast_read_quad_output */
+    W25QXX_OPERATION_FAST_READ_DUAL_IO     = 0x0A,        /**< w25qxx_fast_read_dual_io */
+    W25QXX_OPERATION_FAST_READ_QUAD_IO     = 0x0B,        /**< w25qxx_fast_read_quad_io */
+} w25qxx_operation_t;
+
+/**
+ * @brief w25qxx cost structure definition
+ */
+typedef struct w25qxx_cost_s
+{
+    uint32_t transaction;             /**< bus transactions without status polls */
+    uint32_t poll;                    /**< status polls expected with the typical busy time */
+    uint64_t cycle;                   /**< bus clock cycles without status polls */
+    float bus_time_us;                /**< bus time */
+    float busy_time_typical_us;       /**< typical chip busy time */
+    float busy_time_max_us;           /**< max chip busy time */
+    float total_time_typical_us;      /**< bus time + typical busy time */
+    float total_time_max_us;          /**< bus time + max busy time */
+} w25qxx_cost_t;
+
+/**
+ * @brief w25qxx lock enumeration definition
+ */
+typedef enum
+{
+    W25QXX_LOCK_SHARED    = 0x00,        /**< reader lock, may be held by several callers */
+    W25QXX_LOCK_EXCLUSIVE = 0x01,        /**< writer lock, held by one caller */
+} w25qxx_lock_t;
+
+/**
+ * @brief w25qxx spi transfer structure definition
+ */
+typedef struct w25qxx_spi_transfer_s
+{
+    uint8_t *in_buf;          /**< input buffer */
+    uint32_t in_len;          /**< input length */
+    uint8_t *out_buf;         /**< output buffer */
+    uint32_t out_len;         /**< output length */
+} w25qxx_spi_transfer_t;
+
 /**
  * @brief w25qxx handle structure definition
  */
@@ -289,6 +406,12 @@ typedef struct w25qxx_handle_s
     uint8_t spi_qspi;                                                                                  /**< spi qspi interface type */
     uint8_t buf[256 + 6];                                                                              /**< inner buffer */
     uint8_t buf_4k[4096 + 1];                                                                          /**< 4k inner buffer */
+    void (*erase_callback)(void *param, w25qxx_erase_type_t type, uint32_t addr);                      /**< point to an erase_callback function address */
+    void *erase_param;                                                                                 /**< erase callback param */
+    w25qxx_write_amplification_t wa;                                                                   /**< write amplification counter */
+    void (*lock)(w25qxx_lock_t type);                                                                  /**< point to a lock function address */
+    void (*unlock)(w25qxx_lock_t type);                                                                /**< point to an unlock function address */
+    uint8_t (*spi_batch)(w25qxx_spi_transfer_t *transfer, uint8_t num);                                /**< point to a spi_batch function address */
 } w25qxx_handle_t;
 
 /**
@@ -374,6 +497,35 @@ typedef struct w25qxx_info_s
  */
 #define DRIVER_W25QXX_LINK_DEBUG_PRINT(HANDLE, FUC)               (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link lock function
+ * @param[in] HANDLE pointer to a w25qxx handle structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      optional, reads take the shared lock and everything else that touches the chip
+ *            takes the exclusive lock, each spi_qspi_write_read call must be atomic on the bus,
+ *            a writer preferring lock keeps program and erase calls from starving behind readers
+ */
+#define DRIVER_W25QXX_LINK_LOCK(HANDLE, FUC)                      (HANDLE)->lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] HANDLE pointer to a w25qxx handle structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      optional, called with the same type as the matching lock
+ */
+#define DRIVER_W25QXX_LINK_UNLOCK(HANDLE, FUC)                    (HANDLE)->unlock = FUC
+
+/**
+ * @brief     link spi_batch function
+ * @param[in] HANDLE pointer to a w25qxx handle structure
+ * @param[in] FUC pointer to a spi_batch function address
+ * @note      optional, single spi only, every transfer is one chip select frame that writes
+ *            in_buf and then reads out_buf, the frames go out in order with the chip select
+ *            released between them, so a port can send them with one bus call, on a
+ *            w25qxx_bus shared bus the hook must call w25qxx_bus_batch to hold the bus lock
+ */
+#define DRIVER_W25QXX_LINK_SPI_BATCH(HANDLE, FUC)                 (HANDLE)->spi_batch = FUC
+
 /**
  * @}
  */
@@ -550,6 +702,67 @@ uint8_t w25qxx_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint3
  */
 uint8_t w25qxx_write(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint32_t len);
 
+/**
+ * @brief      get the write amplification of w25qxx_write
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *wa pointer to a w25qxx write amplification structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       ratios are 0.0 before any byte is written
+ */
+uint8_t w25qxx_get_write_amplification(w25qxx_handle_t *handle, w25qxx_write_amplification_t *wa);
+
+/**
+ * @brief     clear the write amplification counter
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_clear_write_amplification(w25qxx_handle_t *handle);
+
+/**
+ * @brief      estimate the cost of an operation without touching the chip
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[in]  operation planned operation
+ * @param[in]  addr operation address
+ * @param[in]  len operation length
+ * @param[in]  clock_hz bus clock in hz
+ * @param[out] *cost pointer to a w25qxx cost structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 clock is invalid
+ *             - 5 operation is invalid
+ *             - 6 length is invalid
+ *             - 7 cost is NULL
+ * @note       the model sends the same frames, line widths and dummy cycles as the driver function of
+ *             the operation with the handle configuration, the status polls are counted apart in poll
+ *             and the per transaction gap of the host is not included
+ */
+uint8_t w25qxx_estimate_cost(w25qxx_handle_t *handle, w25qxx_operation_t operation,
+                             uint32_t addr, uint32_t len, uint32_t clock_hz, w25qxx_cost_t *cost);
+
+/**
+ * @brief     set the erase callback
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] *callback pointer to an erase callback function, NULL to disable
+ * @param[in] *param pointer to a callback param
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the callback runs after every accepted sector, block or chip erase command
+ *            and while the chip is still busy, so it must not access the chip
+ */
+uint8_t w25qxx_set_erase_callback(w25qxx_handle_t *handle,
+                                  void (*callback)(void *param, w25qxx_erase_type_t type, uint32_t addr),
+                                  void *param);
+
 /**
  * @brief      read only in the spi interface
  * @param[in]  *handle pointer to a w25qxx handle structure
@@ -598,7 +811,7 @@ uint8_t w25qxx_fast_read(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data,
  *            - 5 address mode is invalid
  *            - 6 page program timeout
  *            - 7 length is over 256
- * @note      len <= 256
+ * @note      len <= 256, the data can start anywhere inside a page but must not cross the page end
  */
 uint8_t w25qxx_page_program(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len);
 
@@ -980,6 +1193,138 @@ uint8_t w25qxx_erase_program_suspend(w25qxx_handle_t *handle);
  */
 uint8_t w25qxx_erase_program_resume(w25qxx_handle_t *handle);
 
+/**
+ * @brief     start an erase without waiting for it
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] type erase type
+ * @param[in] addr erase address
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 6 type is invalid
+ * @note      poll w25qxx_get_busy until the chip is idle, only the status reads and
+ *            w25qxx_erase_program_suspend may be sent in between
+ */
+uint8_t w25qxx_erase_start(w25qxx_handle_t *handle, w25qxx_erase_type_t type, uint32_t addr);
+
+/**
+ * @brief     start a page program without waiting for it
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] addr program address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 page program start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 7 length is over 256
+ * @note      poll w25qxx_get_busy until the chip is idle
+ */
+uint8_t w25qxx_page_program_start(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len);
+
+/**
+ * @brief      get the busy and suspend status
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *busy pointer to a bool buffer
+ * @param[out] *suspended pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get busy failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       suspended may be NULL
+ */
+uint8_t w25qxx_get_busy(w25qxx_handle_t *handle, w25qxx_bool_t *busy, w25qxx_bool_t *suspended);
+
+/**
+ * @brief     start an erase and hold the handle until it is done
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] type erase type
+ * @param[in] addr erase address
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 6 type is invalid
+ * @note      on success the exclusive lock stays taken, poll w25qxx_get_busy_hold from
+ *            the same thread until it releases the lock, other users of the handle wait
+ *            instead of meeting a busy chip
+ */
+uint8_t w25qxx_erase_start_hold(w25qxx_handle_t *handle, w25qxx_erase_type_t type, uint32_t addr);
+
+/**
+ * @brief     start a page program and hold the handle until it is done
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @param[in] addr program address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 page program start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 address mode is invalid
+ *            - 7 length is over 256
+ * @note      on success the exclusive lock stays taken, poll w25qxx_get_busy_hold from
+ *            the same thread until it releases the lock
+ */
+uint8_t w25qxx_page_program_start_hold(w25qxx_handle_t *handle, uint32_t addr, uint8_t *data, uint16_t len);
+
+/**
+ * @brief      get the busy status of a held handle
+ * @param[in]  *handle pointer to a w25qxx handle structure
+ * @param[out] *busy pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get busy failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       only after a successful w25qxx_erase_start_hold or w25qxx_page_program_start_hold,
+ *             the lock is released once the chip is idle or the status read fails
+ */
+uint8_t w25qxx_get_busy_hold(w25qxx_handle_t *handle, w25qxx_bool_t *busy);
+
+/**
+ * @brief     release a held handle
+ * @param[in] *handle pointer to a w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      gives the handle up while the chip is still busy, e.g. after a timeout
+ */
+uint8_t w25qxx_release_hold(w25qxx_handle_t *handle);
+
+/**
+ * @brief      erase on several chips at the same time
+ * @param[in]  **handle pointer to an array of w25qxx handles
+ * @param[in]  count chip count
+ * @param[in]  type erase type
+ * @param[in]  *addr pointer to an erase address array, one per chip, may be NULL for the chip erase
+ * @param[out] *result pointer to a status array, one erase start status per chip or 1 on timeout
+ * @return     status code
+ *             - 0 success
+ *             - 1 an erase failed
+ *             - 2 handle is NULL
+ * @note       the erases are started back to back and the chips are polled together every
+ *             1 ms with the delay of a running chip, so the whole call takes about one erase
+ *             time instead of count times, a failed chip doesn't stop the others, every chip
+ *             holds its exclusive lock from the erase start until it is done, so the handles
+ *             must be different
+ */
+uint8_t w25qxx_erase_parallel(w25qxx_handle_t **handle, uint8_t count, w25qxx_erase_type_t type,
+                              const uint32_t *addr, uint8_t *result);
+
 /**
  * @brief      get the manufacturer && device id information with dual io
  * @param[in]  *handle pointer to a w25qxx handle structure
@@ -0,0 +1,687 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_async.c
+ * @brief     driver w25qxx async source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_async.h"
+
+/**
+ * @brief async step definition
+ */
+#define W25QXX_ASYNC_STATE_START          0        /**< start the next chunk, sector or erase */
+#define W25QXX_ASYNC_STATE_WAIT           1        /**< wait for the running erase or program */
+#define W25QXX_ASYNC_STATE_PROGRAM        2        /**< start the next page of the sector */
+
+/**
+ * @brief     lock the pending list
+ * @param[in] *async pointer to a w25qxx async structure
+ * @note      none
+ */
+static void a_w25qxx_async_lock(w25qxx_async_t *async)
+{
+    if (async->lock != NULL) /* check the hook */
+    {
+        async->lock();       /* lock */
+    }
+}
+
+/**
+ * @brief     unlock the pending list
+ * @param[in] *async pointer to a w25qxx async structure
+ * @note      none
+ */
+static void a_w25qxx_async_unlock(w25qxx_async_t *async)
+{
+    if (async->unlock != NULL) /* check the hook */
+    {
+        async->unlock();       /* unlock */
+    }
+}
+
+/**
+ * @brief     check the async context
+ * @param[in] *async pointer to a w25qxx async structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+static uint8_t a_w25qxx_async_check(w25qxx_async_t *async)
+{
+    if (async == NULL)      /* check handle */
+    {
+        return 2;           /* return error */
+    }
+    if (async->inited != 1) /* check handle initialization */
+    {
+        return 3;           /* return error */
+    }
+    
+    return 0;               /* success return 0 */
+}
+
+/**
+ * @brief     submit a request
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *req pointer to a w25qxx async request structure
+ * @param[in] op operation
+ * @param[in] addr flash address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *arg pointer to a user argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 request is invalid
+ * @note      none
+ */
+static uint8_t a_w25qxx_async_submit(w25qxx_async_t *async, w25qxx_async_req_t *req, w25qxx_async_op_t op,
+                                     uint32_t addr, uint8_t *data, uint32_t len,
+                                     void (*callback)(w25qxx_async_req_t *req, uint8_t res), void *arg)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_async_check(async);                                                    /* check handle */
+    if (res != 0)                                                                         /* check result */
+    {
+        return res;                                                                       /* return error */
+    }
+    if ((req == NULL) || (len == 0) || (len > (0xFFFFFFFFU - addr)) ||
+        ((op != W25QXX_ASYNC_OP_ERASE) && (data == NULL)) ||
+        ((op == W25QXX_ASYNC_OP_ERASE) && (((addr % 4096) != 0) || ((len % 4096) != 0)))) /* check request */
+    {
+        async->handle->debug_print("w25qxx: request is invalid.\n");                      /* request is invalid */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    req->op = op;                                                                         /* set operation */
+    req->addr = addr;                                                                     /* set address */
+    req->buf = data;                                                                      /* set buffer */
+    req->len = len;                                                                       /* set length */
+    req->callback = callback;                                                             /* set callback */
+    req->arg = arg;                                                                       /* set argument */
+    req->next = NULL;                                                                     /* last one */
+    a_w25qxx_async_lock(async);                                                           /* lock */
+    if (async->tail == NULL)                                                              /* empty list */
+    {
+        async->head = req;                                                                /* set head */
+    }
+    else
+    {
+        async->tail->next = req;                                                          /* append */
+    }
+    async->tail = req;                                                                    /* set tail */
+    async->stats.submit++;                                                                /* submit++ */
+    a_w25qxx_async_unlock(async);                                                         /* unlock */
+    if (async->notify != NULL)                                                            /* check notify */
+    {
+        async->notify();                                                                  /* wake the loop */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     read and merge the next sector of a write
+ * @param[in] *async pointer to a w25qxx async structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the sector is erased when a bit goes from 0 to 1, then the non blank
+ *            pages are programmed, else only the changed pages
+ */
+static uint8_t a_w25qxx_async_sector(w25qxx_async_t *async)
+{
+    uint32_t i;
+    uint32_t p;
+    uint32_t off;
+    uint32_t base;
+    uint8_t *data;
+    w25qxx_async_req_t *req;
+    
+    req = async->active;                                                           /* get request */
+    data = &req->buf[async->pos];                                                  /* new data */
+    off = (req->addr + async->pos) % 4096;                                         /* sector offset */
+    base = req->addr + async->pos - off;                                           /* sector address */
+    async->seg = 4096 - off;                                                       /* sector remain */
+    if (async->seg > (req->len - async->pos))                                      /* check length */
+    {
+        async->seg = req->len - async->pos;                                        /* set length */
+    }
+    if (w25qxx_read(async->handle, base, async->buf, 4096) != 0)                   /* read the sector */
+    {
+        return 1;                                                                  /* return error */
+    }
+    
+    async->erased = 0;                                                             /* no erase */
+    async->mask = 0;                                                               /* no page */
+    for (i = 0; i < async->seg; i++)                                               /* check the bits */
+    {
+        if ((async->buf[off + i] & data[i]) != data[i])                            /* 0 to 1 */
+        {
+            async->erased = 1;                                                     /* need erase */
+            
+            break;                                                                 /* break */
+        }
+        if (async->buf[off + i] != data[i])                                        /* changed */
+        {
+            async->mask |= (uint16_t)(1U << ((off + i) / 256));                    /* program the page */
+        }
+    }
+    memcpy(&async->buf[off], data, async->seg);                                    /* merge */
+    if (async->erased == 0)                                                        /* no erase */
+    {
+        async->state = W25QXX_ASYNC_STATE_PROGRAM;                                 /* program */
+        
+        return 0;                                                                  /* success return 0 */
+    }
+    
+    async->mask = 0;                                                               /* rebuild */
+    for (p = 0; p < 16; p++)                                                       /* loop all pages */
+    {
+        for (i = 0; i < 256; i++)                                                  /* find data */
+        {
+            if (async->buf[p * 256 + i] != 0xFF)                                   /* check data */
+            {
+                async->mask |= (uint16_t)(1U << p);                                /* program the page */
+                
+                break;                                                             /* break */
+            }
+        }
+    }
+    if (w25qxx_erase_start_hold(async->handle, W25QXX_ERASE_TYPE_SECTOR_4K,
+                                base) != 0)                                        /* start the erase */
+    {
+        return 1;                                                                  /* return error */
+    }
+    a_w25qxx_async_lock(async);                                                    /* lock */
+    async->stats.erase++;                                                          /* erase++ */
+    a_w25qxx_async_unlock(async);                                                  /* unlock */
+    async->timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                   /* set timeout */
+    async->wait_us = 1000;                                                         /* poll every 1 ms */
+    async->state = W25QXX_ASYNC_STATE_WAIT;                                        /* wait */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      start the next page of a sector
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[out] *done pointer to a request done flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write failed
+ * @note       none
+ */
+static uint8_t a_w25qxx_async_program(w25qxx_async_t *async, uint8_t *done)
+{
+    uint32_t p;
+    uint32_t base;
+    w25qxx_async_req_t *req;
+    
+    req = async->active;                                                 /* get request */
+    if (async->mask == 0)                                                /* sector done */
+    {
+        async->pos += async->seg;                                        /* next sector */
+        async->state = W25QXX_ASYNC_STATE_START;                         /* start */
+        *done = (uint8_t)(async->pos == req->len);                       /* check done */
+        
+        return 0;                                                        /* success return 0 */
+    }
+    
+    p = 0;                                                               /* first page */
+    while ((async->mask & (1U << p)) == 0)                               /* find the page */
+    {
+        p++;                                                             /* next page */
+    }
+    base = (req->addr + async->pos) - ((req->addr + async->pos) % 4096); /* sector address */
+    if (w25qxx_page_program_start_hold(async->handle, base + p * 256,
+                                       &async->buf[p * 256], 256) != 0)  /* start the program */
+    {
+        return 1;                                                        /* return error */
+    }
+    async->mask &= (uint16_t)(~(1U << p));                               /* page done */
+    a_w25qxx_async_lock(async);                                          /* lock */
+    async->stats.page_program++;                                         /* page program++ */
+    a_w25qxx_async_unlock(async);                                        /* unlock */
+    async->timeout = W25QXX_PAGE_PROGRAM_TIMEOUT_MS * 100;               /* set timeout */
+    async->wait_us = 10;                                                 /* poll every 10 us */
+    async->state = W25QXX_ASYNC_STATE_WAIT;                              /* wait */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      run one step of the active request
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[out] *done pointer to a request done flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 step failed
+ * @note       a busy chip is polled once and left alone, the handle stays held from an
+ *             erase or program start until the poll sees the chip idle
+ */
+static uint8_t a_w25qxx_async_step(w25qxx_async_t *async, uint8_t *done)
+{
+    uint32_t n;
+    w25qxx_bool_t busy;
+    w25qxx_erase_type_t type;
+    w25qxx_async_req_t *req;
+    
+    *done = 0;                                                                               /* not done */
+    req = async->active;                                                                     /* get request */
+    if (async->state == W25QXX_ASYNC_STATE_WAIT)                                             /* running operation */
+    {
+        if (w25qxx_get_busy_hold(async->handle, &busy) != 0)                                 /* get busy */
+        {
+            return 1;                                                                        /* return error */
+        }
+        a_w25qxx_async_lock(async);                                                          /* lock */
+        async->stats.poll++;                                                                 /* poll++ */
+        a_w25qxx_async_unlock(async);                                                        /* unlock */
+        if (busy != W25QXX_BOOL_FALSE)                                                       /* still busy */
+        {
+            if (async->timeout == 0)                                                         /* check timeout */
+            {
+                async->handle->debug_print("w25qxx: async timeout.\n");                      /* async timeout */
+                (void)w25qxx_release_hold(async->handle);                                    /* give the handle up */
+                
+                return 1;                                                                    /* return error */
+            }
+            async->timeout--;                                                                /* timeout-- */
+            
+            return 0;                                                                        /* success return 0 */
+        }
+        if (req->op == W25QXX_ASYNC_OP_ERASE)                                                /* erase done */
+        {
+            async->pos += async->seg;                                                        /* next erase */
+            async->state = W25QXX_ASYNC_STATE_START;                                         /* start */
+        }
+        else
+        {
+            async->state = W25QXX_ASYNC_STATE_PROGRAM;                                       /* next page */
+        }
+    }
+    
+    if (req->op == W25QXX_ASYNC_OP_READ)                                                     /* read */
+    {
+        n = req->len - async->pos;                                                           /* remain */
+        if (n > W25QXX_ASYNC_READ_CHUNK)                                                     /* check length */
+        {
+            n = W25QXX_ASYNC_READ_CHUNK;                                                     /* one chunk */
+        }
+        if (w25qxx_read(async->handle, req->addr + async->pos,
+                        &req->buf[async->pos], n) != 0)                                      /* read */
+        {
+            return 1;                                                                        /* return error */
+        }
+        async->pos += n;                                                                     /* next chunk */
+        *done = (uint8_t)(async->pos == req->len);                                           /* check done */
+        
+        return 0;                                                                            /* success return 0 */
+    }
+    else if (req->op == W25QXX_ASYNC_OP_ERASE)                                               /* erase */
+    {
+        if (async->pos == req->len)                                                          /* all erased */
+        {
+            *done = 1;                                                                       /* done */
+            
+            return 0;                                                                        /* success return 0 */
+        }
+        if ((((req->addr + async->pos) % 65536) == 0) && ((req->len - async->pos) >= 65536)) /* aligned 64k */
+        {
+            type = W25QXX_ERASE_TYPE_BLOCK_64K;                                              /* 64k block */
+            async->seg = 65536;                                                              /* 64k */
+            async->timeout = W25QXX_ERASE_64K_TIMEOUT_MS;                                    /* set timeout */
+        }
+        else
+        {
+            type = W25QXX_ERASE_TYPE_SECTOR_4K;                                              /* 4k sector */
+            async->seg = 4096;                                                               /* 4k */
+            async->timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                     /* set timeout */
+        }
+        if (w25qxx_erase_start_hold(async->handle, type, req->addr + async->pos) != 0)       /* start the erase */
+        {
+            return 1;                                                                        /* return error */
+        }
+        a_w25qxx_async_lock(async);                                                          /* lock */
+        async->stats.erase++;                                                                /* erase++ */
+        a_w25qxx_async_unlock(async);                                                        /* unlock */
+        async->wait_us = 1000;                                                               /* poll every 1 ms */
+        async->state = W25QXX_ASYNC_STATE_WAIT;                                              /* wait */
+        
+        return 0;                                                                            /* success return 0 */
+    }
+    else
+    {
+        if (async->state == W25QXX_ASYNC_STATE_START)                                        /* next sector */
+        {
+            if (a_w25qxx_async_sector(async) != 0)                                           /* read and merge */
+            {
+                return 1;                                                                    /* return error */
+            }
+            if (async->state == W25QXX_ASYNC_STATE_WAIT)                                     /* erasing */
+            {
+                return 0;                                                                    /* success return 0 */
+            }
+        }
+        
+        return a_w25qxx_async_program(async, done);                                          /* next page */
+    }
+}
+
+/**
+ * @brief     initialize the async context
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      an erase or a program holds the exclusive handle lock from its start until
+ *            the chip is idle, so other users of the handle wait instead of meeting a busy
+ *            chip, that needs the handle lock hooks, without them nothing else may use the
+ *            handle while requests are pending, w25qxx_process runs in one thread only
+ */
+uint8_t w25qxx_async_init(w25qxx_async_t *async, w25qxx_handle_t *handle)
+{
+    if ((async == NULL) || (handle == NULL))  /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    if (handle->inited != 1)                  /* check handle initialization */
+    {
+        return 3;                             /* return error */
+    }
+    
+    memset(async, 0, sizeof(w25qxx_async_t)); /* clear async */
+    async->handle = handle;                   /* set handle */
+    async->inited = 1;                        /* set inited */
+    
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief     deinit the async context
+ * @param[in] *async pointer to a w25qxx async structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 requests are pending
+ * @note      none
+ */
+uint8_t w25qxx_async_deinit(w25qxx_async_t *async)
+{
+    uint8_t res;
+    uint8_t pending;
+    
+    res = a_w25qxx_async_check(async);                                     /* check handle */
+    if (res != 0)                                                          /* check result */
+    {
+        return res;                                                        /* return error */
+    }
+    
+    a_w25qxx_async_lock(async);                                            /* lock */
+    pending = (uint8_t)((async->head != NULL) || (async->active != NULL)); /* check pending */
+    a_w25qxx_async_unlock(async);                                          /* unlock */
+    if (pending != 0)                                                      /* check pending */
+    {
+        async->handle->debug_print("w25qxx: requests are pending.\n");     /* requests are pending */
+        
+        return 4;                                                          /* return error */
+    }
+    
+    async->inited = 0;                                                     /* clear inited */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the thread hooks
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @param[in] *notify pointer to a notify function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      lock and unlock guard the pending list only, notify is called after
+ *            every submit, e.g. to write an eventfd watched by the event loop
+ */
+uint8_t w25qxx_async_set_hooks(w25qxx_async_t *async, void (*lock)(void), void (*unlock)(void),
+                               void (*notify)(void))
+{
+    uint8_t res;
+    
+    res = a_w25qxx_async_check(async); /* check handle */
+    if (res != 0)                      /* check result */
+    {
+        return res;                    /* return error */
+    }
+    
+    async->lock = lock;                /* set lock */
+    async->unlock = unlock;            /* set unlock */
+    async->notify = notify;            /* set notify */
+    
+    return 0;                          /* success return 0 */
+}
+
+/**
+ * @brief      read data without blocking
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[in]  *req pointer to a w25qxx async request structure
+ * @param[in]  addr read address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[in]  *callback pointer to a completion callback, may be NULL
+ * @param[in]  *arg pointer to a user argument
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 request is invalid
+ * @note       the request and the buffer belong to the context until the callback runs
+ */
+uint8_t w25qxx_read_async(w25qxx_async_t *async, w25qxx_async_req_t *req, uint32_t addr, uint8_t *data, uint32_t len,
+                          void (*callback)(w25qxx_async_req_t *req, uint8_t res), void *arg)
+{
+    return a_w25qxx_async_submit(async, req, W25QXX_ASYNC_OP_READ, addr, data, len, callback, arg); /* submit */
+}
+
+/**
+ * @brief     write data without blocking
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *req pointer to a w25qxx async request structure
+ * @param[in] addr write address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] *callback pointer to a completion callback, may be NULL
+ * @param[in] *arg pointer to a user argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 request is invalid
+ * @note      like w25qxx_write the surrounding data is kept, a sector is erased only
+ *            when a bit goes from 0 to 1 and unchanged pages are not programmed
+ */
+uint8_t w25qxx_write_async(w25qxx_async_t *async, w25qxx_async_req_t *req, uint32_t addr, uint8_t *data, uint32_t len,
+                           void (*callback)(w25qxx_async_req_t *req, uint8_t res), void *arg)
+{
+    return a_w25qxx_async_submit(async, req, W25QXX_ASYNC_OP_WRITE, addr, data, len, callback, arg); /* submit */
+}
+
+/**
+ * @brief     erase without blocking
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *req pointer to a w25qxx async request structure
+ * @param[in] addr erase address
+ * @param[in] len erase length
+ * @param[in] *callback pointer to a completion callback, may be NULL
+ * @param[in] *arg pointer to a user argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 request is invalid
+ * @note      addr and len are 4k aligned, aligned 64k runs use block erases
+ */
+uint8_t w25qxx_erase_async(w25qxx_async_t *async, w25qxx_async_req_t *req, uint32_t addr, uint32_t len,
+                           void (*callback)(w25qxx_async_req_t *req, uint8_t res), void *arg)
+{
+    return a_w25qxx_async_submit(async, req, W25QXX_ASYNC_OP_ERASE, addr, NULL, len, callback, arg); /* submit */
+}
+
+/**
+ * @brief      run one pump step
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[out] *pending pointer to a pending request number buffer
+ * @param[out] *wait_us pointer to a wait time buffer, may be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 pending is NULL
+ * @note       a step polls the running erase or program once and starts the next one,
+ *             or reads one chunk, it never calls the delay hooks, wait_us is 0 when the
+ *             next step can run at once, else the time to wait before it, timeouts count
+ *             the polls of a loop that waits that long, failed requests get their error
+ *             in the callback, which may submit new requests
+ */
+uint8_t w25qxx_process(w25qxx_async_t *async, uint32_t *pending, uint32_t *wait_us)
+{
+    uint8_t res;
+    uint8_t done;
+    w25qxx_async_req_t *r;
+    
+    res = a_w25qxx_async_check(async);                                            /* check handle */
+    if (res != 0)                                                                 /* check result */
+    {
+        return res;                                                               /* return error */
+    }
+    if (pending == NULL)                                                          /* check pending */
+    {
+        async->handle->debug_print("w25qxx: pending is NULL.\n");                 /* pending is NULL */
+        
+        return 4;                                                                 /* return error */
+    }
+    
+    if (async->active == NULL)                                                    /* nothing running */
+    {
+        a_w25qxx_async_lock(async);                                               /* lock */
+        async->active = async->head;                                              /* take the first one */
+        if (async->head != NULL)                                                  /* check head */
+        {
+            async->head = async->head->next;                                      /* remove */
+            if (async->head == NULL)                                              /* empty list */
+            {
+                async->tail = NULL;                                               /* clear tail */
+            }
+        }
+        a_w25qxx_async_unlock(async);                                             /* unlock */
+        async->pos = 0;                                                           /* from the start */
+        async->state = W25QXX_ASYNC_STATE_START;                                  /* start */
+    }
+    if (async->active != NULL)                                                    /* run a step */
+    {
+        a_w25qxx_async_lock(async);                                               /* lock */
+        async->stats.step++;                                                      /* step++ */
+        a_w25qxx_async_unlock(async);                                             /* unlock */
+        res = a_w25qxx_async_step(async, &done);                                  /* step */
+        if ((res != 0) || (done != 0))                                            /* finished */
+        {
+            r = async->active;                                                    /* save request */
+            async->active = NULL;                                                 /* nothing running */
+            r->next = NULL;                                                       /* detach */
+            a_w25qxx_async_lock(async);                                           /* lock */
+            async->stats.complete++;                                              /* complete++ */
+            a_w25qxx_async_unlock(async);                                         /* unlock */
+            if (r->callback != NULL)                                              /* check callback */
+            {
+                r->callback(r, res);                                              /* run callback */
+            }
+        }
+    }
+    
+    *pending = (async->active != NULL) ? 1 : 0;                                   /* running one */
+    a_w25qxx_async_lock(async);                                                   /* lock */
+    for (r = async->head; r != NULL; r = r->next)                                 /* loop the list */
+    {
+        (*pending)++;                                                             /* pending++ */
+    }
+    a_w25qxx_async_unlock(async);                                                 /* unlock */
+    if (wait_us != NULL)                                                          /* check wait */
+    {
+        *wait_us = 0;                                                             /* run at once */
+        if ((async->active != NULL) && (async->state == W25QXX_ASYNC_STATE_WAIT)) /* chip busy */
+        {
+            *wait_us = async->wait_us;                                            /* poll interval */
+        }
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[out] *stats pointer to a w25qxx async stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_async_get_stats(w25qxx_async_t *async, w25qxx_async_stats_t *stats)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_async_check(async); /* check handle */
+    if (res != 0)                      /* check result */
+    {
+        return res;                    /* return error */
+    }
+    
+    a_w25qxx_async_lock(async);        /* lock */
+    *stats = async->stats;             /* copy stats */
+    a_w25qxx_async_unlock(async);      /* unlock */
+    
+    return 0;                          /* success return 0 */
+}
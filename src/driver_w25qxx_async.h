@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_async.h
+ * @brief     driver w25qxx async header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_ASYNC_H
+#define DRIVER_W25QXX_ASYNC_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_async_driver w25qxx async driver function
+ * @brief    w25qxx callback based non-blocking modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx async read chunk definition
+ */
+#ifndef W25QXX_ASYNC_READ_CHUNK
+    #define W25QXX_ASYNC_READ_CHUNK        4096        /**< bytes read by one step */
+#endif
+
+/**
+ * @brief w25qxx async operation enumeration definition
+ */
+typedef enum
+{
+    W25QXX_ASYNC_OP_READ  = 0x00,        /**< read len bytes into buf */
+    W25QXX_ASYNC_OP_WRITE = 0x01,        /**< write len bytes from buf keeping the surrounding data */
+    W25QXX_ASYNC_OP_ERASE = 0x02,        /**< erase len bytes at addr */
+} w25qxx_async_op_t;
+
+/**
+ * @brief w25qxx async request structure definition
+ */
+typedef struct w25qxx_async_req_s
+{
+    w25qxx_async_op_t op;                                                /**< operation */
+    uint32_t addr;                                                       /**< flash address */
+    uint8_t *buf;                                                        /**< data buffer */
+    uint32_t len;                                                        /**< data length */
+    void (*callback)(struct w25qxx_async_req_s *req, uint8_t res);       /**< completion callback */
+    void *arg;                                                           /**< user argument */
+    struct w25qxx_async_req_s *next;                                     /**< next request */
+} w25qxx_async_req_t;
+
+/**
+ * @brief w25qxx async stats structure definition
+ */
+typedef struct w25qxx_async_stats_s
+{
+    uint32_t submit;              /**< submitted requests */
+    uint32_t complete;            /**< completed requests */
+    uint32_t step;                /**< pump steps */
+    uint32_t poll;                /**< busy polls */
+    uint32_t erase;               /**< erases started */
+    uint32_t page_program;        /**< page programs started */
+} w25qxx_async_stats_t;
+
+/**
+ * @brief w25qxx async structure definition
+ */
+typedef struct w25qxx_async_s
+{
+    w25qxx_handle_t *handle;                     /**< w25qxx handle */
+    w25qxx_async_req_t *head;                    /**< pending list */
+    w25qxx_async_req_t *tail;                    /**< list tail */
+    w25qxx_async_req_t *active;                  /**< running request */
+    uint8_t state;                               /**< step of the running request */
+    uint8_t erased;                              /**< sector erased flag */
+    uint16_t mask;                               /**< pages left to program in the sector */
+    uint32_t pos;                                /**< finished bytes of the running request */
+    uint32_t seg;                                /**< bytes of the running sector or erase */
+    uint32_t timeout;                            /**< polls left */
+    uint32_t wait_us;                            /**< poll interval of the running operation */
+    void (*lock)(void);                          /**< list lock hook */
+    void (*unlock)(void);                        /**< list unlock hook */
+    void (*notify)(void);                        /**< submit notify hook */
+    w25qxx_async_stats_t stats;                  /**< statistics */
+    uint8_t buf[4096];                           /**< sector buffer */
+    uint8_t inited;                              /**< inited flag */
+} w25qxx_async_t;
+
+/**
+ * @brief     initialize the async context
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      an erase or a program holds the exclusive handle lock from its start until
+ *            the chip is idle, so other users of the handle wait instead of meeting a busy
+ *            chip, that needs the handle lock hooks, without them nothing else may use the
+ *            handle while requests are pending, w25qxx_process runs in one thread only
+ */
+uint8_t w25qxx_async_init(w25qxx_async_t *async, w25qxx_handle_t *handle);
+
+/**
+ * @brief     deinit the async context
+ * @param[in] *async pointer to a w25qxx async structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 requests are pending
+ * @note      none
+ */
+uint8_t w25qxx_async_deinit(w25qxx_async_t *async);
+
+/**
+ * @brief     set the thread hooks
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @param[in] *notify pointer to a notify function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      lock and unlock guard the pending list only, notify is called after
+ *            every submit, e.g. to write an eventfd watched by the event loop
+ */
+uint8_t w25qxx_async_set_hooks(w25qxx_async_t *async, void (*lock)(void), void (*unlock)(void),
+                               void (*notify)(void));
+
+/**
+ * @brief      read data without blocking
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[in]  *req pointer to a w25qxx async request structure
+ * @param[in]  addr read address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[in]  *callback pointer to a completion callback, may be NULL
+ * @param[in]  *arg pointer to a user argument
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 request is invalid
+ * @note       the request and the buffer belong to the context until the callback runs
+ */
+uint8_t w25qxx_read_async(w25qxx_async_t *async, w25qxx_async_req_t *req, uint32_t addr, uint8_t *data, uint32_t len,
+                          void (*callback)(w25qxx_async_req_t *req, uint8_t res), void *arg);
+
+/**
+ * @brief     write data without blocking
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *req pointer to a w25qxx async request structure
+ * @param[in] addr write address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] *callback pointer to a completion callback, may be NULL
+ * @param[in] *arg pointer to a user argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 request is invalid
+ * @note      like w25qxx_write the surrounding data is kept, a sector is erased only
+ *            when a bit goes from 0 to 1 and unchanged pages are not programmed
+ */
+uint8_t w25qxx_write_async(w25qxx_async_t *async, w25qxx_async_req_t *req, uint32_t addr, uint8_t *data, uint32_t len,
+                           void (*callback)(w25qxx_async_req_t *req, uint8_t res), void *arg);
+
+/**
+ * @brief     erase without blocking
+ * @param[in] *async pointer to a w25qxx async structure
+ * @param[in] *req pointer to a w25qxx async request structure
+ * @param[in] addr erase address
+ * @param[in] len erase length
+ * @param[in] *callback pointer to a completion callback, may be NULL
+ * @param[in] *arg pointer to a user argument
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 request is invalid
+ * @note      addr and len are 4k aligned, aligned 64k runs use block erases
+ */
+uint8_t w25qxx_erase_async(w25qxx_async_t *async, w25qxx_async_req_t *req, uint32_t addr, uint32_t len,
+                           void (*callback)(w25qxx_async_req_t *req, uint8_t res), void *arg);
+
+/**
+ * @brief      run one pump step
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[out] *pending pointer to a pending request number buffer
+ * @param[out] *wait_us pointer to a wait time buffer, may be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 pending is NULL
+ * @note       a step polls the running erase or program once and starts the next one,
+ *             or reads one chunk, it never calls the delay hooks, wait_us is 0 when the
+ *             next step can run at once, else the time to wait before it, timeouts count
+ *             the polls of a loop that waits that long, failed requests get their error
+ *             in the callback, which may submit new requests
+ */
+uint8_t w25qxx_process(w25qxx_async_t *async, uint32_t *pending, uint32_t *wait_us);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *async pointer to a w25qxx async structure
+ * @param[out] *stats pointer to a w25qxx async stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_async_get_stats(w25qxx_async_t *async, w25qxx_async_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
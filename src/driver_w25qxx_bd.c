@@ -0,0 +1,561 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_bd.c
+ * @brief     driver w25qxx block device source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_bd.h"
+
+/**
+ * @brief     check whether a block is known erased
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] block block index
+ * @return    1 if erased, else 0
+ * @note      none
+ */
+static uint8_t a_w25qxx_bd_is_erased(w25qxx_bd_t *bd, uint32_t block)
+{
+    return (uint8_t)((bd->erased[block / 8] >> (block % 8)) & 0x01); /* return bit */
+}
+
+/**
+ * @brief     set the erased state of a block
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] block block index
+ * @param[in] enable bool value
+ * @note      none
+ */
+static void a_w25qxx_bd_set_erased(w25qxx_bd_t *bd, uint32_t block, uint8_t enable)
+{
+    if (enable != 0)                                           /* set */
+    {
+        bd->erased[block / 8] |= (uint8_t)(1 << (block % 8));  /* set bit */
+    }
+    else
+    {
+        bd->erased[block / 8] &= (uint8_t)~(1 << (block % 8)); /* clear bit */
+    }
+}
+
+/**
+ * @brief     check the handle
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+static uint8_t a_w25qxx_bd_check(w25qxx_bd_t *bd)
+{
+    if (bd == NULL)      /* check handle */
+    {
+        return 2;        /* return error */
+    }
+    if (bd->inited != 1) /* check handle initialization */
+    {
+        return 3;        /* return error */
+    }
+    
+    return 0;            /* success return 0 */
+}
+
+/**
+ * @brief     initialize the block device
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] *config pointer to a w25qxx bd config structure
+ * @param[in] *erased pointer to a W25QXX_BD_BITMAP_SIZE(block_count) bytes buffer
+ * @param[in] *cache pointer to a cache_size bytes buffer, NULL when cache_size is 0
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 config is invalid
+ * @note      every block starts in the unknown state
+ */
+uint8_t w25qxx_bd_init(w25qxx_bd_t *bd, w25qxx_handle_t *handle, const w25qxx_bd_config_t *config,
+                       uint8_t *erased, uint8_t *cache)
+{
+    if ((bd == NULL) || (handle == NULL) || (config == NULL) || (erased == NULL)) /* check handle */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    if (((config->block_size != 4096) && (config->block_size != 32768) &&
+         (config->block_size != 65536)) ||
+        ((config->addr % config->block_size) != 0) || (config->block_count == 0)) /* check block */
+    {
+        handle->debug_print("w25qxx: block is invalid.\n");                       /* block is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    if ((config->read_size == 0) || ((config->block_size % config->read_size) != 0) ||
+        (config->prog_size == 0) || (config->prog_size > 256) ||
+        ((config->prog_size & (config->prog_size - 1)) != 0))                     /* check granularity */
+    {
+        handle->debug_print("w25qxx: granularity is invalid.\n");                 /* granularity is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    if ((config->cache_size != 0) &&
+        ((cache == NULL) || ((config->cache_size % config->read_size) != 0) ||
+         ((config->block_size % config->cache_size) != 0)))                       /* check cache */
+    {
+        handle->debug_print("w25qxx: cache is invalid.\n");                       /* cache is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    if (config->read_mode > W25QXX_BD_READ_MODE_QUAD_IO)                          /* check read mode */
+    {
+        handle->debug_print("w25qxx: read mode is invalid.\n");                   /* read mode is invalid */
+        
+        return 4;                                                                 /* return error */
+    }
+    
+    memset(bd, 0, sizeof(w25qxx_bd_t));                                           /* clear bd */
+    bd->handle = handle;                                                          /* set handle */
+    bd->config = *config;                                                         /* set config */
+    bd->erased = erased;                                                          /* set bitmap */
+    bd->cache = (config->cache_size != 0) ? cache : NULL;                         /* set cache */
+    memset(bd->erased, 0, W25QXX_BD_BITMAP_SIZE(config->block_count));            /* unknown state */
+    switch (config->read_mode)
+    {
+        case W25QXX_BD_READ_MODE_DUAL_OUTPUT :
+        {
+            bd->read = w25qxx_fast_read_dual_output;                              /* 0x3B */
+            
+            break;
+        }
+        case W25QXX_BD_READ_MODE_QUAD_OUTPUT :
+        {
+            bd->read = w25qxx_fast_read_quad_output;                              /* 0x6B */
+            
+            break;
+        }
+        case W25QXX_BD_READ_MODE_DUAL_IO :
+        {
+            bd->read = w25qxx_fast_read_dual_io;                                  /* 0xBB */
+            
+            break;
+        }
+        case W25QXX_BD_READ_MODE_QUAD_IO :
+        {
+            bd->read = w25qxx_fast_read_quad_io;                                  /* 0xEB */
+            
+            break;
+        }
+        case W25QXX_BD_READ_MODE_AUTO :
+        {
+            if ((handle->spi_qspi == W25QXX_INTERFACE_SPI) &&
+                (handle->dual_quad_spi_enable != 0))                              /* spi with dual quad lines */
+            {
+                bd->read = w25qxx_fast_read_quad_io;                              /* 0xEB */
+            }
+            else
+            {
+                bd->read = w25qxx_read;                                           /* 0x0B, 4 lines in qspi */
+            }
+            
+            break;
+        }
+        default :
+        {
+            bd->read = w25qxx_read;                                               /* 0x0B */
+            
+            break;
+        }
+    }
+    bd->inited = 1;                                                               /* set inited */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     deinit the block device
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_bd_deinit(w25qxx_bd_t *bd)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_bd_check(bd); /* check handle */
+    if (res != 0)                /* check result */
+    {
+        return res;              /* return error */
+    }
+    
+    bd->inited = 0;              /* clear inited */
+    
+    return 0;                    /* success return 0 */
+}
+
+/**
+ * @brief      read from a block
+ * @param[in]  *bd pointer to a w25qxx bd structure
+ * @param[in]  block block index
+ * @param[in]  off offset inside the block
+ * @param[out] *buffer pointer to a data buffer
+ * @param[in]  size data size
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 param is invalid
+ * @note       off and size are multiples of read_size, reads of at least cache_size go straight
+ *             into the caller buffer
+ */
+uint8_t w25qxx_bd_read(w25qxx_bd_t *bd, uint32_t block, uint32_t off, void *buffer, uint32_t size)
+{
+    uint8_t res;
+    uint8_t *p;
+    uint32_t base;
+    uint32_t chunk_off;
+    uint32_t len;
+    
+    res = a_w25qxx_bd_check(bd);                                                               /* check handle */
+    if (res != 0)                                                                              /* check result */
+    {
+        return res;                                                                            /* return error */
+    }
+    if ((block >= bd->config.block_count) || ((off % bd->config.read_size) != 0) ||
+        ((size % bd->config.read_size) != 0) || (off + size > bd->config.block_size) ||
+        (off + size < off))                                                                    /* check param */
+    {
+        bd->handle->debug_print("w25qxx: param is invalid.\n");                                /* param is invalid */
+        
+        return 4;                                                                              /* return error */
+    }
+    
+    p = (uint8_t *)buffer;                                                                     /* set pointer */
+    base = bd->config.addr + block * bd->config.block_size;                                    /* get block address */
+    if ((bd->cache == NULL) || (size >= bd->config.cache_size))                                /* large read */
+    {
+        if (size == 0)                                                                         /* nothing to read */
+        {
+            return 0;                                                                          /* success return 0 */
+        }
+        if (bd->read(bd->handle, base + off, p, size) != 0)                                    /* read into the caller buffer */
+        {
+            bd->handle->debug_print("w25qxx: read failed.\n");                                 /* read failed */
+            
+            return 1;                                                                          /* return error */
+        }
+        bd->stats.read_bytes += size;                                                          /* read bytes */
+        
+        return 0;                                                                              /* success return 0 */
+    }
+    
+    while (size != 0)                                                                          /* small read through the cache */
+    {
+        chunk_off = off - (off % bd->config.cache_size);                                       /* get chunk offset */
+        len = chunk_off + bd->config.cache_size - off;                                         /* get chunk remain */
+        if (len > size)                                                                        /* check length */
+        {
+            len = size;                                                                        /* set length */
+        }
+        if ((bd->cache_valid == 0) || (bd->cache_block != block) ||
+            (bd->cache_off != chunk_off))                                                      /* cache miss */
+        {
+            if (bd->read(bd->handle, base + chunk_off, bd->cache, bd->config.cache_size) != 0) /* fill the cache */
+            {
+                bd->cache_valid = 0;                                                           /* invalid cache */
+                bd->handle->debug_print("w25qxx: read failed.\n");                             /* read failed */
+                
+                return 1;                                                                      /* return error */
+            }
+            bd->stats.read_bytes += bd->config.cache_size;                                     /* read bytes */
+            bd->cache_block = block;                                                           /* set block */
+            bd->cache_off = chunk_off;                                                         /* set offset */
+            bd->cache_valid = 1;                                                               /* set valid */
+        }
+        else
+        {
+            bd->stats.cache_hit_bytes += len;                                                  /* cache hit */
+        }
+        memcpy(p, &bd->cache[off - chunk_off], len);                                           /* copy data */
+        p += len;                                                                              /* pointer + length */
+        off += len;                                                                            /* offset + length */
+        size -= len;                                                                           /* size - length */
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     program a block
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] block block index
+ * @param[in] off offset inside the block
+ * @param[in] *buffer pointer to a data buffer
+ * @param[in] size data size
+ * @return    status code
+ *            - 0 success
+ *            - 1 prog failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 param is invalid
+ * @note      off and size are multiples of prog_size, the data is programmed from the caller buffer
+ */
+uint8_t w25qxx_bd_prog(w25qxx_bd_t *bd, uint32_t block, uint32_t off, const void *buffer, uint32_t size)
+{
+    uint8_t res;
+    uint8_t *p;
+    uint32_t addr;
+    uint32_t len;
+    
+    res = a_w25qxx_bd_check(bd);                                          /* check handle */
+    if (res != 0)                                                         /* check result */
+    {
+        return res;                                                       /* return error */
+    }
+    if ((block >= bd->config.block_count) || ((off % bd->config.prog_size) != 0) ||
+        ((size % bd->config.prog_size) != 0) || (off + size > bd->config.block_size) ||
+        (off + size < off))                                               /* check param */
+    {
+        bd->handle->debug_print("w25qxx: param is invalid.\n");           /* param is invalid */
+        
+        return 4;                                                         /* return error */
+    }
+    
+    if ((bd->cache_valid != 0) && (bd->cache_block == block))             /* cached block changes */
+    {
+        bd->cache_valid = 0;                                              /* invalid cache */
+    }
+    a_w25qxx_bd_set_erased(bd, block, 0);                                 /* no longer erased */
+    p = (uint8_t *)buffer;                                                /* set pointer */
+    addr = bd->config.addr + block * bd->config.block_size + off;         /* get address */
+    while (size != 0)                                                     /* loop all pages */
+    {
+        len = 256 - (addr % 256);                                         /* get page remain */
+        if (len > size)                                                   /* check length */
+        {
+            len = size;                                                   /* set length */
+        }
+        if (w25qxx_page_program(bd->handle, addr, p, (uint16_t)len) != 0) /* page program */
+        {
+            bd->handle->debug_print("w25qxx: page program failed.\n");    /* page program failed */
+            
+            return 1;                                                     /* return error */
+        }
+        bd->stats.prog_bytes += len;                                      /* prog bytes */
+        p += len;                                                         /* pointer + length */
+        addr += len;                                                      /* address + length */
+        size -= len;                                                      /* size - length */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      check whether a block is blank
+ * @param[in]  *bd pointer to a w25qxx bd structure
+ * @param[in]  block block index
+ * @param[out] *blank pointer to a blank flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the cache is used as the read buffer when it exists
+ */
+static uint8_t a_w25qxx_bd_blank_check(w25qxx_bd_t *bd, uint32_t block, uint8_t *blank)
+{
+    uint8_t local[64];
+    uint8_t *buf;
+    uint32_t len;
+    uint32_t addr;
+    uint32_t i;
+    uint32_t j;
+    
+    if (bd->cache != NULL)                                     /* use the cache */
+    {
+        buf = bd->cache;                                       /* set buffer */
+        len = bd->config.cache_size;                           /* set length */
+        bd->cache_valid = 0;                                   /* invalid cache */
+    }
+    else
+    {
+        buf = local;                                           /* set buffer */
+        len = sizeof(local);                                   /* set length */
+    }
+    addr = bd->config.addr + block * bd->config.block_size;    /* get address */
+    *blank = 1;                                                /* init blank */
+    for (i = 0; i < bd->config.block_size; i += len)           /* loop the block */
+    {
+        if (bd->read(bd->handle, addr + i, buf, len) != 0)     /* read data */
+        {
+            bd->handle->debug_print("w25qxx: read failed.\n"); /* read failed */
+            
+            return 1;                                          /* return error */
+        }
+        bd->stats.read_bytes += len;                           /* read bytes */
+        for (j = 0; j < len; j++)                              /* check all bytes */
+        {
+            if (buf[j] != 0xFF)                                /* not blank */
+            {
+                *blank = 0;                                    /* set not blank */
+                
+                return 0;                                      /* success return 0 */
+            }
+        }
+    }
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief     erase a block
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] block block index
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 param is invalid
+ * @note      a block known to be erased is not erased again
+ */
+uint8_t w25qxx_bd_erase(w25qxx_bd_t *bd, uint32_t block)
+{
+    uint8_t res;
+    uint8_t blank;
+    uint32_t addr;
+    
+    res = a_w25qxx_bd_check(bd);                                /* check handle */
+    if (res != 0)                                               /* check result */
+    {
+        return res;                                             /* return error */
+    }
+    if (block >= bd->config.block_count)                        /* check block */
+    {
+        bd->handle->debug_print("w25qxx: param is invalid.\n"); /* param is invalid */
+        
+        return 4;                                               /* return error */
+    }
+    
+    if (a_w25qxx_bd_is_erased(bd, block) != 0)                  /* known erased */
+    {
+        bd->stats.erase_skip++;                                 /* skip++ */
+        
+        return 0;                                               /* success return 0 */
+    }
+    if (bd->config.blank_check != 0)                            /* check before erase */
+    {
+        if (a_w25qxx_bd_blank_check(bd, block, &blank) != 0)    /* blank check */
+        {
+            return 1;                                           /* return error */
+        }
+        if (blank != 0)                                         /* already blank */
+        {
+            a_w25qxx_bd_set_erased(bd, block, 1);               /* set erased */
+            bd->stats.erase_skip++;                             /* skip++ */
+            
+            return 0;                                           /* success return 0 */
+        }
+    }
+    
+    if ((bd->cache_valid != 0) && (bd->cache_block == block))   /* cached block changes */
+    {
+        bd->cache_valid = 0;                                    /* invalid cache */
+    }
+    addr = bd->config.addr + block * bd->config.block_size;     /* get address */
+    if (bd->config.block_size == 65536)                         /* 64k block */
+    {
+        res = w25qxx_block_erase_64k(bd->handle, addr);         /* block erase 64k */
+    }
+    else if (bd->config.block_size == 32768)                    /* 32k block */
+    {
+        res = w25qxx_block_erase_32k(bd->handle, addr);         /* block erase 32k */
+    }
+    else
+    {
+        res = w25qxx_sector_erase_4k(bd->handle, addr);         /* sector erase 4k */
+    }
+    if (res != 0)                                               /* check result */
+    {
+        bd->handle->debug_print("w25qxx: erase failed.\n");     /* erase failed */
+        
+        return 1;                                               /* return error */
+    }
+    a_w25qxx_bd_set_erased(bd, block, 1);                       /* set erased */
+    bd->stats.erase_count++;                                    /* erase++ */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     sync the block device
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      programs and erases complete before they return, nothing is buffered
+ */
+uint8_t w25qxx_bd_sync(w25qxx_bd_t *bd)
+{
+    return a_w25qxx_bd_check(bd); /* check handle */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *bd pointer to a w25qxx bd structure
+ * @param[out] *stats pointer to a w25qxx bd stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_bd_get_stats(w25qxx_bd_t *bd, w25qxx_bd_stats_t *stats)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_bd_check(bd);                          /* check handle */
+    if (res != 0)                                         /* check result */
+    {
+        return res;                                       /* return error */
+    }
+    
+    memcpy(stats, &bd->stats, sizeof(w25qxx_bd_stats_t)); /* copy stats */
+    
+    return 0;                                             /* success return 0 */
+}
@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_bd.h
+ * @brief     driver w25qxx block device header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_BD_H
+#define DRIVER_W25QXX_BD_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_bd_driver w25qxx block device driver function
+ * @brief    w25qxx block device adapter modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief     erased bitmap size definition
+ * @param[in] COUNT block count
+ * @note      one bit per block
+ */
+#define W25QXX_BD_BITMAP_SIZE(COUNT)    (((COUNT) + 7U) / 8U)
+
+/**
+ * @brief w25qxx bd read mode enumeration definition
+ */
+typedef enum
+{
+    W25QXX_BD_READ_MODE_AUTO        = 0x00,        /**< fastest mode of the handle configuration */
+    W25QXX_BD_READ_MODE_STANDARD    = 0x01,        /**< w25qxx_read */
+    W25QXX_BD_READ_MODE_DUAL_OUTPUT = 0x02,        /**< w25qxx_fast_read_dual_output */
+    W25QXX_BD_READ_MODE_QUAD_OUTPUT = 0x03,        /**< w25qxx_fast_read_quad_output */
+    W25QXX_BD_READ_MODE_DUAL_IO     = 0x04,        /**< w25qxx_fast_read_dual_io */
+    W25QXX_BD_READ_MODE_QUAD_IO     = 0x05,        /**< w25qxx_fast_read_quad_io */
+} w25qxx_bd_read_mode_t;
+
+/**
+ * @brief w25qxx bd config structure definition
+ */
+typedef struct w25qxx_bd_config_s
+{
+    uint32_t addr;                          /**< region address, block aligned */
+    uint32_t block_size;                    /**< erase block size, 4096, 32768 or 65536 */
+    uint32_t block_count;                   /**< block count */
+    uint32_t read_size;                     /**< min read size */
+    uint32_t prog_size;                     /**< min program size, a power of 2 up to 256 */
+    uint32_t cache_size;                    /**< read cache size, 0 disables the cache */
+    w25qxx_bd_read_mode_t read_mode;        /**< read mode */
+    uint8_t blank_check;                    /**< read a block of unknown state before erasing it */
+} w25qxx_bd_config_t;
+
+/**
+ * @brief w25qxx bd statistics structure definition
+ */
+typedef struct w25qxx_bd_stats_s
+{
+    uint32_t read_bytes;            /**< bytes read from the chip */
+    uint32_t cache_hit_bytes;       /**< bytes served by the cache */
+    uint32_t prog_bytes;            /**< bytes programmed */
+    uint32_t erase_count;           /**< blocks erased */
+    uint32_t erase_skip;            /**< erases skipped because the block was known erased */
+} w25qxx_bd_stats_t;
+
+/**
+ * @brief w25qxx bd structure definition
+ */
+typedef struct w25qxx_bd_s
+{
+    w25qxx_handle_t *handle;                                                  /**< w25qxx handle */
+    w25qxx_bd_config_t config;                                                /**< config */
+    uint8_t (*read)(w25qxx_handle_t *handle, uint32_t addr,
+                    uint8_t *data, uint32_t len);                             /**< selected read function */
+    uint8_t *erased;                                                          /**< known erased bitmap */
+    uint8_t *cache;                                                           /**< read cache */
+    uint32_t cache_block;                                                     /**< cached block */
+    uint32_t cache_off;                                                       /**< cached offset */
+    uint8_t cache_valid;                                                      /**< cache valid flag */
+    w25qxx_bd_stats_t stats;                                                  /**< statistics */
+    uint8_t inited;                                                           /**< inited flag */
+} w25qxx_bd_t;
+
+/**
+ * @brief     initialize the block device
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] *config pointer to a w25qxx bd config structure
+ * @param[in] *erased pointer to a W25QXX_BD_BITMAP_SIZE(block_count) bytes buffer
+ * @param[in] *cache pointer to a cache_size bytes buffer, NULL when cache_size is 0
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 config is invalid
+ * @note      every block starts in the unknown state
+ */
+uint8_t w25qxx_bd_init(w25qxx_bd_t *bd, w25qxx_handle_t *handle, const w25qxx_bd_config_t *config,
+                       uint8_t *erased, uint8_t *cache);
+
+/**
+ * @brief     deinit the block device
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_bd_deinit(w25qxx_bd_t *bd);
+
+/**
+ * @brief      read from a block
+ * @param[in]  *bd pointer to a w25qxx bd structure
+ * @param[in]  block block index
+ * @param[in]  off offset inside the block
+ * @param[out] *buffer pointer to a data buffer
+ * @param[in]  size data size
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 param is invalid
+ * @note       off and size are multiples of read_size, reads of at least cache_size go straight
+ *             into the caller buffer
+ */
+uint8_t w25qxx_bd_read(w25qxx_bd_t *bd, uint32_t block, uint32_t off, void *buffer, uint32_t size);
+
+/**
+ * @brief     program a block
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] block block index
+ * @param[in] off offset inside the block
+ * @param[in] *buffer pointer to a data buffer
+ * @param[in] size data size
+ * @return    status code
+ *            - 0 success
+ *            - 1 prog failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 param is invalid
+ * @note      off and size are multiples of prog_size, the data is programmed from the caller buffer
+ */
+uint8_t w25qxx_bd_prog(w25qxx_bd_t *bd, uint32_t block, uint32_t off, const void *buffer, uint32_t size);
+
+/**
+ * @brief     erase a block
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @param[in] block block index
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 param is invalid
+ * @note      a block known to be erased is not erased again
+ */
+uint8_t w25qxx_bd_erase(w25qxx_bd_t *bd, uint32_t block);
+
+/**
+ * @brief     sync the block device
+ * @param[in] *bd pointer to a w25qxx bd structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      programs and erases complete before they return, nothing is buffered
+ */
+uint8_t w25qxx_bd_sync(w25qxx_bd_t *bd);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *bd pointer to a w25qxx bd structure
+ * @param[out] *stats pointer to a w25qxx bd stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_bd_get_stats(w25qxx_bd_t *bd, w25qxx_bd_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1000 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_blob.c
+ * @brief     driver w25qxx blob source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_blob.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief blob layout definition
+ */
+#define W25QXX_BLOB_MAGIC          0x305A4C42U        /**< "BLZ0" */
+#define W25QXX_BLOB_HEADER_SIZE    32U                /**< header size */
+#define W25QXX_BLOB_INDEX_OFFSET   256U               /**< index offset inside the region */
+#define W25QXX_BLOB_RAW            0x80000000U        /**< index flag of a frame stored as is */
+
+/**
+ * @brief blob codec definition
+ */
+#define W25QXX_BLOB_MIN_MATCH      4U                 /**< shortest match */
+#define W25QXX_BLOB_HASH_EMPTY     0xFFFFU            /**< empty hash slot */
+
+/**
+ * @brief         put a sequence length
+ * @param[in]     *out pointer to an output buffer
+ * @param[in,out] *pos pointer to an output position
+ * @param[in]     cap output capacity
+ * @param[in]     len length beyond the token nibble
+ * @return        status code
+ *                - 0 success
+ *                - 1 output is full
+ * @note          255 bytes continue the length, the first smaller byte ends it
+ */
+static uint8_t a_w25qxx_blob_put_len(uint8_t *out, uint32_t *pos, uint32_t cap, uint32_t len)
+{
+    while (len >= 255)            /* long length */
+    {
+        if (*pos >= cap)          /* check space */
+        {
+            return 1;             /* return error */
+        }
+        out[(*pos)++] = 255;      /* continue */
+        len -= 255;               /* length - 255 */
+    }
+    if (*pos >= cap)              /* check space */
+    {
+        return 1;                 /* return error */
+    }
+    out[(*pos)++] = (uint8_t)len; /* last byte */
+    
+    return 0;                     /* success return 0 */
+}
+
+/**
+ * @brief         put one sequence
+ * @param[in]     *out pointer to an output buffer
+ * @param[in,out] *pos pointer to an output position
+ * @param[in]     cap output capacity
+ * @param[in]     *lit pointer to the literals
+ * @param[in]     lit_len literal length
+ * @param[in]     offset match offset, 0 ends the frame
+ * @param[in]     match_len match length
+ * @return        status code
+ *                - 0 success
+ *                - 1 output is full
+ * @note          token high nibble is the literal length, low nibble is the match length minus 4
+ */
+static uint8_t a_w25qxx_blob_put_sequence(uint8_t *out, uint32_t *pos, uint32_t cap, const uint8_t *lit,
+                                          uint32_t lit_len, uint32_t offset, uint32_t match_len)
+{
+    uint8_t token;
+    uint32_t m;
+    
+    m = (offset != 0) ? (match_len - W25QXX_BLOB_MIN_MATCH) : 0;     /* encoded match length */
+    token = (uint8_t)(((lit_len < 15) ? lit_len : 15) << 4);         /* literal nibble */
+    token |= (uint8_t)((m < 15) ? m : 15);                           /* match nibble */
+    if (*pos >= cap)                                                 /* check space */
+    {
+        return 1;                                                    /* return error */
+    }
+    out[(*pos)++] = token;                                           /* put token */
+    if (lit_len >= 15)                                               /* long literal run */
+    {
+        if (a_w25qxx_blob_put_len(out, pos, cap, lit_len - 15) != 0) /* put length */
+        {
+            return 1;                                                /* return error */
+        }
+    }
+    if (lit_len > cap - *pos)                                        /* check space */
+    {
+        return 1;                                                    /* return error */
+    }
+    memcpy(&out[*pos], lit, lit_len);                                /* copy literals */
+    *pos += lit_len;                                                 /* position + length */
+    if (offset == 0)                                                 /* last sequence */
+    {
+        return 0;                                                    /* success return 0 */
+    }
+    if (cap - *pos < 2)                                              /* check space */
+    {
+        return 1;                                                    /* return error */
+    }
+    out[(*pos)++] = (uint8_t)(offset >> 0);                          /* offset low */
+    out[(*pos)++] = (uint8_t)(offset >> 8);                          /* offset high */
+    if (m >= 15)                                                     /* long match */
+    {
+        if (a_w25qxx_blob_put_len(out, pos, cap, m - 15) != 0)       /* put length */
+        {
+            return 1;                                                /* return error */
+        }
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     compress one frame
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] len frame length
+ * @return    compressed length, 0 when the frame does not shrink
+ * @note      greedy lz77 with a single entry hash table, the output is written to blob->pack
+ */
+static uint32_t a_w25qxx_blob_compress(w25qxx_blob_t *blob, uint32_t len)
+{
+    const uint8_t *in;
+    uint32_t anchor;
+    uint32_t pos;
+    uint32_t i;
+    uint32_t ref;
+    uint32_t value;
+    uint32_t h;
+    uint32_t match_len;
+    
+    in = blob->frame;                                                                                /* input */
+    anchor = 0;                                                                                      /* init 0 */
+    pos = 0;                                                                                         /* init 0 */
+    i = 0;                                                                                           /* init 0 */
+    memset(blob->hash, 0xFF, sizeof(blob->hash));                                                    /* clear the table */
+    while (i + W25QXX_BLOB_MIN_MATCH <= len)                                                         /* search matches */
+    {
+        value = w25qxx_util_get32(&in[i]);                                                           /* get 4 bytes */
+        h = (uint32_t)(value * 2654435761U) >> 24;                                                   /* hash */
+        ref = blob->hash[h];                                                                         /* last position */
+        blob->hash[h] = (uint16_t)i;                                                                 /* update */
+        if ((ref == W25QXX_BLOB_HASH_EMPTY) || (w25qxx_util_get32(&in[ref]) != value))               /* no match */
+        {
+            i++;                                                                                     /* next */
+            
+            continue;                                                                                /* continue */
+        }
+        match_len = W25QXX_BLOB_MIN_MATCH;                                                           /* init match */
+        while ((i + match_len < len) && (in[ref + match_len] == in[i + match_len]))                  /* extend */
+        {
+            match_len++;                                                                             /* length++ */
+        }
+        if (a_w25qxx_blob_put_sequence(blob->pack, &pos, len - 1, &in[anchor], i - anchor,
+                                       i - ref, match_len) != 0)                                     /* put sequence */
+        {
+            return 0;                                                                                /* does not shrink */
+        }
+        i += match_len;                                                                              /* skip the match */
+        anchor = i;                                                                                  /* new anchor */
+    }
+    if (a_w25qxx_blob_put_sequence(blob->pack, &pos, len - 1, &in[anchor], len - anchor, 0, 0) != 0) /* last literals */
+    {
+        return 0;                                                                                    /* does not shrink */
+    }
+    
+    return pos;                                                                                      /* return length */
+}
+
+/**
+ * @brief     decompress one frame
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] in_len compressed length in blob->pack
+ * @param[in] out_len expected frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 frame is corrupt
+ * @note      every length and offset is checked, the output is written to blob->frame
+ */
+static uint8_t a_w25qxx_blob_decompress(w25qxx_blob_t *blob, uint32_t in_len, uint32_t out_len)
+{
+    const uint8_t *in;
+    uint8_t *out;
+    uint32_t ip;
+    uint32_t op;
+    uint32_t lit_len;
+    uint32_t match_len;
+    uint32_t offset;
+    uint8_t b;
+    
+    in = blob->pack;                                                      /* input */
+    out = blob->frame;                                                    /* output */
+    ip = 0;                                                               /* init 0 */
+    op = 0;                                                               /* init 0 */
+    while (ip < in_len)                                                   /* loop all sequences */
+    {
+        b = in[ip++];                                                     /* get token */
+        lit_len = b >> 4;                                                 /* literal length */
+        match_len = (b & 0x0F) + W25QXX_BLOB_MIN_MATCH;                   /* match length */
+        if (lit_len == 15)                                                /* long literal run */
+        {
+            do
+            {
+                if (ip >= in_len)                                         /* check input */
+                {
+                    return 1;                                             /* return error */
+                }
+                b = in[ip++];                                             /* get byte */
+                lit_len += b;                                             /* add length */
+            } while (b == 255);
+        }
+        if ((lit_len > in_len - ip) || (lit_len > out_len - op))          /* check range */
+        {
+            return 1;                                                     /* return error */
+        }
+        memcpy(&out[op], &in[ip], lit_len);                               /* copy literals */
+        ip += lit_len;                                                    /* input + length */
+        op += lit_len;                                                    /* output + length */
+        if (ip == in_len)                                                 /* last sequence */
+        {
+            break;                                                        /* break */
+        }
+        if (in_len - ip < 2)                                              /* check input */
+        {
+            return 1;                                                     /* return error */
+        }
+        offset = (uint32_t)in[ip] | ((uint32_t)in[ip + 1] << 8);          /* get offset */
+        ip += 2;                                                          /* input + 2 */
+        if (match_len == 15 + W25QXX_BLOB_MIN_MATCH)                      /* long match */
+        {
+            do
+            {
+                if (ip >= in_len)                                         /* check input */
+                {
+                    return 1;                                             /* return error */
+                }
+                b = in[ip++];                                             /* get byte */
+                match_len += b;                                           /* add length */
+            } while (b == 255);
+        }
+        if ((offset == 0) || (offset > op) || (match_len > out_len - op)) /* check range */
+        {
+            return 1;                                                     /* return error */
+        }
+        while (match_len != 0)                                            /* copy, may overlap */
+        {
+            out[op] = out[op - offset];                                   /* copy byte */
+            op++;                                                         /* output++ */
+            match_len--;                                                  /* length-- */
+        }
+    }
+    if (op != out_len)                                                    /* check length */
+    {
+        return 1;                                                         /* return error */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     program one page of the data area
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] offset page offset inside the data area
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      a data sector is erased when its first page is programmed
+ */
+static uint8_t a_w25qxx_blob_program_data(w25qxx_blob_t *blob, uint32_t offset)
+{
+    if ((offset % 4096) == 0)                                                              /* new sector */
+    {
+        if (w25qxx_sector_erase_4k(blob->handle, blob->data_addr + offset) != 0)           /* sector erase */
+        {
+            blob->handle->debug_print("w25qxx: sector erase 4k failed.\n");                /* sector erase 4k failed */
+            
+            return 1;                                                                      /* return error */
+        }
+    }
+    if (w25qxx_page_program(blob->handle, blob->data_addr + offset, blob->page, 256) != 0) /* page program */
+    {
+        blob->handle->debug_print("w25qxx: page program failed.\n");                       /* page program failed */
+        
+        return 1;                                                                          /* return error */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     program one page of the index
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] first first frame of the page
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      the index sectors are erased by create
+ */
+static uint8_t a_w25qxx_blob_program_index(w25qxx_blob_t *blob, uint32_t first)
+{
+    if (w25qxx_page_program(blob->handle, blob->addr + W25QXX_BLOB_INDEX_OFFSET + first * 4,
+                            blob->index, 256) != 0)                  /* page program */
+    {
+        blob->handle->debug_print("w25qxx: page program failed.\n"); /* page program failed */
+        
+        return 1;                                                    /* return error */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     compress and store the frame buffer
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] len frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 store failed
+ *            - 5 region is full
+ * @note      none
+ */
+static uint8_t a_w25qxx_blob_store_frame(w25qxx_blob_t *blob, uint32_t len)
+{
+    const uint8_t *src;
+    uint32_t clen;
+    uint32_t flag;
+    uint32_t pos;
+    uint32_t n;
+    
+    clen = a_w25qxx_blob_compress(blob, len);                                        /* compress */
+    if (clen != 0)                                                                   /* shrunk */
+    {
+        src = blob->pack;                                                            /* compressed frame */
+        flag = 0;                                                                    /* compressed */
+    }
+    else
+    {
+        src = blob->frame;                                                           /* raw frame */
+        clen = len;                                                                  /* raw length */
+        flag = W25QXX_BLOB_RAW;                                                      /* raw */
+    }
+    if ((blob->frames >= blob->index_cap) ||
+        (clen > (blob->addr + blob->len - blob->data_addr) - blob->stored))          /* check space */
+    {
+        blob->handle->debug_print("w25qxx: region is full.\n");                      /* region is full */
+        
+        return 5;                                                                    /* return error */
+    }
+    while (clen != 0)                                                                /* append data */
+    {
+        pos = blob->stored % 256;                                                    /* page position */
+        n = 256 - pos;                                                               /* page remain */
+        if (n > clen)                                                                /* check length */
+        {
+            n = clen;                                                                /* set length */
+        }
+        memcpy(&blob->page[pos], src, n);                                            /* copy */
+        src += n;                                                                    /* source + n */
+        clen -= n;                                                                   /* length - n */
+        blob->stored += n;                                                           /* stored + n */
+        if ((blob->stored % 256) == 0)                                               /* page is full */
+        {
+            if (a_w25qxx_blob_program_data(blob, blob->stored - 256) != 0)           /* program it */
+            {
+                return 1;                                                            /* return error */
+            }
+        }
+    }
+    w25qxx_util_put32(&blob->index[(blob->frames % 64) * 4], blob->stored | flag);   /* frame end */
+    blob->frames++;                                                                  /* frame++ */
+    if ((blob->frames % 64) == 0)                                                    /* index page is full */
+    {
+        if (a_w25qxx_blob_program_index(blob, blob->frames - 64) != 0)               /* program it */
+        {
+            return 1;                                                                /* return error */
+        }
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     load and decode one frame
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] frame frame index
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 6 frame is corrupt
+ * @note      none
+ */
+static uint8_t a_w25qxx_blob_load_frame(w25qxx_blob_t *blob, uint32_t frame)
+{
+    uint8_t buf[8];
+    uint32_t start;
+    uint32_t end;
+    uint32_t clen;
+    uint32_t len;
+    
+    blob->cache_frame = 0xFFFFFFFFU;                                                           /* invalidate */
+    if (frame == 0)                                                                            /* first frame */
+    {
+        if (w25qxx_read(blob->handle, blob->addr + W25QXX_BLOB_INDEX_OFFSET, &buf[4], 4) != 0) /* read the entry */
+        {
+            blob->handle->debug_print("w25qxx: read failed.\n");                               /* read failed */
+            
+            return 1;                                                                          /* return error */
+        }
+        start = 0;                                                                             /* data start */
+    }
+    else
+    {
+        if (w25qxx_read(blob->handle, blob->addr + W25QXX_BLOB_INDEX_OFFSET + (frame - 1) * 4,
+                        buf, 8) != 0)                                                          /* read two entries */
+        {
+            blob->handle->debug_print("w25qxx: read failed.\n");                               /* read failed */
+            
+            return 1;                                                                          /* return error */
+        }
+        start = w25qxx_util_get32(&buf[0]) & ~W25QXX_BLOB_RAW;                                 /* previous end */
+    }
+    end = w25qxx_util_get32(&buf[4]);                                                          /* frame end */
+    len = blob->size - frame * W25QXX_BLOB_FRAME_SIZE;                                         /* frame length */
+    if (len > W25QXX_BLOB_FRAME_SIZE)                                                          /* full frame */
+    {
+        len = W25QXX_BLOB_FRAME_SIZE;                                                          /* set length */
+    }
+    clen = (end & ~W25QXX_BLOB_RAW) - start;                                                   /* stored length */
+    if (((end & ~W25QXX_BLOB_RAW) < start) || ((end & ~W25QXX_BLOB_RAW) > blob->stored) ||
+        (clen > W25QXX_BLOB_FRAME_SIZE) || (((end & W25QXX_BLOB_RAW) != 0) && (clen != len)))  /* check entry */
+    {
+        blob->handle->debug_print("w25qxx: frame is corrupt.\n");                              /* frame is corrupt */
+        
+        return 6;                                                                              /* return error */
+    }
+    if (w25qxx_read(blob->handle, blob->data_addr + start,
+                    ((end & W25QXX_BLOB_RAW) != 0) ? blob->frame : blob->pack, clen) != 0)     /* read the frame */
+    {
+        blob->handle->debug_print("w25qxx: read failed.\n");                                   /* read failed */
+        
+        return 1;                                                                              /* return error */
+    }
+    blob->flash_read += clen;                                                                  /* flash read + length */
+    if ((end & W25QXX_BLOB_RAW) == 0)                                                          /* compressed */
+    {
+        if (a_w25qxx_blob_decompress(blob, clen, len) != 0)                                    /* decode */
+        {
+            blob->handle->debug_print("w25qxx: frame is corrupt.\n");                          /* frame is corrupt */
+            
+            return 6;                                                                          /* return error */
+        }
+    }
+    blob->frame_decode++;                                                                      /* decode++ */
+    blob->cache_frame = frame;                                                                 /* keep it */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     verify the stored crc
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 6 frame is corrupt
+ *            - 7 crc mismatch
+ * @note      every frame is decoded once and hashed in order
+ */
+static uint8_t a_w25qxx_blob_verify(w25qxx_blob_t *blob)
+{
+    uint8_t res;
+    uint32_t crc;
+    uint32_t frame;
+    uint32_t len;
+    
+    crc = 0xFFFFFFFFU;                                                    /* init crc */
+    for (frame = 0; frame < blob->frames; frame++)                        /* loop all frames */
+    {
+        res = a_w25qxx_blob_load_frame(blob, frame);                      /* load it */
+        if (res != 0)                                                     /* check result */
+        {
+            return res;                                                   /* return error */
+        }
+        len = blob->size - frame * W25QXX_BLOB_FRAME_SIZE;                /* frame length */
+        if (len > W25QXX_BLOB_FRAME_SIZE)                                 /* full frame */
+        {
+            len = W25QXX_BLOB_FRAME_SIZE;                                 /* set length */
+        }
+        crc = w25qxx_util_crc32(crc, blob->frame, len);                   /* update crc */
+    }
+    if (~crc != blob->crc)                                                /* check crc */
+    {
+        blob->handle->debug_print("w25qxx: crc mismatch.\n");             /* crc mismatch */
+        
+        return 7;                                                         /* return error */
+    }
+    blob->verified = 1;                                                   /* flag verified */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     check the blob handle
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+static uint8_t a_w25qxx_blob_check(w25qxx_blob_t *blob)
+{
+    if (blob == NULL)      /* check handle */
+    {
+        return 2;          /* return error */
+    }
+    if (blob->inited != 1) /* check handle initialization */
+    {
+        return 3;          /* return error */
+    }
+    
+    return 0;              /* success return 0 */
+}
+
+/**
+ * @brief     initialize the blob region
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] max_size largest uncompressed size a new blob may have
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr or len is invalid
+ *            - 5 region is too small for the frame index
+ * @note      addr and len must be 4k aligned, the region starts with a header page and
+ *            a frame index of 4 bytes per frame, the compressed data follows 4k aligned
+ */
+uint8_t w25qxx_blob_init(w25qxx_blob_t *blob, w25qxx_handle_t *handle, uint32_t addr, uint32_t len, uint32_t max_size)
+{
+    uint32_t index_cap;
+    uint32_t data_off;
+    
+    if ((blob == NULL) || (handle == NULL))                                           /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    if (((addr % 4096) != 0) || ((len % 4096) != 0) || (len == 0) || (max_size == 0)) /* check region */
+    {
+        handle->debug_print("w25qxx: addr or len is invalid.\n");                     /* addr or len is invalid */
+        
+        return 4;                                                                     /* return error */
+    }
+    index_cap = (max_size + W25QXX_BLOB_FRAME_SIZE - 1) / W25QXX_BLOB_FRAME_SIZE;     /* frames */
+    data_off = (W25QXX_BLOB_INDEX_OFFSET + index_cap * 4 + 4095) / 4096 * 4096;       /* data offset */
+    if (data_off >= len)                                                              /* check region */
+    {
+        handle->debug_print("w25qxx: region is too small.\n");                        /* region is too small */
+        
+        return 5;                                                                     /* return error */
+    }
+    
+    memset(blob, 0, sizeof(w25qxx_blob_t));                                           /* clear */
+    blob->handle = handle;                                                            /* set handle */
+    blob->addr = addr;                                                                /* set addr */
+    blob->len = len;                                                                  /* set len */
+    blob->index_cap = index_cap;                                                      /* set capacity */
+    blob->data_addr = addr + data_off;                                                /* set data address */
+    blob->cache_frame = 0xFFFFFFFFU;                                                  /* no frame */
+    blob->inited = 1;                                                                 /* flag inited */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     deinit the blob region
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a blob that is not finished is dropped
+ */
+uint8_t w25qxx_blob_deinit(w25qxx_blob_t *blob)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_blob_check(blob); /* check handle */
+    if (res != 0)                    /* check result */
+    {
+        return res;                  /* return error */
+    }
+    
+    blob->writing = 0;               /* clear writing */
+    blob->opened = 0;                /* clear opened */
+    blob->inited = 0;                /* flag closed */
+    
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief     start a new blob
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the header and index sectors are erased here, data sectors are erased when reached
+ */
+uint8_t w25qxx_blob_create(w25qxx_blob_t *blob)
+{
+    uint8_t res;
+    uint32_t a;
+    
+    res = a_w25qxx_blob_check(blob);                                                 /* check handle */
+    if (res != 0)                                                                    /* check result */
+    {
+        return res;                                                                  /* return error */
+    }
+    
+    blob->writing = 0;                                                               /* clear writing */
+    blob->opened = 0;                                                                /* the old blob is gone */
+    blob->cache_frame = 0xFFFFFFFFU;                                                 /* no frame */
+    blob->index_cap = (blob->data_addr - blob->addr - W25QXX_BLOB_INDEX_OFFSET) / 4; /* capacity of this region */
+    for (a = blob->addr; a < blob->data_addr; a += 4096)                             /* header and index sectors */
+    {
+        if (w25qxx_sector_erase_4k(blob->handle, a) != 0)                            /* sector erase */
+        {
+            blob->handle->debug_print("w25qxx: sector erase 4k failed.\n");          /* sector erase 4k failed */
+            
+            return 1;                                                                /* return error */
+        }
+    }
+    blob->size = 0;                                                                  /* init 0 */
+    blob->frames = 0;                                                                /* init 0 */
+    blob->stored = 0;                                                                /* init 0 */
+    blob->crc = 0xFFFFFFFFU;                                                         /* init crc */
+    memset(blob->page, 0xFF, 256);                                                   /* blank page */
+    memset(blob->index, 0xFF, 256);                                                  /* blank index */
+    blob->writing = 1;                                                               /* flag writing */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     append data to the blob
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no blob is being written
+ *            - 5 region is full
+ * @note      every full frame is compressed and programmed, a frame that does not shrink is
+ *            stored as is, the blob is dropped on error
+ */
+uint8_t w25qxx_blob_write(w25qxx_blob_t *blob, const uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint32_t pos;
+    uint32_t n;
+    
+    res = a_w25qxx_blob_check(blob);                                       /* check handle */
+    if (res != 0)                                                          /* check result */
+    {
+        return res;                                                        /* return error */
+    }
+    if (blob->writing != 1)                                                /* check writing */
+    {
+        blob->handle->debug_print("w25qxx: no blob is being written.\n");  /* no blob is being written */
+        
+        return 4;                                                          /* return error */
+    }
+    
+    while (len != 0)                                                       /* loop all bytes */
+    {
+        pos = blob->size % W25QXX_BLOB_FRAME_SIZE;                         /* frame position */
+        n = W25QXX_BLOB_FRAME_SIZE - pos;                                  /* frame remain */
+        if (n > len)                                                       /* check length */
+        {
+            n = len;                                                       /* set length */
+        }
+        memcpy(&blob->frame[pos], data, n);                                /* copy */
+        blob->crc = w25qxx_util_crc32(blob->crc, data, n);                 /* update crc */
+        blob->size += n;                                                   /* size + n */
+        data += n;                                                         /* data + n */
+        len -= n;                                                          /* length - n */
+        if ((blob->size % W25QXX_BLOB_FRAME_SIZE) == 0)                    /* frame is full */
+        {
+            res = a_w25qxx_blob_store_frame(blob, W25QXX_BLOB_FRAME_SIZE); /* store it */
+            if (res != 0)                                                  /* check result */
+            {
+                blob->writing = 0;                                         /* drop the blob */
+                
+                return res;                                                /* return error */
+            }
+        }
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     finish the blob
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no blob is being written
+ *            - 5 region is full
+ * @note      the header page is programmed last, so a torn blob is never opened
+ */
+uint8_t w25qxx_blob_finish(w25qxx_blob_t *blob)
+{
+    uint8_t res;
+    uint32_t pos;
+    
+    res = a_w25qxx_blob_check(blob);                                                         /* check handle */
+    if (res != 0)                                                                            /* check result */
+    {
+        return res;                                                                          /* return error */
+    }
+    if (blob->writing != 1)                                                                  /* check writing */
+    {
+        blob->handle->debug_print("w25qxx: no blob is being written.\n");                    /* no blob is being written */
+        
+        return 4;                                                                            /* return error */
+    }
+    
+    blob->writing = 0;                                                                       /* writing ends here */
+    pos = blob->size % W25QXX_BLOB_FRAME_SIZE;                                               /* last frame length */
+    if (pos != 0)                                                                            /* partial frame */
+    {
+        res = a_w25qxx_blob_store_frame(blob, pos);                                          /* store it */
+        if (res != 0)                                                                        /* check result */
+        {
+            return res;                                                                      /* return error */
+        }
+    }
+    pos = blob->stored % 256;                                                                /* data page position */
+    if (pos != 0)                                                                            /* partial data page */
+    {
+        memset(&blob->page[pos], 0xFF, 256 - pos);                                           /* pad */
+        if (a_w25qxx_blob_program_data(blob, blob->stored - pos) != 0)                       /* program it */
+        {
+            return 1;                                                                        /* return error */
+        }
+    }
+    pos = blob->frames % 64;                                                                 /* index page position */
+    if (pos != 0)                                                                            /* partial index page */
+    {
+        memset(&blob->index[pos * 4], 0xFF, 256 - pos * 4);                                  /* pad */
+        if (a_w25qxx_blob_program_index(blob, blob->frames - pos) != 0)                      /* program it */
+        {
+            return 1;                                                                        /* return error */
+        }
+    }
+    blob->crc = ~blob->crc;                                                                  /* final xor */
+    memset(blob->page, 0xFF, W25QXX_BLOB_HEADER_SIZE);                                       /* clear */
+    w25qxx_util_put32(&blob->page[0], W25QXX_BLOB_MAGIC);                                    /* set magic */
+    w25qxx_util_put32(&blob->page[4], W25QXX_BLOB_FRAME_SIZE);                               /* set frame size */
+    w25qxx_util_put32(&blob->page[8], blob->size);                                           /* set size */
+    w25qxx_util_put32(&blob->page[12], blob->frames);                                        /* set frames */
+    w25qxx_util_put32(&blob->page[16], blob->stored);                                        /* set stored */
+    w25qxx_util_put32(&blob->page[20], blob->index_cap);                                     /* set index capacity */
+    w25qxx_util_put32(&blob->page[24], blob->crc);                                           /* set data crc */
+    w25qxx_util_put32(&blob->page[28], ~w25qxx_util_crc32(0xFFFFFFFFU, blob->page, 28));     /* set header crc */
+    if (w25qxx_page_program(blob->handle, blob->addr, blob->page,
+                            W25QXX_BLOB_HEADER_SIZE) != 0)                                   /* program the header */
+    {
+        blob->handle->debug_print("w25qxx: page program failed.\n");                         /* page program failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    blob->cache_frame = 0xFFFFFFFFU;                                                         /* no frame */
+    blob->opened = 1;                                                                        /* readable now */
+    blob->verified = 0;                                                                      /* not verified yet */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     open the blob stored in the region
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no blob is stored
+ * @note      none
+ */
+uint8_t w25qxx_blob_open(w25qxx_blob_t *blob)
+{
+    uint8_t res;
+    uint32_t size;
+    uint32_t frames;
+    uint32_t stored;
+    uint32_t index_cap;
+    uint32_t data_off;
+    
+    res = a_w25qxx_blob_check(blob);                                                     /* check handle */
+    if (res != 0)                                                                        /* check result */
+    {
+        return res;                                                                      /* return error */
+    }
+    
+    blob->writing = 0;                                                                   /* clear writing */
+    blob->opened = 0;                                                                    /* clear opened */
+    blob->cache_frame = 0xFFFFFFFFU;                                                     /* no frame */
+    if (w25qxx_read(blob->handle, blob->addr, blob->page, W25QXX_BLOB_HEADER_SIZE) != 0) /* read the header */
+    {
+        blob->handle->debug_print("w25qxx: read failed.\n");                             /* read failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    size = w25qxx_util_get32(&blob->page[8]);                                            /* get size */
+    frames = w25qxx_util_get32(&blob->page[12]);                                         /* get frames */
+    stored = w25qxx_util_get32(&blob->page[16]);                                         /* get stored */
+    index_cap = w25qxx_util_get32(&blob->page[20]);                                      /* get index capacity */
+    data_off = (W25QXX_BLOB_INDEX_OFFSET + index_cap * 4 + 4095) / 4096 * 4096;          /* data offset */
+    if ((w25qxx_util_get32(&blob->page[0]) != W25QXX_BLOB_MAGIC) ||
+        (w25qxx_util_get32(&blob->page[28]) != ~w25qxx_util_crc32(0xFFFFFFFFU, blob->page, 28)) ||
+        (w25qxx_util_get32(&blob->page[4]) != W25QXX_BLOB_FRAME_SIZE) ||
+        (index_cap > blob->len / 4) || (data_off >= blob->len) || (frames > index_cap) ||
+        (frames != (size + W25QXX_BLOB_FRAME_SIZE - 1) / W25QXX_BLOB_FRAME_SIZE) ||
+        (stored > blob->len - data_off))                                                 /* check header */
+    {
+        blob->handle->debug_print("w25qxx: no blob is stored.\n");                       /* no blob is stored */
+        
+        return 4;                                                                        /* return error */
+    }
+    blob->size = size;                                                                   /* set size */
+    blob->frames = frames;                                                               /* set frames */
+    blob->stored = stored;                                                               /* set stored */
+    blob->index_cap = index_cap;                                                         /* set index capacity */
+    blob->data_addr = blob->addr + data_off;                                             /* set data address */
+    blob->crc = w25qxx_util_get32(&blob->page[24]);                                      /* set crc */
+    blob->opened = 1;                                                                    /* flag opened */
+    blob->verified = 0;                                                                  /* not verified yet */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      read uncompressed data from the blob
+ * @param[in]  *blob pointer to a w25qxx blob structure
+ * @param[in]  offset uncompressed offset
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 blob is not opened
+ *             - 5 offset or len is invalid
+ *             - 6 frame is corrupt
+ *             - 7 crc mismatch
+ * @note       the first read after open or finish decodes every frame once to check the stored crc,
+ *             later reads only read and decode the frames touched by the range,
+ *             the last decoded frame is kept for the next read
+ */
+uint8_t w25qxx_blob_read(w25qxx_blob_t *blob, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    uint8_t res;
+    uint32_t frame;
+    uint32_t pos;
+    uint32_t n;
+    
+    res = a_w25qxx_blob_check(blob);                                      /* check handle */
+    if (res != 0)                                                         /* check result */
+    {
+        return res;                                                       /* return error */
+    }
+    if (blob->opened != 1)                                                /* check opened */
+    {
+        blob->handle->debug_print("w25qxx: blob is not opened.\n");       /* blob is not opened */
+        
+        return 4;                                                         /* return error */
+    }
+    if ((offset > blob->size) || (len > blob->size - offset))             /* check range */
+    {
+        blob->handle->debug_print("w25qxx: offset or len is invalid.\n"); /* offset or len is invalid */
+        
+        return 5;                                                         /* return error */
+    }
+    if (blob->verified != 1)                                              /* first read */
+    {
+        res = a_w25qxx_blob_verify(blob);                                 /* verify the stored crc */
+        if (res != 0)                                                     /* check result */
+        {
+            return res;                                                   /* return error */
+        }
+    }
+    
+    while (len != 0)                                                      /* loop all frames */
+    {
+        frame = offset / W25QXX_BLOB_FRAME_SIZE;                          /* frame index */
+        pos = offset % W25QXX_BLOB_FRAME_SIZE;                            /* frame position */
+        n = W25QXX_BLOB_FRAME_SIZE - pos;                                 /* frame remain */
+        if (n > len)                                                      /* check length */
+        {
+            n = len;                                                      /* set length */
+        }
+        if (frame != blob->cache_frame)                                   /* not decoded yet */
+        {
+            res = a_w25qxx_blob_load_frame(blob, frame);                  /* load it */
+            if (res != 0)                                                 /* check result */
+            {
+                return res;                                               /* return error */
+            }
+        }
+        memcpy(buf, &blob->frame[pos], n);                                /* copy */
+        buf += n;                                                         /* buffer + n */
+        offset += n;                                                      /* offset + n */
+        len -= n;                                                         /* length - n */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the blob information
+ * @param[in]  *blob pointer to a w25qxx blob structure
+ * @param[out] *info pointer to a w25qxx blob info structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_blob_get_info(w25qxx_blob_t *blob, w25qxx_blob_info_t *info)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_blob_check(blob);         /* check handle */
+    if (res != 0)                            /* check result */
+    {
+        return res;                          /* return error */
+    }
+    if (info == NULL)                        /* check info */
+    {
+        return 2;                            /* return error */
+    }
+    
+    info->size = blob->size;                 /* set size */
+    info->stored = blob->stored;             /* set stored */
+    info->frames = blob->frames;             /* set frames */
+    info->crc = blob->crc;                   /* set crc */
+    info->frame_decode = blob->frame_decode; /* set decode count */
+    info->flash_read = blob->flash_read;     /* set flash read */
+    
+    return 0;                                /* success return 0 */
+}
@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_blob.h
+ * @brief     driver w25qxx blob header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_BLOB_H
+#define DRIVER_W25QXX_BLOB_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_blob_driver w25qxx blob driver function
+ * @brief    w25qxx compressed blob modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx blob frame size definition
+ */
+#define W25QXX_BLOB_FRAME_SIZE        1024U        /**< uncompressed bytes per frame */
+
+/**
+ * @brief w25qxx blob info structure definition
+ */
+typedef struct w25qxx_blob_info_s
+{
+    uint32_t size;                         /**< uncompressed size */
+    uint32_t stored;                       /**< compressed bytes in flash */
+    uint32_t frames;                       /**< frame count */
+    uint32_t crc;                          /**< crc32 of the uncompressed data */
+    uint32_t frame_decode;                 /**< frames decoded by reads */
+    uint32_t flash_read;                   /**< bytes read from flash by reads */
+} w25qxx_blob_info_t;
+
+/**
+ * @brief w25qxx blob structure definition
+ */
+typedef struct w25qxx_blob_s
+{
+    w25qxx_handle_t *handle;               /**< w25qxx handle */
+    uint32_t addr;                         /**< region address */
+    uint32_t len;                          /**< region length */
+    uint32_t index_cap;                    /**< index capacity in frames */
+    uint32_t data_addr;                    /**< compressed data address */
+    uint32_t size;                         /**< uncompressed size */
+    uint32_t frames;                       /**< frame count */
+    uint32_t stored;                       /**< compressed bytes */
+    uint32_t crc;                          /**< crc32 of the uncompressed data */
+    uint32_t cache_frame;                  /**< decoded frame in the frame buffer */
+    uint32_t frame_decode;                 /**< frames decoded by reads */
+    uint32_t flash_read;                   /**< bytes read from flash by reads */
+    uint16_t hash[256];                    /**< match finder table */
+    uint8_t frame[W25QXX_BLOB_FRAME_SIZE]; /**< frame buffer */
+    uint8_t pack[W25QXX_BLOB_FRAME_SIZE];  /**< compressed frame buffer */
+    uint8_t page[256];                     /**< data page buffer */
+    uint8_t index[256];                    /**< index page buffer */
+    uint8_t verified;                      /**< stored crc checked since open */
+    uint8_t writing;                       /**< writing flag */
+    uint8_t opened;                        /**< opened flag */
+    uint8_t inited;                        /**< inited flag */
+} w25qxx_blob_t;
+
+/**
+ * @brief     initialize the blob region
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] max_size largest uncompressed size a new blob may have
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr or len is invalid
+ *            - 5 region is too small for the frame index
+ * @note      addr and len must be 4k aligned, the region starts with a header page and
+ *            a frame index of 4 bytes per frame, the compressed data follows 4k aligned
+ */
+uint8_t w25qxx_blob_init(w25qxx_blob_t *blob, w25qxx_handle_t *handle, uint32_t addr, uint32_t len, uint32_t max_size);
+
+/**
+ * @brief     deinit the blob region
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a blob that is not finished is dropped
+ */
+uint8_t w25qxx_blob_deinit(w25qxx_blob_t *blob);
+
+/**
+ * @brief     start a new blob
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the header and index sectors are erased here, data sectors are erased when reached
+ */
+uint8_t w25qxx_blob_create(w25qxx_blob_t *blob);
+
+/**
+ * @brief     append data to the blob
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no blob is being written
+ *            - 5 region is full
+ * @note      every full frame is compressed and programmed, a frame that does not shrink is
+ *            stored as is, the blob is dropped on error
+ */
+uint8_t w25qxx_blob_write(w25qxx_blob_t *blob, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief     finish the blob
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no blob is being written
+ *            - 5 region is full
+ * @note      the header page is programmed last, so a torn blob is never opened
+ */
+uint8_t w25qxx_blob_finish(w25qxx_blob_t *blob);
+
+/**
+ * @brief     open the blob stored in the region
+ * @param[in] *blob pointer to a w25qxx blob structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no blob is stored
+ * @note      none
+ */
+uint8_t w25qxx_blob_open(w25qxx_blob_t *blob);
+
+/**
+ * @brief      read uncompressed data from the blob
+ * @param[in]  *blob pointer to a w25qxx blob structure
+ * @param[in]  offset uncompressed offset
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 blob is not opened
+ *             - 5 offset or len is invalid
+ *             - 6 frame is corrupt
+ *             - 7 crc mismatch
+ * @note       the first read after open or finish decodes every frame once to check the stored crc,
+ *             later reads only read and decode the frames touched by the range,
+ *             the last decoded frame is kept for the next read
+ */
+uint8_t w25qxx_blob_read(w25qxx_blob_t *blob, uint32_t offset, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief      get the blob information
+ * @param[in]  *blob pointer to a w25qxx blob structure
+ * @param[out] *info pointer to a w25qxx blob info structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_blob_get_info(w25qxx_blob_t *blob, w25qxx_blob_info_t *info);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,384 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_bus.c
+ * @brief     driver w25qxx bus source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_bus.h"
+
+/**
+ * @brief chip command definition
+ */
+#define W25QXX_COMMAND_READ_STATUS_REG1        0x05        /**< read status register-1 */
+
+/**
+ * @brief     check the bus
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+static uint8_t a_w25qxx_bus_check(w25qxx_bus_t *bus)
+{
+    if (bus == NULL)      /* check handle */
+    {
+        return 2;         /* return error */
+    }
+    if (bus->inited != 1) /* check handle initialization */
+    {
+        return 3;         /* return error */
+    }
+    
+    return 0;             /* success return 0 */
+}
+
+/**
+ * @brief     check if a transfer is a status 1 poll
+ * @param[in] instruction sent instruction
+ * @param[in] instruction_line instruction phy lines
+ * @param[in] *in_buf pointer to a input buffer
+ * @param[in] in_len input length
+ * @param[in] out_len output length
+ * @return    1 if it is a poll, else 0
+ * @note      the single spi path sends the command in in_buf, the others as instruction
+ */
+static uint8_t a_w25qxx_bus_is_poll(uint8_t instruction, uint8_t instruction_line,
+                                    uint8_t *in_buf, uint32_t in_len, uint32_t out_len)
+{
+    if (out_len != 1)                                                                            /* one status byte */
+    {
+        return 0;                                                                                /* not a poll */
+    }
+    if (instruction_line == 0)                                                                   /* single spi */
+    {
+        if ((in_buf != NULL) && (in_len == 1) && (in_buf[0] == W25QXX_COMMAND_READ_STATUS_REG1)) /* check command */
+        {
+            return 1;                                                                            /* poll */
+        }
+    }
+    else
+    {
+        if ((instruction == W25QXX_COMMAND_READ_STATUS_REG1) && (in_len == 0))                   /* check instruction */
+        {
+            return 1;                                                                            /* poll */
+        }
+    }
+    
+    return 0;                                                                                    /* not a poll */
+}
+
+/**
+ * @brief     initialize the bus
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *write_read pointer to a bus transfer function selecting the chip by cs
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      write_read takes cs first and then the arguments of the spi_qspi_write_read hook
+ */
+uint8_t w25qxx_bus_init(w25qxx_bus_t *bus,
+                        uint8_t (*write_read)(uint8_t cs, uint8_t instruction, uint8_t instruction_line,
+                                              uint32_t address, uint8_t address_line, uint8_t address_len,
+                                              uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                              uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                              uint8_t *out_buf, uint32_t out_len, uint8_t data_line))
+{
+    if ((bus == NULL) || (write_read == NULL)) /* check handle */
+    {
+        return 2;                              /* return error */
+    }
+    
+    memset(bus, 0, sizeof(w25qxx_bus_t));      /* clear bus */
+    bus->write_read = write_read;              /* set write read */
+    bus->inited = 1;                           /* set inited */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the bus hooks
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *try_lock pointer to a try lock function returning 0 when locked, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the lock is held for one transfer only, so chips used from different
+ *            threads share the bus transfer by transfer
+ */
+uint8_t w25qxx_bus_set_hooks(w25qxx_bus_t *bus, void (*lock)(void), uint8_t (*try_lock)(void), void (*unlock)(void))
+{
+    uint8_t res;
+    
+    res = a_w25qxx_bus_check(bus); /* check handle */
+    if (res != 0)                  /* check result */
+    {
+        return res;                /* return error */
+    }
+    
+    bus->lock = lock;              /* set lock */
+    bus->try_lock = try_lock;      /* set try lock */
+    bus->unlock = unlock;          /* set unlock */
+    
+    return 0;                      /* success return 0 */
+}
+
+/**
+ * @brief     set the bus batch transfer
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *batch pointer to a bus batch function selecting the chip by cs, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      batch takes cs first and then the arguments of the spi_batch hook
+ */
+uint8_t w25qxx_bus_set_batch(w25qxx_bus_t *bus, uint8_t (*batch)(uint8_t cs, w25qxx_spi_transfer_t *transfer, uint8_t num))
+{
+    uint8_t res;
+    
+    res = a_w25qxx_bus_check(bus); /* check handle */
+    if (res != 0)                  /* check result */
+    {
+        return res;                /* return error */
+    }
+    
+    bus->batch = batch;            /* set batch */
+    
+    return 0;                      /* success return 0 */
+}
+
+/**
+ * @brief     attach a chip to the bus
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *chip pointer to a w25qxx bus chip structure
+ * @param[in] cs chip select passed to the transfer function
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a chip handle linking a spi_batch hook must send the batch with
+ *            w25qxx_bus_batch, a hook driving the bus itself bypasses the bus lock
+ */
+uint8_t w25qxx_bus_chip_init(w25qxx_bus_t *bus, w25qxx_bus_chip_t *chip, uint8_t cs)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_bus_check(bus);              /* check handle */
+    if (res != 0)                               /* check result */
+    {
+        return res;                             /* return error */
+    }
+    if (chip == NULL)                           /* check chip */
+    {
+        return 2;                               /* return error */
+    }
+    
+    memset(chip, 0, sizeof(w25qxx_bus_chip_t)); /* clear chip */
+    chip->bus = bus;                            /* set bus */
+    chip->cs = cs;                              /* set chip select */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      bus transfer of one chip
+ * @param[in]  *chip pointer to a w25qxx bus chip structure
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       call it from the spi_qspi_write_read hook of the chip handle, a status 1
+ *             poll of a chip last seen busy is answered with that status when the bus
+ *             is taken by another chip, at most W25QXX_BUS_MAX_DEFER times in a row,
+ *             so the busy wait of one chip doesn't hold the bus against the others
+ */
+uint8_t w25qxx_bus_write_read(w25qxx_bus_chip_t *chip, uint8_t instruction, uint8_t instruction_line,
+                              uint32_t address, uint8_t address_line, uint8_t address_len,
+                              uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                              uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                              uint8_t *out_buf, uint32_t out_len, uint8_t data_line)
+{
+    uint8_t res;
+    uint8_t poll;
+    w25qxx_bus_t *bus;
+    
+    if ((chip == NULL) || (chip->bus == NULL) || (chip->bus->inited != 1))               /* check handle */
+    {
+        return 1;                                                                        /* return error */
+    }
+    
+    bus = chip->bus;                                                                     /* get bus */
+    poll = a_w25qxx_bus_is_poll(instruction, instruction_line, in_buf, in_len, out_len); /* check poll */
+    if ((poll != 0) && ((chip->status & 0x01) != 0) &&
+        (chip->row < W25QXX_BUS_MAX_DEFER) && (bus->try_lock != NULL))                   /* busy chip poll */
+    {
+        if (bus->try_lock() != 0)                                                        /* bus is taken */
+        {
+            out_buf[0] = chip->status;                                                   /* still busy */
+            chip->row++;                                                                 /* row++ */
+            chip->defer++;                                                               /* defer++ */
+            
+            return 0;                                                                    /* success return 0 */
+        }
+    }
+    else if (bus->lock != NULL)                                                          /* check the hook */
+    {
+        bus->lock();                                                                     /* lock */
+    }
+    else
+    {
+        /* one thread only */
+    }
+    
+    /* the bus is ours for one transfer */
+    res = bus->write_read(chip->cs, instruction, instruction_line,
+                          address, address_line, address_len,
+                          alternate, alternate_line, alternate_len,
+                          dummy, in_buf, in_len, out_buf, out_len, data_line);           /* transfer */
+    bus->stats.transaction++;                                                            /* transaction++ */
+    if (poll != 0)                                                                       /* poll */
+    {
+        bus->stats.poll++;                                                               /* poll++ */
+    }
+    if (bus->unlock != NULL)                                                             /* check the hook */
+    {
+        bus->unlock();                                                                   /* unlock */
+    }
+    if ((poll != 0) && (res == 0))                                                       /* poll done */
+    {
+        chip->status = out_buf[0];                                                       /* save status */
+        chip->row = 0;                                                                   /* clear row */
+    }
+    if (res != 0)                                                                        /* check result */
+    {
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     bus batch of one chip
+ * @param[in] *chip pointer to a w25qxx bus chip structure
+ * @param[in] *transfer pointer to a w25qxx spi transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch failed
+ * @note      call it from the spi_batch hook of the chip handle, the bus lock is held
+ *            for the whole batch, so no frame of another chip goes out between the
+ *            write enable and the command it unlocks
+ */
+uint8_t w25qxx_bus_batch(w25qxx_bus_chip_t *chip, w25qxx_spi_transfer_t *transfer, uint8_t num)
+{
+    uint8_t res;
+    w25qxx_bus_t *bus;
+    
+    if ((chip == NULL) || (chip->bus == NULL) || (chip->bus->inited != 1)) /* check handle */
+    {
+        return 1;                                                          /* return error */
+    }
+    bus = chip->bus;                                                       /* get bus */
+    if (bus->batch == NULL)                                                /* check batch */
+    {
+        return 1;                                                          /* return error */
+    }
+    
+    if (bus->lock != NULL)                                                 /* check the hook */
+    {
+        bus->lock();                                                       /* lock */
+    }
+    res = bus->batch(chip->cs, transfer, num);                             /* batch */
+    bus->stats.transaction += num;                                         /* transaction += num */
+    if (bus->unlock != NULL)                                               /* check the hook */
+    {
+        bus->unlock();                                                     /* unlock */
+    }
+    if (res != 0)                                                          /* check result */
+    {
+        return 1;                                                          /* return error */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *bus pointer to a w25qxx bus structure
+ * @param[out] *stats pointer to a w25qxx bus stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_bus_get_stats(w25qxx_bus_t *bus, w25qxx_bus_stats_t *stats)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_bus_check(bus); /* check handle */
+    if (res != 0)                  /* check result */
+    {
+        return res;                /* return error */
+    }
+    
+    if (bus->lock != NULL)         /* check the hook */
+    {
+        bus->lock();               /* lock */
+    }
+    *stats = bus->stats;           /* copy stats */
+    if (bus->unlock != NULL)       /* check the hook */
+    {
+        bus->unlock();             /* unlock */
+    }
+    
+    return 0;                      /* success return 0 */
+}
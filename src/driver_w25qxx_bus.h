@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_bus.h
+ * @brief     driver w25qxx bus header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_BUS_H
+#define DRIVER_W25QXX_BUS_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_bus_driver w25qxx bus driver function
+ * @brief    w25qxx shared bus arbiter modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx bus max defer definition
+ */
+#ifndef W25QXX_BUS_MAX_DEFER
+    #define W25QXX_BUS_MAX_DEFER        4         /**< polls answered in a row without the bus */
+#endif
+
+/**
+ * @brief w25qxx bus stats structure definition
+ */
+typedef struct w25qxx_bus_stats_s
+{
+    uint32_t transaction;        /**< transfers sent on the bus */
+    uint32_t poll;               /**< status 1 polls sent on the bus */
+} w25qxx_bus_stats_t;
+
+/**
+ * @brief w25qxx bus structure definition
+ */
+typedef struct w25qxx_bus_s
+{
+    uint8_t (*write_read)(uint8_t cs, uint8_t instruction, uint8_t instruction_line,
+                          uint32_t address, uint8_t address_line, uint8_t address_len,
+                          uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                          uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                          uint8_t *out_buf, uint32_t out_len, uint8_t data_line);        /**< bus transfer with a chip select */
+    uint8_t (*batch)(uint8_t cs, w25qxx_spi_transfer_t *transfer, uint8_t num);          /**< bus batch with a chip select */
+    void (*lock)(void);                                                                  /**< bus lock hook */
+    uint8_t (*try_lock)(void);                                                           /**< bus try lock hook, 0 on success */
+    void (*unlock)(void);                                                                /**< bus unlock hook */
+    w25qxx_bus_stats_t stats;                                                            /**< statistics */
+    uint8_t inited;                                                                      /**< inited flag */
+} w25qxx_bus_t;
+
+/**
+ * @brief w25qxx bus chip structure definition
+ */
+typedef struct w25qxx_bus_chip_s
+{
+    w25qxx_bus_t *bus;         /**< shared bus */
+    uint8_t cs;                /**< chip select */
+    uint8_t status;            /**< last status 1 read on the bus */
+    uint8_t row;               /**< polls answered in a row without the bus */
+    uint32_t defer;            /**< polls answered while the bus was taken */
+} w25qxx_bus_chip_t;
+
+/**
+ * @brief     initialize the bus
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *write_read pointer to a bus transfer function selecting the chip by cs
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      write_read takes cs first and then the arguments of the spi_qspi_write_read hook
+ */
+uint8_t w25qxx_bus_init(w25qxx_bus_t *bus,
+                        uint8_t (*write_read)(uint8_t cs, uint8_t instruction, uint8_t instruction_line,
+                                              uint32_t address, uint8_t address_line, uint8_t address_len,
+                                              uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                                              uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                                              uint8_t *out_buf, uint32_t out_len, uint8_t data_line));
+
+/**
+ * @brief     set the bus hooks
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *try_lock pointer to a try lock function returning 0 when locked, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the lock is held for one transfer only, so chips used from different
+ *            threads share the bus transfer by transfer
+ */
+uint8_t w25qxx_bus_set_hooks(w25qxx_bus_t *bus, void (*lock)(void), uint8_t (*try_lock)(void), void (*unlock)(void));
+
+/**
+ * @brief     set the bus batch transfer
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *batch pointer to a bus batch function selecting the chip by cs, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      batch takes cs first and then the arguments of the spi_batch hook
+ */
+uint8_t w25qxx_bus_set_batch(w25qxx_bus_t *bus, uint8_t (*batch)(uint8_t cs, w25qxx_spi_transfer_t *transfer, uint8_t num));
+
+/**
+ * @brief     attach a chip to the bus
+ * @param[in] *bus pointer to a w25qxx bus structure
+ * @param[in] *chip pointer to a w25qxx bus chip structure
+ * @param[in] cs chip select passed to the transfer function
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a chip handle linking a spi_batch hook must send the batch with
+ *            w25qxx_bus_batch, a hook driving the bus itself bypasses the bus lock
+ */
+uint8_t w25qxx_bus_chip_init(w25qxx_bus_t *bus, w25qxx_bus_chip_t *chip, uint8_t cs);
+
+/**
+ * @brief      bus transfer of one chip
+ * @param[in]  *chip pointer to a w25qxx bus chip structure
+ * @param[in]  instruction sent instruction
+ * @param[in]  instruction_line instruction phy lines
+ * @param[in]  address register address
+ * @param[in]  address_line address phy lines
+ * @param[in]  address_len address length
+ * @param[in]  alternate register address
+ * @param[in]  alternate_line alternate phy lines
+ * @param[in]  alternate_len alternate length
+ * @param[in]  dummy dummy cycle
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[in]  out_len output length
+ * @param[in]  data_line data phy lines
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       call it from the spi_qspi_write_read hook of the chip handle, a status 1
+ *             poll of a chip last seen busy is answered with that status when the bus
+ *             is taken by another chip, at most W25QXX_BUS_MAX_DEFER times in a row,
+ *             so the busy wait of one chip doesn't hold the bus against the others
+ */
+uint8_t w25qxx_bus_write_read(w25qxx_bus_chip_t *chip, uint8_t instruction, uint8_t instruction_line,
+                              uint32_t address, uint8_t address_line, uint8_t address_len,
+                              uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+                              uint8_t dummy, uint8_t *in_buf, uint32_t in_len,
+                              uint8_t *out_buf, uint32_t out_len, uint8_t data_line);
+
+/**
+ * @brief     bus batch of one chip
+ * @param[in] *chip pointer to a w25qxx bus chip structure
+ * @param[in] *transfer pointer to a w25qxx spi transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch failed
+ * @note      call it from the spi_batch hook of the chip handle, the bus lock is held
+ *            for the whole batch, so no frame of another chip goes out between the
+ *            write enable and the command it unlocks
+ */
+uint8_t w25qxx_bus_batch(w25qxx_bus_chip_t *chip, w25qxx_spi_transfer_t *transfer, uint8_t num);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *bus pointer to a w25qxx bus structure
+ * @param[out] *stats pointer to a w25qxx bus stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_bus_get_stats(w25qxx_bus_t *bus, w25qxx_bus_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
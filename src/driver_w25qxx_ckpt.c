@@ -0,0 +1,378 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ckpt.c
+ * @brief     driver w25qxx ckpt source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_ckpt.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief ckpt record definition
+ */
+#define W25QXX_CKPT_MAGIC            0x30504B43U        /**< "CKP0" */
+#define W25QXX_CKPT_RECORDS          (256U / W25QXX_CKPT_RECORD_SIZE)
+
+/**
+ * @brief     check a record
+ * @param[in] *rec pointer to a record
+ * @return    sequence, 0 when the record is invalid
+ * @note      none
+ */
+static uint32_t a_w25qxx_ckpt_check_record(const uint8_t *rec)
+{
+    if (w25qxx_util_get32(&rec[0]) != W25QXX_CKPT_MAGIC)                   /* check magic */
+    {
+        return 0;                                                          /* invalid */
+    }
+    if (w25qxx_util_get32(&rec[W25QXX_CKPT_RECORD_SIZE - 4]) !=
+        ~w25qxx_util_crc32(0xFFFFFFFFU, rec, W25QXX_CKPT_RECORD_SIZE - 4)) /* check crc */
+    {
+        return 0;                                                          /* invalid */
+    }
+    
+    return w25qxx_util_get32(&rec[4]);                                     /* return sequence */
+}
+
+/**
+ * @brief     check the ckpt handle
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+static uint8_t a_w25qxx_ckpt_check(w25qxx_ckpt_t *ckpt)
+{
+    if (ckpt == NULL)      /* check handle */
+    {
+        return 2;          /* return error */
+    }
+    if (ckpt->inited != 1) /* check handle initialization */
+    {
+        return 3;          /* return error */
+    }
+    
+    return 0;              /* success return 0 */
+}
+
+/**
+ * @brief     initialize the checkpoint
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] mask used security registers
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 mask is invalid
+ * @note      at least two registers are needed, so the newest checkpoint is never
+ *            in the register being erased, locked registers can't be used
+ */
+uint8_t w25qxx_ckpt_init(w25qxx_ckpt_t *ckpt, w25qxx_handle_t *handle, uint8_t mask)
+{
+    uint8_t count;
+    
+    if ((ckpt == NULL) || (handle == NULL))                /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    if (handle->inited != 1)                               /* check handle initialization */
+    {
+        return 3;                                          /* return error */
+    }
+    
+    memset(ckpt, 0, sizeof(w25qxx_ckpt_t));                /* clear */
+    count = 0;                                             /* init 0 */
+    if ((mask & W25QXX_CKPT_REGISTER_1) != 0)              /* register 1 */
+    {
+        ckpt->reg[count++] = W25QXX_SECURITY_REGISTER_1;   /* add it */
+    }
+    if ((mask & W25QXX_CKPT_REGISTER_2) != 0)              /* register 2 */
+    {
+        ckpt->reg[count++] = W25QXX_SECURITY_REGISTER_2;   /* add it */
+    }
+    if ((mask & W25QXX_CKPT_REGISTER_3) != 0)              /* register 3 */
+    {
+        ckpt->reg[count++] = W25QXX_SECURITY_REGISTER_3;   /* add it */
+    }
+    if ((count < 2) || ((mask & ~0x07) != 0))              /* check mask */
+    {
+        handle->debug_print("w25qxx: mask is invalid.\n"); /* mask is invalid */
+        
+        return 4;                                          /* return error */
+    }
+    ckpt->count = count;                                   /* set count */
+    ckpt->handle = handle;                                 /* set handle */
+    ckpt->inited = 1;                                      /* flag inited */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     deinit the checkpoint
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ckpt_deinit(w25qxx_ckpt_t *ckpt)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ckpt_check(ckpt); /* check handle */
+    if (res != 0)                    /* check result */
+    {
+        return res;                  /* return error */
+    }
+    
+    ckpt->loaded = 0;                /* clear loaded */
+    ckpt->inited = 0;                /* flag closed */
+    
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief     erase all used registers
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ckpt_format(w25qxx_ckpt_t *ckpt)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    res = a_w25qxx_ckpt_check(ckpt);                                                /* check handle */
+    if (res != 0)                                                                   /* check result */
+    {
+        return res;                                                                 /* return error */
+    }
+    
+    ckpt->loaded = 0;                                                               /* clear loaded */
+    for (i = 0; i < ckpt->count; i++)                                               /* erase all registers */
+    {
+        if (w25qxx_erase_security_register(ckpt->handle, ckpt->reg[i]) != 0)        /* erase */
+        {
+            ckpt->handle->debug_print("w25qxx: erase security register failed.\n"); /* erase security register failed */
+            
+            return 1;                                                               /* return error */
+        }
+    }
+    ckpt->seq = 0;                                                                  /* no checkpoint */
+    ckpt->loaded = 1;                                                               /* ready to save */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      load the newest checkpoint
+ * @param[in]  *ckpt pointer to a w25qxx ckpt structure
+ * @param[out] *data pointer to a W25QXX_CKPT_DATA_SIZE bytes buffer
+ * @param[out] *generation pointer to a generation buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 no checkpoint
+ * @note       one 256 bytes read per used register, a record with a bad crc is skipped
+ */
+uint8_t w25qxx_ckpt_load(w25qxx_ckpt_t *ckpt, uint8_t *data, uint32_t *generation)
+{
+    uint8_t res;
+    uint8_t i;
+    uint32_t j;
+    uint32_t seq;
+    
+    res = a_w25qxx_ckpt_check(ckpt);                                                   /* check handle */
+    if (res != 0)                                                                      /* check result */
+    {
+        return res;                                                                    /* return error */
+    }
+    if ((data == NULL) || (generation == NULL))                                        /* check buffer */
+    {
+        return 2;                                                                      /* return error */
+    }
+    
+    ckpt->loaded = 0;                                                                  /* clear loaded */
+    ckpt->seq = 0;                                                                     /* no checkpoint */
+    for (i = 0; i < ckpt->count; i++)                                                  /* read all registers */
+    {
+        if (w25qxx_read_security_register(ckpt->handle, ckpt->reg[i], ckpt->buf) != 0) /* read */
+        {
+            ckpt->handle->debug_print("w25qxx: read security register failed.\n");     /* read security register failed */
+            
+            return 1;                                                                  /* return error */
+        }
+        for (j = 0; j < W25QXX_CKPT_RECORDS; j++)                                      /* check all records */
+        {
+            seq = a_w25qxx_ckpt_check_record(&ckpt->buf[j * W25QXX_CKPT_RECORD_SIZE]); /* check record */
+            if ((seq != 0) && (seq > ckpt->seq))                                       /* newer */
+            {
+                ckpt->seq = seq;                                                       /* save sequence */
+                memcpy(data, &ckpt->buf[j * W25QXX_CKPT_RECORD_SIZE + 8],
+                       W25QXX_CKPT_DATA_SIZE);                                         /* copy data */
+            }
+        }
+    }
+    ckpt->loaded = 1;                                                                  /* ready to save */
+    if (ckpt->seq == 0)                                                                /* nothing found */
+    {
+        ckpt->handle->debug_print("w25qxx: no checkpoint.\n");                         /* no checkpoint */
+        
+        return 5;                                                                      /* return error */
+    }
+    *generation = ckpt->seq;                                                           /* set generation */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     save a new checkpoint
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @param[in] *data pointer to a W25QXX_CKPT_DATA_SIZE bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 save failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 checkpoint is not loaded
+ *            - 5 verify failed
+ * @note      records rotate over the used registers, a register is erased when the
+ *            rotation reaches its first record, the older checkpoints stay readable
+ */
+uint8_t w25qxx_ckpt_save(w25qxx_ckpt_t *ckpt, const uint8_t *data)
+{
+    uint8_t res;
+    uint8_t *rec;
+    uint32_t seq;
+    uint32_t pos;
+    uint32_t reg;
+    uint32_t slot;
+    uint32_t i;
+    
+    res = a_w25qxx_ckpt_check(ckpt);                                                          /* check handle */
+    if (res != 0)                                                                             /* check result */
+    {
+        return res;                                                                           /* return error */
+    }
+    if (data == NULL)                                                                         /* check data */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (ckpt->loaded != 1)                                                                    /* check loaded */
+    {
+        ckpt->handle->debug_print("w25qxx: checkpoint is not loaded.\n");                     /* checkpoint is not loaded */
+        
+        return 4;                                                                             /* return error */
+    }
+    
+    seq = ckpt->seq;                                                                          /* newest sequence */
+    while (1)                                                                                 /* find a blank record */
+    {
+        seq++;                                                                                /* next sequence */
+        if (seq == 0)                                                                         /* 0 is never used */
+        {
+            seq = 1;                                                                          /* set 1 */
+        }
+        pos = (seq - 1) % (ckpt->count * W25QXX_CKPT_RECORDS);                                /* rotation position */
+        reg = pos / W25QXX_CKPT_RECORDS;                                                      /* register */
+        slot = pos % W25QXX_CKPT_RECORDS;                                                     /* record */
+        if (slot == 0)                                                                        /* first record */
+        {
+            if (w25qxx_erase_security_register(ckpt->handle, ckpt->reg[reg]) != 0)            /* erase the oldest */
+            {
+                ckpt->handle->debug_print("w25qxx: erase security register failed.\n");       /* erase security register failed */
+                
+                return 1;                                                                     /* return error */
+            }
+            
+            break;                                                                            /* break */
+        }
+        if (w25qxx_read_security_register(ckpt->handle, ckpt->reg[reg], ckpt->buf) != 0)      /* read */
+        {
+            ckpt->handle->debug_print("w25qxx: read security register failed.\n");            /* read security register failed */
+            
+            return 1;                                                                         /* return error */
+        }
+        rec = &ckpt->buf[slot * W25QXX_CKPT_RECORD_SIZE];                                     /* record */
+        for (i = 0; i < W25QXX_CKPT_RECORD_SIZE; i++)                                         /* check blank */
+        {
+            if (rec[i] != 0xFF)                                                               /* torn record */
+            {
+                break;                                                                        /* break */
+            }
+        }
+        if (i == W25QXX_CKPT_RECORD_SIZE)                                                     /* blank */
+        {
+            break;                                                                            /* break */
+        }
+    }
+    
+    memset(ckpt->buf, 0xFF, 256);                                                             /* other records unchanged */
+    rec = &ckpt->buf[slot * W25QXX_CKPT_RECORD_SIZE];                                         /* record */
+    w25qxx_util_put32(&rec[0], W25QXX_CKPT_MAGIC);                                            /* set magic */
+    w25qxx_util_put32(&rec[4], seq);                                                          /* set sequence */
+    memcpy(&rec[8], data, W25QXX_CKPT_DATA_SIZE);                                             /* set data */
+    w25qxx_util_put32(&rec[W25QXX_CKPT_RECORD_SIZE - 4],
+                        ~w25qxx_util_crc32(0xFFFFFFFFU, rec, W25QXX_CKPT_RECORD_SIZE - 4));   /* set crc */
+    if (w25qxx_program_security_register(ckpt->handle, ckpt->reg[reg], ckpt->buf) != 0)       /* program */
+    {
+        ckpt->handle->debug_print("w25qxx: program security register failed.\n");             /* program security register failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    ckpt->seq = seq;                                                                          /* a torn record is skipped next time */
+    if (w25qxx_read_security_register(ckpt->handle, ckpt->reg[reg], ckpt->buf) != 0)          /* read back */
+    {
+        ckpt->handle->debug_print("w25qxx: read security register failed.\n");                /* read security register failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    if (a_w25qxx_ckpt_check_record(&ckpt->buf[slot * W25QXX_CKPT_RECORD_SIZE]) != seq)        /* verify */
+    {
+        ckpt->handle->debug_print("w25qxx: verify failed.\n");                                /* verify failed */
+        
+        return 5;                                                                             /* return error */
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
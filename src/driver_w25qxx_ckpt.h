@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ckpt.h
+ * @brief     driver w25qxx ckpt header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_CKPT_H
+#define DRIVER_W25QXX_CKPT_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_ckpt_driver w25qxx ckpt driver function
+ * @brief    w25qxx security register checkpoint modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx ckpt record definition
+ */
+#define W25QXX_CKPT_RECORD_SIZE      64U        /**< record size, 4 records per security register */
+#define W25QXX_CKPT_DATA_SIZE        52U        /**< user data bytes per checkpoint */
+
+/**
+ * @brief w25qxx ckpt register mask definition
+ */
+#define W25QXX_CKPT_REGISTER_1       (1 << 0)   /**< use security register 1 */
+#define W25QXX_CKPT_REGISTER_2       (1 << 1)   /**< use security register 2 */
+#define W25QXX_CKPT_REGISTER_3       (1 << 2)   /**< use security register 3 */
+
+/**
+ * @brief w25qxx ckpt structure definition
+ */
+typedef struct w25qxx_ckpt_s
+{
+    w25qxx_handle_t *handle;           /**< w25qxx handle */
+    w25qxx_security_register_t reg[3]; /**< used registers */
+    uint8_t count;                     /**< used register count */
+    uint32_t seq;                      /**< newest checkpoint sequence */
+    uint8_t buf[256];                  /**< register buffer */
+    uint8_t loaded;                    /**< loaded flag */
+    uint8_t inited;                    /**< inited flag */
+} w25qxx_ckpt_t;
+
+/**
+ * @brief     initialize the checkpoint
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] mask used security registers
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 mask is invalid
+ * @note      at least two registers are needed, so the newest checkpoint is never
+ *            in the register being erased, locked registers can't be used
+ */
+uint8_t w25qxx_ckpt_init(w25qxx_ckpt_t *ckpt, w25qxx_handle_t *handle, uint8_t mask);
+
+/**
+ * @brief     deinit the checkpoint
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ckpt_deinit(w25qxx_ckpt_t *ckpt);
+
+/**
+ * @brief     erase all used registers
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ckpt_format(w25qxx_ckpt_t *ckpt);
+
+/**
+ * @brief      load the newest checkpoint
+ * @param[in]  *ckpt pointer to a w25qxx ckpt structure
+ * @param[out] *data pointer to a W25QXX_CKPT_DATA_SIZE bytes buffer
+ * @param[out] *generation pointer to a generation buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 no checkpoint
+ * @note       one 256 bytes read per used register, a record with a bad crc is skipped
+ */
+uint8_t w25qxx_ckpt_load(w25qxx_ckpt_t *ckpt, uint8_t *data, uint32_t *generation);
+
+/**
+ * @brief     save a new checkpoint
+ * @param[in] *ckpt pointer to a w25qxx ckpt structure
+ * @param[in] *data pointer to a W25QXX_CKPT_DATA_SIZE bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 save failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 checkpoint is not loaded
+ *            - 5 verify failed
+ * @note      records rotate over the used registers, a register is erased when the
+ *            rotation reaches its first record, the older checkpoints stay readable
+ */
+uint8_t w25qxx_ckpt_save(w25qxx_ckpt_t *ckpt, const uint8_t *data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,988 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ftl.c
+ * @brief     driver w25qxx ftl source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_ftl.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief ftl journal definition
+ */
+#define W25QXX_FTL_MAGIC              0x304C5446U        /**< "FTL0" */
+#define W25QXX_FTL_SECTOR_SIZE        4096U              /**< sector size */
+#define W25QXX_FTL_HEADER_SIZE        16U                /**< journal header size */
+#define W25QXX_FTL_ENTRY_SIZE         8U                 /**< journal entry size */
+#define W25QXX_FTL_UNMAPPED           0xFFFFU            /**< unmapped logical sector */
+#define W25QXX_FTL_ERASE              0xFFFEU            /**< erase entry tag */
+
+/**
+ * @brief ftl sector info definition
+ */
+#define W25QXX_FTL_INFO_COUNT         0x0FFFFFFFU        /**< erase count */
+#define W25QXX_FTL_INFO_DIRTY         0x80000000U        /**< sector is not erased */
+#define W25QXX_FTL_INFO_USED          0x40000000U        /**< sector is mapped */
+#define W25QXX_FTL_INFO_VERIFIED      0x20000000U        /**< sector is known blank since mount */
+
+/**
+ * @brief     get the physical sector address
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] physical physical sector
+ * @return    address
+ * @note      the first two sectors hold the journal
+ */
+static uint32_t a_w25qxx_ftl_addr(w25qxx_ftl_t *ftl, uint32_t physical)
+{
+    return ftl->addr + (physical + 2) * W25QXX_FTL_SECTOR_SIZE; /* return address */
+}
+
+/**
+ * @brief     get one byte of the snapshot stream
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] i byte index
+ * @return    byte
+ * @note      the map as uint16, then the erase count and dirty bit of every sector as uint32
+ */
+static uint8_t a_w25qxx_ftl_stream_get(w25qxx_ftl_t *ftl, uint32_t i)
+{
+    uint32_t value;
+    
+    if (i < ftl->logical_count * 2)                                             /* map part */
+    {
+        return (uint8_t)(ftl->map[i / 2] >> (8 * (i % 2)));                     /* return map byte */
+    }
+    i -= ftl->logical_count * 2;                                                /* info part */
+    value = ftl->info[i / 4] & (W25QXX_FTL_INFO_COUNT | W25QXX_FTL_INFO_DIRTY); /* persisted bits */
+    
+    return (uint8_t)(value >> (8 * (i % 4)));                                   /* return info byte */
+}
+
+/**
+ * @brief     set one byte of the snapshot stream
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] i byte index
+ * @param[in] byte set byte
+ * @note      none
+ */
+static void a_w25qxx_ftl_stream_set(w25qxx_ftl_t *ftl, uint32_t i, uint8_t byte)
+{
+    uint8_t shift;
+    
+    if (i < ftl->logical_count * 2)                                                        /* map part */
+    {
+        shift = (uint8_t)(8 * (i % 2));                                                    /* get shift */
+        ftl->map[i / 2] = (uint16_t)((ftl->map[i / 2] & ~(0xFFU << shift)) |
+                                     ((uint16_t)byte << shift));                           /* set map byte */
+        
+        return;                                                                            /* return */
+    }
+    i -= ftl->logical_count * 2;                                                           /* info part */
+    shift = (uint8_t)(8 * (i % 4));                                                        /* get shift */
+    ftl->info[i / 4] = (ftl->info[i / 4] & ~(0xFFU << shift)) | ((uint32_t)byte << shift); /* set info byte */
+}
+
+/**
+ * @brief     write a snapshot into the other journal sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the header is programmed last, so a torn snapshot is never loaded
+ */
+static uint8_t a_w25qxx_ftl_snapshot(w25qxx_ftl_t *ftl)
+{
+    uint8_t journal;
+    uint32_t base;
+    uint32_t pos;
+    uint32_t end;
+    uint32_t len;
+    uint32_t i;
+    uint32_t crc;
+    
+    journal = (uint8_t)(1 - ftl->journal);                                                /* other journal */
+    base = ftl->addr + journal * W25QXX_FTL_SECTOR_SIZE;                                  /* get address */
+    if (w25qxx_sector_erase_4k(ftl->handle, base) != 0)                                   /* sector erase */
+    {
+        ftl->handle->debug_print("w25qxx: sector erase 4k failed.\n");                    /* sector erase 4k failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    crc = 0xFFFFFFFFU;                                                                    /* init crc */
+    end = W25QXX_FTL_HEADER_SIZE + ftl->logical_count * 2 + ftl->physical_count * 4;      /* get end */
+    for (pos = W25QXX_FTL_HEADER_SIZE; pos < end; pos += len)                             /* loop all pages */
+    {
+        len = 256 - (pos % 256);                                                          /* get page remain */
+        if (len > end - pos)                                                              /* check length */
+        {
+            len = end - pos;                                                              /* set length */
+        }
+        for (i = 0; i < len; i++)                                                         /* fill the page */
+        {
+            ftl->buf[i] = a_w25qxx_ftl_stream_get(ftl, pos - W25QXX_FTL_HEADER_SIZE + i); /* get byte */
+        }
+        crc = w25qxx_util_crc32(crc, ftl->buf, len);                                      /* update crc */
+        if (w25qxx_page_program(ftl->handle, base + pos, ftl->buf, (uint16_t)len) != 0)   /* page program */
+        {
+            ftl->handle->debug_print("w25qxx: page program failed.\n");                   /* page program failed */
+            
+            return 1;                                                                     /* return error */
+        }
+    }
+    
+    ftl->seq++;                                                                           /* seq++ */
+    w25qxx_util_put32(&ftl->buf[0], W25QXX_FTL_MAGIC);                                    /* set magic */
+    w25qxx_util_put32(&ftl->buf[4], ftl->seq);                                            /* set sequence */
+    w25qxx_util_put32(&ftl->buf[8], ~ftl->seq);                                           /* set inverted sequence */
+    w25qxx_util_put32(&ftl->buf[12], crc ^ 0xFFFFFFFFU);                                  /* set crc */
+    if (w25qxx_page_program(ftl->handle, base, ftl->buf, W25QXX_FTL_HEADER_SIZE) != 0)    /* program header */
+    {
+        ftl->handle->debug_print("w25qxx: page program failed.\n");                       /* page program failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    ftl->journal = journal;                                                               /* switch journal */
+    ftl->offset = ftl->entry_start;                                                       /* first entry */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     commit one change to the journal
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] tag logical sector or erase tag
+ * @param[in] physical physical sector
+ * @return    status code
+ *            - 0 success
+ *            - 1 commit failed
+ * @note      the ram state must already hold the change, a full journal is replaced by a new snapshot
+ */
+static uint8_t a_w25qxx_ftl_commit(w25qxx_ftl_t *ftl, uint16_t tag, uint16_t physical)
+{
+    uint8_t entry[W25QXX_FTL_ENTRY_SIZE];
+    
+    if ((ftl->offset + W25QXX_FTL_ENTRY_SIZE) > W25QXX_FTL_SECTOR_SIZE)                     /* journal is full */
+    {
+        return a_w25qxx_ftl_snapshot(ftl);                                                  /* write snapshot */
+    }
+    
+    entry[0] = (uint8_t)(tag >> 0);                                                         /* set tag */
+    entry[1] = (uint8_t)(tag >> 8);                                                         /* set tag */
+    entry[2] = (uint8_t)(physical >> 0);                                                    /* set physical */
+    entry[3] = (uint8_t)(physical >> 8);                                                    /* set physical */
+    w25qxx_util_put32(&entry[4], w25qxx_util_crc32(0xFFFFFFFFU, entry, 4) ^ 0xFFFFFFFFU);   /* set crc */
+    if (w25qxx_page_program(ftl->handle, ftl->addr + ftl->journal * W25QXX_FTL_SECTOR_SIZE + ftl->offset,
+                            entry, W25QXX_FTL_ENTRY_SIZE) != 0)                             /* program entry */
+    {
+        ftl->handle->debug_print("w25qxx: page program failed.\n");                         /* page program failed */
+        ftl->offset += W25QXX_FTL_ENTRY_SIZE;                                               /* skip the torn entry */
+        
+        return 1;                                                                           /* return error */
+    }
+    ftl->offset += W25QXX_FTL_ENTRY_SIZE;                                                   /* next entry */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     apply one journal entry
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] tag logical sector or erase tag
+ * @param[in] physical physical sector
+ * @note      none
+ */
+static void a_w25qxx_ftl_apply(w25qxx_ftl_t *ftl, uint16_t tag, uint16_t physical)
+{
+    uint16_t old;
+    
+    if (tag == W25QXX_FTL_ERASE)                                                  /* erase entry */
+    {
+        if (physical < ftl->physical_count)                                       /* check physical */
+        {
+            ftl->info[physical] = (ftl->info[physical] & ~W25QXX_FTL_INFO_DIRTY &
+                                   ~W25QXX_FTL_INFO_COUNT) |
+                                  (((ftl->info[physical] & W25QXX_FTL_INFO_COUNT) + 1) &
+                                   W25QXX_FTL_INFO_COUNT);                        /* count++ and clean */
+        }
+        
+        return;                                                                   /* return */
+    }
+    if ((tag >= ftl->logical_count) ||
+        ((physical != W25QXX_FTL_UNMAPPED) && (physical >= ftl->physical_count))) /* check entry */
+    {
+        return;                                                                   /* return */
+    }
+    old = ftl->map[tag];                                                          /* get old sector */
+    if (old != W25QXX_FTL_UNMAPPED)                                               /* check old sector */
+    {
+        ftl->info[old] &= ~W25QXX_FTL_INFO_USED;                                  /* old sector is stale */
+    }
+    ftl->map[tag] = physical;                                                     /* set map */
+    if (physical != W25QXX_FTL_UNMAPPED)                                          /* check physical */
+    {
+        ftl->info[physical] |= W25QXX_FTL_INFO_USED | W25QXX_FTL_INFO_DIRTY;      /* set used */
+    }
+}
+
+/**
+ * @brief     erase a physical sector and commit it
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] physical physical sector
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ * @note      none
+ */
+static uint8_t a_w25qxx_ftl_erase(w25qxx_ftl_t *ftl, uint16_t physical)
+{
+    if (w25qxx_sector_erase_4k(ftl->handle, a_w25qxx_ftl_addr(ftl, physical)) != 0) /* sector erase */
+    {
+        ftl->handle->debug_print("w25qxx: sector erase 4k failed.\n");              /* sector erase 4k failed */
+        
+        return 1;                                                                   /* return error */
+    }
+    a_w25qxx_ftl_apply(ftl, W25QXX_FTL_ERASE, physical);                            /* update ram state */
+    ftl->info[physical] |= W25QXX_FTL_INFO_VERIFIED;                                /* known blank */
+    
+    return a_w25qxx_ftl_commit(ftl, W25QXX_FTL_ERASE, physical);                    /* commit erase */
+}
+
+/**
+ * @brief      find the least erased free sector
+ * @param[in]  *ftl pointer to a w25qxx ftl structure
+ * @param[in]  dirty 1 for a stale sector, 0 for an erased sector
+ * @param[out] *physical pointer to a physical sector buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not found
+ * @note       none
+ */
+static uint8_t a_w25qxx_ftl_find_free(w25qxx_ftl_t *ftl, uint8_t dirty, uint16_t *physical)
+{
+    uint32_t i;
+    uint32_t best;
+    uint32_t count;
+    uint32_t min;
+    
+    best = ftl->physical_count;                                            /* init not found */
+    min = 0xFFFFFFFFU;                                                     /* init max */
+    for (i = 0; i < ftl->physical_count; i++)                              /* loop all sectors */
+    {
+        if ((ftl->info[i] & W25QXX_FTL_INFO_USED) != 0)                    /* skip used */
+        {
+            continue;                                                      /* next */
+        }
+        if (((ftl->info[i] & W25QXX_FTL_INFO_DIRTY) != 0) != (dirty != 0)) /* check state */
+        {
+            continue;                                                      /* next */
+        }
+        count = ftl->info[i] & W25QXX_FTL_INFO_COUNT;                      /* get count */
+        if (count < min)                                                   /* less erased */
+        {
+            min = count;                                                   /* set min */
+            best = i;                                                      /* set best */
+        }
+    }
+    if (best == ftl->physical_count)                                       /* check result */
+    {
+        return 1;                                                          /* return error */
+    }
+    *physical = (uint16_t)best;                                            /* set physical */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      allocate an erased sector
+ * @param[in]  *ftl pointer to a w25qxx ftl structure
+ * @param[out] *physical pointer to a physical sector buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 allocate failed
+ *             - 6 no free sector
+ * @note       a sector erased before the last mount is checked blank once,
+ *             it may hold data of a write whose journal entry was lost
+ */
+static uint8_t a_w25qxx_ftl_alloc(w25qxx_ftl_t *ftl, uint16_t *physical)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t addr;
+    
+    if (a_w25qxx_ftl_find_free(ftl, 0, physical) != 0)              /* no erased sector */
+    {
+        if (a_w25qxx_ftl_find_free(ftl, 1, physical) != 0)          /* no stale sector */
+        {
+            ftl->handle->debug_print("w25qxx: no free sector.\n");  /* no free sector */
+            
+            return 6;                                               /* return error */
+        }
+        
+        return a_w25qxx_ftl_erase(ftl, *physical);                  /* erase it now */
+    }
+    if ((ftl->info[*physical] & W25QXX_FTL_INFO_VERIFIED) != 0)     /* known blank */
+    {
+        return 0;                                                   /* success return 0 */
+    }
+    
+    addr = a_w25qxx_ftl_addr(ftl, *physical);                       /* get address */
+    for (i = 0; i < W25QXX_FTL_SECTOR_SIZE; i += 256)               /* loop all pages */
+    {
+        if (w25qxx_read(ftl->handle, addr + i, ftl->buf, 256) != 0) /* read page */
+        {
+            ftl->handle->debug_print("w25qxx: read failed.\n");     /* read failed */
+            
+            return 1;                                               /* return error */
+        }
+        for (j = 0; j < 256; j++)                                   /* check all bytes */
+        {
+            if (ftl->buf[j] != 0xFF)                                /* not blank */
+            {
+                return a_w25qxx_ftl_erase(ftl, *physical);          /* erase it */
+            }
+        }
+    }
+    ftl->info[*physical] |= W25QXX_FTL_INFO_VERIFIED;               /* known blank */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     initialize the ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] *map pointer to a map buffer
+ * @param[in] map_size map entries
+ * @param[in] *info pointer to a sector info buffer
+ * @param[in] info_size info entries
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 buffer is too small
+ * @note      map holds W25QXX_FTL_LOGICAL_COUNT(len) entries and info holds W25QXX_FTL_PHYSICAL_COUNT(len) entries,
+ *            the snapshot of both must fit in one journal sector
+ */
+uint8_t w25qxx_ftl_init(w25qxx_ftl_t *ftl, w25qxx_handle_t *handle, uint32_t addr, uint32_t len,
+                        uint16_t *map, uint32_t map_size, uint32_t *info, uint32_t info_size)
+{
+    uint32_t logical_count;
+    uint32_t physical_count;
+    uint32_t entry_start;
+    
+    if ((ftl == NULL) || (handle == NULL) || (map == NULL) || (info == NULL))                  /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if ((addr % W25QXX_FTL_SECTOR_SIZE) != 0)                                                  /* check address */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");                                     /* addr is invalid */
+        
+        return 4;                                                                              /* return error */
+    }
+    if (((len % W25QXX_FTL_SECTOR_SIZE) != 0) ||
+        ((len / W25QXX_FTL_SECTOR_SIZE) <= (2U + W25QXX_FTL_SPARE)) ||
+        ((len / W25QXX_FTL_SECTOR_SIZE) > 0xFFF0U))                                            /* check length */
+    {
+        handle->debug_print("w25qxx: len is invalid.\n");                                      /* len is invalid */
+        
+        return 5;                                                                              /* return error */
+    }
+    logical_count = W25QXX_FTL_LOGICAL_COUNT(len);                                             /* get logical count */
+    physical_count = W25QXX_FTL_PHYSICAL_COUNT(len);                                           /* get physical count */
+    entry_start = (W25QXX_FTL_HEADER_SIZE + logical_count * 2 + physical_count * 4 +
+                   W25QXX_FTL_ENTRY_SIZE - 1) / W25QXX_FTL_ENTRY_SIZE * W25QXX_FTL_ENTRY_SIZE; /* get entry start */
+    if ((entry_start + W25QXX_FTL_MIN_ENTRY * W25QXX_FTL_ENTRY_SIZE) > W25QXX_FTL_SECTOR_SIZE) /* check snapshot size */
+    {
+        handle->debug_print("w25qxx: len is invalid.\n");                                      /* len is invalid */
+        
+        return 5;                                                                              /* return error */
+    }
+    if ((map_size < logical_count) || (info_size < physical_count))                            /* check buffer */
+    {
+        handle->debug_print("w25qxx: buffer is too small.\n");                                 /* buffer is too small */
+        
+        return 6;                                                                              /* return error */
+    }
+    
+    memset(ftl, 0, sizeof(w25qxx_ftl_t));                                                      /* clear ftl */
+    ftl->handle = handle;                                                                      /* set handle */
+    ftl->map = map;                                                                            /* set map */
+    ftl->info = info;                                                                          /* set info */
+    ftl->addr = addr;                                                                          /* set address */
+    ftl->logical_count = logical_count;                                                        /* set logical count */
+    ftl->physical_count = physical_count;                                                      /* set physical count */
+    ftl->entry_start = entry_start;                                                            /* set entry start */
+    ftl->inited = 1;                                                                           /* set inited */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     deinit the ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ftl_deinit(w25qxx_ftl_t *ftl)
+{
+    if (ftl == NULL)      /* check handle */
+    {
+        return 2;         /* return error */
+    }
+    if (ftl->inited != 1) /* check handle initialization */
+    {
+        return 3;         /* return error */
+    }
+    
+    ftl->mounted = 0;     /* clear mounted */
+    ftl->inited = 0;      /* clear inited */
+    
+    return 0;             /* success return 0 */
+}
+
+/**
+ * @brief     start an empty ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      only the journal is erased, data sectors are erased lazily before their first use
+ */
+uint8_t w25qxx_ftl_format(w25qxx_ftl_t *ftl)
+{
+    uint32_t i;
+    
+    if (ftl == NULL)                                                   /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (ftl->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    ftl->mounted = 0;                                                  /* clear mounted */
+    for (i = 0; i < ftl->logical_count; i++)                           /* loop all logical sectors */
+    {
+        ftl->map[i] = W25QXX_FTL_UNMAPPED;                             /* unmapped */
+    }
+    for (i = 0; i < ftl->physical_count; i++)                          /* loop all physical sectors */
+    {
+        ftl->info[i] = W25QXX_FTL_INFO_DIRTY;                          /* content unknown */
+    }
+    if (w25qxx_sector_erase_4k(ftl->handle, ftl->addr) != 0)           /* erase journal 0 */
+    {
+        ftl->handle->debug_print("w25qxx: sector erase 4k failed.\n"); /* sector erase 4k failed */
+        
+        return 1;                                                      /* return error */
+    }
+    ftl->seq = 0;                                                      /* reset sequence */
+    ftl->journal = 0;                                                  /* snapshot goes to journal 1 */
+    if (a_w25qxx_ftl_snapshot(ftl) != 0)                               /* write snapshot */
+    {
+        return 1;                                                      /* return error */
+    }
+    ftl->mounted = 1;                                                  /* set mounted */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      check one journal sector
+ * @param[in]  *ftl pointer to a w25qxx ftl structure
+ * @param[in]  journal journal sector
+ * @param[out] *seq pointer to a sequence buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 journal is invalid
+ * @note       none
+ */
+static uint8_t a_w25qxx_ftl_check_journal(w25qxx_ftl_t *ftl, uint8_t journal, uint32_t *seq)
+{
+    uint32_t base;
+    uint32_t pos;
+    uint32_t end;
+    uint32_t len;
+    uint32_t crc;
+    uint32_t stored;
+    
+    base = ftl->addr + journal * W25QXX_FTL_SECTOR_SIZE;                             /* get address */
+    if (w25qxx_read(ftl->handle, base, ftl->buf, W25QXX_FTL_HEADER_SIZE) != 0)       /* read header */
+    {
+        ftl->handle->debug_print("w25qxx: read failed.\n");                          /* read failed */
+        
+        return 1;                                                                    /* return error */
+    }
+    *seq = w25qxx_util_get32(&ftl->buf[4]);                                          /* get sequence */
+    if ((w25qxx_util_get32(&ftl->buf[0]) != W25QXX_FTL_MAGIC) ||
+        (w25qxx_util_get32(&ftl->buf[8]) != (uint32_t)~(*seq)))                      /* check header */
+    {
+        return 4;                                                                    /* return error */
+    }
+    stored = w25qxx_util_get32(&ftl->buf[12]);                                       /* get crc */
+    crc = 0xFFFFFFFFU;                                                               /* init crc */
+    end = W25QXX_FTL_HEADER_SIZE + ftl->logical_count * 2 + ftl->physical_count * 4; /* get end */
+    for (pos = W25QXX_FTL_HEADER_SIZE; pos < end; pos += len)                        /* loop the snapshot */
+    {
+        len = (end - pos > 256) ? 256 : (end - pos);                                 /* get length */
+        if (w25qxx_read(ftl->handle, base + pos, ftl->buf, len) != 0)                /* read data */
+        {
+            ftl->handle->debug_print("w25qxx: read failed.\n");                      /* read failed */
+            
+            return 1;                                                                /* return error */
+        }
+        crc = w25qxx_util_crc32(crc, ftl->buf, len);                                 /* update crc */
+    }
+    if ((crc ^ 0xFFFFFFFFU) != stored)                                               /* check crc */
+    {
+        return 4;                                                                    /* return error */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     mount the ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no valid journal
+ * @note      the newest valid snapshot is loaded and its delta entries are replayed
+ */
+uint8_t w25qxx_ftl_mount(w25qxx_ftl_t *ftl)
+{
+    uint8_t res;
+    uint8_t valid;
+    uint8_t journal;
+    uint8_t blank;
+    uint32_t seq[2];
+    uint32_t base;
+    uint32_t pos;
+    uint32_t end;
+    uint32_t len;
+    uint32_t i;
+    uint32_t j;
+    uint16_t tag;
+    uint16_t physical;
+    
+    if (ftl == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (ftl->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    ftl->mounted = 0;                                                                    /* clear mounted */
+    valid = 0;                                                                           /* init 0 */
+    for (i = 0; i < 2; i++)                                                              /* check both journals */
+    {
+        res = a_w25qxx_ftl_check_journal(ftl, (uint8_t)i, &seq[i]);                      /* check journal */
+        if (res == 1)                                                                    /* check result */
+        {
+            return 1;                                                                    /* return error */
+        }
+        if (res == 0)                                                                    /* valid */
+        {
+            valid |= (uint8_t)(1 << i);                                                  /* set valid */
+        }
+    }
+    if (valid == 0)                                                                      /* check valid */
+    {
+        ftl->handle->debug_print("w25qxx: no valid journal.\n");                         /* no valid journal */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (valid == 3)                                                                      /* both are valid */
+    {
+        journal = ((int32_t)(seq[1] - seq[0]) > 0) ? 1 : 0;                              /* newer one */
+    }
+    else
+    {
+        journal = (valid == 2) ? 1 : 0;                                                  /* the valid one */
+    }
+    
+    /* load the snapshot */
+    base = ftl->addr + journal * W25QXX_FTL_SECTOR_SIZE;                                 /* get address */
+    end = W25QXX_FTL_HEADER_SIZE + ftl->logical_count * 2 + ftl->physical_count * 4;     /* get end */
+    for (pos = W25QXX_FTL_HEADER_SIZE; pos < end; pos += len)                            /* loop the snapshot */
+    {
+        len = (end - pos > 256) ? 256 : (end - pos);                                     /* get length */
+        if (w25qxx_read(ftl->handle, base + pos, ftl->buf, len) != 0)                    /* read data */
+        {
+            ftl->handle->debug_print("w25qxx: read failed.\n");                          /* read failed */
+            
+            return 1;                                                                    /* return error */
+        }
+        for (i = 0; i < len; i++)                                                        /* loop all bytes */
+        {
+            a_w25qxx_ftl_stream_set(ftl, pos - W25QXX_FTL_HEADER_SIZE + i, ftl->buf[i]); /* set byte */
+        }
+    }
+    for (i = 0; i < ftl->physical_count; i++)                                            /* loop all sectors */
+    {
+        ftl->info[i] &= W25QXX_FTL_INFO_COUNT | W25QXX_FTL_INFO_DIRTY;                   /* keep persisted bits */
+    }
+    for (i = 0; i < ftl->logical_count; i++)                                             /* rebuild used bits */
+    {
+        if (ftl->map[i] >= ftl->physical_count)                                          /* check map */
+        {
+            ftl->map[i] = W25QXX_FTL_UNMAPPED;                                           /* unmapped */
+        }
+        else
+        {
+            ftl->info[ftl->map[i]] |= W25QXX_FTL_INFO_USED;                              /* set used */
+        }
+    }
+    
+    /* replay the entries */
+    ftl->journal = journal;                                                              /* set journal */
+    ftl->seq = seq[journal];                                                             /* set sequence */
+    ftl->offset = ftl->entry_start;                                                      /* first entry */
+    for (pos = ftl->entry_start; pos < W25QXX_FTL_SECTOR_SIZE; pos += len)               /* loop all entries */
+    {
+        len = 256 - (pos % 256);                                                         /* read to the page end */
+        if (w25qxx_read(ftl->handle, base + pos, ftl->buf, len) != 0)                    /* read data */
+        {
+            ftl->handle->debug_print("w25qxx: read failed.\n");                          /* read failed */
+            
+            return 1;                                                                    /* return error */
+        }
+        for (i = 0; i < len; i += W25QXX_FTL_ENTRY_SIZE)                                 /* loop the entries */
+        {
+            blank = 1;                                                                   /* init blank */
+            for (j = 0; j < W25QXX_FTL_ENTRY_SIZE; j++)                                  /* check blank */
+            {
+                if (ftl->buf[i + j] != 0xFF)                                             /* not blank */
+                {
+                    blank = 0;                                                           /* set not blank */
+                }
+            }
+            if (blank != 0)                                                              /* end of journal */
+            {
+                ftl->mounted = 1;                                                        /* set mounted */
+                
+                return 0;                                                                /* success return 0 */
+            }
+            ftl->offset = pos + i + W25QXX_FTL_ENTRY_SIZE;                               /* next entry */
+            if ((w25qxx_util_crc32(0xFFFFFFFFU, &ftl->buf[i], 4) ^ 0xFFFFFFFFU) !=
+                w25qxx_util_get32(&ftl->buf[i + 4]))                                     /* torn entry */
+            {
+                continue;                                                                /* skip it */
+            }
+            tag = (uint16_t)(ftl->buf[i + 0] | ((uint16_t)ftl->buf[i + 1] << 8));        /* get tag */
+            physical = (uint16_t)(ftl->buf[i + 2] | ((uint16_t)ftl->buf[i + 3] << 8));   /* get physical */
+            a_w25qxx_ftl_apply(ftl, tag, physical);                                      /* apply entry */
+        }
+    }
+    ftl->mounted = 1;                                                                    /* set mounted */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     check the logical sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] logical logical sector
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 logical sector is invalid
+ * @note      none
+ */
+static uint8_t a_w25qxx_ftl_check(w25qxx_ftl_t *ftl, uint32_t logical)
+{
+    if (ftl == NULL)                                                      /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (ftl->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if (ftl->mounted != 1)                                                /* check mounted */
+    {
+        ftl->handle->debug_print("w25qxx: not mounted.\n");               /* not mounted */
+        
+        return 4;                                                         /* return error */
+    }
+    if (logical >= ftl->logical_count)                                    /* check logical */
+    {
+        ftl->handle->debug_print("w25qxx: logical sector is invalid.\n"); /* logical sector is invalid */
+        
+        return 5;                                                         /* return error */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      read a logical sector
+ * @param[in]  *ftl pointer to a w25qxx ftl structure
+ * @param[in]  logical logical sector
+ * @param[out] *buf pointer to a 4096 bytes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 logical sector is invalid
+ * @note       an unmapped sector reads as 0xFF
+ */
+uint8_t w25qxx_ftl_read(w25qxx_ftl_t *ftl, uint32_t logical, uint8_t *buf)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ftl_check(ftl, logical);                 /* check params */
+    if (res != 0)                                           /* check result */
+    {
+        return res;                                         /* return error */
+    }
+    
+    if (ftl->map[logical] == W25QXX_FTL_UNMAPPED)           /* unmapped */
+    {
+        memset(buf, 0xFF, W25QXX_FTL_SECTOR_SIZE);          /* erased content */
+        
+        return 0;                                           /* success return 0 */
+    }
+    if (w25qxx_read(ftl->handle, a_w25qxx_ftl_addr(ftl, ftl->map[logical]), buf,
+                    W25QXX_FTL_SECTOR_SIZE) != 0)           /* read data */
+    {
+        ftl->handle->debug_print("w25qxx: read failed.\n"); /* read failed */
+        
+        return 1;                                           /* return error */
+    }
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     write a logical sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] logical logical sector
+ * @param[in] *buf pointer to a 4096 bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 logical sector is invalid
+ *            - 6 no free sector
+ * @note      the data goes to the least erased free sector and the mapping is committed by one journal entry,
+ *            the old sector is only marked stale
+ */
+uint8_t w25qxx_ftl_write(w25qxx_ftl_t *ftl, uint32_t logical, uint8_t *buf)
+{
+    uint8_t res;
+    uint16_t physical;
+    uint32_t addr;
+    uint32_t i;
+    
+    res = a_w25qxx_ftl_check(ftl, logical);                                /* check params */
+    if (res != 0)                                                          /* check result */
+    {
+        return res;                                                        /* return error */
+    }
+    
+    res = a_w25qxx_ftl_alloc(ftl, &physical);                              /* get an erased sector */
+    if (res != 0)                                                          /* check result */
+    {
+        return res;                                                        /* return error */
+    }
+    addr = a_w25qxx_ftl_addr(ftl, physical);                               /* get address */
+    ftl->info[physical] |= W25QXX_FTL_INFO_DIRTY;                          /* no longer blank */
+    ftl->info[physical] &= ~W25QXX_FTL_INFO_VERIFIED;                      /* clear verified */
+    for (i = 0; i < W25QXX_FTL_SECTOR_SIZE; i += 256)                      /* loop all pages */
+    {
+        if (w25qxx_page_program(ftl->handle, addr + i, buf + i, 256) != 0) /* page program */
+        {
+            ftl->handle->debug_print("w25qxx: page program failed.\n");    /* page program failed */
+            
+            return 1;                                                      /* return error */
+        }
+    }
+    a_w25qxx_ftl_apply(ftl, (uint16_t)logical, physical);                  /* update ram state */
+    
+    return a_w25qxx_ftl_commit(ftl, (uint16_t)logical, physical);          /* commit mapping */
+}
+
+/**
+ * @brief     discard a logical sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] logical logical sector
+ * @return    status code
+ *            - 0 success
+ *            - 1 trim failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 logical sector is invalid
+ * @note      none
+ */
+uint8_t w25qxx_ftl_trim(w25qxx_ftl_t *ftl, uint32_t logical)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ftl_check(ftl, logical);                                  /* check params */
+    if (res != 0)                                                            /* check result */
+    {
+        return res;                                                          /* return error */
+    }
+    
+    if (ftl->map[logical] == W25QXX_FTL_UNMAPPED)                            /* already unmapped */
+    {
+        return 0;                                                            /* success return 0 */
+    }
+    a_w25qxx_ftl_apply(ftl, (uint16_t)logical, W25QXX_FTL_UNMAPPED);         /* update ram state */
+    
+    return a_w25qxx_ftl_commit(ftl, (uint16_t)logical, W25QXX_FTL_UNMAPPED); /* commit unmap */
+}
+
+/**
+ * @brief     erase one stale sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gc failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      call it from an idle loop to keep w25qxx_ftl_write off the erase path
+ */
+uint8_t w25qxx_ftl_gc(w25qxx_ftl_t *ftl)
+{
+    uint16_t physical;
+    
+    if (ftl == NULL)                                        /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (ftl->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    if (ftl->mounted != 1)                                  /* check mounted */
+    {
+        ftl->handle->debug_print("w25qxx: not mounted.\n"); /* not mounted */
+        
+        return 4;                                           /* return error */
+    }
+    
+    if (a_w25qxx_ftl_find_free(ftl, 1, &physical) != 0)     /* no stale sector */
+    {
+        return 0;                                           /* success return 0 */
+    }
+    
+    return a_w25qxx_ftl_erase(ftl, physical);               /* erase it */
+}
+
+/**
+ * @brief      get the erase count range
+ * @param[in]  *ftl pointer to a w25qxx ftl structure
+ * @param[out] *min pointer to a min erase count buffer
+ * @param[out] *max pointer to a max erase count buffer
+ * @param[out] *stale pointer to a stale sector count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_ftl_get_erase_count(w25qxx_ftl_t *ftl, uint32_t *min, uint32_t *max, uint32_t *stale)
+{
+    uint32_t i;
+    uint32_t count;
+    
+    if (ftl == NULL)                                        /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (ftl->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    if (ftl->mounted != 1)                                  /* check mounted */
+    {
+        ftl->handle->debug_print("w25qxx: not mounted.\n"); /* not mounted */
+        
+        return 4;                                           /* return error */
+    }
+    
+    *min = 0xFFFFFFFFU;                                     /* init max */
+    *max = 0;                                               /* init 0 */
+    *stale = 0;                                             /* init 0 */
+    for (i = 0; i < ftl->physical_count; i++)               /* loop all sectors */
+    {
+        count = ftl->info[i] & W25QXX_FTL_INFO_COUNT;       /* get count */
+        if (count < *min)                                   /* check min */
+        {
+            *min = count;                                   /* set min */
+        }
+        if (count > *max)                                   /* check max */
+        {
+            *max = count;                                   /* set max */
+        }
+        if ((ftl->info[i] & (W25QXX_FTL_INFO_USED | W25QXX_FTL_INFO_DIRTY)) ==
+            W25QXX_FTL_INFO_DIRTY)                          /* stale */
+        {
+            (*stale)++;                                     /* stale++ */
+        }
+    }
+    
+    return 0;                                               /* success return 0 */
+}
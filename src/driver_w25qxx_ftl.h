@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ftl.h
+ * @brief     driver w25qxx ftl header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_FTL_H
+#define DRIVER_W25QXX_FTL_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_ftl_driver w25qxx ftl driver function
+ * @brief    w25qxx flash translation layer modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx ftl spare sector definition
+ */
+#ifndef W25QXX_FTL_SPARE
+    #define W25QXX_FTL_SPARE        4        /**< physical sectors not exposed as logical sectors */
+#endif
+
+/**
+ * @brief w25qxx ftl min journal entry definition
+ */
+#ifndef W25QXX_FTL_MIN_ENTRY
+    #define W25QXX_FTL_MIN_ENTRY    32       /**< delta entries a journal sector must hold after the snapshot */
+#endif
+
+/**
+ * @brief     ftl logical sector count definition
+ * @param[in] LEN region length
+ * @note      two sectors hold the mapping journal
+ */
+#define W25QXX_FTL_LOGICAL_COUNT(LEN)     ((LEN) / 4096U - 2U - W25QXX_FTL_SPARE)
+
+/**
+ * @brief     ftl physical sector count definition
+ * @param[in] LEN region length
+ * @note      none
+ */
+#define W25QXX_FTL_PHYSICAL_COUNT(LEN)    ((LEN) / 4096U - 2U)
+
+/**
+ * @brief w25qxx ftl structure definition
+ */
+typedef struct w25qxx_ftl_s
+{
+    w25qxx_handle_t *handle;        /**< w25qxx handle */
+    uint16_t *map;                  /**< logical to physical map */
+    uint32_t *info;                 /**< physical sector erase count and state */
+    uint32_t addr;                  /**< region address */
+    uint32_t logical_count;         /**< logical sectors */
+    uint32_t physical_count;        /**< physical sectors */
+    uint32_t entry_start;           /**< first delta entry offset in a journal sector */
+    uint32_t offset;                /**< next delta entry offset */
+    uint32_t seq;                   /**< journal sequence */
+    uint8_t journal;                /**< active journal sector */
+    uint8_t buf[256];               /**< page buffer */
+    uint8_t mounted;                /**< mounted flag */
+    uint8_t inited;                 /**< inited flag */
+} w25qxx_ftl_t;
+
+/**
+ * @brief     initialize the ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] *map pointer to a map buffer
+ * @param[in] map_size map entries
+ * @param[in] *info pointer to a sector info buffer
+ * @param[in] info_size info entries
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 buffer is too small
+ * @note      map holds W25QXX_FTL_LOGICAL_COUNT(len) entries and info holds W25QXX_FTL_PHYSICAL_COUNT(len) entries,
+ *            the snapshot of both must fit in one journal sector
+ */
+uint8_t w25qxx_ftl_init(w25qxx_ftl_t *ftl, w25qxx_handle_t *handle, uint32_t addr, uint32_t len,
+                        uint16_t *map, uint32_t map_size, uint32_t *info, uint32_t info_size);
+
+/**
+ * @brief     deinit the ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ftl_deinit(w25qxx_ftl_t *ftl);
+
+/**
+ * @brief     start an empty ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      only the journal is erased, data sectors are erased lazily before their first use
+ */
+uint8_t w25qxx_ftl_format(w25qxx_ftl_t *ftl);
+
+/**
+ * @brief     mount the ftl
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no valid journal
+ * @note      the newest valid snapshot is loaded and its delta entries are replayed
+ */
+uint8_t w25qxx_ftl_mount(w25qxx_ftl_t *ftl);
+
+/**
+ * @brief      read a logical sector
+ * @param[in]  *ftl pointer to a w25qxx ftl structure
+ * @param[in]  logical logical sector
+ * @param[out] *buf pointer to a 4096 bytes buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 logical sector is invalid
+ * @note       an unmapped sector reads as 0xFF
+ */
+uint8_t w25qxx_ftl_read(w25qxx_ftl_t *ftl, uint32_t logical, uint8_t *buf);
+
+/**
+ * @brief     write a logical sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] logical logical sector
+ * @param[in] *buf pointer to a 4096 bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 logical sector is invalid
+ *            - 6 no free sector
+ * @note      the data goes to the least erased free sector and the mapping is committed by one journal entry,
+ *            the old sector is only marked stale
+ */
+uint8_t w25qxx_ftl_write(w25qxx_ftl_t *ftl, uint32_t logical, uint8_t *buf);
+
+/**
+ * @brief     discard a logical sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @param[in] logical logical sector
+ * @return    status code
+ *            - 0 success
+ *            - 1 trim failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 logical sector is invalid
+ * @note      none
+ */
+uint8_t w25qxx_ftl_trim(w25qxx_ftl_t *ftl, uint32_t logical);
+
+/**
+ * @brief     erase one stale sector
+ * @param[in] *ftl pointer to a w25qxx ftl structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gc failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      call it from an idle loop to keep w25qxx_ftl_write off the erase path
+ */
+uint8_t w25qxx_ftl_gc(w25qxx_ftl_t *ftl);
+
+/**
+ * @brief      get the erase count range
+ * @param[in]  *ftl pointer to a w25qxx ftl structure
+ * @param[out] *min pointer to a min erase count buffer
+ * @param[out] *max pointer to a max erase count buffer
+ * @param[out] *stale pointer to a stale sector count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_ftl_get_erase_count(w25qxx_ftl_t *ftl, uint32_t *min, uint32_t *max, uint32_t *stale);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
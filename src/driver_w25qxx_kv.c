@@ -0,0 +1,1119 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_kv.c
+ * @brief     driver w25qxx kv source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_kv.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief kv sector definition
+ */
+#define W25QXX_KV_MAGIC          0x3056564BU        /**< "KVV0" */
+#define W25QXX_KV_SECTOR_SIZE    4096U              /**< sector size */
+#define W25QXX_KV_HEADER_SIZE    16U                /**< sector header size */
+#define W25QXX_KV_EMPTY          0xFFFFFFFFU        /**< empty index entry */
+#define W25QXX_KV_FLAG_VALUE     0x01               /**< value record */
+#define W25QXX_KV_FLAG_DELETE    0x00               /**< tombstone record */
+
+/**
+ * @brief     hash a key
+ * @param[in] *key pointer to a key buffer
+ * @param[in] key_len key length
+ * @return    hash
+ * @note      fnv-1a
+ */
+static uint32_t a_w25qxx_kv_hash(const uint8_t *key, uint8_t key_len)
+{
+    uint32_t hash;
+    uint8_t i;
+    
+    hash = 2166136261U;           /* offset basis */
+    for (i = 0; i < key_len; i++) /* loop all bytes */
+    {
+        hash ^= key[i];           /* xor byte */
+        hash *= 16777619U;        /* multiply prime */
+    }
+    
+    return hash;                  /* return hash */
+}
+
+/**
+ * @brief     get the padded record length
+ * @param[in] key_len key length
+ * @param[in] value_len value length
+ * @return    record length
+ * @note      records are 4 bytes aligned
+ */
+static uint32_t a_w25qxx_kv_record_len(uint8_t key_len, uint16_t value_len)
+{
+    return (W25QXX_KV_RECORD_HEADER + key_len + value_len + 3U) & ~3U; /* return length */
+}
+
+/**
+ * @brief     program data that may cross pages
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] addr flash address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      one page program per touched page
+ */
+static uint8_t a_w25qxx_kv_program(w25qxx_kv_t *kv, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    uint32_t page_remain;
+    
+    while (len != 0)                                                                /* loop all pages */
+    {
+        page_remain = 256 - (addr % 256);                                           /* get page remain */
+        if (page_remain > len)                                                      /* check length */
+        {
+            page_remain = len;                                                      /* set length */
+        }
+        if (w25qxx_page_program(kv->handle, addr, buf, (uint16_t)page_remain) != 0) /* page program */
+        {
+            kv->handle->debug_print("w25qxx: page program failed.\n");              /* page program failed */
+            
+            return 1;                                                               /* return error */
+        }
+        addr += page_remain;                                                        /* address + remain */
+        buf += page_remain;                                                         /* buffer + remain */
+        len -= page_remain;                                                         /* length - remain */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      find a key in the index
+ * @param[in]  *kv pointer to a w25qxx kv structure
+ * @param[in]  *key pointer to a key buffer
+ * @param[in]  key_len key length
+ * @param[in]  hash key hash
+ * @param[out] *slot pointer to a slot buffer, the free slot when the key is not found
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 6 key is not found
+ * @note       hash collisions are resolved by comparing the stored key
+ */
+static uint8_t a_w25qxx_kv_find(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len, uint32_t hash, uint32_t *slot)
+{
+    uint8_t buf[W25QXX_KV_RECORD_HEADER + W25QXX_KV_KEY_MAX];
+    uint32_t mask;
+    uint32_t i;
+    
+    mask = kv->index_size - 1;                                              /* get mask */
+    i = hash & mask;                                                        /* first slot */
+    while (kv->index[i].addr != W25QXX_KV_EMPTY)                            /* probe until empty */
+    {
+        if (kv->index[i].hash == hash)                                      /* check hash */
+        {
+            if (w25qxx_read(kv->handle, kv->index[i].addr, buf,
+                            W25QXX_KV_RECORD_HEADER + key_len) != 0)        /* read record key */
+            {
+                kv->handle->debug_print("w25qxx: read failed.\n");          /* read failed */
+                
+                return 1;                                                   /* return error */
+            }
+            if ((buf[0] == key_len) &&
+                (memcmp(&buf[W25QXX_KV_RECORD_HEADER], key, key_len) == 0)) /* check key */
+            {
+                *slot = i;                                                  /* set slot */
+                
+                return 0;                                                   /* success return 0 */
+            }
+        }
+        i = (i + 1) & mask;                                                 /* next slot */
+    }
+    *slot = i;                                                              /* set free slot */
+    
+    return 6;                                                               /* not found */
+}
+
+/**
+ * @brief     remove an index slot
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] slot slot index
+ * @note      backward shift deletion keeps the probe chains intact
+ */
+static void a_w25qxx_kv_remove(w25qxx_kv_t *kv, uint32_t slot)
+{
+    uint32_t mask;
+    uint32_t i;
+    uint32_t home;
+    
+    mask = kv->index_size - 1;                          /* get mask */
+    i = slot;                                           /* start from the slot */
+    while (1)                                           /* loop the chain */
+    {
+        i = (i + 1) & mask;                             /* next slot */
+        if (kv->index[i].addr == W25QXX_KV_EMPTY)       /* chain end */
+        {
+            break;                                      /* break */
+        }
+        home = kv->index[i].hash & mask;                /* get home slot */
+        if (((i - home) & mask) >= ((i - slot) & mask)) /* entry can move back */
+        {
+            kv->index[slot] = kv->index[i];             /* move entry */
+            slot = i;                                   /* new hole */
+        }
+    }
+    kv->index[slot].addr = W25QXX_KV_EMPTY;             /* clear slot */
+    kv->index[slot].hash = 0;                           /* clear hash */
+    kv->count--;                                        /* count-- */
+}
+
+/**
+ * @brief     apply a record to the index
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] addr record address
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 5 index is full
+ * @note      the record must be in the kv buffer
+ */
+static uint8_t a_w25qxx_kv_apply(w25qxx_kv_t *kv, uint32_t addr)
+{
+    uint8_t res;
+    uint8_t key_len;
+    uint32_t hash;
+    uint32_t slot;
+    
+    key_len = kv->buf[0];                                                /* get key length */
+    hash = a_w25qxx_kv_hash(&kv->buf[W25QXX_KV_RECORD_HEADER], key_len); /* get hash */
+    res = a_w25qxx_kv_find(kv, &kv->buf[W25QXX_KV_RECORD_HEADER], key_len,
+                           hash, &slot);                                 /* find key */
+    if (res == 1)                                                        /* check result */
+    {
+        return 1;                                                        /* return error */
+    }
+    if (kv->buf[1] == W25QXX_KV_FLAG_DELETE)                             /* tombstone */
+    {
+        if (res == 0)                                                    /* key exists */
+        {
+            a_w25qxx_kv_remove(kv, slot);                                /* remove key */
+        }
+        
+        return 0;                                                        /* success return 0 */
+    }
+    if (res != 0)                                                        /* new key */
+    {
+        if (kv->count >= kv->index_size - 1)                             /* check index */
+        {
+            return 5;                                                    /* return error */
+        }
+        kv->index[slot].hash = hash;                                     /* set hash */
+        kv->count++;                                                     /* count++ */
+    }
+    kv->index[slot].addr = addr;                                         /* set address */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      read and check one record into the kv buffer
+ * @param[in]  *kv pointer to a w25qxx kv structure
+ * @param[in]  addr record address
+ * @param[out] *len pointer to a padded length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 end of the sector data
+ *             - 5 record is invalid
+ * @note       none
+ */
+static uint8_t a_w25qxx_kv_read_record(w25qxx_kv_t *kv, uint32_t addr, uint32_t *len)
+{
+    uint8_t key_len;
+    uint16_t value_len;
+    uint32_t total;
+    uint32_t crc;
+    
+    if ((W25QXX_KV_SECTOR_SIZE - (addr % W25QXX_KV_SECTOR_SIZE)) < W25QXX_KV_RECORD_HEADER) /* check room */
+    {
+        return 4;                                                                           /* sector end */
+    }
+    if (w25qxx_read(kv->handle, addr, kv->buf, W25QXX_KV_RECORD_HEADER) != 0)               /* read header */
+    {
+        kv->handle->debug_print("w25qxx: read failed.\n");                                  /* read failed */
+        
+        return 1;                                                                           /* return error */
+    }
+    key_len = kv->buf[0];                                                                   /* get key length */
+    if (key_len == 0xFF)                                                                    /* erased */
+    {
+        return 4;                                                                           /* data end */
+    }
+    value_len = (uint16_t)(kv->buf[2] | ((uint16_t)kv->buf[3] << 8));                       /* get value length */
+    total = W25QXX_KV_RECORD_HEADER + key_len + value_len;                                  /* get total length */
+    if ((key_len == 0) || (key_len > W25QXX_KV_KEY_MAX) ||
+        ((kv->buf[1] != W25QXX_KV_FLAG_VALUE) && (kv->buf[1] != W25QXX_KV_FLAG_DELETE)) ||
+        (total > W25QXX_KV_RECORD_MAX) ||
+        (total > (W25QXX_KV_SECTOR_SIZE - (addr % W25QXX_KV_SECTOR_SIZE))))                 /* check header */
+    {
+        return 5;                                                                           /* return error */
+    }
+    if (w25qxx_read(kv->handle, addr + W25QXX_KV_RECORD_HEADER,
+                    &kv->buf[W25QXX_KV_RECORD_HEADER], key_len + value_len) != 0)           /* read body */
+    {
+        kv->handle->debug_print("w25qxx: read failed.\n");                                  /* read failed */
+        
+        return 1;                                                                           /* return error */
+    }
+    crc = w25qxx_util_crc32(0xFFFFFFFFU, kv->buf, 4);                                       /* header crc */
+    crc = w25qxx_util_crc32(crc, &kv->buf[W25QXX_KV_RECORD_HEADER], key_len + value_len);   /* body crc */
+    if ((crc ^ 0xFFFFFFFFU) != w25qxx_util_get32(&kv->buf[4]))                              /* check crc */
+    {
+        return 5;                                                                           /* torn record */
+    }
+    *len = a_w25qxx_kv_record_len(key_len, value_len);                                      /* set length */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     open an erased sector as the new head
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] sector sector index
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the sector is checked blank first, a sector torn by a power loss is erased again
+ */
+static uint8_t a_w25qxx_kv_open(w25qxx_kv_t *kv, uint32_t sector)
+{
+    uint8_t buf[64];
+    uint8_t header[W25QXX_KV_HEADER_SIZE];
+    uint32_t addr;
+    uint32_t i;
+    uint32_t j;
+    uint8_t blank;
+    
+    addr = kv->addr + sector * W25QXX_KV_SECTOR_SIZE;                          /* get sector address */
+    blank = 1;                                                                 /* init blank */
+    for (i = 0; (i < W25QXX_KV_SECTOR_SIZE) && (blank != 0); i += sizeof(buf)) /* loop the sector */
+    {
+        if (w25qxx_read(kv->handle, addr + i, buf, sizeof(buf)) != 0)          /* read data */
+        {
+            kv->handle->debug_print("w25qxx: read failed.\n");                 /* read failed */
+            
+            return 1;                                                          /* return error */
+        }
+        for (j = 0; j < sizeof(buf); j++)                                      /* check all bytes */
+        {
+            if (buf[j] != 0xFF)                                                /* not blank */
+            {
+                blank = 0;                                                     /* set not blank */
+                
+                break;                                                         /* break */
+            }
+        }
+    }
+    if (blank == 0)                                                            /* need erase */
+    {
+        if (w25qxx_sector_erase_4k(kv->handle, addr) != 0)                     /* sector erase */
+        {
+            kv->handle->debug_print("w25qxx: sector erase 4k failed.\n");      /* sector erase 4k failed */
+            
+            return 1;                                                          /* return error */
+        }
+    }
+    
+    kv->seq++;                                                                 /* seq++ */
+    w25qxx_util_put32(&header[0], W25QXX_KV_MAGIC);                            /* set magic */
+    w25qxx_util_put32(&header[4], kv->seq);                                    /* set sequence */
+    w25qxx_util_put32(&header[8], ~kv->seq);                                   /* set inverted sequence */
+    w25qxx_util_put32(&header[12], 0xFFFFFFFFU);                               /* reserved */
+    if (a_w25qxx_kv_program(kv, addr, header, W25QXX_KV_HEADER_SIZE) != 0)     /* program header */
+    {
+        return 1;                                                              /* return error */
+    }
+    kv->head = sector;                                                         /* set head */
+    kv->offset = W25QXX_KV_HEADER_SIZE;                                        /* set offset */
+    kv->free--;                                                                /* free-- */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      append the record in the kv buffer
+ * @param[in]  *kv pointer to a w25qxx kv structure
+ * @param[in]  len padded record length
+ * @param[out] *addr pointer to a record address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 append failed
+ * @note       a new head is opened when the record does not fit, the caller reserves a free sector
+ */
+static uint8_t a_w25qxx_kv_append(w25qxx_kv_t *kv, uint32_t len, uint32_t *addr)
+{
+    if ((kv->offset + len) > W25QXX_KV_SECTOR_SIZE)                       /* head is full */
+    {
+        if (kv->free == 0)                                                /* check free */
+        {
+            return 1;                                                     /* return error */
+        }
+        if (a_w25qxx_kv_open(kv, (kv->head + 1) % kv->sector_count) != 0) /* open next sector */
+        {
+            return 1;                                                     /* return error */
+        }
+    }
+    *addr = kv->addr + kv->head * W25QXX_KV_SECTOR_SIZE + kv->offset;     /* get address */
+    if (a_w25qxx_kv_program(kv, *addr, kv->buf, len) != 0)                /* program record */
+    {
+        kv->offset = W25QXX_KV_SECTOR_SIZE;                               /* never reuse a torn area */
+        
+        return 1;                                                         /* return error */
+    }
+    kv->offset += len;                                                    /* offset + length */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     compact the oldest sector
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 compact failed
+ * @note      live records are copied to the head, tombstones are dropped because nothing older is left
+ */
+static uint8_t a_w25qxx_kv_compact(w25qxx_kv_t *kv)
+{
+    uint8_t res;
+    uint32_t base;
+    uint32_t addr;
+    uint32_t len;
+    uint32_t slot;
+    uint32_t new_addr;
+    
+    base = kv->addr + kv->tail * W25QXX_KV_SECTOR_SIZE;                  /* get tail address */
+    addr = base + W25QXX_KV_HEADER_SIZE;                                 /* first record */
+    while (addr < base + W25QXX_KV_SECTOR_SIZE)                          /* loop all records */
+    {
+        res = a_w25qxx_kv_read_record(kv, addr, &len);                   /* read record */
+        if (res == 1)                                                    /* check result */
+        {
+            return 1;                                                    /* return error */
+        }
+        if (res != 0)                                                    /* data end */
+        {
+            break;                                                       /* break */
+        }
+        if (kv->buf[1] == W25QXX_KV_FLAG_VALUE)                          /* value record */
+        {
+            res = a_w25qxx_kv_find(kv, &kv->buf[W25QXX_KV_RECORD_HEADER], kv->buf[0],
+                                   a_w25qxx_kv_hash(&kv->buf[W25QXX_KV_RECORD_HEADER],
+                                                    kv->buf[0]), &slot); /* find key */
+            if (res == 1)                                                /* check result */
+            {
+                return 1;                                                /* return error */
+            }
+            if ((res == 0) && (kv->index[slot].addr == addr))            /* record is live */
+            {
+                if (a_w25qxx_kv_append(kv, len, &new_addr) != 0)         /* copy record */
+                {
+                    return 1;                                            /* return error */
+                }
+                kv->index[slot].addr = new_addr;                         /* update index */
+            }
+        }
+        addr += len;                                                     /* next record */
+    }
+    if (w25qxx_sector_erase_4k(kv->handle, base) != 0)                   /* sector erase */
+    {
+        kv->handle->debug_print("w25qxx: sector erase 4k failed.\n");    /* sector erase 4k failed */
+        
+        return 1;                                                        /* return error */
+    }
+    kv->tail = (kv->tail + 1) % kv->sector_count;                        /* next tail */
+    kv->free++;                                                          /* free++ */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     make room for one record
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] len padded record length
+ * @return    status code
+ *            - 0 success
+ *            - 1 compact failed
+ *            - 6 no space
+ * @note      one erased sector is always kept for the compaction copy
+ */
+static uint8_t a_w25qxx_kv_reserve(w25qxx_kv_t *kv, uint32_t len)
+{
+    uint32_t i;
+    
+    if ((kv->offset + len) <= W25QXX_KV_SECTOR_SIZE)                                      /* fits in the head */
+    {
+        return 0;                                                                         /* success return 0 */
+    }
+    for (i = 0; (i < kv->sector_count) && (kv->free <= 1) && (kv->tail != kv->head); i++) /* compact until a spare is left */
+    {
+        if (a_w25qxx_kv_compact(kv) != 0)                                                 /* compact */
+        {
+            return 1;                                                                     /* return error */
+        }
+    }
+    if (kv->free <= 1)                                                                    /* check free */
+    {
+        kv->handle->debug_print("w25qxx: no space.\n");                                   /* no space */
+        
+        return 6;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     initialize the kv store
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] *index pointer to an index buffer
+ * @param[in] index_size index entries
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 index size is invalid
+ * @note      addr and len must be 4k aligned and hold at least 3 sectors,
+ *            index_size must be a power of 2 and larger than the key count
+ */
+uint8_t w25qxx_kv_init(w25qxx_kv_t *kv, w25qxx_handle_t *handle, uint32_t addr, uint32_t len,
+                       w25qxx_kv_entry_t *index, uint32_t index_size)
+{
+    if ((kv == NULL) || (handle == NULL) || (index == NULL))                       /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if ((addr % W25QXX_KV_SECTOR_SIZE) != 0)                                       /* check address */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");                         /* addr is invalid */
+        
+        return 4;                                                                  /* return error */
+    }
+    if (((len % W25QXX_KV_SECTOR_SIZE) != 0) || (len < W25QXX_KV_SECTOR_SIZE * 3)) /* check length */
+    {
+        handle->debug_print("w25qxx: len is invalid.\n");                          /* len is invalid */
+        
+        return 5;                                                                  /* return error */
+    }
+    if ((index_size < 2) || ((index_size & (index_size - 1)) != 0))                /* check index size */
+    {
+        handle->debug_print("w25qxx: index size is invalid.\n");                   /* index size is invalid */
+        
+        return 6;                                                                  /* return error */
+    }
+    
+    memset(kv, 0, sizeof(w25qxx_kv_t));                                            /* clear kv */
+    kv->handle = handle;                                                           /* set handle */
+    kv->index = index;                                                             /* set index */
+    kv->index_size = index_size;                                                   /* set index size */
+    kv->addr = addr;                                                               /* set address */
+    kv->sector_count = len / W25QXX_KV_SECTOR_SIZE;                                /* set sector count */
+    kv->inited = 1;                                                                /* set inited */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     deinit the kv store
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_kv_deinit(w25qxx_kv_t *kv)
+{
+    if (kv == NULL)      /* check handle */
+    {
+        return 2;        /* return error */
+    }
+    if (kv->inited != 1) /* check handle initialization */
+    {
+        return 3;        /* return error */
+    }
+    
+    kv->mounted = 0;     /* clear mounted */
+    kv->inited = 0;      /* clear inited */
+    
+    return 0;            /* success return 0 */
+}
+
+/**
+ * @brief     clear the index
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @note      none
+ */
+static void a_w25qxx_kv_clear_index(w25qxx_kv_t *kv)
+{
+    uint32_t i;
+    
+    for (i = 0; i < kv->index_size; i++)     /* loop all entries */
+    {
+        kv->index[i].hash = 0;               /* clear hash */
+        kv->index[i].addr = W25QXX_KV_EMPTY; /* clear address */
+    }
+    kv->count = 0;                           /* clear count */
+}
+
+/**
+ * @brief     erase the region and start an empty store
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_kv_format(w25qxx_kv_t *kv)
+{
+    uint32_t i;
+    
+    if (kv == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (kv->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    kv->mounted = 0;                                                                       /* clear mounted */
+    for (i = 0; i < kv->sector_count; i++)                                                 /* loop all sectors */
+    {
+        if (w25qxx_sector_erase_4k(kv->handle, kv->addr + i * W25QXX_KV_SECTOR_SIZE) != 0) /* sector erase */
+        {
+            kv->handle->debug_print("w25qxx: sector erase 4k failed.\n");                  /* sector erase 4k failed */
+            
+            return 1;                                                                      /* return error */
+        }
+    }
+    a_w25qxx_kv_clear_index(kv);                                                           /* clear index */
+    kv->free = kv->sector_count;                                                           /* all sectors are free */
+    kv->seq = 0;                                                                           /* reset sequence */
+    kv->tail = 0;                                                                          /* set tail */
+    if (a_w25qxx_kv_open(kv, 0) != 0)                                                      /* open first sector */
+    {
+        return 1;                                                                          /* return error */
+    }
+    kv->mounted = 1;                                                                       /* set mounted */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     mount the store and rebuild the index
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no valid sector
+ *            - 5 index is full
+ * @note      a record torn by a power loss ends its sector, the rest of that sector is skipped
+ */
+uint8_t w25qxx_kv_mount(w25qxx_kv_t *kv)
+{
+    uint8_t res;
+    uint8_t header[W25QXX_KV_HEADER_SIZE];
+    uint32_t i;
+    uint32_t sector;
+    uint32_t seq;
+    uint32_t min_seq;
+    uint32_t max_seq;
+    uint32_t used;
+    uint32_t base;
+    uint32_t addr;
+    uint32_t len;
+    
+    if (kv == NULL)                                                            /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (kv->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    kv->mounted = 0;                                                           /* clear mounted */
+    used = 0;                                                                  /* init 0 */
+    min_seq = 0;                                                               /* init 0 */
+    max_seq = 0;                                                               /* init 0 */
+    for (i = 0; i < kv->sector_count; i++)                                     /* find head and tail */
+    {
+        base = kv->addr + i * W25QXX_KV_SECTOR_SIZE;                           /* get sector address */
+        if (w25qxx_read(kv->handle, base, header, W25QXX_KV_HEADER_SIZE) != 0) /* read header */
+        {
+            kv->handle->debug_print("w25qxx: read failed.\n");                 /* read failed */
+            
+            return 1;                                                          /* return error */
+        }
+        seq = w25qxx_util_get32(&header[4]);                                   /* get sequence */
+        if ((w25qxx_util_get32(&header[0]) != W25QXX_KV_MAGIC) ||
+            (w25qxx_util_get32(&header[8]) != (uint32_t)~seq))                 /* check header */
+        {
+            continue;                                                          /* free sector */
+        }
+        if ((used == 0) || ((int32_t)(seq - min_seq) < 0))                     /* older sector */
+        {
+            min_seq = seq;                                                     /* set min sequence */
+            kv->tail = i;                                                      /* set tail */
+        }
+        if ((used == 0) || ((int32_t)(seq - max_seq) > 0))                     /* newer sector */
+        {
+            max_seq = seq;                                                     /* set max sequence */
+            kv->head = i;                                                      /* set head */
+        }
+        used++;                                                                /* used++ */
+    }
+    if (used == 0)                                                             /* check used */
+    {
+        kv->handle->debug_print("w25qxx: no valid sector.\n");                 /* no valid sector */
+        
+        return 4;                                                              /* return error */
+    }
+    
+    a_w25qxx_kv_clear_index(kv);                                               /* clear index */
+    kv->seq = max_seq;                                                         /* set sequence */
+    kv->free = kv->sector_count - used;                                        /* set free */
+    sector = kv->tail;                                                         /* start from the tail */
+    for (i = 0; i < used; i++)                                                 /* replay sectors by age */
+    {
+        base = kv->addr + sector * W25QXX_KV_SECTOR_SIZE;                      /* get sector address */
+        addr = base + W25QXX_KV_HEADER_SIZE;                                   /* first record */
+        while (1)                                                              /* loop all records */
+        {
+            res = a_w25qxx_kv_read_record(kv, addr, &len);                     /* read record */
+            if (res == 1)                                                      /* check result */
+            {
+                return 1;                                                      /* return error */
+            }
+            if (res != 0)                                                      /* end of data */
+            {
+                break;                                                         /* break */
+            }
+            res = a_w25qxx_kv_apply(kv, addr);                                 /* apply record */
+            if (res != 0)                                                      /* check result */
+            {
+                if (res == 5)                                                  /* index is full */
+                {
+                    kv->handle->debug_print("w25qxx: index is full.\n");       /* index is full */
+                }
+                
+                return res;                                                    /* return error */
+            }
+            addr += len;                                                       /* next record */
+        }
+        if (sector == kv->head)                                                /* head sector */
+        {
+            if (res == 4)                                                      /* clean end */
+            {
+                kv->offset = addr - base;                                      /* continue here */
+            }
+            else
+            {
+                kv->offset = W25QXX_KV_SECTOR_SIZE;                            /* torn tail, close it */
+            }
+        }
+        sector = (sector + 1) % kv->sector_count;                              /* next sector */
+    }
+    kv->mounted = 1;                                                           /* set mounted */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     check the key
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *key pointer to a key buffer
+ * @param[in] key_len key length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 key is invalid
+ * @note      none
+ */
+static uint8_t a_w25qxx_kv_check(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len)
+{
+    if (kv == NULL)                                                       /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (kv->inited != 1)                                                  /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if (kv->mounted != 1)                                                 /* check mounted */
+    {
+        kv->handle->debug_print("w25qxx: not mounted.\n");                /* not mounted */
+        
+        return 4;                                                         /* return error */
+    }
+    if ((key == NULL) || (key_len == 0) || (key_len > W25QXX_KV_KEY_MAX)) /* check key */
+    {
+        kv->handle->debug_print("w25qxx: key is invalid.\n");             /* key is invalid */
+        
+        return 5;                                                         /* return error */
+    }
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     write one record
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *key pointer to a key buffer
+ * @param[in] key_len key length
+ * @param[in] flag record flag
+ * @param[in] *value pointer to a value buffer
+ * @param[in] value_len value length
+ * @param[in] hash key hash
+ * @param[in] slot index slot of the key
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 6 no space
+ * @note      none
+ */
+static uint8_t a_w25qxx_kv_write(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len, uint8_t flag,
+                                 const uint8_t *value, uint16_t value_len, uint32_t hash, uint32_t *slot)
+{
+    uint8_t res;
+    uint32_t len;
+    uint32_t addr;
+    uint32_t crc;
+    
+    len = a_w25qxx_kv_record_len(key_len, value_len);                                     /* get length */
+    res = a_w25qxx_kv_reserve(kv, len);                                                   /* make room */
+    if (res != 0)                                                                         /* check result */
+    {
+        return res;                                                                       /* return error */
+    }
+    res = a_w25qxx_kv_find(kv, key, key_len, hash, slot);                                 /* compaction may move the slot */
+    if (res == 1)                                                                         /* check result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    
+    memset(kv->buf, 0xFF, len);                                                           /* pad with erased bytes */
+    kv->buf[0] = key_len;                                                                 /* set key length */
+    kv->buf[1] = flag;                                                                    /* set flag */
+    kv->buf[2] = (uint8_t)(value_len >> 0);                                               /* set value length */
+    kv->buf[3] = (uint8_t)(value_len >> 8);                                               /* set value length */
+    memcpy(&kv->buf[W25QXX_KV_RECORD_HEADER], key, key_len);                              /* copy key */
+    if (value_len != 0)                                                                   /* check value */
+    {
+        memcpy(&kv->buf[W25QXX_KV_RECORD_HEADER + key_len], value, value_len);            /* copy value */
+    }
+    crc = w25qxx_util_crc32(0xFFFFFFFFU, kv->buf, 4);                                     /* header crc */
+    crc = w25qxx_util_crc32(crc, &kv->buf[W25QXX_KV_RECORD_HEADER], key_len + value_len); /* body crc */
+    w25qxx_util_put32(&kv->buf[4], crc ^ 0xFFFFFFFFU);                                    /* set crc */
+    if (a_w25qxx_kv_append(kv, len, &addr) != 0)                                          /* append record */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if (flag == W25QXX_KV_FLAG_DELETE)                                                    /* tombstone */
+    {
+        if (res == 0)                                                                     /* key exists */
+        {
+            a_w25qxx_kv_remove(kv, *slot);                                                /* remove key */
+        }
+    }
+    else
+    {
+        if (res != 0)                                                                     /* new key */
+        {
+            kv->index[*slot].hash = hash;                                                 /* set hash */
+            kv->count++;                                                                  /* count++ */
+        }
+        kv->index[*slot].addr = addr;                                                     /* set address */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set a key
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *key pointer to a key buffer
+ * @param[in] key_len key length
+ * @param[in] *value pointer to a value buffer
+ * @param[in] value_len value length
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 key or value is invalid
+ *            - 6 no space
+ *            - 7 index is full
+ * @note      the record is appended with page programs, no sector is read back or erased
+ *            unless a compaction is needed to make room
+ */
+uint8_t w25qxx_kv_set(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len, const uint8_t *value, uint16_t value_len)
+{
+    uint8_t res;
+    uint32_t hash;
+    uint32_t slot;
+    
+    res = a_w25qxx_kv_check(kv, key, key_len);                                            /* check params */
+    if (res != 0)                                                                         /* check result */
+    {
+        return res;                                                                       /* return error */
+    }
+    if (((value == NULL) && (value_len != 0)) ||
+        ((uint32_t)W25QXX_KV_RECORD_HEADER + key_len + value_len > W25QXX_KV_RECORD_MAX)) /* check value */
+    {
+        kv->handle->debug_print("w25qxx: value is invalid.\n");                           /* value is invalid */
+        
+        return 5;                                                                         /* return error */
+    }
+    
+    hash = a_w25qxx_kv_hash(key, key_len);                                                /* get hash */
+    res = a_w25qxx_kv_find(kv, key, key_len, hash, &slot);                                /* find key */
+    if (res == 1)                                                                         /* check result */
+    {
+        return 1;                                                                         /* return error */
+    }
+    if ((res != 0) && (kv->count >= kv->index_size - 1))                                  /* check index */
+    {
+        kv->handle->debug_print("w25qxx: index is full.\n");                              /* index is full */
+        
+        return 7;                                                                         /* return error */
+    }
+    
+    return a_w25qxx_kv_write(kv, key, key_len, W25QXX_KV_FLAG_VALUE, value, value_len,
+                             hash, &slot);                                                /* write record */
+}
+
+/**
+ * @brief      get a key
+ * @param[in]  *kv pointer to a w25qxx kv structure
+ * @param[in]  *key pointer to a key buffer
+ * @param[in]  key_len key length
+ * @param[out] *value pointer to a value buffer
+ * @param[in]  value_size value buffer size
+ * @param[out] *value_len pointer to a value length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 key is invalid
+ *             - 6 key is not found
+ *             - 7 value buffer is too small
+ * @note       none
+ */
+uint8_t w25qxx_kv_get(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len,
+                      uint8_t *value, uint16_t value_size, uint16_t *value_len)
+{
+    uint8_t res;
+    uint8_t header[W25QXX_KV_RECORD_HEADER];
+    uint16_t len;
+    uint32_t slot;
+    
+    res = a_w25qxx_kv_check(kv, key, key_len);                                               /* check params */
+    if (res != 0)                                                                            /* check result */
+    {
+        return res;                                                                          /* return error */
+    }
+    
+    res = a_w25qxx_kv_find(kv, key, key_len, a_w25qxx_kv_hash(key, key_len), &slot);         /* find key */
+    if (res != 0)                                                                            /* check result */
+    {
+        return res;                                                                          /* return error */
+    }
+    if (w25qxx_read(kv->handle, kv->index[slot].addr, header, W25QXX_KV_RECORD_HEADER) != 0) /* read header */
+    {
+        kv->handle->debug_print("w25qxx: read failed.\n");                                   /* read failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    len = (uint16_t)(header[2] | ((uint16_t)header[3] << 8));                                /* get value length */
+    *value_len = len;                                                                        /* set value length */
+    if (len > value_size)                                                                    /* check buffer */
+    {
+        kv->handle->debug_print("w25qxx: value buffer is too small.\n");                     /* value buffer is too small */
+        
+        return 7;                                                                            /* return error */
+    }
+    if (len != 0)                                                                            /* check length */
+    {
+        if (w25qxx_read(kv->handle, kv->index[slot].addr + W25QXX_KV_RECORD_HEADER + key_len,
+                        value, len) != 0)                                                    /* read value */
+        {
+            kv->handle->debug_print("w25qxx: read failed.\n");                               /* read failed */
+            
+            return 1;                                                                        /* return error */
+        }
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     delete a key
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *key pointer to a key buffer
+ * @param[in] key_len key length
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 key is invalid
+ *            - 6 key is not found or no space
+ * @note      a tombstone record is appended
+ */
+uint8_t w25qxx_kv_delete(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len)
+{
+    uint8_t res;
+    uint32_t hash;
+    uint32_t slot;
+    
+    res = a_w25qxx_kv_check(kv, key, key_len);             /* check params */
+    if (res != 0)                                          /* check result */
+    {
+        return res;                                        /* return error */
+    }
+    
+    hash = a_w25qxx_kv_hash(key, key_len);                 /* get hash */
+    res = a_w25qxx_kv_find(kv, key, key_len, hash, &slot); /* find key */
+    if (res != 0)                                          /* check result */
+    {
+        return res;                                        /* return error */
+    }
+    
+    return a_w25qxx_kv_write(kv, key, key_len, W25QXX_KV_FLAG_DELETE, NULL, 0,
+                             hash, &slot);                 /* write tombstone */
+}
+
+/**
+ * @brief     run one background compaction step
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 compact failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      the oldest sector is compacted only when less than W25QXX_KV_GC_FREE sectors are erased,
+ *            call it from an idle loop to keep w25qxx_kv_set off the erase path
+ */
+uint8_t w25qxx_kv_gc(w25qxx_kv_t *kv)
+{
+    if (kv == NULL)                                               /* check handle */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (kv->inited != 1)                                          /* check handle initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    if (kv->mounted != 1)                                         /* check mounted */
+    {
+        kv->handle->debug_print("w25qxx: not mounted.\n");        /* not mounted */
+        
+        return 4;                                                 /* return error */
+    }
+    
+    if ((kv->free < W25QXX_KV_GC_FREE) && (kv->tail != kv->head)) /* check free sectors */
+    {
+        if (a_w25qxx_kv_compact(kv) != 0)                         /* compact the tail */
+        {
+            return 1;                                             /* return error */
+        }
+    }
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the store usage
+ * @param[in]  *kv pointer to a w25qxx kv structure
+ * @param[out] *count pointer to a live key count buffer
+ * @param[out] *free_sector pointer to an erased sector count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_kv_get_usage(w25qxx_kv_t *kv, uint32_t *count, uint32_t *free_sector)
+{
+    if (kv == NULL)                                        /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    if (kv->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                          /* return error */
+    }
+    if (kv->mounted != 1)                                  /* check mounted */
+    {
+        kv->handle->debug_print("w25qxx: not mounted.\n"); /* not mounted */
+        
+        return 4;                                          /* return error */
+    }
+    
+    *count = kv->count;                                    /* set count */
+    *free_sector = kv->free;                               /* set free sectors */
+    
+    return 0;                                              /* success return 0 */
+}
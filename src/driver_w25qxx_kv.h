@@ -0,0 +1,263 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_kv.h
+ * @brief     driver w25qxx kv header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_KV_H
+#define DRIVER_W25QXX_KV_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_kv_driver w25qxx kv driver function
+ * @brief    w25qxx log structured key value store modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx kv max key length definition
+ */
+#ifndef W25QXX_KV_KEY_MAX
+    #define W25QXX_KV_KEY_MAX        32        /**< 32 bytes */
+#endif
+
+/**
+ * @brief w25qxx kv max record length definition
+ */
+#ifndef W25QXX_KV_RECORD_MAX
+    #define W25QXX_KV_RECORD_MAX     256       /**< header, key and value */
+#endif
+
+/**
+ * @brief w25qxx kv free sector threshold definition
+ */
+#ifndef W25QXX_KV_GC_FREE
+    #define W25QXX_KV_GC_FREE        2         /**< background compaction keeps this many erased sectors */
+#endif
+
+/**
+ * @brief w25qxx kv record header size definition
+ */
+#define W25QXX_KV_RECORD_HEADER      8         /**< key length, flag, value length and crc32 */
+
+/**
+ * @brief w25qxx kv index entry structure definition
+ */
+typedef struct w25qxx_kv_entry_s
+{
+    uint32_t hash;        /**< key hash */
+    uint32_t addr;        /**< record address, 0xFFFFFFFF means empty */
+} w25qxx_kv_entry_t;
+
+/**
+ * @brief w25qxx kv structure definition
+ */
+typedef struct w25qxx_kv_s
+{
+    w25qxx_handle_t *handle;                    /**< w25qxx handle */
+    w25qxx_kv_entry_t *index;                   /**< hash index */
+    uint32_t index_size;                        /**< index entries, power of 2 */
+    uint32_t count;                             /**< live keys */
+    uint32_t addr;                              /**< region address */
+    uint32_t sector_count;                      /**< region sectors */
+    uint32_t head;                              /**< sector being appended */
+    uint32_t tail;                              /**< oldest sector */
+    uint32_t free;                              /**< erased sectors */
+    uint32_t offset;                            /**< append offset inside the head sector */
+    uint32_t seq;                               /**< head sector sequence */
+    uint8_t buf[W25QXX_KV_RECORD_MAX];          /**< record buffer */
+    uint8_t mounted;                            /**< mounted flag */
+    uint8_t inited;                             /**< inited flag */
+} w25qxx_kv_t;
+
+/**
+ * @brief     initialize the kv store
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] *index pointer to an index buffer
+ * @param[in] index_size index entries
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 index size is invalid
+ * @note      addr and len must be 4k aligned and hold at least 3 sectors,
+ *            index_size must be a power of 2 and larger than the key count
+ */
+uint8_t w25qxx_kv_init(w25qxx_kv_t *kv, w25qxx_handle_t *handle, uint32_t addr, uint32_t len,
+                       w25qxx_kv_entry_t *index, uint32_t index_size);
+
+/**
+ * @brief     deinit the kv store
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_kv_deinit(w25qxx_kv_t *kv);
+
+/**
+ * @brief     erase the region and start an empty store
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_kv_format(w25qxx_kv_t *kv);
+
+/**
+ * @brief     mount the store and rebuild the index
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no valid sector
+ *            - 5 index is full
+ * @note      a record torn by a power loss ends its sector, the rest of that sector is skipped
+ */
+uint8_t w25qxx_kv_mount(w25qxx_kv_t *kv);
+
+/**
+ * @brief     set a key
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *key pointer to a key buffer
+ * @param[in] key_len key length
+ * @param[in] *value pointer to a value buffer
+ * @param[in] value_len value length
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 key or value is invalid
+ *            - 6 no space
+ *            - 7 index is full
+ * @note      the record is appended with page programs, no sector is read back or erased
+ *            unless a compaction is needed to make room
+ */
+uint8_t w25qxx_kv_set(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len, const uint8_t *value, uint16_t value_len);
+
+/**
+ * @brief      get a key
+ * @param[in]  *kv pointer to a w25qxx kv structure
+ * @param[in]  *key pointer to a key buffer
+ * @param[in]  key_len key length
+ * @param[out] *value pointer to a value buffer
+ * @param[in]  value_size value buffer size
+ * @param[out] *value_len pointer to a value length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 key is invalid
+ *             - 6 key is not found
+ *             - 7 value buffer is too small
+ * @note       none
+ */
+uint8_t w25qxx_kv_get(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len,
+                      uint8_t *value, uint16_t value_size, uint16_t *value_len);
+
+/**
+ * @brief     delete a key
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @param[in] *key pointer to a key buffer
+ * @param[in] key_len key length
+ * @return    status code
+ *            - 0 success
+ *            - 1 delete failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 key is invalid
+ *            - 6 key is not found or no space
+ * @note      a tombstone record is appended
+ */
+uint8_t w25qxx_kv_delete(w25qxx_kv_t *kv, const uint8_t *key, uint8_t key_len);
+
+/**
+ * @brief     run one background compaction step
+ * @param[in] *kv pointer to a w25qxx kv structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 compact failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      the oldest sector is compacted only when less than W25QXX_KV_GC_FREE sectors are erased,
+ *            call it from an idle loop to keep w25qxx_kv_set off the erase path
+ */
+uint8_t w25qxx_kv_gc(w25qxx_kv_t *kv);
+
+/**
+ * @brief      get the store usage
+ * @param[in]  *kv pointer to a w25qxx kv structure
+ * @param[out] *count pointer to a live key count buffer
+ * @param[out] *free_sector pointer to an erased sector count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_kv_get_usage(w25qxx_kv_t *kv, uint32_t *count, uint32_t *free_sector);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,767 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_log.c
+ * @brief     driver w25qxx log source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_log.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief log sector header definition
+ */
+#define W25QXX_LOG_MAGIC        0x30474C43U        /**< "CLG0" */
+
+/**
+ * @brief     get the padded record length
+ * @param[in] len data length
+ * @return    record length
+ * @note      records are 4 bytes aligned
+ */
+static uint32_t a_w25qxx_log_record_len(uint32_t len)
+{
+    return (W25QXX_LOG_RECORD_HEADER + len + 3U) & ~3U; /* return length */
+}
+
+/**
+ * @brief     get the address of a sector
+ * @param[in] *log pointer to a w25qxx log structure
+ * @param[in] seq sector sequence
+ * @return    sector address
+ * @note      the sector of a sequence is fixed, sector = seq % sector_count
+ */
+static uint32_t a_w25qxx_log_sector_addr(w25qxx_log_t *log, uint32_t seq)
+{
+    return log->addr + (seq % log->sector_count) * W25QXX_LOG_SECTOR_SIZE; /* return address */
+}
+
+/**
+ * @brief      read and check a sector header
+ * @param[in]  *log pointer to a w25qxx log structure
+ * @param[in]  sector sector index
+ * @param[out] *seq pointer to a sequence buffer
+ * @param[out] *valid pointer to a valid flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_w25qxx_log_read_header(w25qxx_log_t *log, uint32_t sector, uint32_t *seq, uint8_t *valid)
+{
+    uint8_t header[W25QXX_LOG_HEADER_SIZE];
+    
+    log->mount_read++;                                          /* read++ */
+    if (w25qxx_read(log->handle, log->addr + sector * W25QXX_LOG_SECTOR_SIZE,
+                    header, W25QXX_LOG_HEADER_SIZE) != 0)       /* read header */
+    {
+        log->handle->debug_print("w25qxx: read failed.\n");     /* read failed */
+        
+        return 1;                                               /* return error */
+    }
+    *seq = w25qxx_util_get32(&header[4]);                       /* get sequence */
+    *valid = (uint8_t)((w25qxx_util_get32(&header[0]) == W25QXX_LOG_MAGIC) &&
+                       (w25qxx_util_get32(&header[8]) == (uint32_t)~(*seq)) &&
+                       (w25qxx_util_get32(&header[12]) == w25qxx_util_crc32(0xFFFFFFFFU, header, 12)) &&
+                       ((*seq % log->sector_count) == sector)); /* check header */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      check whether a sector is blank
+ * @param[in]  *log pointer to a w25qxx log structure
+ * @param[in]  sector sector index
+ * @param[out] *blank pointer to a blank flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_w25qxx_log_blank_check(w25qxx_log_t *log, uint32_t sector, uint8_t *blank)
+{
+    uint32_t addr;
+    uint32_t i;
+    uint32_t j;
+    
+    addr = log->addr + sector * W25QXX_LOG_SECTOR_SIZE;                          /* get address */
+    *blank = 1;                                                                  /* init blank */
+    for (i = 0; i < W25QXX_LOG_SECTOR_SIZE; i += sizeof(log->buf))               /* loop the sector */
+    {
+        if (w25qxx_read(log->handle, addr + i, log->buf, sizeof(log->buf)) != 0) /* read data */
+        {
+            log->handle->debug_print("w25qxx: read failed.\n");                  /* read failed */
+            
+            return 1;                                                            /* return error */
+        }
+        for (j = 0; j < sizeof(log->buf); j++)                                   /* check all bytes */
+        {
+            if (log->buf[j] != 0xFF)                                             /* not blank */
+            {
+                *blank = 0;                                                      /* set not blank */
+                
+                return 0;                                                        /* success return 0 */
+            }
+        }
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     write the header of a sector
+ * @param[in] *log pointer to a w25qxx log structure
+ * @param[in] seq sector sequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      the sector must be erased
+ */
+static uint8_t a_w25qxx_log_write_header(w25qxx_log_t *log, uint32_t seq)
+{
+    uint8_t header[W25QXX_LOG_HEADER_SIZE];
+    
+    w25qxx_util_put32(&header[0], W25QXX_LOG_MAGIC);                              /* set magic */
+    w25qxx_util_put32(&header[4], seq);                                           /* set sequence */
+    w25qxx_util_put32(&header[8], ~seq);                                          /* set inverted sequence */
+    w25qxx_util_put32(&header[12], w25qxx_util_crc32(0xFFFFFFFFU, header, 12));   /* set crc */
+    if (w25qxx_page_program(log->handle, a_w25qxx_log_sector_addr(log, seq),
+                            header, W25QXX_LOG_HEADER_SIZE) != 0)                 /* page program */
+    {
+        log->handle->debug_print("w25qxx: page program failed.\n");               /* page program failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     open the next sector
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the sector erase_ahead sectors after the new head is erased first,
+ *            so the erased window always moves in front of the writer
+ */
+static uint8_t a_w25qxx_log_open(w25qxx_log_t *log)
+{
+    uint32_t ahead;
+    
+    ahead = log->seq + 1 + log->erase_ahead;                                            /* erase ahead sequence */
+    if (w25qxx_sector_erase_4k(log->handle, a_w25qxx_log_sector_addr(log, ahead)) != 0) /* sector erase */
+    {
+        log->handle->debug_print("w25qxx: sector erase 4k failed.\n");                  /* sector erase 4k failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    if (ahead >= log->sector_count)                                                     /* wrapped */
+    {
+        if ((int32_t)(ahead - log->sector_count + 1 - log->tail_seq) > 0)               /* oldest sector erased */
+        {
+            log->tail_seq = ahead - log->sector_count + 1;                              /* drop the oldest sector */
+        }
+    }
+    if (a_w25qxx_log_write_header(log, log->seq + 1) != 0)                              /* write header */
+    {
+        return 1;                                                                       /* return error */
+    }
+    log->seq++;                                                                         /* sequence++ */
+    log->offset = W25QXX_LOG_HEADER_SIZE;                                               /* first record */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     initialize the log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] erase_ahead erased sectors kept ahead of the head
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 erase ahead is invalid
+ * @note      addr and len must be 4k aligned, erase_ahead must be at least 1 and
+ *            leave at least 2 sectors for data
+ */
+uint8_t w25qxx_log_init(w25qxx_log_t *log, w25qxx_handle_t *handle, uint32_t addr, uint32_t len, uint32_t erase_ahead)
+{
+    if ((log == NULL) || (handle == NULL))                                      /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    if ((addr % W25QXX_LOG_SECTOR_SIZE) != 0)                                   /* check addr */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");                      /* addr is invalid */
+        
+        return 4;                                                               /* return error */
+    }
+    if (((len % W25QXX_LOG_SECTOR_SIZE) != 0) || (len == 0))                    /* check len */
+    {
+        handle->debug_print("w25qxx: len is invalid.\n");                       /* len is invalid */
+        
+        return 5;                                                               /* return error */
+    }
+    if ((erase_ahead == 0) || (erase_ahead + 2 > len / W25QXX_LOG_SECTOR_SIZE)) /* check erase ahead */
+    {
+        handle->debug_print("w25qxx: erase ahead is invalid.\n");               /* erase ahead is invalid */
+        
+        return 6;                                                               /* return error */
+    }
+    
+    memset(log, 0, sizeof(w25qxx_log_t));                                       /* clear log */
+    log->handle = handle;                                                       /* set handle */
+    log->addr = addr;                                                           /* set addr */
+    log->sector_count = len / W25QXX_LOG_SECTOR_SIZE;                           /* set sector count */
+    log->erase_ahead = erase_ahead;                                             /* set erase ahead */
+    log->inited = 1;                                                            /* set inited */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     deinit the log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_log_deinit(w25qxx_log_t *log)
+{
+    if (log == NULL)      /* check handle */
+    {
+        return 2;         /* return error */
+    }
+    if (log->inited != 1) /* check handle initialization */
+    {
+        return 3;         /* return error */
+    }
+    
+    log->mounted = 0;     /* clear mounted */
+    log->inited = 0;      /* clear inited */
+    
+    return 0;             /* success return 0 */
+}
+
+/**
+ * @brief     erase the region and start an empty log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      64k aligned parts of the region are erased with block erases
+ */
+uint8_t w25qxx_log_format(w25qxx_log_t *log)
+{
+    uint8_t res;
+    uint32_t addr;
+    uint32_t end;
+    
+    if (log == NULL)                                              /* check handle */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (log->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    
+    log->mounted = 0;                                             /* clear mounted */
+    addr = log->addr;                                             /* region start */
+    end = log->addr + log->sector_count * W25QXX_LOG_SECTOR_SIZE; /* region end */
+    while (addr < end)                                            /* erase the region */
+    {
+        if (((addr % 65536) == 0) && (end - addr >= 65536))       /* whole 64k block */
+        {
+            res = w25qxx_block_erase_64k(log->handle, addr);      /* block erase 64k */
+            addr += 65536;                                        /* next block */
+        }
+        else
+        {
+            res = w25qxx_sector_erase_4k(log->handle, addr);      /* sector erase 4k */
+            addr += W25QXX_LOG_SECTOR_SIZE;                       /* next sector */
+        }
+        if (res != 0)                                             /* check result */
+        {
+            log->handle->debug_print("w25qxx: erase failed.\n");  /* erase failed */
+            
+            return 1;                                             /* return error */
+        }
+    }
+    if (a_w25qxx_log_write_header(log, 0) != 0)                   /* first sector */
+    {
+        return 1;                                                 /* return error */
+    }
+    log->seq = 0;                                                 /* set sequence */
+    log->tail_seq = 0;                                            /* set tail */
+    log->offset = W25QXX_LOG_HEADER_SIZE;                         /* first record */
+    log->mounted = 1;                                             /* set mounted */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     mount the log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 no valid log
+ * @note      the head sector is found by a binary search over the sector headers,
+ *            only the head sector and the erase ahead sectors are scanned, a leading
+ *            window of erase_ahead + 1 blank sectors left by an open torn between its
+ *            erase and its header is skipped
+ */
+uint8_t w25qxx_log_mount(w25qxx_log_t *log)
+{
+    uint8_t valid;
+    uint8_t blank;
+    uint32_t i;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    uint32_t seq;
+    uint32_t lap;
+    uint32_t base;
+    uint32_t off;
+    uint32_t win;
+    uint32_t win_len;
+    uint32_t len;
+    
+    if (log == NULL)                                                                               /* check handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (log->inited != 1)                                                                          /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    
+    log->mounted = 0;                                                                              /* clear mounted */
+    log->mount_read = 0;                                                                           /* clear reads */
+    valid = 0;                                                                                     /* init 0 */
+    seq = 0;                                                                                       /* init 0 */
+    for (i = 0; i <= log->erase_ahead + 1; i++)                                                    /* skip a leading erased window */
+    {
+        if (a_w25qxx_log_read_header(log, i, &seq, &valid) != 0)                                   /* read header */
+        {
+            return 1;                                                                              /* return error */
+        }
+        if (valid != 0)                                                                            /* first written sector */
+        {
+            break;                                                                                 /* break */
+        }
+    }
+    if (valid == 0)                                                                                /* check valid */
+    {
+        log->handle->debug_print("w25qxx: no valid log.\n");                                       /* no valid log */
+        
+        return 5;                                                                                  /* return error */
+    }
+    
+    lap = seq - i;                                                                                 /* sequence of sector 0 in this lap */
+    lo = i;                                                                                        /* known in the lap */
+    hi = log->sector_count - 1;                                                                    /* last sector */
+    while (lo < hi)                                                                                /* find the last sector of the lap */
+    {
+        mid = lo + (hi - lo + 1) / 2;                                                              /* get middle */
+        if (a_w25qxx_log_read_header(log, mid, &seq, &valid) != 0)                                 /* read header */
+        {
+            return 1;                                                                              /* return error */
+        }
+        if ((valid != 0) && (seq - mid == lap))                                                    /* same lap */
+        {
+            lo = mid;                                                                              /* search upper half */
+        }
+        else
+        {
+            hi = mid - 1;                                                                          /* search lower half */
+        }
+    }
+    log->seq = lap + lo;                                                                           /* set head sequence */
+    
+    for (i = 1; i <= log->erase_ahead; i++)                                                        /* restore the erased window */
+    {
+        lo = (log->seq + i) % log->sector_count;                                                   /* get sector */
+        if (a_w25qxx_log_blank_check(log, lo, &blank) != 0)                                        /* blank check */
+        {
+            return 1;                                                                              /* return error */
+        }
+        if (blank == 0)                                                                            /* not erased */
+        {
+            if (w25qxx_sector_erase_4k(log->handle, log->addr + lo * W25QXX_LOG_SECTOR_SIZE) != 0) /* sector erase */
+            {
+                log->handle->debug_print("w25qxx: sector erase 4k failed.\n");                     /* sector erase 4k failed */
+                
+                return 1;                                                                          /* return error */
+            }
+        }
+    }
+    
+    log->tail_seq = 0;                                                                             /* not wrapped yet */
+    if (log->seq >= log->sector_count - log->erase_ahead - 1)                                      /* wrapped */
+    {
+        log->tail_seq = log->seq - (log->sector_count - log->erase_ahead - 1);                     /* oldest kept sector */
+        if (a_w25qxx_log_read_header(log, log->tail_seq % log->sector_count, &seq, &valid) != 0)   /* read header */
+        {
+            return 1;                                                                              /* return error */
+        }
+        if ((valid == 0) || (seq != log->tail_seq))                                                /* erased before its successor was opened */
+        {
+            log->tail_seq++;                                                                       /* next sector */
+        }
+    }
+    
+    base = a_w25qxx_log_sector_addr(log, log->seq);                                                /* head sector address */
+    off = W25QXX_LOG_HEADER_SIZE;                                                                  /* first record */
+    win = 0;                                                                                       /* init 0 */
+    win_len = 0;                                                                                   /* empty window */
+    while (1)                                                                                      /* walk the head records */
+    {
+        if (off + W25QXX_LOG_RECORD_HEADER > W25QXX_LOG_SECTOR_SIZE)                               /* sector is full */
+        {
+            off = W25QXX_LOG_SECTOR_SIZE;                                                          /* close it */
+            
+            break;                                                                                 /* break */
+        }
+        if ((off < win) || (off + W25QXX_LOG_RECORD_HEADER > win + win_len))                       /* outside the window */
+        {
+            win = off;                                                                             /* set window */
+            win_len = W25QXX_LOG_SECTOR_SIZE - off;                                                /* get remain */
+            if (win_len > sizeof(log->buf))                                                        /* check length */
+            {
+                win_len = sizeof(log->buf);                                                        /* set length */
+            }
+            if (w25qxx_read(log->handle, base + win, log->buf, win_len) != 0)                      /* read window */
+            {
+                log->handle->debug_print("w25qxx: read failed.\n");                                /* read failed */
+                
+                return 1;                                                                          /* return error */
+            }
+        }
+        len = (uint32_t)log->buf[off - win] | ((uint32_t)log->buf[off - win + 1] << 8);            /* get length */
+        if ((w25qxx_util_get32(&log->buf[off - win]) == 0xFFFFFFFFU) &&
+            (w25qxx_util_get32(&log->buf[off - win + 4]) == 0xFFFFFFFFU))                          /* erased */
+        {
+            break;                                                                                 /* append here */
+        }
+        if ((((uint32_t)log->buf[off - win + 2] | ((uint32_t)log->buf[off - win + 3] << 8)) != (len ^ 0xFFFFU)) ||
+            (len > W25QXX_LOG_RECORD_MAX) ||
+            (off + a_w25qxx_log_record_len(len) > W25QXX_LOG_SECTOR_SIZE))                         /* torn header */
+        {
+            off = W25QXX_LOG_SECTOR_SIZE;                                                          /* close the sector */
+            
+            break;                                                                                 /* break */
+        }
+        off += a_w25qxx_log_record_len(len);                                                       /* next record */
+    }
+    log->offset = off;                                                                             /* set offset */
+    log->mounted = 1;                                                                              /* set mounted */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     check the handle
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      none
+ */
+static uint8_t a_w25qxx_log_check(w25qxx_log_t *log)
+{
+    if (log == NULL)       /* check handle */
+    {
+        return 2;          /* return error */
+    }
+    if (log->inited != 1)  /* check handle initialization */
+    {
+        return 3;          /* return error */
+    }
+    if (log->mounted != 1) /* check mounted */
+    {
+        return 4;          /* return error */
+    }
+    
+    return 0;              /* success return 0 */
+}
+
+/**
+ * @brief     append a record
+ * @param[in] *log pointer to a w25qxx log structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 len is invalid
+ * @note      len <= W25QXX_LOG_RECORD_MAX, opening a new sector erases the oldest one ahead of the head
+ */
+uint8_t w25qxx_log_append(w25qxx_log_t *log, const uint8_t *buf, uint32_t len)
+{
+    uint8_t res;
+    uint8_t header[W25QXX_LOG_RECORD_HEADER];
+    uint32_t total;
+    uint32_t addr;
+    uint32_t pos;
+    uint32_t chunk;
+    uint32_t i;
+    
+    res = a_w25qxx_log_check(log);                                                  /* check handle */
+    if (res != 0)                                                                   /* check result */
+    {
+        return res;                                                                 /* return error */
+    }
+    if ((buf == NULL) || (len == 0) || (len > W25QXX_LOG_RECORD_MAX))               /* check len */
+    {
+        log->handle->debug_print("w25qxx: len is invalid.\n");                      /* len is invalid */
+        
+        return 5;                                                                   /* return error */
+    }
+    
+    total = a_w25qxx_log_record_len(len);                                           /* get record length */
+    if (log->offset + total > W25QXX_LOG_SECTOR_SIZE)                               /* head is full */
+    {
+        if (a_w25qxx_log_open(log) != 0)                                            /* open next sector */
+        {
+            return 1;                                                               /* return error */
+        }
+    }
+    header[0] = (uint8_t)(len >> 0);                                                /* set length */
+    header[1] = (uint8_t)(len >> 8);                                                /* set length */
+    header[2] = (uint8_t)~(len >> 0);                                               /* set inverted length */
+    header[3] = (uint8_t)~(len >> 8);                                               /* set inverted length */
+    w25qxx_util_put32(&header[4], w25qxx_util_crc32(0xFFFFFFFFU, buf, len));        /* set crc */
+    addr = a_w25qxx_log_sector_addr(log, log->seq) + log->offset;                   /* get address */
+    pos = 0;                                                                        /* init 0 */
+    while (pos < total)                                                             /* one program per page */
+    {
+        chunk = 256 - (addr % 256);                                                 /* get page remain */
+        if (chunk > total - pos)                                                    /* check length */
+        {
+            chunk = total - pos;                                                    /* set length */
+        }
+        for (i = 0; i < chunk; i++)                                                 /* stage header, data and pad */
+        {
+            if (pos + i < W25QXX_LOG_RECORD_HEADER)                                 /* header */
+            {
+                log->buf[i] = header[pos + i];                                      /* copy header */
+            }
+            else if (pos + i - W25QXX_LOG_RECORD_HEADER < len)                      /* data */
+            {
+                log->buf[i] = buf[pos + i - W25QXX_LOG_RECORD_HEADER];              /* copy data */
+            }
+            else
+            {
+                log->buf[i] = 0xFF;                                                 /* pad */
+            }
+        }
+        if (w25qxx_page_program(log->handle, addr, log->buf, (uint16_t)chunk) != 0) /* page program */
+        {
+            log->handle->debug_print("w25qxx: page program failed.\n");             /* page program failed */
+            log->offset = W25QXX_LOG_SECTOR_SIZE;                                   /* close the sector */
+            
+            return 1;                                                               /* return error */
+        }
+        addr += chunk;                                                              /* address + chunk */
+        pos += chunk;                                                               /* position + chunk */
+    }
+    log->offset += total;                                                           /* offset + length */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      move a cursor to the oldest record
+ * @param[in]  *log pointer to a w25qxx log structure
+ * @param[out] *cursor pointer to a w25qxx log cursor structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_log_rewind(w25qxx_log_t *log, w25qxx_log_cursor_t *cursor)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_log_check(log);           /* check handle */
+    if (res != 0)                            /* check result */
+    {
+        return res;                          /* return error */
+    }
+    
+    cursor->seq = log->tail_seq;             /* oldest sector */
+    cursor->offset = W25QXX_LOG_HEADER_SIZE; /* first record */
+    
+    return 0;                                /* success return 0 */
+}
+
+/**
+ * @brief         read the record at the cursor and advance it
+ * @param[in]     *log pointer to a w25qxx log structure
+ * @param[in,out] *cursor pointer to a w25qxx log cursor structure
+ * @param[out]    *buf pointer to a data buffer
+ * @param[in]     size data buffer size
+ * @param[out]    *len pointer to a data length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 not mounted
+ *                - 5 no more record
+ *                - 6 buffer is too small
+ * @note          a cursor whose sector was erased restarts at the oldest record,
+ *                records with a bad crc are skipped, the cursor does not move when the buffer is too small
+ */
+uint8_t w25qxx_log_next(w25qxx_log_t *log, w25qxx_log_cursor_t *cursor, uint8_t *buf, uint32_t size, uint32_t *len)
+{
+    uint8_t res;
+    uint8_t header[W25QXX_LOG_RECORD_HEADER];
+    uint32_t addr;
+    uint32_t l;
+    
+    res = a_w25qxx_log_check(log);                                                               /* check handle */
+    if (res != 0)                                                                                /* check result */
+    {
+        return res;                                                                              /* return error */
+    }
+    
+    if (((int32_t)(cursor->seq - log->tail_seq) < 0) || ((int32_t)(cursor->seq - log->seq) > 0)) /* sector was erased */
+    {
+        cursor->seq = log->tail_seq;                                                             /* oldest sector */
+        cursor->offset = W25QXX_LOG_HEADER_SIZE;                                                 /* first record */
+    }
+    while (1)                                                                                    /* find the next good record */
+    {
+        if ((cursor->seq == log->seq) && (cursor->offset >= log->offset))                        /* reach the head */
+        {
+            return 5;                                                                            /* no more record */
+        }
+        if (cursor->offset + W25QXX_LOG_RECORD_HEADER > W25QXX_LOG_SECTOR_SIZE)                  /* end of sector */
+        {
+            cursor->seq++;                                                                       /* next sector */
+            cursor->offset = W25QXX_LOG_HEADER_SIZE;                                             /* first record */
+            
+            continue;                                                                            /* continue */
+        }
+        addr = a_w25qxx_log_sector_addr(log, cursor->seq) + cursor->offset;                      /* get address */
+        if (w25qxx_read(log->handle, addr, header, W25QXX_LOG_RECORD_HEADER) != 0)               /* read header */
+        {
+            log->handle->debug_print("w25qxx: read failed.\n");                                  /* read failed */
+            
+            return 1;                                                                            /* return error */
+        }
+        l = (uint32_t)header[0] | ((uint32_t)header[1] << 8);                                    /* get length */
+        if ((((uint32_t)header[2] | ((uint32_t)header[3] << 8)) != (l ^ 0xFFFFU)) ||
+            (l > W25QXX_LOG_RECORD_MAX) ||
+            (cursor->offset + a_w25qxx_log_record_len(l) > W25QXX_LOG_SECTOR_SIZE))              /* erased or torn */
+        {
+            cursor->offset = W25QXX_LOG_SECTOR_SIZE;                                             /* skip the sector rest */
+            
+            continue;                                                                            /* continue */
+        }
+        if (l > size)                                                                            /* check buffer */
+        {
+            *len = l;                                                                            /* set length */
+            
+            return 6;                                                                            /* return error */
+        }
+        if (w25qxx_read(log->handle, addr + W25QXX_LOG_RECORD_HEADER, buf, l) != 0)              /* read data */
+        {
+            log->handle->debug_print("w25qxx: read failed.\n");                                  /* read failed */
+            
+            return 1;                                                                            /* return error */
+        }
+        cursor->offset += a_w25qxx_log_record_len(l);                                            /* next record */
+        if (w25qxx_util_get32(&header[4]) != w25qxx_util_crc32(0xFFFFFFFFU, buf, l))             /* check crc */
+        {
+            continue;                                                                            /* skip the record */
+        }
+        *len = l;                                                                                /* set length */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+}
+
+/**
+ * @brief      get the log info
+ * @param[in]  *log pointer to a w25qxx log structure
+ * @param[out] *info pointer to a w25qxx log info structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_log_get_info(w25qxx_log_t *log, w25qxx_log_info_t *info)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_log_check(log);      /* check handle */
+    if (res != 0)                       /* check result */
+    {
+        return res;                     /* return error */
+    }
+    
+    info->head_seq = log->seq;          /* set head */
+    info->tail_seq = log->tail_seq;     /* set tail */
+    info->offset = log->offset;         /* set offset */
+    info->mount_read = log->mount_read; /* set reads */
+    
+    return 0;                           /* success return 0 */
+}
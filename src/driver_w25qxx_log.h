@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_log.h
+ * @brief     driver w25qxx log header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_LOG_H
+#define DRIVER_W25QXX_LOG_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_log_driver w25qxx log driver function
+ * @brief    w25qxx append only circular log modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx log sector definition
+ */
+#define W25QXX_LOG_SECTOR_SIZE       4096U        /**< sector size */
+#define W25QXX_LOG_HEADER_SIZE       16U          /**< sector header size */
+#define W25QXX_LOG_RECORD_HEADER     8U           /**< length, inverted length and crc32 */
+
+/**
+ * @brief w25qxx log max record length definition
+ */
+#define W25QXX_LOG_RECORD_MAX        (W25QXX_LOG_SECTOR_SIZE - W25QXX_LOG_HEADER_SIZE - W25QXX_LOG_RECORD_HEADER)
+
+/**
+ * @brief w25qxx log cursor structure definition
+ */
+typedef struct w25qxx_log_cursor_s
+{
+    uint32_t seq;           /**< sequence of the sector being read */
+    uint32_t offset;        /**< offset inside the sector */
+} w25qxx_log_cursor_t;
+
+/**
+ * @brief w25qxx log info structure definition
+ */
+typedef struct w25qxx_log_info_s
+{
+    uint32_t head_seq;             /**< sequence of the sector being appended */
+    uint32_t tail_seq;             /**< sequence of the oldest sector */
+    uint32_t offset;               /**< append offset inside the head sector */
+    uint32_t mount_read;           /**< sector header reads of the last mount */
+} w25qxx_log_info_t;
+
+/**
+ * @brief w25qxx log structure definition
+ */
+typedef struct w25qxx_log_s
+{
+    w25qxx_handle_t *handle;        /**< w25qxx handle */
+    uint32_t addr;                  /**< region address */
+    uint32_t sector_count;          /**< region sectors */
+    uint32_t erase_ahead;           /**< erased sectors kept ahead of the head */
+    uint32_t seq;                   /**< head sector sequence */
+    uint32_t tail_seq;              /**< oldest sector sequence */
+    uint32_t offset;                /**< append offset inside the head sector */
+    uint32_t mount_read;            /**< sector header reads of the last mount */
+    uint8_t buf[256];               /**< page buffer */
+    uint8_t mounted;                /**< mounted flag */
+    uint8_t inited;                 /**< inited flag */
+} w25qxx_log_t;
+
+/**
+ * @brief     initialize the log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] erase_ahead erased sectors kept ahead of the head
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 erase ahead is invalid
+ * @note      addr and len must be 4k aligned, erase_ahead must be at least 1 and
+ *            leave at least 2 sectors for data
+ */
+uint8_t w25qxx_log_init(w25qxx_log_t *log, w25qxx_handle_t *handle, uint32_t addr, uint32_t len, uint32_t erase_ahead);
+
+/**
+ * @brief     deinit the log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_log_deinit(w25qxx_log_t *log);
+
+/**
+ * @brief     erase the region and start an empty log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      64k aligned parts of the region are erased with block erases
+ */
+uint8_t w25qxx_log_format(w25qxx_log_t *log);
+
+/**
+ * @brief     mount the log
+ * @param[in] *log pointer to a w25qxx log structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 no valid log
+ * @note      the head sector is found by a binary search over the sector headers,
+ *            only the head sector and the erase ahead sectors are scanned, a leading
+ *            window of erase_ahead + 1 blank sectors left by an open torn between its
+ *            erase and its header is skipped
+ */
+uint8_t w25qxx_log_mount(w25qxx_log_t *log);
+
+/**
+ * @brief     append a record
+ * @param[in] *log pointer to a w25qxx log structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 len is invalid
+ * @note      len <= W25QXX_LOG_RECORD_MAX, opening a new sector erases the oldest one ahead of the head
+ */
+uint8_t w25qxx_log_append(w25qxx_log_t *log, const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief      move a cursor to the oldest record
+ * @param[in]  *log pointer to a w25qxx log structure
+ * @param[out] *cursor pointer to a w25qxx log cursor structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_log_rewind(w25qxx_log_t *log, w25qxx_log_cursor_t *cursor);
+
+/**
+ * @brief         read the record at the cursor and advance it
+ * @param[in]     *log pointer to a w25qxx log structure
+ * @param[in,out] *cursor pointer to a w25qxx log cursor structure
+ * @param[out]    *buf pointer to a data buffer
+ * @param[in]     size data buffer size
+ * @param[out]    *len pointer to a data length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 not mounted
+ *                - 5 no more record
+ *                - 6 buffer is too small
+ * @note          a cursor whose sector was erased restarts at the oldest record,
+ *                records with a bad crc are skipped, the cursor does not move when the buffer is too small
+ */
+uint8_t w25qxx_log_next(w25qxx_log_t *log, w25qxx_log_cursor_t *cursor, uint8_t *buf, uint32_t size, uint32_t *len);
+
+/**
+ * @brief      get the log info
+ * @param[in]  *log pointer to a w25qxx log structure
+ * @param[out] *info pointer to a w25qxx log info structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_log_get_info(w25qxx_log_t *log, w25qxx_log_info_t *info);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,627 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_mirror.c
+ * @brief     driver w25qxx mirror source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_mirror.h"
+
+/**
+ * @brief     lock the mirror state
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @note      none
+ */
+static void a_w25qxx_mirror_lock(w25qxx_mirror_t *mirror)
+{
+    if (mirror->lock != NULL) /* check the hook */
+    {
+        mirror->lock();       /* lock */
+    }
+}
+
+/**
+ * @brief     unlock the mirror state
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @note      none
+ */
+static void a_w25qxx_mirror_unlock(w25qxx_mirror_t *mirror)
+{
+    if (mirror->unlock != NULL) /* check the hook */
+    {
+        mirror->unlock();       /* unlock */
+    }
+}
+
+/**
+ * @brief     check the mirror and a range
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] addr volume address
+ * @param[in] len range length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      none
+ */
+static uint8_t a_w25qxx_mirror_check(w25qxx_mirror_t *mirror, uint32_t addr, uint32_t len)
+{
+    if (mirror == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (mirror->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    if ((addr > mirror->size) || (len > (mirror->size - addr)))        /* check range */
+    {
+        mirror->handle[0]->debug_print("w25qxx: range is invalid.\n"); /* range is invalid */
+        
+        return 5;                                                      /* return error */
+    }
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      pick the chip serving a read
+ * @param[in]  *mirror pointer to a w25qxx mirror structure
+ * @param[in]  verify 1 to pick chip 0 for a verified read
+ * @param[in]  exclude chip index left out, 0xFF if none
+ * @param[out] *chip pointer to a chip index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 pick failed
+ * @note       the picked chip counts one more reader and must be released
+ */
+static uint8_t a_w25qxx_mirror_pick(w25qxx_mirror_t *mirror, uint8_t verify, uint8_t exclude, uint8_t *chip)
+{
+    uint8_t i;
+    uint8_t num;
+    uint8_t cand[2];
+    uint32_t timeout;
+    w25qxx_bool_t busy;
+    
+    timeout = W25QXX_ERASE_64K_TIMEOUT_MS * 100;                               /* set timeout */
+    while (1)                                                                  /* poll */
+    {
+        /* the chip being modified holds its handle lock, it is skipped without a poll */
+        a_w25qxx_mirror_lock(mirror);                                          /* lock */
+        num = 0;                                                               /* init 0 */
+        for (i = 0; i < 2; i++)                                                /* loop both chips */
+        {
+            cand[num] = (verify != 0) ? i : (uint8_t)((mirror->next + i) % 2); /* preferred order */
+            if ((mirror->active != cand[num]) && (exclude != cand[num]))       /* check chip */
+            {
+                num++;                                                         /* candidate */
+            }
+        }
+        a_w25qxx_mirror_unlock(mirror);                                        /* unlock */
+        
+        /* the first candidate whose wip bit is clear */
+        for (i = 0; i < num; i++)                                              /* loop all candidates */
+        {
+            if (w25qxx_get_busy(mirror->handle[cand[i]], &busy, NULL) != 0)    /* get busy */
+            {
+                return 1;                                                      /* return error */
+            }
+            if (busy == W25QXX_BOOL_FALSE)                                     /* idle */
+            {
+                break;                                                         /* found */
+            }
+        }
+        if (i < num)                                                           /* found */
+        {
+            a_w25qxx_mirror_lock(mirror);                                      /* lock */
+            if (mirror->active != cand[i])                                     /* check again */
+            {
+                mirror->reading[cand[i]]++;                                    /* one more reader */
+                mirror->next = (uint8_t)((cand[i] + 1) % 2);                   /* next chip */
+                if (i != 0)                                                    /* moved */
+                {
+                    mirror->stats.busy_skip++;                                 /* busy skip++ */
+                }
+                mirror->stats.read[cand[i]]++;                                 /* read++ */
+                a_w25qxx_mirror_unlock(mirror);                                /* unlock */
+                *chip = cand[i];                                               /* set chip */
+                
+                return 0;                                                      /* success return 0 */
+            }
+            a_w25qxx_mirror_unlock(mirror);                                    /* unlock */
+        }
+        if (timeout == 0)                                                      /* check timeout */
+        {
+            mirror->handle[0]->debug_print("w25qxx: mirror read timeout.\n");  /* mirror read timeout */
+            
+            return 1;                                                          /* return error */
+        }
+        timeout--;                                                             /* timeout-- */
+        mirror->handle[cand[0]]->delay_us(10);                                 /* delay 10 us */
+    }
+}
+
+/**
+ * @brief     release a picked chip
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] chip chip index
+ * @note      none
+ */
+static void a_w25qxx_mirror_release(w25qxx_mirror_t *mirror, uint8_t chip)
+{
+    a_w25qxx_mirror_lock(mirror);   /* lock */
+    mirror->reading[chip]--;        /* one less reader */
+    a_w25qxx_mirror_unlock(mirror); /* unlock */
+}
+
+/**
+ * @brief         start modifying the copy of one chip
+ * @param[in]     *mirror pointer to a w25qxx mirror structure
+ * @param[in]     chip chip index
+ * @param[in,out] *generation pointer to the generation seen by the caller, NULL to always start
+ * @return        status code
+ *                - 0 success
+ *                - 1 the volume was modified after the caller saw it
+ * @note          a running modification is waited for, new reads go to the other chip
+ *                and running reads of the chip are waited for
+ */
+static uint8_t a_w25qxx_mirror_enter(w25qxx_mirror_t *mirror, uint8_t chip, uint32_t *generation)
+{
+    uint8_t reading;
+    
+    while (1)                                                            /* wait the modifier */
+    {
+        a_w25qxx_mirror_lock(mirror);                                    /* lock */
+        if ((generation != NULL) && (*generation != mirror->generation)) /* check generation */
+        {
+            a_w25qxx_mirror_unlock(mirror);                              /* unlock */
+            
+            return 1;                                                    /* return modified */
+        }
+        if (mirror->active == 0xFF)                                      /* no modifier */
+        {
+            mirror->active = chip;                                       /* set chip */
+            mirror->generation++;                                        /* generation++ */
+            if (generation != NULL)                                      /* check generation */
+            {
+                *generation = mirror->generation;                        /* own modification */
+            }
+            a_w25qxx_mirror_unlock(mirror);                              /* unlock */
+            
+            break;                                                       /* break */
+        }
+        a_w25qxx_mirror_unlock(mirror);                                  /* unlock */
+        mirror->handle[chip]->delay_us(10);                              /* delay 10 us */
+    }
+    while (1)                                                            /* wait the readers */
+    {
+        a_w25qxx_mirror_lock(mirror);                                    /* lock */
+        reading = mirror->reading[chip];                                 /* get readers */
+        a_w25qxx_mirror_unlock(mirror);                                  /* unlock */
+        if (reading == 0)                                                /* no reader */
+        {
+            break;                                                       /* break */
+        }
+        mirror->handle[chip]->delay_us(10);                              /* delay 10 us */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     stop modifying
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @note      none
+ */
+static void a_w25qxx_mirror_leave(w25qxx_mirror_t *mirror)
+{
+    a_w25qxx_mirror_lock(mirror);   /* lock */
+    mirror->active = 0xFF;          /* none */
+    a_w25qxx_mirror_unlock(mirror); /* unlock */
+}
+
+/**
+ * @brief     initialize the mirrored volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] *handle0 pointer to the initialized w25qxx handle of chip 0
+ * @param[in] *handle1 pointer to the initialized w25qxx handle of chip 1
+ * @param[in] size used bytes of every chip
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 size is invalid
+ * @note      size is a multiple of 4096
+ */
+uint8_t w25qxx_mirror_init(w25qxx_mirror_t *mirror, w25qxx_handle_t *handle0, w25qxx_handle_t *handle1, uint32_t size)
+{
+    if ((mirror == NULL) || (handle0 == NULL) || (handle1 == NULL)) /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if ((handle0->inited != 1) || (handle1->inited != 1))           /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    if ((size == 0) || ((size % 4096) != 0))                        /* check size */
+    {
+        handle0->debug_print("w25qxx: size is invalid.\n");         /* size is invalid */
+        
+        return 4;                                                   /* return error */
+    }
+    
+    memset(mirror, 0, sizeof(w25qxx_mirror_t));                     /* clear mirror */
+    mirror->handle[0] = handle0;                                    /* set handle 0 */
+    mirror->handle[1] = handle1;                                    /* set handle 1 */
+    mirror->size = size;                                            /* set size */
+    mirror->active = 0xFF;                                          /* nothing modified */
+    mirror->verify = W25QXX_BOOL_FALSE;                             /* no verify */
+    mirror->inited = 1;                                             /* set inited */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     deinit the mirrored volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_mirror_deinit(w25qxx_mirror_t *mirror)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_mirror_check(mirror, 0, 0); /* check handle */
+    if (res != 0)                              /* check result */
+    {
+        return res;                            /* return error */
+    }
+    
+    mirror->inited = 0;                        /* clear inited */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the state lock hooks
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      needed when reads run in another thread than writes, the hooks guard
+ *            the mirror state only and are never held during a flash operation
+ */
+uint8_t w25qxx_mirror_set_hooks(w25qxx_mirror_t *mirror, void (*lock)(void), void (*unlock)(void))
+{
+    uint8_t res;
+    
+    res = a_w25qxx_mirror_check(mirror, 0, 0); /* check handle */
+    if (res != 0)                              /* check result */
+    {
+        return res;                            /* return error */
+    }
+    
+    mirror->lock = lock;                       /* set lock */
+    mirror->unlock = unlock;                   /* set unlock */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the read verify
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a verified read compares both copies and rewrites chip 1 from chip 0
+ *            where they differ, it costs a second read, chip 0 is always the
+ *            reference: after a power loss it holds the newer data, but two copies
+ *            can't tell which one went bad, so a corrupted chip 0 is copied over a
+ *            good chip 1, data needing that has to carry its own crc, as the kv and
+ *            blob records do, a repair is skipped when a write started after chip 0
+ *            was read, that write leaves both copies equal
+ */
+uint8_t w25qxx_mirror_set_verify(w25qxx_mirror_t *mirror, w25qxx_bool_t enable)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_mirror_check(mirror, 0, 0); /* check handle */
+    if (res != 0)                              /* check result */
+    {
+        return res;                            /* return error */
+    }
+    
+    mirror->verify = enable;                   /* set verify */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief      read the volume
+ * @param[in]  *mirror pointer to a w25qxx mirror structure
+ * @param[in]  addr volume address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 range is invalid
+ * @note       the read goes to a chip whose wip bit is clear and never to the chip
+ *             being modified, idle chips take turns, a read failed on one chip is
+ *             retried on the other one
+ */
+uint8_t w25qxx_mirror_read(w25qxx_mirror_t *mirror, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint8_t chip;
+    uint8_t verify;
+    uint32_t off;
+    uint32_t n;
+    uint32_t generation;
+    uint8_t buf[W25QXX_MIRROR_CHUNK];
+    
+    res = a_w25qxx_mirror_check(mirror, addr, len);                                      /* check handle */
+    if (res != 0)                                                                        /* check result */
+    {
+        return res;                                                                      /* return error */
+    }
+    if (len == 0)                                                                        /* check length */
+    {
+        return 0;                                                                        /* success return 0 */
+    }
+    
+    /* a verified read needs both copies complete */
+    a_w25qxx_mirror_lock(mirror);                                                        /* lock */
+    verify = ((mirror->verify == W25QXX_BOOL_TRUE) && (mirror->active == 0xFF)) ? 1 : 0; /* check verify */
+    generation = mirror->generation;                                                     /* save generation */
+    a_w25qxx_mirror_unlock(mirror);                                                      /* unlock */
+    if (a_w25qxx_mirror_pick(mirror, verify, 0xFF, &chip) != 0)                          /* pick a chip */
+    {
+        return 1;                                                                        /* return error */
+    }
+    res = w25qxx_read(mirror->handle[chip], addr, data, len);                            /* read */
+    a_w25qxx_mirror_release(mirror, chip);                                               /* release */
+    if (res != 0)                                                                        /* check result */
+    {
+        /* fail over to the other copy */
+        mirror->handle[chip]->debug_print("w25qxx: chip %d read failed.\n", chip);       /* mirror read failed */
+        if (a_w25qxx_mirror_pick(mirror, 0, chip, &chip) != 0)                           /* pick the other chip */
+        {
+            return 1;                                                                    /* return error */
+        }
+        res = w25qxx_read(mirror->handle[chip], addr, data, len);                        /* read */
+        a_w25qxx_mirror_release(mirror, chip);                                           /* release */
+        if (res != 0)                                                                    /* check result */
+        {
+            return 1;                                                                    /* return error */
+        }
+        a_w25qxx_mirror_lock(mirror);                                                    /* lock */
+        mirror->stats.failover++;                                                        /* failover++ */
+        a_w25qxx_mirror_unlock(mirror);                                                  /* unlock */
+        
+        return 0;                                                                        /* success return 0 */
+    }
+    if ((verify == 0) || (chip != 0))                                                    /* no verify */
+    {
+        return 0;                                                                        /* success return 0 */
+    }
+    
+    /* compare with chip 1 and reconcile from chip 0 */
+    for (off = 0; off < len; off += n)                                                   /* loop all chunks */
+    {
+        n = len - off;                                                                   /* remain */
+        if (n > W25QXX_MIRROR_CHUNK)                                                     /* check length */
+        {
+            n = W25QXX_MIRROR_CHUNK;                                                     /* set length */
+        }
+        if (w25qxx_read(mirror->handle[1], addr + off, buf, n) != 0)                     /* read chip 1 */
+        {
+            return 1;                                                                    /* return error */
+        }
+        if (memcmp(buf, &data[off], n) != 0)                                             /* compare */
+        {
+            a_w25qxx_mirror_lock(mirror);                                                /* lock */
+            mirror->stats.mismatch++;                                                    /* mismatch++ */
+            a_w25qxx_mirror_unlock(mirror);                                              /* unlock */
+            mirror->handle[1]->debug_print("w25qxx: mirror mismatch at 0x%08X.\n",
+                                           (unsigned int)(addr + off));                  /* mirror mismatch */
+            
+            /* a write started after chip 0 was read makes the copy stale, it leaves both chips equal anyway */
+            if (a_w25qxx_mirror_enter(mirror, 1, &generation) != 0)                      /* modify chip 1 */
+            {
+                return 0;                                                                /* success return 0 */
+            }
+            res = w25qxx_write(mirror->handle[1], addr + off, &data[off], n);            /* repair */
+            a_w25qxx_mirror_leave(mirror);                                               /* done */
+            if (res != 0)                                                                /* check result */
+            {
+                return 1;                                                                /* return error */
+            }
+            a_w25qxx_mirror_lock(mirror);                                                /* lock */
+            mirror->stats.repair++;                                                      /* repair++ */
+            a_w25qxx_mirror_unlock(mirror);                                              /* unlock */
+        }
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     write the volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] addr volume address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      chip 0 is written first and chip 1 after it, so one copy of the range
+ *            is always complete and readable, after a power loss chip 0 holds the
+ *            newer data
+ */
+uint8_t w25qxx_mirror_write(w25qxx_mirror_t *mirror, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    res = a_w25qxx_mirror_check(mirror, addr, len);             /* check handle */
+    if (res != 0)                                               /* check result */
+    {
+        return res;                                             /* return error */
+    }
+    if (len == 0)                                               /* check length */
+    {
+        return 0;                                               /* success return 0 */
+    }
+    
+    for (i = 0; i < 2; i++)                                     /* loop both chips */
+    {
+        (void)a_w25qxx_mirror_enter(mirror, i, NULL);           /* modify the chip */
+        res = w25qxx_write(mirror->handle[i], addr, data, len); /* write */
+        a_w25qxx_mirror_leave(mirror);                          /* done */
+        if (res != 0)                                           /* check result */
+        {
+            return 1;                                           /* return error */
+        }
+    }
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     erase the volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] addr volume address
+ * @param[in] len erase length
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr or len is not 4k aligned
+ *            - 5 range is invalid
+ * @note      chip 0 is erased first and chip 1 after it, reads go to the other chip
+ *            meanwhile
+ */
+uint8_t w25qxx_mirror_erase(w25qxx_mirror_t *mirror, uint32_t addr, uint32_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    uint32_t a;
+    
+    res = a_w25qxx_mirror_check(mirror, addr, len);                                 /* check handle */
+    if (res != 0)                                                                   /* check result */
+    {
+        return res;                                                                 /* return error */
+    }
+    if (((addr % 4096) != 0) || ((len % 4096) != 0))                                /* check alignment */
+    {
+        mirror->handle[0]->debug_print("w25qxx: addr or len is not 4k aligned.\n"); /* addr or len is not 4k aligned */
+        
+        return 4;                                                                   /* return error */
+    }
+    if (len == 0)                                                                   /* check length */
+    {
+        return 0;                                                                   /* success return 0 */
+    }
+    
+    for (i = 0; i < 2; i++)                                                         /* loop both chips */
+    {
+        (void)a_w25qxx_mirror_enter(mirror, i, NULL);                               /* modify the chip */
+        a = addr;                                                                   /* init address */
+        while (a < (addr + len))                                                    /* loop all sectors */
+        {
+            if (((a % 65536) == 0) && ((addr + len - a) >= 65536))                  /* whole block */
+            {
+                res = w25qxx_block_erase_64k(mirror->handle[i], a);                 /* erase the block */
+                a += 65536;                                                         /* next block */
+            }
+            else
+            {
+                res = w25qxx_sector_erase_4k(mirror->handle[i], a);                 /* erase the sector */
+                a += 4096;                                                          /* next sector */
+            }
+            if (res != 0)                                                           /* check result */
+            {
+                break;                                                              /* break */
+            }
+        }
+        a_w25qxx_mirror_leave(mirror);                                              /* done */
+        if (res != 0)                                                               /* check result */
+        {
+            return 1;                                                               /* return error */
+        }
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *mirror pointer to a w25qxx mirror structure
+ * @param[out] *stats pointer to a w25qxx mirror stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_mirror_get_stats(w25qxx_mirror_t *mirror, w25qxx_mirror_stats_t *stats)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_mirror_check(mirror, 0, 0); /* check handle */
+    if (res != 0)                              /* check result */
+    {
+        return res;                            /* return error */
+    }
+    
+    a_w25qxx_mirror_lock(mirror);              /* lock */
+    *stats = mirror->stats;                    /* copy stats */
+    a_w25qxx_mirror_unlock(mirror);            /* unlock */
+    
+    return 0;                                  /* success return 0 */
+}
@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_mirror.h
+ * @brief     driver w25qxx mirror header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_MIRROR_H
+#define DRIVER_W25QXX_MIRROR_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_mirror_driver w25qxx mirror driver function
+ * @brief    w25qxx two chip mirrored volume modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx mirror verify chunk definition
+ */
+#ifndef W25QXX_MIRROR_CHUNK
+    #define W25QXX_MIRROR_CHUNK        256        /**< 256 bytes */
+#endif
+
+/**
+ * @brief w25qxx mirror stats structure definition
+ */
+typedef struct w25qxx_mirror_stats_s
+{
+    uint32_t read[2];          /**< reads served by every chip */
+    uint32_t busy_skip;        /**< reads moved away from a busy chip */
+    uint32_t mismatch;         /**< chunks found different on verify */
+    uint32_t repair;           /**< chunks copied from chip 0 to chip 1 */
+    uint32_t failover;         /**< reads served by the other chip after a failure */
+} w25qxx_mirror_stats_t;
+
+/**
+ * @brief w25qxx mirror structure definition
+ */
+typedef struct w25qxx_mirror_s
+{
+    w25qxx_handle_t *handle[2];                /**< chip handles */
+    uint32_t size;                             /**< used bytes of every chip */
+    uint8_t next;                              /**< next chip for an idle read */
+    uint8_t active;                            /**< chip being modified, 0xFF if none */
+    uint32_t generation;                       /**< modifications started */
+    uint8_t reading[2];                        /**< running reads of every chip */
+    w25qxx_bool_t verify;                      /**< verify flag */
+    void (*lock)(void);                        /**< state lock hook */
+    void (*unlock)(void);                      /**< state unlock hook */
+    w25qxx_mirror_stats_t stats;               /**< statistics */
+    uint8_t inited;                            /**< inited flag */
+} w25qxx_mirror_t;
+
+/**
+ * @brief     initialize the mirrored volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] *handle0 pointer to the initialized w25qxx handle of chip 0
+ * @param[in] *handle1 pointer to the initialized w25qxx handle of chip 1
+ * @param[in] size used bytes of every chip
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 size is invalid
+ * @note      size is a multiple of 4096
+ */
+uint8_t w25qxx_mirror_init(w25qxx_mirror_t *mirror, w25qxx_handle_t *handle0, w25qxx_handle_t *handle1, uint32_t size);
+
+/**
+ * @brief     deinit the mirrored volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_mirror_deinit(w25qxx_mirror_t *mirror);
+
+/**
+ * @brief     set the state lock hooks
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      needed when reads run in another thread than writes, the hooks guard
+ *            the mirror state only and are never held during a flash operation
+ */
+uint8_t w25qxx_mirror_set_hooks(w25qxx_mirror_t *mirror, void (*lock)(void), void (*unlock)(void));
+
+/**
+ * @brief     enable or disable the read verify
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a verified read compares both copies and rewrites chip 1 from chip 0
+ *            where they differ, it costs a second read, chip 0 is always the
+ *            reference: after a power loss it holds the newer data, but two copies
+ *            can't tell which one went bad, so a corrupted chip 0 is copied over a
+ *            good chip 1, data needing that has to carry its own crc, as the kv and
+ *            blob records do, a repair is skipped when a write started after chip 0
+ *            was read, that write leaves both copies equal
+ */
+uint8_t w25qxx_mirror_set_verify(w25qxx_mirror_t *mirror, w25qxx_bool_t enable);
+
+/**
+ * @brief      read the volume
+ * @param[in]  *mirror pointer to a w25qxx mirror structure
+ * @param[in]  addr volume address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 range is invalid
+ * @note       the read goes to a chip whose wip bit is clear and never to the chip
+ *             being modified, idle chips take turns, a read failed on one chip is
+ *             retried on the other one
+ */
+uint8_t w25qxx_mirror_read(w25qxx_mirror_t *mirror, uint32_t addr, uint8_t *data, uint32_t len);
+
+/**
+ * @brief     write the volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] addr volume address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      chip 0 is written first and chip 1 after it, so one copy of the range
+ *            is always complete and readable, after a power loss chip 0 holds the
+ *            newer data
+ */
+uint8_t w25qxx_mirror_write(w25qxx_mirror_t *mirror, uint32_t addr, uint8_t *data, uint32_t len);
+
+/**
+ * @brief     erase the volume
+ * @param[in] *mirror pointer to a w25qxx mirror structure
+ * @param[in] addr volume address
+ * @param[in] len erase length
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr or len is not 4k aligned
+ *            - 5 range is invalid
+ * @note      chip 0 is erased first and chip 1 after it, reads go to the other chip
+ *            meanwhile
+ */
+uint8_t w25qxx_mirror_erase(w25qxx_mirror_t *mirror, uint32_t addr, uint32_t len);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *mirror pointer to a w25qxx mirror structure
+ * @param[out] *stats pointer to a w25qxx mirror stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_mirror_get_stats(w25qxx_mirror_t *mirror, w25qxx_mirror_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
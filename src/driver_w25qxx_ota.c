@@ -0,0 +1,1116 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ota.c
+ * @brief     driver w25qxx ota source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_ota.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief ota selector definition
+ */
+#define W25QXX_OTA_MAGIC          0x3041544FU        /**< "OTA0" */
+#define W25QXX_OTA_RECORD_SIZE    32U                /**< selector record size */
+#define W25QXX_OTA_SECTOR_SIZE    4096U              /**< selector sector size */
+#define W25QXX_OTA_BLOCK_SIZE     65536U             /**< slot erase block size */
+
+/**
+ * @brief ota install definition
+ */
+#define W25QXX_OTA_INSTALL_STREAM      1                 /**< full image stream */
+#define W25QXX_OTA_INSTALL_PATCH       2                 /**< delta patch */
+
+/**
+ * @brief ota patch definition
+ */
+#define W25QXX_OTA_PATCH_MAGIC         0x30504457U       /**< "WDP0" */
+#define W25QXX_OTA_PATCH_OP_COPY       0x01              /**< copy from the old image */
+#define W25QXX_OTA_PATCH_OP_INSERT     0x02              /**< insert new data */
+#define W25QXX_OTA_PATCH_STATE_HEADER  0                 /**< header */
+#define W25QXX_OTA_PATCH_STATE_OP      1                 /**< op code */
+#define W25QXX_OTA_PATCH_STATE_ARG     2                 /**< op arguments */
+#define W25QXX_OTA_PATCH_STATE_DATA    3                 /**< insert data */
+
+/**
+ * @brief      hash a slot
+ * @param[in]  *ota pointer to a w25qxx ota structure
+ * @param[in]  slot slot index
+ * @param[in]  size image size
+ * @param[out] *crc pointer to a crc32 buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_w25qxx_ota_hash_slot(w25qxx_ota_t *ota, uint8_t slot, uint32_t size, uint32_t *crc)
+{
+    uint32_t i;
+    uint32_t len;
+    
+    *crc = 0xFFFFFFFFU;                                                             /* init crc */
+    for (i = 0; i < size; i += len)                                                 /* loop the image */
+    {
+        len = size - i;                                                             /* get remain */
+        if (len > sizeof(ota->buf))                                                 /* check length */
+        {
+            len = sizeof(ota->buf);                                                 /* set length */
+        }
+        if (w25qxx_read(ota->handle, ota->slot_addr[slot] + i, ota->buf, len) != 0) /* read data */
+        {
+            ota->handle->debug_print("w25qxx: read failed.\n");                     /* read failed */
+            
+            return 1;                                                               /* return error */
+        }
+        *crc = w25qxx_util_crc32(*crc, ota->buf, len);                              /* update crc */
+    }
+    *crc = ~(*crc);                                                                 /* final xor */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     append a selector record
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] slot active slot
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ * @note      records fill one sector, then the other sector is erased and used,
+ *            so the previous record survives until the new one is complete
+ */
+static uint8_t a_w25qxx_ota_append_record(w25qxx_ota_t *ota, uint8_t slot)
+{
+    uint8_t record[W25QXX_OTA_RECORD_SIZE];
+    uint32_t seq;
+    
+    if ((ota->record_addr % W25QXX_OTA_SECTOR_SIZE) == 0)                                        /* first record of a sector */
+    {
+        if (w25qxx_sector_erase_4k(ota->handle, ota->record_addr) != 0)                          /* sector erase */
+        {
+            ota->handle->debug_print("w25qxx: sector erase 4k failed.\n");                       /* sector erase 4k failed */
+            
+            return 1;                                                                            /* return error */
+        }
+    }
+    seq = ota->seq + 1;                                                                          /* next sequence */
+    w25qxx_util_put32(&record[0], W25QXX_OTA_MAGIC);                                             /* set magic */
+    w25qxx_util_put32(&record[4], seq);                                                          /* set sequence */
+    w25qxx_util_put32(&record[8], ~seq);                                                         /* set inverted sequence */
+    w25qxx_util_put32(&record[12], slot);                                                        /* set slot */
+    w25qxx_util_put32(&record[16], ota->image[slot].size);                                       /* set size */
+    w25qxx_util_put32(&record[20], ota->image[slot].crc);                                        /* set crc */
+    w25qxx_util_put32(&record[24], 0xFFFFFFFFU);                                                 /* reserved */
+    w25qxx_util_put32(&record[28], w25qxx_util_crc32(0xFFFFFFFFU, record, 28));                  /* set record crc */
+    if (w25qxx_page_program(ota->handle, ota->record_addr, record, W25QXX_OTA_RECORD_SIZE) != 0) /* page program */
+    {
+        ota->handle->debug_print("w25qxx: page program failed.\n");                              /* page program failed */
+        
+        return 1;                                                                                /* return error */
+    }
+    ota->seq = seq;                                                                              /* set sequence */
+    ota->active = slot;                                                                          /* set active */
+    ota->record_addr += W25QXX_OTA_RECORD_SIZE;                                                  /* next record */
+    if (ota->record_addr == ota->selector_addr + 2 * W25QXX_OTA_SECTOR_SIZE)                     /* last sector is full */
+    {
+        ota->record_addr = ota->selector_addr;                                                   /* back to the first sector */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     program the page buffer
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] page_off page offset inside the slot
+ * @param[in] len valid bytes in the page buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      the 64k block of the page is erased first when the writer enters it
+ */
+static uint8_t a_w25qxx_ota_program_page(w25qxx_ota_t *ota, uint32_t page_off, uint32_t len)
+{
+    uint32_t base;
+    uint32_t i;
+    
+    base = ota->slot_addr[ota->target];                                                  /* slot address */
+    if (page_off >= ota->erased)                                                         /* block not erased yet */
+    {
+        if (w25qxx_block_erase_64k(ota->handle, base + ota->erased) != 0)                /* block erase 64k */
+        {
+            ota->handle->debug_print("w25qxx: block erase 64k failed.\n");               /* block erase 64k failed */
+            
+            return 1;                                                                    /* return error */
+        }
+        ota->erased += W25QXX_OTA_BLOCK_SIZE;                                            /* erased + block */
+    }
+    for (i = 0; i < len; i++)                                                            /* check blank */
+    {
+        if (ota->buf[i] != 0xFF)                                                         /* not blank */
+        {
+            break;                                                                       /* break */
+        }
+    }
+    if (i == len)                                                                        /* blank page */
+    {
+        return 0;                                                                        /* success return 0 */
+    }
+    if (w25qxx_page_program(ota->handle, base + page_off, ota->buf, (uint16_t)len) != 0) /* page program */
+    {
+        ota->handle->debug_print("w25qxx: page program failed.\n");                      /* page program failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     check the handle
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      none
+ */
+static uint8_t a_w25qxx_ota_check(w25qxx_ota_t *ota)
+{
+    if (ota == NULL)       /* check handle */
+    {
+        return 2;          /* return error */
+    }
+    if (ota->inited != 1)  /* check handle initialization */
+    {
+        return 3;          /* return error */
+    }
+    if (ota->mounted != 1) /* check mounted */
+    {
+        return 4;          /* return error */
+    }
+    
+    return 0;              /* success return 0 */
+}
+
+/**
+ * @brief     initialize the slot manager
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] slot_a slot a address
+ * @param[in] slot_b slot b address
+ * @param[in] slot_size slot size
+ * @param[in] selector_addr selector region address, two 4k sectors
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 slot size is invalid
+ * @note      slots are 64k aligned, slot_size is a multiple of 64k, no region may overlap
+ */
+uint8_t w25qxx_ota_init(w25qxx_ota_t *ota, w25qxx_handle_t *handle, uint32_t slot_a, uint32_t slot_b,
+                        uint32_t slot_size, uint32_t selector_addr)
+{
+    if ((ota == NULL) || (handle == NULL))                                                               /* check handle */
+    {
+        return 2;                                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                                             /* check handle initialization */
+    {
+        return 3;                                                                                        /* return error */
+    }
+    if ((slot_size == 0) || ((slot_size % W25QXX_OTA_BLOCK_SIZE) != 0))                                  /* check slot size */
+    {
+        handle->debug_print("w25qxx: slot size is invalid.\n");                                          /* slot size is invalid */
+        
+        return 5;                                                                                        /* return error */
+    }
+    if (((slot_a % W25QXX_OTA_BLOCK_SIZE) != 0) || ((slot_b % W25QXX_OTA_BLOCK_SIZE) != 0) ||
+        ((selector_addr % W25QXX_OTA_SECTOR_SIZE) != 0) ||
+        ((slot_a < slot_b + slot_size) && (slot_b < slot_a + slot_size)) ||
+        ((selector_addr < slot_a + slot_size) && (slot_a < selector_addr + 2 * W25QXX_OTA_SECTOR_SIZE)) ||
+        ((selector_addr < slot_b + slot_size) && (slot_b < selector_addr + 2 * W25QXX_OTA_SECTOR_SIZE))) /* check addr */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");                                               /* addr is invalid */
+        
+        return 4;                                                                                        /* return error */
+    }
+    
+    memset(ota, 0, sizeof(w25qxx_ota_t));                                                                /* clear ota */
+    ota->handle = handle;                                                                                /* set handle */
+    ota->slot_addr[0] = slot_a;                                                                          /* set slot a */
+    ota->slot_addr[1] = slot_b;                                                                          /* set slot b */
+    ota->slot_size = slot_size;                                                                          /* set slot size */
+    ota->selector_addr = selector_addr;                                                                  /* set selector */
+    ota->active = W25QXX_OTA_SLOT_NONE;                                                                  /* no active slot */
+    ota->inited = 1;                                                                                     /* set inited */
+    
+    return 0;                                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     deinit the slot manager
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      an unfinished install is dropped
+ */
+uint8_t w25qxx_ota_deinit(w25qxx_ota_t *ota)
+{
+    if (ota == NULL)      /* check handle */
+    {
+        return 2;         /* return error */
+    }
+    if (ota->inited != 1) /* check handle initialization */
+    {
+        return 3;         /* return error */
+    }
+    
+    ota->installing = 0;  /* drop the install */
+    ota->mounted = 0;     /* clear mounted */
+    ota->inited = 0;      /* clear inited */
+    
+    return 0;             /* success return 0 */
+}
+
+/**
+ * @brief     load the newest selector record
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      no active slot is reported when the selector region holds no valid record
+ */
+uint8_t w25qxx_ota_mount(w25qxx_ota_t *ota)
+{
+    uint8_t found;
+    uint8_t slot;
+    uint8_t *p;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t seq;
+    uint32_t newest_addr;
+    uint32_t used_end[2];
+    uint32_t slot_seq[2];
+    
+    if (ota == NULL)                                                                                           /* check handle */
+    {
+        return 2;                                                                                              /* return error */
+    }
+    if (ota->inited != 1)                                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                              /* return error */
+    }
+    
+    ota->mounted = 0;                                                                                          /* clear mounted */
+    ota->installing = 0;                                                                                       /* drop the install */
+    ota->active = W25QXX_OTA_SLOT_NONE;                                                                        /* no active slot */
+    ota->image[0].valid = 0;                                                                                   /* no image */
+    ota->image[1].valid = 0;                                                                                   /* no image */
+    ota->seq = 0;                                                                                              /* init 0 */
+    found = 0;                                                                                                 /* init 0 */
+    newest_addr = 0;                                                                                           /* init 0 */
+    slot_seq[0] = 0;                                                                                           /* init 0 */
+    slot_seq[1] = 0;                                                                                           /* init 0 */
+    for (i = 0; i < 2; i++)                                                                                    /* loop both sectors */
+    {
+        used_end[i] = 0;                                                                                       /* empty sector */
+        for (j = 0; j < W25QXX_OTA_SECTOR_SIZE; j += sizeof(ota->buf))                                         /* loop all chunks */
+        {
+            if (w25qxx_read(ota->handle, ota->selector_addr + i * W25QXX_OTA_SECTOR_SIZE + j,
+                            ota->buf, sizeof(ota->buf)) != 0)                                                  /* read chunk */
+            {
+                ota->handle->debug_print("w25qxx: read failed.\n");                                            /* read failed */
+                
+                return 1;                                                                                      /* return error */
+            }
+            for (k = 0; k < sizeof(ota->buf); k += W25QXX_OTA_RECORD_SIZE)                                     /* loop all records */
+            {
+                p = &ota->buf[k];                                                                              /* record pointer */
+                if ((w25qxx_util_get32(&p[0]) != 0xFFFFFFFFU) || (w25qxx_util_get32(&p[28]) != 0xFFFFFFFFU))   /* not blank */
+                {
+                    used_end[i] = j + k + W25QXX_OTA_RECORD_SIZE;                                              /* used so far */
+                }
+                seq = w25qxx_util_get32(&p[4]);                                                                /* get sequence */
+                slot = p[12];                                                                                  /* get slot */
+                if ((w25qxx_util_get32(&p[0]) != W25QXX_OTA_MAGIC) ||
+                    (w25qxx_util_get32(&p[8]) != (uint32_t)~seq) || (slot > 1) ||
+                    (w25qxx_util_get32(&p[28]) != w25qxx_util_crc32(0xFFFFFFFFU, p, 28)))                      /* check record */
+                {
+                    continue;                                                                                  /* skip */
+                }
+                if ((found == 0) || ((int32_t)(seq - ota->seq) > 0))                                           /* newer record */
+                {
+                    found = 1;                                                                                 /* set found */
+                    ota->seq = seq;                                                                            /* set sequence */
+                    ota->active = slot;                                                                        /* set active */
+                    newest_addr = i * W25QXX_OTA_SECTOR_SIZE + j + k;                                          /* save position */
+                }
+                if ((ota->image[slot].valid == 0) || ((int32_t)(seq - slot_seq[slot]) > 0))                    /* newer image */
+                {
+                    slot_seq[slot] = seq;                                                                      /* set sequence */
+                    ota->image[slot].size = w25qxx_util_get32(&p[16]);                                         /* set size */
+                    ota->image[slot].crc = w25qxx_util_get32(&p[20]);                                          /* set crc */
+                    ota->image[slot].valid = 1;                                                                /* set valid */
+                }
+            }
+        }
+    }
+    if (found == 0)                                                                                            /* empty selector */
+    {
+        ota->record_addr = ota->selector_addr;                                                                 /* erase and use sector 0 */
+    }
+    else
+    {
+        i = newest_addr / W25QXX_OTA_SECTOR_SIZE;                                                              /* newest sector */
+        if (used_end[i] >= W25QXX_OTA_SECTOR_SIZE)                                                             /* sector is full */
+        {
+            ota->record_addr = ota->selector_addr + (1 - i) * W25QXX_OTA_SECTOR_SIZE;                          /* erase and use the other */
+        }
+        else
+        {
+            ota->record_addr = ota->selector_addr + i * W25QXX_OTA_SECTOR_SIZE + used_end[i];                  /* after the last used record */
+        }
+    }
+    ota->mounted = 1;                                                                                          /* set mounted */
+    
+    return 0;                                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the active slot
+ * @param[in]  *ota pointer to a w25qxx ota structure
+ * @param[out] *slot pointer to a slot buffer
+ * @param[out] *addr pointer to a slot address buffer
+ * @param[out] *image pointer to a w25qxx ota image structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 no active slot
+ * @note       none
+ */
+uint8_t w25qxx_ota_get_active(w25qxx_ota_t *ota, w25qxx_ota_slot_t *slot, uint32_t *addr, w25qxx_ota_image_t *image)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ota_check(ota);                                       /* check handle */
+    if (res != 0)                                                        /* check result */
+    {
+        return res;                                                      /* return error */
+    }
+    if (ota->active == W25QXX_OTA_SLOT_NONE)                             /* check active */
+    {
+        *slot = W25QXX_OTA_SLOT_NONE;                                    /* no slot */
+        
+        return 5;                                                        /* return error */
+    }
+    
+    *slot = (w25qxx_ota_slot_t)(ota->active);                            /* set slot */
+    *addr = ota->slot_addr[ota->active];                                 /* set address */
+    memcpy(image, &ota->image[ota->active], sizeof(w25qxx_ota_image_t)); /* set image */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     start installing an image into the inactive slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] size image size
+ * @return    status code
+ *            - 0 success
+ *            - 1 begin failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 size is invalid
+ * @note      the first 64k block is erased here, the active slot is never touched
+ */
+uint8_t w25qxx_ota_begin(w25qxx_ota_t *ota, uint32_t size)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ota_check(ota);                                                            /* check handle */
+    if (res != 0)                                                                             /* check result */
+    {
+        return res;                                                                           /* return error */
+    }
+    if ((size == 0) || (size > ota->slot_size))                                               /* check size */
+    {
+        ota->handle->debug_print("w25qxx: size is invalid.\n");                               /* size is invalid */
+        
+        return 5;                                                                             /* return error */
+    }
+    
+    ota->target = (ota->active == W25QXX_OTA_SLOT_A) ? W25QXX_OTA_SLOT_B : W25QXX_OTA_SLOT_A; /* inactive slot */
+    ota->image[ota->target].valid = 0;                                                        /* slot is being replaced */
+    ota->size = size;                                                                         /* set size */
+    ota->offset = 0;                                                                          /* init 0 */
+    ota->erased = 0;                                                                          /* nothing erased */
+    ota->crc = 0xFFFFFFFFU;                                                                   /* init crc */
+    ota->installing = 0;                                                                      /* not ready yet */
+    if (w25qxx_block_erase_64k(ota->handle, ota->slot_addr[ota->target]) != 0)                /* erase the first block */
+    {
+        ota->handle->debug_print("w25qxx: block erase 64k failed.\n");                        /* block erase 64k failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    ota->erased = W25QXX_OTA_BLOCK_SIZE;                                                      /* first block erased */
+    ota->installing = W25QXX_OTA_INSTALL_STREAM;                                              /* set installing */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     stream image data into the inactive slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no install in progress
+ *            - 6 image is larger than announced
+ * @note      data is hashed and programmed one page at a time, 64k blocks are erased as the
+ *            writer reaches them and blank pages are not programmed
+ */
+uint8_t w25qxx_ota_write(w25qxx_ota_t *ota, const uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint32_t chunk;
+    
+    res = a_w25qxx_ota_check(ota);                                             /* check handle */
+    if (res != 0)                                                              /* check result */
+    {
+        return res;                                                            /* return error */
+    }
+    if (ota->installing != W25QXX_OTA_INSTALL_STREAM)                          /* check installing */
+    {
+        ota->handle->debug_print("w25qxx: no install in progress.\n");         /* no install in progress */
+        
+        return 5;                                                              /* return error */
+    }
+    if (len > ota->size - ota->offset)                                         /* check size */
+    {
+        ota->handle->debug_print("w25qxx: image is larger than announced.\n"); /* image is larger than announced */
+        
+        return 6;                                                              /* return error */
+    }
+    
+    ota->crc = w25qxx_util_crc32(ota->crc, data, len);                         /* hash while writing */
+    while (len != 0)                                                           /* loop all data */
+    {
+        chunk = 256 - (ota->offset % 256);                                     /* get page remain */
+        if (chunk > len)                                                       /* check length */
+        {
+            chunk = len;                                                       /* set length */
+        }
+        memcpy(&ota->buf[ota->offset % 256], data, chunk);                     /* fill the page */
+        ota->offset += chunk;                                                  /* offset + chunk */
+        data += chunk;                                                         /* data + chunk */
+        len -= chunk;                                                          /* length - chunk */
+        if ((ota->offset % 256) == 0)                                          /* page is complete */
+        {
+            if (a_w25qxx_ota_program_page(ota, ota->offset - 256, 256) != 0)   /* program it */
+            {
+                ota->installing = 0;                                           /* abort */
+                
+                return 1;                                                      /* return error */
+            }
+        }
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     finish the install and flip the selector to the new slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] crc expected image crc32
+ * @return    status code
+ *            - 0 success
+ *            - 1 finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no install in progress
+ *            - 6 image is shorter than announced
+ *            - 7 crc mismatch
+ * @note      the image is read back and hashed before the selector record is programmed,
+ *            the record is the single commit point
+ */
+uint8_t w25qxx_ota_finish(w25qxx_ota_t *ota, uint32_t crc)
+{
+    uint8_t res;
+    uint32_t check;
+    
+    res = a_w25qxx_ota_check(ota);                                                                     /* check handle */
+    if (res != 0)                                                                                      /* check result */
+    {
+        return res;                                                                                    /* return error */
+    }
+    if (ota->installing != W25QXX_OTA_INSTALL_STREAM)                                                  /* check installing */
+    {
+        ota->handle->debug_print("w25qxx: no install in progress.\n");                                 /* no install in progress */
+        
+        return 5;                                                                                      /* return error */
+    }
+    if (ota->offset != ota->size)                                                                      /* check size */
+    {
+        ota->handle->debug_print("w25qxx: image is shorter than announced.\n");                        /* image is shorter than announced */
+        
+        return 6;                                                                                      /* return error */
+    }
+    
+    ota->installing = 0;                                                                               /* install ends here */
+    if (~ota->crc != crc)                                                                              /* check the stream hash */
+    {
+        ota->handle->debug_print("w25qxx: crc mismatch.\n");                                           /* crc mismatch */
+        
+        return 7;                                                                                      /* return error */
+    }
+    if ((ota->offset % 256) != 0)                                                                      /* partial last page */
+    {
+        if (a_w25qxx_ota_program_page(ota, ota->offset - (ota->offset % 256), ota->offset % 256) != 0) /* program it */
+        {
+            return 1;                                                                                  /* return error */
+        }
+    }
+    if (a_w25qxx_ota_hash_slot(ota, ota->target, ota->size, &check) != 0)                              /* read back */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    if (check != crc)                                                                                  /* check the flash content */
+    {
+        ota->handle->debug_print("w25qxx: verify failed.\n");                                          /* verify failed */
+        
+        return 1;                                                                                      /* return error */
+    }
+    ota->image[ota->target].size = ota->size;                                                          /* set size */
+    ota->image[ota->target].crc = crc;                                                                 /* set crc */
+    ota->image[ota->target].valid = 1;                                                                 /* set valid */
+    if (a_w25qxx_ota_append_record(ota, ota->target) != 0)                                             /* flip the selector */
+    {
+        return 1;                                                                                      /* return error */
+    }
+    
+    return 0;                                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     verify a slot and make it active
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] slot slot to activate
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 slot has no image
+ *            - 6 image crc mismatch
+ * @note      used to roll back to the previous image
+ */
+uint8_t w25qxx_ota_select(w25qxx_ota_t *ota, w25qxx_ota_slot_t slot)
+{
+    uint8_t res;
+    uint32_t check;
+    
+    res = a_w25qxx_ota_check(ota);                                             /* check handle */
+    if (res != 0)                                                              /* check result */
+    {
+        return res;                                                            /* return error */
+    }
+    if ((slot > W25QXX_OTA_SLOT_B) || (ota->image[slot].valid == 0) ||
+        ((ota->installing != 0) && (ota->target == slot)))                     /* check slot */
+    {
+        ota->handle->debug_print("w25qxx: slot has no image.\n");              /* slot has no image */
+        
+        return 5;                                                              /* return error */
+    }
+    
+    if (a_w25qxx_ota_hash_slot(ota, slot, ota->image[slot].size, &check) != 0) /* hash the slot */
+    {
+        return 1;                                                              /* return error */
+    }
+    if (check != ota->image[slot].crc)                                         /* check crc */
+    {
+        ota->handle->debug_print("w25qxx: image crc mismatch.\n");             /* image crc mismatch */
+        
+        return 6;                                                              /* return error */
+    }
+    if (a_w25qxx_ota_append_record(ota, (uint8_t)slot) != 0)                   /* flip the selector */
+    {
+        return 1;                                                              /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     program one output sector of a patch
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @param[in] sector_off sector offset inside the slot
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      unchanged pages are skipped, the sector is erased only when a changed page needs a bit set
+ */
+static uint8_t a_w25qxx_ota_patch_flush(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch, uint32_t sector_off)
+{
+    uint8_t erase;
+    uint8_t *p;
+    uint16_t program;
+    uint32_t base;
+    uint32_t skip;
+    uint32_t i;
+    uint32_t j;
+    
+    base = ota->slot_addr[ota->target] + sector_off;                                          /* sector address */
+    erase = 0;                                                                                /* init 0 */
+    program = 0;                                                                              /* init 0 */
+    skip = 0;                                                                                 /* init 0 */
+    for (i = 0; i < 16; i++)                                                                  /* compare all pages */
+    {
+        if (w25qxx_read(ota->handle, base + i * 256, ota->buf, 256) != 0)                     /* read the flash page */
+        {
+            ota->handle->debug_print("w25qxx: read failed.\n");                               /* read failed */
+            
+            return 1;                                                                         /* return error */
+        }
+        p = &patch->buf[i * 256];                                                             /* page pointer */
+        if (memcmp(p, ota->buf, 256) == 0)                                                    /* unchanged page */
+        {
+            skip++;                                                                           /* skip++ */
+            
+            continue;                                                                         /* continue */
+        }
+        for (j = 0; j < 256; j++)                                                             /* compare bytes */
+        {
+            if ((p[j] & (uint8_t)~ota->buf[j]) != 0)                                          /* a bit must go back to 1 */
+            {
+                erase = 1;                                                                    /* need erase */
+                
+                break;                                                                        /* break */
+            }
+        }
+        if (erase != 0)                                                                       /* need erase */
+        {
+            break;                                                                            /* break */
+        }
+        program |= (uint16_t)(1 << i);                                                        /* program in place */
+    }
+    if (erase != 0)                                                                           /* rewrite the sector */
+    {
+        if (w25qxx_sector_erase_4k(ota->handle, base) != 0)                                   /* sector erase */
+        {
+            ota->handle->debug_print("w25qxx: sector erase 4k failed.\n");                    /* sector erase 4k failed */
+            
+            return 1;                                                                         /* return error */
+        }
+        patch->sector_erase++;                                                                /* erase++ */
+        program = 0;                                                                          /* init 0 */
+        for (i = 0; i < 16; i++)                                                              /* find non blank pages */
+        {
+            p = &patch->buf[i * 256];                                                         /* page pointer */
+            for (j = 0; j < 256; j++)                                                         /* check bytes */
+            {
+                if (p[j] != 0xFF)                                                             /* not blank */
+                {
+                    program |= (uint16_t)(1 << i);                                            /* program it */
+                    
+                    break;                                                                    /* break */
+                }
+            }
+        }
+    }
+    else
+    {
+        patch->page_skip += skip;                                                             /* unchanged pages */
+    }
+    for (i = 0; i < 16; i++)                                                                  /* program pages */
+    {
+        if ((program & (1 << i)) == 0)                                                        /* skip page */
+        {
+            continue;                                                                         /* continue */
+        }
+        if (w25qxx_page_program(ota->handle, base + i * 256, &patch->buf[i * 256], 256) != 0) /* page program */
+        {
+            ota->handle->debug_print("w25qxx: page program failed.\n");                       /* page program failed */
+            
+            return 1;                                                                         /* return error */
+        }
+        patch->page_program++;                                                                /* program++ */
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     produce image bytes
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @param[in] *data pointer to an insert data buffer, NULL copies from the old image
+ * @param[in] src old image offset for a copy
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 produce failed
+ * @note      copied bytes are read straight into the output sector buffer
+ */
+static uint8_t a_w25qxx_ota_patch_emit(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch, const uint8_t *data,
+                                       uint32_t src, uint32_t len)
+{
+    uint32_t pos;
+    uint32_t n;
+    
+    while (len != 0)                                                          /* loop all bytes */
+    {
+        pos = patch->out % 4096;                                              /* sector position */
+        n = 4096 - pos;                                                       /* get sector remain */
+        if (n > len)                                                          /* check length */
+        {
+            n = len;                                                          /* set length */
+        }
+        if (data != NULL)                                                     /* insert */
+        {
+            memcpy(&patch->buf[pos], data, n);                                /* copy data */
+            data += n;                                                        /* data + n */
+        }
+        else
+        {
+            if (w25qxx_read(ota->handle, ota->slot_addr[ota->active] + src,
+                            &patch->buf[pos], n) != 0)                        /* read the old image */
+            {
+                ota->handle->debug_print("w25qxx: read failed.\n");           /* read failed */
+                
+                return 1;                                                     /* return error */
+            }
+            src += n;                                                         /* source + n */
+        }
+        patch->hash = w25qxx_util_crc32(patch->hash, &patch->buf[pos], n);    /* hash while writing */
+        patch->out += n;                                                      /* out + n */
+        len -= n;                                                             /* length - n */
+        if ((patch->out % 4096) == 0)                                         /* sector is complete */
+        {
+            if (a_w25qxx_ota_patch_flush(ota, patch, patch->out - 4096) != 0) /* program it */
+            {
+                return 1;                                                     /* return error */
+            }
+        }
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     start applying a delta patch from the active slot into the inactive slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no active slot
+ * @note      nothing is erased until the first output sector is complete
+ */
+uint8_t w25qxx_ota_patch_begin(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ota_check(ota);                                     /* check handle */
+    if (res != 0)                                                      /* check result */
+    {
+        return res;                                                    /* return error */
+    }
+    if (patch == NULL)                                                 /* check patch */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (ota->active == W25QXX_OTA_SLOT_NONE)                           /* check active */
+    {
+        ota->handle->debug_print("w25qxx: no active slot.\n");         /* no active slot */
+        
+        return 5;                                                      /* return error */
+    }
+    
+    ota->target = (uint8_t)(1 - ota->active);                          /* inactive slot */
+    ota->image[ota->target].valid = 0;                                 /* slot is being replaced */
+    memset(patch, 0, sizeof(w25qxx_ota_patch_t) - sizeof(patch->buf)); /* clear state */
+    patch->state = W25QXX_OTA_PATCH_STATE_HEADER;                      /* wait for the header */
+    patch->arg_len = 16;                                               /* header length */
+    patch->hash = 0xFFFFFFFFU;                                         /* init crc */
+    ota->installing = W25QXX_OTA_INSTALL_PATCH;                        /* set installing */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     stream patch data
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @param[in] *data pointer to a patch data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no patch in progress
+ *            - 6 patch is invalid
+ * @note      copy ops read the active slot with w25qxx_read, every completed 4k output sector
+ *            is compared with the inactive slot, unchanged pages are not programmed and the
+ *            sector is erased only when a bit has to go back to 1
+ */
+uint8_t w25qxx_ota_patch_write(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch, const uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint32_t n;
+    uint32_t src;
+    uint32_t size;
+    
+    res = a_w25qxx_ota_check(ota);                                                                       /* check handle */
+    if (res != 0)                                                                                        /* check result */
+    {
+        return res;                                                                                      /* return error */
+    }
+    if ((patch == NULL) || (ota->installing != W25QXX_OTA_INSTALL_PATCH))                                /* check installing */
+    {
+        ota->handle->debug_print("w25qxx: no patch in progress.\n");                                     /* no patch in progress */
+        
+        return 5;                                                                                        /* return error */
+    }
+    
+    while (len != 0)                                                                                     /* parse all bytes */
+    {
+        if (patch->state == W25QXX_OTA_PATCH_STATE_OP)                                                   /* op code */
+        {
+            patch->op = *data;                                                                           /* get op */
+            data++;                                                                                      /* data + 1 */
+            len--;                                                                                       /* length - 1 */
+            if (patch->op == W25QXX_OTA_PATCH_OP_COPY)                                                   /* copy */
+            {
+                patch->arg_len = 8;                                                                      /* offset and length */
+            }
+            else if (patch->op == W25QXX_OTA_PATCH_OP_INSERT)                                            /* insert */
+            {
+                patch->arg_len = 4;                                                                      /* length */
+            }
+            else
+            {
+                ota->installing = 0;                                                                     /* abort */
+                ota->handle->debug_print("w25qxx: patch is invalid.\n");                                 /* patch is invalid */
+                
+                return 6;                                                                                /* return error */
+            }
+            patch->arg_pos = 0;                                                                          /* init 0 */
+            patch->state = W25QXX_OTA_PATCH_STATE_ARG;                                                   /* wait for arguments */
+        }
+        else if (patch->state == W25QXX_OTA_PATCH_STATE_DATA)                                            /* insert data */
+        {
+            n = (len < patch->remain) ? len : patch->remain;                                             /* get length */
+            if (a_w25qxx_ota_patch_emit(ota, patch, data, 0, n) != 0)                                    /* produce bytes */
+            {
+                ota->installing = 0;                                                                     /* abort */
+                
+                return 1;                                                                                /* return error */
+            }
+            data += n;                                                                                   /* data + n */
+            len -= n;                                                                                    /* length - n */
+            patch->remain -= n;                                                                          /* remain - n */
+            if (patch->remain == 0)                                                                      /* insert done */
+            {
+                patch->state = W25QXX_OTA_PATCH_STATE_OP;                                                /* next op */
+            }
+        }
+        else
+        {
+            n = patch->arg_len - patch->arg_pos;                                                         /* missing bytes */
+            if (n > len)                                                                                 /* check length */
+            {
+                n = len;                                                                                 /* set length */
+            }
+            memcpy(&patch->arg[patch->arg_pos], data, n);                                                /* collect */
+            patch->arg_pos += n;                                                                         /* position + n */
+            data += n;                                                                                   /* data + n */
+            len -= n;                                                                                    /* length - n */
+            if (patch->arg_pos < patch->arg_len)                                                         /* not complete */
+            {
+                continue;                                                                                /* continue */
+            }
+            if (patch->state == W25QXX_OTA_PATCH_STATE_HEADER)                                           /* header */
+            {
+                patch->size = w25qxx_util_get32(&patch->arg[4]);                                         /* get new size */
+                patch->crc = w25qxx_util_get32(&patch->arg[8]);                                          /* get new crc */
+                if ((w25qxx_util_get32(&patch->arg[0]) != W25QXX_OTA_PATCH_MAGIC) ||
+                    (patch->size == 0) || (patch->size > ota->slot_size) ||
+                    (w25qxx_util_get32(&patch->arg[12]) != ota->image[ota->active].crc))                 /* check header */
+                {
+                    ota->installing = 0;                                                                 /* abort */
+                    ota->handle->debug_print("w25qxx: patch is invalid.\n");                             /* patch is invalid */
+                    
+                    return 6;                                                                            /* return error */
+                }
+                patch->state = W25QXX_OTA_PATCH_STATE_OP;                                                /* first op */
+                
+                continue;                                                                                /* continue */
+            }
+            if (patch->op == W25QXX_OTA_PATCH_OP_COPY)                                                   /* copy */
+            {
+                src = w25qxx_util_get32(&patch->arg[0]);                                                 /* get offset */
+                size = w25qxx_util_get32(&patch->arg[4]);                                                /* get length */
+            }
+            else
+            {
+                src = 0;                                                                                 /* no source */
+                size = w25qxx_util_get32(&patch->arg[0]);                                                /* get length */
+            }
+            if ((size > patch->size - patch->out) ||
+                ((patch->op == W25QXX_OTA_PATCH_OP_COPY) &&
+                 ((src > ota->image[ota->active].size) || (size > ota->image[ota->active].size - src)))) /* check range */
+            {
+                ota->installing = 0;                                                                     /* abort */
+                ota->handle->debug_print("w25qxx: patch is invalid.\n");                                 /* patch is invalid */
+                
+                return 6;                                                                                /* return error */
+            }
+            if (patch->op == W25QXX_OTA_PATCH_OP_COPY)                                                   /* copy */
+            {
+                if (a_w25qxx_ota_patch_emit(ota, patch, NULL, src, size) != 0)                           /* copy from the old image */
+                {
+                    ota->installing = 0;                                                                 /* abort */
+                    
+                    return 1;                                                                            /* return error */
+                }
+                patch->state = W25QXX_OTA_PATCH_STATE_OP;                                                /* next op */
+            }
+            else
+            {
+                patch->remain = size;                                                                    /* set remain */
+                patch->state = (size != 0) ? W25QXX_OTA_PATCH_STATE_DATA : W25QXX_OTA_PATCH_STATE_OP;    /* wait for data */
+            }
+        }
+    }
+    
+    return 0;                                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     finish the patch and flip the selector to the new slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no patch in progress
+ *            - 6 patch is incomplete
+ *            - 7 crc mismatch
+ * @note      the new image is read back and hashed before the selector record is programmed
+ */
+uint8_t w25qxx_ota_patch_finish(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch)
+{
+    uint8_t res;
+    uint32_t pos;
+    uint32_t check;
+    
+    res = a_w25qxx_ota_check(ota);                                                  /* check handle */
+    if (res != 0)                                                                   /* check result */
+    {
+        return res;                                                                 /* return error */
+    }
+    if ((patch == NULL) || (ota->installing != W25QXX_OTA_INSTALL_PATCH))           /* check installing */
+    {
+        ota->handle->debug_print("w25qxx: no patch in progress.\n");                /* no patch in progress */
+        
+        return 5;                                                                   /* return error */
+    }
+    if ((patch->state != W25QXX_OTA_PATCH_STATE_OP) || (patch->out != patch->size)) /* check size */
+    {
+        ota->handle->debug_print("w25qxx: patch is incomplete.\n");                 /* patch is incomplete */
+        
+        return 6;                                                                   /* return error */
+    }
+    
+    ota->installing = 0;                                                            /* patch ends here */
+    if (~patch->hash != patch->crc)                                                 /* check the produced image */
+    {
+        ota->handle->debug_print("w25qxx: crc mismatch.\n");                        /* crc mismatch */
+        
+        return 7;                                                                   /* return error */
+    }
+    pos = patch->out % 4096;                                                        /* last sector fill */
+    if (pos != 0)                                                                   /* partial last sector */
+    {
+        memset(&patch->buf[pos], 0xFF, 4096 - pos);                                 /* pad */
+        if (a_w25qxx_ota_patch_flush(ota, patch, patch->out - pos) != 0)            /* program it */
+        {
+            return 1;                                                               /* return error */
+        }
+    }
+    if (a_w25qxx_ota_hash_slot(ota, ota->target, patch->size, &check) != 0)         /* read back */
+    {
+        return 1;                                                                   /* return error */
+    }
+    if (check != patch->crc)                                                        /* check the flash content */
+    {
+        ota->handle->debug_print("w25qxx: verify failed.\n");                       /* verify failed */
+        
+        return 1;                                                                   /* return error */
+    }
+    ota->image[ota->target].size = patch->size;                                     /* set size */
+    ota->image[ota->target].crc = patch->crc;                                       /* set crc */
+    ota->image[ota->target].valid = 1;                                              /* set valid */
+    if (a_w25qxx_ota_append_record(ota, ota->target) != 0)                          /* flip the selector */
+    {
+        return 1;                                                                   /* return error */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
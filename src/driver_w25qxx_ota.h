@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ota.h
+ * @brief     driver w25qxx ota header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_OTA_H
+#define DRIVER_W25QXX_OTA_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_ota_driver w25qxx ota driver function
+ * @brief    w25qxx a/b firmware slot modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx ota slot enumeration definition
+ */
+typedef enum
+{
+    W25QXX_OTA_SLOT_A    = 0x00,        /**< slot a */
+    W25QXX_OTA_SLOT_B    = 0x01,        /**< slot b */
+    W25QXX_OTA_SLOT_NONE = 0xFF,        /**< no slot */
+} w25qxx_ota_slot_t;
+
+/**
+ * @brief w25qxx ota image structure definition
+ */
+typedef struct w25qxx_ota_image_s
+{
+    uint32_t size;         /**< image size */
+    uint32_t crc;          /**< image crc32 */
+    uint8_t valid;         /**< image is recorded */
+} w25qxx_ota_image_t;
+
+/**
+ * @brief w25qxx ota patch structure definition
+ * @note  a patch is a 16 bytes header (magic "WDP0", new size, new crc32, old crc32, little endian)
+ *        followed by ops, 0x01 copy (old offset u32, length u32) and 0x02 insert (length u32, data)
+ */
+typedef struct w25qxx_ota_patch_s
+{
+    uint8_t state;                 /**< parser state */
+    uint8_t op;                    /**< current op */
+    uint8_t arg[16];               /**< argument buffer */
+    uint32_t arg_len;              /**< argument length */
+    uint32_t arg_pos;              /**< received argument bytes */
+    uint32_t remain;               /**< insert bytes left */
+    uint32_t size;                 /**< new image size */
+    uint32_t crc;                  /**< expected new image crc32 */
+    uint32_t hash;                 /**< running crc of the produced image */
+    uint32_t out;                  /**< produced bytes */
+    uint32_t page_skip;            /**< unchanged pages not programmed */
+    uint32_t page_program;         /**< programmed pages */
+    uint32_t sector_erase;         /**< erased sectors */
+    uint8_t buf[4096];             /**< output sector buffer */
+} w25qxx_ota_patch_t;
+
+/**
+ * @brief w25qxx ota structure definition
+ */
+typedef struct w25qxx_ota_s
+{
+    w25qxx_handle_t *handle;              /**< w25qxx handle */
+    uint32_t slot_addr[2];                /**< slot address */
+    uint32_t slot_size;                   /**< slot size */
+    uint32_t selector_addr;               /**< selector region address */
+    uint32_t seq;                         /**< newest selector record sequence */
+    uint32_t record_addr;                 /**< next selector record address */
+    w25qxx_ota_image_t image[2];          /**< recorded image of each slot */
+    uint8_t active;                       /**< active slot */
+    uint8_t target;                       /**< slot being installed */
+    uint32_t size;                        /**< size of the image being installed */
+    uint32_t offset;                      /**< bytes received */
+    uint32_t erased;                      /**< erased bytes of the target slot */
+    uint32_t crc;                         /**< running crc of the image being installed */
+    uint8_t buf[256];                     /**< page buffer */
+    uint8_t installing;                   /**< install in progress */
+    uint8_t mounted;                      /**< mounted flag */
+    uint8_t inited;                       /**< inited flag */
+} w25qxx_ota_t;
+
+/**
+ * @brief     initialize the slot manager
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] slot_a slot a address
+ * @param[in] slot_b slot b address
+ * @param[in] slot_size slot size
+ * @param[in] selector_addr selector region address, two 4k sectors
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 slot size is invalid
+ * @note      slots are 64k aligned, slot_size is a multiple of 64k, no region may overlap
+ */
+uint8_t w25qxx_ota_init(w25qxx_ota_t *ota, w25qxx_handle_t *handle, uint32_t slot_a, uint32_t slot_b,
+                        uint32_t slot_size, uint32_t selector_addr);
+
+/**
+ * @brief     deinit the slot manager
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      an unfinished install is dropped
+ */
+uint8_t w25qxx_ota_deinit(w25qxx_ota_t *ota);
+
+/**
+ * @brief     load the newest selector record
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      no active slot is reported when the selector region holds no valid record
+ */
+uint8_t w25qxx_ota_mount(w25qxx_ota_t *ota);
+
+/**
+ * @brief      get the active slot
+ * @param[in]  *ota pointer to a w25qxx ota structure
+ * @param[out] *slot pointer to a slot buffer
+ * @param[out] *addr pointer to a slot address buffer
+ * @param[out] *image pointer to a w25qxx ota image structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 no active slot
+ * @note       none
+ */
+uint8_t w25qxx_ota_get_active(w25qxx_ota_t *ota, w25qxx_ota_slot_t *slot, uint32_t *addr, w25qxx_ota_image_t *image);
+
+/**
+ * @brief     start installing an image into the inactive slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] size image size
+ * @return    status code
+ *            - 0 success
+ *            - 1 begin failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 size is invalid
+ * @note      the first 64k block is erased here, the active slot is never touched
+ */
+uint8_t w25qxx_ota_begin(w25qxx_ota_t *ota, uint32_t size);
+
+/**
+ * @brief     stream image data into the inactive slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no install in progress
+ *            - 6 image is larger than announced
+ * @note      data is hashed and programmed one page at a time, 64k blocks are erased as the
+ *            writer reaches them and blank pages are not programmed
+ */
+uint8_t w25qxx_ota_write(w25qxx_ota_t *ota, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief     finish the install and flip the selector to the new slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] crc expected image crc32
+ * @return    status code
+ *            - 0 success
+ *            - 1 finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no install in progress
+ *            - 6 image is shorter than announced
+ *            - 7 crc mismatch
+ * @note      the image is read back and hashed before the selector record is programmed,
+ *            the record is the single commit point
+ */
+uint8_t w25qxx_ota_finish(w25qxx_ota_t *ota, uint32_t crc);
+
+/**
+ * @brief     verify a slot and make it active
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] slot slot to activate
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 slot has no image
+ *            - 6 image crc mismatch
+ * @note      used to roll back to the previous image
+ */
+uint8_t w25qxx_ota_select(w25qxx_ota_t *ota, w25qxx_ota_slot_t slot);
+
+/**
+ * @brief     start applying a delta patch from the active slot into the inactive slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no active slot
+ * @note      nothing is erased until the first output sector is complete
+ */
+uint8_t w25qxx_ota_patch_begin(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch);
+
+/**
+ * @brief     stream patch data
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @param[in] *data pointer to a patch data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no patch in progress
+ *            - 6 patch is invalid
+ * @note      copy ops read the active slot with w25qxx_read, every completed 4k output sector
+ *            is compared with the inactive slot, unchanged pages are not programmed and the
+ *            sector is erased only when a bit has to go back to 1
+ */
+uint8_t w25qxx_ota_patch_write(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief     finish the patch and flip the selector to the new slot
+ * @param[in] *ota pointer to a w25qxx ota structure
+ * @param[in] *patch pointer to a w25qxx ota patch structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 finish failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 no patch in progress
+ *            - 6 patch is incomplete
+ *            - 7 crc mismatch
+ * @note      the new image is read back and hashed before the selector record is programmed
+ */
+uint8_t w25qxx_ota_patch_finish(w25qxx_ota_t *ota, w25qxx_ota_patch_t *patch);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
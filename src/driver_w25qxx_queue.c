@@ -0,0 +1,900 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_queue.c
+ * @brief     driver w25qxx queue source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_queue.h"
+
+/**
+ * @brief     take the list lock
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @note      none
+ */
+static void a_w25qxx_queue_lock(w25qxx_queue_t *queue)
+{
+    if (queue->lock != NULL) /* check lock */
+    {
+        queue->lock();       /* lock */
+    }
+}
+
+/**
+ * @brief     release the list lock
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @note      none
+ */
+static void a_w25qxx_queue_unlock(w25qxx_queue_t *queue)
+{
+    if (queue->unlock != NULL) /* check unlock */
+    {
+        queue->unlock();       /* unlock */
+    }
+}
+
+/**
+ * @brief     get the priority class of an operation
+ * @param[in] op operation
+ * @return    0 for reads, 1 for programs and 2 for erases
+ * @note      none
+ */
+static uint8_t a_w25qxx_queue_class(w25qxx_queue_op_t op)
+{
+    if (op == W25QXX_QUEUE_OP_READ)         /* read */
+    {
+        return 0;                           /* class 0 */
+    }
+    else if (op == W25QXX_QUEUE_OP_PROGRAM) /* program */
+    {
+        return 1;                           /* class 1 */
+    }
+    else
+    {
+        return 2;                           /* class 2 */
+    }
+}
+
+/**
+ * @brief      get the flash range of a request
+ * @param[in]  *req pointer to a w25qxx queue request structure
+ * @param[out] *start pointer to a start address buffer
+ * @param[out] *end pointer to an end address buffer
+ * @note       none
+ */
+static void a_w25qxx_queue_range(w25qxx_queue_req_t *req, uint32_t *start, uint32_t *end)
+{
+    *start = req->addr;                            /* set start */
+    if (req->op == W25QXX_QUEUE_OP_ERASE_4K)       /* 4k sector */
+    {
+        *end = req->addr + 4096;                   /* set end */
+    }
+    else if (req->op == W25QXX_QUEUE_OP_ERASE_64K) /* 64k block */
+    {
+        *end = req->addr + 65536;                  /* set end */
+    }
+    else
+    {
+        *end = req->addr + req->len;               /* set end */
+    }
+}
+
+/**
+ * @brief     check if two requests must keep their order
+ * @param[in] *a pointer to a w25qxx queue request structure
+ * @param[in] *b pointer to a w25qxx queue request structure
+ * @return    1 if they conflict, otherwise 0
+ * @note      overlapping requests conflict unless both are reads
+ */
+static uint8_t a_w25qxx_queue_conflict(w25qxx_queue_req_t *a, w25qxx_queue_req_t *b)
+{
+    uint32_t a_start;
+    uint32_t a_end;
+    uint32_t b_start;
+    uint32_t b_end;
+    
+    if ((a->op == W25QXX_QUEUE_OP_READ) && (b->op == W25QXX_QUEUE_OP_READ)) /* both reads */
+    {
+        return 0;                                                           /* no conflict */
+    }
+    a_w25qxx_queue_range(a, &a_start, &a_end);                              /* get range a */
+    a_w25qxx_queue_range(b, &b_start, &b_end);                              /* get range b */
+    
+    return (uint8_t)((a_start < b_end) && (b_start < a_end));               /* check overlap */
+}
+
+/**
+ * @brief     check if a request may be issued now
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *req pointer to a pending w25qxx queue request structure
+ * @param[in] *active pointer to the running erase, may be NULL
+ * @return    1 if it may be issued, otherwise 0
+ * @note      a request waits for every earlier pending request it conflicts with,
+ *            the caller holds the list lock
+ */
+static uint8_t a_w25qxx_queue_eligible(w25qxx_queue_t *queue, w25qxx_queue_req_t *req, w25qxx_queue_req_t *active)
+{
+    uint8_t i;
+    w25qxx_queue_req_t *r;
+    
+    if ((active != NULL) && (a_w25qxx_queue_conflict(req, active) != 0)) /* check the running erase */
+    {
+        return 0;                                                        /* wait */
+    }
+    for (i = 0; i < 3; i++)                                              /* loop all classes */
+    {
+        for (r = queue->head[i]; r != NULL; r = r->next)                 /* lists are in submit order */
+        {
+            if ((int32_t)(r->seq - req->seq) >= 0)                       /* not earlier */
+            {
+                break;                                                   /* break */
+            }
+            if (a_w25qxx_queue_conflict(req, r) != 0)                    /* check conflict */
+            {
+                return 0;                                                /* wait */
+            }
+        }
+    }
+    
+    return 1;                                                            /* ready */
+}
+
+/**
+ * @brief     unlink a pending request
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *req pointer to a pending w25qxx queue request structure
+ * @note      the caller holds the list lock
+ */
+static void a_w25qxx_queue_remove(w25qxx_queue_t *queue, w25qxx_queue_req_t *req)
+{
+    uint8_t cls;
+    w25qxx_queue_req_t *prev;
+    w25qxx_queue_req_t *r;
+    
+    cls = a_w25qxx_queue_class(req->op);               /* get class */
+    prev = NULL;                                       /* no previous */
+    for (r = queue->head[cls]; r != NULL; r = r->next) /* find the request */
+    {
+        if (r == req)                                  /* found */
+        {
+            break;                                     /* break */
+        }
+        prev = r;                                      /* save previous */
+    }
+    if (r == NULL)                                     /* not found */
+    {
+        return;                                        /* return */
+    }
+    if (prev == NULL)                                  /* first one */
+    {
+        queue->head[cls] = req->next;                  /* set head */
+    }
+    else
+    {
+        prev->next = req->next;                        /* skip it */
+    }
+    if (queue->tail[cls] == req)                       /* last one */
+    {
+        queue->tail[cls] = prev;                       /* set tail */
+    }
+    req->next = NULL;                                  /* detach */
+}
+
+/**
+ * @brief     pick the next request to issue
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] read_only 1 to pick only reads submitted before limit
+ * @param[in] limit submit counter limit of read_only
+ * @param[in] *active pointer to the running erase, may be NULL
+ * @return    pointer to the request, NULL if nothing may be issued
+ * @note      the caller holds the list lock
+ */
+static w25qxx_queue_req_t *a_w25qxx_queue_pick(w25qxx_queue_t *queue, uint8_t read_only, uint32_t limit,
+                                               w25qxx_queue_req_t *active)
+{
+    uint8_t i;
+    w25qxx_queue_req_t *r;
+    
+    for (i = 0; i < ((read_only != 0) ? 1 : 3); i++)                  /* reads, programs, erases */
+    {
+        for (r = queue->head[i]; r != NULL; r = r->next)              /* loop in submit order */
+        {
+            if ((read_only != 0) && ((int32_t)(r->seq - limit) >= 0)) /* submitted too late */
+            {
+                break;                                                /* break */
+            }
+            if (a_w25qxx_queue_eligible(queue, r, active) != 0)       /* check order */
+            {
+                return r;                                             /* found */
+            }
+        }
+    }
+    
+    return NULL;                                                      /* nothing */
+}
+
+/**
+ * @brief      take a request and merge its neighbours
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[in]  *first pointer to the picked w25qxx queue request structure
+ * @param[in]  *active pointer to the running erase, may be NULL
+ * @param[out] *op pointer to a merged operation buffer
+ * @param[out] *start pointer to a merged start address buffer
+ * @param[out] *len pointer to a merged length buffer
+ * @return     pointer to the batch list
+ * @note       contiguous reads and programs are merged up to the merge buffer size,
+ *             a whole 64k block of 4k erases becomes one block erase and covered
+ *             erases are dropped, the caller holds the list lock
+ */
+static w25qxx_queue_req_t *a_w25qxx_queue_collect(w25qxx_queue_t *queue, w25qxx_queue_req_t *first,
+                                                  w25qxx_queue_req_t *active, w25qxx_queue_op_t *op,
+                                                  uint32_t *start, uint32_t *len)
+{
+    uint8_t cls;
+    uint8_t found;
+    uint32_t s;
+    uint32_t e;
+    uint32_t r_start;
+    uint32_t r_end;
+    uint32_t base;
+    uint32_t i;
+    w25qxx_queue_req_t *batch;
+    w25qxx_queue_req_t *last;
+    w25qxx_queue_req_t *r;
+    w25qxx_queue_req_t *next;
+    
+    cls = a_w25qxx_queue_class(first->op);                                                          /* get class */
+    a_w25qxx_queue_remove(queue, first);                                                            /* take it */
+    batch = first;                                                                                  /* batch head */
+    last = first;                                                                                   /* batch tail */
+    *op = first->op;                                                                                /* set operation */
+    a_w25qxx_queue_range(first, &s, &e);                                                            /* get range */
+    if (cls != 2)                                                                                   /* read or program */
+    {
+        found = (uint8_t)(first->len <= W25QXX_QUEUE_MERGE_SIZE);                                   /* large ones go alone */
+        while (found != 0)                                                                          /* grow the range */
+        {
+            found = 0;                                                                              /* init 0 */
+            for (r = queue->head[cls]; r != NULL; r = r->next)                                      /* loop the class */
+            {
+                if (((e - s) + r->len) > W25QXX_QUEUE_MERGE_SIZE)                                   /* too long */
+                {
+                    continue;                                                                       /* skip */
+                }
+                if (((r->addr == e) || ((r->addr + r->len) == s)) &&
+                    (a_w25qxx_queue_eligible(queue, r, active) != 0))                               /* adjacent and ready */
+                {
+                    a_w25qxx_queue_remove(queue, r);                                                /* take it */
+                    last->next = r;                                                                 /* append */
+                    last = r;                                                                       /* set tail */
+                    s = (r->addr < s) ? r->addr : s;                                                /* update start */
+                    e = (r->addr == e) ? (e + r->len) : e;                                          /* update end */
+                    queue->stats.merge++;                                                           /* merge++ */
+                    found = 1;                                                                      /* found */
+                    
+                    break;                                                                          /* rescan */
+                }
+            }
+        }
+    }
+    else
+    {
+        if (first->op == W25QXX_QUEUE_OP_ERASE_4K)                                                  /* 4k sector */
+        {
+            base = first->addr & ~0xFFFFU;                                                          /* block base */
+            for (i = 0; i < 16; i++)                                                                /* loop all sectors */
+            {
+                if ((base + i * 4096) == first->addr)                                               /* the picked one */
+                {
+                    continue;                                                                       /* skip */
+                }
+                for (r = queue->head[2]; r != NULL; r = r->next)                                    /* find the sector */
+                {
+                    if ((r->op == W25QXX_QUEUE_OP_ERASE_4K) && (r->addr == (base + i * 4096)) &&
+                        (a_w25qxx_queue_eligible(queue, r, active) != 0))                           /* ready */
+                    {
+                        break;                                                                      /* found */
+                    }
+                }
+                if (r == NULL)                                                                      /* missing */
+                {
+                    break;                                                                          /* break */
+                }
+            }
+            if (i == 16)                                                                            /* whole block */
+            {
+                *op = W25QXX_QUEUE_OP_ERASE_64K;                                                    /* block erase */
+                s = base;                                                                           /* set start */
+                e = base + 65536;                                                                   /* set end */
+            }
+        }
+        for (r = queue->head[2]; r != NULL; r = next)                                               /* drop covered erases */
+        {
+            next = r->next;                                                                         /* save next */
+            a_w25qxx_queue_range(r, &r_start, &r_end);                                              /* get range */
+            if ((r_start >= s) && (r_end <= e) && (a_w25qxx_queue_eligible(queue, r, active) != 0)) /* covered and ready */
+            {
+                a_w25qxx_queue_remove(queue, r);                                                    /* take it */
+                last->next = r;                                                                     /* append */
+                last = r;                                                                           /* set tail */
+                queue->stats.merge++;                                                               /* merge++ */
+            }
+        }
+    }
+    *start = s;                                                                                     /* set start */
+    *len = e - s;                                                                                   /* set length */
+    
+    return batch;                                                                                   /* return the batch */
+}
+
+/**
+ * @brief      complete a batch
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[in]  *batch pointer to a batch list
+ * @param[in]  res result of the batch
+ * @param[out] *count pointer to a completed request number buffer
+ * @note       the callbacks may submit the same requests again
+ */
+static void a_w25qxx_queue_complete(w25qxx_queue_t *queue, w25qxx_queue_req_t *batch, uint8_t res, uint32_t *count)
+{
+    w25qxx_queue_req_t *next;
+    
+    while (batch != NULL)                /* loop the batch */
+    {
+        next = batch->next;              /* save next */
+        batch->next = NULL;              /* detach */
+        a_w25qxx_queue_lock(queue);      /* lock */
+        queue->stats.complete++;         /* complete++ */
+        a_w25qxx_queue_unlock(queue);    /* unlock */
+        (*count)++;                      /* count++ */
+        if (batch->callback != NULL)     /* check callback */
+        {
+            batch->callback(batch, res); /* run callback */
+        }
+        batch = next;                    /* next one */
+    }
+}
+
+/**
+ * @brief     issue a read batch
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *batch pointer to a batch list
+ * @param[in] start merged start address
+ * @param[in] len merged length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      a single request reads straight into its own buffer
+ */
+static uint8_t a_w25qxx_queue_read(w25qxx_queue_t *queue, w25qxx_queue_req_t *batch, uint32_t start, uint32_t len)
+{
+    w25qxx_queue_req_t *r;
+    
+    a_w25qxx_queue_lock(queue);                                                    /* lock */
+    queue->stats.dispatch++;                                                       /* dispatch++ */
+    a_w25qxx_queue_unlock(queue);                                                  /* unlock */
+    if (batch->next == NULL)                                                       /* single request */
+    {
+        return (uint8_t)(w25qxx_read(queue->handle, start, batch->buf, len) != 0); /* read */
+    }
+    if (w25qxx_read(queue->handle, start, queue->buf, len) != 0)                   /* read the merged range */
+    {
+        return 1;                                                                  /* return error */
+    }
+    for (r = batch; r != NULL; r = r->next)                                        /* loop the batch */
+    {
+        memcpy(r->buf, &queue->buf[r->addr - start], r->len);                      /* copy out */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     issue a program batch
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *batch pointer to a batch list
+ * @param[in] start merged start address
+ * @param[in] len merged length
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      one page program per touched page
+ */
+static uint8_t a_w25qxx_queue_program(w25qxx_queue_t *queue, w25qxx_queue_req_t *batch, uint32_t start, uint32_t len)
+{
+    uint8_t *p;
+    uint16_t n;
+    w25qxx_queue_req_t *r;
+    
+    p = batch->buf;                                               /* single request */
+    if (batch->next != NULL)                                      /* merged requests */
+    {
+        for (r = batch; r != NULL; r = r->next)                   /* loop the batch */
+        {
+            memcpy(&queue->buf[r->addr - start], r->buf, r->len); /* copy in */
+        }
+        p = queue->buf;                                           /* merged data */
+    }
+    while (len != 0)                                              /* loop all pages */
+    {
+        n = (uint16_t)(256 - (start % 256));                      /* page remain */
+        if (n > len)                                              /* check length */
+        {
+            n = (uint16_t)len;                                    /* set length */
+        }
+        a_w25qxx_queue_lock(queue);                               /* lock */
+        queue->stats.dispatch++;                                  /* dispatch++ */
+        a_w25qxx_queue_unlock(queue);                             /* unlock */
+        if (w25qxx_page_program(queue->handle, start, p, n) != 0) /* page program */
+        {
+            return 1;                                             /* return error */
+        }
+        start += n;                                               /* next address */
+        p += n;                                                   /* next data */
+        len -= n;                                                 /* remain */
+    }
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      issue the reads submitted before limit
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[in]  limit submit counter limit
+ * @param[in]  *active pointer to the running erase
+ * @param[out] *count pointer to a completed request number buffer
+ * @note       reads submitted later wait for the next suspend so the erase keeps moving
+ */
+static void a_w25qxx_queue_serve_reads(w25qxx_queue_t *queue, uint32_t limit, w25qxx_queue_req_t *active, uint32_t *count)
+{
+    uint8_t res;
+    uint32_t start;
+    uint32_t len;
+    w25qxx_queue_op_t op;
+    w25qxx_queue_req_t *r;
+    w25qxx_queue_req_t *batch;
+    
+    while (1)                                                                /* loop all reads */
+    {
+        a_w25qxx_queue_lock(queue);                                          /* lock */
+        r = a_w25qxx_queue_pick(queue, 1, limit, active);                    /* pick a read */
+        if (r == NULL)                                                       /* no read */
+        {
+            a_w25qxx_queue_unlock(queue);                                    /* unlock */
+            
+            return;                                                          /* return */
+        }
+        batch = a_w25qxx_queue_collect(queue, r, active, &op, &start, &len); /* merge */
+        a_w25qxx_queue_unlock(queue);                                        /* unlock */
+        res = a_w25qxx_queue_read(queue, batch, start, len);                 /* read */
+        a_w25qxx_queue_complete(queue, batch, res, count);                   /* complete */
+    }
+}
+
+/**
+ * @brief      issue an erase batch
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[in]  op merged operation
+ * @param[in]  start merged start address
+ * @param[out] *count pointer to a completed request number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 erase failed
+ * @note       the erase is polled, and reads outside its range that are waiting
+ *             between two polls suspend it, run and resume it
+ */
+static uint8_t a_w25qxx_queue_erase(w25qxx_queue_t *queue, w25qxx_queue_op_t op, uint32_t start, uint32_t *count)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t timeout;
+    uint32_t limit;
+    w25qxx_bool_t busy;
+    w25qxx_bool_t suspended;
+    w25qxx_queue_req_t active;
+    w25qxx_queue_req_t *r;
+    
+    suspended = W25QXX_BOOL_FALSE;                                                   /* not suspended */
+    memset(&active, 0, sizeof(w25qxx_queue_req_t));                                  /* clear */
+    active.op = op;                                                                  /* set operation */
+    active.addr = start;                                                             /* set address */
+    a_w25qxx_queue_lock(queue);                                                      /* lock */
+    queue->stats.dispatch++;                                                         /* dispatch++ */
+    a_w25qxx_queue_unlock(queue);                                                    /* unlock */
+    if (op == W25QXX_QUEUE_OP_ERASE_64K)                                             /* 64k block */
+    {
+        timeout = W25QXX_ERASE_64K_TIMEOUT_MS;                                       /* set timeout */
+        res = w25qxx_erase_start(queue->handle, W25QXX_ERASE_TYPE_BLOCK_64K, start); /* start the erase */
+    }
+    else
+    {
+        timeout = W25QXX_ERASE_4K_TIMEOUT_MS;                                        /* set timeout */
+        res = w25qxx_erase_start(queue->handle, W25QXX_ERASE_TYPE_SECTOR_4K, start); /* start the erase */
+    }
+    if (res != 0)                                                                    /* check result */
+    {
+        return 1;                                                                    /* return error */
+    }
+    
+    while (1)                                                                        /* poll the erase */
+    {
+        if (w25qxx_get_busy(queue->handle, &busy, NULL) != 0)                        /* get busy */
+        {
+            return 1;                                                                /* return error */
+        }
+        if (busy == W25QXX_BOOL_FALSE)                                               /* done */
+        {
+            return 0;                                                                /* success return 0 */
+        }
+        if (timeout == 0)                                                            /* check timeout */
+        {
+            queue->handle->debug_print("w25qxx: erase timeout.\n");                  /* erase timeout */
+            
+            return 1;                                                                /* return error */
+        }
+        a_w25qxx_queue_lock(queue);                                                  /* lock */
+        limit = queue->seq;                                                          /* reads waiting now */
+        r = a_w25qxx_queue_pick(queue, 1, limit, &active);                           /* any read */
+        a_w25qxx_queue_unlock(queue);                                                /* unlock */
+        if (r != NULL)                                                               /* suspend for it */
+        {
+            if (w25qxx_erase_program_suspend(queue->handle) != 0)                    /* suspend */
+            {
+                return 1;                                                            /* return error */
+            }
+            a_w25qxx_queue_lock(queue);                                              /* lock */
+            queue->stats.suspend++;                                                  /* suspend++ */
+            a_w25qxx_queue_unlock(queue);                                            /* unlock */
+            for (i = 0; i < 10; i++)                                                 /* wait the suspend latency */
+            {
+                if (w25qxx_get_busy(queue->handle, &busy, &suspended) != 0)          /* get busy */
+                {
+                    return 1;                                                        /* return error */
+                }
+                if (busy == W25QXX_BOOL_FALSE)                                       /* suspended or done */
+                {
+                    break;                                                           /* break */
+                }
+                queue->handle->delay_us(20);                                         /* delay 20 us */
+            }
+            if (busy != W25QXX_BOOL_FALSE)                                           /* check busy */
+            {
+                queue->handle->debug_print("w25qxx: erase suspend timeout.\n");      /* erase suspend timeout */
+                
+                return 1;                                                            /* return error */
+            }
+            a_w25qxx_queue_serve_reads(queue, limit, &active, count);                /* run the reads */
+            if (suspended == W25QXX_BOOL_FALSE)                                      /* finished before the suspend */
+            {
+                return 0;                                                            /* success return 0 */
+            }
+            if (w25qxx_erase_program_resume(queue->handle) != 0)                     /* resume */
+            {
+                return 1;                                                            /* return error */
+            }
+        }
+        queue->handle->delay_ms(1);                                                  /* delay 1 ms */
+        timeout--;                                                                   /* timeout-- */
+    }
+}
+
+/**
+ * @brief      check the queue
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+static uint8_t a_w25qxx_queue_check(w25qxx_queue_t *queue)
+{
+    if (queue == NULL)      /* check handle */
+    {
+        return 2;           /* return error */
+    }
+    if (queue->inited != 1) /* check handle initialization */
+    {
+        return 3;           /* return error */
+    }
+    
+    return 0;               /* success return 0 */
+}
+
+/**
+ * @brief     initialize the queue
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      while the queue runs every flash access must go through it
+ */
+uint8_t w25qxx_queue_init(w25qxx_queue_t *queue, w25qxx_handle_t *handle)
+{
+    if ((queue == NULL) || (handle == NULL))  /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    if (handle->inited != 1)                  /* check handle initialization */
+    {
+        return 3;                             /* return error */
+    }
+    
+    memset(queue, 0, sizeof(w25qxx_queue_t)); /* clear queue */
+    queue->handle = handle;                   /* set handle */
+    queue->inited = 1;                        /* set inited */
+    
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief     deinit the queue
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 requests are pending
+ * @note      none
+ */
+uint8_t w25qxx_queue_deinit(w25qxx_queue_t *queue)
+{
+    uint8_t res;
+    uint32_t pending;
+    
+    res = w25qxx_queue_get_pending(queue, &pending);                   /* get pending */
+    if (res != 0)                                                      /* check result */
+    {
+        return res;                                                    /* return error */
+    }
+    if (pending != 0)                                                  /* check pending */
+    {
+        queue->handle->debug_print("w25qxx: requests are pending.\n"); /* requests are pending */
+        
+        return 4;                                                      /* return error */
+    }
+    
+    queue->inited = 0;                                                 /* clear inited */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the thread hooks
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @param[in] *notify pointer to a notify function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      lock and unlock guard the pending lists only and are never held
+ *            during a flash operation, notify is called after every submit to
+ *            wake the thread running w25qxx_queue_run
+ */
+uint8_t w25qxx_queue_set_hooks(w25qxx_queue_t *queue, void (*lock)(void), void (*unlock)(void),
+                               void (*notify)(void))
+{
+    uint8_t res;
+    
+    res = a_w25qxx_queue_check(queue); /* check handle */
+    if (res != 0)                      /* check result */
+    {
+        return res;                    /* return error */
+    }
+    
+    queue->lock = lock;                /* set lock */
+    queue->unlock = unlock;            /* set unlock */
+    queue->notify = notify;            /* set notify */
+    
+    return 0;                          /* success return 0 */
+}
+
+/**
+ * @brief     submit a request
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *req pointer to a filled w25qxx queue request structure
+ * @param[in] *callback pointer to a completion callback, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 request is invalid
+ * @note      the request and its buffer belong to the queue until the callback runs,
+ *            reads go before programs and programs before erases, but a request never
+ *            passes an earlier one that touches the same range
+ */
+uint8_t w25qxx_queue_submit(w25qxx_queue_t *queue, w25qxx_queue_req_t *req,
+                            void (*callback)(w25qxx_queue_req_t *req, uint8_t res))
+{
+    uint8_t res;
+    uint8_t cls;
+    
+    res = a_w25qxx_queue_check(queue);                                          /* check handle */
+    if (res != 0)                                                               /* check result */
+    {
+        return res;                                                             /* return error */
+    }
+    if ((req == NULL) || (req->op > W25QXX_QUEUE_OP_ERASE_64K) ||
+        ((req->op <= W25QXX_QUEUE_OP_PROGRAM) && ((req->buf == NULL) || (req->len == 0))) ||
+        ((req->op == W25QXX_QUEUE_OP_ERASE_4K) && ((req->addr % 4096) != 0)) ||
+        ((req->op == W25QXX_QUEUE_OP_ERASE_64K) && ((req->addr % 65536) != 0))) /* check request */
+    {
+        queue->handle->debug_print("w25qxx: request is invalid.\n");            /* request is invalid */
+        
+        return 4;                                                               /* return error */
+    }
+    
+    cls = a_w25qxx_queue_class(req->op);                                        /* get class */
+    req->callback = callback;                                                   /* set callback */
+    req->next = NULL;                                                           /* last one */
+    a_w25qxx_queue_lock(queue);                                                 /* lock */
+    req->seq = queue->seq++;                                                    /* set order */
+    if (queue->tail[cls] == NULL)                                               /* empty list */
+    {
+        queue->head[cls] = req;                                                 /* set head */
+    }
+    else
+    {
+        queue->tail[cls]->next = req;                                           /* append */
+    }
+    queue->tail[cls] = req;                                                     /* set tail */
+    queue->stats.submit++;                                                      /* submit++ */
+    a_w25qxx_queue_unlock(queue);                                               /* unlock */
+    if (queue->notify != NULL)                                                  /* check notify */
+    {
+        queue->notify();                                                        /* wake the runner */
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      run one queue step
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[out] *count pointer to a completed request number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a step merges the best request with its neighbours and issues them,
+ *             reads arriving during an erase suspend it, count is 0 when the queue
+ *             is empty, failed requests get their error in the callback
+ */
+uint8_t w25qxx_queue_run(w25qxx_queue_t *queue, uint32_t *count)
+{
+    uint8_t res;
+    uint32_t start;
+    uint32_t len;
+    w25qxx_queue_op_t op;
+    w25qxx_queue_req_t *r;
+    w25qxx_queue_req_t *batch;
+    
+    res = a_w25qxx_queue_check(queue);                                 /* check handle */
+    if (res != 0)                                                      /* check result */
+    {
+        return res;                                                    /* return error */
+    }
+    
+    *count = 0;                                                        /* init 0 */
+    a_w25qxx_queue_lock(queue);                                        /* lock */
+    r = a_w25qxx_queue_pick(queue, 0, 0, NULL);                        /* pick the best one */
+    if (r == NULL)                                                     /* empty */
+    {
+        a_w25qxx_queue_unlock(queue);                                  /* unlock */
+        
+        return 0;                                                      /* success return 0 */
+    }
+    batch = a_w25qxx_queue_collect(queue, r, NULL, &op, &start, &len); /* merge */
+    a_w25qxx_queue_unlock(queue);                                      /* unlock */
+    if (op == W25QXX_QUEUE_OP_READ)                                    /* read */
+    {
+        res = a_w25qxx_queue_read(queue, batch, start, len);           /* read */
+    }
+    else if (op == W25QXX_QUEUE_OP_PROGRAM)                            /* program */
+    {
+        res = a_w25qxx_queue_program(queue, batch, start, len);        /* program */
+    }
+    else
+    {
+        res = a_w25qxx_queue_erase(queue, op, start, count);           /* erase */
+    }
+    a_w25qxx_queue_complete(queue, batch, res, count);                 /* complete */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the pending request number
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[out] *pending pointer to a pending number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_queue_get_pending(w25qxx_queue_t *queue, uint32_t *pending)
+{
+    uint8_t res;
+    uint8_t i;
+    w25qxx_queue_req_t *r;
+    
+    res = a_w25qxx_queue_check(queue);                   /* check handle */
+    if (res != 0)                                        /* check result */
+    {
+        return res;                                      /* return error */
+    }
+    
+    *pending = 0;                                        /* init 0 */
+    a_w25qxx_queue_lock(queue);                          /* lock */
+    for (i = 0; i < 3; i++)                              /* loop all classes */
+    {
+        for (r = queue->head[i]; r != NULL; r = r->next) /* loop the list */
+        {
+            (*pending)++;                                /* pending++ */
+        }
+    }
+    a_w25qxx_queue_unlock(queue);                        /* unlock */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[out] *stats pointer to a w25qxx queue stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_queue_get_stats(w25qxx_queue_t *queue, w25qxx_queue_stats_t *stats)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_queue_check(queue); /* check handle */
+    if (res != 0)                      /* check result */
+    {
+        return res;                    /* return error */
+    }
+    
+    a_w25qxx_queue_lock(queue);        /* lock */
+    *stats = queue->stats;             /* copy stats */
+    a_w25qxx_queue_unlock(queue);      /* unlock */
+    
+    return 0;                          /* success return 0 */
+}
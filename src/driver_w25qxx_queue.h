@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_queue.h
+ * @brief     driver w25qxx queue header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_QUEUE_H
+#define DRIVER_W25QXX_QUEUE_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_queue_driver w25qxx queue driver function
+ * @brief    w25qxx prioritized request queue modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx queue merge buffer size definition
+ */
+#ifndef W25QXX_QUEUE_MERGE_SIZE
+    #define W25QXX_QUEUE_MERGE_SIZE        4096        /**< 4k */
+#endif
+
+/**
+ * @brief w25qxx queue operation enumeration definition
+ */
+typedef enum
+{
+    W25QXX_QUEUE_OP_READ      = 0x00,        /**< read len bytes into buf */
+    W25QXX_QUEUE_OP_PROGRAM   = 0x01,        /**< program len bytes from buf into erased flash */
+    W25QXX_QUEUE_OP_ERASE_4K  = 0x02,        /**< erase the 4k sector at addr */
+    W25QXX_QUEUE_OP_ERASE_64K = 0x03,        /**< erase the 64k block at addr */
+} w25qxx_queue_op_t;
+
+/**
+ * @brief w25qxx queue request structure definition
+ */
+typedef struct w25qxx_queue_req_s
+{
+    w25qxx_queue_op_t op;                                                /**< operation */
+    uint32_t addr;                                                       /**< flash address */
+    uint8_t *buf;                                                        /**< data buffer */
+    uint32_t len;                                                        /**< data length */
+    void (*callback)(struct w25qxx_queue_req_s *req, uint8_t res);       /**< completion callback */
+    void *arg;                                                           /**< user argument */
+    uint32_t seq;                                                        /**< submit order */
+    struct w25qxx_queue_req_s *next;                                     /**< next request */
+} w25qxx_queue_req_t;
+
+/**
+ * @brief w25qxx queue stats structure definition
+ */
+typedef struct w25qxx_queue_stats_s
+{
+    uint32_t submit;              /**< submitted requests */
+    uint32_t complete;            /**< completed requests */
+    uint32_t dispatch;            /**< flash operations issued */
+    uint32_t merge;               /**< requests merged into another one */
+    uint32_t suspend;             /**< erases suspended for reads */
+} w25qxx_queue_stats_t;
+
+/**
+ * @brief w25qxx queue structure definition
+ */
+typedef struct w25qxx_queue_s
+{
+    w25qxx_handle_t *handle;                     /**< w25qxx handle */
+    w25qxx_queue_req_t *head[3];                 /**< pending lists of reads, programs and erases */
+    w25qxx_queue_req_t *tail[3];                 /**< list tails */
+    uint32_t seq;                                /**< submit counter */
+    void (*lock)(void);                          /**< list lock hook */
+    void (*unlock)(void);                        /**< list unlock hook */
+    void (*notify)(void);                        /**< submit notify hook */
+    w25qxx_queue_stats_t stats;                  /**< statistics */
+    uint8_t buf[W25QXX_QUEUE_MERGE_SIZE];        /**< merge buffer */
+    uint8_t inited;                              /**< inited flag */
+} w25qxx_queue_t;
+
+/**
+ * @brief     initialize the queue
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      while the queue runs every flash access must go through it
+ */
+uint8_t w25qxx_queue_init(w25qxx_queue_t *queue, w25qxx_handle_t *handle);
+
+/**
+ * @brief     deinit the queue
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 requests are pending
+ * @note      none
+ */
+uint8_t w25qxx_queue_deinit(w25qxx_queue_t *queue);
+
+/**
+ * @brief     set the thread hooks
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *lock pointer to a lock function, may be NULL
+ * @param[in] *unlock pointer to an unlock function, may be NULL
+ * @param[in] *notify pointer to a notify function, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      lock and unlock guard the pending lists only and are never held
+ *            during a flash operation, notify is called after every submit to
+ *            wake the thread running w25qxx_queue_run
+ */
+uint8_t w25qxx_queue_set_hooks(w25qxx_queue_t *queue, void (*lock)(void), void (*unlock)(void),
+                               void (*notify)(void));
+
+/**
+ * @brief     submit a request
+ * @param[in] *queue pointer to a w25qxx queue structure
+ * @param[in] *req pointer to a filled w25qxx queue request structure
+ * @param[in] *callback pointer to a completion callback, may be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 request is invalid
+ * @note      the request and its buffer belong to the queue until the callback runs,
+ *            reads go before programs and programs before erases, but a request never
+ *            passes an earlier one that touches the same range
+ */
+uint8_t w25qxx_queue_submit(w25qxx_queue_t *queue, w25qxx_queue_req_t *req,
+                            void (*callback)(w25qxx_queue_req_t *req, uint8_t res));
+
+/**
+ * @brief      run one queue step
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[out] *count pointer to a completed request number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a step merges the best request with its neighbours and issues them,
+ *             reads arriving during an erase suspend it, count is 0 when the queue
+ *             is empty, failed requests get their error in the callback
+ */
+uint8_t w25qxx_queue_run(w25qxx_queue_t *queue, uint32_t *count);
+
+/**
+ * @brief      get the pending request number
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[out] *pending pointer to a pending number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_queue_get_pending(w25qxx_queue_t *queue, uint32_t *pending);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *queue pointer to a w25qxx queue structure
+ * @param[out] *stats pointer to a w25qxx queue stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_queue_get_stats(w25qxx_queue_t *queue, w25qxx_queue_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
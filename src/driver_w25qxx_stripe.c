@@ -0,0 +1,727 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_stripe.c
+ * @brief     driver w25qxx stripe source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_stripe.h"
+
+/**
+ * @brief      map a volume address
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[in]  addr volume address
+ * @param[out] *chip pointer to a chip index buffer
+ * @param[out] *chip_addr pointer to a chip address buffer
+ * @note       none
+ */
+static void a_w25qxx_stripe_map(w25qxx_stripe_t *stripe, uint32_t addr, uint8_t *chip, uint32_t *chip_addr)
+{
+    uint32_t index;
+    
+    index = addr / stripe->unit;                                                 /* unit index */
+    *chip = (uint8_t)(index % stripe->count);                                    /* set chip */
+    *chip_addr = (index / stripe->count) * stripe->unit + (addr % stripe->unit); /* set chip address */
+}
+
+/**
+ * @brief      split one round of the volume range
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[in]  addr volume address
+ * @param[in]  len range length
+ * @param[out] *seg_addr pointer to a chip address array
+ * @param[out] *seg_len pointer to a segment length array
+ * @param[out] *seg_off pointer to a range offset array
+ * @return     covered length
+ * @note       a round gives every chip at most one unit, so the chips can work together
+ */
+static uint32_t a_w25qxx_stripe_round(w25qxx_stripe_t *stripe, uint32_t addr, uint32_t len,
+                                      uint32_t *seg_addr, uint32_t *seg_len, uint32_t *seg_off)
+{
+    uint8_t chip;
+    uint32_t chip_addr;
+    uint32_t done;
+    uint32_t n;
+    
+    memset(seg_len, 0, sizeof(uint32_t) * W25QXX_STRIPE_MAX_CHIP);   /* clear segments */
+    done = 0;                                                        /* init 0 */
+    while (done < len)                                               /* loop all units */
+    {
+        a_w25qxx_stripe_map(stripe, addr + done, &chip, &chip_addr); /* map */
+        if (seg_len[chip] != 0)                                      /* chip already used */
+        {
+            break;                                                   /* next round */
+        }
+        n = stripe->unit - ((addr + done) % stripe->unit);           /* unit remain */
+        if (n > (len - done))                                        /* check length */
+        {
+            n = len - done;                                          /* set length */
+        }
+        seg_addr[chip] = chip_addr;                                  /* set address */
+        seg_len[chip] = n;                                           /* set length */
+        seg_off[chip] = done;                                        /* set offset */
+        done += n;                                                   /* next unit */
+    }
+    
+    return done;                                                     /* return covered length */
+}
+
+/**
+ * @brief     wait for a chip to be idle
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] chip chip index
+ * @param[in] erase 1 if the chip is erasing
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      erases are polled every 1 ms and programs every 10 us like the driver
+ */
+static uint8_t a_w25qxx_stripe_wait(w25qxx_stripe_t *stripe, uint8_t chip, uint8_t erase)
+{
+    uint32_t timeout;
+    w25qxx_bool_t busy;
+    w25qxx_handle_t *handle;
+    
+    handle = stripe->handle[chip];                                                               /* get handle */
+    timeout = (erase != 0) ? W25QXX_ERASE_64K_TIMEOUT_MS : W25QXX_PAGE_PROGRAM_TIMEOUT_MS * 100; /* set timeout */
+    while (1)                                                                                    /* poll */
+    {
+        if (w25qxx_get_busy(handle, &busy, NULL) != 0)                                           /* get busy */
+        {
+            return 1;                                                                            /* return error */
+        }
+        if (busy == W25QXX_BOOL_FALSE)                                                           /* idle */
+        {
+            return 0;                                                                            /* success return 0 */
+        }
+        if (timeout == 0)                                                                        /* check timeout */
+        {
+            handle->debug_print("w25qxx: stripe wait timeout.\n");                               /* stripe wait timeout */
+            
+            return 1;                                                                            /* return error */
+        }
+        timeout--;                                                                               /* timeout-- */
+        if (erase != 0)                                                                          /* erase */
+        {
+            handle->delay_ms(1);                                                                 /* delay 1 ms */
+        }
+        else
+        {
+            handle->delay_us(10);                                                                /* delay 10 us */
+        }
+    }
+}
+
+/**
+ * @brief     wait for all busy chips
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] *busy pointer to a busy flag array, cleared on return
+ * @param[in] erase 1 if the chips are erasing
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ * @note      a chip that fails its wait doesn't stop the wait of the others
+ */
+static uint8_t a_w25qxx_stripe_wait_all(w25qxx_stripe_t *stripe, uint8_t *busy, uint8_t erase)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    res = 0;                                                 /* init 0 */
+    for (i = 0; i < stripe->count; i++)                      /* loop all chips */
+    {
+        if (busy[i] != 0)                                    /* check busy */
+        {
+            busy[i] = 0;                                     /* not waited again */
+            if (a_w25qxx_stripe_wait(stripe, i, erase) != 0) /* wait */
+            {
+                res = 1;                                     /* keep waiting the others */
+            }
+        }
+    }
+    
+    return res;                                              /* return the result */
+}
+
+/**
+ * @brief     wait for the started chips after an error
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] *busy pointer to a busy flag array, cleared on return
+ * @return    1
+ * @note      polled like erases, so a program or an erase in flight is never left
+ *            running into the next call
+ */
+static uint8_t a_w25qxx_stripe_abort(w25qxx_stripe_t *stripe, uint8_t *busy)
+{
+    (void)a_w25qxx_stripe_wait_all(stripe, busy, 1);         /* wait all chips */
+    
+    return 1;                                                /* return error */
+}
+
+/**
+ * @brief     check the stripe and a range
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] addr volume address
+ * @param[in] len range length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      none
+ */
+static uint8_t a_w25qxx_stripe_check(w25qxx_stripe_t *stripe, uint32_t addr, uint32_t len)
+{
+    uint32_t size;
+    
+    if (stripe == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (stripe->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    size = stripe->chip_size * stripe->count;                          /* volume size */
+    if ((addr > size) || (len > (size - addr)))                        /* check range */
+    {
+        stripe->handle[0]->debug_print("w25qxx: range is invalid.\n"); /* range is invalid */
+        
+        return 5;                                                      /* return error */
+    }
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     initialize the striped volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] **handle pointer to an array of initialized w25qxx handles
+ * @param[in] count chip count
+ * @param[in] unit stripe unit in bytes
+ * @param[in] chip_size used bytes of every chip
+ * @param[in] *buf pointer to a work buffer of count * 4096 bytes
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 geometry is invalid
+ * @note      unit is a multiple of 4096 and chip_size a multiple of unit, unit k of
+ *            the volume lives on chip k % count at (k / count) * unit
+ */
+uint8_t w25qxx_stripe_init(w25qxx_stripe_t *stripe, w25qxx_handle_t **handle, uint8_t count,
+                           uint32_t unit, uint32_t chip_size, uint8_t *buf)
+{
+    uint8_t i;
+    
+    if ((stripe == NULL) || (handle == NULL) || (buf == NULL))            /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if ((count == 0) || (count > W25QXX_STRIPE_MAX_CHIP))                 /* check count */
+    {
+        return 4;                                                         /* return error */
+    }
+    for (i = 0; i < count; i++)                                           /* loop all chips */
+    {
+        if (handle[i] == NULL)                                            /* check handle */
+        {
+            return 2;                                                     /* return error */
+        }
+        if (handle[i]->inited != 1)                                       /* check handle initialization */
+        {
+            return 3;                                                     /* return error */
+        }
+    }
+    if ((unit == 0) || ((unit % 4096) != 0) || (chip_size == 0) ||
+        ((chip_size % unit) != 0) || (chip_size > (0xFFFFFFFFU / count))) /* check geometry */
+    {
+        handle[0]->debug_print("w25qxx: geometry is invalid.\n");         /* geometry is invalid */
+        
+        return 4;                                                         /* return error */
+    }
+    
+    memset(stripe, 0, sizeof(w25qxx_stripe_t));                           /* clear stripe */
+    stripe->handle = handle;                                              /* set handle */
+    stripe->count = count;                                                /* set count */
+    stripe->unit = unit;                                                  /* set unit */
+    stripe->chip_size = chip_size;                                        /* set chip size */
+    stripe->buf = buf;                                                    /* set buffer */
+    stripe->inited = 1;                                                   /* set inited */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     deinit the striped volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_stripe_deinit(w25qxx_stripe_t *stripe)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_stripe_check(stripe, 0, 0); /* check handle */
+    if (res != 0)                              /* check result */
+    {
+        return res;                            /* return error */
+    }
+    
+    stripe->inited = 0;                        /* clear inited */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the volume size
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_stripe_get_size(w25qxx_stripe_t *stripe, uint32_t *size)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_stripe_check(stripe, 0, 0); /* check handle */
+    if (res != 0)                              /* check result */
+    {
+        return res;                            /* return error */
+    }
+    
+    *size = stripe->chip_size * stripe->count; /* set size */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief      read the volume
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[in]  addr volume address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 range is invalid
+ * @note       none
+ */
+uint8_t w25qxx_stripe_read(w25qxx_stripe_t *stripe, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint8_t chip;
+    uint32_t chip_addr;
+    uint32_t n;
+    
+    res = a_w25qxx_stripe_check(stripe, addr, len);                     /* check handle */
+    if (res != 0)                                                       /* check result */
+    {
+        return res;                                                     /* return error */
+    }
+    
+    stripe->stats.read_bytes += len;                                    /* read bytes */
+    while (len != 0)                                                    /* loop all units */
+    {
+        a_w25qxx_stripe_map(stripe, addr, &chip, &chip_addr);           /* map */
+        n = stripe->unit - (addr % stripe->unit);                       /* unit remain */
+        if (n > len)                                                    /* check length */
+        {
+            n = len;                                                    /* set length */
+        }
+        if (w25qxx_read(stripe->handle[chip], chip_addr, data, n) != 0) /* read */
+        {
+            return 1;                                                   /* return error */
+        }
+        addr += n;                                                      /* next address */
+        data += n;                                                      /* next data */
+        len -= n;                                                       /* remain */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     program erased volume space
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] addr volume address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      the page programs of the chips overlap, the range must be erased
+ */
+uint8_t w25qxx_stripe_program(w25qxx_stripe_t *stripe, uint32_t addr, const uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t busy[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_addr[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_len[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_off[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t done;
+    uint32_t left;
+    uint32_t n;
+    
+    res = a_w25qxx_stripe_check(stripe, addr, len);                                            /* check handle */
+    if (res != 0)                                                                              /* check result */
+    {
+        return res;                                                                            /* return error */
+    }
+    
+    memset(busy, 0, sizeof(busy));                                                             /* all idle */
+    stripe->stats.write_bytes += len;                                                          /* write bytes */
+    while (len != 0)                                                                           /* loop all rounds */
+    {
+        done = a_w25qxx_stripe_round(stripe, addr, len, seg_addr, seg_len, seg_off);           /* split a round */
+        left = done;                                                                           /* init left */
+        while (left != 0)                                                                      /* one page per chip */
+        {
+            for (i = 0; i < stripe->count; i++)                                                /* loop all chips */
+            {
+                if (seg_len[i] == 0)                                                           /* nothing left */
+                {
+                    continue;                                                                  /* skip */
+                }
+                n = 256 - (seg_addr[i] % 256);                                                 /* page remain */
+                if (n > seg_len[i])                                                            /* check length */
+                {
+                    n = seg_len[i];                                                            /* set length */
+                }
+                if ((busy[i] != 0) && (a_w25qxx_stripe_wait(stripe, i, 0) != 0))               /* wait the last page */
+                {
+                    busy[i] = 0;                                                               /* already waited */
+                    
+                    return a_w25qxx_stripe_abort(stripe, busy);                                /* wait the started chips */
+                }
+                if (w25qxx_page_program_start(stripe->handle[i], seg_addr[i],
+                                              (uint8_t *)&data[seg_off[i]], (uint16_t)n) != 0) /* start the program */
+                {
+                    return a_w25qxx_stripe_abort(stripe, busy);                                /* wait the started chips */
+                }
+                busy[i] = 1;                                                                   /* busy */
+                stripe->stats.page_program++;                                                  /* page program++ */
+                seg_addr[i] += n;                                                              /* next address */
+                seg_off[i] += n;                                                               /* next offset */
+                seg_len[i] -= n;                                                               /* remain */
+                left -= n;                                                                     /* left */
+            }
+        }
+        addr += done;                                                                          /* next address */
+        data += done;                                                                          /* next data */
+        len -= done;                                                                           /* remain */
+    }
+    
+    return a_w25qxx_stripe_wait_all(stripe, busy, 0);                                          /* wait all chips */
+}
+
+/**
+ * @brief     write the volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] addr volume address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      like w25qxx_write the surrounding data is kept, one sector of every
+ *            chip is read, erased and programmed at the same time
+ */
+uint8_t w25qxx_stripe_write(w25qxx_stripe_t *stripe, uint32_t addr, const uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t busy[W25QXX_STRIPE_MAX_CHIP];
+    uint8_t erase[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_addr[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_len[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_off[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t sec_len[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t done;
+    uint32_t left;
+    uint32_t off;
+    uint32_t j;
+    uint32_t p;
+    uint8_t *sec;
+    
+    res = a_w25qxx_stripe_check(stripe, addr, len);                                    /* check handle */
+    if (res != 0)                                                                      /* check result */
+    {
+        return res;                                                                    /* return error */
+    }
+    
+    memset(busy, 0, sizeof(busy));                                                     /* all idle */
+    stripe->stats.write_bytes += len;                                                  /* write bytes */
+    while (len != 0)                                                                   /* loop all rounds */
+    {
+        done = a_w25qxx_stripe_round(stripe, addr, len, seg_addr, seg_len, seg_off);   /* split a round */
+        left = done;                                                                   /* init left */
+        while (left != 0)                                                              /* one sector per chip */
+        {
+            /* read and merge one sector of every chip */
+            for (i = 0; i < stripe->count; i++)                                        /* loop all chips */
+            {
+                sec_len[i] = 0;                                                        /* nothing */
+                erase[i] = 0;                                                          /* no erase */
+                if (seg_len[i] == 0)                                                   /* nothing left */
+                {
+                    continue;                                                          /* skip */
+                }
+                sec = &stripe->buf[(uint32_t)i * 4096];                                /* sector buffer */
+                off = seg_addr[i] % 4096;                                              /* sector offset */
+                sec_len[i] = 4096 - off;                                               /* sector remain */
+                if (sec_len[i] > seg_len[i])                                           /* check length */
+                {
+                    sec_len[i] = seg_len[i];                                           /* set length */
+                }
+                if (w25qxx_read(stripe->handle[i], seg_addr[i] - off, sec, 4096) != 0) /* read the sector */
+                {
+                    return a_w25qxx_stripe_abort(stripe, busy);                        /* wait the started chips */
+                }
+                for (j = 0; j < sec_len[i]; j++)                                       /* check the bits */
+                {
+                    if ((sec[off + j] & data[seg_off[i] + j]) != data[seg_off[i] + j]) /* 0 to 1 */
+                    {
+                        erase[i] = 1;                                                  /* need erase */
+                        
+                        break;                                                         /* break */
+                    }
+                }
+                memcpy(&sec[off], &data[seg_off[i]], sec_len[i]);                      /* merge */
+                if (erase[i] != 0)                                                     /* erase */
+                {
+                    if (w25qxx_erase_start(stripe->handle[i], W25QXX_ERASE_TYPE_SECTOR_4K,
+                                           seg_addr[i] - off) != 0)                    /* start the erase */
+                    {
+                        return a_w25qxx_stripe_abort(stripe, busy);                    /* wait the started chips */
+                    }
+                    busy[i] = 1;                                                       /* busy */
+                    stripe->stats.erase++;                                             /* erase++ */
+                }
+            }
+            if (a_w25qxx_stripe_wait_all(stripe, busy, 1) != 0)                        /* wait the erases */
+            {
+                return 1;                                                              /* return error */
+            }
+            
+            /* program the pages one chip after another */
+            for (p = 0; p < 16; p++)                                                   /* loop all pages */
+            {
+                for (i = 0; i < stripe->count; i++)                                    /* loop all chips */
+                {
+                    if (sec_len[i] == 0)                                               /* nothing */
+                    {
+                        continue;                                                      /* skip */
+                    }
+                    sec = &stripe->buf[(uint32_t)i * 4096 + p * 256];                  /* page buffer */
+                    off = seg_addr[i] % 4096;                                          /* sector offset */
+                    if (erase[i] != 0)                                                 /* erased sector */
+                    {
+                        for (j = 0; j < 256; j++)                                      /* find data */
+                        {
+                            if (sec[j] != 0xFF)                                        /* check data */
+                            {
+                                break;                                                 /* break */
+                            }
+                        }
+                        if (j == 256)                                                  /* blank page */
+                        {
+                            continue;                                                  /* skip */
+                        }
+                    }
+                    else
+                    {
+                        if (((p + 1) * 256 <= off) || (p * 256 >= (off + sec_len[i]))) /* untouched page */
+                        {
+                            continue;                                                  /* skip */
+                        }
+                    }
+                    if ((busy[i] != 0) && (a_w25qxx_stripe_wait(stripe, i, 0) != 0))   /* wait the last page */
+                    {
+                        busy[i] = 0;                                                   /* already waited */
+                        
+                        return a_w25qxx_stripe_abort(stripe, busy);                    /* wait the started chips */
+                    }
+                    if (w25qxx_page_program_start(stripe->handle[i], seg_addr[i] - off + p * 256,
+                                                  sec, 256) != 0)                      /* start the program */
+                    {
+                        return a_w25qxx_stripe_abort(stripe, busy);                    /* wait the started chips */
+                    }
+                    busy[i] = 1;                                                       /* busy */
+                    stripe->stats.page_program++;                                      /* page program++ */
+                }
+            }
+            if (a_w25qxx_stripe_wait_all(stripe, busy, 0) != 0)                        /* wait the programs */
+            {
+                return 1;                                                              /* return error */
+            }
+            for (i = 0; i < stripe->count; i++)                                        /* loop all chips */
+            {
+                seg_addr[i] += sec_len[i];                                             /* next address */
+                seg_off[i] += sec_len[i];                                              /* next offset */
+                seg_len[i] -= sec_len[i];                                              /* remain */
+                left -= sec_len[i];                                                    /* left */
+            }
+        }
+        addr += done;                                                                  /* next address */
+        data += done;                                                                  /* next data */
+        len -= done;                                                                   /* remain */
+    }
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     erase the volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] addr volume address
+ * @param[in] len erase length
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr or len is not 4k aligned
+ *            - 5 range is invalid
+ * @note      the chips erase at the same time, aligned 64k runs of a chip use block erases
+ */
+uint8_t w25qxx_stripe_erase(w25qxx_stripe_t *stripe, uint32_t addr, uint32_t len)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t busy[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_addr[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_len[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t seg_off[W25QXX_STRIPE_MAX_CHIP];
+    uint32_t done;
+    uint32_t left;
+    uint32_t n;
+    w25qxx_erase_type_t type;
+    
+    res = a_w25qxx_stripe_check(stripe, addr, len);                                  /* check handle */
+    if (res != 0)                                                                    /* check result */
+    {
+        return res;                                                                  /* return error */
+    }
+    if (((addr % 4096) != 0) || ((len % 4096) != 0))                                 /* check alignment */
+    {
+        stripe->handle[0]->debug_print("w25qxx: addr or len is not 4k aligned.\n");  /* addr or len is not 4k aligned */
+        
+        return 4;                                                                    /* return error */
+    }
+    
+    memset(busy, 0, sizeof(busy));                                                   /* all idle */
+    while (len != 0)                                                                 /* loop all rounds */
+    {
+        done = a_w25qxx_stripe_round(stripe, addr, len, seg_addr, seg_len, seg_off); /* split a round */
+        left = done;                                                                 /* init left */
+        while (left != 0)                                                            /* one erase per chip */
+        {
+            for (i = 0; i < stripe->count; i++)                                      /* loop all chips */
+            {
+                if (seg_len[i] == 0)                                                 /* nothing left */
+                {
+                    continue;                                                        /* skip */
+                }
+                if (((seg_addr[i] % 65536) == 0) && (seg_len[i] >= 65536))           /* whole block */
+                {
+                    type = W25QXX_ERASE_TYPE_BLOCK_64K;                              /* 64k block */
+                    n = 65536;                                                       /* 64k */
+                }
+                else
+                {
+                    type = W25QXX_ERASE_TYPE_SECTOR_4K;                              /* 4k sector */
+                    n = 4096;                                                        /* 4k */
+                }
+                if ((busy[i] != 0) && (a_w25qxx_stripe_wait(stripe, i, 1) != 0))     /* wait the last erase */
+                {
+                    busy[i] = 0;                                                     /* already waited */
+                    
+                    return a_w25qxx_stripe_abort(stripe, busy);                      /* wait the started chips */
+                }
+                if (w25qxx_erase_start(stripe->handle[i], type, seg_addr[i]) != 0)   /* start the erase */
+                {
+                    return a_w25qxx_stripe_abort(stripe, busy);                      /* wait the started chips */
+                }
+                busy[i] = 1;                                                         /* busy */
+                stripe->stats.erase++;                                               /* erase++ */
+                seg_addr[i] += n;                                                    /* next address */
+                seg_len[i] -= n;                                                     /* remain */
+                left -= n;                                                           /* left */
+            }
+        }
+        addr += done;                                                                /* next address */
+        len -= done;                                                                 /* remain */
+    }
+    
+    return a_w25qxx_stripe_wait_all(stripe, busy, 1);                                /* wait all chips */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[out] *stats pointer to a w25qxx stripe stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_stripe_get_stats(w25qxx_stripe_t *stripe, w25qxx_stripe_stats_t *stats)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_stripe_check(stripe, 0, 0); /* check handle */
+    if (res != 0)                              /* check result */
+    {
+        return res;                            /* return error */
+    }
+    
+    *stats = stripe->stats;                    /* copy stats */
+    
+    return 0;                                  /* success return 0 */
+}
@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_stripe.h
+ * @brief     driver w25qxx stripe header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_STRIPE_H
+#define DRIVER_W25QXX_STRIPE_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_stripe_driver w25qxx stripe driver function
+ * @brief    w25qxx multi chip striped volume modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx stripe max chip definition
+ */
+#ifndef W25QXX_STRIPE_MAX_CHIP
+    #define W25QXX_STRIPE_MAX_CHIP        8        /**< 8 chips */
+#endif
+
+/**
+ * @brief w25qxx stripe stats structure definition
+ */
+typedef struct w25qxx_stripe_stats_s
+{
+    uint32_t read_bytes;          /**< bytes read by the user */
+    uint32_t write_bytes;         /**< bytes written by the user */
+    uint32_t erase;               /**< erase commands */
+    uint32_t page_program;        /**< page program commands */
+} w25qxx_stripe_stats_t;
+
+/**
+ * @brief w25qxx stripe structure definition
+ */
+typedef struct w25qxx_stripe_s
+{
+    w25qxx_handle_t **handle;           /**< chip handles */
+    uint8_t count;                      /**< chip count */
+    uint32_t unit;                      /**< stripe unit */
+    uint32_t chip_size;                 /**< used bytes of every chip */
+    uint8_t *buf;                       /**< one sector buffer per chip */
+    w25qxx_stripe_stats_t stats;        /**< statistics */
+    uint8_t inited;                     /**< inited flag */
+} w25qxx_stripe_t;
+
+/**
+ * @brief     initialize the striped volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] **handle pointer to an array of initialized w25qxx handles
+ * @param[in] count chip count
+ * @param[in] unit stripe unit in bytes
+ * @param[in] chip_size used bytes of every chip
+ * @param[in] *buf pointer to a work buffer of count * 4096 bytes
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 geometry is invalid
+ * @note      unit is a multiple of 4096 and chip_size a multiple of unit, unit k of
+ *            the volume lives on chip k % count at (k / count) * unit
+ */
+uint8_t w25qxx_stripe_init(w25qxx_stripe_t *stripe, w25qxx_handle_t **handle, uint8_t count,
+                           uint32_t unit, uint32_t chip_size, uint8_t *buf);
+
+/**
+ * @brief     deinit the striped volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_stripe_deinit(w25qxx_stripe_t *stripe);
+
+/**
+ * @brief      get the volume size
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[out] *size pointer to a size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_stripe_get_size(w25qxx_stripe_t *stripe, uint32_t *size);
+
+/**
+ * @brief      read the volume
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[in]  addr volume address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 range is invalid
+ * @note       none
+ */
+uint8_t w25qxx_stripe_read(w25qxx_stripe_t *stripe, uint32_t addr, uint8_t *data, uint32_t len);
+
+/**
+ * @brief     program erased volume space
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] addr volume address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      the page programs of the chips overlap, the range must be erased
+ */
+uint8_t w25qxx_stripe_program(w25qxx_stripe_t *stripe, uint32_t addr, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief     write the volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] addr volume address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 range is invalid
+ * @note      like w25qxx_write the surrounding data is kept, one sector of every
+ *            chip is read, erased and programmed at the same time
+ */
+uint8_t w25qxx_stripe_write(w25qxx_stripe_t *stripe, uint32_t addr, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief     erase the volume
+ * @param[in] *stripe pointer to a w25qxx stripe structure
+ * @param[in] addr volume address
+ * @param[in] len erase length
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr or len is not 4k aligned
+ *            - 5 range is invalid
+ * @note      the chips erase at the same time, aligned 64k runs of a chip use block erases
+ */
+uint8_t w25qxx_stripe_erase(w25qxx_stripe_t *stripe, uint32_t addr, uint32_t len);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *stripe pointer to a w25qxx stripe structure
+ * @param[out] *stats pointer to a w25qxx stripe stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_stripe_get_stats(w25qxx_stripe_t *stripe, w25qxx_stripe_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
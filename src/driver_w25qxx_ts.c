@@ -0,0 +1,1003 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ts.c
+ * @brief     driver w25qxx ts source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_ts.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief ts layout definition
+ */
+#define W25QXX_TS_MAGIC              0x30535454U        /**< "TTS0" */
+#define W25QXX_TS_SECTOR_SIZE        4096U              /**< sector size */
+#define W25QXX_TS_HEADER_SIZE        16U                /**< data sector header size */
+#define W25QXX_TS_ENTRY_SIZE         16U                /**< index entry size */
+#define W25QXX_TS_RECORD_HEADER      8U                 /**< timestamp and crc32 */
+#define W25QXX_TS_BLANK              0xFFFFFFFFU        /**< erased word */
+
+/**
+ * @brief     get the address of a data sector
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] seq sector sequence
+ * @return    sector address
+ * @note      none
+ */
+static uint32_t a_w25qxx_ts_sector_addr(w25qxx_ts_t *ts, uint32_t seq)
+{
+    return ts->data_addr + (seq % ts->sector_count) * W25QXX_TS_SECTOR_SIZE; /* return address */
+}
+
+/**
+ * @brief     erase a range
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] addr range address
+ * @param[in] len range length
+ * @return    status code
+ *            - 0 success
+ *            - 1 erase failed
+ * @note      64k aligned parts are erased with block erases
+ */
+static uint8_t a_w25qxx_ts_erase_range(w25qxx_ts_t *ts, uint32_t addr, uint32_t len)
+{
+    uint8_t res;
+    uint32_t end;
+    
+    end = addr + len;                                           /* range end */
+    while (addr < end)                                          /* erase the range */
+    {
+        if (((addr % 65536) == 0) && (end - addr >= 65536))     /* whole 64k block */
+        {
+            res = w25qxx_block_erase_64k(ts->handle, addr);     /* block erase 64k */
+            addr += 65536;                                      /* next block */
+        }
+        else
+        {
+            res = w25qxx_sector_erase_4k(ts->handle, addr);     /* sector erase 4k */
+            addr += W25QXX_TS_SECTOR_SIZE;                      /* next sector */
+        }
+        if (res != 0)                                           /* check result */
+        {
+            ts->handle->debug_print("w25qxx: erase failed.\n"); /* erase failed */
+            
+            return 1;                                           /* return error */
+        }
+    }
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     program a 16 bytes block made of three words and their crc
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] addr flash address
+ * @param[in] a first word
+ * @param[in] b second word
+ * @param[in] c third word
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      used by data sector headers and index entries
+ */
+static uint8_t a_w25qxx_ts_write_block(w25qxx_ts_t *ts, uint32_t addr, uint32_t a, uint32_t b, uint32_t c)
+{
+    uint8_t block[16];
+    
+    w25qxx_util_put32(&block[0], a);                                          /* set word 0 */
+    w25qxx_util_put32(&block[4], b);                                          /* set word 1 */
+    w25qxx_util_put32(&block[8], c);                                          /* set word 2 */
+    w25qxx_util_put32(&block[12], w25qxx_util_crc32(0xFFFFFFFFU, block, 12)); /* set crc */
+    if (w25qxx_page_program(ts->handle, addr, block, 16) != 0)                /* page program */
+    {
+        ts->handle->debug_print("w25qxx: page program failed.\n");            /* page program failed */
+        
+        return 1;                                                             /* return error */
+    }
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      read a 16 bytes block made of three words and their crc
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[in]  addr flash address
+ * @param[out] *word pointer to a three words buffer
+ * @param[out] *valid pointer to a valid flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_w25qxx_ts_read_block(w25qxx_ts_t *ts, uint32_t addr, uint32_t *word, uint8_t *valid)
+{
+    uint8_t block[16];
+    
+    if (w25qxx_read(ts->handle, addr, block, 16) != 0)                                              /* read block */
+    {
+        ts->handle->debug_print("w25qxx: read failed.\n");                                          /* read failed */
+        
+        return 1;                                                                                   /* return error */
+    }
+    word[0] = w25qxx_util_get32(&block[0]);                                                         /* get word 0 */
+    word[1] = w25qxx_util_get32(&block[4]);                                                         /* get word 1 */
+    word[2] = w25qxx_util_get32(&block[8]);                                                         /* get word 2 */
+    *valid = (uint8_t)(w25qxx_util_get32(&block[12]) == w25qxx_util_crc32(0xFFFFFFFFU, block, 12)); /* check crc */
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      check the header of a data sector
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[in]  seq sector sequence
+ * @param[out] *valid pointer to a valid flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_w25qxx_ts_check_header(w25qxx_ts_t *ts, uint32_t seq, uint8_t *valid)
+{
+    uint32_t word[3];
+    
+    if (a_w25qxx_ts_read_block(ts, a_w25qxx_ts_sector_addr(ts, seq), word, valid) != 0) /* read header */
+    {
+        return 1;                                                                       /* return error */
+    }
+    if ((word[0] != W25QXX_TS_MAGIC) || (word[1] != seq) || (word[2] != ~seq))          /* check header */
+    {
+        *valid = 0;                                                                     /* invalid */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      read an index entry
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[in]  slot index slot
+ * @param[out] *seq pointer to a sector sequence buffer
+ * @param[out] *min_ts pointer to a min timestamp buffer
+ * @param[out] *max_ts pointer to a max timestamp buffer
+ * @param[out] *valid pointer to a valid flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       an entry is valid only in the slot of its own sequence
+ */
+static uint8_t a_w25qxx_ts_read_entry(w25qxx_ts_t *ts, uint32_t slot, uint32_t *seq,
+                                      uint32_t *min_ts, uint32_t *max_ts, uint8_t *valid)
+{
+    uint32_t word[3];
+    
+    if (a_w25qxx_ts_read_block(ts, ts->index_addr + slot * W25QXX_TS_ENTRY_SIZE, word, valid) != 0) /* read entry */
+    {
+        return 1;                                                                                   /* return error */
+    }
+    *seq = word[0];                                                                                 /* set sequence */
+    *min_ts = word[1];                                                                              /* set min */
+    *max_ts = word[2];                                                                              /* set max */
+    if ((*valid != 0) && ((*seq % ts->index_slot) != slot))                                         /* check slot */
+    {
+        *valid = 0;                                                                                 /* invalid */
+    }
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the timestamp range of a sealed sector
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[in]  seq sector sequence
+ * @param[out] *min_ts pointer to a min timestamp buffer
+ * @param[out] *max_ts pointer to a max timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a lost index entry reports the widest range so the sector is never skipped
+ */
+static uint8_t a_w25qxx_ts_get_range(w25qxx_ts_t *ts, uint32_t seq, uint32_t *min_ts, uint32_t *max_ts)
+{
+    uint8_t valid;
+    uint32_t s;
+    
+    ts->index_read++;                                                                      /* read++ */
+    if (a_w25qxx_ts_read_entry(ts, seq % ts->index_slot, &s, min_ts, max_ts, &valid) != 0) /* read entry */
+    {
+        return 1;                                                                          /* return error */
+    }
+    if ((valid == 0) || (s != seq))                                                        /* lost entry */
+    {
+        *min_ts = 0;                                                                       /* widest min */
+        *max_ts = W25QXX_TS_BLANK - 1;                                                     /* widest max */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     program the pending bytes of the head page
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 program failed
+ * @note      none
+ */
+static uint8_t a_w25qxx_ts_program_pending(w25qxx_ts_t *ts)
+{
+    uint32_t len;
+    
+    len = ts->offset - ts->flushed;                                           /* pending length */
+    if (len == 0)                                                             /* nothing pending */
+    {
+        return 0;                                                             /* success return 0 */
+    }
+    if (w25qxx_page_program(ts->handle, a_w25qxx_ts_sector_addr(ts, ts->seq) + ts->flushed,
+                            &ts->buf[ts->flushed % 256], (uint16_t)len) != 0) /* page program */
+    {
+        ts->handle->debug_print("w25qxx: page program failed.\n");            /* page program failed */
+        
+        return 1;                                                             /* return error */
+    }
+    ts->flushed = ts->offset;                                                 /* all programmed */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     seal the head sector
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 seal failed
+ * @note      the index entry is written after the last sample, an index sector is erased
+ *            when its first slot is reached
+ */
+static uint8_t a_w25qxx_ts_seal(w25qxx_ts_t *ts)
+{
+    uint32_t slot;
+    
+    if (a_w25qxx_ts_program_pending(ts) != 0)                                                      /* flush the head page */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    slot = ts->seq % ts->index_slot;                                                               /* get slot */
+    if ((slot % (W25QXX_TS_SECTOR_SIZE / W25QXX_TS_ENTRY_SIZE)) == 0)                              /* first slot of a sector */
+    {
+        if (w25qxx_sector_erase_4k(ts->handle, ts->index_addr + slot * W25QXX_TS_ENTRY_SIZE) != 0) /* sector erase */
+        {
+            ts->handle->debug_print("w25qxx: sector erase 4k failed.\n");                          /* sector erase 4k failed */
+            
+            return 1;                                                                              /* return error */
+        }
+    }
+    if (a_w25qxx_ts_write_block(ts, ts->index_addr + slot * W25QXX_TS_ENTRY_SIZE,
+                                ts->seq, ts->min_ts, ts->max_ts) != 0)                             /* write entry */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    ts->seq++;                                                                                     /* next sector */
+    ts->open = 0;                                                                                  /* not opened yet */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     open the head sector
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the oldest sector is erased and dropped
+ */
+static uint8_t a_w25qxx_ts_open(w25qxx_ts_t *ts)
+{
+    if (w25qxx_sector_erase_4k(ts->handle, a_w25qxx_ts_sector_addr(ts, ts->seq)) != 0) /* sector erase */
+    {
+        ts->handle->debug_print("w25qxx: sector erase 4k failed.\n");                  /* sector erase 4k failed */
+        
+        return 1;                                                                      /* return error */
+    }
+    if (ts->seq >= ts->sector_count)                                                   /* wrapped */
+    {
+        ts->tail_seq = ts->seq - ts->sector_count + 1;                                 /* drop the oldest sector */
+    }
+    if (a_w25qxx_ts_write_block(ts, a_w25qxx_ts_sector_addr(ts, ts->seq),
+                                W25QXX_TS_MAGIC, ts->seq, ~ts->seq) != 0)              /* write header */
+    {
+        return 1;                                                                      /* return error */
+    }
+    ts->offset = W25QXX_TS_HEADER_SIZE;                                                /* first sample */
+    ts->flushed = W25QXX_TS_HEADER_SIZE;                                               /* nothing pending */
+    ts->open = 1;                                                                      /* set open */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     get the crc of a sample record
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] *record pointer to a record buffer
+ * @return    crc
+ * @note      covers the timestamp and the sample data
+ */
+static uint32_t a_w25qxx_ts_record_crc(w25qxx_ts_t *ts, const uint8_t *record)
+{
+    uint32_t crc;
+    
+    crc = w25qxx_util_crc32(0xFFFFFFFFU, &record[0], 4);                              /* timestamp */
+    
+    return w25qxx_util_crc32(crc, &record[W25QXX_TS_RECORD_HEADER], ts->sample_size); /* sample data */
+}
+
+/**
+ * @brief      scan the samples of a data sector
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[in]  seq sector sequence
+ * @param[in]  limit scan end offset
+ * @param[in]  start first timestamp
+ * @param[in]  end last timestamp
+ * @param[in]  *callback pointer to a sample callback, NULL rebuilds the head state
+ * @param[in]  *arg pointer to a callback argument
+ * @param[out] *count pointer to a sample count buffer
+ * @param[out] *stop pointer to a stop flag buffer, set when a sample after end is seen
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       without callback the offset, min and max of the head sector are rebuilt,
+ *             a torn sample closes the head sector
+ */
+static uint8_t a_w25qxx_ts_scan(w25qxx_ts_t *ts, uint32_t seq, uint32_t limit, uint32_t start, uint32_t end,
+                                void (*callback)(uint32_t timestamp, uint8_t *data, uint16_t len, void *arg),
+                                void *arg, uint32_t *count, uint8_t *stop)
+{
+    uint32_t base;
+    uint32_t off;
+    uint32_t chunk;
+    uint32_t len;
+    uint32_t i;
+    uint32_t t;
+    uint8_t *p;
+    
+    base = a_w25qxx_ts_sector_addr(ts, seq);                                              /* get sector address */
+    chunk = (sizeof(ts->buf) / ts->record_len) * ts->record_len;                          /* whole records per read */
+    *stop = 0;                                                                            /* init 0 */
+    off = W25QXX_TS_HEADER_SIZE;                                                          /* first sample */
+    while (off + ts->record_len <= limit)                                                 /* loop all chunks */
+    {
+        len = limit - off;                                                                /* get remain */
+        len -= len % ts->record_len;                                                      /* whole records */
+        if (len > chunk)                                                                  /* check length */
+        {
+            len = chunk;                                                                  /* set length */
+        }
+        if (w25qxx_read(ts->handle, base + off, ts->buf, len) != 0)                       /* read chunk */
+        {
+            ts->handle->debug_print("w25qxx: read failed.\n");                            /* read failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        for (i = 0; i < len; i += ts->record_len)                                         /* loop all records */
+        {
+            p = &ts->buf[i];                                                              /* record pointer */
+            t = w25qxx_util_get32(&p[0]);                                                 /* get timestamp */
+            if ((t == W25QXX_TS_BLANK) && (w25qxx_util_get32(&p[4]) == W25QXX_TS_BLANK))  /* erased */
+            {
+                if (callback == NULL)                                                     /* rebuild the head */
+                {
+                    ts->offset = off + i;                                                 /* append here */
+                }
+                
+                return 0;                                                                 /* success return 0 */
+            }
+            if (w25qxx_util_get32(&p[4]) != a_w25qxx_ts_record_crc(ts, p))                /* torn sample */
+            {
+                if (callback == NULL)                                                     /* rebuild the head */
+                {
+                    ts->offset = W25QXX_TS_SECTOR_SIZE;                                   /* close the sector */
+                    
+                    return 0;                                                             /* success return 0 */
+                }
+                
+                continue;                                                                 /* skip the sample */
+            }
+            if (callback == NULL)                                                         /* rebuild the head */
+            {
+                if (ts->offset == W25QXX_TS_HEADER_SIZE)                                  /* first sample */
+                {
+                    ts->min_ts = t;                                                       /* set min */
+                }
+                ts->max_ts = t;                                                           /* set max */
+                ts->offset = off + i + ts->record_len;                                    /* after this sample */
+            }
+            else if (t > end)                                                             /* after the range */
+            {
+                *stop = 1;                                                                /* stop the query */
+                
+                return 0;                                                                 /* success return 0 */
+            }
+            else if (t >= start)                                                          /* inside the range */
+            {
+                callback(t, &p[W25QXX_TS_RECORD_HEADER], (uint16_t)ts->sample_size, arg); /* run the callback */
+                (*count)++;                                                               /* count++ */
+            }
+        }
+        off += len;                                                                       /* next chunk */
+    }
+    if (callback == NULL)                                                                 /* rebuild the head */
+    {
+        ts->offset = W25QXX_TS_SECTOR_SIZE;                                               /* sector is full */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     initialize the time series store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] index_addr index region address
+ * @param[in] index_len index region length
+ * @param[in] data_addr data region address
+ * @param[in] data_len data region length
+ * @param[in] sample_size sample data size
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 sample size is invalid
+ * @note      regions must be 4k aligned and must not overlap,
+ *            index_len must be at least W25QXX_TS_INDEX_LEN(data_len)
+ */
+uint8_t w25qxx_ts_init(w25qxx_ts_t *ts, w25qxx_handle_t *handle, uint32_t index_addr, uint32_t index_len,
+                       uint32_t data_addr, uint32_t data_len, uint32_t sample_size)
+{
+    if ((ts == NULL) || (handle == NULL))                                                      /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (((index_addr % W25QXX_TS_SECTOR_SIZE) != 0) || ((data_addr % W25QXX_TS_SECTOR_SIZE) != 0) ||
+        ((index_addr < data_addr + data_len) && (data_addr < index_addr + index_len)))         /* check addr */
+    {
+        handle->debug_print("w25qxx: addr is invalid.\n");                                     /* addr is invalid */
+        
+        return 4;                                                                              /* return error */
+    }
+    if (((index_len % W25QXX_TS_SECTOR_SIZE) != 0) || ((data_len % W25QXX_TS_SECTOR_SIZE) != 0) ||
+        (data_len < 2 * W25QXX_TS_SECTOR_SIZE) || (index_len < W25QXX_TS_INDEX_LEN(data_len))) /* check len */
+    {
+        handle->debug_print("w25qxx: len is invalid.\n");                                      /* len is invalid */
+        
+        return 5;                                                                              /* return error */
+    }
+    if ((sample_size == 0) || (sample_size > W25QXX_TS_SAMPLE_MAX))                            /* check sample size */
+    {
+        handle->debug_print("w25qxx: sample size is invalid.\n");                              /* sample size is invalid */
+        
+        return 6;                                                                              /* return error */
+    }
+    
+    memset(ts, 0, sizeof(w25qxx_ts_t));                                                        /* clear ts */
+    ts->handle = handle;                                                                       /* set handle */
+    ts->index_addr = index_addr;                                                               /* set index addr */
+    ts->index_slot = index_len / W25QXX_TS_ENTRY_SIZE;                                         /* set index slots */
+    ts->data_addr = data_addr;                                                                 /* set data addr */
+    ts->sector_count = data_len / W25QXX_TS_SECTOR_SIZE;                                       /* set sector count */
+    ts->sample_size = sample_size;                                                             /* set sample size */
+    ts->record_len = (W25QXX_TS_RECORD_HEADER + sample_size + 3U) & ~3U;                       /* set record length */
+    ts->inited = 1;                                                                            /* set inited */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     deinit the time series store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      pending samples are not flushed
+ */
+uint8_t w25qxx_ts_deinit(w25qxx_ts_t *ts)
+{
+    if (ts == NULL)      /* check handle */
+    {
+        return 2;        /* return error */
+    }
+    if (ts->inited != 1) /* check handle initialization */
+    {
+        return 3;        /* return error */
+    }
+    
+    ts->mounted = 0;     /* clear mounted */
+    ts->inited = 0;      /* clear inited */
+    
+    return 0;            /* success return 0 */
+}
+
+/**
+ * @brief     erase both regions and start an empty store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ts_format(w25qxx_ts_t *ts)
+{
+    if (ts == NULL)                                                                                /* check handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (ts->inited != 1)                                                                           /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    
+    ts->mounted = 0;                                                                               /* clear mounted */
+    if (a_w25qxx_ts_erase_range(ts, ts->index_addr, ts->index_slot * W25QXX_TS_ENTRY_SIZE) != 0)   /* erase index */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    if (a_w25qxx_ts_erase_range(ts, ts->data_addr, ts->sector_count * W25QXX_TS_SECTOR_SIZE) != 0) /* erase data */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    ts->seq = 0;                                                                                   /* first sector */
+    ts->tail_seq = 0;                                                                              /* set tail */
+    ts->last_ts = 0;                                                                               /* no sample */
+    if (a_w25qxx_ts_write_block(ts, ts->data_addr, W25QXX_TS_MAGIC, 0, ~0U) != 0)                  /* write header */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    ts->offset = W25QXX_TS_HEADER_SIZE;                                                            /* first sample */
+    ts->flushed = W25QXX_TS_HEADER_SIZE;                                                           /* nothing pending */
+    ts->open = 1;                                                                                  /* set open */
+    ts->mounted = 1;                                                                               /* set mounted */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     mount the time series store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 no valid store
+ * @note      the last index entry is found by a binary search, only the head data sector is scanned
+ */
+uint8_t w25qxx_ts_mount(w25qxx_ts_t *ts)
+{
+    uint8_t valid;
+    uint8_t next;
+    uint8_t stop;
+    uint32_t seq;
+    uint32_t min_ts;
+    uint32_t max_ts;
+    uint32_t last_max;
+    uint32_t lap;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    uint32_t count;
+    
+    if (ts == NULL)                                                                                     /* check handle */
+    {
+        return 2;                                                                                       /* return error */
+    }
+    if (ts->inited != 1)                                                                                /* check handle initialization */
+    {
+        return 3;                                                                                       /* return error */
+    }
+    
+    ts->mounted = 0;                                                                                    /* clear mounted */
+    lo = 0;                                                                                             /* first slot */
+    if (a_w25qxx_ts_read_entry(ts, 0, &seq, &min_ts, &max_ts, &valid) != 0)                             /* read slot 0 */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    if (valid == 0)                                                                                     /* index sector 0 just erased */
+    {
+        lo = W25QXX_TS_SECTOR_SIZE / W25QXX_TS_ENTRY_SIZE;                                              /* first slot of sector 1 */
+        if (a_w25qxx_ts_read_entry(ts, lo, &seq, &min_ts, &max_ts, &valid) != 0)                        /* read slot */
+        {
+            return 1;                                                                                   /* return error */
+        }
+    }
+    if (valid != 0)                                                                                     /* index has entries */
+    {
+        lap = seq - lo;                                                                                 /* sequence of slot 0 in this lap */
+        last_max = max_ts;                                                                              /* init max */
+        hi = ts->index_slot - 1;                                                                        /* last slot */
+        while (lo < hi)                                                                                 /* find the last entry of the lap */
+        {
+            mid = lo + (hi - lo + 1) / 2;                                                               /* get middle */
+            if (a_w25qxx_ts_read_entry(ts, mid, &seq, &min_ts, &max_ts, &valid) != 0)                   /* read entry */
+            {
+                return 1;                                                                               /* return error */
+            }
+            if ((valid != 0) && (seq - mid == lap))                                                     /* same lap */
+            {
+                lo = mid;                                                                               /* search upper half */
+                last_max = max_ts;                                                                      /* save max */
+            }
+            else
+            {
+                hi = mid - 1;                                                                           /* search lower half */
+            }
+        }
+        ts->seq = lap + lo + 1;                                                                         /* sector after the last sealed */
+        ts->last_ts = last_max;                                                                         /* last timestamp */
+    }
+    else
+    {
+        ts->seq = 0;                                                                                    /* first sector */
+        ts->last_ts = 0;                                                                                /* no sample */
+    }
+    if (a_w25qxx_ts_check_header(ts, ts->seq, &valid) != 0)                                             /* check head header */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    while (valid != 0)                                                                                  /* skip sectors whose index entry was lost */
+    {
+        if (a_w25qxx_ts_check_header(ts, ts->seq + 1, &next) != 0)                                      /* check next header */
+        {
+            return 1;                                                                                   /* return error */
+        }
+        if (next == 0)                                                                                  /* head found */
+        {
+            break;                                                                                      /* break */
+        }
+        ts->seq++;                                                                                      /* next sector */
+    }
+    ts->tail_seq = (ts->seq >= ts->sector_count - 1) ? (ts->seq - (ts->sector_count - 1)) : 0;          /* oldest sector */
+    
+    ts->open = 0;                                                                                       /* opened by the next append */
+    if (valid != 0)                                                                                     /* head is open */
+    {
+        ts->offset = W25QXX_TS_HEADER_SIZE;                                                             /* first sample */
+        if (a_w25qxx_ts_scan(ts, ts->seq, W25QXX_TS_SECTOR_SIZE, 0, 0, NULL, NULL, &count, &stop) != 0) /* rebuild the head */
+        {
+            return 1;                                                                                   /* return error */
+        }
+        ts->flushed = ts->offset;                                                                       /* all programmed */
+        ts->open = 1;                                                                                   /* set open */
+        if (ts->offset > W25QXX_TS_HEADER_SIZE)                                                         /* head has samples */
+        {
+            ts->last_ts = ts->max_ts;                                                                   /* last timestamp */
+        }
+        if (ts->offset + ts->record_len > W25QXX_TS_SECTOR_SIZE)                                        /* full but not indexed */
+        {
+            if (a_w25qxx_ts_seal(ts) != 0)                                                              /* seal it */
+            {
+                return 1;                                                                               /* return error */
+            }
+        }
+    }
+    else if (ts->seq == 0)                                                                              /* nothing written */
+    {
+        ts->handle->debug_print("w25qxx: no valid store.\n");                                           /* no valid store */
+        
+        return 5;                                                                                       /* return error */
+    }
+    ts->mounted = 1;                                                                                    /* set mounted */
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     check the handle
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      none
+ */
+static uint8_t a_w25qxx_ts_check(w25qxx_ts_t *ts)
+{
+    if (ts == NULL)       /* check handle */
+    {
+        return 2;         /* return error */
+    }
+    if (ts->inited != 1)  /* check handle initialization */
+    {
+        return 3;         /* return error */
+    }
+    if (ts->mounted != 1) /* check mounted */
+    {
+        return 4;         /* return error */
+    }
+    
+    return 0;             /* success return 0 */
+}
+
+/**
+ * @brief     append a sample
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] timestamp sample timestamp
+ * @param[in] *data pointer to a sample_size bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 timestamp is invalid
+ * @note      timestamps must not decrease and 0xFFFFFFFF is reserved,
+ *            samples are packed in ram and programmed one page at a time
+ */
+uint8_t w25qxx_ts_append(w25qxx_ts_t *ts, uint32_t timestamp, const uint8_t *data)
+{
+    uint8_t res;
+    uint8_t record[W25QXX_TS_RECORD_HEADER + W25QXX_TS_SAMPLE_MAX + 3];
+    uint32_t pos;
+    uint32_t len;
+    
+    res = a_w25qxx_ts_check(ts);                                                  /* check handle */
+    if (res != 0)                                                                 /* check result */
+    {
+        return res;                                                               /* return error */
+    }
+    if ((timestamp == W25QXX_TS_BLANK) || (timestamp < ts->last_ts))              /* check timestamp */
+    {
+        ts->handle->debug_print("w25qxx: timestamp is invalid.\n");               /* timestamp is invalid */
+        
+        return 5;                                                                 /* return error */
+    }
+    
+    if ((ts->open != 0) && (ts->offset + ts->record_len > W25QXX_TS_SECTOR_SIZE)) /* head is full */
+    {
+        if (a_w25qxx_ts_seal(ts) != 0)                                            /* seal it */
+        {
+            return 1;                                                             /* return error */
+        }
+    }
+    if (ts->open == 0)                                                            /* no head sector */
+    {
+        if (a_w25qxx_ts_open(ts) != 0)                                            /* open it */
+        {
+            return 1;                                                             /* return error */
+        }
+    }
+    memset(record, 0xFF, ts->record_len);                                         /* pad */
+    w25qxx_util_put32(&record[0], timestamp);                                     /* set timestamp */
+    memcpy(&record[W25QXX_TS_RECORD_HEADER], data, ts->sample_size);              /* set data */
+    w25qxx_util_put32(&record[4], a_w25qxx_ts_record_crc(ts, record));            /* set crc */
+    pos = 0;                                                                      /* init 0 */
+    while (pos < ts->record_len)                                                  /* stage into the page buffer */
+    {
+        len = 256 - (ts->offset % 256);                                           /* get page remain */
+        if (len > ts->record_len - pos)                                           /* check length */
+        {
+            len = ts->record_len - pos;                                           /* set length */
+        }
+        memcpy(&ts->buf[ts->offset % 256], &record[pos], len);                    /* copy record */
+        ts->offset += len;                                                        /* offset + length */
+        pos += len;                                                               /* position + length */
+        if ((ts->offset % 256) == 0)                                              /* page is complete */
+        {
+            if (a_w25qxx_ts_program_pending(ts) != 0)                             /* program it */
+            {
+                ts->offset = W25QXX_TS_SECTOR_SIZE;                               /* close the sector */
+                ts->flushed = ts->offset;                                         /* drop the failed page */
+                
+                return 1;                                                         /* return error */
+            }
+        }
+    }
+    if (ts->offset == W25QXX_TS_HEADER_SIZE + ts->record_len)                     /* first sample */
+    {
+        ts->min_ts = timestamp;                                                   /* set min */
+    }
+    ts->max_ts = timestamp;                                                       /* set max */
+    ts->last_ts = timestamp;                                                      /* set last */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     program the pending samples
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      the rest of a partly programmed page is programmed by later flushes
+ */
+uint8_t w25qxx_ts_flush(w25qxx_ts_t *ts)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ts_check(ts);            /* check handle */
+    if (res != 0)                           /* check result */
+    {
+        return res;                         /* return error */
+    }
+    if (ts->open == 0)                      /* nothing to flush */
+    {
+        return 0;                           /* success return 0 */
+    }
+    
+    return a_w25qxx_ts_program_pending(ts); /* program pending bytes */
+}
+
+/**
+ * @brief      query the samples inside a time range
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[in]  start first timestamp
+ * @param[in]  end last timestamp
+ * @param[in]  *callback pointer to a sample callback
+ * @param[in]  *arg pointer to a callback argument
+ * @param[out] *count pointer to a sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 query failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 range is invalid
+ * @note       pending samples are flushed first, the index is binary searched for the first sector
+ *             and only sectors whose min/max range overlaps [start, end] are read
+ */
+uint8_t w25qxx_ts_query(w25qxx_ts_t *ts, uint32_t start, uint32_t end,
+                        void (*callback)(uint32_t timestamp, uint8_t *data, uint16_t len, void *arg),
+                        void *arg, uint32_t *count)
+{
+    uint8_t res;
+    uint8_t stop;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    uint32_t min_ts;
+    uint32_t max_ts;
+    
+    res = a_w25qxx_ts_check(ts);                                                                           /* check handle */
+    if (res != 0)                                                                                          /* check result */
+    {
+        return res;                                                                                        /* return error */
+    }
+    if ((start > end) || (callback == NULL) || (count == NULL))                                            /* check range */
+    {
+        ts->handle->debug_print("w25qxx: range is invalid.\n");                                            /* range is invalid */
+        
+        return 5;                                                                                          /* return error */
+    }
+    
+    *count = 0;                                                                                            /* init 0 */
+    ts->sector_read = 0;                                                                                   /* clear reads */
+    ts->index_read = 0;                                                                                    /* clear reads */
+    if (ts->open != 0)                                                                                     /* head is open */
+    {
+        if (a_w25qxx_ts_program_pending(ts) != 0)                                                          /* flush */
+        {
+            return 1;                                                                                      /* return error */
+        }
+    }
+    lo = ts->tail_seq;                                                                                     /* oldest sealed sector */
+    hi = ts->seq;                                                                                          /* after the newest sealed sector */
+    while (lo < hi)                                                                                        /* first sector with max >= start */
+    {
+        mid = lo + (hi - lo) / 2;                                                                          /* get middle */
+        if (a_w25qxx_ts_get_range(ts, mid, &min_ts, &max_ts) != 0)                                         /* get range */
+        {
+            return 1;                                                                                      /* return error */
+        }
+        if (max_ts < start)                                                                                /* before the range */
+        {
+            lo = mid + 1;                                                                                  /* search upper half */
+        }
+        else
+        {
+            hi = mid;                                                                                      /* search lower half */
+        }
+    }
+    for (; lo < ts->seq; lo++)                                                                             /* walk sealed sectors */
+    {
+        if (a_w25qxx_ts_get_range(ts, lo, &min_ts, &max_ts) != 0)                                          /* get range */
+        {
+            return 1;                                                                                      /* return error */
+        }
+        if (min_ts > end)                                                                                  /* after the range */
+        {
+            return 0;                                                                                      /* success return 0 */
+        }
+        ts->sector_read++;                                                                                 /* read++ */
+        if (a_w25qxx_ts_scan(ts, lo, W25QXX_TS_SECTOR_SIZE, start, end, callback, arg, count, &stop) != 0) /* scan sector */
+        {
+            return 1;                                                                                      /* return error */
+        }
+        if (stop != 0)                                                                                     /* after the range */
+        {
+            return 0;                                                                                      /* success return 0 */
+        }
+    }
+    if ((ts->open != 0) && (ts->offset > W25QXX_TS_HEADER_SIZE) &&
+        (ts->max_ts >= start) && (ts->min_ts <= end))                                                      /* head overlaps */
+    {
+        ts->sector_read++;                                                                                 /* read++ */
+        if (a_w25qxx_ts_scan(ts, ts->seq, ts->offset, start, end, callback, arg, count, &stop) != 0)       /* scan head */
+        {
+            return 1;                                                                                      /* return error */
+        }
+    }
+    
+    return 0;                                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the store info
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[out] *info pointer to a w25qxx ts info structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_ts_get_info(w25qxx_ts_t *ts, w25qxx_ts_info_t *info)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_ts_check(ts);         /* check handle */
+    if (res != 0)                        /* check result */
+    {
+        return res;                      /* return error */
+    }
+    
+    info->head_seq = ts->seq;            /* set head */
+    info->tail_seq = ts->tail_seq;       /* set tail */
+    info->first_timestamp = ts->min_ts;  /* set first */
+    info->last_timestamp = ts->last_ts;  /* set last */
+    info->sector_read = ts->sector_read; /* set sector reads */
+    info->index_read = ts->index_read;   /* set index reads */
+    
+    return 0;                            /* success return 0 */
+}
@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_ts.h
+ * @brief     driver w25qxx ts header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_TS_H
+#define DRIVER_W25QXX_TS_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_ts_driver w25qxx ts driver function
+ * @brief    w25qxx time series store modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx ts max sample size definition
+ */
+#define W25QXX_TS_SAMPLE_MAX        248U        /**< one sample record fits a page */
+
+/**
+ * @brief     index region length definition
+ * @param[in] DATA_LEN data region length
+ * @note      one 16 bytes entry per data sector plus one spare index sector
+ */
+#define W25QXX_TS_INDEX_LEN(DATA_LEN)   (((((DATA_LEN) / 4096U) + 255U) / 256U + 1U) * 4096U)
+
+/**
+ * @brief w25qxx ts info structure definition
+ */
+typedef struct w25qxx_ts_info_s
+{
+    uint32_t head_seq;              /**< sequence of the sector being appended */
+    uint32_t tail_seq;              /**< sequence of the oldest sector */
+    uint32_t first_timestamp;       /**< first timestamp of the head sector */
+    uint32_t last_timestamp;        /**< last appended timestamp */
+    uint32_t sector_read;           /**< data sectors read by the last query */
+    uint32_t index_read;            /**< index entries read by the last query */
+} w25qxx_ts_info_t;
+
+/**
+ * @brief w25qxx ts structure definition
+ */
+typedef struct w25qxx_ts_s
+{
+    w25qxx_handle_t *handle;         /**< w25qxx handle */
+    uint32_t index_addr;             /**< index region address */
+    uint32_t index_slot;             /**< index entries */
+    uint32_t data_addr;              /**< data region address */
+    uint32_t sector_count;           /**< data sectors */
+    uint32_t sample_size;            /**< sample data size */
+    uint32_t record_len;             /**< sample record length */
+    uint32_t seq;                    /**< head sector sequence */
+    uint32_t tail_seq;               /**< oldest sector sequence */
+    uint32_t offset;                 /**< append offset inside the head sector */
+    uint32_t flushed;                /**< programmed offset inside the head sector */
+    uint32_t min_ts;                 /**< first timestamp of the head sector */
+    uint32_t max_ts;                 /**< last timestamp of the head sector */
+    uint32_t last_ts;                /**< last appended timestamp */
+    uint32_t sector_read;            /**< data sectors read by the last query */
+    uint32_t index_read;             /**< index entries read by the last query */
+    uint8_t buf[256];                /**< page buffer */
+    uint8_t open;                    /**< head sector is open */
+    uint8_t mounted;                 /**< mounted flag */
+    uint8_t inited;                  /**< inited flag */
+} w25qxx_ts_t;
+
+/**
+ * @brief     initialize the time series store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] index_addr index region address
+ * @param[in] index_len index region length
+ * @param[in] data_addr data region address
+ * @param[in] data_len data region length
+ * @param[in] sample_size sample data size
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 len is invalid
+ *            - 6 sample size is invalid
+ * @note      regions must be 4k aligned and must not overlap,
+ *            index_len must be at least W25QXX_TS_INDEX_LEN(data_len)
+ */
+uint8_t w25qxx_ts_init(w25qxx_ts_t *ts, w25qxx_handle_t *handle, uint32_t index_addr, uint32_t index_len,
+                       uint32_t data_addr, uint32_t data_len, uint32_t sample_size);
+
+/**
+ * @brief     deinit the time series store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      pending samples are not flushed
+ */
+uint8_t w25qxx_ts_deinit(w25qxx_ts_t *ts);
+
+/**
+ * @brief     erase both regions and start an empty store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 format failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_ts_format(w25qxx_ts_t *ts);
+
+/**
+ * @brief     mount the time series store
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 mount failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 no valid store
+ * @note      the last index entry is found by a binary search, only the head data sector is scanned
+ */
+uint8_t w25qxx_ts_mount(w25qxx_ts_t *ts);
+
+/**
+ * @brief     append a sample
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @param[in] timestamp sample timestamp
+ * @param[in] *data pointer to a sample_size bytes buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 append failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ *            - 5 timestamp is invalid
+ * @note      timestamps must not decrease and 0xFFFFFFFF is reserved,
+ *            samples are packed in ram and programmed one page at a time
+ */
+uint8_t w25qxx_ts_append(w25qxx_ts_t *ts, uint32_t timestamp, const uint8_t *data);
+
+/**
+ * @brief     program the pending samples
+ * @param[in] *ts pointer to a w25qxx ts structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 not mounted
+ * @note      the rest of a partly programmed page is programmed by later flushes
+ */
+uint8_t w25qxx_ts_flush(w25qxx_ts_t *ts);
+
+/**
+ * @brief      query the samples inside a time range
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[in]  start first timestamp
+ * @param[in]  end last timestamp
+ * @param[in]  *callback pointer to a sample callback
+ * @param[in]  *arg pointer to a callback argument
+ * @param[out] *count pointer to a sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 query failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ *             - 5 range is invalid
+ * @note       pending samples are flushed first, the index is binary searched for the first sector
+ *             and only sectors whose min/max range overlaps [start, end] are read
+ */
+uint8_t w25qxx_ts_query(w25qxx_ts_t *ts, uint32_t start, uint32_t end,
+                        void (*callback)(uint32_t timestamp, uint8_t *data, uint16_t len, void *arg),
+                        void *arg, uint32_t *count);
+
+/**
+ * @brief      get the store info
+ * @param[in]  *ts pointer to a w25qxx ts structure
+ * @param[out] *info pointer to a w25qxx ts info structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 not mounted
+ * @note       none
+ */
+uint8_t w25qxx_ts_get_info(w25qxx_ts_t *ts, w25qxx_ts_info_t *info);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_util.c
+ * @brief     driver w25qxx util source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief     crc32 update
+ * @param[in] crc current crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    updated crc
+ * @note      reflected polynomial 0xEDB88320
+ */
+uint32_t w25qxx_util_crc32(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint8_t j;
+    
+    for (i = 0; i < len; i++)                                     /* loop all bytes */
+    {
+        crc ^= buf[i];                                            /* xor byte */
+        for (j = 0; j < 8; j++)                                   /* loop all bits */
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U))); /* shift */
+        }
+    }
+    
+    return crc;                                                   /* return crc */
+}
+
+/**
+ * @brief     put a little endian uint32
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] value set value
+ * @note      none
+ */
+void w25qxx_util_put32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)(value >> 0);  /* set byte 0 */
+    buf[1] = (uint8_t)(value >> 8);  /* set byte 1 */
+    buf[2] = (uint8_t)(value >> 16); /* set byte 2 */
+    buf[3] = (uint8_t)(value >> 24); /* set byte 3 */
+}
+
+/**
+ * @brief     get a little endian uint32
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+uint32_t w25qxx_util_get32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+           ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24); /* return value */
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_util.h
+ * @brief     driver w25qxx util header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_UTIL_H
+#define DRIVER_W25QXX_UTIL_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_util_driver w25qxx util driver function
+ * @brief    w25qxx crc and byte order helpers shared by the storage modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief     crc32 update
+ * @param[in] crc current crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    updated crc
+ * @note      reflected polynomial 0xEDB88320
+ */
+uint32_t w25qxx_util_crc32(uint32_t crc, const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief     put a little endian uint32
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] value set value
+ * @note      none
+ */
+void w25qxx_util_put32(uint8_t *buf, uint32_t value);
+
+/**
+ * @brief     get a little endian uint32
+ * @param[in] *buf pointer to a data buffer
+ * @return    value
+ * @note      none
+ */
+uint32_t w25qxx_util_get32(const uint8_t *buf);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,554 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_wb.c
+ * @brief     driver w25qxx wb source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_wb.h"
+
+/**
+ * @brief      flush one line
+ * @param[in]  *wb pointer to a w25qxx wb structure
+ * @param[in]  *line pointer to a w25qxx wb line structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 flush failed
+ * @note       dirty pages are programmed in place when they only clear bits,
+ *             otherwise the sector is erased and its non blank pages are programmed
+ */
+static uint8_t a_w25qxx_wb_flush_line(w25qxx_wb_t *wb, w25qxx_wb_line_t *line)
+{
+    uint8_t erase;
+    uint32_t base;
+    uint32_t i;
+    uint32_t j;
+    uint8_t *p;
+    uint16_t program;
+    
+    if ((line->valid == 0) || (line->dirty_page == 0))                                      /* clean line */
+    {
+        return 0;                                                                           /* success return 0 */
+    }
+    
+    base = line->sector * 4096;                                                             /* get sector address */
+    erase = 0;                                                                              /* init 0 */
+    program = 0;                                                                            /* init 0 */
+    for (i = 0; i < 16; i++)                                                                /* check all dirty pages */
+    {
+        if ((line->dirty_page & (1 << i)) == 0)                                             /* clean page */
+        {
+            continue;                                                                       /* continue */
+        }
+        if (w25qxx_read(wb->handle, base + i * 256, wb->page, 256) != 0)                    /* read the flash page */
+        {
+            wb->handle->debug_print("w25qxx: read failed.\n");                              /* read failed */
+            
+            return 1;                                                                       /* return error */
+        }
+        p = &line->buf[i * 256];                                                            /* page pointer */
+        for (j = 0; j < 256; j++)                                                           /* compare bytes */
+        {
+            if ((p[j] & (uint8_t)~wb->page[j]) != 0)                                        /* a bit must go back to 1 */
+            {
+                erase = 1;                                                                  /* need erase */
+                
+                break;                                                                      /* break */
+            }
+        }
+        if (erase != 0)                                                                     /* need erase */
+        {
+            break;                                                                          /* break */
+        }
+        if (memcmp(p, wb->page, 256) != 0)                                                  /* page changed */
+        {
+            program |= (uint16_t)(1 << i);                                                  /* program in place */
+        }
+    }
+    if (erase != 0)                                                                         /* rewrite the sector */
+    {
+        if (w25qxx_sector_erase_4k(wb->handle, base) != 0)                                  /* sector erase */
+        {
+            wb->handle->debug_print("w25qxx: sector erase 4k failed.\n");                   /* sector erase 4k failed */
+            
+            return 1;                                                                       /* return error */
+        }
+        wb->stats.erase++;                                                                  /* erase++ */
+        program = 0;                                                                        /* init 0 */
+        for (i = 0; i < 16; i++)                                                            /* find non blank pages */
+        {
+            p = &line->buf[i * 256];                                                        /* page pointer */
+            for (j = 0; j < 256; j++)                                                       /* check bytes */
+            {
+                if (p[j] != 0xFF)                                                           /* not blank */
+                {
+                    program |= (uint16_t)(1 << i);                                          /* program it */
+                    
+                    break;                                                                  /* break */
+                }
+            }
+        }
+    }
+    for (i = 0; i < 16; i++)                                                                /* program pages */
+    {
+        if ((program & (1 << i)) == 0)                                                      /* skip page */
+        {
+            continue;                                                                       /* continue */
+        }
+        if (w25qxx_page_program(wb->handle, base + i * 256, &line->buf[i * 256], 256) != 0) /* page program */
+        {
+            wb->handle->debug_print("w25qxx: page program failed.\n");                      /* page program failed */
+            
+            return 1;                                                                       /* return error */
+        }
+        wb->stats.page_program++;                                                           /* page program++ */
+    }
+    line->dirty_page = 0;                                                                   /* clean */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     find the line of a sector
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @param[in] sector sector index
+ * @return    pointer to the line, NULL when the sector is not buffered
+ * @note      none
+ */
+static w25qxx_wb_line_t *a_w25qxx_wb_find(w25qxx_wb_t *wb, uint32_t sector)
+{
+    uint32_t i;
+    
+    for (i = 0; i < wb->line_count; i++)                                /* loop all lines */
+    {
+        if ((wb->line[i].valid != 0) && (wb->line[i].sector == sector)) /* found */
+        {
+            wb->line[i].age = ++wb->age;                                /* touch */
+            
+            return &wb->line[i];                                        /* return line */
+        }
+    }
+    
+    return NULL;                                                        /* not found */
+}
+
+/**
+ * @brief      get a line for a sector
+ * @param[in]  *wb pointer to a w25qxx wb structure
+ * @param[in]  sector sector index
+ * @param[in]  load bool value, read the sector into the line
+ * @param[out] **line pointer to a line pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       a free line is used first, then the least recently used one
+ */
+static uint8_t a_w25qxx_wb_alloc(w25qxx_wb_t *wb, uint32_t sector, uint8_t load, w25qxx_wb_line_t **line)
+{
+    uint32_t i;
+    w25qxx_wb_line_t *victim;
+    
+    victim = &wb->line[0];                                                  /* init the first line */
+    for (i = 0; i < wb->line_count; i++)                                    /* loop all lines */
+    {
+        if (wb->line[i].valid == 0)                                         /* free line */
+        {
+            victim = &wb->line[i];                                          /* use it */
+            
+            break;                                                          /* break */
+        }
+        if ((int32_t)(wb->line[i].age - victim->age) < 0)                   /* older */
+        {
+            victim = &wb->line[i];                                          /* set victim */
+        }
+    }
+    if ((victim->valid != 0) && (victim->dirty_page != 0))                  /* dirty victim */
+    {
+        if (a_w25qxx_wb_flush_line(wb, victim) != 0)                        /* flush it */
+        {
+            return 1;                                                       /* return error */
+        }
+        wb->stats.evict++;                                                  /* evict++ */
+    }
+    victim->valid = 0;                                                      /* invalid during load */
+    if (load != 0)                                                          /* partial write */
+    {
+        if (w25qxx_read(wb->handle, sector * 4096, victim->buf, 4096) != 0) /* read the sector */
+        {
+            wb->handle->debug_print("w25qxx: read failed.\n");              /* read failed */
+            
+            return 1;                                                       /* return error */
+        }
+    }
+    victim->sector = sector;                                                /* set sector */
+    victim->dirty_page = 0;                                                 /* clean */
+    victim->age = ++wb->age;                                                /* touch */
+    victim->valid = 1;                                                      /* set valid */
+    *line = victim;                                                         /* set line */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     check the handle
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+static uint8_t a_w25qxx_wb_check(w25qxx_wb_t *wb)
+{
+    if (wb == NULL)      /* check handle */
+    {
+        return 2;        /* return error */
+    }
+    if (wb->inited != 1) /* check handle initialization */
+    {
+        return 3;        /* return error */
+    }
+    
+    return 0;            /* success return 0 */
+}
+
+/**
+ * @brief     initialize the write back buffer
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] *line pointer to a line array
+ * @param[in] line_count line count
+ * @param[in] timeout_ms dirty line lifetime, 0 disables the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 line count is invalid
+ * @note      every line buffers one 4k sector, flush before writing or erasing
+ *            the same range directly through the handle
+ */
+uint8_t w25qxx_wb_init(w25qxx_wb_t *wb, w25qxx_handle_t *handle, w25qxx_wb_line_t *line,
+                       uint32_t line_count, uint32_t timeout_ms)
+{
+    uint32_t i;
+    
+    if ((wb == NULL) || (handle == NULL) || (line == NULL))      /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    if (handle->inited != 1)                                     /* check handle initialization */
+    {
+        return 3;                                                /* return error */
+    }
+    if (line_count == 0)                                         /* check line count */
+    {
+        handle->debug_print("w25qxx: line count is invalid.\n"); /* line count is invalid */
+        
+        return 4;                                                /* return error */
+    }
+    
+    memset(wb, 0, sizeof(w25qxx_wb_t));                          /* clear wb */
+    wb->handle = handle;                                         /* set handle */
+    wb->line = line;                                             /* set line */
+    wb->line_count = line_count;                                 /* set line count */
+    wb->timeout_ms = timeout_ms;                                 /* set timeout */
+    for (i = 0; i < line_count; i++)                             /* loop all lines */
+    {
+        line[i].valid = 0;                                       /* free */
+        line[i].dirty_page = 0;                                  /* clean */
+    }
+    wb->inited = 1;                                              /* set inited */
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief     flush and deinit the write back buffer
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_wb_deinit(w25qxx_wb_t *wb)
+{
+    uint8_t res;
+    
+    res = w25qxx_wb_flush(wb); /* flush */
+    if (res != 0)              /* check result */
+    {
+        return res;            /* return error */
+    }
+    
+    wb->inited = 0;            /* clear inited */
+    
+    return 0;                  /* success return 0 */
+}
+
+/**
+ * @brief     write data through the buffer
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @param[in] addr written address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the least recently used line is flushed when a new sector needs a line
+ */
+uint8_t w25qxx_wb_write(w25qxx_wb_t *wb, uint32_t addr, const uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint32_t off;
+    uint32_t remain;
+    uint32_t page;
+    w25qxx_wb_line_t *line;
+    
+    res = a_w25qxx_wb_check(wb);                                                           /* check handle */
+    if (res != 0)                                                                          /* check result */
+    {
+        return res;                                                                        /* return error */
+    }
+    
+    wb->stats.write_bytes += len;                                                          /* write bytes */
+    while (len != 0)                                                                       /* loop all sectors */
+    {
+        off = addr % 4096;                                                                 /* get sector offset */
+        remain = 4096 - off;                                                               /* get sector remain */
+        if (remain > len)                                                                  /* check length */
+        {
+            remain = len;                                                                  /* set length */
+        }
+        line = a_w25qxx_wb_find(wb, addr / 4096);                                          /* find the sector */
+        if (line != NULL)                                                                  /* buffered */
+        {
+            wb->stats.write_hit++;                                                         /* hit++ */
+        }
+        else
+        {
+            if (a_w25qxx_wb_alloc(wb, addr / 4096, (uint8_t)(remain != 4096), &line) != 0) /* get a line */
+            {
+                return 1;                                                                  /* return error */
+            }
+        }
+        if (line->dirty_page == 0)                                                         /* first dirty write */
+        {
+            line->dirty_ms = wb->now_ms;                                                   /* stamp */
+        }
+        memcpy(&line->buf[off], data, remain);                                             /* merge data */
+        for (page = off / 256; page <= (off + remain - 1) / 256; page++)                   /* mark pages */
+        {
+            line->dirty_page |= (uint16_t)(1 << page);                                     /* set dirty */
+        }
+        addr += remain;                                                                    /* address + remain */
+        data += remain;                                                                    /* data + remain */
+        len -= remain;                                                                     /* length - remain */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      read data through the buffer
+ * @param[in]  *wb pointer to a w25qxx wb structure
+ * @param[in]  addr read address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       buffered sectors are served from ram, so unflushed data is returned
+ */
+uint8_t w25qxx_wb_read(w25qxx_wb_t *wb, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    uint8_t res;
+    uint32_t off;
+    uint32_t remain;
+    uint32_t run;
+    w25qxx_wb_line_t *line;
+    
+    res = a_w25qxx_wb_check(wb);                                               /* check handle */
+    if (res != 0)                                                              /* check result */
+    {
+        return res;                                                            /* return error */
+    }
+    
+    run = 0;                                                                   /* uncached bytes */
+    while (len != 0)                                                           /* loop all sectors */
+    {
+        off = addr % 4096;                                                     /* get sector offset */
+        remain = 4096 - off;                                                   /* get sector remain */
+        if (remain > len)                                                      /* check length */
+        {
+            remain = len;                                                      /* set length */
+        }
+        line = a_w25qxx_wb_find(wb, addr / 4096);                              /* find the sector */
+        if (line != NULL)                                                      /* buffered */
+        {
+            if (run != 0)                                                      /* read the uncached run */
+            {
+                if (w25qxx_read(wb->handle, addr - run, data - run, run) != 0) /* read data */
+                {
+                    wb->handle->debug_print("w25qxx: read failed.\n");         /* read failed */
+                    
+                    return 1;                                                  /* return error */
+                }
+                run = 0;                                                       /* clear run */
+            }
+            memcpy(data, &line->buf[off], remain);                             /* copy from ram */
+        }
+        else
+        {
+            run += remain;                                                     /* extend the run */
+        }
+        addr += remain;                                                        /* address + remain */
+        data += remain;                                                        /* data + remain */
+        len -= remain;                                                         /* length - remain */
+    }
+    if (run != 0)                                                              /* read the uncached run */
+    {
+        if (w25qxx_read(wb->handle, addr - run, data - run, run) != 0)         /* read data */
+        {
+            wb->handle->debug_print("w25qxx: read failed.\n");                 /* read failed */
+            
+            return 1;                                                          /* return error */
+        }
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     flush all dirty lines
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      lines stay valid as a read cache
+ */
+uint8_t w25qxx_wb_flush(w25qxx_wb_t *wb)
+{
+    uint8_t res;
+    uint32_t i;
+    
+    res = a_w25qxx_wb_check(wb);                           /* check handle */
+    if (res != 0)                                          /* check result */
+    {
+        return res;                                        /* return error */
+    }
+    
+    for (i = 0; i < wb->line_count; i++)                   /* loop all lines */
+    {
+        if (a_w25qxx_wb_flush_line(wb, &wb->line[i]) != 0) /* flush line */
+        {
+            return 1;                                      /* return error */
+        }
+    }
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     flush the lines dirty for longer than the timeout
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it periodically, now_ms also stamps the following writes
+ */
+uint8_t w25qxx_wb_poll(w25qxx_wb_t *wb, uint32_t now_ms)
+{
+    uint8_t res;
+    uint32_t i;
+    
+    res = a_w25qxx_wb_check(wb);                               /* check handle */
+    if (res != 0)                                              /* check result */
+    {
+        return res;                                            /* return error */
+    }
+    
+    wb->now_ms = now_ms;                                       /* set time */
+    if (wb->timeout_ms == 0)                                   /* timeout is disabled */
+    {
+        return 0;                                              /* success return 0 */
+    }
+    for (i = 0; i < wb->line_count; i++)                       /* loop all lines */
+    {
+        if ((wb->line[i].valid != 0) && (wb->line[i].dirty_page != 0) &&
+            (now_ms - wb->line[i].dirty_ms >= wb->timeout_ms)) /* expired */
+        {
+            if (a_w25qxx_wb_flush_line(wb, &wb->line[i]) != 0) /* flush line */
+            {
+                return 1;                                      /* return error */
+            }
+            wb->stats.timeout++;                               /* timeout++ */
+        }
+    }
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *wb pointer to a w25qxx wb structure
+ * @param[out] *stats pointer to a w25qxx wb stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_wb_get_stats(w25qxx_wb_t *wb, w25qxx_wb_stats_t *stats)
+{
+    uint8_t res;
+    
+    res = a_w25qxx_wb_check(wb);                          /* check handle */
+    if (res != 0)                                         /* check result */
+    {
+        return res;                                       /* return error */
+    }
+    
+    memcpy(stats, &wb->stats, sizeof(w25qxx_wb_stats_t)); /* copy stats */
+    
+    return 0;                                             /* success return 0 */
+}
@@ -0,0 +1,200 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_wb.h
+ * @brief     driver w25qxx wb header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_WB_H
+#define DRIVER_W25QXX_WB_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_wb_driver w25qxx wb driver function
+ * @brief    w25qxx write back buffer modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx wb line structure definition
+ */
+typedef struct w25qxx_wb_line_s
+{
+    uint32_t sector;              /**< sector index */
+    uint32_t age;                 /**< last use stamp */
+    uint32_t dirty_ms;            /**< time of the first unflushed write */
+    uint16_t dirty_page;          /**< dirty page bitmap */
+    uint8_t valid;                /**< valid flag */
+    uint8_t buf[4096];            /**< sector image */
+} w25qxx_wb_line_t;
+
+/**
+ * @brief w25qxx wb stats structure definition
+ */
+typedef struct w25qxx_wb_stats_s
+{
+    uint32_t write_bytes;         /**< bytes written by the user */
+    uint32_t write_hit;           /**< writes absorbed by a buffered sector */
+    uint32_t evict;               /**< dirty lines flushed to make room */
+    uint32_t timeout;             /**< dirty lines flushed by the timeout */
+    uint32_t erase;               /**< sector erases */
+    uint32_t page_program;        /**< page programs */
+} w25qxx_wb_stats_t;
+
+/**
+ * @brief w25qxx wb structure definition
+ */
+typedef struct w25qxx_wb_s
+{
+    w25qxx_handle_t *handle;        /**< w25qxx handle */
+    w25qxx_wb_line_t *line;         /**< line array */
+    uint32_t line_count;            /**< line count */
+    uint32_t timeout_ms;            /**< flush timeout, 0 disables it */
+    uint32_t now_ms;                /**< time of the last poll */
+    uint32_t age;                   /**< use stamp */
+    w25qxx_wb_stats_t stats;        /**< statistics */
+    uint8_t page[256];              /**< page buffer */
+    uint8_t inited;                 /**< inited flag */
+} w25qxx_wb_t;
+
+/**
+ * @brief     initialize the write back buffer
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] *line pointer to a line array
+ * @param[in] line_count line count
+ * @param[in] timeout_ms dirty line lifetime, 0 disables the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 line count is invalid
+ * @note      every line buffers one 4k sector, flush before writing or erasing
+ *            the same range directly through the handle
+ */
+uint8_t w25qxx_wb_init(w25qxx_wb_t *wb, w25qxx_handle_t *handle, w25qxx_wb_line_t *line,
+                       uint32_t line_count, uint32_t timeout_ms);
+
+/**
+ * @brief     flush and deinit the write back buffer
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_wb_deinit(w25qxx_wb_t *wb);
+
+/**
+ * @brief     write data through the buffer
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @param[in] addr written address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the least recently used line is flushed when a new sector needs a line
+ */
+uint8_t w25qxx_wb_write(w25qxx_wb_t *wb, uint32_t addr, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief      read data through the buffer
+ * @param[in]  *wb pointer to a w25qxx wb structure
+ * @param[in]  addr read address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       buffered sectors are served from ram, so unflushed data is returned
+ */
+uint8_t w25qxx_wb_read(w25qxx_wb_t *wb, uint32_t addr, uint8_t *data, uint32_t len);
+
+/**
+ * @brief     flush all dirty lines
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      lines stay valid as a read cache
+ */
+uint8_t w25qxx_wb_flush(w25qxx_wb_t *wb);
+
+/**
+ * @brief     flush the lines dirty for longer than the timeout
+ * @param[in] *wb pointer to a w25qxx wb structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it periodically, now_ms also stamps the following writes
+ */
+uint8_t w25qxx_wb_poll(w25qxx_wb_t *wb, uint32_t now_ms);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *wb pointer to a w25qxx wb structure
+ * @param[out] *stats pointer to a w25qxx wb stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_wb_get_stats(w25qxx_wb_t *wb, w25qxx_wb_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
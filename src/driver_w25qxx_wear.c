@@ -0,0 +1,557 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_wear.c
+ * @brief     driver w25qxx wear source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_wear.h"
+#include "driver_w25qxx_util.h"
+
+/**
+ * @brief wear snapshot definition
+ */
+#define W25QXX_WEAR_MAGIC          0x52414557U        /**< "WEAR" */
+#define W25QXX_WEAR_HEADER_SIZE    16U                /**< snapshot header size */
+
+/**
+ * @brief     get a packed counter
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] index counter index
+ * @return    counter value
+ * @note      none
+ */
+static uint32_t a_w25qxx_wear_get(w25qxx_wear_t *wear, uint32_t index)
+{
+    uint8_t *p;
+    
+    p = &wear->table[index * 3];                                                  /* get counter position */
+    
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);       /* return counter */
+}
+
+/**
+ * @brief     increase a packed counter
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] index counter index
+ * @note      the counter saturates at W25QXX_WEAR_COUNTER_MAX
+ */
+static void a_w25qxx_wear_inc(w25qxx_wear_t *wear, uint32_t index)
+{
+    uint32_t value;
+    uint8_t *p;
+    
+    value = a_w25qxx_wear_get(wear, index);                 /* get counter */
+    if (value < W25QXX_WEAR_COUNTER_MAX)                    /* check saturation */
+    {
+        value++;                                            /* counter++ */
+    }
+    p = &wear->table[index * 3];                            /* get counter position */
+    p[0] = (uint8_t)(value >> 0);                           /* set byte 0 */
+    p[1] = (uint8_t)(value >> 8);                           /* set byte 1 */
+    p[2] = (uint8_t)(value >> 16);                          /* set byte 2 */
+}
+
+/**
+ * @brief     erase callback
+ * @param[in] *param pointer to a w25qxx wear structure
+ * @param[in] type erase type
+ * @param[in] addr erase address
+ * @note      only counts in ram, the chip is still busy here
+ */
+static void a_w25qxx_wear_erase_callback(void *param, w25qxx_erase_type_t type, uint32_t addr)
+{
+    w25qxx_wear_t *wear;
+    uint32_t sector_num;
+    
+    wear = (w25qxx_wear_t *)param;                                                            /* get wear */
+    sector_num = wear->size / 4096;                                                           /* get sector number */
+    if (type == W25QXX_ERASE_TYPE_CHIP)                                                       /* chip erase */
+    {
+        if (wear->chip < W25QXX_WEAR_COUNTER_MAX)                                             /* check saturation */
+        {
+            wear->chip++;                                                                     /* chip++ */
+        }
+    }
+    else if (addr < wear->size)                                                               /* check address */
+    {
+        if (type == W25QXX_ERASE_TYPE_SECTOR_4K)                                              /* 4k sector */
+        {
+            a_w25qxx_wear_inc(wear, addr / 4096);                                             /* sector counter++ */
+        }
+        else if (type == W25QXX_ERASE_TYPE_BLOCK_32K)                                         /* 32k block */
+        {
+            a_w25qxx_wear_inc(wear, sector_num + addr / 32768);                               /* 32k counter++ */
+        }
+        else                                                                                  /* 64k block */
+        {
+            a_w25qxx_wear_inc(wear, sector_num + wear->size / 32768 + addr / 65536);          /* 64k counter++ */
+        }
+    }
+    else
+    {
+        return;                                                                               /* out of range */
+    }
+    wear->pending++;                                                                          /* pending++ */
+}
+
+/**
+ * @brief     initialize the wear table and attach it to the handle
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] size flash size in bytes
+ * @param[in] *table pointer to a counter table buffer
+ * @param[in] table_size counter table buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 size is invalid
+ *            - 5 table is too small
+ * @note      the table must hold at least W25QXX_WEAR_TABLE_SIZE(size) bytes,
+ *            this function replaces the erase callback of the handle
+ */
+uint8_t w25qxx_wear_init(w25qxx_wear_t *wear, w25qxx_handle_t *handle, uint32_t size,
+                         uint8_t *table, uint32_t table_size)
+{
+    if ((wear == NULL) || (handle == NULL) || (table == NULL))                       /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if ((size == 0) || ((size % 65536) != 0))                                        /* check size */
+    {
+        handle->debug_print("w25qxx: size is invalid.\n");                           /* size is invalid */
+    
+        return 4;                                                                    /* return error */
+    }
+    if (table_size < W25QXX_WEAR_TABLE_SIZE(size))                                   /* check table size */
+    {
+        handle->debug_print("w25qxx: table is too small.\n");                        /* table is too small */
+    
+        return 5;                                                                    /* return error */
+    }
+    
+    memset(wear, 0, sizeof(w25qxx_wear_t));                                          /* clear wear */
+    wear->handle = handle;                                                           /* set handle */
+    wear->table = table;                                                             /* set table */
+    wear->table_size = W25QXX_WEAR_TABLE_SIZE(size);                                 /* set table size */
+    wear->size = size;                                                               /* set size */
+    memset(wear->table, 0, wear->table_size);                                        /* clear table */
+    (void)w25qxx_set_erase_callback(handle, a_w25qxx_wear_erase_callback, wear);     /* attach callback */
+    wear->inited = 1;                                                                /* set inited */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     detach the wear table from the handle
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_wear_deinit(w25qxx_wear_t *wear)
+{
+    if (wear == NULL)                                                  /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (wear->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    (void)w25qxx_set_erase_callback(wear->handle, NULL, NULL);         /* detach callback */
+    wear->inited = 0;                                                  /* clear inited */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the reserved region used to persist the table
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] batch erase count between two snapshots
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 region is too small
+ * @note      the region holds two alternating snapshot slots,
+ *            each one is 4k aligned and sized for a 16 bytes header plus the table
+ */
+uint8_t w25qxx_wear_set_region(w25qxx_wear_t *wear, uint32_t addr, uint32_t len, uint32_t batch)
+{
+    uint32_t slot_size;
+    
+    if (wear == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (wear->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (((addr % 4096) != 0) || (addr >= wear->size))                                     /* check address */
+    {
+        wear->handle->debug_print("w25qxx: addr is invalid.\n");                          /* addr is invalid */
+    
+        return 4;                                                                         /* return error */
+    }
+    
+    slot_size = ((W25QXX_WEAR_HEADER_SIZE + wear->table_size + 4095) / 4096) * 4096;      /* get slot size */
+    if ((len < slot_size * 2) || ((wear->size - addr) < slot_size * 2))                   /* check length */
+    {
+        wear->handle->debug_print("w25qxx: region is too small.\n");                      /* region is too small */
+    
+        return 5;                                                                         /* return error */
+    }
+    wear->region_addr = addr;                                                             /* set region address */
+    wear->slot_size = slot_size;                                                          /* set slot size */
+    wear->batch = batch;                                                                  /* set batch */
+    wear->seq = 0;                                                                        /* reset sequence */
+    wear->region_enable = 1;                                                              /* enable region */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     read and check one snapshot slot
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] slot slot index
+ * @param[in] seq expected sequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 5 snapshot is invalid
+ * @note      the table is overwritten
+ */
+static uint8_t a_w25qxx_wear_load_slot(w25qxx_wear_t *wear, uint8_t slot, uint32_t seq)
+{
+    uint8_t header[W25QXX_WEAR_HEADER_SIZE];
+    uint32_t addr;
+    uint32_t crc;
+    
+    addr = wear->region_addr + slot * wear->slot_size;                                             /* get slot address */
+    if (w25qxx_read(wear->handle, addr, header, W25QXX_WEAR_HEADER_SIZE) != 0)                     /* read header */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    if (w25qxx_read(wear->handle, addr + W25QXX_WEAR_HEADER_SIZE,
+                    wear->table, wear->table_size) != 0)                                           /* read table */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    crc = w25qxx_util_crc32(0xFFFFFFFFU, header, 12);                                              /* crc header */
+    crc = w25qxx_util_crc32(crc, wear->table, wear->table_size) ^ 0xFFFFFFFFU;                     /* crc table */
+    if ((w25qxx_util_get32(&header[0]) != W25QXX_WEAR_MAGIC) ||
+        (w25qxx_util_get32(&header[4]) != seq) ||
+        (w25qxx_util_get32(&header[12]) != crc))                                                   /* check snapshot */
+    {
+        return 5;                                                                                  /* return error */
+    }
+    wear->chip = w25qxx_util_get32(&header[8]);                                                    /* set chip count */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     load the newest valid snapshot from the reserved region
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is not set
+ *            - 5 no valid snapshot
+ * @note      the table is cleared when no valid snapshot is found
+ */
+uint8_t w25qxx_wear_load(w25qxx_wear_t *wear)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t header[8];
+    uint32_t seq[2];
+    uint8_t valid[2];
+    uint8_t order[2];
+    
+    if (wear == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (wear->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (wear->region_enable != 1)                                                               /* check region */
+    {
+        wear->handle->debug_print("w25qxx: region is not set.\n");                              /* region is not set */
+    
+        return 4;                                                                               /* return error */
+    }
+    
+    for (i = 0; i < 2; i++)                                                                     /* read both headers */
+    {
+        res = w25qxx_read(wear->handle, wear->region_addr + i * wear->slot_size, header, 8);    /* read header */
+        if (res != 0)                                                                           /* check result */
+        {
+            wear->handle->debug_print("w25qxx: read failed.\n");                                /* read failed */
+    
+            return 1;                                                                           /* return error */
+        }
+        valid[i] = (uint8_t)(w25qxx_util_get32(&header[0]) == W25QXX_WEAR_MAGIC);               /* check magic */
+        seq[i] = w25qxx_util_get32(&header[4]);                                                 /* get sequence */
+    }
+    if ((valid[1] != 0) && ((valid[0] == 0) || ((int32_t)(seq[1] - seq[0]) > 0)))               /* slot 1 is newer */
+    {
+        order[0] = 1;                                                                           /* try slot 1 first */
+        order[1] = 0;                                                                           /* then slot 0 */
+    }
+    else
+    {
+        order[0] = 0;                                                                           /* try slot 0 first */
+        order[1] = 1;                                                                           /* then slot 1 */
+    }
+    for (i = 0; i < 2; i++)                                                                     /* try both slots */
+    {
+        if (valid[order[i]] == 0)                                                               /* check magic */
+        {
+            continue;                                                                           /* skip */
+        }
+        res = a_w25qxx_wear_load_slot(wear, order[i], seq[order[i]]);                           /* load slot */
+        if (res == 1)                                                                           /* check result */
+        {
+            wear->handle->debug_print("w25qxx: read failed.\n");                                /* read failed */
+    
+            return 1;                                                                           /* return error */
+        }
+        if (res == 0)                                                                           /* found */
+        {
+            wear->seq = seq[order[i]];                                                          /* set sequence */
+            wear->pending = 0;                                                                  /* clear pending */
+    
+            return 0;                                                                           /* success return 0 */
+        }
+    }
+    memset(wear->table, 0, wear->table_size);                                                   /* clear table */
+    wear->chip = 0;                                                                             /* clear chip count */
+    wear->seq = 0;                                                                              /* reset sequence */
+    
+    return 5;                                                                                   /* return error */
+}
+
+/**
+ * @brief     persist the table once enough erases are pending
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] force bool value, persist even if less than batch erases are pending
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is not set
+ * @note      the snapshot header is programmed last, so a torn snapshot is never loaded
+ */
+uint8_t w25qxx_wear_sync(w25qxx_wear_t *wear, w25qxx_bool_t force)
+{
+    uint8_t res;
+    uint8_t header[W25QXX_WEAR_HEADER_SIZE];
+    uint8_t page[256];
+    uint32_t slot_addr;
+    uint32_t total;
+    uint32_t offset;
+    uint32_t seq;
+    uint32_t crc;
+    uint32_t i;
+    
+    if (wear == NULL)                                                                            /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (wear->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (wear->region_enable != 1)                                                                /* check region */
+    {
+        wear->handle->debug_print("w25qxx: region is not set.\n");                               /* region is not set */
+    
+        return 4;                                                                                /* return error */
+    }
+    if ((wear->pending == 0) || ((force == W25QXX_BOOL_FALSE) && (wear->pending < wear->batch))) /* check pending */
+    {
+        return 0;                                                                                /* nothing to do */
+    }
+    
+    seq = wear->seq + 1;                                                                         /* next sequence */
+    slot_addr = wear->region_addr + (seq % 2) * wear->slot_size;                                 /* get slot address */
+    for (offset = 0; offset < wear->slot_size; offset += 4096)                                   /* erase the slot */
+    {
+        res = w25qxx_sector_erase_4k(wear->handle, slot_addr + offset);                          /* erase sector */
+        if (res != 0)                                                                            /* check result */
+        {
+            wear->handle->debug_print("w25qxx: sector erase 4k failed.\n");                      /* sector erase 4k failed */
+    
+            return 1;                                                                            /* return error */
+        }
+    }
+    
+    w25qxx_util_put32(&header[0], W25QXX_WEAR_MAGIC);                                            /* set magic */
+    w25qxx_util_put32(&header[4], seq);                                                          /* set sequence */
+    w25qxx_util_put32(&header[8], wear->chip);                                                   /* set chip count */
+    crc = w25qxx_util_crc32(0xFFFFFFFFU, header, 12);                                            /* crc header */
+    crc = w25qxx_util_crc32(crc, wear->table, wear->table_size) ^ 0xFFFFFFFFU;                   /* crc table */
+    w25qxx_util_put32(&header[12], crc);                                                         /* set crc */
+    total = W25QXX_WEAR_HEADER_SIZE + wear->table_size;                                          /* get total size */
+    offset = ((total - 1) / 256) * 256;                                                          /* last page first */
+    while (1)                                                                                    /* program pages backward */
+    {
+        memset(page, 0xFF, 256);                                                                 /* erased page */
+        for (i = 0; (i < 256) && ((offset + i) < total); i++)                                    /* fill page */
+        {
+            if ((offset + i) < W25QXX_WEAR_HEADER_SIZE)                                          /* header */
+            {
+                page[i] = header[offset + i];                                                    /* copy header */
+            }
+            else
+            {
+                page[i] = wear->table[offset + i - W25QXX_WEAR_HEADER_SIZE];                     /* copy table */
+            }
+        }
+        res = w25qxx_page_program(wear->handle, slot_addr + offset, page, 256);                  /* page program */
+        if (res != 0)                                                                            /* check result */
+        {
+            wear->handle->debug_print("w25qxx: page program failed.\n");                         /* page program failed */
+    
+            return 1;                                                                            /* return error */
+        }
+        if (offset == 0)                                                                         /* header page done */
+        {
+            break;                                                                               /* break */
+        }
+        offset -= 256;                                                                           /* previous page */
+    }
+    wear->seq = seq;                                                                             /* set sequence */
+    wear->pending = 0;                                                                           /* clear pending */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the erase count of a sector
+ * @param[in]  *wear pointer to a w25qxx wear structure
+ * @param[in]  addr address inside the sector
+ * @param[out] *count pointer to a w25qxx wear count structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 addr is invalid
+ * @note       none
+ */
+uint8_t w25qxx_wear_get_count(w25qxx_wear_t *wear, uint32_t addr, w25qxx_wear_count_t *count)
+{
+    uint32_t sector_num;
+    
+    if (wear == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (wear->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (addr >= wear->size)                                                                     /* check address */
+    {
+        wear->handle->debug_print("w25qxx: addr is invalid.\n");                                /* addr is invalid */
+    
+        return 4;                                                                               /* return error */
+    }
+    
+    sector_num = wear->size / 4096;                                                             /* get sector number */
+    count->sector_4k = a_w25qxx_wear_get(wear, addr / 4096);                                    /* get 4k count */
+    count->block_32k = a_w25qxx_wear_get(wear, sector_num + addr / 32768);                      /* get 32k count */
+    count->block_64k = a_w25qxx_wear_get(wear, sector_num + wear->size / 32768 + addr / 65536); /* get 64k count */
+    count->chip = wear->chip;                                                                   /* get chip count */
+    count->total = count->sector_4k + count->block_32k + count->block_64k + count->chip;        /* get total */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      find the most erased sector
+ * @param[in]  *wear pointer to a w25qxx wear structure
+ * @param[out] *addr pointer to a sector address buffer
+ * @param[out] *total pointer to a total erase count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_wear_get_hot_sector(w25qxx_wear_t *wear, uint32_t *addr, uint32_t *total)
+{
+    w25qxx_wear_count_t count;
+    uint32_t a;
+    
+    if (wear == NULL)                                                   /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (wear->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    *addr = 0;                                                          /* init address */
+    *total = 0;                                                         /* init total */
+    for (a = 0; a < wear->size; a += 4096)                              /* loop all sectors */
+    {
+        (void)w25qxx_wear_get_count(wear, a, &count);                   /* get count */
+        if (count.total > *total)                                       /* check total */
+        {
+            *addr = a;                                                  /* set address */
+            *total = count.total;                                       /* set total */
+        }
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
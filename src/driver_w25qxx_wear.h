@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_wear.h
+ * @brief     driver w25qxx wear header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_WEAR_H
+#define DRIVER_W25QXX_WEAR_H
+
+#include "driver_w25qxx.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup w25qxx_wear_driver w25qxx wear driver function
+ * @brief    w25qxx wear driver modules
+ * @ingroup  w25qxx_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx wear counter max definition
+ */
+#define W25QXX_WEAR_COUNTER_MAX        (0xFFFFFFU)        /**< 24 bits saturating counter */
+
+/**
+ * @brief     wear table size definition
+ * @param[in] SIZE flash size in bytes
+ * @note      one 3 bytes counter per 4k sector, per 32k block and per 64k block
+ */
+#define W25QXX_WEAR_TABLE_SIZE(SIZE)   ((((SIZE) / 4096U) + ((SIZE) / 32768U) + ((SIZE) / 65536U)) * 3U)
+
+/**
+ * @brief w25qxx wear count structure definition
+ */
+typedef struct w25qxx_wear_count_s
+{
+    uint32_t sector_4k;        /**< 4k sector erase count */
+    uint32_t block_32k;        /**< 32k block erase count of the sector's block */
+    uint32_t block_64k;        /**< 64k block erase count of the sector's block */
+    uint32_t chip;             /**< chip erase count */
+    uint32_t total;            /**< total erase cycles seen by the sector */
+} w25qxx_wear_count_t;
+
+/**
+ * @brief w25qxx wear structure definition
+ */
+typedef struct w25qxx_wear_s
+{
+    w25qxx_handle_t *handle;        /**< w25qxx handle */
+    uint8_t *table;                 /**< packed counter table */
+    uint32_t table_size;            /**< counter table size */
+    uint32_t size;                  /**< flash size */
+    uint32_t chip;                  /**< chip erase count */
+    uint32_t pending;               /**< erases not persisted yet */
+    uint32_t batch;                 /**< persist batch */
+    uint32_t region_addr;           /**< reserved region address */
+    uint32_t slot_size;             /**< one snapshot slot size */
+    uint32_t seq;                   /**< last snapshot sequence */
+    uint8_t region_enable;          /**< reserved region enable */
+    uint8_t inited;                 /**< inited flag */
+} w25qxx_wear_t;
+
+/**
+ * @brief     initialize the wear table and attach it to the handle
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] *handle pointer to an initialized w25qxx handle structure
+ * @param[in] size flash size in bytes
+ * @param[in] *table pointer to a counter table buffer
+ * @param[in] table_size counter table buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 size is invalid
+ *            - 5 table is too small
+ * @note      the table must hold at least W25QXX_WEAR_TABLE_SIZE(size) bytes,
+ *            this function replaces the erase callback of the handle
+ */
+uint8_t w25qxx_wear_init(w25qxx_wear_t *wear, w25qxx_handle_t *handle, uint32_t size,
+                         uint8_t *table, uint32_t table_size);
+
+/**
+ * @brief     detach the wear table from the handle
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t w25qxx_wear_deinit(w25qxx_wear_t *wear);
+
+/**
+ * @brief     set the reserved region used to persist the table
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] addr region address
+ * @param[in] len region length
+ * @param[in] batch erase count between two snapshots
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 addr is invalid
+ *            - 5 region is too small
+ * @note      the region holds two alternating snapshot slots,
+ *            each one is 4k aligned and sized for a 16 bytes header plus the table
+ */
+uint8_t w25qxx_wear_set_region(w25qxx_wear_t *wear, uint32_t addr, uint32_t len, uint32_t batch);
+
+/**
+ * @brief     load the newest valid snapshot from the reserved region
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is not set
+ *            - 5 no valid snapshot
+ * @note      the table is cleared when no valid snapshot is found
+ */
+uint8_t w25qxx_wear_load(w25qxx_wear_t *wear);
+
+/**
+ * @brief     persist the table once enough erases are pending
+ * @param[in] *wear pointer to a w25qxx wear structure
+ * @param[in] force bool value, persist even if less than batch erases are pending
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 region is not set
+ * @note      the snapshot header is programmed last, so a torn snapshot is never loaded
+ */
+uint8_t w25qxx_wear_sync(w25qxx_wear_t *wear, w25qxx_bool_t force);
+
+/**
+ * @brief      get the erase count of a sector
+ * @param[in]  *wear pointer to a w25qxx wear structure
+ * @param[in]  addr address inside the sector
+ * @param[out] *count pointer to a w25qxx wear count structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 addr is invalid
+ * @note       none
+ */
+uint8_t w25qxx_wear_get_count(w25qxx_wear_t *wear, uint32_t addr, w25qxx_wear_count_t *count);
+
+/**
+ * @brief      find the most erased sector
+ * @param[in]  *wear pointer to a w25qxx wear structure
+ * @param[out] *addr pointer to a sector address buffer
+ * @param[out] *total pointer to a total erase count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t w25qxx_wear_get_hot_sector(w25qxx_wear_t *wear, uint32_t *addr, uint32_t *total);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
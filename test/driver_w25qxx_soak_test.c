@@ -0,0 +1,663 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_soak_test.c
+ * @brief     driver w25qxx soak test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_w25qxx_soak_test.h"
+#include <stdlib.h>
+
+/**
+ * @brief soak operation definition
+ */
+#define SOAK_OP_READ         0        /**< read */
+#define SOAK_OP_WRITE        1        /**< write */
+#define SOAK_OP_ERASE        2        /**< erase */
+#define SOAK_OP_NUM          3        /**< operation number */
+#define SOAK_MAX_REPORT      16       /**< max printed mismatches */
+
+/**
+ * @brief soak statistics structure definition
+ */
+typedef struct soak_stat_s
+{
+    uint64_t count;               /**< operation count */
+    uint64_t bytes;               /**< operation bytes */
+    uint64_t total_us;            /**< total latency */
+    uint64_t max_us;              /**< max latency */
+    uint64_t window_bytes;        /**< bytes in the current report window */
+    uint32_t window_count;        /**< operations in the current report window */
+    uint32_t histogram[32];       /**< log2 latency histogram */
+} soak_stat_t;
+
+static w25qxx_handle_t gs_handle;                           /**< w25qxx handle */
+static uint8_t gs_buffer_input[W25QXX_SOAK_MAX_LENGTH];     /**< input buffer */
+static uint8_t gs_buffer_output[W25QXX_SOAK_MAX_LENGTH];    /**< output buffer */
+static uint32_t gs_page[W25QXX_SOAK_MAX_PAGE];              /**< generation of every page, 0 means erased */
+static uint32_t gs_generation;                              /**< last generation */
+static uint32_t gs_random;                                  /**< random state */
+static uint32_t gs_cursor;                                  /**< sequential cursor */
+static uint32_t gs_mismatch;                                /**< mismatch count */
+static soak_stat_t gs_stat[SOAK_OP_NUM];                    /**< statistics */
+static const char *const gsc_name[SOAK_OP_NUM] = {"read", "write", "erase"};    /**< operation name */
+
+/**
+ * @brief  get a random number
+ * @return random number
+ * @note   xorshift32, the sequence only depends on the seed
+ */
+static uint32_t a_soak_random(void)
+{
+    gs_random ^= gs_random << 13;
+    gs_random ^= gs_random >> 17;
+    gs_random ^= gs_random << 5;
+    
+    return gs_random;
+}
+
+/**
+ * @brief     get the flash size
+ * @param[in] type chip type
+ * @return    flash size in bytes, 0 if the type is unknown
+ * @note      the ids are not contiguous after W25Q512
+ */
+static uint32_t a_soak_size(w25qxx_type_t type)
+{
+    switch (type)
+    {
+        case W25Q10 :
+        case W25Q20 :
+        case W25Q40 :
+        case W25Q80 :
+        case W25Q16 :
+        case W25Q32 :
+        case W25Q64 :
+        case W25Q128 :
+        case W25Q256 :
+        case W25Q512 :
+        {
+            return 0x20000U << (type - W25Q10);
+        }
+        case W25Q01 :
+        {
+            return 0x8000000U;
+        }
+        case W25Q02 :
+        {
+            return 0x10000000U;
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief     get the expected byte
+ * @param[in] addr flash address
+ * @param[in] generation page generation
+ * @return    expected byte
+ * @note      none
+ */
+static uint8_t a_soak_pattern(uint32_t addr, uint32_t generation)
+{
+    uint32_t x;
+    
+    if (generation == 0)
+    {
+        return 0xFF;
+    }
+    x = (addr * 2654435761U) ^ (generation * 0x9E3779B9U);
+    x ^= x >> 15;
+    x *= 0x2C1B3C6DU;
+    x ^= x >> 12;
+    
+    return (uint8_t)(x & 0xFF);
+}
+
+/**
+ * @brief     get an operation length
+ * @param[in] *param pointer to a w25qxx soak param structure
+ * @return    length
+ * @note      none
+ */
+static uint32_t a_soak_length(const w25qxx_soak_param_t *param)
+{
+    uint32_t low;
+    uint32_t high;
+    uint32_t len;
+    
+    if (param->distribution == W25QXX_SOAK_DISTRIBUTION_UNIFORM)
+    {
+        return param->min_length + a_soak_random() % (param->max_length - param->min_length + 1);
+    }
+    else if (param->distribution == W25QXX_SOAK_DISTRIBUTION_LOG)
+    {
+        /* find the power of 2 range */
+        low = 0;
+        while ((2U << low) <= param->min_length)
+        {
+            low++;
+        }
+        high = low;
+        while ((2U << high) <= param->max_length)
+        {
+            high++;
+        }
+        
+        /* pick an octave, then a length inside it */
+        low = low + a_soak_random() % (high - low + 1);
+        len = (1U << low) + a_soak_random() % (1U << low);
+        if (len < param->min_length)
+        {
+            len = param->min_length;
+        }
+        if (len > param->max_length)
+        {
+            len = param->max_length;
+        }
+        
+        return len;
+    }
+    else
+    {
+        return param->max_length;
+    }
+}
+
+/**
+ * @brief     get an operation offset
+ * @param[in] *param pointer to a w25qxx soak param structure
+ * @param[in] len operation length
+ * @param[in] align offset alignment
+ * @return    offset inside the region
+ * @note      none
+ */
+static uint32_t a_soak_offset(const w25qxx_soak_param_t *param, uint32_t len, uint32_t align)
+{
+    uint32_t offset;
+    
+    if (param->pattern == W25QXX_SOAK_PATTERN_SEQUENTIAL)
+    {
+        offset = (gs_cursor + align - 1) / align * align;
+        if (offset + len > param->size)
+        {
+            offset = 0;
+        }
+        gs_cursor = offset + len;
+    }
+    else
+    {
+        offset = (a_soak_random() % ((param->size - len) / align + 1)) * align;
+    }
+    
+    return offset;
+}
+
+/**
+ * @brief     record one operation
+ * @param[in] op operation
+ * @param[in] len operation length
+ * @param[in] us operation latency
+ * @note      none
+ */
+static void a_soak_record(uint8_t op, uint32_t len, uint64_t us)
+{
+    uint8_t bucket;
+    
+    bucket = 0;
+    while ((bucket < 31) && ((us >> (bucket + 1)) != 0))
+    {
+        bucket++;
+    }
+    gs_stat[op].count++;
+    gs_stat[op].bytes += len;
+    gs_stat[op].total_us += us;
+    gs_stat[op].window_bytes += len;
+    gs_stat[op].window_count++;
+    gs_stat[op].histogram[bucket]++;
+    if (us > gs_stat[op].max_us)
+    {
+        gs_stat[op].max_us = us;
+    }
+}
+
+/**
+ * @brief     get a latency percentile
+ * @param[in] op operation
+ * @param[in] per_mille percentile in 1/1000
+ * @return    upper bound of the percentile bucket in us
+ * @note      none
+ */
+static uint64_t a_soak_percentile(uint8_t op, uint32_t per_mille)
+{
+    uint64_t target;
+    uint64_t sum;
+    uint8_t i;
+    
+    target = (gs_stat[op].count * per_mille + 999) / 1000;
+    sum = 0;
+    for (i = 0; i < 32; i++)
+    {
+        sum += gs_stat[op].histogram[i];
+        if ((sum >= target) && (sum != 0))
+        {
+            break;
+        }
+    }
+    if ((i >= 31) || ((2ULL << i) > gs_stat[op].max_us))
+    {
+        return gs_stat[op].max_us;
+    }
+    
+    return 2ULL << i;
+}
+
+/**
+ * @brief     print the window throughput
+ * @param[in] seconds elapsed seconds
+ * @param[in] window_us window length in us
+ * @note      none
+ */
+static void a_soak_report(uint32_t seconds, uint64_t window_us)
+{
+    double s;
+    
+    s = (double)window_us / 1000000.0;
+    if (s <= 0.0)
+    {
+        return;
+    }
+    w25qxx_interface_debug_print("w25qxx: [%6us] read %0.1fKB/s(%0.0fops) write %0.1fKB/s(%0.0fops) erase %0.1fops mismatch %u.\n",
+                                 seconds,
+                                 (double)gs_stat[SOAK_OP_READ].window_bytes / 1024.0 / s,
+                                 (double)gs_stat[SOAK_OP_READ].window_count / s,
+                                 (double)gs_stat[SOAK_OP_WRITE].window_bytes / 1024.0 / s,
+                                 (double)gs_stat[SOAK_OP_WRITE].window_count / s,
+                                 (double)gs_stat[SOAK_OP_ERASE].window_count / s,
+                                 gs_mismatch);
+    gs_stat[SOAK_OP_READ].window_bytes = 0;
+    gs_stat[SOAK_OP_READ].window_count = 0;
+    gs_stat[SOAK_OP_WRITE].window_bytes = 0;
+    gs_stat[SOAK_OP_WRITE].window_count = 0;
+    gs_stat[SOAK_OP_ERASE].window_bytes = 0;
+    gs_stat[SOAK_OP_ERASE].window_count = 0;
+}
+
+/**
+ * @brief     check the read data
+ * @param[in] addr flash address
+ * @param[in] offset region offset
+ * @param[in] len data length
+ * @note      none
+ */
+static void a_soak_check(uint32_t addr, uint32_t offset, uint32_t len)
+{
+    uint32_t j;
+    uint8_t expect;
+    
+    for (j = 0; j < len; j++)
+    {
+        expect = a_soak_pattern(addr + j, gs_page[(offset + j) / 256]);
+        if (gs_buffer_output[j] != expect)
+        {
+            if (gs_mismatch < SOAK_MAX_REPORT)
+            {
+                w25qxx_interface_debug_print("w25qxx: mismatch at 0x%08X, expect 0x%02X, read 0x%02X.\n",
+                                             addr + j, expect, gs_buffer_output[j]);
+            }
+            gs_mismatch++;
+            
+            /* one mismatch per read is enough */
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     soak test
+ * @param[in] type chip type
+ * @param[in] interface chip interface
+ * @param[in] dual_quad_spi_enable bool value
+ * @param[in] *param pointer to a w25qxx soak param structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the region is erased first, then every read is checked against the expected content
+ */
+uint8_t w25qxx_soak_test(w25qxx_type_t type, w25qxx_interface_t interface, w25qxx_bool_t dual_quad_spi_enable,
+                         const w25qxx_soak_param_t *param)
+{
+    uint8_t res;
+    uint8_t op;
+    uint32_t i;
+    uint32_t weight;
+    uint32_t len;
+    uint32_t offset;
+    uint32_t addr;
+    uint32_t done;
+    uint32_t next_report;
+    uint64_t start;
+    uint64_t window;
+    uint64_t t0;
+    uint64_t now;
+    w25qxx_info_t info;
+    
+    /* check the param */
+    if ((param == NULL) || (param->timestamp_us == NULL))
+    {
+        w25qxx_interface_debug_print("w25qxx: param is invalid.\n");
+        
+        return 1;
+    }
+    if (((param->addr % 4096) != 0) || ((param->size % 4096) != 0) || (param->size == 0) ||
+        ((param->size / 256) > W25QXX_SOAK_MAX_PAGE) || 
+        ((uint64_t)param->addr + param->size > a_soak_size(type)))
+    {
+        w25qxx_interface_debug_print("w25qxx: region is invalid.\n");
+        
+        return 1;
+    }
+    if ((param->min_length == 0) || (param->min_length > param->max_length) ||
+        (param->max_length > W25QXX_SOAK_MAX_LENGTH) || (param->max_length > param->size))
+    {
+        w25qxx_interface_debug_print("w25qxx: length is invalid.\n");
+        
+        return 1;
+    }
+    weight = (uint32_t)param->read_ratio + param->write_ratio + param->erase_ratio;
+    if (weight == 0)
+    {
+        w25qxx_interface_debug_print("w25qxx: ratio is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link interface function */
+    DRIVER_W25QXX_LINK_INIT(&gs_handle, w25qxx_handle_t);
+    DRIVER_W25QXX_LINK_SPI_QSPI_INIT(&gs_handle, w25qxx_interface_spi_qspi_init);
+    DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(&gs_handle, w25qxx_interface_spi_qspi_deinit);
+    DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(&gs_handle, w25qxx_interface_spi_qspi_write_read);
+    DRIVER_W25QXX_LINK_DELAY_MS(&gs_handle, w25qxx_interface_delay_ms);
+    DRIVER_W25QXX_LINK_DELAY_US(&gs_handle, w25qxx_interface_delay_us);
+    DRIVER_W25QXX_LINK_DEBUG_PRINT(&gs_handle, w25qxx_interface_debug_print);
+    
+    /* get information */
+    res = w25qxx_info(&info);
+    if (res != 0)
+    {
+        w25qxx_interface_debug_print("w25qxx: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        w25qxx_interface_debug_print("w25qxx: chip is %s.\n", info.chip_name);
+        w25qxx_interface_debug_print("w25qxx: manufacturer is %s.\n", info.manufacturer_name);
+        w25qxx_interface_debug_print("w25qxx: interface is %s.\n", info.interface);
+        w25qxx_interface_debug_print("w25qxx: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        w25qxx_interface_debug_print("w25qxx: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        w25qxx_interface_debug_print("w25qxx: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        w25qxx_interface_debug_print("w25qxx: max current is %0.2fmA.\n", info.max_current_ma);
+        w25qxx_interface_debug_print("w25qxx: max temperature is %0.1fC.\n", info.temperature_max);
+        w25qxx_interface_debug_print("w25qxx: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* set chip type */
+    res = w25qxx_set_type(&gs_handle, type);
+    if (res != 0)
+    {
+        w25qxx_interface_debug_print("w25qxx: set type failed.\n");
+        
+        return 1;
+    }
+    
+    /* set chip interface */
+    res = w25qxx_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        w25qxx_interface_debug_print("w25qxx: set interface failed.\n");
+        
+        return 1;
+    }
+    
+    /* set dual quad spi */
+    res = w25qxx_set_dual_quad_spi(&gs_handle, dual_quad_spi_enable);
+    if (res != 0)
+    {
+        w25qxx_interface_debug_print("w25qxx: set dual quad spi failed.\n");
+        
+        return 1;
+    }
+    
+    /* chip init */
+    res = w25qxx_init(&gs_handle);
+    if (res != 0)
+    {
+        w25qxx_interface_debug_print("w25qxx: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* start soak test */
+    w25qxx_interface_debug_print("w25qxx: start soak test.\n");
+    w25qxx_interface_debug_print("w25qxx: region 0x%08X size 0x%08X ratio %d:%d:%d length %d-%d seed %u.\n",
+                                 param->addr, param->size, param->read_ratio, param->write_ratio, param->erase_ratio,
+                                 param->min_length, param->max_length, param->seed);
+    
+    /* erase the region so the expected content is known */
+    w25qxx_interface_debug_print("w25qxx: erase the region.\n");
+    for (addr = param->addr; addr < param->addr + param->size; )
+    {
+        if (((addr % 0x10000) == 0) && ((param->addr + param->size - addr) >= 0x10000))
+        {
+            res = w25qxx_block_erase_64k(&gs_handle, addr);
+            addr += 0x10000;
+        }
+        else
+        {
+            res = w25qxx_sector_erase_4k(&gs_handle, addr);
+            addr += 0x1000;
+        }
+        if (res != 0)
+        {
+            w25qxx_interface_debug_print("w25qxx: erase failed.\n");
+            (void)w25qxx_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* init the model */
+    memset(gs_page, 0, sizeof(gs_page));
+    memset(gs_stat, 0, sizeof(gs_stat));
+    gs_generation = 0;
+    gs_random = (param->seed != 0) ? param->seed : 1;
+    gs_cursor = 0;
+    gs_mismatch = 0;
+    done = 0;
+    next_report = (param->interval != 0) ? param->interval : 10;
+    start = param->timestamp_us();
+    window = start;
+    
+    while (1)
+    {
+        /* check the end */
+        now = param->timestamp_us();
+        if ((param->seconds != 0) && ((now - start) >= (uint64_t)param->seconds * 1000000ULL))
+        {
+            break;
+        }
+        if ((param->operations != 0) && (done >= param->operations))
+        {
+            break;
+        }
+        
+        /* print the throughput */
+        if ((now - start) >= (uint64_t)next_report * 1000000ULL)
+        {
+            a_soak_report(next_report, now - window);
+            window = now;
+            next_report += (param->interval != 0) ? param->interval : 10;
+        }
+        
+        /* pick the operation */
+        i = a_soak_random() % weight;
+        if (i < param->read_ratio)
+        {
+            op = SOAK_OP_READ;
+        }
+        else if (i < (uint32_t)param->read_ratio + param->write_ratio)
+        {
+            op = SOAK_OP_WRITE;
+        }
+        else
+        {
+            op = SOAK_OP_ERASE;
+        }
+        
+        if (op == SOAK_OP_READ)
+        {
+            len = a_soak_length(param);
+            offset = a_soak_offset(param, len, 1);
+            addr = param->addr + offset;
+            t0 = param->timestamp_us();
+            res = w25qxx_read(&gs_handle, addr, gs_buffer_output, len);
+            now = param->timestamp_us();
+            if (res != 0)
+            {
+                w25qxx_interface_debug_print("w25qxx: read failed.\n");
+                (void)w25qxx_deinit(&gs_handle);
+                
+                return 1;
+            }
+            a_soak_record(op, len, now - t0);
+            a_soak_check(addr, offset, len);
+        }
+        else if (op == SOAK_OP_WRITE)
+        {
+            /* writes cover whole pages, so one generation per page describes the content */
+            len = (a_soak_length(param) + 255) / 256 * 256;
+            if (len > W25QXX_SOAK_MAX_LENGTH)
+            {
+                len = W25QXX_SOAK_MAX_LENGTH;
+            }
+            if (len > param->size)
+            {
+                len = param->size;
+            }
+            offset = a_soak_offset(param, len, 256);
+            addr = param->addr + offset;
+            gs_generation++;
+            if (gs_generation == 0)
+            {
+                gs_generation = 1;
+            }
+            for (i = 0; i < len; i++)
+            {
+                gs_buffer_input[i] = a_soak_pattern(addr + i, gs_generation);
+            }
+            t0 = param->timestamp_us();
+            res = w25qxx_write(&gs_handle, addr, gs_buffer_input, len);
+            now = param->timestamp_us();
+            if (res != 0)
+            {
+                w25qxx_interface_debug_print("w25qxx: write failed.\n");
+                (void)w25qxx_deinit(&gs_handle);
+                
+                return 1;
+            }
+            for (i = 0; i < len / 256; i++)
+            {
+                gs_page[offset / 256 + i] = gs_generation;
+            }
+            a_soak_record(op, len, now - t0);
+        }
+        else
+        {
+            offset = a_soak_offset(param, 4096, 4096);
+            addr = param->addr + offset;
+            t0 = param->timestamp_us();
+            res = w25qxx_sector_erase_4k(&gs_handle, addr);
+            now = param->timestamp_us();
+            if (res != 0)
+            {
+                w25qxx_interface_debug_print("w25qxx: sector erase 4k failed.\n");
+                (void)w25qxx_deinit(&gs_handle);
+                
+                return 1;
+            }
+            for (i = 0; i < 16; i++)
+            {
+                gs_page[offset / 256 + i] = 0;
+            }
+            a_soak_record(op, 4096, now - t0);
+        }
+        done++;
+    }
+    now = param->timestamp_us();
+    
+    /* print the summary */
+    w25qxx_interface_debug_print("w25qxx: %u operations in %0.1fs, %u mismatches.\n",
+                                 done, (double)(now - start) / 1000000.0, gs_mismatch);
+    for (op = 0; op < SOAK_OP_NUM; op++)
+    {
+        if (gs_stat[op].count == 0)
+        {
+            continue;
+        }
+        w25qxx_interface_debug_print("w25qxx: %s count %llu bytes %llu avg %lluus p50 %lluus p99 %lluus p99.9 %lluus max %lluus.\n",
+                                     gsc_name[op],
+                                     (unsigned long long)gs_stat[op].count,
+                                     (unsigned long long)gs_stat[op].bytes,
+                                     (unsigned long long)(gs_stat[op].total_us / gs_stat[op].count),
+                                     (unsigned long long)a_soak_percentile(op, 500),
+                                     (unsigned long long)a_soak_percentile(op, 990),
+                                     (unsigned long long)a_soak_percentile(op, 999),
+                                     (unsigned long long)gs_stat[op].max_us);
+    }
+    
+    /* finish soak test */
+    (void)w25qxx_deinit(&gs_handle);
+    if (gs_mismatch != 0)
+    {
+        w25qxx_interface_debug_print("w25qxx: soak test failed.\n");
+        
+        return 1;
+    }
+    w25qxx_interface_debug_print("w25qxx: finish soak test.\n");
+    
+    return 0;
+}
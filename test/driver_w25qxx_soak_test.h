@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_w25qxx_soak_test.h
+ * @brief     driver w25qxx soak test header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_W25QXX_SOAK_TEST_H
+#define DRIVER_W25QXX_SOAK_TEST_H
+
+#include "driver_w25qxx_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup w25qxx_test_driver
+ * @{
+ */
+
+/**
+ * @brief w25qxx soak test max definition
+ */
+#define W25QXX_SOAK_MAX_LENGTH        4096         /**< max length of one operation */
+#define W25QXX_SOAK_MAX_PAGE          65536        /**< max tracked pages, 16MB region */
+
+/**
+ * @brief w25qxx soak pattern enumeration definition
+ */
+typedef enum
+{
+    W25QXX_SOAK_PATTERN_RANDOM     = 0x00,        /**< random address */
+    W25QXX_SOAK_PATTERN_SEQUENTIAL = 0x01,        /**< sequential address */
+} w25qxx_soak_pattern_t;
+
+/**
+ * @brief w25qxx soak distribution enumeration definition
+ */
+typedef enum
+{
+    W25QXX_SOAK_DISTRIBUTION_FIXED   = 0x00,        /**< always the max length */
+    W25QXX_SOAK_DISTRIBUTION_UNIFORM = 0x01,        /**< uniform between min and max */
+    W25QXX_SOAK_DISTRIBUTION_LOG     = 0x02,        /**< log uniform, small operations dominate */
+} w25qxx_soak_distribution_t;
+
+/**
+ * @brief w25qxx soak param structure definition
+ */
+typedef struct w25qxx_soak_param_s
+{
+    uint32_t addr;                                  /**< region address, 4k aligned */
+    uint32_t size;                                  /**< region size, 4k aligned */
+    uint32_t seconds;                               /**< run time, 0 means no limit */
+    uint32_t operations;                            /**< operation count, 0 means no limit */
+    uint32_t interval;                              /**< report interval in seconds */
+    uint32_t seed;                                  /**< random seed */
+    uint8_t read_ratio;                             /**< read weight */
+    uint8_t write_ratio;                            /**< write weight */
+    uint8_t erase_ratio;                            /**< erase weight */
+    w25qxx_soak_pattern_t pattern;                  /**< address pattern */
+    w25qxx_soak_distribution_t distribution;        /**< size distribution */
+    uint32_t min_length;                            /**< min operation length */
+    uint32_t max_length;                            /**< max operation length */
+    uint64_t (*timestamp_us)(void);                 /**< point to a monotonic timestamp function address */
+} w25qxx_soak_param_t;
+
+/**
+ * @brief     soak test
+ * @param[in] type chip type
+ * @param[in] interface chip interface
+ * @param[in] dual_quad_spi_enable bool value
+ * @param[in] *param pointer to a w25qxx soak param structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the region is erased first, then every read is checked against the expected content
+ */
+uint8_t w25qxx_soak_test(w25qxx_type_t type, w25qxx_interface_t interface, w25qxx_bool_t dual_quad_spi_enable,
+                         const w25qxx_soak_param_t *param);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif